@@ -0,0 +1,564 @@
+/**
+ * @file arp_prober.c
+ * @brief ARP Prober Implementation - AF_PACKET who-has requests
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE     // getifaddrs()
+
+#include "arp_prober.h"
+#include "neigh_table.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <ifaddrs.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+// Linux headers
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define ARP_HTYPE_ETHER         1
+#define ARP_OP_REQUEST          1
+#define ARP_OP_REPLY            2
+#define SWEEP_HOSTS             254     // .1 - .254 of the /24
+#define RTT_EWMA_SHIFT          3       // avg += (sample - avg) / 8
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    bool active;
+    struct in_addr addr;
+    uint8_t mac[6];
+    bool have_mac;              // Unicast the first attempt
+    int attempts;               // Requests sent so far
+    uint64_t sent_us;           // Last request
+} arp_pending_t;
+
+typedef struct {
+    bool initialized;
+    int fd;
+    int ifindex;
+    uint8_t own_mac[6];
+    struct in_addr own_addr;
+    uint32_t sweep_base;        // /24 network, host order
+
+    arp_pending_t pending[ARP_MAX_PENDING];
+
+    // Paced sweep
+    int sweep_next;             // Next host number to ask (1-254)
+    uint64_t sweep_next_us;     // When it is due
+    uint8_t sweep_answered[32]; // One bit per host number
+
+    arp_callback_t callback;
+    void *callback_user_data;
+
+    arp_stats_t stats;
+} arp_prober_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static arp_prober_context_t g_arp_ctx = { .fd = -1 };
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+static bool parse_mac(const char *text, uint8_t mac[6]) {
+    unsigned int b[6];
+    if (text == NULL || strlen(text) != 17 ||
+        sscanf(text, "%2x:%2x:%2x:%2x:%2x:%2x", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]) != 6) {
+        return false;
+    }
+    for (int i = 0; i < 6; i++) {
+        mac[i] = (uint8_t)b[i];
+    }
+    return true;
+}
+
+static void format_mac(const uint8_t mac[6], char *out) {
+    snprintf(out, ARP_MAC_MAX_LEN, "%02x:%02x:%02x:%02x:%02x:%02x",
+             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+/**
+ * @brief Parse "a.b.c.d/nn" (no prefix means /24)
+ */
+static bool parse_subnet(const char *subnet, uint32_t *network, int *prefix) {
+    char addr[32];
+    snprintf(addr, sizeof(addr), "%s", subnet);
+
+    *prefix = 24;
+    char *slash = strchr(addr, '/');
+    if (slash != NULL) {
+        *slash = '\0';
+        char *end = NULL;
+        long value = strtol(slash + 1, &end, 10);
+        if (end == slash + 1 || *end != '\0' || value < 8 || value > 30) {
+            return false;
+        }
+        *prefix = (int)value;
+    }
+
+    struct in_addr in;
+    if (inet_pton(AF_INET, addr, &in) != 1) {
+        return false;
+    }
+
+    uint32_t mask = 0xFFFFFFFFu << (32 - *prefix);
+    *network = ntohl(in.s_addr) & mask;
+    return true;
+}
+
+static void update_rtt(uint32_t rtt_us) {
+    int32_t delta = (int32_t)rtt_us - (int32_t)g_arp_ctx.stats.rtt_avg_us;
+    if (g_arp_ctx.stats.rtt_avg_us == 0) {
+        g_arp_ctx.stats.rtt_avg_us = rtt_us;
+    } else {
+        g_arp_ctx.stats.rtt_avg_us = (uint32_t)((int32_t)g_arp_ctx.stats.rtt_avg_us + delta / (1 << RTT_EWMA_SHIFT));
+    }
+}
+
+/**
+ * @brief Send one who-has for addr (broadcast unless dst_mac is given)
+ */
+static bool send_request(struct in_addr addr, const uint8_t *dst_mac) {
+    g_arp_ctx.stats.requests++;
+
+    #ifdef TESTING
+    // In test mode, nothing is sent; answers are fed via handle_reply()
+    (void)addr;
+    (void)dst_mac;
+    return true;
+    #else
+    static const uint8_t broadcast[6] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+    uint8_t packet[ARP_PACKET_LEN];
+    memset(packet, 0, sizeof(packet));
+    packet[1] = ARP_HTYPE_ETHER;
+    packet[2] = (uint8_t)(ETH_P_IP >> 8);
+    packet[3] = (uint8_t)ETH_P_IP;
+    packet[4] = 6;
+    packet[5] = 4;
+    packet[7] = ARP_OP_REQUEST;
+    memcpy(packet + 8, g_arp_ctx.own_mac, 6);
+    memcpy(packet + 14, &g_arp_ctx.own_addr, 4);
+    memcpy(packet + 24, &addr, 4);      // Target MAC stays zero
+
+    struct sockaddr_ll to;
+    memset(&to, 0, sizeof(to));
+    to.sll_family = AF_PACKET;
+    to.sll_protocol = htons(ETH_P_ARP);
+    to.sll_ifindex = g_arp_ctx.ifindex;
+    to.sll_halen = 6;
+    memcpy(to.sll_addr, dst_mac ? dst_mac : broadcast, 6);
+
+    return sendto(g_arp_ctx.fd, packet, sizeof(packet), 0, (struct sockaddr*)&to, sizeof(to)) ==
+           (ssize_t)sizeof(packet);
+    #endif
+}
+
+static int report(const arp_result_t *result) {
+    if (g_arp_ctx.callback != NULL) {
+        g_arp_ctx.callback(result, g_arp_ctx.callback_user_data);
+    }
+    return 1;
+}
+
+/**
+ * @brief Host number in the sweep /24, 0 if outside it
+ */
+static int sweep_host(struct in_addr addr) {
+    uint32_t host = ntohl(addr.s_addr);
+    if ((host & 0xFFFFFF00u) != g_arp_ctx.sweep_base) {
+        return 0;
+    }
+    int n = (int)(host & 0xFF);
+    return (n >= 1 && n <= SWEEP_HOSTS) ? n : 0;
+}
+
+/**
+ * @brief Send due sweep requests, end the sweep once the last one timed out
+ */
+static void sweep_step(uint64_t now) {
+    int burst = 0;
+    while (g_arp_ctx.sweep_next <= SWEEP_HOSTS && now >= g_arp_ctx.sweep_next_us &&
+           burst < ARP_SWEEP_BURST) {
+        struct in_addr addr = { .s_addr = htonl(g_arp_ctx.sweep_base | (uint32_t)g_arp_ctx.sweep_next) };
+        if (addr.s_addr != g_arp_ctx.own_addr.s_addr) {
+            send_request(addr, NULL);
+            g_arp_ctx.sweep_next_us += ARP_SWEEP_GAP_US;
+            burst++;
+        }
+        g_arp_ctx.sweep_next++;
+    }
+
+    if (g_arp_ctx.sweep_next > SWEEP_HOSTS &&
+        now >= g_arp_ctx.sweep_next_us + (uint64_t)ARP_PROBE_TIMEOUT_MS * 1000ULL) {
+        g_arp_ctx.stats.sweeping = false;
+    }
+}
+
+/**
+ * @brief Retry or expire pending probes
+ */
+static int expire_pending(uint64_t now) {
+    int reported = 0;
+
+    for (int i = 0; i < ARP_MAX_PENDING; i++) {
+        arp_pending_t *p = &g_arp_ctx.pending[i];
+        if (!p->active || now - p->sent_us < (uint64_t)ARP_PROBE_TIMEOUT_MS * 1000ULL) {
+            continue;
+        }
+
+        if (p->attempts < ARP_PROBE_ATTEMPTS) {
+            // The MAC may have changed hands; later attempts broadcast
+            send_request(p->addr, NULL);
+            p->attempts++;
+            p->sent_us = now;
+            continue;
+        }
+
+        arp_result_t result;
+        memset(&result, 0, sizeof(result));
+        inet_ntop(AF_INET, &p->addr, result.ip, sizeof(result.ip));
+        p->active = false;
+        g_arp_ctx.stats.timeouts++;
+        reported += report(&result);
+    }
+
+    return reported;
+}
+
+#ifndef TESTING
+
+/**
+ * @brief Read every queued ARP packet
+ */
+static int drain_socket(void) {
+    int reported = 0;
+    uint8_t packet[64];
+    ssize_t n;
+
+    while ((n = recv(g_arp_ctx.fd, packet, sizeof(packet), MSG_DONTWAIT)) > 0) {
+        reported += arp_prober_handle_reply(packet, (size_t)n);
+    }
+    return reported;
+}
+
+/**
+ * @brief Find the interface holding the subnet, with its IPv4 and MAC
+ */
+static bool find_interface(uint32_t network, int prefix) {
+    struct ifaddrs *list = NULL;
+    if (getifaddrs(&list) != 0) {
+        return false;
+    }
+
+    uint32_t mask = 0xFFFFFFFFu << (32 - prefix);
+    char name[IF_NAMESIZE] = "";
+
+    for (struct ifaddrs *ifa = list; ifa != NULL && name[0] == '\0'; ifa = ifa->ifa_next) {
+        if (ifa->ifa_addr == NULL || ifa->ifa_addr->sa_family != AF_INET) {
+            continue;
+        }
+        struct in_addr addr = ((struct sockaddr_in*)ifa->ifa_addr)->sin_addr;
+        if ((ntohl(addr.s_addr) & mask) == network) {
+            snprintf(name, sizeof(name), "%s", ifa->ifa_name);
+            g_arp_ctx.own_addr = addr;
+        }
+    }
+
+    bool have_mac = false;
+    for (struct ifaddrs *ifa = list; ifa != NULL && name[0] != '\0'; ifa = ifa->ifa_next) {
+        if (ifa->ifa_addr != NULL && ifa->ifa_addr->sa_family == AF_PACKET &&
+            strcmp(ifa->ifa_name, name) == 0) {
+            struct sockaddr_ll *ll = (struct sockaddr_ll*)ifa->ifa_addr;
+            if (ll->sll_halen == 6) {
+                memcpy(g_arp_ctx.own_mac, ll->sll_addr, 6);
+                have_mac = true;
+            }
+            break;
+        }
+    }
+    freeifaddrs(list);
+
+    g_arp_ctx.ifindex = have_mac ? (int)if_nametoindex(name) : 0;
+    snprintf(g_arp_ctx.stats.iface, sizeof(g_arp_ctx.stats.iface), "%s", name);
+    return g_arp_ctx.ifindex > 0;
+}
+
+#endif /* !TESTING */
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int arp_prober_init(const char *subnet) {
+    if (g_arp_ctx.initialized) {
+        return ARP_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    uint32_t network;
+    int prefix;
+    if (subnet == NULL || !parse_subnet(subnet, &network, &prefix)) {
+        return ARP_ERROR_INVALID_PARAM;
+    }
+
+    memset(&g_arp_ctx, 0, sizeof(arp_prober_context_t));
+    g_arp_ctx.fd = -1;
+
+    #ifdef TESTING
+    // In test mode, no socket; this host is the first address
+    (void)prefix;
+    g_arp_ctx.ifindex = 1;
+    g_arp_ctx.own_addr.s_addr = htonl(network | 1);
+    snprintf(g_arp_ctx.stats.iface, sizeof(g_arp_ctx.stats.iface), "test0");
+    #else
+    if (!find_interface(network, prefix)) {
+        fprintf(stderr, "[ARP] No interface on %s\n", subnet);
+        return ARP_ERROR_SOCKET;
+    }
+
+    g_arp_ctx.fd = socket(AF_PACKET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, htons(ETH_P_ARP));
+    if (g_arp_ctx.fd < 0) {
+        return ARP_ERROR_SOCKET;
+    }
+
+    struct sockaddr_ll bind_addr;
+    memset(&bind_addr, 0, sizeof(bind_addr));
+    bind_addr.sll_family = AF_PACKET;
+    bind_addr.sll_protocol = htons(ETH_P_ARP);
+    bind_addr.sll_ifindex = g_arp_ctx.ifindex;
+    if (bind(g_arp_ctx.fd, (struct sockaddr*)&bind_addr, sizeof(bind_addr)) != 0) {
+        close(g_arp_ctx.fd);
+        g_arp_ctx.fd = -1;
+        return ARP_ERROR_SOCKET;
+    }
+
+    fprintf(stdout, "[ARP] Probing on %s\n", g_arp_ctx.stats.iface);
+    #endif
+
+    // Sweep the /24 this host is in, even on a wider subnet
+    g_arp_ctx.sweep_base = ntohl(g_arp_ctx.own_addr.s_addr) & 0xFFFFFF00u;
+    g_arp_ctx.initialized = true;
+    return ARP_OK;
+}
+
+void arp_prober_set_callback(arp_callback_t callback, void *user_data) {
+    g_arp_ctx.callback = callback;
+    g_arp_ctx.callback_user_data = user_data;
+}
+
+int arp_prober_probe(const char *ip, const char *mac) {
+    if (!g_arp_ctx.initialized) {
+        return ARP_ERROR_NOT_INIT;
+    }
+
+    struct in_addr addr;
+    if (ip == NULL || inet_pton(AF_INET, ip, &addr) != 1) {
+        return ARP_ERROR_INVALID_PARAM;
+    }
+
+    arp_pending_t *slot = NULL;
+    for (int i = 0; i < ARP_MAX_PENDING; i++) {
+        arp_pending_t *p = &g_arp_ctx.pending[i];
+        if (p->active && p->addr.s_addr == addr.s_addr) {
+            return ARP_OK;  // Already in flight
+        }
+        if (!p->active && slot == NULL) {
+            slot = p;
+        }
+    }
+    if (slot == NULL) {
+        return ARP_ERROR_BUSY;
+    }
+
+    memset(slot, 0, sizeof(arp_pending_t));
+    slot->addr = addr;
+    slot->have_mac = parse_mac(mac, slot->mac);
+
+    if (!send_request(addr, slot->have_mac ? slot->mac : NULL)) {
+        return ARP_ERROR_SOCKET;
+    }
+    slot->active = true;
+    slot->attempts = 1;
+    slot->sent_us = server_clock_monotonic_us();
+    return ARP_OK;
+}
+
+int arp_prober_get_fd(void) {
+    return g_arp_ctx.fd;
+}
+
+int arp_prober_sweep(void) {
+    if (!g_arp_ctx.initialized) {
+        return ARP_ERROR_NOT_INIT;
+    }
+
+    if (g_arp_ctx.stats.sweeping) {
+        return ARP_OK;
+    }
+
+    g_arp_ctx.stats.sweeping = true;
+    g_arp_ctx.stats.sweeps++;
+    g_arp_ctx.sweep_next = 1;
+    g_arp_ctx.sweep_next_us = server_clock_monotonic_us();
+    memset(g_arp_ctx.sweep_answered, 0, sizeof(g_arp_ctx.sweep_answered));
+
+    #ifndef TESTING
+    fprintf(stdout, "[ARP] Sweeping %u.%u.%u.0/24\n",
+            (g_arp_ctx.sweep_base >> 24) & 0xFF, (g_arp_ctx.sweep_base >> 16) & 0xFF,
+            (g_arp_ctx.sweep_base >> 8) & 0xFF);
+    #endif
+
+    return ARP_OK;
+}
+
+int arp_prober_process(void) {
+    if (!g_arp_ctx.initialized) {
+        return ARP_ERROR_NOT_INIT;
+    }
+
+    int reported = 0;
+
+    #ifndef TESTING
+    reported += drain_socket();
+    #endif
+
+    uint64_t now = server_clock_monotonic_us();
+    if (g_arp_ctx.stats.sweeping) {
+        sweep_step(now);
+    }
+    reported += expire_pending(now);
+
+    return reported;
+}
+
+int arp_prober_handle_reply(const uint8_t *packet, size_t len) {
+    if (!g_arp_ctx.initialized || packet == NULL || len < ARP_PACKET_LEN) {
+        return 0;
+    }
+
+    // Ethernet / IPv4 replies only; our own requests come back on the socket too
+    if (packet[0] != 0 || packet[1] != ARP_HTYPE_ETHER ||
+        packet[2] != (uint8_t)(ETH_P_IP >> 8) || packet[3] != (uint8_t)ETH_P_IP ||
+        packet[4] != 6 || packet[5] != 4 || packet[6] != 0 || packet[7] != ARP_OP_REPLY) {
+        return 0;
+    }
+
+    const uint8_t *sender_mac = packet + 8;
+    struct in_addr sender;
+    memcpy(&sender, packet + 14, 4);
+
+    arp_result_t result;
+    memset(&result, 0, sizeof(result));
+    result.alive = true;
+    inet_ntop(AF_INET, &sender, result.ip, sizeof(result.ip));
+    format_mac(sender_mac, result.mac);
+
+    uint64_t now = server_clock_monotonic_us();
+
+    arp_pending_t *pending = NULL;
+    for (int i = 0; i < ARP_MAX_PENDING && pending == NULL; i++) {
+        if (g_arp_ctx.pending[i].active && g_arp_ctx.pending[i].addr.s_addr == sender.s_addr) {
+            pending = &g_arp_ctx.pending[i];
+        }
+    }
+
+    int host = sweep_host(sender);
+    bool sweep_answer = (pending == NULL && g_arp_ctx.stats.sweeping && host > 0 &&
+                         host < g_arp_ctx.sweep_next &&
+                         !(g_arp_ctx.sweep_answered[host / 8] & (1u << (host % 8))));
+
+    if (pending == NULL && !sweep_answer) {
+        return 0;
+    }
+
+    g_arp_ctx.stats.replies++;
+    if (neigh_table_learn(result.ip, result.mac, g_arp_ctx.ifindex) == NEIGH_OK) {
+        g_arp_ctx.stats.learned++;
+    }
+
+    if (pending != NULL) {
+        result.rtt_us = (uint32_t)(now - pending->sent_us);
+        update_rtt(result.rtt_us);
+        pending->active = false;
+        return report(&result);
+    }
+
+    if (sweep_answer) {
+        g_arp_ctx.sweep_answered[host / 8] |= (uint8_t)(1u << (host % 8));
+        result.sweep = true;
+        return report(&result);
+    }
+
+    return 0;
+}
+
+int arp_prober_get_stats(arp_stats_t *stats) {
+    if (!g_arp_ctx.initialized) {
+        return ARP_ERROR_NOT_INIT;
+    }
+
+    if (stats == NULL) {
+        return ARP_ERROR_INVALID_PARAM;
+    }
+
+    memcpy(stats, &g_arp_ctx.stats, sizeof(arp_stats_t));
+    return ARP_OK;
+}
+
+void arp_prober_cleanup(void) {
+    if (!g_arp_ctx.initialized) {
+        return;
+    }
+
+    if (g_arp_ctx.fd >= 0) {
+        close(g_arp_ctx.fd);
+    }
+
+    memset(&g_arp_ctx, 0, sizeof(arp_prober_context_t));
+    g_arp_ctx.fd = -1;
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* arp_prober_error_string(int error) {
+    switch (error) {
+        case ARP_OK:                    return "OK";
+        case ARP_ERROR_NOT_INIT:        return "Not initialized";
+        case ARP_ERROR_INVALID_PARAM:   return "Invalid parameter";
+        case ARP_ERROR_SOCKET:          return "Socket error";
+        case ARP_ERROR_TIMEOUT:         return "No answer";
+        case ARP_ERROR_BUSY:            return "Too many probes in flight";
+        case ARP_ERROR_UNKNOWN:         return "Unknown error";
+        default:                        return "Invalid error code";
+    }
+}
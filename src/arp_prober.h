@@ -0,0 +1,179 @@
+/**
+ * @file arp_prober.h
+ * @brief ARP Prober - Layer-2 liveness checks and subnet sweeps
+ *
+ * Sends ARP who-has requests on the LAN interface through an AF_PACKET
+ * socket. A console in rest mode often ignores ICMP but always answers
+ * ARP, and an ARP answer needs no neighbour resolution first, so this
+ * is both faster and more reliable than ping on the local segment.
+ *
+ *   probe   who-has to one IP: unicast to the cached MAC first, then
+ *           broadcast; the answer is matched in process() (the hedged
+ *           detection polls get_fd() while it waits)
+ *   sweep   who-has to every host of the /24, paced so a full sweep
+ *           does not burst onto the wireless side
+ *
+ * Every answer is written into the kernel neighbour table as a STALE
+ * entry (when none exists), so the follow-up TCP probes go out at once.
+ *
+ * Needs CAP_NET_RAW.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef ARP_PROBER_H
+#define ARP_PROBER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define ARP_OK                          0
+#define ARP_ERROR_NOT_INIT             -1
+#define ARP_ERROR_INVALID_PARAM        -2
+#define ARP_ERROR_SOCKET               -3
+#define ARP_ERROR_TIMEOUT              -4
+#define ARP_ERROR_BUSY                 -5
+#define ARP_ERROR_UNKNOWN              -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define ARP_PACKET_LEN              28      /**< Ethernet/IPv4 ARP payload */
+#define ARP_MAX_PENDING             8       /**< Concurrent probe() requests */
+#define ARP_PROBE_TIMEOUT_MS        250     /**< Wait per attempt */
+#define ARP_PROBE_ATTEMPTS          3       /**< First unicast (if MAC known), then broadcast */
+#define ARP_SWEEP_GAP_US            2000    /**< Pacing between sweep requests */
+#define ARP_SWEEP_BURST             16      /**< Max sweep requests per process() call */
+#define ARP_IP_MAX_LEN              16
+#define ARP_MAC_MAX_LEN             18
+#define ARP_IFACE_MAX_LEN           16
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Outcome of one probe, or one sweep answer
+ */
+typedef struct {
+    char ip[ARP_IP_MAX_LEN];            /**< Probed address */
+    char mac[ARP_MAC_MAX_LEN];          /**< Answering MAC, empty on timeout */
+    bool alive;                         /**< Answered */
+    bool sweep;                         /**< Answer to a sweep request */
+    uint32_t rtt_us;                    /**< Time since the answered request (0 for sweeps) */
+} arp_result_t;
+
+/**
+ * @brief Result callback function type
+ */
+typedef void (*arp_callback_t)(const arp_result_t *result, void *user_data);
+
+/**
+ * @brief Statistics
+ */
+typedef struct {
+    char iface[ARP_IFACE_MAX_LEN];      /**< LAN interface in use */
+    uint32_t requests;                  /**< who-has sent */
+    uint32_t replies;                   /**< Matched answers */
+    uint32_t timeouts;                  /**< Probes that got no answer */
+    uint32_t learned;                   /**< Neighbour entries added */
+    uint32_t sweeps;                    /**< Sweeps started */
+    bool sweeping;                      /**< A sweep is in progress */
+    uint32_t rtt_avg_us;                /**< Smoothed answer time */
+} arp_stats_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Open the packet socket on the interface that holds the subnet
+ * @param subnet Network subnet (e.g., "192.168.1.0/24")
+ * @return ARP_OK on success, negative error code on failure
+ */
+int arp_prober_init(const char *subnet);
+
+/**
+ * @brief Set the result callback
+ * @param callback Callback function
+ * @param user_data User data to pass to callback
+ */
+void arp_prober_set_callback(arp_callback_t callback, void *user_data);
+
+/**
+ * @brief Start a probe; the result is reported from process()
+ * @param ip IPv4 address
+ * @param mac Last known MAC for a unicast first attempt (can be NULL)
+ * @return ARP_OK if sent, ARP_ERROR_BUSY if ARP_MAX_PENDING are in flight
+ */
+int arp_prober_probe(const char *ip, const char *mac);
+
+/**
+ * @brief Get the packet socket, readable when answers are waiting
+ * @return File descriptor, -1 if not initialized (or in test mode)
+ */
+int arp_prober_get_fd(void);
+
+/**
+ * @brief Start a paced sweep of the /24 around this host
+ *
+ * Each answer is reported with sweep set. A sweep already running is
+ * left alone.
+ *
+ * @return ARP_OK on success, negative error code on failure
+ */
+int arp_prober_sweep(void);
+
+/**
+ * @brief Send due requests, read answers, expire probes (non-blocking)
+ * @return Number of results reported, negative error code on failure
+ */
+int arp_prober_process(void);
+
+/**
+ * @brief Handle one received ARP payload
+ *
+ * Used by process(); exposed so matching can be tested offline.
+ *
+ * @param packet ARP payload (no Ethernet header)
+ * @param len Payload length
+ * @return Number of results reported (0 or 1)
+ */
+int arp_prober_handle_reply(const uint8_t *packet, size_t len);
+
+/**
+ * @brief Get a snapshot of the statistics
+ * @param stats Pointer to store statistics
+ * @return ARP_OK on success, negative error code on failure
+ */
+int arp_prober_get_stats(arp_stats_t *stats);
+
+/**
+ * @brief Close the socket and drop pending probes
+ */
+void arp_prober_cleanup(void);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* arp_prober_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARP_PROBER_H */
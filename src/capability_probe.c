@@ -0,0 +1,268 @@
+/**
+ * @file capability_probe.c
+ * @brief Capability Probe Implementation - One-shot startup checks
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE     // syscall()
+
+#include "capability_probe.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+
+// Linux headers
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <linux/if_ether.h>
+#include <linux/cec.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define PROC_ARP_PATH           "/proc/net/arp"
+#define IO_URING_PARAMS_SIZE    120     // sizeof(struct io_uring_params)
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static capability_report_t g_report;
+static bool g_probed = false;
+
+/* ============================================================
+ *  Helper Functions - Probes
+ * ============================================================ */
+
+#ifndef TESTING
+
+/**
+ * @brief Check that a socket of this type can be opened
+ */
+static bool probe_socket(int domain, int type, int protocol) {
+    int fd = socket(domain, type, protocol);
+    if (fd < 0) {
+        return false;
+    }
+    close(fd);
+    return true;
+}
+
+/**
+ * @brief Check that an executable is in PATH
+ */
+static bool probe_command(const char *name) {
+    const char *path = getenv("PATH");
+    if (path == NULL) {
+        path = "/usr/sbin:/usr/bin:/sbin:/bin";
+    }
+
+    char dirs[1024];
+    snprintf(dirs, sizeof(dirs), "%s", path);
+
+    char *saveptr = NULL;
+    for (char *dir = strtok_r(dirs, ":", &saveptr); dir != NULL;
+         dir = strtok_r(NULL, ":", &saveptr)) {
+        char full[512];
+        snprintf(full, sizeof(full), "%s/%s", dir, name);
+        if (access(full, X_OK) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Device opens and the adapter has claimed a logical address
+ */
+static bool probe_cec_ioctl(const char *device) {
+    int fd = open(device, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct cec_log_addrs laddrs;
+    memset(&laddrs, 0, sizeof(laddrs));
+    bool ok = (ioctl(fd, CEC_ADAP_G_LOG_ADDRS, &laddrs) == 0 && laddrs.num_log_addrs > 0);
+
+    close(fd);
+    return ok;
+}
+
+/**
+ * @brief A real neighbour dump, since some sandboxes allow the socket but not the request
+ */
+static bool probe_neigh_netlink(void) {
+    neigh_backend_t saved = neigh_table_get_backend();
+    neigh_entry_t entries[NEIGH_MAX_ENTRIES];
+
+    neigh_table_set_backend(NEIGH_BACKEND_NETLINK);
+    int result = neigh_table_dump(entries, NEIGH_MAX_ENTRIES);
+    neigh_table_set_backend(saved);
+
+    return result >= 0;
+}
+
+static bool probe_io_uring(void) {
+    #ifdef __NR_io_uring_setup
+    uint32_t params[IO_URING_PARAMS_SIZE / sizeof(uint32_t)];
+    memset(params, 0, sizeof(params));
+
+    long fd = syscall(__NR_io_uring_setup, 1, params);
+    if (fd < 0) {
+        return false;  // ENOSYS, or disabled by kernel.io_uring_disabled
+    }
+    close((int)fd);
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+static bool probe_epoll(void) {
+    int fd = epoll_create1(EPOLL_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    close(fd);
+    return true;
+}
+
+#endif /* !TESTING */
+
+/**
+ * @brief Run every probe once
+ */
+static void probe_all(const char *cec_device, capability_set_t *caps) {
+    memset(caps, 0, sizeof(capability_set_t));
+
+    #ifdef TESTING
+    // In test mode, report nothing so selection falls back to defaults
+    (void)cec_device;
+    #else
+    caps->arp_packet = probe_socket(AF_PACKET, SOCK_DGRAM, htons(ETH_P_ARP));
+    caps->icmp_raw = probe_socket(AF_INET, SOCK_RAW, IPPROTO_ICMP);
+    caps->icmp_dgram = probe_socket(AF_INET, SOCK_DGRAM, IPPROTO_ICMP);
+    caps->tcp_connect = probe_socket(AF_INET, SOCK_STREAM, 0);
+    caps->ping_command = probe_command("ping");
+
+    caps->cec_ioctl = probe_cec_ioctl(cec_device);
+    caps->cec_ctl = probe_command("cec-ctl") && access(cec_device, F_OK) == 0;
+
+    caps->neigh_netlink = probe_neigh_netlink();
+    caps->neigh_proc = (access(PROC_ARP_PATH, R_OK) == 0);
+    caps->arp_command = probe_command("arp");
+
+    caps->io_uring = probe_io_uring();
+    caps->epoll = probe_epoll();
+    #endif
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+void capability_probe_select(const capability_set_t *caps, capability_report_t *report) {
+    if (caps == NULL || report == NULL) {
+        return;
+    }
+
+    memset(report, 0, sizeof(capability_report_t));
+    report->caps = *caps;
+
+    // ARP first: a resting console drops ICMP but always answers ARP.
+    // Then datagram ICMP: the kernel demuxes replies per socket,
+    // while a raw socket sees every ICMP packet on the box
+    if (caps->arp_packet)           report->ping = PING_BACKEND_ARP;
+    else if (caps->icmp_dgram)      report->ping = PING_BACKEND_ICMP_DGRAM;
+    else if (caps->icmp_raw)        report->ping = PING_BACKEND_ICMP_RAW;
+    else if (caps->tcp_connect)     report->ping = PING_BACKEND_TCP;
+    else if (caps->ping_command)    report->ping = PING_BACKEND_COMMAND;
+    else                            report->ping = PING_BACKEND_NONE;
+
+    if (caps->cec_ioctl)            report->cec = CEC_BACKEND_IOCTL;
+    else if (caps->cec_ctl)         report->cec = CEC_BACKEND_COMMAND;
+    else                            report->cec = CEC_BACKEND_NONE;
+
+    if (caps->neigh_netlink)        report->neigh = NEIGH_BACKEND_NETLINK;
+    else if (caps->neigh_proc)      report->neigh = NEIGH_BACKEND_PROC;
+    else if (caps->arp_command)     report->neigh = NEIGH_BACKEND_COMMAND;
+    else                            report->neigh = NEIGH_BACKEND_NONE;
+
+    // Report the poller the main loop actually runs; io_uring and epoll
+    // stay in caps until something consumes them
+    report->loop = LOOP_BACKEND_POLL;
+}
+
+int capability_probe_run(const char *cec_device, capability_report_t *report) {
+    if (cec_device == NULL) {
+        return CAP_PROBE_ERROR_INVALID_PARAM;
+    }
+
+    uint64_t start = server_clock_monotonic_us();
+
+    capability_set_t caps;
+    probe_all(cec_device, &caps);
+    capability_probe_select(&caps, &g_report);
+
+    g_report.probe_ms = (uint32_t)((server_clock_monotonic_us() - start) / 1000ULL);
+    g_probed = true;
+
+    #ifndef TESTING
+    fprintf(stdout, "[Caps] ping=%s cec=%s neigh=%s loop=%s (probed in %u ms)\n",
+            ps5_detector_ping_backend_string(g_report.ping),
+            cec_backend_to_string(g_report.cec),
+            neigh_backend_to_string(g_report.neigh),
+            capability_loop_backend_string(g_report.loop),
+            g_report.probe_ms);
+    #endif
+
+    if (report != NULL) {
+        *report = g_report;
+    }
+    return CAP_PROBE_OK;
+}
+
+const capability_report_t* capability_probe_get(void) {
+    return g_probed ? &g_report : NULL;
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* capability_loop_backend_string(loop_backend_t backend) {
+    switch (backend) {
+        case LOOP_BACKEND_POLL:         return "poll";
+        case LOOP_BACKEND_EPOLL:        return "epoll";
+        case LOOP_BACKEND_IO_URING:     return "io_uring";
+        default:                        return "unknown";
+    }
+}
+
+const char* capability_probe_error_string(int error) {
+    switch (error) {
+        case CAP_PROBE_OK:                      return "OK";
+        case CAP_PROBE_ERROR_INVALID_PARAM:     return "Invalid parameter";
+        case CAP_PROBE_ERROR_UNKNOWN:           return "Unknown error";
+        default:                                return "Invalid error code";
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * @file capability_probe.h
+ * @brief Capability Probe - Startup backend selection
+ *
+ * Checks once at startup what this firmware build and privilege level
+ * allow, then picks the fastest available backend per subsystem:
+ *
+ *   ping   ARP > ICMP datagram > ICMP raw > TCP connect > ping(8)
+ *   cec    CEC_TRANSMIT ioctl > cec-ctl
+ *   neigh  rtnetlink > /proc/net/arp > arp -n
+ *   loop   poll (io_uring and epoll are only probed: the main loop
+ *          is built on poll(2), so that is what gets reported)
+ *
+ * The caller applies the choice to each module; the report is kept
+ * for the stats reply.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef CAPABILITY_PROBE_H
+#define CAPABILITY_PROBE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cec_monitor.h"
+#include "ps5_detector.h"
+#include "neigh_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define CAP_PROBE_OK                    0
+#define CAP_PROBE_ERROR_INVALID_PARAM  -2
+#define CAP_PROBE_ERROR_UNKNOWN        -99
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Event loop backend
+ */
+typedef enum {
+    LOOP_BACKEND_POLL = 0,      /**< poll(2), always available */
+    LOOP_BACKEND_EPOLL,         /**< epoll(7) */
+    LOOP_BACKEND_IO_URING,      /**< io_uring(7) */
+} loop_backend_t;
+
+/**
+ * @brief Raw probe results
+ */
+typedef struct {
+    bool arp_packet;        /**< AF_PACKET/ETH_P_ARP opens */
+    bool icmp_raw;          /**< SOCK_RAW/IPPROTO_ICMP opens */
+    bool icmp_dgram;        /**< SOCK_DGRAM/IPPROTO_ICMP opens (ping_group_range) */
+    bool tcp_connect;       /**< SOCK_STREAM opens */
+    bool ping_command;      /**< ping in PATH */
+    bool cec_ioctl;         /**< Device opens and has a logical address */
+    bool cec_ctl;           /**< cec-ctl in PATH and device present */
+    bool neigh_netlink;     /**< RTM_GETNEIGH dump succeeds */
+    bool neigh_proc;        /**< /proc/net/arp readable */
+    bool arp_command;       /**< arp in PATH */
+    bool io_uring;          /**< io_uring_setup succeeds */
+    bool epoll;             /**< epoll_create1 succeeds */
+} capability_set_t;
+
+/**
+ * @brief Selected backends
+ */
+typedef struct {
+    capability_set_t caps;      /**< What was found */
+    ping_backend_t ping;        /**< Liveness check */
+    cec_backend_t cec;          /**< Power status query */
+    neigh_backend_t neigh;      /**< Neighbour lookup */
+    loop_backend_t loop;        /**< Event loop */
+    uint32_t probe_ms;          /**< Time spent probing */
+} capability_report_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Probe all capabilities and select backends
+ * @param cec_device CEC device path (e.g., "/dev/cec0")
+ * @param report Output report (can be NULL)
+ * @return CAP_PROBE_OK on success, negative error code on failure
+ */
+int capability_probe_run(const char *cec_device, capability_report_t *report);
+
+/**
+ * @brief Pick the fastest backend per subsystem (pure, exposed for tests)
+ * @param caps Probe results
+ * @param report Output report; caps are copied in
+ */
+void capability_probe_select(const capability_set_t *caps, capability_report_t *report);
+
+/**
+ * @brief Get the last probe report
+ * @return Report, or NULL if capability_probe_run() has not been called
+ */
+const capability_report_t* capability_probe_get(void);
+
+/**
+ * @brief Convert loop backend to string
+ * @param backend Backend
+ * @return Backend name string
+ */
+const char* capability_loop_backend_string(loop_backend_t backend);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* capability_probe_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAPABILITY_PROBE_H */
@@ -11,6 +11,9 @@
 #define _POSIX_C_SOURCE 200809L
 
 #include "cec_monitor.h"
+#include "server_trace.h"
+#include "fault_inject.h"
+#include "thread_policy.h"
 
 // Standard C library
 #include <stdio.h>
@@ -24,6 +27,14 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+
+// Linux headers
+#include <linux/cec.h>
 
 /* ============================================================
  *  Constants
@@ -32,6 +43,8 @@
 #define CEC_POLL_INTERVAL_MS    1000    // 1 second
 #define CEC_MAX_RETRY           3
 #define CEC_COMMAND_TIMEOUT     5
+#define CEC_IOCTL_TIMEOUT_MS    1000
+#define CEC_PS5_LOG_ADDR        CEC_LOG_ADDR_PLAYBACK_2     // 4
 
 /* ============================================================
  *  Internal Structures
@@ -55,18 +68,57 @@ typedef struct {
     unsigned int poll_count;
     unsigned int error_count;
     
+    // Monitor thread
+    bool threaded;                      // Results go to the mailbox, not the callback
+    bool thread_started;
+    bool paused;                        // Set by the main loop, read by the thread
+    pthread_t thread;
+    
 } cec_monitor_context_t;
 
+/**
+ * @brief One result posted by the monitor thread
+ */
+typedef struct {
+    cec_event_t event;
+    ps5_power_state_t state;
+    time_t timestamp;
+} cec_record_t;
+
+/**
+ * @brief Single-producer/single-consumer ring
+ *
+ * Only the monitor thread writes head and only the main loop writes
+ * tail; each side publishes its index with a release store after
+ * touching the slot, so no lock is needed.
+ */
+typedef struct {
+    cec_record_t records[CEC_MAILBOX_SIZE];
+    unsigned int head;                  // Next slot to write (producer)
+    unsigned int tail;                  // Next slot to read (consumer)
+    unsigned int dropped;               // Records lost while full
+    int event_fd;                       // Signalled after each post
+    int wake_fd;                        // Signalled by stop() to end the wait
+} cec_mailbox_t;
+
 /* ============================================================
  *  Static Variables
  * ============================================================ */
 
 static cec_monitor_context_t g_cec_ctx = {0};
 
+// Backend is chosen before init and survives cleanup
+static cec_backend_t g_cec_backend = CEC_BACKEND_COMMAND;
+static int g_cec_fd = -1;
+
+static cec_mailbox_t g_cec_mailbox = { .event_fd = -1, .wake_fd = -1 };
+
 /* ============================================================
  *  Helper Functions
  * ============================================================ */
 
+static void trigger_callback_if_changed(void);
+
 /**
  * @brief Execute CEC command and get output
  */
@@ -75,6 +127,11 @@ static int execute_cec_command(const char *cmd, char *output, size_t output_size
         return CEC_ERROR_INVALID_PARAM;
     }
     
+    FAULT_DELAY(FAULT_POINT_CMD);
+    if (FAULT_FAIL(FAULT_POINT_CMD)) {
+        return CEC_ERROR_COMMAND_FAILED;
+    }
+    
     FILE *fp = popen(cmd, "r");
     if (fp == NULL) {
         #ifndef TESTING
@@ -130,9 +187,9 @@ static ps5_power_state_t parse_power_status(const char *output) {
 }
 
 /**
- * @brief Query PS5 power status via CEC
+ * @brief Query PS5 power status via cec-ctl
  */
-static ps5_power_state_t query_power_status(void) {
+static ps5_power_state_t query_power_status_command(void) {
     char cmd[512];
     char output[1024];
     
@@ -143,10 +200,126 @@ static ps5_power_state_t query_power_status(void) {
     if (execute_cec_command(cmd, output, sizeof(output)) != CEC_OK) {
         return PS5_POWER_UNKNOWN;
     }
-    
     return parse_power_status(output);
 }
 
+/**
+ * @brief Map a <Report Power Status> operand (same mapping as parse_power_status())
+ */
+static ps5_power_state_t power_status_from_operand(uint8_t status) {
+    switch (status) {
+        case CEC_OP_POWER_STATUS_ON:
+        case CEC_OP_POWER_STATUS_TO_ON:         return PS5_POWER_ON;
+        case CEC_OP_POWER_STATUS_STANDBY:       return PS5_POWER_STANDBY;
+        case CEC_OP_POWER_STATUS_TO_STANDBY:    return PS5_POWER_OFF;
+        default:                                return PS5_POWER_UNKNOWN;
+    }
+}
+
+/**
+ * @brief Query PS5 power status with CEC_TRANSMIT (no fork per poll)
+ */
+static ps5_power_state_t query_power_status_ioctl(void) {
+    if (g_cec_fd < 0) {
+        g_cec_fd = open(g_cec_ctx.device_path, O_RDWR | O_CLOEXEC);
+        if (g_cec_fd < 0) {
+            return PS5_POWER_UNKNOWN;
+        }
+    }
+    
+    struct cec_log_addrs laddrs;
+    memset(&laddrs, 0, sizeof(laddrs));
+    if (ioctl(g_cec_fd, CEC_ADAP_G_LOG_ADDRS, &laddrs) != 0 || laddrs.num_log_addrs == 0) {
+        return PS5_POWER_UNKNOWN;
+    }
+    
+    struct cec_msg msg;
+    memset(&msg, 0, sizeof(msg));
+    cec_msg_init(&msg, laddrs.log_addr[0], CEC_PS5_LOG_ADDR);
+    msg.len = 2;
+    msg.msg[1] = CEC_MSG_GIVE_DEVICE_POWER_STATUS;
+    msg.reply = CEC_MSG_REPORT_POWER_STATUS;
+    msg.timeout = CEC_IOCTL_TIMEOUT_MS;
+    
+    if (ioctl(g_cec_fd, CEC_TRANSMIT, &msg) != 0 ||
+        !(msg.rx_status & CEC_RX_STATUS_OK) || msg.len < 3) {
+        return PS5_POWER_UNKNOWN;
+    }
+    
+    return power_status_from_operand(msg.msg[2]);
+}
+
+/**
+ * @brief Read one message the console sent on its own
+ *
+ * Lets the monitor thread see standby or wake-up as soon as the console
+ * announces it instead of at the next poll.
+ *
+ * @param state Output new power state, PS5_POWER_UNKNOWN if the message says nothing about it
+ * @return CEC_OK, or CEC_ERROR_COMMAND_FAILED if the device could not be read
+ */
+static int receive_power_message(ps5_power_state_t *state) {
+    struct cec_msg msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.timeout = 1;    // Already readable; 0 would mean wait forever
+    *state = PS5_POWER_UNKNOWN;
+    
+    if (ioctl(g_cec_fd, CEC_RECEIVE, &msg) != 0) {
+        return CEC_ERROR_COMMAND_FAILED;
+    }
+    if (msg.len < 2 || cec_msg_initiator(&msg) != CEC_PS5_LOG_ADDR) {
+        return CEC_OK;
+    }
+    
+    switch (msg.msg[1]) {
+        case CEC_MSG_REPORT_POWER_STATUS:
+            if (msg.len >= 3) {
+                *state = power_status_from_operand(msg.msg[2]);
+            }
+            break;
+        case CEC_MSG_STANDBY:
+            *state = PS5_POWER_STANDBY;
+            break;
+        case CEC_MSG_ACTIVE_SOURCE:
+        case CEC_MSG_IMAGE_VIEW_ON:
+        case CEC_MSG_TEXT_VIEW_ON:
+            *state = PS5_POWER_ON;
+            break;
+        default:
+            break;
+    }
+    return CEC_OK;
+}
+
+/**
+ * @brief Query PS5 power status via CEC
+ */
+static ps5_power_state_t query_power_status(void) {
+    uint64_t trace_start = server_trace_now_us();
+    SERVER_TRACE0(cec_query_start);
+    
+    ps5_power_state_t state = PS5_POWER_UNKNOWN;
+    FAULT_DELAY(FAULT_POINT_CEC);
+    if (FAULT_FAIL(FAULT_POINT_CEC)) {
+        SERVER_TRACE2(cec_query_end, state, server_trace_now_us() - trace_start);
+        return state;
+    }
+    
+    switch (g_cec_backend) {
+        case CEC_BACKEND_IOCTL:
+            state = query_power_status_ioctl();
+            break;
+        case CEC_BACKEND_COMMAND:
+            state = query_power_status_command();
+            break;
+        default:
+            break;
+    }
+    
+    SERVER_TRACE2(cec_query_end, state, server_trace_now_us() - trace_start);
+    return state;
+}
+
 /**
  * @brief Convert power state to event type
  */
@@ -159,11 +332,122 @@ static cec_event_t power_state_to_event(ps5_power_state_t state) {
     }
 }
 
+/**
+ * @brief Signal an eventfd (the counter just needs to become non-zero)
+ */
+static void signal_fd(int fd) {
+    if (fd >= 0) {
+        uint64_t one = 1;
+        ssize_t n = write(fd, &one, sizeof(one));
+        (void)n;    // EAGAIN: already signalled
+    }
+}
+
+/**
+ * @brief Take the oldest record (main thread)
+ * @return true if a record was taken
+ */
+static bool mailbox_pop(cec_record_t *record) {
+    unsigned int tail = g_cec_mailbox.tail;
+    unsigned int head = __atomic_load_n(&g_cec_mailbox.head, __ATOMIC_ACQUIRE);
+    
+    if (tail == head) {
+        return false;
+    }
+    
+    *record = g_cec_mailbox.records[tail % CEC_MAILBOX_SIZE];
+    __atomic_store_n(&g_cec_mailbox.tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Record the state of one successful query (monitor thread)
+ */
+static void set_current_state(ps5_power_state_t state) {
+    __atomic_store_n(&g_cec_ctx.current_power_state, state, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Wait out one poll interval (monitor thread)
+ *
+ * Ends early when stop() signals the wake fd. With the ioctl backend,
+ * messages the console broadcasts meanwhile are applied as they arrive.
+ */
+static void wait_interval(void) {
+    struct pollfd pfds[2];
+    nfds_t nfds = 1;
+    
+    pfds[0].fd = g_cec_mailbox.wake_fd;
+    pfds[0].events = POLLIN;
+    if (g_cec_backend == CEC_BACKEND_IOCTL && g_cec_fd >= 0) {
+        pfds[1].fd = g_cec_fd;
+        pfds[1].events = POLLIN;
+        nfds = 2;
+    }
+    
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t deadline_ms = (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000 + CEC_POLL_INTERVAL_MS;
+    
+    while (__atomic_load_n(&g_cec_ctx.running, __ATOMIC_ACQUIRE)) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int64_t remaining = deadline_ms - ((int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000);
+        if (remaining <= 0) {
+            return;
+        }
+        
+        int ret = poll(pfds, nfds, (int)remaining);
+        if (ret < 0 && errno != EINTR) {
+            return;
+        }
+        if (ret <= 0) {
+            continue;
+        }
+        if (pfds[0].revents & POLLIN) {
+            return;     // stop()
+        }
+        if (nfds == 2 && (pfds[1].revents & (POLLIN | POLLERR | POLLHUP))) {
+            ps5_power_state_t state;
+            if (receive_power_message(&state) != CEC_OK) {
+                nfds = 1;   // Unreadable: just sleep out the interval
+            } else if (state != PS5_POWER_UNKNOWN) {
+                set_current_state(state);
+                trigger_callback_if_changed();
+            }
+        }
+    }
+}
+
+#ifndef TESTING
+/**
+ * @brief Thread entry point
+ */
+static void *monitor_thread_main(void *arg) {
+    (void)arg;
+    thread_policy_apply(THREAD_CLASS_CEC);
+    cec_monitor_run();
+    return NULL;
+}
+#endif
+
 /**
  * @brief Trigger callback if state changed
+ *
+ * On the monitor thread the result is posted to the mailbox instead;
+ * every successful query is posted, so the main loop can see the bus
+ * is healthy.
  */
 static void trigger_callback_if_changed(void) {
-    if (g_cec_ctx.current_power_state != g_cec_ctx.previous_power_state) {
+    bool changed = (g_cec_ctx.current_power_state != g_cec_ctx.previous_power_state);
+    
+    if (g_cec_ctx.threaded) {
+        cec_event_t event = changed ? power_state_to_event(g_cec_ctx.current_power_state) : CEC_EVENT_NONE;
+        cec_monitor_post(event, g_cec_ctx.current_power_state);
+        g_cec_ctx.previous_power_state = g_cec_ctx.current_power_state;
+        return;
+    }
+    
+    if (changed) {
         if (g_cec_ctx.callback != NULL) {
             cec_event_t event = power_state_to_event(g_cec_ctx.current_power_state);
             g_cec_ctx.callback(event, g_cec_ctx.current_power_state, g_cec_ctx.user_data);
@@ -234,7 +518,7 @@ int cec_monitor_run(void) {
         return CEC_ERROR_NOT_INIT;
     }
     
-    g_cec_ctx.running = true;
+    __atomic_store_n(&g_cec_ctx.running, true, __ATOMIC_RELEASE);
     
     #ifndef TESTING
     fprintf(stdout, "[CEC] Starting monitoring loop...\n");
@@ -246,25 +530,39 @@ int cec_monitor_run(void) {
         .tv_nsec = (CEC_POLL_INTERVAL_MS % 1000) * 1000000
     };
     
-    while (g_cec_ctx.running) {
-        // Query power status
-        ps5_power_state_t state = query_power_status();
-        
-        if (state != PS5_POWER_UNKNOWN) {
-            g_cec_ctx.current_power_state = state;
-            trigger_callback_if_changed();
-            g_cec_ctx.error_count = 0;
-        } else {
-            g_cec_ctx.error_count++;
+    while (__atomic_load_n(&g_cec_ctx.running, __ATOMIC_ACQUIRE)) {
+        if (!__atomic_load_n(&g_cec_ctx.paused, __ATOMIC_ACQUIRE)) {
+            // Query power status
+            ps5_power_state_t state = query_power_status();
             
-            if (g_cec_ctx.error_count >= CEC_MAX_RETRY) {
-                nanosleep(&sleep_time, NULL);
+            if (state != PS5_POWER_UNKNOWN) {
+                set_current_state(state);
+                trigger_callback_if_changed();
                 g_cec_ctx.error_count = 0;
+            } else {
+                g_cec_ctx.error_count++;
+                if (g_cec_ctx.threaded) {
+                    cec_monitor_post(CEC_EVENT_ERROR, g_cec_ctx.current_power_state);
+                }
+                
+                if (g_cec_ctx.error_count >= CEC_MAX_RETRY) {
+                    if (g_cec_ctx.threaded) {
+                        wait_interval();
+                    } else {
+                        nanosleep(&sleep_time, NULL);
+                    }
+                    g_cec_ctx.error_count = 0;
+                }
             }
+            
+            g_cec_ctx.poll_count++;
         }
         
-        g_cec_ctx.poll_count++;
-        nanosleep(&sleep_time, NULL);
+        if (g_cec_ctx.threaded) {
+            wait_interval();
+        } else {
+            nanosleep(&sleep_time, NULL);
+        }
     }
     
     #ifndef TESTING
@@ -291,15 +589,135 @@ int cec_monitor_process(int timeout_ms) {
 }
 
 void cec_monitor_stop(void) {
-    g_cec_ctx.running = false;
+    __atomic_store_n(&g_cec_ctx.running, false, __ATOMIC_RELEASE);
+    
+    if (g_cec_ctx.thread_started) {
+        signal_fd(g_cec_mailbox.wake_fd);
+        pthread_join(g_cec_ctx.thread, NULL);
+        g_cec_ctx.thread_started = false;
+    }
+}
+
+int cec_monitor_start_thread(void) {
+    if (!g_cec_ctx.initialized) {
+        return CEC_ERROR_NOT_INIT;
+    }
+    if (g_cec_ctx.threaded) {
+        return CEC_OK;
+    }
+    
+    g_cec_mailbox.event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    g_cec_mailbox.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (g_cec_mailbox.event_fd < 0 || g_cec_mailbox.wake_fd < 0) {
+        if (g_cec_mailbox.event_fd >= 0) close(g_cec_mailbox.event_fd);
+        if (g_cec_mailbox.wake_fd >= 0) close(g_cec_mailbox.wake_fd);
+        g_cec_mailbox.event_fd = -1;
+        g_cec_mailbox.wake_fd = -1;
+        return CEC_ERROR_THREAD;
+    }
+    
+    g_cec_mailbox.head = 0;
+    g_cec_mailbox.tail = 0;
+    g_cec_mailbox.dropped = 0;
+    g_cec_ctx.threaded = true;
+    
+    #ifndef TESTING
+    // Mark running before the thread exists so an early stop() is not lost
+    __atomic_store_n(&g_cec_ctx.running, true, __ATOMIC_RELEASE);
+    if (pthread_create(&g_cec_ctx.thread, NULL, monitor_thread_main, NULL) != 0) {
+        fprintf(stderr, "[CEC] Failed to start monitor thread\n");
+        g_cec_ctx.running = false;
+        g_cec_ctx.threaded = false;
+        close(g_cec_mailbox.event_fd);
+        close(g_cec_mailbox.wake_fd);
+        g_cec_mailbox.event_fd = -1;
+        g_cec_mailbox.wake_fd = -1;
+        return CEC_ERROR_THREAD;
+    }
+    g_cec_ctx.thread_started = true;
+    fprintf(stdout, "[CEC] Monitor thread started\n");
+    #endif
+    
+    return CEC_OK;
+}
+
+int cec_monitor_get_event_fd(void) {
+    return g_cec_mailbox.event_fd;
+}
+
+int cec_monitor_post(cec_event_t event, ps5_power_state_t state) {
+    if (!g_cec_ctx.threaded) {
+        return CEC_ERROR_NOT_INIT;
+    }
+    
+    unsigned int head = g_cec_mailbox.head;
+    unsigned int tail = __atomic_load_n(&g_cec_mailbox.tail, __ATOMIC_ACQUIRE);
+    
+    if (head - tail >= CEC_MAILBOX_SIZE) {
+        // Only if the main loop stalled for about a minute; the state
+        // itself stays readable through cec_monitor_get_power_state()
+        __atomic_add_fetch(&g_cec_mailbox.dropped, 1, __ATOMIC_RELAXED);
+        return CEC_ERROR_MAILBOX_FULL;
+    }
+    
+    cec_record_t *record = &g_cec_mailbox.records[head % CEC_MAILBOX_SIZE];
+    record->event = event;
+    record->state = state;
+    record->timestamp = time(NULL);
+    __atomic_store_n(&g_cec_mailbox.head, head + 1, __ATOMIC_RELEASE);
+    
+    signal_fd(g_cec_mailbox.event_fd);
+    return CEC_OK;
+}
+
+int cec_monitor_dispatch(void) {
+    if (!g_cec_ctx.threaded) {
+        return CEC_ERROR_NOT_INIT;
+    }
+    
+    // Reset the wakeup before draining, so a post racing with us re-arms it
+    uint64_t count;
+    ssize_t n = read(g_cec_mailbox.event_fd, &count, sizeof(count));
+    (void)n;
+    
+    unsigned int dropped = __atomic_exchange_n(&g_cec_mailbox.dropped, 0, __ATOMIC_RELAXED);
+    if (dropped > 0) {
+        #ifndef TESTING
+        fprintf(stderr, "[CEC] Mailbox full, %u record(s) dropped\n", dropped);
+        #endif
+    }
+    
+    int result = CEC_ERROR_TIMEOUT;
+    cec_record_t record;
+    
+    while (mailbox_pop(&record)) {
+        if (record.event == CEC_EVENT_ERROR) {
+            result = CEC_ERROR_COMMAND_FAILED;
+            continue;
+        }
+        
+        result = CEC_OK;
+        if (record.event != CEC_EVENT_NONE) {
+            g_cec_ctx.last_update = record.timestamp;
+            if (g_cec_ctx.callback != NULL) {
+                g_cec_ctx.callback(record.event, record.state, g_cec_ctx.user_data);
+            }
+        }
+    }
+    
+    return result;
+}
+
+void cec_monitor_set_paused(bool paused) {
+    __atomic_store_n(&g_cec_ctx.paused, paused, __ATOMIC_RELEASE);
 }
 
 ps5_power_state_t cec_monitor_get_power_state(void) {
-    return g_cec_ctx.current_power_state;
+    return __atomic_load_n(&g_cec_ctx.current_power_state, __ATOMIC_ACQUIRE);
 }
 
 ps5_power_state_t cec_monitor_get_last_state(void) {
-    return g_cec_ctx.current_power_state;
+    return cec_monitor_get_power_state();
 }
 
 int cec_monitor_query_state(ps5_power_state_t *state) {
@@ -347,14 +765,42 @@ void cec_monitor_cleanup(void) {
         return;
     }
     
-    g_cec_ctx.running = false;
+    cec_monitor_stop();
     memset(&g_cec_ctx, 0, sizeof(cec_monitor_context_t));
     
+    if (g_cec_fd >= 0) {
+        close(g_cec_fd);
+        g_cec_fd = -1;
+    }
+    
+    if (g_cec_mailbox.event_fd >= 0) {
+        close(g_cec_mailbox.event_fd);
+    }
+    if (g_cec_mailbox.wake_fd >= 0) {
+        close(g_cec_mailbox.wake_fd);
+    }
+    memset(&g_cec_mailbox, 0, sizeof(g_cec_mailbox));
+    g_cec_mailbox.event_fd = -1;
+    g_cec_mailbox.wake_fd = -1;
+    
     #ifndef TESTING
     fprintf(stdout, "[CEC] Cleaned up\n");
     #endif
 }
 
+void cec_monitor_set_backend(cec_backend_t backend) {
+    g_cec_backend = backend;
+    
+    if (g_cec_fd >= 0) {
+        close(g_cec_fd);
+        g_cec_fd = -1;
+    }
+}
+
+cec_backend_t cec_monitor_get_backend(void) {
+    return g_cec_backend;
+}
+
 /* ============================================================
  *  String Conversion Functions
  * ============================================================ */
@@ -391,6 +837,15 @@ const char* cec_monitor_event_string(cec_event_t event) {
     return cec_event_to_string(event);
 }
 
+const char* cec_backend_to_string(cec_backend_t backend) {
+    switch (backend) {
+        case CEC_BACKEND_NONE:      return "none";
+        case CEC_BACKEND_COMMAND:   return "cec-ctl";
+        case CEC_BACKEND_IOCTL:     return "ioctl";
+        default:                    return "unknown";
+    }
+}
+
 const char* cec_monitor_error_string(int error) {
     switch (error) {
         case CEC_OK:                        return "OK";
@@ -399,6 +854,8 @@ const char* cec_monitor_error_string(int error) {
         case CEC_ERROR_INVALID_PARAM:       return "Invalid parameter";
         case CEC_ERROR_COMMAND_FAILED:      return "Command failed";
         case CEC_ERROR_TIMEOUT:             return "Timeout";
+        case CEC_ERROR_THREAD:              return "Thread error";
+        case CEC_ERROR_MAILBOX_FULL:        return "Mailbox full";
         case CEC_ERROR_UNKNOWN:             return "Unknown error";
         default:                            return "Invalid error code";
     }
@@ -31,8 +31,16 @@ extern "C" {
 #define CEC_ERROR_INVALID_PARAM        -3
 #define CEC_ERROR_COMMAND_FAILED       -4
 #define CEC_ERROR_TIMEOUT              -5
+#define CEC_ERROR_THREAD               -6
+#define CEC_ERROR_MAILBOX_FULL         -7
 #define CEC_ERROR_UNKNOWN              -99
 
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define CEC_MAILBOX_SIZE            64      /**< Records between the monitor thread and the main loop (power of 2) */
+
 /* ============================================================
  *  Type Definitions
  * ============================================================ */
@@ -62,6 +70,15 @@ typedef enum {
     CEC_EVENT_ERROR,              /**< Error occurred */
 } cec_event_t;
 
+/**
+ * @brief How power status is queried
+ */
+typedef enum {
+    CEC_BACKEND_NONE = 0,     /**< No CEC access */
+    CEC_BACKEND_COMMAND,      /**< Run cec-ctl */
+    CEC_BACKEND_IOCTL,        /**< CEC_TRANSMIT on the device node */
+} cec_backend_t;
+
 /**
  * @brief CEC event callback function type
  */
@@ -102,9 +119,67 @@ int cec_monitor_process(int timeout_ms);
 
 /**
  * @brief Stop the CEC monitor
+ *
+ * Wakes and joins the monitor thread if one was started.
  */
 void cec_monitor_stop(void);
 
+/**
+ * @brief Run cec_monitor_run() on its own thread
+ *
+ * The thread blocks on the CEC device (or the cec-ctl child) and posts
+ * every result to a lock-free single-producer/single-consumer mailbox,
+ * then signals the event fd. The callback is not called from the
+ * thread: cec_monitor_dispatch() delivers the records on the caller's
+ * thread.
+ *
+ * In TESTING no thread is created; records are fed with
+ * cec_monitor_post().
+ *
+ * @return CEC_OK on success, negative error code on failure
+ */
+int cec_monitor_start_thread(void);
+
+/**
+ * @brief Get the fd that becomes readable when records are waiting
+ * @return File descriptor, -1 if the thread was not started
+ */
+int cec_monitor_get_event_fd(void);
+
+/**
+ * @brief Deliver waiting records (main thread)
+ *
+ * Calls the callback for each power change, in order.
+ *
+ * @return CEC_OK if the latest query succeeded,
+ *         CEC_ERROR_COMMAND_FAILED if it failed,
+ *         CEC_ERROR_TIMEOUT if no record was waiting
+ */
+int cec_monitor_dispatch(void);
+
+/**
+ * @brief Post one record to the mailbox (monitor thread)
+ *
+ * Used by the monitor thread; exposed so the mailbox can be tested
+ * offline.
+ *
+ * @param event Power event, CEC_EVENT_NONE for a query without change,
+ *              CEC_EVENT_ERROR for a failed query
+ * @param state Power state
+ * @return CEC_OK on success, CEC_ERROR_MAILBOX_FULL if the main loop fell behind
+ */
+int cec_monitor_post(cec_event_t event, ps5_power_state_t state);
+
+/**
+ * @brief Pause or resume the monitor thread's queries
+ *
+ * Lets the caller's circuit breaker keep gating the bus while the
+ * queries run elsewhere.
+ *
+ * @param paused true to skip queries
+ */
+void cec_monitor_set_paused(bool paused);
+
 /**
  * @brief Get the current PS5 power state
  * @return Current PS5 power state
@@ -142,6 +217,18 @@ bool cec_monitor_device_available(const char *device_path);
  */
 void cec_monitor_cleanup(void);
 
+/**
+ * @brief Select the power query backend (default COMMAND)
+ * @param backend Backend, kept across cleanup
+ */
+void cec_monitor_set_backend(cec_backend_t backend);
+
+/**
+ * @brief Get the selected power query backend
+ * @return Backend
+ */
+cec_backend_t cec_monitor_get_backend(void);
+
 /* ============================================================
  *  String Conversion Functions
  * ============================================================ */
@@ -174,6 +261,13 @@ const char* cec_event_to_string(cec_event_t event);
  */
 const char* cec_monitor_event_string(cec_event_t event);
 
+/**
+ * @brief Convert CEC backend to string
+ * @param backend Backend
+ * @return String representation
+ */
+const char* cec_backend_to_string(cec_backend_t backend);
+
 /**
  * @brief Convert error code to string
  * @param error Error code
@@ -0,0 +1,164 @@
+/**
+ * @file circuit_breaker.c
+ * @brief Circuit Breaker Implementation - Closed / open / half-open
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "circuit_breaker.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+/**
+ * @brief Open the breaker for the current cool-down, then widen it
+ */
+static void trip(circuit_breaker_t *cb) {
+    cb->state = CB_STATE_OPEN;
+    cb->open_until_us = server_clock_monotonic_us() + (uint64_t)cb->cooldown_ms * 1000ULL;
+    cb->stats.opens++;
+
+    #ifndef TESTING
+    fprintf(stdout, "[Breaker] %s open for %u ms after %u failures\n",
+            cb->name, cb->cooldown_ms, cb->consecutive_failures);
+    #endif
+
+    cb->cooldown_ms *= 2;
+    if (cb->cooldown_ms > cb->max_cooldown_ms) {
+        cb->cooldown_ms = cb->max_cooldown_ms;
+    }
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int circuit_breaker_init(circuit_breaker_t *cb, const char *name,
+                         uint32_t failure_threshold,
+                         uint32_t base_cooldown_ms,
+                         uint32_t max_cooldown_ms) {
+    if (cb == NULL || name == NULL || failure_threshold == 0 ||
+        base_cooldown_ms == 0 || max_cooldown_ms < base_cooldown_ms) {
+        return CB_ERROR_INVALID_PARAM;
+    }
+
+    memset(cb, 0, sizeof(circuit_breaker_t));
+    snprintf(cb->name, sizeof(cb->name), "%s", name);
+    cb->failure_threshold = failure_threshold;
+    cb->base_cooldown_ms = base_cooldown_ms;
+    cb->max_cooldown_ms = max_cooldown_ms;
+    cb->cooldown_ms = base_cooldown_ms;
+    cb->state = CB_STATE_CLOSED;
+    cb->initialized = true;
+
+    return CB_OK;
+}
+
+bool circuit_breaker_allow(circuit_breaker_t *cb) {
+    if (cb == NULL || !cb->initialized) {
+        return true;  // No breaker configured: never block
+    }
+
+    switch (cb->state) {
+        case CB_STATE_CLOSED:
+            return true;
+
+        case CB_STATE_OPEN:
+            if (server_clock_monotonic_us() >= cb->open_until_us) {
+                cb->state = CB_STATE_HALF_OPEN;
+                return true;  // The trial call
+            }
+            cb->stats.rejected++;
+            return false;
+
+        case CB_STATE_HALF_OPEN:
+        default:
+            cb->stats.rejected++;
+            return false;  // Trial still outstanding
+    }
+}
+
+void circuit_breaker_record_success(circuit_breaker_t *cb) {
+    if (cb == NULL || !cb->initialized) {
+        return;
+    }
+
+    cb->stats.successes++;
+    cb->consecutive_failures = 0;
+
+    if (cb->state != CB_STATE_CLOSED) {
+        #ifndef TESTING
+        fprintf(stdout, "[Breaker] %s closed\n", cb->name);
+        #endif
+        cb->state = CB_STATE_CLOSED;
+    }
+    cb->cooldown_ms = cb->base_cooldown_ms;
+}
+
+void circuit_breaker_record_failure(circuit_breaker_t *cb) {
+    if (cb == NULL || !cb->initialized) {
+        return;
+    }
+
+    cb->stats.failures++;
+    cb->consecutive_failures++;
+
+    if (cb->state == CB_STATE_HALF_OPEN ||
+        (cb->state == CB_STATE_CLOSED && cb->consecutive_failures >= cb->failure_threshold)) {
+        trip(cb);
+    }
+}
+
+cb_state_t circuit_breaker_get_state(const circuit_breaker_t *cb) {
+    if (cb == NULL || !cb->initialized) {
+        return CB_STATE_CLOSED;
+    }
+    return cb->state;
+}
+
+uint32_t circuit_breaker_remaining_ms(const circuit_breaker_t *cb) {
+    if (cb == NULL || !cb->initialized || cb->state != CB_STATE_OPEN) {
+        return 0;
+    }
+
+    uint64_t now = server_clock_monotonic_us();
+    if (now >= cb->open_until_us) {
+        return 0;
+    }
+    return (uint32_t)((cb->open_until_us - now + 999ULL) / 1000ULL);
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* circuit_breaker_state_to_string(cb_state_t state) {
+    switch (state) {
+        case CB_STATE_CLOSED:       return "CLOSED";
+        case CB_STATE_OPEN:         return "OPEN";
+        case CB_STATE_HALF_OPEN:    return "HALF_OPEN";
+        default:                    return "UNKNOWN";
+    }
+}
+
+const char* circuit_breaker_error_string(int error) {
+    switch (error) {
+        case CB_OK:                     return "OK";
+        case CB_ERROR_NOT_INIT:         return "Not initialized";
+        case CB_ERROR_INVALID_PARAM:    return "Invalid parameter";
+        case CB_ERROR_UNKNOWN:          return "Unknown error";
+        default:                        return "Invalid error code";
+    }
+}
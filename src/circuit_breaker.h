@@ -0,0 +1,165 @@
+/**
+ * @file circuit_breaker.h
+ * @brief Circuit Breaker - Stop calling subsystems that keep failing
+ *
+ * One breaker guards one dependency (nmap scan, CEC queries, error
+ * recovery). The caller asks circuit_breaker_allow() before each call
+ * and reports the outcome:
+ *
+ *   CLOSED     calls pass; N consecutive failures open the breaker
+ *   OPEN       calls are rejected until the cool-down expires
+ *   HALF_OPEN  one trial call passes; success closes the breaker,
+ *              failure reopens it with a doubled cool-down (capped)
+ *
+ * Breakers are plain structs owned by the caller, so each subsystem
+ * keeps its own thresholds. Time comes from server_clock.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef CIRCUIT_BREAKER_H
+#define CIRCUIT_BREAKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define CB_OK                       0
+#define CB_ERROR_NOT_INIT          -1
+#define CB_ERROR_INVALID_PARAM     -2
+#define CB_ERROR_UNKNOWN           -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define CB_NAME_MAX_LEN             16
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Breaker state
+ */
+typedef enum {
+    CB_STATE_CLOSED = 0,        /**< Calls pass */
+    CB_STATE_OPEN,              /**< Calls rejected during cool-down */
+    CB_STATE_HALF_OPEN,         /**< One trial call in flight */
+} cb_state_t;
+
+/**
+ * @brief Breaker counters
+ */
+typedef struct {
+    uint32_t successes;         /**< Calls reported successful */
+    uint32_t failures;          /**< Calls reported failed */
+    uint32_t rejected;          /**< Calls refused while open */
+    uint32_t opens;             /**< Times the breaker opened */
+} cb_stats_t;
+
+/**
+ * @brief Circuit breaker (caller-owned)
+ */
+typedef struct {
+    char name[CB_NAME_MAX_LEN];
+    bool initialized;
+
+    // Configuration
+    uint32_t failure_threshold;     /**< Consecutive failures to open */
+    uint32_t base_cooldown_ms;      /**< First cool-down */
+    uint32_t max_cooldown_ms;       /**< Cool-down cap */
+
+    // State
+    cb_state_t state;
+    uint32_t consecutive_failures;
+    uint32_t cooldown_ms;           /**< Cool-down for the next open */
+    uint64_t open_until_us;
+
+    cb_stats_t stats;
+} circuit_breaker_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Initialize a breaker (closed)
+ * @param cb Breaker
+ * @param name Subsystem name for logs and stats
+ * @param failure_threshold Consecutive failures to open (>= 1)
+ * @param base_cooldown_ms First cool-down
+ * @param max_cooldown_ms Cool-down cap
+ * @return CB_OK on success, negative error code on failure
+ */
+int circuit_breaker_init(circuit_breaker_t *cb, const char *name,
+                         uint32_t failure_threshold,
+                         uint32_t base_cooldown_ms,
+                         uint32_t max_cooldown_ms);
+
+/**
+ * @brief Ask whether a call may go ahead
+ *
+ * An open breaker whose cool-down has expired moves to HALF_OPEN and
+ * lets exactly one trial through; further calls are refused until the
+ * trial's outcome is recorded.
+ *
+ * @param cb Breaker
+ * @return true if the call may proceed
+ */
+bool circuit_breaker_allow(circuit_breaker_t *cb);
+
+/**
+ * @brief Record a successful call (closes the breaker)
+ * @param cb Breaker
+ */
+void circuit_breaker_record_success(circuit_breaker_t *cb);
+
+/**
+ * @brief Record a failed call (may open the breaker)
+ * @param cb Breaker
+ */
+void circuit_breaker_record_failure(circuit_breaker_t *cb);
+
+/**
+ * @brief Get breaker state
+ * @param cb Breaker
+ * @return Current state
+ */
+cb_state_t circuit_breaker_get_state(const circuit_breaker_t *cb);
+
+/**
+ * @brief Time until an open breaker allows a trial
+ * @param cb Breaker
+ * @return Milliseconds (0 unless open)
+ */
+uint32_t circuit_breaker_remaining_ms(const circuit_breaker_t *cb);
+
+/**
+ * @brief Convert state to string
+ * @param state Breaker state
+ * @return State name string
+ */
+const char* circuit_breaker_state_to_string(cb_state_t state);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* circuit_breaker_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIRCUIT_BREAKER_H */
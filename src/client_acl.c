@@ -0,0 +1,339 @@
+/**
+ * @file client_acl.c
+ * @brief Client ACL Implementation
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "client_acl.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// POSIX headers
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define ACL_KEY_BITS        128
+#define ACL_V4_MAPPED_BITS  96      // ::ffff:0:0/96
+#define ACL_PREFIX_MAX_LEN  64      // Longest "addr/len" accepted
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+/**
+ * @brief One trie node per prefix bit; index 0 is the root
+ */
+typedef struct {
+    uint16_t child[2];                  // 0 = none (the root is never a child)
+    uint8_t perms;
+    bool terminal;                      // A prefix ends here
+} acl_node_t;
+
+typedef struct {
+    acl_node_t nodes[CLIENT_ACL_MAX_NODES];
+    uint32_t node_count;
+    uint32_t rule_count;
+    uint8_t default_perms;
+    client_acl_stats_t stats;
+    bool initialized;
+} client_acl_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static client_acl_context_t g_acl_ctx = {0};
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+static void map_ipv4(const struct in_addr *addr, uint8_t key[16]) {
+    memset(key, 0, 16);
+    key[10] = 0xFF;
+    key[11] = 0xFF;
+    memcpy(&key[12], &addr->s_addr, 4);
+}
+
+/**
+ * @brief Parse "addr[/len]" into a 128-bit key and prefix length
+ */
+static int parse_prefix(const char *prefix, uint8_t key[16], int *bits) {
+    char addr[ACL_PREFIX_MAX_LEN];
+    const char *slash = strchr(prefix, '/');
+    size_t addr_len = (slash != NULL) ? (size_t)(slash - prefix) : strlen(prefix);
+
+    if (addr_len == 0 || addr_len >= sizeof(addr)) {
+        return CLIENT_ACL_ERROR_INVALID_PARAM;
+    }
+    memcpy(addr, prefix, addr_len);
+    addr[addr_len] = '\0';
+
+    int max_len;
+    int offset;
+    struct in_addr v4;
+    struct in6_addr v6;
+
+    if (inet_pton(AF_INET, addr, &v4) == 1) {
+        map_ipv4(&v4, key);
+        max_len = 32;
+        offset = ACL_V4_MAPPED_BITS;
+    } else if (inet_pton(AF_INET6, addr, &v6) == 1) {
+        memcpy(key, v6.s6_addr, 16);
+        max_len = 128;
+        offset = 0;
+    } else {
+        return CLIENT_ACL_ERROR_INVALID_PARAM;
+    }
+
+    long len = max_len;
+    if (slash != NULL) {
+        char *end = NULL;
+        errno = 0;
+        len = strtol(slash + 1, &end, 10);
+        if (errno != 0 || end == slash + 1 || *end != '\0' || len < 0 || len > max_len) {
+            return CLIENT_ACL_ERROR_INVALID_PARAM;
+        }
+    }
+
+    *bits = offset + (int)len;
+    return CLIENT_ACL_OK;
+}
+
+static int key_bit(const uint8_t key[16], int bit) {
+    return (key[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+/**
+ * @brief Longest-prefix match
+ */
+static uint8_t lookup_key(const uint8_t key[16]) {
+    uint8_t perms = g_acl_ctx.default_perms;
+    uint32_t node = 0;
+
+    for (int bit = 0; ; bit++) {
+        const acl_node_t *n = &g_acl_ctx.nodes[node];
+        if (n->terminal) {
+            perms = n->perms;
+        }
+        if (bit == ACL_KEY_BITS) {
+            break;
+        }
+
+        node = n->child[key_bit(key, bit)];
+        if (node == 0) {
+            break;
+        }
+    }
+
+    return perms;
+}
+
+/**
+ * @brief Count a lookup made for an accepted peer
+ */
+static uint8_t account(uint8_t perms) {
+    g_acl_ctx.stats.lookups++;
+    if (perms == CLIENT_ACL_PERM_NONE) {
+        g_acl_ctx.stats.denied++;
+    } else if (!(perms & CLIENT_ACL_PERM_WAKE)) {
+        g_acl_ctx.stats.query_only++;
+    }
+    return perms;
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int client_acl_init(void) {
+    if (g_acl_ctx.initialized) {
+        return CLIENT_ACL_ERROR_NOT_INIT;
+    }
+
+    memset(&g_acl_ctx, 0, sizeof(client_acl_context_t));
+    g_acl_ctx.node_count = 1;                   // Root
+    g_acl_ctx.default_perms = CLIENT_ACL_PERM_NONE;
+    g_acl_ctx.initialized = true;
+
+    return CLIENT_ACL_OK;
+}
+
+int client_acl_add(const char *prefix, uint8_t perms) {
+    if (!g_acl_ctx.initialized) {
+        return CLIENT_ACL_ERROR_NOT_INIT;
+    }
+
+    if (prefix == NULL || (perms & ~CLIENT_ACL_PERM_ALL) != 0) {
+        return CLIENT_ACL_ERROR_INVALID_PARAM;
+    }
+
+    uint8_t key[16];
+    int bits;
+    int ret = parse_prefix(prefix, key, &bits);
+    if (ret != CLIENT_ACL_OK) {
+        return ret;
+    }
+
+    // Check the room first so a failed add leaves the trie unchanged
+    uint32_t node = 0;
+    int depth = 0;
+    while (depth < bits && g_acl_ctx.nodes[node].child[key_bit(key, depth)] != 0) {
+        node = g_acl_ctx.nodes[node].child[key_bit(key, depth)];
+        depth++;
+    }
+    if (g_acl_ctx.node_count + (uint32_t)(bits - depth) > CLIENT_ACL_MAX_NODES) {
+        return CLIENT_ACL_ERROR_FULL;
+    }
+
+    bool is_new = !(depth == bits && g_acl_ctx.nodes[node].terminal);
+    if (is_new && g_acl_ctx.rule_count >= CLIENT_ACL_MAX_RULES) {
+        return CLIENT_ACL_ERROR_FULL;
+    }
+
+    for (; depth < bits; depth++) {
+        uint32_t next = g_acl_ctx.node_count++;
+        memset(&g_acl_ctx.nodes[next], 0, sizeof(acl_node_t));
+        g_acl_ctx.nodes[node].child[key_bit(key, depth)] = (uint16_t)next;
+        node = next;
+    }
+
+    g_acl_ctx.nodes[node].terminal = true;
+    g_acl_ctx.nodes[node].perms = perms;
+    if (is_new) {
+        g_acl_ctx.rule_count++;
+    }
+
+    return CLIENT_ACL_OK;
+}
+
+int client_acl_add_rule(const char *rule) {
+    if (rule == NULL) {
+        return CLIENT_ACL_ERROR_INVALID_PARAM;
+    }
+
+    char prefix[ACL_PREFIX_MAX_LEN];
+    const char *eq = strchr(rule, '=');
+    size_t len = (eq != NULL) ? (size_t)(eq - rule) : strlen(rule);
+    if (len >= sizeof(prefix)) {
+        return CLIENT_ACL_ERROR_INVALID_PARAM;
+    }
+    memcpy(prefix, rule, len);
+    prefix[len] = '\0';
+
+    uint8_t perms = CLIENT_ACL_PERM_ALL;
+    if (eq != NULL) {
+        const char *name = eq + 1;
+        if (strcmp(name, "deny") == 0) {
+            perms = CLIENT_ACL_PERM_NONE;
+        } else if (strcmp(name, "query") == 0) {
+            perms = CLIENT_ACL_PERM_QUERY;
+        } else if (strcmp(name, "wake") == 0 || strcmp(name, "all") == 0) {
+            perms = CLIENT_ACL_PERM_ALL;
+        } else {
+            return CLIENT_ACL_ERROR_INVALID_PARAM;
+        }
+    }
+
+    return client_acl_add(prefix, perms);
+}
+
+void client_acl_set_default(uint8_t perms) {
+    g_acl_ctx.default_perms = perms & CLIENT_ACL_PERM_ALL;
+}
+
+uint8_t client_acl_check(const char *ip) {
+    if (!client_acl_is_active()) {
+        return CLIENT_ACL_PERM_ALL;
+    }
+
+    uint8_t key[16];
+    struct in_addr v4;
+    struct in6_addr v6;
+
+    if (ip != NULL && inet_pton(AF_INET, ip, &v4) == 1) {
+        map_ipv4(&v4, key);
+    } else if (ip != NULL && inet_pton(AF_INET6, ip, &v6) == 1) {
+        memcpy(key, v6.s6_addr, 16);
+    } else {
+        return account(CLIENT_ACL_PERM_NONE);
+    }
+
+    return account(lookup_key(key));
+}
+
+uint8_t client_acl_check_addr(const struct sockaddr *addr) {
+    if (!client_acl_is_active()) {
+        return CLIENT_ACL_PERM_ALL;
+    }
+
+    uint8_t key[16];
+
+    if (addr != NULL && addr->sa_family == AF_INET) {
+        map_ipv4(&((const struct sockaddr_in *)addr)->sin_addr, key);
+    } else if (addr != NULL && addr->sa_family == AF_INET6) {
+        memcpy(key, ((const struct sockaddr_in6 *)addr)->sin6_addr.s6_addr, 16);
+    } else {
+        return account(CLIENT_ACL_PERM_NONE);
+    }
+
+    return account(lookup_key(key));
+}
+
+bool client_acl_is_active(void) {
+    return g_acl_ctx.initialized && g_acl_ctx.rule_count > 0;
+}
+
+int client_acl_get_stats(client_acl_stats_t *stats) {
+    if (!g_acl_ctx.initialized) {
+        return CLIENT_ACL_ERROR_NOT_INIT;
+    }
+
+    if (stats == NULL) {
+        return CLIENT_ACL_ERROR_INVALID_PARAM;
+    }
+
+    *stats = g_acl_ctx.stats;
+    stats->rules = g_acl_ctx.rule_count;
+    stats->nodes = g_acl_ctx.node_count;
+    return CLIENT_ACL_OK;
+}
+
+void client_acl_cleanup(void) {
+    memset(&g_acl_ctx, 0, sizeof(client_acl_context_t));
+}
+
+const char* client_acl_perm_string(uint8_t perms) {
+    switch (perms & CLIENT_ACL_PERM_ALL) {
+        case CLIENT_ACL_PERM_NONE:      return "deny";
+        case CLIENT_ACL_PERM_QUERY:     return "query";
+        case CLIENT_ACL_PERM_WAKE:      return "wake-only";
+        default:                        return "wake";
+    }
+}
+
+const char* client_acl_error_string(int error) {
+    switch (error) {
+        case CLIENT_ACL_OK:                     return "OK";
+        case CLIENT_ACL_ERROR_NOT_INIT:         return "Not initialized";
+        case CLIENT_ACL_ERROR_INVALID_PARAM:    return "Invalid parameter";
+        case CLIENT_ACL_ERROR_FULL:             return "ACL full";
+        case CLIENT_ACL_ERROR_UNKNOWN:          return "Unknown error";
+        default:                                return "Invalid error code";
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * @file client_acl.h
+ * @brief Client ACL - Which peers may connect, query and wake
+ *
+ * Allow/deny rules for IPv4 and IPv6 prefixes, compiled into one binary
+ * trie (IPv4 is stored as ::ffff:a.b.c.d/96+len, so IPv4-mapped peers on
+ * a dual-stack socket match the IPv4 rules). The longest matching prefix
+ * decides; each rule carries a permission mask:
+ *
+ *   deny    closed right after accept, before the handshake
+ *   query   status queries, ping and stats
+ *   wake    query plus wake_ps5
+ *
+ * With no rules every peer may do everything. Once a rule exists, peers
+ * no rule matches get the default mask (deny unless changed).
+ *
+ * Rules are added at startup and only read afterwards.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef CLIENT_ACL_H
+#define CLIENT_ACL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define CLIENT_ACL_OK                   0
+#define CLIENT_ACL_ERROR_NOT_INIT      -1
+#define CLIENT_ACL_ERROR_INVALID_PARAM -2
+#define CLIENT_ACL_ERROR_FULL          -3
+#define CLIENT_ACL_ERROR_UNKNOWN       -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define CLIENT_ACL_PERM_NONE            0x00    /**< Deny */
+#define CLIENT_ACL_PERM_QUERY           0x01    /**< Status queries, ping, stats */
+#define CLIENT_ACL_PERM_WAKE            0x02    /**< wake_ps5 */
+#define CLIENT_ACL_PERM_ALL             (CLIENT_ACL_PERM_QUERY | CLIENT_ACL_PERM_WAKE)
+
+#define CLIENT_ACL_MAX_RULES            64
+#define CLIENT_ACL_MAX_NODES            4096    /**< Trie nodes (one per prefix bit) */
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Statistics
+ */
+typedef struct {
+    uint32_t rules;                     /**< Prefixes in the trie */
+    uint32_t nodes;                     /**< Trie nodes in use */
+    uint32_t lookups;                   /**< Peers checked */
+    uint32_t denied;                    /**< Peers rejected at accept */
+    uint32_t query_only;                /**< Peers admitted without wake */
+} client_acl_stats_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Initialize an empty ACL (everything allowed)
+ * @return CLIENT_ACL_OK on success, negative error code on failure
+ */
+int client_acl_init(void);
+
+/**
+ * @brief Add a prefix
+ *
+ * Adding the same prefix again replaces its mask.
+ *
+ * @param prefix "192.168.1.0/24", "fd00::/8", or a bare address (host)
+ * @param perms CLIENT_ACL_PERM_* mask
+ * @return CLIENT_ACL_OK on success, CLIENT_ACL_ERROR_FULL if out of nodes
+ */
+int client_acl_add(const char *prefix, uint8_t perms);
+
+/**
+ * @brief Add a rule in command-line form
+ * @param rule "PREFIX[=deny|query|wake]" (wake when omitted)
+ * @return CLIENT_ACL_OK on success, negative error code on failure
+ */
+int client_acl_add_rule(const char *rule);
+
+/**
+ * @brief Set the mask for peers no rule matches (used once a rule exists)
+ * @param perms CLIENT_ACL_PERM_* mask
+ */
+void client_acl_set_default(uint8_t perms);
+
+/**
+ * @brief Look up a peer given as a string
+ * @param ip IPv4 or IPv6 address
+ * @return Permission mask (CLIENT_ACL_PERM_ALL when no rules are set)
+ */
+uint8_t client_acl_check(const char *ip);
+
+/**
+ * @brief Look up a peer as returned by accept()
+ * @param addr AF_INET or AF_INET6 address
+ * @return Permission mask (CLIENT_ACL_PERM_ALL when no rules are set)
+ */
+uint8_t client_acl_check_addr(const struct sockaddr *addr);
+
+/**
+ * @brief Check whether any rule is set
+ * @return true if peers are filtered
+ */
+bool client_acl_is_active(void);
+
+/**
+ * @brief Get a snapshot of the statistics
+ * @param stats Pointer to store statistics
+ * @return CLIENT_ACL_OK on success, negative error code on failure
+ */
+int client_acl_get_stats(client_acl_stats_t *stats);
+
+/**
+ * @brief Drop all rules and release resources
+ */
+void client_acl_cleanup(void);
+
+/**
+ * @brief Convert a permission mask to string
+ * @param perms CLIENT_ACL_PERM_* mask
+ * @return "deny", "query", "wake" (query + wake) or "wake-only"
+ */
+const char* client_acl_perm_string(uint8_t perms);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* client_acl_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLIENT_ACL_H */
@@ -0,0 +1,299 @@
+/**
+ * @file coroutine.c
+ * @brief Coroutine Scheduler Implementation
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "coroutine.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// POSIX headers
+#include <poll.h>
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    coro_t *head;
+    coro_t *tail;
+    int count;                          // Active coroutines
+    int run_depth;                      // > 0 while coro_sched_run() walks the list
+} coro_sched_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static coro_sched_context_t g_sched_ctx = {0};
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+static void link_coro(coro_t *co) {
+    co->next = NULL;
+    co->linked = true;
+    if (g_sched_ctx.tail != NULL) {
+        g_sched_ctx.tail->next = co;
+    } else {
+        g_sched_ctx.head = co;
+    }
+    g_sched_ctx.tail = co;
+}
+
+/**
+ * @brief Unlink finished and cancelled coroutines (never during a pass)
+ */
+static void sweep(void) {
+    coro_t *prev = NULL;
+    coro_t *co = g_sched_ctx.head;
+
+    while (co != NULL) {
+        coro_t *next = co->next;
+        if (!co->active) {
+            if (prev != NULL) {
+                prev->next = next;
+            } else {
+                g_sched_ctx.head = next;
+            }
+            if (g_sched_ctx.tail == co) {
+                g_sched_ctx.tail = prev;
+            }
+            co->next = NULL;
+            co->linked = false;
+        } else {
+            prev = co;
+        }
+        co = next;
+    }
+}
+
+static void finish(coro_t *co) {
+    if (co->active) {
+        co->active = false;
+        g_sched_ctx.count--;
+    }
+    co->fds = NULL;
+    co->nfds = 0;
+}
+
+/**
+ * @brief Resume one coroutine
+ */
+static void resume(coro_t *co) {
+    if (co->fn(co) == CORO_DONE) {
+        finish(co);
+    }
+}
+
+/**
+ * @brief Decide whether a suspended coroutine may run now
+ */
+static bool is_due(coro_t *co, const struct pollfd *fds, int nfds, uint64_t now) {
+    if (co->fds != NULL && co->nfds > 0) {
+        bool ready = false;
+
+        if (co->poll_index >= 0 && co->poll_index + co->nfds <= nfds) {
+            for (int i = 0; i < co->nfds; i++) {
+                co->fds[i].revents = fds[co->poll_index + i].revents;
+                ready = ready || (co->fds[i].revents != 0);
+            }
+        } else {
+            // Did not fit in the caller's poll set
+            ready = (poll(co->fds, (nfds_t)co->nfds, 0) > 0);
+        }
+
+        if (ready) {
+            co->timed_out = false;
+            return true;
+        }
+    }
+
+    if (co->deadline_us != 0 && now >= co->deadline_us) {
+        co->timed_out = true;
+        return true;
+    }
+
+    return co->recheck;
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int coro_spawn(coro_t *co, coro_fn_t fn, void *arg) {
+    if (co == NULL || fn == NULL) {
+        return CORO_ERROR_INVALID_PARAM;
+    }
+
+    if (co->active) {
+        return CORO_ERROR_BUSY;
+    }
+
+    // A coroutine that ended in the current pass is still linked
+    bool linked = co->linked;
+    coro_t *next = co->next;
+
+    memset(co, 0, sizeof(coro_t));
+    co->fn = fn;
+    co->arg = arg;
+    co->poll_index = -1;
+    co->active = true;
+    g_sched_ctx.count++;
+
+    if (linked) {
+        co->linked = true;
+        co->next = next;
+    } else {
+        link_coro(co);
+    }
+
+    resume(co);
+    if (g_sched_ctx.run_depth == 0) {
+        sweep();
+    }
+    return CORO_OK;
+}
+
+void coro_cancel(coro_t *co) {
+    if (co == NULL || !co->active) {
+        return;
+    }
+
+    finish(co);
+    co->line = 0;
+    if (g_sched_ctx.run_depth == 0) {
+        sweep();
+    }
+}
+
+bool coro_is_running(const coro_t *co) {
+    return (co != NULL && co->active);
+}
+
+bool coro_timed_out(const coro_t *co) {
+    return (co != NULL && co->timed_out);
+}
+
+bool coro_wait_ended(const coro_t *co) {
+    if (co == NULL) {
+        return false;
+    }
+
+    bool ended = co->timed_out;
+    for (int i = 0; i < co->nfds && !ended; i++) {
+        ended = (co->fds[i].revents != 0);
+    }
+    return ended;
+}
+
+void coro_wait_set(coro_t *co, int timeout_ms, struct pollfd *fds, int nfds, bool recheck) {
+    co->deadline_us = (timeout_ms >= 0) ?
+                      server_clock_monotonic_us() + (uint64_t)timeout_ms * 1000ULL : 0;
+    co->fds = fds;
+    co->nfds = (fds != NULL) ? nfds : 0;
+    co->recheck = recheck;
+    co->timed_out = false;
+    co->poll_index = -1;
+
+    for (int i = 0; i < co->nfds; i++) {
+        fds[i].revents = 0;
+    }
+}
+
+int coro_sched_pollfds(struct pollfd *fds, int max) {
+    int n = 0;
+
+    for (coro_t *co = g_sched_ctx.head; co != NULL; co = co->next) {
+        co->poll_index = -1;
+        if (!co->active || co->fds == NULL || co->nfds == 0 || fds == NULL ||
+            n + co->nfds > max) {
+            continue;
+        }
+
+        co->poll_index = n;
+        for (int i = 0; i < co->nfds; i++) {
+            fds[n].fd = co->fds[i].fd;
+            fds[n].events = co->fds[i].events;
+            fds[n].revents = 0;
+            n++;
+        }
+    }
+
+    return n;
+}
+
+int coro_sched_timeout_ms(int max_ms) {
+    uint64_t now = server_clock_monotonic_us();
+    int timeout = max_ms;
+
+    for (coro_t *co = g_sched_ctx.head; co != NULL; co = co->next) {
+        if (!co->active || co->deadline_us == 0) {
+            continue;
+        }
+        if (co->deadline_us <= now) {
+            return 0;
+        }
+
+        uint64_t ms = (co->deadline_us - now + 999) / 1000;
+        if (ms < (uint64_t)timeout) {
+            timeout = (int)ms;
+        }
+    }
+
+    return timeout;
+}
+
+int coro_sched_run(const struct pollfd *fds, int nfds) {
+    uint64_t now = server_clock_monotonic_us();
+    int resumed = 0;
+
+    g_sched_ctx.run_depth++;
+
+    // Coroutines spawned during the pass are appended and already ran once
+    coro_t *last = g_sched_ctx.tail;
+    for (coro_t *co = g_sched_ctx.head; co != NULL; co = co->next) {
+        if (co->active && is_due(co, fds, nfds, now)) {
+            resume(co);
+            resumed++;
+        }
+        if (co == last) {
+            break;
+        }
+    }
+
+    g_sched_ctx.run_depth--;
+    if (g_sched_ctx.run_depth == 0) {
+        sweep();
+    }
+
+    return resumed;
+}
+
+int coro_sched_count(void) {
+    return g_sched_ctx.count;
+}
+
+const char* coro_error_string(int error) {
+    switch (error) {
+        case CORO_OK:                   return "OK";
+        case CORO_ERROR_NOT_INIT:       return "Not initialized";
+        case CORO_ERROR_INVALID_PARAM:  return "Invalid parameter";
+        case CORO_ERROR_BUSY:           return "Already running";
+        case CORO_ERROR_UNKNOWN:        return "Unknown error";
+        default:                        return "Invalid error code";
+    }
+}
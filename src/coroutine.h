@@ -0,0 +1,221 @@
+/**
+ * @file coroutine.h
+ * @brief Coroutines - Stackless multi-step flows on the main loop
+ *
+ * Protothread-style coroutines: a flow is an ordinary function written
+ * top to bottom, and each wait macro returns to the scheduler and later
+ * resumes on the line after it (a switch on the saved line number). No
+ * stack is kept, so anything that must survive a wait lives in the
+ * flow's own state struct, never in locals; a coroutine costs one
+ * coro_t and the flow state, and the caller owns both.
+ *
+ *   CORO_SLEEP_MS     resume after a delay
+ *   CORO_WAIT_FDS     resume when one of the fds is ready, or on timeout
+ *   CORO_WAIT_UNTIL   re-check a condition on every scheduler pass
+ *   CORO_WAIT_FDS_UNTIL  CORO_WAIT_FDS that also ends once a condition
+ *                     holds (for results another module delivers)
+ *   CORO_YIELD        let the rest of the loop run, resume on the next pass
+ *
+ * The main loop adds coro_sched_pollfds() to its poll set, bounds the
+ * wait with coro_sched_timeout_ms() and then calls coro_sched_run().
+ *
+ * Rules: at most one wait macro per source line, and no switch
+ * statement around a wait inside the flow body.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <poll.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define CORO_OK                         0
+#define CORO_ERROR_NOT_INIT            -1
+#define CORO_ERROR_INVALID_PARAM       -2
+#define CORO_ERROR_BUSY                -3
+#define CORO_ERROR_UNKNOWN             -99
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief What a flow function returns to the scheduler
+ */
+typedef enum {
+    CORO_WAITING = 0,           /**< Suspended in a wait macro */
+    CORO_DONE,                  /**< Reached CORO_END */
+} coro_status_t;
+
+typedef struct coro coro_t;
+
+/**
+ * @brief Flow function; state is reached through co->arg
+ */
+typedef coro_status_t (*coro_fn_t)(coro_t *co);
+
+/**
+ * @brief One coroutine (owned by the caller, linked into the scheduler)
+ */
+struct coro {
+    int line;                   /**< Resume point, 0 = start */
+    coro_fn_t fn;               /**< Flow function */
+    void *arg;                  /**< Flow state */
+
+    // Current wait
+    uint64_t deadline_us;       /**< Resume at this time, 0 = no timer */
+    struct pollfd *fds;         /**< Resume when one is ready (owned by the flow) */
+    int nfds;
+    bool recheck;               /**< Resume on every pass (CORO_WAIT_UNTIL / CORO_YIELD) */
+    bool timed_out;             /**< Last wait ended by its deadline */
+
+    // Scheduler bookkeeping
+    int poll_index;             /**< Position in the last coro_sched_pollfds() set, -1 = none */
+    bool active;                /**< Still to be resumed */
+    bool linked;                /**< In the scheduler list (unlinked after the pass it ends in) */
+    coro_t *next;
+};
+
+/* ============================================================
+ *  Flow Macros
+ * ============================================================ */
+
+#define CORO_BEGIN(co)          switch ((co)->line) { case 0:
+
+#define CORO_END(co)            } (co)->line = 0; return CORO_DONE
+
+/** Suspend here; resumes at the next label with the same line */
+#define CORO_SUSPEND_(co)       do { (co)->line = __LINE__; return CORO_WAITING; case __LINE__:; } while (0)
+
+#define CORO_YIELD(co) \
+    do { coro_wait_set((co), -1, NULL, 0, true); CORO_SUSPEND_(co); } while (0)
+
+#define CORO_SLEEP_MS(co, ms) \
+    do { coro_wait_set((co), (ms), NULL, 0, false); CORO_SUSPEND_(co); } while (0)
+
+/** timeout_ms < 0 waits without a timer; check coro_timed_out() afterwards */
+#define CORO_WAIT_FDS(co, fds, n, timeout_ms) \
+    do { coro_wait_set((co), (timeout_ms), (fds), (n), false); CORO_SUSPEND_(co); } while (0)
+
+#define CORO_WAIT_UNTIL(co, cond) \
+    do { if (!(cond)) { coro_wait_set((co), -1, NULL, 0, true); CORO_SUSPEND_(co); \
+                        if (!(cond)) { return CORO_WAITING; } } } while (0)
+
+/** CORO_WAIT_FDS that also resumes once cond holds (re-checked on every pass) */
+#define CORO_WAIT_FDS_UNTIL(co, fds, n, timeout_ms, cond) \
+    do { if (!(cond)) { coro_wait_set((co), (timeout_ms), (fds), (n), true); CORO_SUSPEND_(co); \
+                        if (!(cond) && !coro_wait_ended(co)) { return CORO_WAITING; } } } while (0)
+
+/** Finish the flow from anywhere in its body */
+#define CORO_EXIT(co)           do { (co)->line = 0; return CORO_DONE; } while (0)
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Start a coroutine and run it up to its first wait
+ * @param co Coroutine storage (must stay valid until it is done or cancelled)
+ * @param fn Flow function
+ * @param arg Flow state
+ * @return CORO_OK on success, CORO_ERROR_BUSY if co is already running
+ */
+int coro_spawn(coro_t *co, coro_fn_t fn, void *arg);
+
+/**
+ * @brief Remove a coroutine without resuming it again
+ *
+ * The flow's own resources (sockets, jobs) are the caller's to release.
+ *
+ * @param co Coroutine
+ */
+void coro_cancel(coro_t *co);
+
+/**
+ * @brief Check whether a coroutine is still in flight
+ * @param co Coroutine
+ * @return true until CORO_END or coro_cancel()
+ */
+bool coro_is_running(const coro_t *co);
+
+/**
+ * @brief Check whether the last wait ended by its deadline
+ * @param co Coroutine
+ * @return true on timeout
+ */
+bool coro_timed_out(const coro_t *co);
+
+/**
+ * @brief Check whether the last fd wait ended by readiness or its deadline
+ * @param co Coroutine
+ * @return true if an fd is ready or the wait timed out (used by CORO_WAIT_FDS_UNTIL)
+ */
+bool coro_wait_ended(const coro_t *co);
+
+/**
+ * @brief Arm the next wait (used by the wait macros)
+ * @param co Coroutine
+ * @param timeout_ms Timer, < 0 for none
+ * @param fds Fds to wait on (can be NULL)
+ * @param nfds Number of fds
+ * @param recheck Resume on every pass
+ */
+void coro_wait_set(coro_t *co, int timeout_ms, struct pollfd *fds, int nfds, bool recheck);
+
+/**
+ * @brief Copy the fds coroutines wait on into the caller's poll set
+ *
+ * Coroutines whose fds do not fit are polled by coro_sched_run() itself.
+ *
+ * @param fds Output array
+ * @param max Capacity
+ * @return Number of entries written
+ */
+int coro_sched_pollfds(struct pollfd *fds, int max);
+
+/**
+ * @brief Longest the main loop may wait before a coroutine is due
+ * @param max_ms Upper bound
+ * @return Timeout in milliseconds (0 if one is due now)
+ */
+int coro_sched_timeout_ms(int max_ms);
+
+/**
+ * @brief Resume every coroutine whose wait is over
+ * @param fds The poll set filled by coro_sched_pollfds(), after poll()
+ * @param nfds Number of entries
+ * @return Number of coroutines resumed
+ */
+int coro_sched_run(const struct pollfd *fds, int nfds);
+
+/**
+ * @brief Number of coroutines in flight
+ * @return Count
+ */
+int coro_sched_count(void);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* coro_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COROUTINE_H */
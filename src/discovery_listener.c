@@ -0,0 +1,654 @@
+/**
+ * @file discovery_listener.c
+ * @brief Discovery Listener Implementation - DDP / SSDP / mDNS parsing
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE     // struct ip_mreq
+
+#include "discovery_listener.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <errno.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define DISCOVERY_MAX_SOCKETS   4       // DDP x2, SSDP, mDNS
+#define DDP_STATUS_ON           200
+#define DDP_STATUS_STANDBY      620
+#define DNS_HEADER_LEN          12
+#define DNS_FLAG_RESPONSE       0x8000
+#define DNS_TYPE_A              1
+#define DNS_TYPE_PTR            12
+#define DNS_TYPE_SRV            33
+#define DNS_MAX_NAME            256
+#define DNS_MAX_POINTER_HOPS    16
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    int fd;
+    discovery_proto_t proto;
+} discovery_socket_t;
+
+typedef struct {
+    bool initialized;
+    discovery_socket_t sockets[DISCOVERY_MAX_SOCKETS];
+    int socket_count;
+
+    discovery_callback_t callback;
+    void *callback_user_data;
+
+    discovery_stats_t stats;
+} discovery_listener_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static discovery_listener_context_t g_discovery_ctx = {0};
+
+/* ============================================================
+ *  Helper Functions - Text
+ * ============================================================ */
+
+/**
+ * @brief Case-insensitive substring search
+ */
+static const char* find_nocase(const char *haystack, const char *needle) {
+    size_t n = strlen(needle);
+    for (; *haystack != '\0'; haystack++) {
+        if (strncasecmp(haystack, needle, n) == 0) {
+            return haystack;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Text names a PS5 ("PlayStation 5", "PlayStation5" or a "PS5" token)
+ */
+static bool mentions_ps5(const char *text) {
+    if (find_nocase(text, "playstation 5") != NULL || find_nocase(text, "playstation5") != NULL) {
+        return true;
+    }
+
+    for (const char *p = text; (p = find_nocase(p, "ps5")) != NULL; p++) {
+        bool starts = (p == text) || !isalnum((unsigned char)p[-1]);
+        bool ends = !isalnum((unsigned char)p[3]);
+        if (starts && ends) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Copy a datagram into a NUL-terminated buffer
+ */
+static void copy_text(char *dst, size_t dst_size, const char *data, size_t len) {
+    if (len >= dst_size) {
+        len = dst_size - 1;
+    }
+    memcpy(dst, data, len);
+    dst[len] = '\0';
+}
+
+/**
+ * @brief Find "key: value" among CRLF / LF separated header lines
+ * @return true if found; value is trimmed
+ */
+static bool get_header(const char *text, const char *key, char *value, size_t value_size) {
+    size_t key_len = strlen(key);
+    const char *line = text;
+
+    while (line != NULL && *line != '\0') {
+        const char *end = strchr(line, '\n');
+        size_t line_len = end ? (size_t)(end - line) : strlen(line);
+
+        if (line_len > key_len && strncasecmp(line, key, key_len) == 0 && line[key_len] == ':') {
+            const char *v = line + key_len + 1;
+            const char *v_end = line + line_len;
+            while (v < v_end && (*v == ' ' || *v == '\t')) {
+                v++;
+            }
+            while (v_end > v && (v_end[-1] == '\r' || v_end[-1] == ' ' || v_end[-1] == '\t')) {
+                v_end--;
+            }
+            snprintf(value, value_size, "%.*s", (int)(v_end - v), v);
+            return true;
+        }
+
+        line = end ? end + 1 : NULL;
+    }
+
+    return false;
+}
+
+/**
+ * @brief DDP host-id is the console's MAC as 12 hex digits
+ */
+static void mac_from_host_id(const char *host_id, char *mac, size_t mac_size) {
+    mac[0] = '\0';
+
+    if (strlen(host_id) != 12) {
+        return;
+    }
+    for (int i = 0; i < 12; i++) {
+        if (!isxdigit((unsigned char)host_id[i])) {
+            return;
+        }
+    }
+
+    char lower[13];
+    for (int i = 0; i < 12; i++) {
+        lower[i] = (char)tolower((unsigned char)host_id[i]);
+    }
+    lower[12] = '\0';
+
+    snprintf(mac, mac_size, "%.2s:%.2s:%.2s:%.2s:%.2s:%.2s",
+             lower, lower + 2, lower + 4, lower + 6, lower + 8, lower + 10);
+}
+
+static void init_sighting(discovery_sighting_t *sighting, discovery_proto_t proto, const char *src_ip) {
+    memset(sighting, 0, sizeof(discovery_sighting_t));
+    sighting->proto = proto;
+    sighting->status = DISCOVERY_STATUS_UNKNOWN;
+    snprintf(sighting->ip, sizeof(sighting->ip), "%s", src_ip ? src_ip : "");
+}
+
+/* ============================================================
+ *  Helper Functions - DNS
+ * ============================================================ */
+
+static uint16_t read_u16(const uint8_t *p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t read_u32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief Decode a (possibly compressed) DNS name into dotted form
+ * @return Offset just past the name at its original position, -1 if malformed
+ */
+static int read_dns_name(const uint8_t *data, size_t len, size_t off, char *out, size_t out_size) {
+    size_t pos = off;
+    size_t out_len = 0;
+    int end = -1;
+    int hops = 0;
+
+    out[0] = '\0';
+
+    while (pos < len) {
+        uint8_t label_len = data[pos];
+
+        if (label_len == 0) {
+            return (end >= 0) ? end : (int)(pos + 1);
+        }
+
+        if ((label_len & 0xC0) == 0xC0) {
+            if (pos + 1 >= len || ++hops > DNS_MAX_POINTER_HOPS) {
+                return -1;
+            }
+            if (end < 0) {
+                end = (int)(pos + 2);
+            }
+            pos = ((size_t)(label_len & 0x3F) << 8) | data[pos + 1];
+            continue;
+        }
+
+        if (label_len > 63 || pos + 1 + label_len > len) {
+            return -1;
+        }
+
+        if (out_len + label_len + 2 < out_size) {
+            if (out_len > 0) {
+                out[out_len++] = '.';
+            }
+            memcpy(out + out_len, data + pos + 1, label_len);
+            out_len += label_len;
+            out[out_len] = '\0';
+        }
+        pos += 1 + (size_t)label_len;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Remember a name whose first label names a PS5
+ */
+static bool match_dns_name(const char *name, discovery_sighting_t *sighting) {
+    char label[DISCOVERY_NAME_MAX_LEN];
+    const char *dot = strchr(name, '.');
+    size_t n = dot ? (size_t)(dot - name) : strlen(name);
+
+    snprintf(label, sizeof(label), "%.*s", (int)n, name);
+    if (!mentions_ps5(label)) {
+        return false;
+    }
+
+    if (sighting->name[0] == '\0') {
+        snprintf(sighting->name, sizeof(sighting->name), "%s", label);
+    }
+    return true;
+}
+
+/* ============================================================
+ *  Public API Implementation - Parsers
+ * ============================================================ */
+
+bool discovery_parse_ddp(const char *data, size_t len, const char *src_ip,
+                         discovery_sighting_t *sighting) {
+    if (data == NULL || sighting == NULL || len == 0) {
+        return false;
+    }
+
+    char text[DISCOVERY_MAX_PACKET + 1];
+    copy_text(text, sizeof(text), data, len);
+
+    // Replies only: "HTTP/1.1 200 Ok" or "HTTP/1.1 620 Server Standby"
+    int code = 0;
+    if (sscanf(text, "HTTP/1.1 %d", &code) != 1) {
+        return false;
+    }
+
+    char value[DISCOVERY_NAME_MAX_LEN];
+    if (!get_header(text, "host-type", value, sizeof(value)) || strcasecmp(value, "PS5") != 0) {
+        return false;
+    }
+
+    init_sighting(sighting, DISCOVERY_PROTO_DDP, src_ip);
+
+    if (code == DDP_STATUS_ON) {
+        sighting->status = DISCOVERY_STATUS_ON;
+    } else if (code == DDP_STATUS_STANDBY) {
+        sighting->status = DISCOVERY_STATUS_STANDBY;
+    }
+
+    if (get_header(text, "host-id", sighting->host_id, sizeof(sighting->host_id))) {
+        mac_from_host_id(sighting->host_id, sighting->mac, sizeof(sighting->mac));
+    }
+    get_header(text, "host-name", sighting->name, sizeof(sighting->name));
+
+    return true;
+}
+
+bool discovery_parse_ssdp(const char *data, size_t len, const char *src_ip,
+                          discovery_sighting_t *sighting) {
+    if (data == NULL || sighting == NULL || len == 0) {
+        return false;
+    }
+
+    char text[DISCOVERY_MAX_PACKET + 1];
+    copy_text(text, sizeof(text), data, len);
+
+    // Announcements and search responses; other searchers' M-SEARCH say nothing about the console
+    if (strncmp(text, "NOTIFY ", 7) != 0 && strncmp(text, "HTTP/1.1 200", 12) != 0) {
+        return false;
+    }
+
+    static const char *const id_headers[] = { "SERVER", "USN", "NT", "ST" };
+    char value[DISCOVERY_MAX_PACKET];
+    bool is_ps5 = false;
+
+    for (size_t i = 0; i < sizeof(id_headers) / sizeof(id_headers[0]) && !is_ps5; i++) {
+        is_ps5 = get_header(text, id_headers[i], value, sizeof(value)) && mentions_ps5(value);
+    }
+    if (!is_ps5) {
+        return false;
+    }
+
+    init_sighting(sighting, DISCOVERY_PROTO_SSDP, src_ip);
+
+    if (get_header(text, "NTS", value, sizeof(value)) && strcasecmp(value, "ssdp:byebye") == 0) {
+        sighting->status = DISCOVERY_STATUS_GONE;
+    }
+
+    // USN: uuid:<device-uuid>[::<type>]
+    if (get_header(text, "USN", value, sizeof(value)) && strncasecmp(value, "uuid:", 5) == 0) {
+        const char *uuid = value + 5;
+        const char *sep = strstr(uuid, "::");
+        size_t n = sep ? (size_t)(sep - uuid) : strlen(uuid);
+        snprintf(sighting->host_id, sizeof(sighting->host_id), "%.*s", (int)n, uuid);
+    }
+
+    return true;
+}
+
+bool discovery_parse_mdns(const uint8_t *data, size_t len, const char *src_ip,
+                          discovery_sighting_t *sighting) {
+    if (data == NULL || sighting == NULL || len < DNS_HEADER_LEN) {
+        return false;
+    }
+
+    if ((read_u16(data + 2) & DNS_FLAG_RESPONSE) == 0) {
+        return false;  // Queries come from anyone
+    }
+
+    uint16_t questions = read_u16(data + 4);
+    uint32_t records = (uint32_t)read_u16(data + 6) + read_u16(data + 8) + read_u16(data + 10);
+
+    char name[DNS_MAX_NAME];
+    int off = DNS_HEADER_LEN;
+
+    for (uint16_t i = 0; i < questions; i++) {
+        off = read_dns_name(data, len, (size_t)off, name, sizeof(name));
+        if (off < 0 || (size_t)off + 4 > len) {
+            return false;
+        }
+        off += 4;  // QTYPE, QCLASS
+    }
+
+    init_sighting(sighting, DISCOVERY_PROTO_MDNS, src_ip);
+
+    bool matched = false;
+    bool have_a = false;
+    bool goodbye = false;
+
+    for (uint32_t i = 0; i < records; i++) {
+        off = read_dns_name(data, len, (size_t)off, name, sizeof(name));
+        if (off < 0 || (size_t)off + 10 > len) {
+            break;
+        }
+
+        uint16_t type = read_u16(data + off);
+        uint32_t ttl = read_u32(data + off + 4);
+        uint16_t rdlen = read_u16(data + off + 8);
+        size_t rdata = (size_t)off + 10;
+        if (rdata + rdlen > len) {
+            break;
+        }
+        off = (int)(rdata + rdlen);
+
+        bool hit = match_dns_name(name, sighting);
+
+        if (type == DNS_TYPE_A && rdlen == 4 && hit && !have_a) {
+            // The console's own address record beats the sender address
+            inet_ntop(AF_INET, data + rdata, sighting->ip, sizeof(sighting->ip));
+            have_a = true;
+        } else if (type == DNS_TYPE_PTR && !hit) {
+            hit = read_dns_name(data, len, rdata, name, sizeof(name)) >= 0 &&
+                  match_dns_name(name, sighting);
+        } else if (type == DNS_TYPE_SRV && rdlen > 6 && !hit) {
+            hit = read_dns_name(data, len, rdata + 6, name, sizeof(name)) >= 0 &&
+                  match_dns_name(name, sighting);
+        }
+
+        if (hit) {
+            matched = true;
+            goodbye = goodbye || (ttl == 0);
+        }
+    }
+
+    if (matched && goodbye) {
+        sighting->status = DISCOVERY_STATUS_GONE;
+    }
+    return matched;
+}
+
+/* ============================================================
+ *  Helper Functions - Sockets
+ * ============================================================ */
+
+#ifndef TESTING
+
+/**
+ * @brief Open a non-blocking UDP socket on port, joined to group if given
+ */
+static int open_listener(uint16_t port, const char *group) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    // Other SSDP / mDNS stacks on the router already own these ports
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    if (group != NULL) {
+        struct ip_mreq mreq;
+        memset(&mreq, 0, sizeof(mreq));
+        inet_pton(AF_INET, group, &mreq.imr_multiaddr);
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+
+        if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) {
+            close(fd);
+            return -1;
+        }
+    }
+
+    return fd;
+}
+
+static void add_listener(discovery_proto_t proto, uint16_t port, const char *group) {
+    int fd = open_listener(port, group);
+    if (fd < 0) {
+        fprintf(stderr, "[Discovery] Cannot listen on %s port %u: %s\n",
+                discovery_proto_to_string(proto), port, strerror(errno));
+        return;
+    }
+
+    g_discovery_ctx.sockets[g_discovery_ctx.socket_count].fd = fd;
+    g_discovery_ctx.sockets[g_discovery_ctx.socket_count].proto = proto;
+    g_discovery_ctx.socket_count++;
+    g_discovery_ctx.stats.listening_mask |= DISCOVERY_MASK(proto);
+}
+
+#endif /* !TESTING */
+
+/**
+ * @brief Parse one datagram and report it if it is a PS5
+ */
+static bool handle_datagram(discovery_proto_t proto, const uint8_t *data, size_t len,
+                            const char *src_ip) {
+    discovery_sighting_t sighting;
+    bool found = false;
+
+    switch (proto) {
+        case DISCOVERY_PROTO_DDP:
+            found = discovery_parse_ddp((const char*)data, len, src_ip, &sighting);
+            break;
+        case DISCOVERY_PROTO_SSDP:
+            found = discovery_parse_ssdp((const char*)data, len, src_ip, &sighting);
+            break;
+        case DISCOVERY_PROTO_MDNS:
+            found = discovery_parse_mdns(data, len, src_ip, &sighting);
+            break;
+        default:
+            break;
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    g_discovery_ctx.stats.sightings[proto]++;
+    g_discovery_ctx.stats.last_sighting = server_clock_now();
+
+    if (g_discovery_ctx.callback != NULL) {
+        g_discovery_ctx.callback(&sighting, g_discovery_ctx.callback_user_data);
+    }
+    return true;
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int discovery_listener_init(uint32_t proto_mask) {
+    if (g_discovery_ctx.initialized) {
+        return DISCOVERY_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    if ((proto_mask & DISCOVERY_MASK_ALL) == 0) {
+        return DISCOVERY_ERROR_INVALID_PARAM;
+    }
+
+    memset(&g_discovery_ctx, 0, sizeof(discovery_listener_context_t));
+
+    #ifdef TESTING
+    // In test mode, no sockets; datagrams are fed to the parsers directly
+    g_discovery_ctx.stats.listening_mask = proto_mask & DISCOVERY_MASK_ALL;
+    #else
+    if (proto_mask & DISCOVERY_MASK(DISCOVERY_PROTO_DDP)) {
+        add_listener(DISCOVERY_PROTO_DDP, DISCOVERY_DDP_PORT, NULL);
+        add_listener(DISCOVERY_PROTO_DDP, DISCOVERY_DDP_LEGACY_PORT, NULL);
+    }
+    if (proto_mask & DISCOVERY_MASK(DISCOVERY_PROTO_SSDP)) {
+        add_listener(DISCOVERY_PROTO_SSDP, DISCOVERY_SSDP_PORT, DISCOVERY_SSDP_GROUP);
+    }
+    if (proto_mask & DISCOVERY_MASK(DISCOVERY_PROTO_MDNS)) {
+        add_listener(DISCOVERY_PROTO_MDNS, DISCOVERY_MDNS_PORT, DISCOVERY_MDNS_GROUP);
+    }
+
+    if (g_discovery_ctx.socket_count == 0) {
+        return DISCOVERY_ERROR_SOCKET;
+    }
+
+    fprintf(stdout, "[Discovery] Listening on%s%s%s\n",
+            (g_discovery_ctx.stats.listening_mask & DISCOVERY_MASK(DISCOVERY_PROTO_DDP)) ? " ddp" : "",
+            (g_discovery_ctx.stats.listening_mask & DISCOVERY_MASK(DISCOVERY_PROTO_SSDP)) ? " ssdp" : "",
+            (g_discovery_ctx.stats.listening_mask & DISCOVERY_MASK(DISCOVERY_PROTO_MDNS)) ? " mdns" : "");
+    #endif
+
+    g_discovery_ctx.initialized = true;
+    return DISCOVERY_OK;
+}
+
+void discovery_listener_set_callback(discovery_callback_t callback, void *user_data) {
+    g_discovery_ctx.callback = callback;
+    g_discovery_ctx.callback_user_data = user_data;
+}
+
+int discovery_listener_process(void) {
+    if (!g_discovery_ctx.initialized) {
+        return DISCOVERY_ERROR_NOT_INIT;
+    }
+
+    int reported = 0;
+    uint8_t buf[DISCOVERY_MAX_PACKET];
+
+    for (int s = 0; s < g_discovery_ctx.socket_count; s++) {
+        discovery_socket_t *sock = &g_discovery_ctx.sockets[s];
+
+        for (int n = 0; n < DISCOVERY_MAX_PACKETS_PER_CALL; n++) {
+            struct sockaddr_in from;
+            socklen_t from_len = sizeof(from);
+            ssize_t len = recvfrom(sock->fd, buf, sizeof(buf), MSG_DONTWAIT,
+                                   (struct sockaddr*)&from, &from_len);
+            if (len <= 0) {
+                break;  // EAGAIN: drained
+            }
+
+            g_discovery_ctx.stats.packets++;
+
+            char src_ip[DISCOVERY_IP_MAX_LEN];
+            inet_ntop(AF_INET, &from.sin_addr, src_ip, sizeof(src_ip));
+
+            if (handle_datagram(sock->proto, buf, (size_t)len, src_ip)) {
+                reported++;
+            }
+        }
+    }
+
+    return reported;
+}
+
+int discovery_listener_get_stats(discovery_stats_t *stats) {
+    if (!g_discovery_ctx.initialized) {
+        return DISCOVERY_ERROR_NOT_INIT;
+    }
+
+    if (stats == NULL) {
+        return DISCOVERY_ERROR_INVALID_PARAM;
+    }
+
+    memcpy(stats, &g_discovery_ctx.stats, sizeof(discovery_stats_t));
+    return DISCOVERY_OK;
+}
+
+void discovery_listener_cleanup(void) {
+    if (!g_discovery_ctx.initialized) {
+        return;
+    }
+
+    for (int s = 0; s < g_discovery_ctx.socket_count; s++) {
+        close(g_discovery_ctx.sockets[s].fd);
+    }
+    memset(&g_discovery_ctx, 0, sizeof(discovery_listener_context_t));
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* discovery_proto_to_string(discovery_proto_t proto) {
+    switch (proto) {
+        case DISCOVERY_PROTO_DDP:   return "ddp";
+        case DISCOVERY_PROTO_SSDP:  return "ssdp";
+        case DISCOVERY_PROTO_MDNS:  return "mdns";
+        default:                    return "unknown";
+    }
+}
+
+const char* discovery_status_to_string(discovery_status_t status) {
+    switch (status) {
+        case DISCOVERY_STATUS_UNKNOWN:  return "UNKNOWN";
+        case DISCOVERY_STATUS_ON:       return "ON";
+        case DISCOVERY_STATUS_STANDBY:  return "STANDBY";
+        case DISCOVERY_STATUS_GONE:     return "GONE";
+        default:                        return "INVALID";
+    }
+}
+
+const char* discovery_listener_error_string(int error) {
+    switch (error) {
+        case DISCOVERY_OK:                  return "OK";
+        case DISCOVERY_ERROR_NOT_INIT:      return "Not initialized";
+        case DISCOVERY_ERROR_INVALID_PARAM: return "Invalid parameter";
+        case DISCOVERY_ERROR_SOCKET:        return "Socket error";
+        case DISCOVERY_ERROR_UNKNOWN:       return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
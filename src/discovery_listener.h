@@ -0,0 +1,213 @@
+/**
+ * @file discovery_listener.h
+ * @brief Discovery Listener - Passive PS5 sightings from LAN announcements
+ *
+ * Listens, without sending anything, on the groups and ports where the
+ * console and companion apps talk:
+ *
+ *   DDP    UDP 9302 (PS5) and 987 (PS4 era); "HTTP/1.1 200 Ok" / "620
+ *          Server Standby" replies carrying host-id, host-type, host-name
+ *   SSDP   239.255.255.250:1900; NOTIFY ssdp:alive / ssdp:byebye
+ *   mDNS   224.0.0.251:5353; responses naming a "PS5-..." host
+ *
+ * DDP replies are normally unicast to the app that searched, so they are
+ * only seen when broadcast or when the searching app runs on this host;
+ * SSDP and mDNS announcements are multicast and always seen.
+ *
+ * Every datagram recognised as a PS5 is reported as a sighting with the
+ * sender's IP, the host-id / name when present and the status it implies.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef DISCOVERY_LISTENER_H
+#define DISCOVERY_LISTENER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define DISCOVERY_OK                    0
+#define DISCOVERY_ERROR_NOT_INIT       -1
+#define DISCOVERY_ERROR_INVALID_PARAM  -2
+#define DISCOVERY_ERROR_SOCKET         -3
+#define DISCOVERY_ERROR_UNKNOWN        -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define DISCOVERY_DDP_PORT              9302
+#define DISCOVERY_DDP_LEGACY_PORT       987
+#define DISCOVERY_SSDP_GROUP            "239.255.255.250"
+#define DISCOVERY_SSDP_PORT             1900
+#define DISCOVERY_MDNS_GROUP            "224.0.0.251"
+#define DISCOVERY_MDNS_PORT             5353
+#define DISCOVERY_MAX_PACKET            1500
+#define DISCOVERY_MAX_PACKETS_PER_CALL  32      /**< Bound work per process() */
+
+#define DISCOVERY_IP_MAX_LEN            16
+#define DISCOVERY_MAC_MAX_LEN           18
+#define DISCOVERY_ID_MAX_LEN            48
+#define DISCOVERY_NAME_MAX_LEN          64
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Announcement protocol
+ */
+typedef enum {
+    DISCOVERY_PROTO_DDP = 0,        /**< PlayStation Device Discovery Protocol */
+    DISCOVERY_PROTO_SSDP,           /**< UPnP SSDP */
+    DISCOVERY_PROTO_MDNS,           /**< Multicast DNS */
+    DISCOVERY_PROTO_COUNT
+} discovery_proto_t;
+
+#define DISCOVERY_MASK(proto)   (1u << (proto))
+#define DISCOVERY_MASK_ALL      (DISCOVERY_MASK(DISCOVERY_PROTO_COUNT) - 1u)
+
+/**
+ * @brief Console status implied by an announcement
+ */
+typedef enum {
+    DISCOVERY_STATUS_UNKNOWN = 0,   /**< Present, status not stated */
+    DISCOVERY_STATUS_ON,            /**< DDP 200 */
+    DISCOVERY_STATUS_STANDBY,       /**< DDP 620 */
+    DISCOVERY_STATUS_GONE,          /**< ssdp:byebye, mDNS goodbye (TTL 0) */
+} discovery_status_t;
+
+/**
+ * @brief One PS5 sighting
+ */
+typedef struct {
+    discovery_proto_t proto;                /**< Where it was heard */
+    discovery_status_t status;              /**< Implied status */
+    char ip[DISCOVERY_IP_MAX_LEN];          /**< Console IPv4 address */
+    char mac[DISCOVERY_MAC_MAX_LEN];        /**< From DDP host-id, empty if unknown */
+    char host_id[DISCOVERY_ID_MAX_LEN];     /**< DDP host-id or SSDP UUID */
+    char name[DISCOVERY_NAME_MAX_LEN];      /**< DDP host-name or mDNS host label */
+} discovery_sighting_t;
+
+/**
+ * @brief Sighting callback function type
+ */
+typedef void (*discovery_callback_t)(const discovery_sighting_t *sighting, void *user_data);
+
+/**
+ * @brief Listener statistics
+ */
+typedef struct {
+    uint32_t listening_mask;                        /**< Protocols with an open socket */
+    uint32_t packets;                               /**< Datagrams received */
+    uint32_t sightings[DISCOVERY_PROTO_COUNT];      /**< PS5 sightings per protocol */
+    time_t last_sighting;                           /**< Time of the last sighting (0 = never) */
+} discovery_stats_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Open the listening sockets
+ * @param proto_mask DISCOVERY_MASK() bits of the protocols to listen on
+ * @return DISCOVERY_OK if at least one socket is listening, negative error code otherwise
+ */
+int discovery_listener_init(uint32_t proto_mask);
+
+/**
+ * @brief Set the sighting callback
+ * @param callback Callback function
+ * @param user_data User data to pass to callback
+ */
+void discovery_listener_set_callback(discovery_callback_t callback, void *user_data);
+
+/**
+ * @brief Drain pending datagrams (non-blocking, call from the main loop)
+ * @return Number of sightings reported, negative error code on failure
+ */
+int discovery_listener_process(void);
+
+/**
+ * @brief Parse a DDP datagram
+ * @param data Datagram payload
+ * @param len Payload length
+ * @param src_ip Sender address
+ * @param sighting Output sighting
+ * @return true if it is a PS5 reply
+ */
+bool discovery_parse_ddp(const char *data, size_t len, const char *src_ip,
+                         discovery_sighting_t *sighting);
+
+/**
+ * @brief Parse an SSDP datagram
+ * @param data Datagram payload
+ * @param len Payload length
+ * @param src_ip Sender address
+ * @param sighting Output sighting
+ * @return true if it is a PS5 announcement
+ */
+bool discovery_parse_ssdp(const char *data, size_t len, const char *src_ip,
+                          discovery_sighting_t *sighting);
+
+/**
+ * @brief Parse an mDNS datagram
+ * @param data Datagram payload
+ * @param len Payload length
+ * @param src_ip Sender address
+ * @param sighting Output sighting
+ * @return true if it is a response naming a PS5 host
+ */
+bool discovery_parse_mdns(const uint8_t *data, size_t len, const char *src_ip,
+                          discovery_sighting_t *sighting);
+
+/**
+ * @brief Get a snapshot of the statistics
+ * @param stats Pointer to store statistics
+ * @return DISCOVERY_OK on success, negative error code on failure
+ */
+int discovery_listener_get_stats(discovery_stats_t *stats);
+
+/**
+ * @brief Close the sockets
+ */
+void discovery_listener_cleanup(void);
+
+/**
+ * @brief Convert protocol to string
+ * @param proto Protocol
+ * @return Protocol name string
+ */
+const char* discovery_proto_to_string(discovery_proto_t proto);
+
+/**
+ * @brief Convert status to string
+ * @param status Status
+ * @return Status string
+ */
+const char* discovery_status_to_string(discovery_status_t status);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* discovery_listener_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DISCOVERY_LISTENER_H */
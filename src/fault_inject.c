@@ -0,0 +1,367 @@
+/**
+ * @file fault_inject.c
+ * @brief Fault Injection Implementation
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "fault_inject.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// POSIX headers
+#include <pthread.h>
+#include <unistd.h>
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    fault_rule_t rules[FAULT_POINT_COUNT];
+    fault_stats_t stats[FAULT_POINT_COUNT];
+    uint64_t rng;
+    bool active;
+    pthread_mutex_t mutex;              // Hooks run on the main, CEC and worker threads
+} fault_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static fault_context_t g_fault_ctx = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+static const char *const g_point_names[FAULT_POINT_COUNT] = {
+    "cmd", "cec", "probe", "client", "cache"
+};
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+/**
+ * @brief xorshift64*; caller holds the mutex
+ */
+static uint64_t next_random(void) {
+    uint64_t x = g_fault_ctx.rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    g_fault_ctx.rng = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Uniform in [0, 1); caller holds the mutex
+ */
+static double next_unit(void) {
+    return (double)(next_random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static bool valid_point(fault_point_t point) {
+    return ((int)point >= 0 && point < FAULT_POINT_COUNT);
+}
+
+static int parse_point(const char *name, size_t len) {
+    for (int i = 0; i < FAULT_POINT_COUNT; i++) {
+        if (strlen(g_point_names[i]) == len && strncmp(g_point_names[i], name, len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool parse_prob(const char *text, double *prob) {
+    char *end = NULL;
+    errno = 0;
+    double value = strtod(text, &end);
+    if (errno != 0 || end == text || *end != '\0' || value < 0.0 || value > 1.0) {
+        return false;
+    }
+    *prob = value;
+    return true;
+}
+
+static bool parse_ms(const char *text, char **end, uint32_t *ms) {
+    errno = 0;
+    long value = strtol(text, end, 10);
+    if (errno != 0 || *end == text || value < 0 || value > FAULT_DELAY_MAX_MS) {
+        return false;
+    }
+    *ms = (uint32_t)value;
+    return true;
+}
+
+/**
+ * @brief "MS[-MS][@PROB]"
+ */
+static bool parse_delay(char *text, fault_rule_t *rule) {
+    double prob = 1.0;
+    char *at = strchr(text, '@');
+    if (at != NULL) {
+        *at = '\0';
+        if (!parse_prob(at + 1, &prob)) {
+            return false;
+        }
+    }
+
+    char *end = NULL;
+    uint32_t min_ms;
+    uint32_t max_ms;
+    if (!parse_ms(text, &end, &min_ms)) {
+        return false;
+    }
+    max_ms = min_ms;
+    if (*end == '-') {
+        char *start = end + 1;
+        if (!parse_ms(start, &end, &max_ms) || max_ms < min_ms) {
+            return false;
+        }
+    }
+    if (*end != '\0') {
+        return false;
+    }
+
+    rule->delay_prob = prob;
+    rule->delay_min_ms = min_ms;
+    rule->delay_max_ms = max_ms;
+    return true;
+}
+
+/**
+ * @brief One "point.action=value" or "seed=N"
+ */
+static bool parse_entry(char *entry, fault_rule_t *rules, uint64_t *seed) {
+    char *eq = strchr(entry, '=');
+    if (eq == NULL) {
+        return false;
+    }
+    *eq = '\0';
+    char *value = eq + 1;
+
+    if (strcmp(entry, "seed") == 0) {
+        char *end = NULL;
+        errno = 0;
+        unsigned long long n = strtoull(value, &end, 10);
+        if (errno != 0 || end == value || *end != '\0') {
+            return false;
+        }
+        *seed = (uint64_t)n;
+        return true;
+    }
+
+    char *dot = strchr(entry, '.');
+    if (dot == NULL) {
+        return false;
+    }
+    int point = parse_point(entry, (size_t)(dot - entry));
+    if (point < 0) {
+        return false;
+    }
+
+    const char *action = dot + 1;
+    fault_rule_t *rule = &rules[point];
+
+    if (strcmp(action, "delay") == 0 || strcmp(action, "stall") == 0) {
+        return parse_delay(value, rule);
+    }
+    if (strcmp(action, "fail") == 0 || strcmp(action, "drop") == 0) {
+        return parse_prob(value, &rule->fail_prob);
+    }
+    if (strcmp(action, "corrupt") == 0) {
+        return parse_prob(value, &rule->corrupt_prob);
+    }
+    return false;
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int fault_inject_configure(const char *spec) {
+    if (spec == NULL) {
+        spec = getenv(FAULT_ENV_VAR);
+        if (spec == NULL) {
+            return FAULT_OK;
+        }
+    }
+
+    char buf[FAULT_SPEC_MAX_LEN];
+    if (strlen(spec) >= sizeof(buf)) {
+        return FAULT_ERROR_INVALID_PARAM;
+    }
+    snprintf(buf, sizeof(buf), "%s", spec);
+
+    fault_rule_t rules[FAULT_POINT_COUNT];
+    memset(rules, 0, sizeof(rules));
+    uint64_t seed = 0;
+
+    char *saveptr = NULL;
+    for (char *entry = strtok_r(buf, ", \t\n", &saveptr); entry != NULL;
+         entry = strtok_r(NULL, ", \t\n", &saveptr)) {
+        if (!parse_entry(entry, rules, &seed)) {
+            #ifndef TESTING
+            fprintf(stderr, "[Fault] Invalid rule: %s\n", entry);
+            #endif
+            return FAULT_ERROR_INVALID_PARAM;
+        }
+    }
+
+    bool active = false;
+    for (int i = 0; i < FAULT_POINT_COUNT; i++) {
+        if (rules[i].delay_prob > 0.0 || rules[i].fail_prob > 0.0 || rules[i].corrupt_prob > 0.0) {
+            active = true;
+        }
+    }
+
+    if (seed == 0) {
+        seed = server_clock_monotonic_us() ^ ((uint64_t)getpid() << 32);
+    }
+
+    pthread_mutex_lock(&g_fault_ctx.mutex);
+    memcpy(g_fault_ctx.rules, rules, sizeof(rules));
+    memset(g_fault_ctx.stats, 0, sizeof(g_fault_ctx.stats));
+    g_fault_ctx.rng = (seed != 0) ? seed : 1;   // xorshift state must not be 0
+    g_fault_ctx.active = active;
+    pthread_mutex_unlock(&g_fault_ctx.mutex);
+
+    #ifndef TESTING
+    if (active) {
+        fprintf(stdout, "[Fault] Injection active: %s\n", spec);
+    }
+    #endif
+
+    return FAULT_OK;
+}
+
+bool fault_inject_is_active(void) {
+    pthread_mutex_lock(&g_fault_ctx.mutex);
+    bool active = g_fault_ctx.active;
+    pthread_mutex_unlock(&g_fault_ctx.mutex);
+    return active;
+}
+
+uint32_t fault_inject_draw_delay(fault_point_t point) {
+    if (!valid_point(point)) {
+        return 0;
+    }
+
+    uint32_t ms = 0;
+
+    pthread_mutex_lock(&g_fault_ctx.mutex);
+    const fault_rule_t *rule = &g_fault_ctx.rules[point];
+    fault_stats_t *stats = &g_fault_ctx.stats[point];
+
+    if (g_fault_ctx.active) {
+        stats->calls++;
+        if (rule->delay_prob > 0.0 && next_unit() < rule->delay_prob) {
+            uint32_t span = rule->delay_max_ms - rule->delay_min_ms;
+            ms = rule->delay_min_ms + ((span > 0) ? (uint32_t)(next_random() % (span + 1)) : 0);
+            stats->delays++;
+            stats->delay_ms += ms;
+        }
+    }
+    pthread_mutex_unlock(&g_fault_ctx.mutex);
+    return ms;
+}
+
+uint32_t fault_inject_delay(fault_point_t point) {
+    // Sleep outside the lock so other threads' hooks are not serialized behind it
+    uint32_t ms = fault_inject_draw_delay(point);
+    if (ms > 0) {
+        server_clock_sleep_ms(ms);
+    }
+    return ms;
+}
+
+bool fault_inject_fail(fault_point_t point) {
+    if (!valid_point(point)) {
+        return false;
+    }
+
+    bool fail = false;
+
+    pthread_mutex_lock(&g_fault_ctx.mutex);
+    const fault_rule_t *rule = &g_fault_ctx.rules[point];
+    if (g_fault_ctx.active && rule->fail_prob > 0.0 && next_unit() < rule->fail_prob) {
+        g_fault_ctx.stats[point].failures++;
+        fail = true;
+    }
+    pthread_mutex_unlock(&g_fault_ctx.mutex);
+
+    return fail;
+}
+
+bool fault_inject_corrupt(fault_point_t point, char *buf, size_t len) {
+    if (!valid_point(point) || buf == NULL || len == 0) {
+        return false;
+    }
+
+    bool corrupt = false;
+
+    pthread_mutex_lock(&g_fault_ctx.mutex);
+    const fault_rule_t *rule = &g_fault_ctx.rules[point];
+    if (g_fault_ctx.active && rule->corrupt_prob > 0.0 && next_unit() < rule->corrupt_prob) {
+        size_t pos = (size_t)(next_random() % len);
+        buf[pos] ^= (char)(1 + next_random() % 255);
+        g_fault_ctx.stats[point].corruptions++;
+        corrupt = true;
+    }
+    pthread_mutex_unlock(&g_fault_ctx.mutex);
+
+    return corrupt;
+}
+
+int fault_inject_get_rule(fault_point_t point, fault_rule_t *rule) {
+    if (!valid_point(point) || rule == NULL) {
+        return FAULT_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&g_fault_ctx.mutex);
+    *rule = g_fault_ctx.rules[point];
+    pthread_mutex_unlock(&g_fault_ctx.mutex);
+    return FAULT_OK;
+}
+
+int fault_inject_get_stats(fault_point_t point, fault_stats_t *stats) {
+    if (!valid_point(point) || stats == NULL) {
+        return FAULT_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&g_fault_ctx.mutex);
+    *stats = g_fault_ctx.stats[point];
+    pthread_mutex_unlock(&g_fault_ctx.mutex);
+    return FAULT_OK;
+}
+
+void fault_inject_cleanup(void) {
+    pthread_mutex_lock(&g_fault_ctx.mutex);
+    memset(g_fault_ctx.rules, 0, sizeof(g_fault_ctx.rules));
+    memset(g_fault_ctx.stats, 0, sizeof(g_fault_ctx.stats));
+    g_fault_ctx.active = false;
+    pthread_mutex_unlock(&g_fault_ctx.mutex);
+}
+
+const char* fault_point_to_string(fault_point_t point) {
+    return valid_point(point) ? g_point_names[point] : "unknown";
+}
+
+const char* fault_inject_error_string(int error) {
+    switch (error) {
+        case FAULT_OK:                      return "OK";
+        case FAULT_ERROR_INVALID_PARAM:     return "Invalid parameter";
+        case FAULT_ERROR_UNKNOWN:           return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
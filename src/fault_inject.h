@@ -0,0 +1,211 @@
+/**
+ * @file fault_inject.h
+ * @brief Fault Injection - Delays and failures at backend boundaries
+ *
+ * For watching queues, breakers and timeouts under degradation. Built
+ * with ENABLE_FAULT_INJECTION, the hooks below sit where the daemon
+ * leaves its own code:
+ *
+ *   cmd     popen()/system() of cec-ctl, ping, nmap, arp, nft/tc
+ *   cec     one power status query (ioctl or cec-ctl)
+ *   probe   liveness probe replies (detector and link monitor)
+ *   client  sends to WebSocket clients (a stall holds that client's
+ *           frames until it ends; the main thread does not sleep)
+ *   cache   PS5 cache file reads and writes
+ *
+ * Each point can be given a delay (fixed or a uniform range, with a
+ * probability) and a failure probability; cache reads can also be
+ * corrupted. The spec comes from --faults or the GAMING_SERVER_FAULTS
+ * environment variable, e.g.
+ *
+ *   cec.fail=0.2,cmd.delay=50-400@0.5,probe.drop=0.1,
+ *   client.stall=2000@0.05,cache.corrupt=0.3,seed=42
+ *
+ * "drop" is "fail" and "stall" is "delay" under the name that reads
+ * better for the point. Without ENABLE_FAULT_INJECTION (and always in
+ * unit tests) the hooks compile to nothing.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef FAULT_INJECT_H
+#define FAULT_INJECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define FAULT_OK                        0
+#define FAULT_ERROR_INVALID_PARAM      -2
+#define FAULT_ERROR_UNKNOWN            -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define FAULT_ENV_VAR                   "GAMING_SERVER_FAULTS"
+#define FAULT_SPEC_MAX_LEN              512
+#define FAULT_DELAY_MAX_MS              60000
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Injection point
+ */
+typedef enum {
+    FAULT_POINT_CMD = 0,        /**< Command execution */
+    FAULT_POINT_CEC,            /**< CEC I/O */
+    FAULT_POINT_PROBE,          /**< Probe replies */
+    FAULT_POINT_CLIENT,         /**< Client sockets */
+    FAULT_POINT_CACHE,          /**< Cache file I/O */
+    FAULT_POINT_COUNT
+} fault_point_t;
+
+/**
+ * @brief What one point does
+ */
+typedef struct {
+    double delay_prob;          /**< Chance of a delay per call */
+    uint32_t delay_min_ms;
+    uint32_t delay_max_ms;
+    double fail_prob;           /**< Chance the call fails / the reply is dropped */
+    double corrupt_prob;        /**< Chance a read buffer is corrupted */
+} fault_rule_t;
+
+/**
+ * @brief Per-point counters
+ */
+typedef struct {
+    uint32_t calls;             /**< Times the hook was reached */
+    uint32_t delays;
+    uint64_t delay_ms;          /**< Total injected delay */
+    uint32_t failures;
+    uint32_t corruptions;
+} fault_stats_t;
+
+/* ============================================================
+ *  Hooks
+ * ============================================================ */
+
+#if defined(ENABLE_FAULT_INJECTION) && !defined(TESTING)
+
+#define FAULT_DELAY(point)                  fault_inject_delay(point)
+#define FAULT_STALL_MS(point)               fault_inject_draw_delay(point)
+#define FAULT_FAIL(point)                   fault_inject_fail(point)
+#define FAULT_CORRUPT(point, buf, len)      fault_inject_corrupt(point, buf, len)
+
+#else
+
+// sizeof keeps the arguments "used" without evaluating them
+#define FAULT_DELAY(point)                  do { (void)sizeof(point); } while (0)
+#define FAULT_STALL_MS(point)               ((void)sizeof(point), 0u)
+#define FAULT_FAIL(point)                   ((void)sizeof(point), false)
+#define FAULT_CORRUPT(point, buf, len)      do { (void)sizeof(point); (void)sizeof(buf); \
+                                                 (void)sizeof(len); } while (0)
+
+#endif
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Load a spec, replacing any previous one
+ * @param spec Comma-separated rules; NULL reads FAULT_ENV_VAR
+ * @return FAULT_OK on success (also when there is nothing to load),
+ *         FAULT_ERROR_INVALID_PARAM if the spec does not parse (nothing is changed)
+ */
+int fault_inject_configure(const char *spec);
+
+/**
+ * @brief Check whether any rule is set
+ * @return true if faults will be injected
+ */
+bool fault_inject_is_active(void);
+
+/**
+ * @brief Maybe sleep at a point
+ * @param point Injection point
+ * @return Milliseconds slept (0 if not delayed)
+ */
+uint32_t fault_inject_delay(fault_point_t point);
+
+/**
+ * @brief Draw a delay at a point without sleeping
+ *
+ * For callers on the main thread that model the delay themselves
+ * (e.g. by holding a client's output until a deadline).
+ *
+ * @param point Injection point
+ * @return Milliseconds to delay (0 if not delayed); counted in the stats
+ */
+uint32_t fault_inject_draw_delay(fault_point_t point);
+
+/**
+ * @brief Decide whether a call at a point fails
+ * @param point Injection point
+ * @return true if the caller should act as if the call failed
+ */
+bool fault_inject_fail(fault_point_t point);
+
+/**
+ * @brief Maybe flip a byte in a buffer just read at a point
+ * @param point Injection point
+ * @param buf Buffer
+ * @param len Bytes in buf
+ * @return true if the buffer was changed
+ */
+bool fault_inject_corrupt(fault_point_t point, char *buf, size_t len);
+
+/**
+ * @brief Get the rule for a point
+ * @param point Injection point
+ * @param rule Output rule
+ * @return FAULT_OK on success, negative error code on failure
+ */
+int fault_inject_get_rule(fault_point_t point, fault_rule_t *rule);
+
+/**
+ * @brief Get the counters for a point
+ * @param point Injection point
+ * @param stats Output counters
+ * @return FAULT_OK on success, negative error code on failure
+ */
+int fault_inject_get_stats(fault_point_t point, fault_stats_t *stats);
+
+/**
+ * @brief Drop all rules and counters
+ */
+void fault_inject_cleanup(void);
+
+/**
+ * @brief Convert injection point to string
+ * @param point Injection point
+ * @return "cmd", "cec", "probe", "client", "cache" or "unknown"
+ */
+const char* fault_point_to_string(fault_point_t point);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* fault_inject_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FAULT_INJECT_H */
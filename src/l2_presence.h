@@ -0,0 +1,204 @@
+/**
+ * @file l2_presence.h
+ * @brief L2 Presence - Console presence from bridge FDB and Wi-Fi station events
+ *
+ * The router learns at layer 2 when the console's MAC appears on a LAN
+ * port or associates to an access point, well before any probe could
+ * tell. Two event sources are watched, keyed by the console's MAC:
+ *
+ *   bridge  RTM_NEWNEIGH / RTM_DELNEIGH for AF_BRIDGE on an RTMGRP_NEIGH
+ *           netlink subscription (FDB learned / aged out / port down)
+ *   wifi    AP-STA-CONNECTED / AP-STA-DISCONNECTED from every hostapd
+ *           control socket (ATTACH as a monitor)
+ *
+ * IPv4 neighbour notifications on the same subscription keep the
+ * console's current IP, which is attached to every event. Nothing is
+ * sent to the console.
+ *
+ * Events fire only when a source's view changes. State is event-driven:
+ * a console that was already present at startup is reported the next
+ * time the FDB entry is refreshed or the station reassociates.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef L2_PRESENCE_H
+#define L2_PRESENCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define L2_OK                           0
+#define L2_ERROR_NOT_INIT              -1
+#define L2_ERROR_INVALID_PARAM         -2
+#define L2_ERROR_SOCKET                -3
+#define L2_ERROR_UNKNOWN               -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define L2_HOSTAPD_DIR              "/var/run/hostapd"  /**< hostapd ctrl_interface */
+#define L2_MAX_HOSTAPD              4                   /**< Attached hostapd sockets */
+#define L2_MAX_FDS                  (1 + L2_MAX_HOSTAPD) /**< Netlink + hostapd sockets */
+#define L2_HOSTAPD_CHECK_SEC        30                  /**< Liveness check / rescan interval */
+#define L2_HOSTAPD_REPLY_MS         500                 /**< ATTACH reply timeout */
+#define L2_MSG_MAX_LEN              512
+#define L2_NETLINK_BUF_SIZE         8192
+#define L2_MAC_MAX_LEN              18
+#define L2_IP_MAX_LEN               16
+#define L2_IFACE_MAX_LEN            16
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Event source
+ */
+typedef enum {
+    L2_SOURCE_BRIDGE = 0,           /**< Bridge forwarding database */
+    L2_SOURCE_WIFI,                 /**< hostapd station events */
+    L2_SOURCE_COUNT
+} l2_source_t;
+
+#define L2_SOURCE_MASK(source)  (1u << (source))
+
+/**
+ * @brief One presence change
+ */
+typedef struct {
+    l2_source_t source;                 /**< Where it was seen */
+    bool present;                       /**< Appeared (true) or left (false) */
+    char mac[L2_MAC_MAX_LEN];           /**< Console MAC */
+    char ip[L2_IP_MAX_LEN];             /**< Last IPv4 seen for the MAC, empty if unknown */
+    char iface[L2_IFACE_MAX_LEN];       /**< Bridge port or AP interface */
+} l2_event_t;
+
+/**
+ * @brief Presence callback function type
+ */
+typedef void (*l2_callback_t)(const l2_event_t *event, void *user_data);
+
+/**
+ * @brief Statistics
+ */
+typedef struct {
+    uint32_t listening_mask;                /**< Sources with an open socket */
+    uint32_t hostapd_attached;              /**< hostapd sockets attached */
+    uint32_t messages;                      /**< Netlink / hostapd messages read */
+    uint32_t events[L2_SOURCE_COUNT];       /**< Presence changes per source */
+    time_t last_event;                      /**< Time of the last change (0 = never) */
+} l2_stats_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Subscribe to neighbour notifications and attach to hostapd
+ * @param hostapd_dir hostapd control directory (NULL uses L2_HOSTAPD_DIR)
+ * @return L2_OK if at least one source is listening, negative error code otherwise
+ */
+int l2_presence_init(const char *hostapd_dir);
+
+/**
+ * @brief Set the MAC to follow (resets per-source state when it changes)
+ * @param mac Console MAC ("aa:bb:cc:dd:ee:ff", any case)
+ * @return L2_OK on success, negative error code on failure
+ */
+int l2_presence_set_mac(const char *mac);
+
+/**
+ * @brief Set the presence callback
+ * @param callback Callback function
+ * @param user_data User data to pass to callback
+ */
+void l2_presence_set_callback(l2_callback_t callback, void *user_data);
+
+/**
+ * @brief Read pending messages (non-blocking, call from the main loop)
+ * @return Number of presence changes reported, negative error code on failure
+ */
+int l2_presence_process(void);
+
+/**
+ * @brief Get the open sockets, readable when messages are waiting
+ *
+ * For the caller's poll set; the hostapd sockets change on rescans,
+ * so fetch them again before each poll.
+ *
+ * @param fds Output array
+ * @param max Capacity of fds (L2_MAX_FDS covers every socket)
+ * @return Number of descriptors stored (0 if not initialized or in test mode)
+ */
+int l2_presence_get_fds(int *fds, int max);
+
+/**
+ * @brief Handle a buffer of rtnetlink messages
+ *
+ * Used by process(); exposed so message handling can be tested offline.
+ *
+ * @param buf Messages
+ * @param len Buffer length
+ * @return Number of presence changes reported
+ */
+int l2_presence_handle_netlink(const void *buf, size_t len);
+
+/**
+ * @brief Handle one hostapd control message
+ * @param msg Message text (e.g. "<3>AP-STA-CONNECTED aa:bb:cc:dd:ee:ff")
+ * @param iface AP interface the message came from
+ * @return Number of presence changes reported (0 or 1)
+ */
+int l2_presence_handle_hostapd(const char *msg, const char *iface);
+
+/**
+ * @brief Whether any source currently sees the console
+ * @return true if present on at least one source
+ */
+bool l2_presence_is_present(void);
+
+/**
+ * @brief Get a snapshot of the statistics
+ * @param stats Pointer to store statistics
+ * @return L2_OK on success, negative error code on failure
+ */
+int l2_presence_get_stats(l2_stats_t *stats);
+
+/**
+ * @brief Detach from hostapd and close all sockets
+ */
+void l2_presence_cleanup(void);
+
+/**
+ * @brief Convert source to string
+ * @param source Source
+ * @return Source name string
+ */
+const char* l2_source_to_string(l2_source_t source);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* l2_presence_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* L2_PRESENCE_H */
@@ -0,0 +1,429 @@
+/**
+ * @file link_monitor.c
+ * @brief Link Monitor Implementation - TCP SYN RTT probing
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "link_monitor.h"
+#include "server_clock.h"
+#include "server_trace.h"
+#include "fault_inject.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    bool initialized;
+    bool active;
+    uint16_t port;
+    struct sockaddr_in target;
+
+    // In-flight probe
+    int probe_fd;
+    uint64_t probe_start_us;
+    uint64_t next_probe_us;
+
+    // Estimators
+    link_stats_t stats;
+    uint64_t loss_mask;         // 1 bit per probe, 1 = lost
+    bool have_rtt;
+
+    // Rolling histogram: one slot per interval, stats.histogram is their sum
+    uint32_t hist_slots[LINK_MON_HIST_SLOTS][LINK_MON_HIST_BUCKETS];
+    int hist_slot;
+    uint64_t hist_slot_start_us;
+} link_monitor_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static link_monitor_context_t g_link_ctx = { .probe_fd = -1 };
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+/**
+ * @brief Drop histogram slots older than the window
+ */
+static void age_histogram(uint64_t now) {
+    const uint64_t slot_us = (uint64_t)LINK_MON_HIST_WINDOW_SEC * 1000000ULL / LINK_MON_HIST_SLOTS;
+
+    if (now < g_link_ctx.hist_slot_start_us) {
+        g_link_ctx.hist_slot_start_us = now;    // Clock was replaced (tests)
+        return;
+    }
+
+    for (int step = 0; step < LINK_MON_HIST_SLOTS &&
+                       now - g_link_ctx.hist_slot_start_us >= slot_us; step++) {
+        g_link_ctx.hist_slot = (g_link_ctx.hist_slot + 1) % LINK_MON_HIST_SLOTS;
+
+        uint32_t *slot = g_link_ctx.hist_slots[g_link_ctx.hist_slot];
+        for (int i = 0; i < LINK_MON_HIST_BUCKETS; i++) {
+            g_link_ctx.stats.histogram[i] -= slot[i];
+            slot[i] = 0;
+        }
+        g_link_ctx.hist_slot_start_us += slot_us;
+    }
+
+    // Idle for longer than the window: everything is gone already
+    if (now - g_link_ctx.hist_slot_start_us >= slot_us) {
+        g_link_ctx.hist_slot_start_us = now;
+    }
+}
+
+/**
+ * @brief Map an RTT to its histogram bucket
+ */
+static int rtt_bucket(uint32_t rtt_us) {
+    int bucket = 0;
+    uint32_t bound = LINK_MON_HIST_BASE_US;
+
+    while (rtt_us >= bound && bucket < LINK_MON_HIST_BUCKETS - 1) {
+        bound <<= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+/**
+ * @brief Close the in-flight probe socket
+ */
+static void close_probe(void) {
+    if (g_link_ctx.probe_fd >= 0) {
+        close(g_link_ctx.probe_fd);
+        g_link_ctx.probe_fd = -1;
+    }
+}
+
+/**
+ * @brief Send one probe (non-blocking connect)
+ */
+static int send_probe(uint64_t now_us) {
+    #ifdef TESTING
+    // In test mode, no network traffic; samples are fed via record_sample()
+    (void)now_us;
+    return LINK_MON_OK;
+    #else
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return LINK_MON_ERROR_SOCKET;
+    }
+
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    // RST on close: no FIN handshake, no TIME_WAIT left behind
+    struct linger lg = { .l_onoff = 1, .l_linger = 0 };
+    setsockopt(fd, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg));
+
+    g_link_ctx.stats.probes_sent++;
+    g_link_ctx.probe_start_us = now_us;
+    SERVER_TRACE2(probe_sent, g_link_ctx.target.sin_addr.s_addr, ntohs(g_link_ctx.target.sin_port));
+
+    if (connect(fd, (struct sockaddr*)&g_link_ctx.target, sizeof(g_link_ctx.target)) == 0) {
+        // Loopback-fast answer
+        close(fd);
+        link_monitor_record_sample(true, (uint32_t)(server_clock_monotonic_us() - now_us));
+        return LINK_MON_OK;
+    }
+
+    if (errno == ECONNREFUSED) {
+        close(fd);
+        link_monitor_record_sample(true, (uint32_t)(server_clock_monotonic_us() - now_us));
+        return LINK_MON_OK;
+    }
+
+    if (errno != EINPROGRESS) {
+        close(fd);
+        link_monitor_record_sample(false, 0);
+        return LINK_MON_OK;
+    }
+
+    g_link_ctx.probe_fd = fd;
+    return LINK_MON_OK;
+    #endif
+}
+
+/**
+ * @brief Check the in-flight probe for completion
+ */
+static void check_probe(uint64_t now_us) {
+    struct pollfd pfd = { .fd = g_link_ctx.probe_fd, .events = POLLOUT };
+
+    if (poll(&pfd, 1, 0) > 0) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(g_link_ctx.probe_fd, SOL_SOCKET, SO_ERROR, &err, &len);
+
+        // Handshake completed or RST received: the console answered
+        bool replied = (err == 0 || err == ECONNREFUSED) && !FAULT_FAIL(FAULT_POINT_PROBE);
+        close_probe();
+        link_monitor_record_sample(replied, (uint32_t)(now_us - g_link_ctx.probe_start_us));
+        return;
+    }
+
+    if (now_us - g_link_ctx.probe_start_us >= (uint64_t)LINK_MON_PROBE_TIMEOUT_MS * 1000ULL) {
+        close_probe();
+        link_monitor_record_sample(false, 0);
+    }
+}
+
+/**
+ * @brief Reset all estimators
+ */
+static void reset_stats(void) {
+    memset(&g_link_ctx.stats, 0, sizeof(link_stats_t));
+    g_link_ctx.loss_mask = 0;
+    g_link_ctx.have_rtt = false;
+
+    memset(g_link_ctx.hist_slots, 0, sizeof(g_link_ctx.hist_slots));
+    g_link_ctx.hist_slot = 0;
+    g_link_ctx.hist_slot_start_us = server_clock_monotonic_us();
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int link_monitor_init(uint16_t port) {
+    if (g_link_ctx.initialized) {
+        return LINK_MON_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    memset(&g_link_ctx, 0, sizeof(link_monitor_context_t));
+    g_link_ctx.probe_fd = -1;
+    g_link_ctx.port = (port > 0) ? port : LINK_MON_DEFAULT_PORT;
+    g_link_ctx.hist_slot_start_us = server_clock_monotonic_us();
+    g_link_ctx.initialized = true;
+
+    return LINK_MON_OK;
+}
+
+int link_monitor_start(const char *ip) {
+    if (!g_link_ctx.initialized) {
+        return LINK_MON_ERROR_NOT_INIT;
+    }
+
+    struct sockaddr_in target;
+    memset(&target, 0, sizeof(target));
+    target.sin_family = AF_INET;
+    target.sin_port = htons(g_link_ctx.port);
+
+    if (ip == NULL || inet_pton(AF_INET, ip, &target.sin_addr) != 1) {
+        return LINK_MON_ERROR_INVALID_PARAM;
+    }
+
+    if (g_link_ctx.active &&
+        target.sin_addr.s_addr == g_link_ctx.target.sin_addr.s_addr) {
+        return LINK_MON_OK;  // Already probing this address
+    }
+
+    close_probe();
+    if (target.sin_addr.s_addr != g_link_ctx.target.sin_addr.s_addr) {
+        reset_stats();
+    }
+
+    g_link_ctx.target = target;
+    g_link_ctx.active = true;
+    g_link_ctx.stats.active = true;
+    g_link_ctx.next_probe_us = server_clock_monotonic_us();
+
+    #ifndef TESTING
+    fprintf(stdout, "[LinkMon] Probing %s:%u\n", ip, g_link_ctx.port);
+    #endif
+
+    return LINK_MON_OK;
+}
+
+void link_monitor_stop(void) {
+    close_probe();
+    g_link_ctx.active = false;
+    g_link_ctx.stats.active = false;
+}
+
+int link_monitor_process(void) {
+    if (!g_link_ctx.initialized) {
+        return LINK_MON_ERROR_NOT_INIT;
+    }
+
+    if (!g_link_ctx.active) {
+        return LINK_MON_OK;
+    }
+
+    uint64_t now = server_clock_monotonic_us();
+
+    if (g_link_ctx.probe_fd >= 0) {
+        check_probe(now);
+        return LINK_MON_OK;
+    }
+
+    if (now >= g_link_ctx.next_probe_us) {
+        g_link_ctx.next_probe_us = now + (uint64_t)LINK_MON_PROBE_INTERVAL_MS * 1000ULL;
+        return send_probe(now);
+    }
+
+    return LINK_MON_OK;
+}
+
+int link_monitor_get_fd(void) {
+    return g_link_ctx.probe_fd;
+}
+
+void link_monitor_record_sample(bool replied, uint32_t rtt_us) {
+    link_stats_t *s = &g_link_ctx.stats;
+
+    SERVER_TRACE2(probe_reply, replied, rtt_us);
+
+    // Loss window
+    g_link_ctx.loss_mask = (g_link_ctx.loss_mask << 1) | (replied ? 0ULL : 1ULL);
+    if (s->window_probes < LINK_MON_LOSS_WINDOW) {
+        s->window_probes++;
+    }
+    s->window_lost = (uint32_t)__builtin_popcountll(g_link_ctx.loss_mask);
+
+    if (!replied) {
+        return;
+    }
+
+    s->replies++;
+
+    int bucket = rtt_bucket(rtt_us);
+    age_histogram(server_clock_monotonic_us());
+    g_link_ctx.hist_slots[g_link_ctx.hist_slot][bucket]++;
+    s->histogram[bucket]++;
+
+    if (!g_link_ctx.have_rtt) {
+        s->rtt_min_us = rtt_us;
+        s->rtt_max_us = rtt_us;
+        s->rtt_avg_us = rtt_us;
+        s->jitter_us = 0;
+        g_link_ctx.have_rtt = true;
+    } else {
+        // Jitter: J += (|D| - J) / 16 (RFC 3550, 6.4.1)
+        int64_t d = (int64_t)rtt_us - (int64_t)s->rtt_last_us;
+        if (d < 0) {
+            d = -d;
+        }
+        s->jitter_us = (uint32_t)((int64_t)s->jitter_us + (d - (int64_t)s->jitter_us) / 16);
+
+        // Smoothed RTT: A += (R - A) / 8
+        s->rtt_avg_us = (uint32_t)((int64_t)s->rtt_avg_us +
+                                   ((int64_t)rtt_us - (int64_t)s->rtt_avg_us) / 8);
+
+        if (rtt_us < s->rtt_min_us) {
+            s->rtt_min_us = rtt_us;
+        }
+        if (rtt_us > s->rtt_max_us) {
+            s->rtt_max_us = rtt_us;
+        }
+    }
+
+    s->rtt_last_us = rtt_us;
+}
+
+int link_monitor_get_stats(link_stats_t *stats) {
+    if (!g_link_ctx.initialized) {
+        return LINK_MON_ERROR_NOT_INIT;
+    }
+
+    if (stats == NULL) {
+        return LINK_MON_ERROR_INVALID_PARAM;
+    }
+
+    age_histogram(server_clock_monotonic_us());
+    memcpy(stats, &g_link_ctx.stats, sizeof(link_stats_t));
+    return LINK_MON_OK;
+}
+
+uint32_t link_monitor_percentile_us(const link_stats_t *stats, int percentile) {
+    if (stats == NULL || percentile <= 0 || percentile > 100) {
+        return 0;
+    }
+
+    uint64_t total = 0;
+    for (int i = 0; i < LINK_MON_HIST_BUCKETS; i++) {
+        total += stats->histogram[i];
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t target = (total * (uint64_t)percentile + 99) / 100;
+    uint64_t seen = 0;
+    uint32_t bound = LINK_MON_HIST_BASE_US;
+
+    for (int i = 0; i < LINK_MON_HIST_BUCKETS; i++) {
+        seen += stats->histogram[i];
+        if (seen >= target) {
+            return bound;
+        }
+        bound <<= 1;
+    }
+
+    return bound;
+}
+
+double link_monitor_loss_percent(const link_stats_t *stats) {
+    if (stats == NULL || stats->window_probes == 0) {
+        return 0.0;
+    }
+
+    return 100.0 * (double)stats->window_lost / (double)stats->window_probes;
+}
+
+bool link_monitor_is_active(void) {
+    return g_link_ctx.active;
+}
+
+void link_monitor_cleanup(void) {
+    if (!g_link_ctx.initialized) {
+        return;
+    }
+
+    close_probe();
+    memset(&g_link_ctx, 0, sizeof(link_monitor_context_t));
+    g_link_ctx.probe_fd = -1;
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* link_monitor_error_string(int error) {
+    switch (error) {
+        case LINK_MON_OK:                   return "OK";
+        case LINK_MON_ERROR_NOT_INIT:       return "Not initialized";
+        case LINK_MON_ERROR_INVALID_PARAM:  return "Invalid parameter";
+        case LINK_MON_ERROR_SOCKET:         return "Socket error";
+        case LINK_MON_ERROR_UNKNOWN:        return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
@@ -0,0 +1,166 @@
+/**
+ * @file link_monitor.h
+ * @brief Link Monitor - Continuous RTT / jitter / loss estimation for the PS5 link
+ *
+ * While the console is on, a low-rate probe (one non-blocking TCP SYN to
+ * the Remote Play port per interval) measures the round-trip time. Both a
+ * completed handshake and a RST count as a reply, so the probe works even
+ * when Remote Play is not accepting yet.
+ *
+ * Results are kept in fixed-size state (log2 histogram of the last five
+ * minutes, EWMA RTT, RFC 3550 style jitter and a 64-probe loss window),
+ * so memory use never grows and percentiles follow the current link.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef LINK_MONITOR_H
+#define LINK_MONITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define LINK_MON_OK                     0
+#define LINK_MON_ERROR_NOT_INIT        -1
+#define LINK_MON_ERROR_INVALID_PARAM   -2
+#define LINK_MON_ERROR_SOCKET          -3
+#define LINK_MON_ERROR_UNKNOWN         -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define LINK_MON_DEFAULT_PORT           9295    /**< PS5 Remote Play port */
+#define LINK_MON_PROBE_INTERVAL_MS      1000    /**< One probe per second */
+#define LINK_MON_PROBE_TIMEOUT_MS       1000    /**< Probe counted as lost after this */
+#define LINK_MON_HIST_BUCKETS           16      /**< log2 histogram buckets */
+#define LINK_MON_HIST_BASE_US           256     /**< Upper bound of bucket 0 (us) */
+#define LINK_MON_HIST_WINDOW_SEC        300     /**< Histogram covers this much history */
+#define LINK_MON_HIST_SLOTS             5       /**< Aged out one slot (window / slots) at a time */
+#define LINK_MON_LOSS_WINDOW            64      /**< Probes in loss window */
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Link quality statistics
+ */
+typedef struct {
+    bool active;                                /**< Monitor running */
+    uint32_t probes_sent;                       /**< Total probes sent */
+    uint32_t replies;                           /**< Total replies received */
+    uint32_t rtt_last_us;                       /**< Last RTT (us) */
+    uint32_t rtt_min_us;                        /**< Minimum RTT (us) */
+    uint32_t rtt_max_us;                        /**< Maximum RTT (us) */
+    uint32_t rtt_avg_us;                        /**< Smoothed RTT, EWMA 1/8 (us) */
+    uint32_t jitter_us;                         /**< Interarrival jitter, EWMA 1/16 (us) */
+    uint32_t window_probes;                     /**< Probes in loss window */
+    uint32_t window_lost;                       /**< Lost probes in loss window */
+    uint32_t histogram[LINK_MON_HIST_BUCKETS];  /**< RTT histogram over the window (log2 buckets) */
+} link_stats_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Initialize the link monitor
+ * @param port TCP port to probe (0 uses LINK_MON_DEFAULT_PORT)
+ * @return LINK_MON_OK on success, negative error code on failure
+ */
+int link_monitor_init(uint16_t port);
+
+/**
+ * @brief Start probing a console address
+ *
+ * Restarting with a different IP resets the statistics.
+ *
+ * @param ip Console IPv4 address
+ * @return LINK_MON_OK on success, negative error code on failure
+ */
+int link_monitor_start(const char *ip);
+
+/**
+ * @brief Stop probing (statistics are kept until the next start)
+ */
+void link_monitor_stop(void);
+
+/**
+ * @brief Drive the probe (non-blocking, call from the main loop)
+ *
+ * The RTT is taken when this runs, so call it as soon as the probe
+ * socket becomes writable (see link_monitor_get_fd()).
+ *
+ * @return LINK_MON_OK on success, negative error code on failure
+ */
+int link_monitor_process(void);
+
+/**
+ * @brief Get the in-flight probe socket, for the caller's poll set (POLLOUT)
+ * @return File descriptor, -1 if no probe is in flight
+ */
+int link_monitor_get_fd(void);
+
+/**
+ * @brief Record one probe outcome into the estimators
+ * @param replied true if the probe was answered
+ * @param rtt_us Round-trip time in microseconds (ignored if not replied)
+ */
+void link_monitor_record_sample(bool replied, uint32_t rtt_us);
+
+/**
+ * @brief Get a snapshot of the statistics
+ * @param stats Pointer to store statistics
+ * @return LINK_MON_OK on success, negative error code on failure
+ */
+int link_monitor_get_stats(link_stats_t *stats);
+
+/**
+ * @brief Estimate an RTT percentile from the histogram (last LINK_MON_HIST_WINDOW_SEC)
+ * @param stats Statistics snapshot
+ * @param percentile Percentile (1-100)
+ * @return Upper bound of the matching bucket in microseconds, 0 if no samples
+ */
+uint32_t link_monitor_percentile_us(const link_stats_t *stats, int percentile);
+
+/**
+ * @brief Loss ratio within the loss window
+ * @param stats Statistics snapshot
+ * @return Loss in percent (0-100)
+ */
+double link_monitor_loss_percent(const link_stats_t *stats);
+
+/**
+ * @brief Check if the monitor is probing
+ * @return true if active
+ */
+bool link_monitor_is_active(void);
+
+/**
+ * @brief Clean up link monitor resources
+ */
+void link_monitor_cleanup(void);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* link_monitor_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINK_MONITOR_H */
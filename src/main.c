@@ -20,10 +20,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <signal.h>
 #include <unistd.h>
 #include <getopt.h>
+#include <poll.h>
 #include <time.h>
 #include <cjson/cJSON.h>
 
@@ -32,7 +35,28 @@
 #include "ps5_detector.h"
 #include "ps5_wake.h"
 #include "websocket_server.h"
+#include "client_acl.h"
 #include "server_state_machine.h"
+#include "qos_manager.h"
+#include "link_monitor.h"
+#include "ready_probe.h"
+#include "presence_channel.h"
+#include "discovery_listener.h"
+#include "l2_presence.h"
+#include "arp_prober.h"
+#include "status_beacon.h"
+#include "status_snapshot.h"
+#include "mqtt_publisher.h"
+#include "webhook_dispatcher.h"
+#include "worker_pool.h"
+#include "coroutine.h"
+#include "server_clock.h"
+#include "circuit_breaker.h"
+#include "capability_probe.h"
+#include "self_bench.h"
+#include "fault_inject.h"
+#include "thread_policy.h"
+#include "server_trace.h"
 
 /* ============================================================
  *  Constants and Macros
@@ -47,6 +71,50 @@
 #define DEFAULT_CACHE_PATH  "/var/run/gaming/ps5_cache.json"
 
 #define MAIN_LOOP_INTERVAL_MS   100
+#define MQTT_RTT_INTERVAL_SEC   10
+#define COROUTINE_POLL_MAX      16      // 協程等待的 fd 併入主循環 poll 的上限
+
+// 非同步喚醒: 驗證須在狀態逾時 (SERVER_STATE_TIMEOUT_SEC) 前結束
+#define WAKE_VERIFY_TIMEOUT_SEC 25
+#define WAKE_MAX_RETRIES        1
+#define WAKE_CLIENT_NONE        -1      // MQTT 發起的喚醒,不回覆客戶端
+
+// 斷路器: 連續失敗次數 / 初始冷卻 / 冷卻上限 (毫秒)
+#define SCAN_BREAKER_THRESHOLD      3
+#define SCAN_BREAKER_BASE_MS        (5 * 60 * 1000)
+#define SCAN_BREAKER_MAX_MS         (60 * 60 * 1000)
+#define CEC_BREAKER_THRESHOLD       5
+#define CEC_BREAKER_BASE_MS         1000
+#define CEC_BREAKER_MAX_MS          (5 * 60 * 1000)
+#define RECOVERY_BREAKER_THRESHOLD  3
+#define RECOVERY_BREAKER_BASE_MS    5000
+#define RECOVERY_BREAKER_MAX_MS     (SERVER_DETECT_INTERVAL_SEC * 1000)
+
+// 僅有長選項的 CLI 參數
+enum {
+    OPT_QOS_TC = 256,
+    OPT_NETNS,
+    OPT_BEACON,
+    OPT_MQTT,
+    OPT_WEBHOOK,
+    OPT_PRESENCE,
+    OPT_PASSIVE,
+    OPT_L2_PRESENCE,
+    OPT_ACL,
+    OPT_BENCH,
+    OPT_FAULTS,
+    OPT_THREADS,
+};
+
+// 主循環 poll 集合的固定欄位,其後接協程等待的 fd
+enum {
+    WAKE_FD_CEC = 0,        // CEC 執行緒有結果
+    WAKE_FD_WORKER,         // 背景工作完成
+    WAKE_FD_LINK_PROBE,     // 連線品質探測完成
+    WAKE_FD_READY_PROBE,    // Remote Play 就緒探測完成
+    WAKE_FD_L2,             // L2 在線事件 (netlink / hostapd,共 L2_MAX_FDS 個)
+    WAKE_FD_FIXED = WAKE_FD_L2 + L2_MAX_FDS
+};
 
 /* ============================================================
  *  Global Variables
@@ -65,14 +133,79 @@ static struct {
     char subnet[32];
     char cache_path[256];
     bool use_mock;
+    bool qos_enabled;
+    char qos_tc_iface[QOS_IFACE_MAX_LEN];
+    char qos_tc_classid[QOS_CLASSID_MAX_LEN];
+    char netns[QOS_NETNS_MAX_LEN];
+    bool beacon_enabled;
+    char beacon_group[16];
+    uint16_t beacon_port;
+    bool mqtt_enabled;
+    char mqtt_host[MQTT_HOST_MAX_LEN];
+    uint16_t mqtt_port;
+    const char *webhook_urls[WEBHOOK_MAX_ENDPOINTS];
+    int webhook_count;
+    bool presence_enabled;
+    bool passive_enabled;
+    bool l2_enabled;
+    const char *acl_rules[CLIENT_ACL_MAX_RULES];
+    int acl_count;
+    bool bench_mode;
+    const char *fault_spec;
+    const char *thread_rules[THREAD_CLASS_COUNT];
+    int thread_rule_count;
 } g_config = {
     .ws_port = DEFAULT_WS_PORT,
     .cec_device = DEFAULT_CEC_DEVICE,
     .subnet = DEFAULT_SUBNET,
     .cache_path = DEFAULT_CACHE_PATH,
-    .use_mock = false
+    .use_mock = false,
+    .qos_enabled = false,
+    .beacon_enabled = false,
+    .beacon_group = STATUS_BEACON_DEFAULT_GROUP,
+    .beacon_port = STATUS_BEACON_DEFAULT_PORT,
+    .mqtt_enabled = false,
+    .mqtt_port = MQTT_DEFAULT_PORT,
+    .webhook_count = 0,
+    .presence_enabled = false,
+    .passive_enabled = false,
+    .l2_enabled = false,
+    .acl_count = 0,
+    .bench_mode = false,
+    .fault_spec = NULL,
+    .thread_rule_count = 0
 };
 
+// 最後一次對外發布的 PS5 綜合狀態
+static const char *g_last_ps5_status = NULL;
+static char g_last_ps5_ip[PS5_IP_MAX_LEN] = {0};
+
+// MQTT 喚醒指令 (延後到主循環執行)
+static bool g_mqtt_wake_requested = false;
+static time_t g_mqtt_last_rtt_time = 0;
+
+// 等待非同步喚醒結果的客戶端 (斷線後清除,不回覆給別的連線)
+static int g_wake_client_id = WAKE_CLIENT_NONE;
+
+// 最後一次通知 webhook 的 CEC / 網路狀態
+static ps5_power_state_t g_last_cec_state = PS5_POWER_UNKNOWN;
+static bool g_last_network_online = false;
+
+// 斷路器: 持續失敗的子系統暫停呼叫,避免無謂的 fork / 輪詢 / 狀態震盪
+static circuit_breaker_t g_scan_breaker;
+static circuit_breaker_t g_cec_breaker;
+static circuit_breaker_t g_recovery_breaker;
+static circuit_breaker_t *const g_breakers[] = {
+    &g_scan_breaker, &g_cec_breaker, &g_recovery_breaker
+};
+#define BREAKER_COUNT (int)(sizeof(g_breakers) / sizeof(g_breakers[0]))
+
+// process_state_machine() 上次看到的狀態 (恢復斷路器使用)
+static server_state_t g_last_sm_state = SERVER_STATE_INIT;
+
+// 進行中的偵測是否允許掃描 (結果回調時回報掃描斷路器)
+static bool g_detect_scan_allowed = false;
+
 /* ============================================================
  *  Signal Handling
  * ============================================================ */
@@ -130,6 +263,139 @@ static void on_cec_event(cec_event_t event, ps5_power_state_t state, void *user_
     
     // 更新狀態機
     server_sm_update_cec_state(ctx, state);
+    
+    if (state == PS5_POWER_ON) {
+        ps5_wake_report_awake();
+    }
+}
+
+/**
+ * @brief 被動聽到 PS5 廣播 (DDP / SSDP / mDNS) 回調
+ */
+static void on_discovery_sighting(const discovery_sighting_t *sighting, void *user_data) {
+    server_context_t *ctx = (server_context_t*)user_data;
+    const ps5_info_t *known = &ctx->ps5_status.info;
+    
+    // 已知主機 MAC 時只接受同一台
+    if (known->mac[0] != '\0' && sighting->mac[0] != '\0' &&
+        strcasecmp(known->mac, sighting->mac) != 0) {
+        return;
+    }
+    
+    fprintf(stdout, "[Discovery] PS5 %s at %s via %s\n",
+            discovery_status_to_string(sighting->status), sighting->ip,
+            discovery_proto_to_string(sighting->proto));
+    
+    if (sighting->status == DISCOVERY_STATUS_GONE) {
+        if (strcmp(known->ip, sighting->ip) == 0) {
+            server_sm_update_network_state(ctx, false);
+        }
+        return;
+    }
+    
+    ps5_info_t info;
+    memset(&info, 0, sizeof(info));
+    snprintf(info.ip, sizeof(info.ip), "%s", sighting->ip);
+    if (sighting->mac[0] != '\0') {
+        snprintf(info.mac, sizeof(info.mac), "%s", sighting->mac);
+    } else if (strcmp(known->ip, sighting->ip) == 0) {
+        snprintf(info.mac, sizeof(info.mac), "%s", known->mac);
+    } else {
+        neigh_table_lookup_ip(info.ip, info.mac, sizeof(info.mac));
+    }
+    
+    // SSDP / mDNS 不帶 MAC: 解析不到或與已知主機不同 (其他裝置或偽造廣播) 就丟棄
+    if (info.mac[0] == '\0' ||
+        (known->mac[0] != '\0' && strcasecmp(known->mac, info.mac) != 0)) {
+        fprintf(stdout, "[Discovery] Ignoring sighting at %s: MAC %s does not match\n",
+                info.ip, info.mac[0] != '\0' ? info.mac : "unknown");
+        return;
+    }
+    
+    info.online = true;
+    info.last_seen = server_clock_now();
+    info.method = DETECT_METHOD_PASSIVE;
+    
+    // DDP 200: 主機確實已開機 (非休眠)
+    if (sighting->status == DISCOVERY_STATUS_ON) {
+        ps5_wake_report_awake();
+    }
+    
+    bool moved = (strcmp(known->ip, info.ip) != 0 || strcasecmp(known->mac, info.mac) != 0);
+    server_sm_update_ps5_info(ctx, &info);
+    if (moved) {
+        ps5_detector_save_cache(&info);
+    }
+    
+    // 主機剛發聲,延後下一次主動偵測
+    ctx->last_detect_time = server_clock_now();
+}
+
+/**
+ * @brief 橋接 FDB / Wi-Fi 關聯變化回調
+ */
+static void on_l2_event(const l2_event_t *event, void *user_data) {
+    server_context_t *ctx = (server_context_t*)user_data;
+    const ps5_info_t *known = &ctx->ps5_status.info;
+    
+    // 任一來源仍看得到主機即視為在線
+    server_sm_update_network_state(ctx, l2_presence_is_present());
+    
+    if (!event->present || event->ip[0] == '\0') {
+        return;
+    }
+    
+    // 主機換了 IP (DHCP),直接更新不必重新掃描
+    if (strcmp(known->ip, event->ip) != 0) {
+        ps5_info_t info;
+        memset(&info, 0, sizeof(info));
+        snprintf(info.ip, sizeof(info.ip), "%s", event->ip);
+        snprintf(info.mac, sizeof(info.mac), "%s", known->mac);
+        info.online = true;
+        info.last_seen = server_clock_now();
+        info.method = DETECT_METHOD_PASSIVE;
+        
+        server_sm_update_ps5_info(ctx, &info);
+        ps5_detector_save_cache(&info);
+    }
+    
+    ctx->last_detect_time = server_clock_now();
+}
+
+/**
+ * @brief ARP 探測 / 掃描回應回調
+ */
+static void on_arp_result(const arp_result_t *result, void *user_data) {
+    server_context_t *ctx = (server_context_t*)user_data;
+    const ps5_info_t *known = &ctx->ps5_status.info;
+    
+    // 單點探測是偵測流程送出的,結果交回給它
+    if (!result->sweep) {
+        ps5_detector_handle_arp_result(result->ip, result->mac, result->alive);
+        return;
+    }
+    
+    // 掃描只關心已知主機
+    if (known->mac[0] == '\0' || strcasecmp(result->mac, known->mac) != 0) {
+        return;
+    }
+    
+    fprintf(stdout, "[ARP] PS5 found at %s\n", result->ip);
+    
+    ps5_info_t info;
+    memset(&info, 0, sizeof(info));
+    snprintf(info.ip, sizeof(info.ip), "%s", result->ip);
+    snprintf(info.mac, sizeof(info.mac), "%s", result->mac);
+    info.online = true;
+    info.last_seen = server_clock_now();
+    info.method = DETECT_METHOD_ARP;
+    
+    bool moved = (strcmp(known->ip, info.ip) != 0);
+    server_sm_update_ps5_info(ctx, &info);
+    if (moved) {
+        ps5_detector_save_cache(&info);
+    }
+    ctx->last_detect_time = server_clock_now();
 }
 
 /**
@@ -146,6 +412,340 @@ static void on_ws_connect(int client_id, const char *client_ip, void *user_data)
 static void on_ws_disconnect(int client_id, void *user_data) {
     (void)user_data;
     fprintf(stdout, "[WebSocket] Client %d disconnected\n", client_id);
+    
+    if (client_id == g_wake_client_id) {
+        g_wake_client_id = WAKE_CLIENT_NONE;
+    }
+}
+
+/**
+ * @brief 加入連線品質統計 (RTT / jitter / loss)
+ */
+static void add_link_stats(cJSON *parent) {
+    link_stats_t stats;
+    if (link_monitor_get_stats(&stats) != LINK_MON_OK) {
+        return;
+    }
+    
+    cJSON *link = cJSON_AddObjectToObject(parent, "link");
+    cJSON_AddBoolToObject(link, "active", stats.active);
+    cJSON_AddNumberToObject(link, "samples", stats.replies);
+    cJSON_AddNumberToObject(link, "rtt_ms", stats.rtt_avg_us / 1000.0);
+    cJSON_AddNumberToObject(link, "rtt_min_ms", stats.rtt_min_us / 1000.0);
+    cJSON_AddNumberToObject(link, "rtt_max_ms", stats.rtt_max_us / 1000.0);
+    cJSON_AddNumberToObject(link, "rtt_p95_ms", link_monitor_percentile_us(&stats, 95) / 1000.0);
+    cJSON_AddNumberToObject(link, "jitter_ms", stats.jitter_us / 1000.0);
+    cJSON_AddNumberToObject(link, "loss_pct", link_monitor_loss_percent(&stats));
+}
+
+/**
+ * @brief 加入持續連線的在線偵測統計
+ */
+static void add_presence_stats(cJSON *parent) {
+    presence_stats_t stats;
+    if (presence_channel_get_stats(&stats) != PRESENCE_OK) {
+        return;
+    }
+    
+    cJSON *presence = cJSON_AddObjectToObject(parent, "presence");
+    cJSON_AddStringToObject(presence, "state", presence_state_to_string(stats.state));
+    cJSON_AddBoolToObject(presence, "online", stats.online);
+    cJSON_AddNumberToObject(presence, "connects", stats.connects);
+    cJSON_AddNumberToObject(presence, "losses", stats.losses);
+    cJSON_AddNumberToObject(presence, "retry_ms", stats.backoff_ms);
+}
+
+/**
+ * @brief 加入被動偵測統計
+ */
+static void add_discovery_stats(cJSON *parent) {
+    discovery_stats_t stats;
+    if (discovery_listener_get_stats(&stats) != DISCOVERY_OK) {
+        return;
+    }
+    
+    cJSON *discovery = cJSON_AddObjectToObject(parent, "discovery");
+    cJSON_AddNumberToObject(discovery, "packets", stats.packets);
+    for (int p = 0; p < DISCOVERY_PROTO_COUNT; p++) {
+        if (stats.listening_mask & DISCOVERY_MASK(p)) {
+            cJSON_AddNumberToObject(discovery, discovery_proto_to_string((discovery_proto_t)p),
+                                    stats.sightings[p]);
+        }
+    }
+    cJSON_AddNumberToObject(discovery, "last_sighting", (double)stats.last_sighting);
+}
+
+/**
+ * @brief 加入 L2 在線偵測統計
+ */
+static void add_l2_stats(cJSON *parent) {
+    l2_stats_t stats;
+    if (l2_presence_get_stats(&stats) != L2_OK) {
+        return;
+    }
+    
+    cJSON *l2 = cJSON_AddObjectToObject(parent, "l2");
+    cJSON_AddBoolToObject(l2, "present", l2_presence_is_present());
+    cJSON_AddNumberToObject(l2, "hostapd", stats.hostapd_attached);
+    for (int s = 0; s < L2_SOURCE_COUNT; s++) {
+        if (stats.listening_mask & L2_SOURCE_MASK(s)) {
+            cJSON_AddNumberToObject(l2, l2_source_to_string((l2_source_t)s), stats.events[s]);
+        }
+    }
+    cJSON_AddNumberToObject(l2, "last_event", (double)stats.last_event);
+}
+
+/**
+ * @brief 加入 ARP 探測統計
+ */
+static void add_arp_stats(cJSON *parent) {
+    arp_stats_t stats;
+    if (arp_prober_get_stats(&stats) != ARP_OK) {
+        return;
+    }
+    
+    cJSON *arp = cJSON_AddObjectToObject(parent, "arp");
+    cJSON_AddStringToObject(arp, "iface", stats.iface);
+    cJSON_AddNumberToObject(arp, "requests", stats.requests);
+    cJSON_AddNumberToObject(arp, "replies", stats.replies);
+    cJSON_AddNumberToObject(arp, "timeouts", stats.timeouts);
+    cJSON_AddNumberToObject(arp, "learned", stats.learned);
+    cJSON_AddNumberToObject(arp, "sweeps", stats.sweeps);
+    cJSON_AddBoolToObject(arp, "sweeping", stats.sweeping);
+    cJSON_AddNumberToObject(arp, "rtt_ms", stats.rtt_avg_us / 1000.0);
+}
+
+/**
+ * @brief 加入背景工作池統計
+ */
+static void add_worker_stats(cJSON *parent) {
+    worker_pool_stats_t stats;
+    if (worker_pool_get_stats(&stats) != WORKER_POOL_OK) {
+        return;
+    }
+    
+    cJSON *workers = cJSON_AddObjectToObject(parent, "workers");
+    cJSON_AddNumberToObject(workers, "threads", stats.threads);
+    cJSON_AddNumberToObject(workers, "queued", stats.queued);
+    cJSON_AddNumberToObject(workers, "running", stats.running);
+    cJSON_AddNumberToObject(workers, "max_queued", stats.max_queued);
+    cJSON_AddNumberToObject(workers, "completed", stats.completed);
+    cJSON_AddNumberToObject(workers, "expired", stats.expired);
+    cJSON_AddNumberToObject(workers, "rejected", stats.rejected);
+    cJSON_AddNumberToObject(workers, "wait_ms", stats.wait_avg_us / 1000.0);
+    cJSON_AddNumberToObject(workers, "wait_max_ms", stats.wait_max_us / 1000.0);
+    cJSON_AddNumberToObject(workers, "run_ms", stats.run_avg_us / 1000.0);
+}
+
+/**
+ * @brief 加入客戶端 ACL 統計
+ */
+static void add_acl_stats(cJSON *parent) {
+    client_acl_stats_t stats;
+    if (!client_acl_is_active() || client_acl_get_stats(&stats) != CLIENT_ACL_OK) {
+        return;
+    }
+    
+    cJSON *acl = cJSON_AddObjectToObject(parent, "acl");
+    cJSON_AddNumberToObject(acl, "rules", stats.rules);
+    cJSON_AddNumberToObject(acl, "lookups", stats.lookups);
+    cJSON_AddNumberToObject(acl, "denied", stats.denied);
+    cJSON_AddNumberToObject(acl, "query_only", stats.query_only);
+}
+
+/**
+ * @brief 加入執行緒策略統計
+ */
+static void add_thread_stats(cJSON *parent) {
+    cJSON *threads = cJSON_AddObjectToObject(parent, "threads");
+    
+    for (int i = 0; i < THREAD_CLASS_COUNT; i++) {
+        thread_policy_t policy;
+        thread_policy_stats_t stats;
+        if (thread_policy_get((thread_class_t)i, &policy) != THREAD_POLICY_OK ||
+            thread_policy_get_stats((thread_class_t)i, &stats) != THREAD_POLICY_OK) {
+            continue;
+        }
+        
+        cJSON *entry = cJSON_AddObjectToObject(threads, thread_class_to_string((thread_class_t)i));
+        cJSON_AddStringToObject(entry, "sched", thread_sched_to_string(policy.sched));
+        if (policy.sched == THREAD_SCHED_NICE) {
+            cJSON_AddNumberToObject(entry, "nice", policy.nice);
+        }
+        cJSON_AddNumberToObject(entry, "cpu_mask", policy.cpu_mask);
+        cJSON_AddNumberToObject(entry, "applied", stats.applied);
+        cJSON_AddNumberToObject(entry, "failed", stats.failed);
+    }
+}
+
+#ifdef ENABLE_FAULT_INJECTION
+/**
+ * @brief 加入故障注入統計
+ */
+static void add_fault_stats(cJSON *parent) {
+    if (!fault_inject_is_active()) {
+        return;
+    }
+    
+    cJSON *faults = cJSON_AddObjectToObject(parent, "faults");
+    for (int i = 0; i < FAULT_POINT_COUNT; i++) {
+        fault_stats_t stats;
+        fault_inject_get_stats((fault_point_t)i, &stats);
+        
+        cJSON *entry = cJSON_AddObjectToObject(faults, fault_point_to_string((fault_point_t)i));
+        cJSON_AddNumberToObject(entry, "calls", stats.calls);
+        cJSON_AddNumberToObject(entry, "delays", stats.delays);
+        cJSON_AddNumberToObject(entry, "delay_ms", (double)stats.delay_ms);
+        cJSON_AddNumberToObject(entry, "failures", stats.failures);
+        cJSON_AddNumberToObject(entry, "corruptions", stats.corruptions);
+    }
+}
+#endif
+
+/**
+ * @brief 加入斷路器統計
+ */
+static void add_breaker_stats(cJSON *parent) {
+    cJSON *breakers = cJSON_AddObjectToObject(parent, "breakers");
+    
+    for (int i = 0; i < BREAKER_COUNT; i++) {
+        const circuit_breaker_t *cb = g_breakers[i];
+        cJSON *entry = cJSON_AddObjectToObject(breakers, cb->name);
+        cJSON_AddStringToObject(entry, "state",
+                                circuit_breaker_state_to_string(circuit_breaker_get_state(cb)));
+        cJSON_AddNumberToObject(entry, "failures", cb->stats.failures);
+        cJSON_AddNumberToObject(entry, "opens", cb->stats.opens);
+        cJSON_AddNumberToObject(entry, "rejected", cb->stats.rejected);
+        cJSON_AddNumberToObject(entry, "retry_in_ms", circuit_breaker_remaining_ms(cb));
+    }
+}
+
+/**
+ * @brief 加入各偵測方法的命中率與延遲,以及目前的嘗試順序
+ */
+static void add_detection_stats(cJSON *parent) {
+    cJSON *detection = cJSON_AddObjectToObject(parent, "detection");
+    
+    detect_method_t order[DETECT_METHOD_COUNT];
+    ps5_detector_get_method_order(order);
+    cJSON *order_arr = cJSON_AddArrayToObject(detection, "order");
+    
+    for (int i = 0; i < DETECT_METHOD_COUNT; i++) {
+        cJSON_AddItemToArray(order_arr, cJSON_CreateString(ps5_detector_method_string(order[i])));
+        
+        detect_method_stats_t st;
+        if (ps5_detector_get_method_stats((detect_method_t)i, &st) != PS5_DETECT_OK) {
+            continue;
+        }
+        cJSON *entry = cJSON_AddObjectToObject(detection,
+                                               ps5_detector_method_string((detect_method_t)i));
+        cJSON_AddNumberToObject(entry, "attempts", st.attempts);
+        cJSON_AddNumberToObject(entry, "hits", st.hits);
+        cJSON_AddNumberToObject(entry, "avg_ms", st.avg_latency_us / 1000.0);
+    }
+}
+
+/**
+ * @brief 加入啟動時選定的後端
+ */
+static void add_capability_stats(cJSON *parent) {
+    const capability_report_t *report = capability_probe_get();
+    if (report == NULL) {
+        return;
+    }
+    
+    cJSON *caps = cJSON_AddObjectToObject(parent, "capabilities");
+    cJSON_AddStringToObject(caps, "ping", ps5_detector_ping_backend_string(ps5_detector_get_ping_backend()));
+    cJSON_AddStringToObject(caps, "cec", cec_backend_to_string(report->cec));
+    cJSON_AddStringToObject(caps, "neigh", neigh_backend_to_string(report->neigh));
+    cJSON_AddStringToObject(caps, "loop", capability_loop_backend_string(report->loop));
+    cJSON_AddNumberToObject(caps, "probe_ms", report->probe_ms);
+}
+
+/**
+ * @brief 列出非 CLOSED 的斷路器 (狀態查詢的 "degraded" 欄位)
+ */
+static void add_degraded_subsystems(cJSON *parent) {
+    cJSON *degraded = NULL;
+    
+    for (int i = 0; i < BREAKER_COUNT; i++) {
+        if (circuit_breaker_get_state(g_breakers[i]) == CB_STATE_CLOSED) {
+            continue;
+        }
+        if (degraded == NULL) {
+            degraded = cJSON_AddArrayToObject(parent, "degraded");
+        }
+        cJSON_AddItemToArray(degraded, cJSON_CreateString(g_breakers[i]->name));
+    }
+}
+
+/**
+ * @brief MQTT 喚醒指令回調
+ */
+static void on_mqtt_wake(void *user_data) {
+    (void)user_data;
+    fprintf(stdout, "[MQTT] Wake command received\n");
+    g_mqtt_wake_requested = true;
+}
+
+/**
+ * @brief 非同步喚醒完成回調 (user_data 為發起的客戶端 ID)
+ */
+static void on_wake_done(wake_result_t result, void *user_data) {
+    int client_id = (int)(intptr_t)user_data;
+    
+    fprintf(stdout, "[Server] Wake result: %s\n", ps5_wake_result_string(result));
+    server_sm_handle_event(&g_server_ctx, (result == WAKE_RESULT_SUCCESS) ?
+                           SERVER_EVENT_COMPLETED : SERVER_EVENT_ERROR);
+    
+    // 發起的客戶端已斷線 (或是 MQTT 發起),不回覆
+    bool same_client = (client_id != WAKE_CLIENT_NONE && client_id == g_wake_client_id);
+    g_wake_client_id = WAKE_CLIENT_NONE;
+    if (!same_client) {
+        return;
+    }
+    
+    // 最終結果回覆給發起的客戶端 (先前已回覆 pending)
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "type", "wake_response");
+    if (result == WAKE_RESULT_SUCCESS) {
+        cJSON_AddStringToObject(root, "status", "success");
+        cJSON_AddStringToObject(root, "message", "PS5 woke up successfully");
+    } else {
+        cJSON_AddStringToObject(root, "status", "failed");
+        cJSON_AddStringToObject(root, "message", ps5_wake_result_string(result));
+    }
+    
+    char *json = cJSON_PrintUnformatted(root);
+    ws_server_send(client_id, json);
+    cJSON_free(json);
+    cJSON_Delete(root);
+}
+
+/**
+ * @brief 條件查詢: 客戶端帶 if_version 時回傳 not_modified / delta
+ * 
+ * @return 快取的回應 (不需釋放), NULL 表示需要完整回應
+ */
+static const char* conditional_query_reply(const char *payload) {
+    // 大部分查詢不帶 if_version,避免多餘的 JSON 解析
+    if (payload == NULL || strstr(payload, "if_version") == NULL) {
+        return NULL;
+    }
+    
+    cJSON *root = cJSON_Parse(payload);
+    if (root == NULL) {
+        return NULL;
+    }
+    
+    const char *reply = NULL;
+    cJSON *if_version = cJSON_GetObjectItem(root, "if_version");
+    if (cJSON_IsNumber(if_version) && if_version->valuedouble >= 0) {
+        reply = status_snapshot_conditional_reply((uint32_t)if_version->valuedouble);
+    }
+    
+    cJSON_Delete(root);
+    return reply;
 }
 
 /**
@@ -156,6 +756,9 @@ static char* on_ws_message(int client_id, ws_message_type_t msg_type,
     server_context_t *ctx = (server_context_t*)user_data;
     char *response = NULL;
     
+    uint64_t trace_start = server_trace_now_us();
+    SERVER_TRACE2(ws_msg_recv, client_id, msg_type);
+    
     fprintf(stdout, "[WebSocket] Client %d, Message Type: %s\n", 
             client_id, ws_message_type_to_string(msg_type));
     
@@ -164,15 +767,32 @@ static char* on_ws_message(int client_id, ws_message_type_t msg_type,
             // 處理 PS5 狀態查詢
             server_sm_handle_event(ctx, SERVER_EVENT_CLIENT_QUERY);
             
-            const char *status = server_sm_get_ps5_status(ctx);
+            // 客戶端已是最新版本: 回傳小型 not_modified / delta
+            const char *cached = conditional_query_reply(payload);
+            if (cached != NULL) {
+                response = strdup(cached);
+                server_sm_handle_event(ctx, SERVER_EVENT_COMPLETED);
+                break;
+            }
+            
+            // 使用版本快照,確保內容與版本號一致
+            status_snapshot_t snap;
+            status_snapshot_get(&snap);
             
             // 建立回應
             cJSON *root = cJSON_CreateObject();
             cJSON_AddStringToObject(root, "type", "ps5_status");
-            cJSON_AddStringToObject(root, "status", status);
-            cJSON_AddStringToObject(root, "ip", ctx->ps5_status.info.ip);
-            cJSON_AddStringToObject(root, "mac", ctx->ps5_status.info.mac);
-            cJSON_AddNumberToObject(root, "timestamp", (double)time(NULL));
+            cJSON_AddNumberToObject(root, "version", snap.version);
+            cJSON_AddStringToObject(root, "status", snap.status);
+            cJSON_AddStringToObject(root, "ip", snap.ip);
+            cJSON_AddStringToObject(root, "mac", snap.mac);
+            if (snap.ip[0] != '\0') {
+                cJSON_AddStringToObject(root, "method",
+                                        ps5_detector_method_string(ctx->ps5_status.info.method));
+            }
+            cJSON_AddNumberToObject(root, "timestamp", (double)server_clock_now());
+            add_link_stats(root);
+            add_degraded_subsystems(root);
             
             response = cJSON_PrintUnformatted(root);
             cJSON_Delete(root);
@@ -187,21 +807,25 @@ static char* on_ws_message(int client_id, ws_message_type_t msg_type,
             
             fprintf(stdout, "[Server] Waking PS5...\n");
             
-            // 執行喚醒
+            // 喚醒在協程中進行,完成後由 on_wake_done 回覆最終結果
             ps5_info_t *ps5 = &ctx->ps5_status.info;
-            wake_result_t wake_result = ps5_wake(ps5, 30);
+            int wake_ret = ps5_wake_start(ps5, WAKE_VERIFY_TIMEOUT_SEC, WAKE_MAX_RETRIES,
+                                          on_wake_done, (void *)(intptr_t)client_id);
             
             // 建立回應
             cJSON *root = cJSON_CreateObject();
             cJSON_AddStringToObject(root, "type", "wake_response");
             
-            if (wake_result == WAKE_RESULT_SUCCESS) {
-                cJSON_AddStringToObject(root, "status", "success");
-                cJSON_AddStringToObject(root, "message", "PS5 woke up successfully");
-                server_sm_handle_event(ctx, SERVER_EVENT_COMPLETED);
+            if (wake_ret == 0) {
+                g_wake_client_id = client_id;
+                cJSON_AddStringToObject(root, "status", "pending");
+                cJSON_AddStringToObject(root, "message", "Wake command sent, verifying");
+            } else if (ps5_wake_in_progress()) {
+                cJSON_AddStringToObject(root, "status", "busy");
+                cJSON_AddStringToObject(root, "message", ps5_wake_error_string(wake_ret));
             } else {
                 cJSON_AddStringToObject(root, "status", "failed");
-                cJSON_AddStringToObject(root, "message", ps5_wake_result_string(wake_result));
+                cJSON_AddStringToObject(root, "message", ps5_wake_error_string(wake_ret));
                 server_sm_handle_event(ctx, SERVER_EVENT_ERROR);
             }
             
@@ -214,7 +838,46 @@ static char* on_ws_message(int client_id, ws_message_type_t msg_type,
             // 回應 Pong
             cJSON *root = cJSON_CreateObject();
             cJSON_AddStringToObject(root, "type", "pong");
-            cJSON_AddNumberToObject(root, "timestamp", (double)time(NULL));
+            cJSON_AddNumberToObject(root, "timestamp", (double)server_clock_now());
+            
+            response = cJSON_PrintUnformatted(root);
+            cJSON_Delete(root);
+            break;
+        }
+        
+        case WS_MSG_STATS: {
+            // 回應執行統計
+            cJSON *root = cJSON_CreateObject();
+            cJSON_AddStringToObject(root, "type", "stats");
+            cJSON_AddStringToObject(root, "state", 
+                                    server_state_to_string(server_sm_get_state(ctx)));
+            cJSON_AddNumberToObject(root, "clients", ws_server_get_client_count());
+            cJSON_AddNumberToObject(root, "timestamp", (double)server_clock_now());
+            add_link_stats(root);
+            add_presence_stats(root);
+            add_discovery_stats(root);
+            add_l2_stats(root);
+            add_arp_stats(root);
+            add_worker_stats(root);
+            add_thread_stats(root);
+            add_acl_stats(root);
+#ifdef ENABLE_FAULT_INJECTION
+            add_fault_stats(root);
+#endif
+            add_breaker_stats(root);
+            add_capability_stats(root);
+            add_detection_stats(root);
+            
+            webhook_stats_t wh_stats;
+            if (webhook_dispatcher_get_stats(&wh_stats) == WEBHOOK_OK) {
+                cJSON *wh = cJSON_AddObjectToObject(root, "webhooks");
+                cJSON_AddNumberToObject(wh, "queued", wh_stats.queued);
+                cJSON_AddNumberToObject(wh, "events_sent", wh_stats.events_sent);
+                cJSON_AddNumberToObject(wh, "batches_sent", wh_stats.batches_sent);
+                cJSON_AddNumberToObject(wh, "dropped", wh_stats.events_dropped);
+                cJSON_AddNumberToObject(wh, "failed", wh_stats.batches_failed);
+                cJSON_AddNumberToObject(wh, "retries", wh_stats.retries);
+            }
             
             response = cJSON_PrintUnformatted(root);
             cJSON_Delete(root);
@@ -226,6 +889,8 @@ static char* on_ws_message(int client_id, ws_message_type_t msg_type,
             break;
     }
     
+    SERVER_TRACE4(ws_reply_sent, client_id, msg_type, server_trace_now_us() - trace_start,
+                  response ? strlen(response) : 0);
     return response;
 }
 
@@ -233,12 +898,67 @@ static char* on_ws_message(int client_id, ws_message_type_t msg_type,
  *  Initialization and Cleanup
  * ============================================================ */
 
+/**
+ * @brief 偵測平台能力,為各子系統選擇最快的後端
+ */
+static void select_backends(capability_report_t *caps) {
+    if (capability_probe_run(g_config.cec_device, caps) != CAP_PROBE_OK) {
+        return;
+    }
+    
+    // ARP 需要子網路所在的介面; 開不起來就改選次佳的 IP 層探測
+    if (caps->caps.arp_packet && arp_prober_init(g_config.subnet) != ARP_OK) {
+        fprintf(stderr, "[Server] Failed to initialize ARP Prober\n");
+        caps->caps.arp_packet = false;
+        capability_probe_select(&caps->caps, caps);
+    } else if (caps->caps.arp_packet) {
+        arp_prober_set_callback(on_arp_result, &g_server_ctx);
+    }
+    ps5_detector_set_ping_backend(caps->ping);
+    neigh_table_set_backend(caps->neigh);
+    if (caps->cec != CEC_BACKEND_NONE) {        // 否則保留 cec-ctl,裝置稍後出現仍可用
+        cec_monitor_set_backend(caps->cec);
+    }
+}
+
 /**
  * @brief 初始化所有模組
  */
 static int initialize_modules(void) {
     fprintf(stdout, "[Server] Initializing modules...\n");
     
+#ifdef ENABLE_FAULT_INJECTION
+    // 故障注入 (僅測試建置): --faults 優先,否則讀環境變數
+    if (fault_inject_configure(g_config.fault_spec) != FAULT_OK) {
+        fprintf(stderr, "[Server] Invalid fault spec\n");
+        return -1;
+    }
+#endif
+    
+    // 執行緒策略: 先套用到主執行緒,之後建立的執行緒各自套用所屬類別
+    // (掃描、Webhook 等背景工作讓出 CPU 給封包轉發)
+    thread_policy_init();
+    for (int i = 0; i < g_config.thread_rule_count; i++) {
+        int ret = thread_policy_add_rule(g_config.thread_rules[i]);
+        if (ret != THREAD_POLICY_OK) {
+            fprintf(stderr, "[Server] Invalid thread rule %s: %s\n",
+                    g_config.thread_rules[i], thread_policy_error_string(ret));
+            return -1;
+        }
+    }
+    thread_policy_apply(THREAD_CLASS_MAIN);
+    
+    // 0. 偵測平台能力,為各子系統選擇最快的後端
+    capability_report_t caps;
+    select_backends(&caps);
+    
+    // 背景工作池: 快取檔寫入等阻塞工作不佔用主循環
+    if (worker_pool_init(0) != WORKER_POOL_OK || worker_pool_start() != WORKER_POOL_OK) {
+        fprintf(stderr, "[Server] Failed to start worker pool, blocking work stays inline\n");
+        worker_pool_cleanup();
+        // 非關鍵錯誤,繼續
+    }
+    
     // 1. 初始化 CEC Monitor
     fprintf(stdout, "[Server] Initializing CEC Monitor (%s)...\n", g_config.cec_device);
     if (cec_monitor_init(g_config.cec_device) != 0) {
@@ -246,6 +966,12 @@ static int initialize_modules(void) {
         // 非關鍵錯誤,繼續
     } else {
         cec_monitor_set_callback(on_cec_event, &g_server_ctx);
+        
+        // CEC 查詢移到獨立執行緒,主循環不再等待 CEC 匯流排
+        if (cec_monitor_start_thread() != CEC_OK) {
+            fprintf(stderr, "[Server] Failed to start CEC thread, polling inline\n");
+            // 非關鍵錯誤,繼續
+        }
     }
     
     // 2. 初始化 PS5 Detector
@@ -262,7 +988,20 @@ static int initialize_modules(void) {
         // 非關鍵錯誤,繼續
     }
     
-    // 4. 初始化 WebSocket Server
+    // 4. 初始化 WebSocket Server (先載入 ACL,連線一進來就檢查)
+    client_acl_init();
+    for (int i = 0; i < g_config.acl_count; i++) {
+        int ret = client_acl_add_rule(g_config.acl_rules[i]);
+        if (ret != CLIENT_ACL_OK) {
+            fprintf(stderr, "[Server] Invalid ACL rule %s: %s\n",
+                    g_config.acl_rules[i], client_acl_error_string(ret));
+            return -1;
+        }
+    }
+    if (client_acl_is_active()) {
+        fprintf(stdout, "[Server] Client ACL: %d rules, unmatched peers denied\n", g_config.acl_count);
+    }
+    
     fprintf(stdout, "[Server] Initializing WebSocket Server (port %d)...\n", g_config.ws_port);
     if (ws_server_init(g_config.ws_port) != 0) {
         fprintf(stderr, "[Server] Failed to initialize WebSocket Server\n");
@@ -280,6 +1019,111 @@ static int initialize_modules(void) {
         return -1;
     }
     
+    // 狀態版本快照 (條件查詢使用)
+    status_snapshot_init();
+    
+    // 斷路器
+    circuit_breaker_init(&g_scan_breaker, "scan", SCAN_BREAKER_THRESHOLD,
+                         SCAN_BREAKER_BASE_MS, SCAN_BREAKER_MAX_MS);
+    circuit_breaker_init(&g_cec_breaker, "cec", CEC_BREAKER_THRESHOLD,
+                         CEC_BREAKER_BASE_MS, CEC_BREAKER_MAX_MS);
+    circuit_breaker_init(&g_recovery_breaker, "recovery", RECOVERY_BREAKER_THRESHOLD,
+                         RECOVERY_BREAKER_BASE_MS, RECOVERY_BREAKER_MAX_MS);
+    
+    // 6. 初始化 Link Monitor
+    if (link_monitor_init(0) != LINK_MON_OK) {
+        fprintf(stderr, "[Server] Failed to initialize Link Monitor\n");
+        // 非關鍵錯誤,繼續
+    }
+    
+    if (ready_probe_init(0) != READY_PROBE_OK) {
+        fprintf(stderr, "[Server] Failed to initialize Ready Probe\n");
+        // 非關鍵錯誤,繼續
+    }
+    
+    // 持續連線在線偵測 (選用),取代週期偵測發現主機離線
+    if (g_config.presence_enabled && presence_channel_init(0) != PRESENCE_OK) {
+        fprintf(stderr, "[Server] Failed to initialize Presence Channel\n");
+        // 非關鍵錯誤,繼續
+    }
+    
+    // 被動聽取 PS5 廣播 (選用),主機有發聲時不必主動掃描
+    if (g_config.passive_enabled) {
+        fprintf(stdout, "[Server] Initializing Discovery Listener...\n");
+        if (discovery_listener_init(DISCOVERY_MASK_ALL) != DISCOVERY_OK) {
+            fprintf(stderr, "[Server] Failed to initialize Discovery Listener\n");
+            // 非關鍵錯誤,繼續
+        } else {
+            discovery_listener_set_callback(on_discovery_sighting, &g_server_ctx);
+        }
+    }
+    
+    // 路由器本身的 L2 事件 (選用),主機接上 / 離開橋接埠或 AP 時立即得知
+    if (g_config.l2_enabled) {
+        fprintf(stdout, "[Server] Initializing L2 Presence...\n");
+        if (l2_presence_init(NULL) != L2_OK) {
+            fprintf(stderr, "[Server] Failed to initialize L2 Presence\n");
+            // 非關鍵錯誤,繼續
+        } else {
+            l2_presence_set_callback(on_l2_event, &g_server_ctx);
+        }
+    }
+    
+    // 7. 初始化 Status Beacon (選用)
+    if (g_config.beacon_enabled) {
+        fprintf(stdout, "[Server] Initializing Status Beacon...\n");
+        if (status_beacon_init(g_config.beacon_group, g_config.beacon_port) != BEACON_OK) {
+            fprintf(stderr, "[Server] Failed to initialize Status Beacon\n");
+            // 非關鍵錯誤,繼續
+        }
+    }
+    
+    // 8. 初始化 MQTT Publisher (選用)
+    if (g_config.mqtt_enabled) {
+        fprintf(stdout, "[Server] Initializing MQTT Publisher...\n");
+        mqtt_config_t mqtt_config;
+        mqtt_publisher_default_config(&mqtt_config);
+        snprintf(mqtt_config.host, sizeof(mqtt_config.host), "%s", g_config.mqtt_host);
+        mqtt_config.port = g_config.mqtt_port;
+        
+        if (mqtt_publisher_init(&mqtt_config) != MQTT_OK) {
+            fprintf(stderr, "[Server] Failed to initialize MQTT Publisher\n");
+            // 非關鍵錯誤,繼續
+        } else {
+            mqtt_publisher_set_wake_callback(on_mqtt_wake, &g_server_ctx);
+        }
+    }
+    
+    // 9. 初始化 Webhook Dispatcher (選用)
+    if (g_config.webhook_count > 0) {
+        fprintf(stdout, "[Server] Initializing Webhook Dispatcher...\n");
+        if (webhook_dispatcher_init() != WEBHOOK_OK) {
+            fprintf(stderr, "[Server] Failed to initialize Webhook Dispatcher\n");
+            // 非關鍵錯誤,繼續
+        } else {
+            for (int i = 0; i < g_config.webhook_count; i++) {
+                if (webhook_dispatcher_add_endpoint(g_config.webhook_urls[i]) != WEBHOOK_OK) {
+                    fprintf(stderr, "[Server] Invalid webhook URL: %s\n", g_config.webhook_urls[i]);
+                }
+            }
+        }
+    }
+    
+    // 10. 初始化 QoS Manager (選用)
+    if (g_config.qos_enabled) {
+        fprintf(stdout, "[Server] Initializing QoS Manager...\n");
+        qos_config_t qos_config;
+        qos_manager_default_config(&qos_config);
+        snprintf(qos_config.tc_iface, sizeof(qos_config.tc_iface), "%s", g_config.qos_tc_iface);
+        snprintf(qos_config.tc_classid, sizeof(qos_config.tc_classid), "%s", g_config.qos_tc_classid);
+        snprintf(qos_config.netns, sizeof(qos_config.netns), "%s", g_config.netns);
+        
+        if (qos_manager_init(&qos_config) != QOS_OK) {
+            fprintf(stderr, "[Server] Failed to initialize QoS Manager\n");
+            // 非關鍵錯誤,繼續
+        }
+    }
+    
     fprintf(stdout, "[Server] All modules initialized successfully\n");
     return 0;
 }
@@ -296,6 +1140,12 @@ static int start_services(void) {
         return -1;
     }
     
+    // 啟動 Webhook 背景執行緒 (選用)
+    if (g_config.webhook_count > 0 && webhook_dispatcher_start() != WEBHOOK_OK) {
+        fprintf(stderr, "[Server] Failed to start Webhook Dispatcher\n");
+        // 非關鍵錯誤,繼續
+    }
+    
     fprintf(stdout, "[Server] All services started successfully\n");
     return 0;
 }
@@ -308,16 +1158,37 @@ static void cleanup_modules(void) {
     
     ws_server_stop();
     ws_server_cleanup();
+    client_acl_cleanup();
     
     cec_monitor_stop();
     cec_monitor_cleanup();
     
+    // 先完成排隊中的工作 (例如最後一次快取寫入),再清理提交它們的模組
+    worker_pool_cleanup();
+    
     ps5_detector_cleanup();
     ps5_wake_cleanup();
     
+    qos_manager_cleanup();
+    link_monitor_cleanup();
+    ready_probe_cleanup();
+    presence_channel_cleanup();
+    discovery_listener_cleanup();
+    l2_presence_cleanup();
+    arp_prober_cleanup();
+    status_beacon_cleanup();
+    status_snapshot_cleanup();
+    mqtt_publisher_cleanup();
+    webhook_dispatcher_cleanup();
+    
     server_sm_stop(&g_server_ctx);
     server_sm_cleanup(&g_server_ctx);
     
+#ifdef ENABLE_FAULT_INJECTION
+    fault_inject_cleanup();
+#endif
+    thread_policy_cleanup();
+    
     fprintf(stdout, "[Server] Cleanup completed\n");
 }
 
@@ -325,47 +1196,115 @@ static void cleanup_modules(void) {
  *  Main Loop
  * ============================================================ */
 
+/**
+ * @brief 廣播 PS5 狀態更新給所有客戶端
+ */
+static void broadcast_ps5_status(const char *status) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "type", "ps5_status_update");
+    cJSON_AddNumberToObject(root, "version", status_snapshot_get_version());
+    cJSON_AddStringToObject(root, "status", status);
+    cJSON_AddNumberToObject(root, "timestamp", (double)server_clock_now());
+    
+    char *json = cJSON_PrintUnformatted(root);
+    ws_server_broadcast(json);
+    cJSON_free(json);
+    cJSON_Delete(root);
+}
+
+/**
+ * @brief 非同步偵測完成回調
+ */
+static void on_detect_done(int result, const ps5_info_t *info, void *user_data) {
+    (void)user_data;
+    
+    if (g_detect_scan_allowed) {
+        if (result == PS5_DETECT_ERROR_SCAN_FAILED) {
+            circuit_breaker_record_failure(&g_scan_breaker);
+        } else {
+            circuit_breaker_record_success(&g_scan_breaker);
+        }
+    }
+    
+    // 找不到時以 MAC 在整個 /24 背景掃描,換了 IP 的主機由 on_arp_result 找回
+    if (result != 0 && g_server_ctx.ps5_status.info.mac[0] != '\0') {
+        arp_prober_sweep();
+    }
+    
+    if (result == 0) {
+        server_sm_update_ps5_info(&g_server_ctx, info);
+        server_sm_handle_event(&g_server_ctx, SERVER_EVENT_COMPLETED);
+        
+        fprintf(stdout, "[Server] PS5 detected: %s (%s) via %s\n",
+                info->ip, info->mac, ps5_detector_method_string(info->method));
+    } else if (!g_detect_scan_allowed) {
+        // 掃描暫停中,本輪視為完成而非錯誤
+        server_sm_handle_event(&g_server_ctx, SERVER_EVENT_COMPLETED);
+    } else {
+        fprintf(stderr, "[Server] PS5 detection failed\n");
+        server_sm_handle_event(&g_server_ctx, SERVER_EVENT_ERROR);
+    }
+}
+
 /**
  * @brief 處理狀態機狀態
  */
 static void process_state_machine(void) {
     server_state_t state = server_sm_get_state(&g_server_ctx);
     
+    // 進入 ERROR 記一次失敗; 正常完成一輪回到 IDLE 記一次成功
+    if (state != g_last_sm_state) {
+        if (state == SERVER_STATE_ERROR) {
+            circuit_breaker_record_failure(&g_recovery_breaker);
+        } else if (state == SERVER_STATE_IDLE && g_last_sm_state != SERVER_STATE_ERROR) {
+            circuit_breaker_record_success(&g_recovery_breaker);
+        }
+        g_last_sm_state = state;
+    }
+    
     switch (state) {
+        case SERVER_STATE_MONITORING: {
+            // CEC 狀態已更新,進入廣播
+            server_sm_handle_event(&g_server_ctx, SERVER_EVENT_COMPLETED);
+            break;
+        }
+        
         case SERVER_STATE_DETECTING: {
-            // 執行 PS5 偵測
-            ps5_info_t info;
-            if (ps5_detector_scan(&info) == 0) {
-                server_sm_update_ps5_info(&g_server_ctx, &info);
-                server_sm_handle_event(&g_server_ctx, SERVER_EVENT_COMPLETED);
-                
-                fprintf(stdout, "[Server] PS5 detected: %s (%s)\n", info.ip, info.mac);
-            } else {
-                fprintf(stderr, "[Server] PS5 detection failed\n");
-                server_sm_handle_event(&g_server_ctx, SERVER_EVENT_ERROR);
+            // 偵測進行中: 結果由 on_detect_done 處理
+            if (ps5_detector_detect_in_progress()) {
+                break;
+            }
+            
+            // nmap 無法執行時只略過掃描,其餘方法照常
+            g_detect_scan_allowed = circuit_breaker_allow(&g_scan_breaker);
+            ps5_detector_set_scan_enabled(g_detect_scan_allowed);
+            
+            // 執行 PS5 偵測 (快取 IP / 鄰居表 / DHCP 租約同時進行,先回應者勝)
+            // 探測在主循環 poll 中等待,最後手段的掃描交給背景工作池
+            int ret = ps5_detector_detect_start(g_server_ctx.ps5_status.info.ip,
+                                                on_detect_done, NULL);
+            if (ret != PS5_DETECT_OK && ret != PS5_DETECT_ERROR_BUSY) {
+                ps5_info_t none;
+                memset(&none, 0, sizeof(none));
+                on_detect_done(ret, &none, NULL);
             }
             break;
         }
         
         case SERVER_STATE_BROADCASTING: {
             // 廣播狀態更新給所有客戶端
-            const char *status = server_sm_get_ps5_status(&g_server_ctx);
-            
-            cJSON *root = cJSON_CreateObject();
-            cJSON_AddStringToObject(root, "type", "ps5_status_update");
-            cJSON_AddStringToObject(root, "status", status);
-            cJSON_AddNumberToObject(root, "timestamp", (double)time(NULL));
-            
-            char *json = cJSON_PrintUnformatted(root);
-            ws_server_broadcast(json);
-            cJSON_free(json);
-            cJSON_Delete(root);
+            broadcast_ps5_status(server_sm_get_ps5_status(&g_server_ctx));
             
             server_sm_handle_event(&g_server_ctx, SERVER_EVENT_COMPLETED);
             break;
         }
         
         case SERVER_STATE_ERROR: {
+            // 反覆進入 ERROR 時停留在 ERROR,冷卻後才再次恢復
+            if (!circuit_breaker_allow(&g_recovery_breaker)) {
+                break;
+            }
+            
             // 錯誤狀態 - 嘗試恢復
             fprintf(stderr, "[Server] In error state, attempting recovery...\n");
             server_sm_handle_event(&g_server_ctx, SERVER_EVENT_NONE);
@@ -377,6 +1316,153 @@ static void process_state_machine(void) {
     }
 }
 
+/**
+ * @brief PS5 綜合狀態變化時的處理
+ */
+static void on_ps5_status_changed(const char *old_status, const char *new_status) {
+    const ps5_info_t *info = &g_server_ctx.ps5_status.info;
+    
+    fprintf(stdout, "[Server] PS5 status: %s -> %s\n",
+            old_status ? old_status : "none", new_status);
+    
+    bool is_ready = (strcmp(new_status, "ready") == 0);
+    bool is_on = is_ready || (strcmp(new_status, "on") == 0);
+    
+    status_snapshot_update(new_status, info->ip, info->mac);
+    
+    // 已知主機位址後保持連線; 不論開關機都持續,才能即時發現上線 / 離線
+    if (g_config.presence_enabled && info->ip[0] != '\0') {
+        presence_channel_start(info->ip);
+    }
+    
+    // L2 事件以 MAC 比對,主機換 IP 也能追蹤
+    if (g_config.l2_enabled && info->mac[0] != '\0') {
+        l2_presence_set_mac(info->mac);
+    }
+    
+    // 多播狀態給無連線的監聽者
+    beacon_status_t beacon = {
+        .status_version = status_snapshot_get_version(),
+        .power_state = (uint8_t)g_server_ctx.ps5_status.cec_state,
+        .network_online = g_server_ctx.ps5_status.network_online,
+        .status = status_beacon_code_from_string(new_status),
+    };
+    snprintf(beacon.ip, sizeof(beacon.ip), "%s", info->ip);
+    snprintf(beacon.mac, sizeof(beacon.mac), "%s", info->mac);
+    status_beacon_publish(&beacon);
+    
+    // 更新 MQTT retained 主題
+    if (mqtt_publisher_set_device(info->mac) == MQTT_OK) {
+        char network[MQTT_PAYLOAD_MAX_LEN];
+        snprintf(network, sizeof(network), "{\"online\":%s,\"ip\":\"%s\"}",
+                 g_server_ctx.ps5_status.network_online ? "true" : "false", info->ip);
+        mqtt_publisher_update("state", new_status);
+        mqtt_publisher_update("network", network);
+    }
+    
+    // 開機時提升主機流量優先權,離開 "on" 時移除
+    if (qos_manager_is_active() && !is_on) {
+        qos_manager_remove();
+    } else if (is_on) {
+        qos_manager_apply(info->ip, info->mac);
+    }
+    
+    // 連線品質探測只在開機時執行
+    if (is_on) {
+        link_monitor_start(info->ip);
+    } else {
+        link_monitor_stop();
+    }
+    
+    // 網路在線後等待 Remote Play 埠接受連線; 就緒時立即推送,
+    // 讓客戶端只在正確時機連線一次
+    if (is_ready) {
+        broadcast_ps5_status(new_status);
+    } else if (is_on) {
+        ready_probe_start(info->ip);
+    } else {
+        ready_probe_stop();
+    }
+}
+
+/**
+ * @brief 檢查 PS5 綜合狀態是否變化
+ */
+static void check_ps5_status_change(void) {
+    const char *status = server_sm_get_ps5_status(&g_server_ctx);
+    const char *ip = g_server_ctx.ps5_status.info.ip;
+    
+    if (g_last_ps5_status == NULL || strcmp(g_last_ps5_status, status) != 0) {
+        on_ps5_status_changed(g_last_ps5_status, status);
+        g_last_ps5_status = status;
+    } else if (strcmp(g_last_ps5_ip, ip) != 0) {
+        // 狀態不變但 IP 變更 (DHCP),重新套用
+        on_ps5_status_changed(status, status);
+    }
+    
+    snprintf(g_last_ps5_ip, sizeof(g_last_ps5_ip), "%s", ip);
+}
+
+/**
+ * @brief MQTT 週期工作: 喚醒指令與 RTT 主題
+ */
+static void process_mqtt(void) {
+    if (g_mqtt_wake_requested) {
+        g_mqtt_wake_requested = false;
+        
+        server_sm_handle_event(&g_server_ctx, SERVER_EVENT_WAKE_REQUEST);
+        int wake_ret = ps5_wake_start(&g_server_ctx.ps5_status.info, WAKE_VERIFY_TIMEOUT_SEC,
+                                      WAKE_MAX_RETRIES, on_wake_done,
+                                      (void *)(intptr_t)WAKE_CLIENT_NONE);
+        if (wake_ret != 0) {
+            fprintf(stdout, "[MQTT] Wake not started: %s\n", ps5_wake_error_string(wake_ret));
+            if (!ps5_wake_in_progress()) {
+                server_sm_handle_event(&g_server_ctx, SERVER_EVENT_ERROR);
+            }
+        }
+    }
+    
+    // RTT 變化頻繁,限制發布頻率
+    time_t now = server_clock_now();
+    link_stats_t stats;
+    if (now - g_mqtt_last_rtt_time >= MQTT_RTT_INTERVAL_SEC &&
+        link_monitor_get_stats(&stats) == LINK_MON_OK && stats.active && stats.replies > 0) {
+        char rtt[MQTT_PAYLOAD_MAX_LEN];
+        snprintf(rtt, sizeof(rtt),
+                 "{\"rtt_ms\":%.2f,\"rtt_p95_ms\":%.2f,\"jitter_ms\":%.2f,\"loss_pct\":%.1f}",
+                 stats.rtt_avg_us / 1000.0, link_monitor_percentile_us(&stats, 95) / 1000.0,
+                 stats.jitter_us / 1000.0, link_monitor_loss_percent(&stats));
+        mqtt_publisher_update("rtt", rtt);
+        g_mqtt_last_rtt_time = now;
+    }
+    
+    mqtt_publisher_process();
+}
+
+/**
+ * @brief CEC / 網路狀態變化時通知 webhook (只排入佇列,不阻塞)
+ */
+static void notify_webhooks(void) {
+    const ps5_status_t *ps5 = &g_server_ctx.ps5_status;
+    char data[WEBHOOK_DATA_MAX_LEN];
+    
+    if (ps5->cec_state != g_last_cec_state) {
+        snprintf(data, sizeof(data), "{\"power_state\":\"%s\",\"status\":\"%s\"}",
+                 ps5_power_state_to_string(ps5->cec_state),
+                 server_sm_get_ps5_status(&g_server_ctx));
+        webhook_dispatcher_notify("cec_state", data);
+        g_last_cec_state = ps5->cec_state;
+    }
+    
+    if (ps5->network_online != g_last_network_online) {
+        snprintf(data, sizeof(data), "{\"online\":%s,\"ip\":\"%s\",\"status\":\"%s\"}",
+                 ps5->network_online ? "true" : "false", ps5->info.ip,
+                 server_sm_get_ps5_status(&g_server_ctx));
+        webhook_dispatcher_notify("network", data);
+        g_last_network_online = ps5->network_online;
+    }
+}
+
 /**
  * @brief 主事件循環
  */
@@ -388,21 +1474,129 @@ static void main_loop(void) {
         .tv_nsec = MAIN_LOOP_INTERVAL_MS * 1000000  // ms to ns
     };
     
+    // CEC 執行緒與背景工作池有結果、探測 socket 就緒、L2 事件到達時喚醒主循環
+    // (fd 為 -1 時 poll 會略過),其後接協程等待的 fd (喚醒驗證連線 / 偵測探測)
+    struct pollfd wake_fds[WAKE_FD_FIXED + COROUTINE_POLL_MAX] = {
+        [WAKE_FD_CEC]         = { .fd = cec_monitor_get_event_fd(), .events = POLLIN },
+        [WAKE_FD_WORKER]      = { .fd = worker_pool_get_event_fd(), .events = POLLIN },
+        [WAKE_FD_LINK_PROBE]  = { .fd = -1, .events = POLLOUT },
+        [WAKE_FD_READY_PROBE] = { .fd = -1, .events = POLLOUT },
+    };
+    for (int i = 0; i < L2_MAX_FDS; i++) {
+        wake_fds[WAKE_FD_L2 + i] = (struct pollfd){ .fd = -1, .events = POLLIN };
+    }
+    int cec_event_fd = wake_fds[WAKE_FD_CEC].fd;
+    
     while (g_running) {
         // 更新狀態機
         server_sm_update(&g_server_ctx);
         
-        // 處理 CEC 事件
-        cec_monitor_process(50);
+        // 處理 CEC 事件 (CEC 持續失敗時由斷路器暫停輪詢)
+        if (cec_event_fd >= 0) {
+            // 查詢在 CEC 執行緒進行,這裡只取回結果並執行回調
+            // 斷路器打開時暫停執行緒,冷卻後放行一次試探查詢
+            if (circuit_breaker_get_state(&g_cec_breaker) == CB_STATE_OPEN) {
+                cec_monitor_set_paused(!circuit_breaker_allow(&g_cec_breaker));
+            }
+            
+            int cec_ret = cec_monitor_dispatch();
+            if (cec_ret == CEC_OK) {
+                circuit_breaker_record_success(&g_cec_breaker);
+            } else if (cec_ret == CEC_ERROR_COMMAND_FAILED) {
+                circuit_breaker_record_failure(&g_cec_breaker);
+                if (circuit_breaker_get_state(&g_cec_breaker) == CB_STATE_OPEN) {
+                    cec_monitor_set_paused(true);
+                }
+            }
+        } else if (circuit_breaker_allow(&g_cec_breaker)) {
+            if (cec_monitor_process(50) == CEC_OK) {
+                circuit_breaker_record_success(&g_cec_breaker);
+            } else {
+                circuit_breaker_record_failure(&g_cec_breaker);
+            }
+        }
         
         // 處理 WebSocket 事件
         ws_server_service(50);
         
+        // 背景工作完成回調 (在主執行緒執行)
+        worker_pool_process();
+        
+        // 持續連線中斷 / 恢復即時回報網路狀態 (非阻塞)
+        if (g_config.presence_enabled) {
+            presence_event_t presence = presence_channel_process();
+            if (presence != PRESENCE_EVENT_NONE) {
+                server_sm_update_network_state(&g_server_ctx, presence == PRESENCE_EVENT_UP);
+            }
+        }
+        
+        // 被動偵測 (非阻塞,收完即返回)
+        if (g_config.passive_enabled) {
+            discovery_listener_process();
+        }
+        
+        // ARP 回應 / 掃描進度 (非阻塞)
+        arp_prober_process();
+        
+        // L2 在線事件 (非阻塞)
+        if (g_config.l2_enabled) {
+            l2_presence_process();
+        }
+        
+        // 狀態 beacon 心跳
+        status_beacon_process();
+        
+        // MQTT 發布 / 重連 / 指令 (非阻塞)
+        if (g_config.mqtt_enabled) {
+            process_mqtt();
+        }
+        
         // 處理狀態機狀態
         process_state_machine();
         
-        // 短暫休息
-        nanosleep(&sleep_time, NULL);
+        // Remote Play 就緒探測 (非阻塞)
+        if (ready_probe_process() == READY_PROBE_READY &&
+            !g_server_ctx.ps5_status.remote_play_ready) {
+            server_sm_update_ready_state(&g_server_ctx, true);
+        }
+        
+        // 檢查 PS5 狀態變化
+        check_ps5_status_change();
+        
+        // Webhook 通知 (由背景執行緒送出)
+        if (g_config.webhook_count > 0) {
+            notify_webhooks();
+        }
+        
+        // 短暫休息 (CEC 執行緒、背景工作、探測或協程等待的 fd 就緒時立即喚醒)
+        wake_fds[WAKE_FD_LINK_PROBE].fd = link_monitor_get_fd();
+        wake_fds[WAKE_FD_READY_PROBE].fd = ready_probe_get_fd();
+        
+        // hostapd socket 會隨重新掃描增減,每輪重取
+        int l2_fds[L2_MAX_FDS];
+        int l2_nfds = g_config.l2_enabled ? l2_presence_get_fds(l2_fds, L2_MAX_FDS) : 0;
+        for (int i = 0; i < L2_MAX_FDS; i++) {
+            wake_fds[WAKE_FD_L2 + i].fd = (i < l2_nfds) ? l2_fds[i] : -1;
+        }
+        
+        int coro_nfds = coro_sched_pollfds(&wake_fds[WAKE_FD_FIXED], COROUTINE_POLL_MAX);
+        int timeout_ms = coro_sched_timeout_ms(MAIN_LOOP_INTERVAL_MS);
+        bool have_fds = (coro_nfds > 0);
+        for (int i = 0; i < WAKE_FD_FIXED; i++) {
+            have_fds = have_fds || wake_fds[i].fd >= 0;
+        }
+        if (have_fds) {
+            poll(wake_fds, (nfds_t)(WAKE_FD_FIXED + coro_nfds), timeout_ms);
+        } else {
+            sleep_time.tv_nsec = (long)timeout_ms * 1000000L;
+            nanosleep(&sleep_time, NULL);
+        }
+        
+        // 連線品質探測 (非阻塞),poll 一返回就處理,RTT 才不含主循環週期
+        link_monitor_process();
+        
+        // 恢復等待結束的協程 (喚醒流程 / 偵測流程)
+        coro_sched_run(&wake_fds[WAKE_FD_FIXED], coro_nfds);
     }
     
     fprintf(stdout, "[Server] Main loop exited\n");
@@ -423,6 +1617,34 @@ static void print_usage(const char *program_name) {
     printf("  -c, --cec DEVICE      CEC device (default: %s)\n", DEFAULT_CEC_DEVICE);
     printf("  -s, --subnet SUBNET   Network subnet (default: %s)\n", DEFAULT_SUBNET);
     printf("  -m, --mock            Use mock mode for testing\n");
+    printf("  -Q, --qos             Prioritize PS5 traffic (nftables DSCP) while on\n");
+    printf("      --qos-tc IF,CLASS Also steer PS5 traffic into tc class (e.g. br-lan,1:10)\n");
+    printf("      --netns NAME      Apply QoS rules inside network namespace NAME\n");
+    printf("      --beacon[=GROUP[:PORT]]\n");
+    printf("                        Multicast binary status beacon (default: %s:%d)\n",
+           STATUS_BEACON_DEFAULT_GROUP, STATUS_BEACON_DEFAULT_PORT);
+    printf("      --mqtt HOST[:PORT]\n");
+    printf("                        Publish retained status topics to MQTT broker (port %d)\n",
+           MQTT_DEFAULT_PORT);
+    printf("      --webhook URL     POST CEC/network changes to http:// URL (up to %d)\n",
+           WEBHOOK_MAX_ENDPOINTS);
+    printf("      --presence        Hold a keepalive TCP connection to detect PS5 loss\n");
+    printf("      --passive         Listen for PS5 DDP/SSDP/mDNS announcements\n");
+    printf("      --l2-presence     Follow PS5 MAC in bridge FDB and hostapd station events\n");
+    printf("      --acl PREFIX[=deny|query|wake]\n");
+    printf("                        Allow clients from PREFIX (IPv4/IPv6, repeatable, up to %d);\n",
+           CLIENT_ACL_MAX_RULES);
+    printf("                        longest prefix wins, unmatched clients are refused\n");
+    printf("      --threads CLASS=[normal|idle|nice:N][@CPUS]\n");
+    printf("                        Scheduling and CPUs for main, cec, worker or webhook\n");
+    printf("                        threads (repeatable; default worker/webhook nice %d)\n",
+           THREAD_POLICY_BACKGROUND_NICE);
+    printf("      --bench           Measure this device, print a JSON report with\n");
+    printf("                        recommended intervals, and exit\n");
+#ifdef ENABLE_FAULT_INJECTION
+    printf("      --faults SPEC     Inject delays/failures, e.g. cec.fail=0.2,cmd.delay=50-400@0.5\n");
+    printf("                        (default: $%s)\n", FAULT_ENV_VAR);
+#endif
     printf("  -h, --help            Show this help message\n");
     printf("  -v, --version         Show version information\n");
     printf("\n");
@@ -445,6 +1667,21 @@ static int parse_arguments(int argc, char *argv[]) {
         {"cec",     required_argument, 0, 'c'},
         {"subnet",  required_argument, 0, 's'},
         {"mock",    no_argument,       0, 'm'},
+        {"qos",     no_argument,       0, 'Q'},
+        {"qos-tc",  required_argument, 0, OPT_QOS_TC},
+        {"netns",   required_argument, 0, OPT_NETNS},
+        {"beacon",  optional_argument, 0, OPT_BEACON},
+        {"mqtt",    required_argument, 0, OPT_MQTT},
+        {"webhook", required_argument, 0, OPT_WEBHOOK},
+        {"presence", no_argument,      0, OPT_PRESENCE},
+        {"passive", no_argument,       0, OPT_PASSIVE},
+        {"l2-presence", no_argument,   0, OPT_L2_PRESENCE},
+        {"acl",     required_argument, 0, OPT_ACL},
+        {"threads", required_argument, 0, OPT_THREADS},
+        {"bench",   no_argument,       0, OPT_BENCH},
+#ifdef ENABLE_FAULT_INJECTION
+        {"faults",  required_argument, 0, OPT_FAULTS},
+#endif
         {"help",    no_argument,       0, 'h'},
         {"version", no_argument,       0, 'v'},
         {0, 0, 0, 0}
@@ -453,7 +1690,7 @@ static int parse_arguments(int argc, char *argv[]) {
     int opt;
     int option_index = 0;
     
-    while ((opt = getopt_long(argc, argv, "p:c:s:mhv", long_options, &option_index)) != -1) {
+    while ((opt = getopt_long(argc, argv, "p:c:s:mQhv", long_options, &option_index)) != -1) {
         switch (opt) {
             case 'p':
                 g_config.ws_port = atoi(optarg);
@@ -471,6 +1708,108 @@ static int parse_arguments(int argc, char *argv[]) {
                 g_config.use_mock = true;
                 break;
                 
+            case 'Q':
+                g_config.qos_enabled = true;
+                break;
+                
+            case OPT_QOS_TC: {
+                // 格式: IFACE,CLASSID
+                const char *comma = strchr(optarg, ',');
+                if (comma == NULL) {
+                    fprintf(stderr, "Invalid --qos-tc value: %s\n", optarg);
+                    return -1;
+                }
+                snprintf(g_config.qos_tc_iface, sizeof(g_config.qos_tc_iface),
+                         "%.*s", (int)(comma - optarg), optarg);
+                snprintf(g_config.qos_tc_classid, sizeof(g_config.qos_tc_classid),
+                         "%s", comma + 1);
+                g_config.qos_enabled = true;
+                break;
+            }
+                
+            case OPT_NETNS:
+                // 名稱會進入 root 執行的 shell 指令,只接受 [A-Za-z0-9_.-]
+                if (!qos_manager_validate_netns(optarg)) {
+                    fprintf(stderr, "Invalid --netns value: %s\n", optarg);
+                    return -1;
+                }
+                snprintf(g_config.netns, sizeof(g_config.netns), "%s", optarg);
+                break;
+                
+            case OPT_BEACON:
+                // 格式: GROUP[:PORT]
+                g_config.beacon_enabled = true;
+                if (optarg != NULL) {
+                    const char *colon = strchr(optarg, ':');
+                    if (colon != NULL) {
+                        g_config.beacon_port = (uint16_t)atoi(colon + 1);
+                        snprintf(g_config.beacon_group, sizeof(g_config.beacon_group),
+                                 "%.*s", (int)(colon - optarg), optarg);
+                    } else {
+                        snprintf(g_config.beacon_group, sizeof(g_config.beacon_group),
+                                 "%s", optarg);
+                    }
+                }
+                break;
+                
+            case OPT_MQTT: {
+                // 格式: HOST[:PORT]
+                const char *colon = strchr(optarg, ':');
+                g_config.mqtt_enabled = true;
+                if (colon != NULL) {
+                    g_config.mqtt_port = (uint16_t)atoi(colon + 1);
+                    snprintf(g_config.mqtt_host, sizeof(g_config.mqtt_host),
+                             "%.*s", (int)(colon - optarg), optarg);
+                } else {
+                    snprintf(g_config.mqtt_host, sizeof(g_config.mqtt_host), "%s", optarg);
+                }
+                break;
+            }
+                
+            case OPT_WEBHOOK:
+                if (g_config.webhook_count >= WEBHOOK_MAX_ENDPOINTS) {
+                    fprintf(stderr, "Too many --webhook endpoints (max %d)\n", WEBHOOK_MAX_ENDPOINTS);
+                    return -1;
+                }
+                g_config.webhook_urls[g_config.webhook_count++] = optarg;
+                break;
+                
+            case OPT_PRESENCE:
+                g_config.presence_enabled = true;
+                break;
+                
+            case OPT_PASSIVE:
+                g_config.passive_enabled = true;
+                break;
+                
+            case OPT_L2_PRESENCE:
+                g_config.l2_enabled = true;
+                break;
+                
+            case OPT_ACL:
+                if (g_config.acl_count >= CLIENT_ACL_MAX_RULES) {
+                    fprintf(stderr, "Too many --acl rules (max %d)\n", CLIENT_ACL_MAX_RULES);
+                    return -1;
+                }
+                g_config.acl_rules[g_config.acl_count++] = optarg;
+                break;
+                
+            case OPT_BENCH:
+                g_config.bench_mode = true;
+                break;
+                
+            case OPT_FAULTS:
+                g_config.fault_spec = optarg;
+                break;
+                
+            case OPT_THREADS:
+                if (g_config.thread_rule_count >= THREAD_CLASS_COUNT) {
+                    fprintf(stderr, "Too many --threads rules (max %d)\n", THREAD_CLASS_COUNT);
+                    return -1;
+                }
+                g_config.thread_rules[g_config.thread_rule_count++] = optarg;
+                break;
+                
             case 'h':
                 print_usage(argv[0]);
                 return 1;
@@ -488,6 +1827,72 @@ static int parse_arguments(int argc, char *argv[]) {
     return 0;
 }
 
+/* ============================================================
+ *  Self Benchmark
+ * ============================================================ */
+
+/**
+ * @brief --bench: 在目標機上量測並輸出 JSON 報告 (stdout),不啟動服務
+ */
+static int run_bench(void) {
+    // 各模組的日誌寫在 stdout; 量測期間改到 stderr,報告才能直接被解析
+    fflush(stdout);
+    int report_fd = dup(STDOUT_FILENO);
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    
+    capability_report_t caps;
+    memset(&caps, 0, sizeof(caps));
+    select_backends(&caps);
+    
+    self_bench_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.icmp_backend = caps.caps.icmp_dgram ? PING_BACKEND_ICMP_DGRAM :
+                          caps.caps.icmp_raw ? PING_BACKEND_ICMP_RAW : PING_BACKEND_NONE;
+    config.cec_available = (cec_monitor_init(g_config.cec_device) == CEC_OK);
+    
+    // 用快取中的 PS5 位址量測 ICMP / TCP 延遲
+    ps5_info_t cached;
+    memset(&cached, 0, sizeof(cached));
+    if (ps5_detector_init(g_config.subnet, g_config.cache_path) == 0 &&
+        ps5_detector_get_cached(&cached) == PS5_DETECT_OK) {
+        config.target_ip = cached.ip;
+    } else {
+        fprintf(stderr, "[Bench] No cached PS5 address, skipping ICMP/TCP probes\n");
+    }
+    
+    fprintf(stderr, "[Bench] Measuring...\n");
+    
+    self_bench_report_t report;
+    int ret = self_bench_run(&config, &report);
+    
+    fflush(stdout);
+    if (report_fd >= 0) {
+        dup2(report_fd, STDOUT_FILENO);
+        close(report_fd);
+    }
+    
+    if (ret == SELF_BENCH_OK) {
+        char *json = self_bench_report_to_json(&report);
+        if (json != NULL) {
+            printf("%s\n", json);
+            cJSON_free(json);
+        } else {
+            ret = SELF_BENCH_ERROR_UNKNOWN;
+        }
+    }
+    
+    if (ret != SELF_BENCH_OK) {
+        fprintf(stderr, "[Bench] Failed: %s\n", self_bench_error_string(ret));
+    }
+    
+    fflush(stdout);
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    ps5_detector_cleanup();
+    cec_monitor_cleanup();
+    arp_prober_cleanup();
+    return (ret == SELF_BENCH_OK) ? 0 : -1;
+}
+
 /* ============================================================
  *  Main Entry Point
  * ============================================================ */
@@ -498,18 +1903,23 @@ static int parse_arguments(int argc, char *argv[]) {
 int main(int argc, char *argv[]) {
     int ret = EXIT_SUCCESS;
     
-    // 顯示啟動訊息
-    printf("===========================================\n");
-    printf("  %s v%s\n", PROGRAM_NAME, PROGRAM_VERSION);
-    printf("  Gaming System Server Daemon\n");
-    printf("===========================================\n\n");
-    
     // 解析命令列參數
     int parse_result = parse_arguments(argc, argv);
     if (parse_result != 0) {
         return (parse_result > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
     }
     
+    // 自我量測模式: stdout 只輸出 JSON 報告
+    if (g_config.bench_mode) {
+        return (run_bench() == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    
+    // 顯示啟動訊息
+    printf("===========================================\n");
+    printf("  %s v%s\n", PROGRAM_NAME, PROGRAM_VERSION);
+    printf("  Gaming System Server Daemon\n");
+    printf("===========================================\n\n");
+    
     // 設定 Signal 處理
     setup_signal_handlers();
     
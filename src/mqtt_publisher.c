@@ -0,0 +1,1070 @@
+/**
+ * @file mqtt_publisher.c
+ * @brief MQTT Publisher Implementation - Non-blocking MQTT 3.1.1 client
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "mqtt_publisher.h"
+#include "worker_pool.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <ctype.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define MQTT_CONNECT_TIMEOUT_SEC    10
+#define MQTT_DEVICE_MAX_LEN         13      // 12 hex digits + '\0'
+#define MQTT_SUBTOPIC_MAX_LEN       16
+
+// Control packet types (upper nibble of the fixed header)
+#define MQTT_PKT_CONNECT            0x10
+#define MQTT_PKT_CONNACK            0x20
+#define MQTT_PKT_PUBLISH            0x30
+#define MQTT_PKT_SUBSCRIBE          0x82    // with mandatory flags 0010
+#define MQTT_PKT_SUBACK             0x90
+#define MQTT_PKT_UNSUBSCRIBE        0xA2    // with mandatory flags 0010
+#define MQTT_PKT_PINGREQ            0xC0
+#define MQTT_PKT_PINGRESP           0xD0
+#define MQTT_PKT_DISCONNECT         0xE0
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    char subtopic[MQTT_SUBTOPIC_MAX_LEN];
+    char payload[MQTT_PAYLOAD_MAX_LEN];
+    bool has_value;
+    bool dirty;
+} mqtt_topic_t;
+
+typedef struct {
+    bool initialized;
+    mqtt_config_t config;
+    mqtt_state_t state;
+    int sock_fd;
+
+    // Topics
+    char device[MQTT_DEVICE_MAX_LEN];
+    bool need_subscribe;
+    char subscribed_topic[MQTT_TOPIC_MAX_LEN];      // Wake topic of this session
+    char unsubscribe_topic[MQTT_TOPIC_MAX_LEN];     // Old wake topic after a MAC change
+    mqtt_topic_t topics[MQTT_MAX_TOPICS];
+
+    // Broker address lookup running on the worker pool
+    bool resolving;
+
+    // Buffers
+    uint8_t tx_buf[MQTT_TX_BUFFER_SIZE];
+    size_t tx_len;
+    uint8_t rx_buf[MQTT_RX_BUFFER_SIZE];
+    size_t rx_len;
+    uint32_t rx_skip;       // Bytes left of an oversized packet being discarded
+    uint32_t rx_dropped;    // Oversized packets discarded
+
+    // Timers (server_clock_monotonic_us)
+    uint64_t state_enter_us;
+    uint64_t next_connect_us;
+    uint64_t last_tx_us;
+    uint64_t ping_sent_us;
+    bool ping_outstanding;
+    int backoff_sec;
+    uint16_t next_packet_id;
+
+    // Callback
+    mqtt_wake_callback_t wake_callback;
+    void *wake_user_data;
+} mqtt_publisher_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static mqtt_publisher_context_t g_mqtt_ctx = { .sock_fd = -1 };
+
+// Outlives cleanup(), so a lookup finishing after it is recognised as stale
+static uint32_t g_resolve_generation = 0;
+
+/* ============================================================
+ *  Helper Functions - Encoding
+ * ============================================================ */
+
+/**
+ * @brief Write a length-prefixed UTF-8 string
+ */
+static size_t put_string(uint8_t *buf, const char *str, size_t len) {
+    buf[0] = (uint8_t)(len >> 8);
+    buf[1] = (uint8_t)(len & 0xFF);
+    memcpy(&buf[2], str, len);
+    return len + 2;
+}
+
+/**
+ * @brief Write fixed header, return header length
+ */
+static int put_fixed_header(uint8_t type, uint32_t remaining, uint8_t *buf, size_t size) {
+    uint8_t rl[4];
+    int rl_len = mqtt_encode_remaining_length(remaining, rl);
+    if (rl_len < 0) {
+        return rl_len;
+    }
+
+    if ((size_t)(1 + rl_len) + remaining > size) {
+        return MQTT_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    buf[0] = type;
+    memcpy(&buf[1], rl, (size_t)rl_len);
+    return 1 + rl_len;
+}
+
+/**
+ * @brief Build "<prefix>/<device>/<subtopic>"
+ */
+static void build_topic(const char *subtopic, char *topic, size_t size) {
+    snprintf(topic, size, "%s/%s/%s",
+             g_mqtt_ctx.config.topic_prefix, g_mqtt_ctx.device, subtopic);
+}
+
+/**
+ * @brief Next non-zero packet identifier
+ */
+static uint16_t take_packet_id(void) {
+    uint16_t id = g_mqtt_ctx.next_packet_id;
+    g_mqtt_ctx.next_packet_id = (uint16_t)(id + 1);
+    if (g_mqtt_ctx.next_packet_id == 0) {
+        g_mqtt_ctx.next_packet_id = 1;
+    }
+    return id;
+}
+
+/* ============================================================
+ *  Helper Functions - Connection
+ * ============================================================ */
+
+static void change_state(mqtt_state_t state) {
+    g_mqtt_ctx.state = state;
+    g_mqtt_ctx.state_enter_us = server_clock_monotonic_us();
+}
+
+/**
+ * @brief Drop the connection and schedule a reconnect with backoff
+ */
+static void connection_failed(const char *reason) {
+    if (g_mqtt_ctx.sock_fd >= 0) {
+        close(g_mqtt_ctx.sock_fd);
+        g_mqtt_ctx.sock_fd = -1;
+    }
+
+    g_mqtt_ctx.tx_len = 0;
+    g_mqtt_ctx.rx_len = 0;
+    g_mqtt_ctx.rx_skip = 0;
+    g_mqtt_ctx.ping_outstanding = false;
+
+    // Clean session: the broker forgets our subscription with the connection
+    g_mqtt_ctx.subscribed_topic[0] = '\0';
+    g_mqtt_ctx.unsubscribe_topic[0] = '\0';
+
+    g_mqtt_ctx.next_connect_us = server_clock_monotonic_us() + (uint64_t)g_mqtt_ctx.backoff_sec * 1000000ULL;
+
+    #ifndef TESTING
+    fprintf(stderr, "[MQTT] Connection lost (%s), retry in %ds\n",
+            reason, g_mqtt_ctx.backoff_sec);
+    #else
+    (void)reason;
+    #endif
+
+    g_mqtt_ctx.backoff_sec *= 2;
+    if (g_mqtt_ctx.backoff_sec > MQTT_BACKOFF_MAX_SEC) {
+        g_mqtt_ctx.backoff_sec = MQTT_BACKOFF_MAX_SEC;
+    }
+
+    change_state(MQTT_STATE_DISCONNECTED);
+}
+
+/**
+ * @brief Append a packet to the transmit buffer
+ */
+static bool tx_reserve(size_t *avail, uint8_t **buf) {
+    *buf = g_mqtt_ctx.tx_buf + g_mqtt_ctx.tx_len;
+    *avail = sizeof(g_mqtt_ctx.tx_buf) - g_mqtt_ctx.tx_len;
+    return (*avail > 0);
+}
+
+static bool queue_packet_result(int len) {
+    if (len < 0) {
+        return false;
+    }
+    g_mqtt_ctx.tx_len += (size_t)len;
+    return true;
+}
+
+/**
+ * @brief Write as much of the transmit buffer as the socket accepts
+ */
+static int flush_tx(void) {
+    #ifdef TESTING
+    // In test mode, the transmit buffer is discarded
+    g_mqtt_ctx.tx_len = 0;
+    g_mqtt_ctx.last_tx_us = server_clock_monotonic_us();
+    return MQTT_OK;
+    #else
+    if (g_mqtt_ctx.tx_len == 0) {
+        return MQTT_OK;
+    }
+
+    ssize_t sent = send(g_mqtt_ctx.sock_fd, g_mqtt_ctx.tx_buf, g_mqtt_ctx.tx_len, MSG_NOSIGNAL);
+    if (sent < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return MQTT_OK;
+        }
+        return MQTT_ERROR_SOCKET;
+    }
+
+    memmove(g_mqtt_ctx.tx_buf, g_mqtt_ctx.tx_buf + sent, g_mqtt_ctx.tx_len - (size_t)sent);
+    g_mqtt_ctx.tx_len -= (size_t)sent;
+    g_mqtt_ctx.last_tx_us = server_clock_monotonic_us();
+    return MQTT_OK;
+    #endif
+}
+
+/**
+ * @brief TCP connected: send CONNECT
+ */
+static void send_connect(void) {
+    uint8_t *buf;
+    size_t avail;
+
+    g_mqtt_ctx.tx_len = 0;
+    tx_reserve(&avail, &buf);
+    if (!queue_packet_result(mqtt_encode_connect(&g_mqtt_ctx.config, buf, avail))) {
+        connection_failed("encode");
+        return;
+    }
+
+    change_state(MQTT_STATE_WAIT_CONNACK);
+}
+
+#ifndef TESTING
+/**
+ * @brief Broker address lookup handed to the worker pool
+ */
+typedef struct {
+    uint32_t generation;
+    char host[MQTT_HOST_MAX_LEN];
+    uint16_t port;
+    struct sockaddr_in addr;
+} mqtt_resolve_t;
+
+/**
+ * @brief Resolve the broker host (blocks on DNS unless it is an IPv4 literal)
+ */
+static int resolve_broker(const char *host, uint16_t port, struct sockaddr_in *addr) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(port);
+
+    if (inet_pton(AF_INET, host, &addr->sin_addr) == 1) {
+        return MQTT_OK;
+    }
+
+    struct addrinfo hints;
+    struct addrinfo *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    if (getaddrinfo(host, NULL, &hints, &res) != 0 || res == NULL) {
+        return MQTT_ERROR_SOCKET;
+    }
+    addr->sin_addr = ((struct sockaddr_in *)res->ai_addr)->sin_addr;
+    freeaddrinfo(res);
+
+    return MQTT_OK;
+}
+
+/**
+ * @brief Start a non-blocking TCP connect to a resolved broker address
+ */
+static void connect_broker(const struct sockaddr_in *addr) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        connection_failed("socket");
+        return;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    g_mqtt_ctx.sock_fd = fd;
+
+    if (connect(fd, (const struct sockaddr *)addr, sizeof(*addr)) != 0 && errno != EINPROGRESS) {
+        connection_failed("connect");
+        return;
+    }
+
+    change_state(MQTT_STATE_CONNECTING);
+}
+
+/**
+ * @brief Worker pool job: name lookup
+ */
+static int resolve_job(void *arg) {
+    mqtt_resolve_t *req = (mqtt_resolve_t *)arg;
+    return resolve_broker(req->host, req->port, &req->addr);
+}
+
+/**
+ * @brief Worker pool completion (main loop): connect, unless cleaned up or restarted meanwhile
+ */
+static void resolve_done(int result, void *arg) {
+    mqtt_resolve_t *req = (mqtt_resolve_t *)arg;
+
+    if (g_mqtt_ctx.initialized && g_mqtt_ctx.resolving &&
+        req->generation == g_resolve_generation) {
+        g_mqtt_ctx.resolving = false;
+        if (result == MQTT_OK) {
+            connect_broker(&req->addr);
+        } else {
+            connection_failed("resolve");
+        }
+    }
+
+    free(req);
+}
+#endif /* !TESTING */
+
+/**
+ * @brief Start connecting to the broker
+ *
+ * An IPv4 literal connects right away; a host name is looked up on the
+ * worker pool (inline only when the pool is not running).
+ */
+static void start_connect(void) {
+    #ifdef TESTING
+    // In test mode, no socket; broker packets are fed via mqtt_publisher_feed()
+    send_connect();
+    #else
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+
+    if (inet_pton(AF_INET, g_mqtt_ctx.config.host, &addr.sin_addr) != 1 && worker_pool_is_ready()) {
+        mqtt_resolve_t *req = (mqtt_resolve_t *)malloc(sizeof(mqtt_resolve_t));
+        if (req != NULL) {
+            snprintf(req->host, sizeof(req->host), "%s", g_mqtt_ctx.config.host);
+            req->port = g_mqtt_ctx.config.port;
+            req->generation = ++g_resolve_generation;
+            if (worker_pool_submit(resolve_job, resolve_done, req, 0) == WORKER_POOL_OK) {
+                g_mqtt_ctx.resolving = true;
+                return;
+            }
+            free(req);
+        }
+        // Pool full: fall through to an inline lookup
+    }
+
+    if (resolve_broker(g_mqtt_ctx.config.host, g_mqtt_ctx.config.port, &addr) != MQTT_OK) {
+        connection_failed("resolve");
+        return;
+    }
+    connect_broker(&addr);
+    #endif
+}
+
+/**
+ * @brief Queue SUBSCRIBE and all dirty PUBLISH packets into one write
+ */
+static void queue_pending(void) {
+    char topic[MQTT_TOPIC_MAX_LEN];
+    uint8_t *buf;
+    size_t avail;
+
+    if (g_mqtt_ctx.device[0] == '\0') {
+        return;  // Topics need the console MAC
+    }
+
+    // Wake topic of the previous console MAC
+    if (g_mqtt_ctx.unsubscribe_topic[0] != '\0') {
+        tx_reserve(&avail, &buf);
+        if (queue_packet_result(mqtt_encode_unsubscribe(g_mqtt_ctx.next_packet_id,
+                                                        g_mqtt_ctx.unsubscribe_topic, buf, avail))) {
+            take_packet_id();
+            g_mqtt_ctx.unsubscribe_topic[0] = '\0';
+        }
+    }
+
+    if (g_mqtt_ctx.need_subscribe) {
+        build_topic("wake", topic, sizeof(topic));
+        tx_reserve(&avail, &buf);
+        if (queue_packet_result(mqtt_encode_subscribe(g_mqtt_ctx.next_packet_id, topic, buf, avail))) {
+            take_packet_id();
+            snprintf(g_mqtt_ctx.subscribed_topic, sizeof(g_mqtt_ctx.subscribed_topic), "%s", topic);
+            g_mqtt_ctx.need_subscribe = false;
+        }
+    }
+
+    for (int i = 0; i < MQTT_MAX_TOPICS; i++) {
+        mqtt_topic_t *t = &g_mqtt_ctx.topics[i];
+        if (!t->dirty) {
+            continue;
+        }
+
+        build_topic(t->subtopic, topic, sizeof(topic));
+        tx_reserve(&avail, &buf);
+        if (!queue_packet_result(mqtt_encode_publish(topic, t->payload, true, buf, avail))) {
+            break;  // Buffer full, rest goes out next iteration
+        }
+        t->dirty = false;
+    }
+}
+
+/**
+ * @brief Read whatever the socket has
+ */
+static int receive_available(void) {
+    uint8_t buf[256];
+
+    for (;;) {
+        ssize_t n = recv(g_mqtt_ctx.sock_fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            int rc = mqtt_publisher_feed(buf, (size_t)n);
+            if (rc != MQTT_OK) {
+                return rc;
+            }
+            continue;
+        }
+        if (n == 0) {
+            return MQTT_ERROR_SOCKET;  // Broker closed
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return MQTT_OK;
+        }
+        return MQTT_ERROR_SOCKET;
+    }
+}
+
+/**
+ * @brief Handle one complete incoming packet
+ */
+static int handle_packet(uint8_t header, const uint8_t *body, uint32_t len) {
+    switch (header & 0xF0) {
+        case MQTT_PKT_CONNACK:
+            if (len < 2 || body[1] != 0) {
+                return MQTT_ERROR_PROTOCOL;  // Refused
+            }
+            if (g_mqtt_ctx.state == MQTT_STATE_WAIT_CONNACK) {
+                change_state(MQTT_STATE_CONNECTED);
+                g_mqtt_ctx.backoff_sec = MQTT_BACKOFF_MIN_SEC;
+                g_mqtt_ctx.need_subscribe = true;
+
+                // Values may have changed while offline
+                for (int i = 0; i < MQTT_MAX_TOPICS; i++) {
+                    g_mqtt_ctx.topics[i].dirty = g_mqtt_ctx.topics[i].has_value;
+                }
+
+                #ifndef TESTING
+                fprintf(stdout, "[MQTT] Connected to %s:%u\n",
+                        g_mqtt_ctx.config.host, g_mqtt_ctx.config.port);
+                #endif
+            }
+            return MQTT_OK;
+
+        case MQTT_PKT_PUBLISH: {
+            if (len < 2) {
+                return MQTT_ERROR_PROTOCOL;
+            }
+            uint32_t topic_len = ((uint32_t)body[0] << 8) | body[1];
+            uint32_t offset = 2 + topic_len;
+            if ((header & 0x06) != 0) {
+                offset += 2;  // Packet identifier (QoS > 0)
+            }
+            if (offset > len) {
+                return MQTT_ERROR_PROTOCOL;
+            }
+
+            char topic[MQTT_TOPIC_MAX_LEN];
+            char wake_topic[MQTT_TOPIC_MAX_LEN];
+            build_topic("wake", wake_topic, sizeof(wake_topic));
+
+            if (topic_len >= sizeof(topic)) {
+                return MQTT_OK;  // Not ours
+            }
+            memcpy(topic, &body[2], topic_len);
+            topic[topic_len] = '\0';
+
+            // Retained deliveries replay old commands on every (re)subscribe
+            bool retained = (header & 0x01) != 0;
+            bool has_payload = (offset < len);
+
+            if (!retained && has_payload && g_mqtt_ctx.device[0] != '\0' &&
+                strcmp(topic, wake_topic) == 0 && g_mqtt_ctx.wake_callback != NULL) {
+                g_mqtt_ctx.wake_callback(g_mqtt_ctx.wake_user_data);
+            }
+            return MQTT_OK;
+        }
+
+        case MQTT_PKT_PINGRESP:
+            g_mqtt_ctx.ping_outstanding = false;
+            return MQTT_OK;
+
+        case MQTT_PKT_SUBACK:
+        default:
+            return MQTT_OK;
+    }
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+void mqtt_publisher_default_config(mqtt_config_t *config) {
+    if (config == NULL) {
+        return;
+    }
+
+    memset(config, 0, sizeof(mqtt_config_t));
+    snprintf(config->host, sizeof(config->host), "127.0.0.1");
+    config->port = MQTT_DEFAULT_PORT;
+    snprintf(config->client_id, sizeof(config->client_id), "gaming-server");
+    snprintf(config->topic_prefix, sizeof(config->topic_prefix), "%s", MQTT_DEFAULT_TOPIC_PREFIX);
+    config->keepalive_sec = MQTT_DEFAULT_KEEPALIVE_SEC;
+}
+
+int mqtt_publisher_init(const mqtt_config_t *config) {
+    if (g_mqtt_ctx.initialized) {
+        return MQTT_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    if (config == NULL || config->host[0] == '\0' || config->client_id[0] == '\0') {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    memset(&g_mqtt_ctx, 0, sizeof(mqtt_publisher_context_t));
+    memcpy(&g_mqtt_ctx.config, config, sizeof(mqtt_config_t));
+    g_mqtt_ctx.sock_fd = -1;
+
+    if (g_mqtt_ctx.config.port == 0) {
+        g_mqtt_ctx.config.port = MQTT_DEFAULT_PORT;
+    }
+    if (g_mqtt_ctx.config.keepalive_sec == 0) {
+        g_mqtt_ctx.config.keepalive_sec = MQTT_DEFAULT_KEEPALIVE_SEC;
+    }
+
+    g_mqtt_ctx.backoff_sec = MQTT_BACKOFF_MIN_SEC;
+    g_mqtt_ctx.next_packet_id = 1;
+    g_mqtt_ctx.next_connect_us = 0;  // Connect on first process()
+    change_state(MQTT_STATE_DISCONNECTED);
+
+    g_mqtt_ctx.initialized = true;
+
+    #ifndef TESTING
+    fprintf(stdout, "[MQTT] Initialized: broker=%s:%u, prefix=%s\n",
+            g_mqtt_ctx.config.host, g_mqtt_ctx.config.port,
+            g_mqtt_ctx.config.topic_prefix);
+    #endif
+
+    return MQTT_OK;
+}
+
+void mqtt_publisher_set_wake_callback(mqtt_wake_callback_t callback, void *user_data) {
+    g_mqtt_ctx.wake_callback = callback;
+    g_mqtt_ctx.wake_user_data = user_data;
+}
+
+int mqtt_publisher_set_device(const char *mac) {
+    if (!g_mqtt_ctx.initialized) {
+        return MQTT_ERROR_NOT_INIT;
+    }
+
+    if (mac == NULL) {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    // "AA:BB:CC:DD:EE:FF" -> "aabbccddeeff"
+    char device[MQTT_DEVICE_MAX_LEN];
+    size_t n = 0;
+    for (const char *p = mac; *p != '\0'; p++) {
+        if (*p == ':' || *p == '-') {
+            continue;
+        }
+        if (!isxdigit((unsigned char)*p) || n >= sizeof(device) - 1) {
+            return MQTT_ERROR_INVALID_PARAM;
+        }
+        device[n++] = (char)tolower((unsigned char)*p);
+    }
+    device[n] = '\0';
+
+    if (n != 12) {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    if (strcmp(device, g_mqtt_ctx.device) == 0) {
+        return MQTT_OK;
+    }
+
+    // Stop listening for wake commands addressed to the old MAC
+    if (g_mqtt_ctx.subscribed_topic[0] != '\0') {
+        memcpy(g_mqtt_ctx.unsubscribe_topic, g_mqtt_ctx.subscribed_topic,
+               sizeof(g_mqtt_ctx.unsubscribe_topic));
+        g_mqtt_ctx.subscribed_topic[0] = '\0';
+    }
+
+    snprintf(g_mqtt_ctx.device, sizeof(g_mqtt_ctx.device), "%s", device);
+    g_mqtt_ctx.need_subscribe = true;
+    for (int i = 0; i < MQTT_MAX_TOPICS; i++) {
+        g_mqtt_ctx.topics[i].dirty = g_mqtt_ctx.topics[i].has_value;
+    }
+
+    return MQTT_OK;
+}
+
+int mqtt_publisher_update(const char *subtopic, const char *payload) {
+    if (!g_mqtt_ctx.initialized) {
+        return MQTT_ERROR_NOT_INIT;
+    }
+
+    if (subtopic == NULL || payload == NULL ||
+        strlen(subtopic) >= MQTT_SUBTOPIC_MAX_LEN ||
+        strlen(payload) >= MQTT_PAYLOAD_MAX_LEN) {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    mqtt_topic_t *slot = NULL;
+    for (int i = 0; i < MQTT_MAX_TOPICS; i++) {
+        mqtt_topic_t *t = &g_mqtt_ctx.topics[i];
+        if (t->subtopic[0] != '\0' && strcmp(t->subtopic, subtopic) == 0) {
+            slot = t;
+            break;
+        }
+        if (slot == NULL && t->subtopic[0] == '\0') {
+            slot = t;
+        }
+    }
+
+    if (slot == NULL) {
+        return MQTT_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (slot->has_value && strcmp(slot->payload, payload) == 0) {
+        return MQTT_OK;  // Unchanged, nothing to publish
+    }
+
+    snprintf(slot->subtopic, sizeof(slot->subtopic), "%s", subtopic);
+    snprintf(slot->payload, sizeof(slot->payload), "%s", payload);
+    slot->has_value = true;
+    slot->dirty = true;
+
+    return MQTT_OK;
+}
+
+int mqtt_publisher_process(void) {
+    if (!g_mqtt_ctx.initialized) {
+        return MQTT_ERROR_NOT_INIT;
+    }
+
+    uint64_t now = server_clock_monotonic_us();
+
+    switch (g_mqtt_ctx.state) {
+        case MQTT_STATE_DISCONNECTED:
+            if (!g_mqtt_ctx.resolving && now >= g_mqtt_ctx.next_connect_us) {
+                start_connect();
+            }
+            return MQTT_OK;
+
+        case MQTT_STATE_CONNECTING: {
+            struct pollfd pfd = { .fd = g_mqtt_ctx.sock_fd, .events = POLLOUT };
+            if (poll(&pfd, 1, 0) > 0) {
+                int err = 0;
+                socklen_t len = sizeof(err);
+                getsockopt(g_mqtt_ctx.sock_fd, SOL_SOCKET, SO_ERROR, &err, &len);
+                if (err != 0) {
+                    connection_failed("connect");
+                    return MQTT_ERROR_SOCKET;
+                }
+                send_connect();
+            } else if (now - g_mqtt_ctx.state_enter_us >= (uint64_t)MQTT_CONNECT_TIMEOUT_SEC * 1000000ULL) {
+                connection_failed("connect timeout");
+                return MQTT_ERROR_SOCKET;
+            }
+            break;
+        }
+
+        case MQTT_STATE_WAIT_CONNACK:
+            if (now - g_mqtt_ctx.state_enter_us >= (uint64_t)MQTT_CONNECT_TIMEOUT_SEC * 1000000ULL) {
+                connection_failed("CONNACK timeout");
+                return MQTT_ERROR_PROTOCOL;
+            }
+            break;
+
+        case MQTT_STATE_CONNECTED: {
+            uint16_t keepalive = g_mqtt_ctx.config.keepalive_sec;
+
+            if (g_mqtt_ctx.ping_outstanding &&
+                now - g_mqtt_ctx.ping_sent_us >= (uint64_t)keepalive * 1000000ULL) {
+                connection_failed("PINGRESP timeout");
+                return MQTT_ERROR_PROTOCOL;
+            }
+
+            queue_pending();
+
+            // Keepalive: ping when idle for half the interval
+            if (g_mqtt_ctx.tx_len == 0 && !g_mqtt_ctx.ping_outstanding &&
+                now - g_mqtt_ctx.last_tx_us >= (uint64_t)keepalive * 500000ULL) {
+                g_mqtt_ctx.tx_buf[0] = MQTT_PKT_PINGREQ;
+                g_mqtt_ctx.tx_buf[1] = 0;
+                g_mqtt_ctx.tx_len = 2;
+                g_mqtt_ctx.ping_outstanding = true;
+                g_mqtt_ctx.ping_sent_us = now;
+            }
+            break;
+        }
+    }
+
+    if (g_mqtt_ctx.state != MQTT_STATE_DISCONNECTED) {
+        if (flush_tx() != MQTT_OK) {
+            connection_failed("send");
+            return MQTT_ERROR_SOCKET;
+        }
+        if (g_mqtt_ctx.state != MQTT_STATE_CONNECTING && g_mqtt_ctx.sock_fd >= 0) {
+            int rc = receive_available();
+            if (rc != MQTT_OK) {
+                connection_failed(rc == MQTT_ERROR_PROTOCOL ? "protocol" : "recv");
+                return rc;
+            }
+        }
+    }
+
+    return MQTT_OK;
+}
+
+/**
+ * @brief Handle the complete packets in the receive buffer
+ */
+static int parse_rx(void) {
+    while (g_mqtt_ctx.rx_len >= 2) {
+        uint32_t remaining = 0;
+        int rl_len = mqtt_decode_remaining_length(g_mqtt_ctx.rx_buf + 1,
+                                                  g_mqtt_ctx.rx_len - 1, &remaining);
+        if (rl_len < 0) {
+            return MQTT_ERROR_PROTOCOL;
+        }
+        if (rl_len == 0) {
+            break;  // Incomplete header
+        }
+
+        size_t total = 1 + (size_t)rl_len + remaining;
+        if (total > sizeof(g_mqtt_ctx.rx_buf)) {
+            // Only a PUBLISH can legitimately be this large; a retained one would
+            // come back on every reconnect, so skip it instead of dropping the session
+            if ((g_mqtt_ctx.rx_buf[0] & 0xF0) != MQTT_PKT_PUBLISH) {
+                return MQTT_ERROR_PROTOCOL;
+            }
+            g_mqtt_ctx.rx_skip = (uint32_t)(total - g_mqtt_ctx.rx_len);
+            g_mqtt_ctx.rx_len = 0;
+            g_mqtt_ctx.rx_dropped++;
+
+            #ifndef TESTING
+            fprintf(stderr, "[MQTT] Discarding %zu byte PUBLISH (buffer %d)\n",
+                    total, MQTT_RX_BUFFER_SIZE);
+            #endif
+            break;
+        }
+        if (g_mqtt_ctx.rx_len < total) {
+            break;  // Incomplete body
+        }
+
+        int rc = handle_packet(g_mqtt_ctx.rx_buf[0],
+                               g_mqtt_ctx.rx_buf + 1 + rl_len, remaining);
+
+        memmove(g_mqtt_ctx.rx_buf, g_mqtt_ctx.rx_buf + total, g_mqtt_ctx.rx_len - total);
+        g_mqtt_ctx.rx_len -= total;
+
+        if (rc != MQTT_OK) {
+            return rc;
+        }
+    }
+
+    return MQTT_OK;
+}
+
+int mqtt_publisher_feed(const uint8_t *data, size_t len) {
+    if (!g_mqtt_ctx.initialized) {
+        return MQTT_ERROR_NOT_INIT;
+    }
+
+    if (data == NULL) {
+        return MQTT_ERROR_PROTOCOL;
+    }
+
+    while (len > 0) {
+        // Rest of an oversized packet
+        if (g_mqtt_ctx.rx_skip > 0) {
+            size_t n = (len < g_mqtt_ctx.rx_skip) ? len : g_mqtt_ctx.rx_skip;
+            g_mqtt_ctx.rx_skip -= (uint32_t)n;
+            data += n;
+            len -= n;
+            continue;
+        }
+
+        size_t space = sizeof(g_mqtt_ctx.rx_buf) - g_mqtt_ctx.rx_len;
+        size_t n = (len < space) ? len : space;
+        memcpy(g_mqtt_ctx.rx_buf + g_mqtt_ctx.rx_len, data, n);
+        g_mqtt_ctx.rx_len += n;
+        data += n;
+        len -= n;
+
+        int rc = parse_rx();
+        if (rc != MQTT_OK) {
+            return rc;
+        }
+    }
+
+    return MQTT_OK;
+}
+
+uint32_t mqtt_publisher_dropped_count(void) {
+    return g_mqtt_ctx.rx_dropped;
+}
+
+int mqtt_publisher_pending_count(void) {
+    int count = 0;
+    for (int i = 0; i < MQTT_MAX_TOPICS; i++) {
+        if (g_mqtt_ctx.topics[i].dirty) {
+            count++;
+        }
+    }
+    return count;
+}
+
+mqtt_state_t mqtt_publisher_get_state(void) {
+    return g_mqtt_ctx.state;
+}
+
+void mqtt_publisher_cleanup(void) {
+    if (!g_mqtt_ctx.initialized) {
+        return;
+    }
+
+    g_resolve_generation++;  // A lookup still running is discarded when it returns
+
+    if (g_mqtt_ctx.sock_fd >= 0) {
+        if (g_mqtt_ctx.state == MQTT_STATE_CONNECTED) {
+            const uint8_t disconnect[2] = { MQTT_PKT_DISCONNECT, 0 };
+            send(g_mqtt_ctx.sock_fd, disconnect, sizeof(disconnect), MSG_NOSIGNAL);
+        }
+        close(g_mqtt_ctx.sock_fd);
+    }
+
+    memset(&g_mqtt_ctx, 0, sizeof(mqtt_publisher_context_t));
+    g_mqtt_ctx.sock_fd = -1;
+
+    #ifndef TESTING
+    fprintf(stdout, "[MQTT] Cleaned up\n");
+    #endif
+}
+
+/* ============================================================
+ *  Packet Encoding
+ * ============================================================ */
+
+int mqtt_encode_remaining_length(uint32_t value, uint8_t *buf) {
+    if (buf == NULL || value > 268435455u) {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    int n = 0;
+    do {
+        uint8_t byte = (uint8_t)(value % 128);
+        value /= 128;
+        if (value > 0) {
+            byte |= 0x80;
+        }
+        buf[n++] = byte;
+    } while (value > 0);
+
+    return n;
+}
+
+int mqtt_decode_remaining_length(const uint8_t *buf, size_t len, uint32_t *value) {
+    if (buf == NULL || value == NULL) {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    uint32_t result = 0;
+    uint32_t multiplier = 1;
+
+    for (size_t i = 0; i < 4; i++) {
+        if (i >= len) {
+            return 0;  // Need more bytes
+        }
+        result += (uint32_t)(buf[i] & 0x7F) * multiplier;
+        if ((buf[i] & 0x80) == 0) {
+            *value = result;
+            return (int)(i + 1);
+        }
+        multiplier *= 128;
+    }
+
+    return MQTT_ERROR_PROTOCOL;  // More than 4 bytes
+}
+
+int mqtt_encode_connect(const mqtt_config_t *config, uint8_t *buf, size_t size) {
+    if (config == NULL || buf == NULL) {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    size_t id_len = strlen(config->client_id);
+    size_t user_len = strlen(config->username);
+    size_t pass_len = strlen(config->password);
+
+    uint8_t flags = 0x02;  // Clean session
+    uint32_t remaining = 10 + 2 + (uint32_t)id_len;
+    if (user_len > 0) {
+        flags |= 0x80;
+        remaining += 2 + (uint32_t)user_len;
+        if (pass_len > 0) {
+            flags |= 0x40;
+            remaining += 2 + (uint32_t)pass_len;
+        }
+    }
+
+    int pos = put_fixed_header(MQTT_PKT_CONNECT, remaining, buf, size);
+    if (pos < 0) {
+        return pos;
+    }
+
+    // Variable header: protocol name, level 4 (3.1.1), flags, keepalive
+    pos += (int)put_string(&buf[pos], "MQTT", 4);
+    buf[pos++] = 4;
+    buf[pos++] = flags;
+    buf[pos++] = (uint8_t)(config->keepalive_sec >> 8);
+    buf[pos++] = (uint8_t)(config->keepalive_sec & 0xFF);
+
+    // Payload
+    pos += (int)put_string(&buf[pos], config->client_id, id_len);
+    if (flags & 0x80) {
+        pos += (int)put_string(&buf[pos], config->username, user_len);
+    }
+    if (flags & 0x40) {
+        pos += (int)put_string(&buf[pos], config->password, pass_len);
+    }
+
+    return pos;
+}
+
+int mqtt_encode_publish(const char *topic, const char *payload, bool retain,
+                        uint8_t *buf, size_t size) {
+    if (topic == NULL || payload == NULL || buf == NULL || topic[0] == '\0') {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    size_t topic_len = strlen(topic);
+    size_t payload_len = strlen(payload);
+    uint32_t remaining = 2 + (uint32_t)topic_len + (uint32_t)payload_len;
+
+    int pos = put_fixed_header((uint8_t)(MQTT_PKT_PUBLISH | (retain ? 0x01 : 0x00)),
+                               remaining, buf, size);
+    if (pos < 0) {
+        return pos;
+    }
+
+    pos += (int)put_string(&buf[pos], topic, topic_len);
+    memcpy(&buf[pos], payload, payload_len);
+    pos += (int)payload_len;
+
+    return pos;
+}
+
+int mqtt_encode_subscribe(uint16_t packet_id, const char *topic,
+                          uint8_t *buf, size_t size) {
+    if (topic == NULL || buf == NULL || topic[0] == '\0' || packet_id == 0) {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    size_t topic_len = strlen(topic);
+    uint32_t remaining = 2 + 2 + (uint32_t)topic_len + 1;
+
+    int pos = put_fixed_header(MQTT_PKT_SUBSCRIBE, remaining, buf, size);
+    if (pos < 0) {
+        return pos;
+    }
+
+    buf[pos++] = (uint8_t)(packet_id >> 8);
+    buf[pos++] = (uint8_t)(packet_id & 0xFF);
+    pos += (int)put_string(&buf[pos], topic, topic_len);
+    buf[pos++] = 0;  // Requested QoS 0
+
+    return pos;
+}
+
+int mqtt_encode_unsubscribe(uint16_t packet_id, const char *topic,
+                            uint8_t *buf, size_t size) {
+    if (topic == NULL || buf == NULL || topic[0] == '\0' || packet_id == 0) {
+        return MQTT_ERROR_INVALID_PARAM;
+    }
+
+    size_t topic_len = strlen(topic);
+    uint32_t remaining = 2 + 2 + (uint32_t)topic_len;
+
+    int pos = put_fixed_header(MQTT_PKT_UNSUBSCRIBE, remaining, buf, size);
+    if (pos < 0) {
+        return pos;
+    }
+
+    buf[pos++] = (uint8_t)(packet_id >> 8);
+    buf[pos++] = (uint8_t)(packet_id & 0xFF);
+    pos += (int)put_string(&buf[pos], topic, topic_len);
+
+    return pos;
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* mqtt_state_to_string(mqtt_state_t state) {
+    switch (state) {
+        case MQTT_STATE_DISCONNECTED:   return "DISCONNECTED";
+        case MQTT_STATE_CONNECTING:     return "CONNECTING";
+        case MQTT_STATE_WAIT_CONNACK:   return "WAIT_CONNACK";
+        case MQTT_STATE_CONNECTED:      return "CONNECTED";
+        default:                        return "UNKNOWN";
+    }
+}
+
+const char* mqtt_publisher_error_string(int error) {
+    switch (error) {
+        case MQTT_OK:                       return "OK";
+        case MQTT_ERROR_NOT_INIT:           return "Not initialized";
+        case MQTT_ERROR_INVALID_PARAM:      return "Invalid parameter";
+        case MQTT_ERROR_BUFFER_TOO_SMALL:   return "Buffer too small";
+        case MQTT_ERROR_SOCKET:             return "Socket error";
+        case MQTT_ERROR_PROTOCOL:           return "Protocol error";
+        case MQTT_ERROR_NOT_CONNECTED:      return "Not connected";
+        case MQTT_ERROR_UNKNOWN:            return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
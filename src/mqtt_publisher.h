@@ -0,0 +1,247 @@
+/**
+ * @file mqtt_publisher.h
+ * @brief MQTT Publisher - Retained PS5 status topics for home automation
+ *
+ * A small non-blocking MQTT 3.1.1 client driven from the main loop:
+ *
+ *   <prefix>/<mac>/state     combined status ("on", "standby", ...)   retained
+ *   <prefix>/<mac>/network   {"online":true,"ip":"..."}              retained
+ *   <prefix>/<mac>/rtt       {"rtt_ms":..,"jitter_ms":..,...}        retained
+ *   <prefix>/<mac>/wake      subscribed, any non-retained message wakes the PS5
+ *
+ * Updates only mark a topic dirty; all dirty topics are flushed together
+ * in one write per main-loop iteration, so bursts collapse to the latest
+ * value. Lost connections are retried with exponential backoff. A broker
+ * host name is looked up on the worker pool, never on the main loop.
+ * Incoming packets larger than MQTT_RX_BUFFER_SIZE are skipped (PUBLISH)
+ * rather than dropping the session.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef MQTT_PUBLISHER_H
+#define MQTT_PUBLISHER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define MQTT_OK                         0
+#define MQTT_ERROR_NOT_INIT            -1
+#define MQTT_ERROR_INVALID_PARAM       -2
+#define MQTT_ERROR_BUFFER_TOO_SMALL    -3
+#define MQTT_ERROR_SOCKET              -4
+#define MQTT_ERROR_PROTOCOL            -5
+#define MQTT_ERROR_NOT_CONNECTED       -6
+#define MQTT_ERROR_UNKNOWN             -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define MQTT_DEFAULT_PORT               1883
+#define MQTT_DEFAULT_KEEPALIVE_SEC      60
+#define MQTT_DEFAULT_TOPIC_PREFIX       "gaming/ps5"
+#define MQTT_HOST_MAX_LEN               64
+#define MQTT_CLIENT_ID_MAX_LEN          32
+#define MQTT_CREDENTIAL_MAX_LEN         64
+#define MQTT_TOPIC_MAX_LEN              128
+#define MQTT_PAYLOAD_MAX_LEN            256
+#define MQTT_MAX_TOPICS                 4       /**< Published topics */
+#define MQTT_TX_BUFFER_SIZE             2048
+#define MQTT_RX_BUFFER_SIZE             1024
+#define MQTT_BACKOFF_MIN_SEC            1
+#define MQTT_BACKOFF_MAX_SEC            60
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief MQTT connection state
+ */
+typedef enum {
+    MQTT_STATE_DISCONNECTED = 0,    /**< Waiting for reconnect backoff */
+    MQTT_STATE_CONNECTING,          /**< TCP connect in progress */
+    MQTT_STATE_WAIT_CONNACK,        /**< CONNECT sent */
+    MQTT_STATE_CONNECTED,           /**< Session established */
+} mqtt_state_t;
+
+/**
+ * @brief MQTT configuration
+ */
+typedef struct {
+    char host[MQTT_HOST_MAX_LEN];               /**< Broker host */
+    uint16_t port;                              /**< Broker port */
+    char client_id[MQTT_CLIENT_ID_MAX_LEN];     /**< Client identifier */
+    char username[MQTT_CREDENTIAL_MAX_LEN];     /**< Username (optional) */
+    char password[MQTT_CREDENTIAL_MAX_LEN];     /**< Password (optional) */
+    char topic_prefix[MQTT_TOPIC_MAX_LEN / 2];  /**< Topic prefix */
+    uint16_t keepalive_sec;                     /**< Keepalive interval */
+} mqtt_config_t;
+
+/**
+ * @brief Wake command callback
+ * @param user_data User data
+ */
+typedef void (*mqtt_wake_callback_t)(void *user_data);
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Fill configuration with default values
+ * @param config Configuration to fill
+ */
+void mqtt_publisher_default_config(mqtt_config_t *config);
+
+/**
+ * @brief Initialize the MQTT publisher
+ * @param config Configuration
+ * @return MQTT_OK on success, negative error code on failure
+ */
+int mqtt_publisher_init(const mqtt_config_t *config);
+
+/**
+ * @brief Set the wake command callback
+ * @param callback Callback function
+ * @param user_data User data
+ */
+void mqtt_publisher_set_wake_callback(mqtt_wake_callback_t callback, void *user_data);
+
+/**
+ * @brief Set the console MAC used in topic names
+ *
+ * Changing the device re-subscribes and republishes all topics.
+ *
+ * @param mac Console MAC address
+ * @return MQTT_OK on success, negative error code on failure
+ */
+int mqtt_publisher_set_device(const char *mac);
+
+/**
+ * @brief Queue a retained topic update (flushed by process)
+ * @param subtopic Subtopic ("state", "network", "rtt")
+ * @param payload Payload string
+ * @return MQTT_OK on success, negative error code on failure
+ */
+int mqtt_publisher_update(const char *subtopic, const char *payload);
+
+/**
+ * @brief Drive connection, flush, keepalive and receive (non-blocking)
+ * @return MQTT_OK on success, negative error code on failure
+ */
+int mqtt_publisher_process(void);
+
+/**
+ * @brief Feed received bytes into the packet parser
+ *
+ * Used by process(); exposed so the parser can be tested offline.
+ *
+ * @param data Received bytes
+ * @param len Number of bytes
+ * @return MQTT_OK on success, negative error code on protocol error
+ */
+int mqtt_publisher_feed(const uint8_t *data, size_t len);
+
+/**
+ * @brief Number of oversized PUBLISH packets discarded
+ * @return Dropped packet count
+ */
+uint32_t mqtt_publisher_dropped_count(void);
+
+/**
+ * @brief Number of topics waiting to be flushed
+ * @return Dirty topic count
+ */
+int mqtt_publisher_pending_count(void);
+
+/**
+ * @brief Get the connection state
+ * @return Connection state
+ */
+mqtt_state_t mqtt_publisher_get_state(void);
+
+/**
+ * @brief Clean up MQTT publisher (sends DISCONNECT if connected)
+ */
+void mqtt_publisher_cleanup(void);
+
+/* ============================================================
+ *  Packet Encoding
+ * ============================================================ */
+
+/**
+ * @brief Encode an MQTT remaining-length field
+ * @param value Remaining length
+ * @param buf Output buffer (at least 4 bytes)
+ * @return Number of bytes written, negative error code if too large
+ */
+int mqtt_encode_remaining_length(uint32_t value, uint8_t *buf);
+
+/**
+ * @brief Decode an MQTT remaining-length field
+ * @param buf Input bytes
+ * @param len Available bytes
+ * @param value Pointer to store the value
+ * @return Bytes consumed, 0 if incomplete, negative error code if malformed
+ */
+int mqtt_decode_remaining_length(const uint8_t *buf, size_t len, uint32_t *value);
+
+/**
+ * @brief Encode a CONNECT packet (clean session)
+ * @return Packet length, negative error code on failure
+ */
+int mqtt_encode_connect(const mqtt_config_t *config, uint8_t *buf, size_t size);
+
+/**
+ * @brief Encode a QoS 0 PUBLISH packet
+ * @return Packet length, negative error code on failure
+ */
+int mqtt_encode_publish(const char *topic, const char *payload, bool retain,
+                        uint8_t *buf, size_t size);
+
+/**
+ * @brief Encode a QoS 0 SUBSCRIBE packet
+ * @return Packet length, negative error code on failure
+ */
+int mqtt_encode_subscribe(uint16_t packet_id, const char *topic,
+                          uint8_t *buf, size_t size);
+
+/**
+ * @brief Encode an UNSUBSCRIBE packet for one topic
+ * @return Packet length, negative error code on failure
+ */
+int mqtt_encode_unsubscribe(uint16_t packet_id, const char *topic,
+                            uint8_t *buf, size_t size);
+
+/**
+ * @brief Convert connection state to string
+ * @param state Connection state
+ * @return State string
+ */
+const char* mqtt_state_to_string(mqtt_state_t state);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* mqtt_publisher_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MQTT_PUBLISHER_H */
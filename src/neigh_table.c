@@ -0,0 +1,455 @@
+/**
+ * @file neigh_table.c
+ * @brief Neighbour Table Implementation - netlink, /proc/net/arp, arp -n
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "neigh_table.h"
+#include "fault_inject.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdint.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+// Linux headers
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/neighbour.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define PROC_ARP_PATH           "/proc/net/arp"
+#define ARP_COMMAND             "arp -n 2>/dev/null"
+#define LINE_MAX_LEN            256
+#define NETLINK_BUF_SIZE        8192
+#define NETLINK_TIMEOUT_MS      1000
+
+#define ATF_COMPLETE            0x02    // From <net/if_arp.h>
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static neigh_backend_t g_backend = NEIGH_BACKEND_PROC;
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+/**
+ * @brief Validate and normalize a MAC (lowercase, rejects all-zero)
+ */
+static bool normalize_mac(const char *in, char *out) {
+    if (strlen(in) != 17) {
+        return false;
+    }
+
+    bool all_zero = true;
+    for (int i = 0; i < 17; i++) {
+        char c = in[i];
+        if (i % 3 == 2) {
+            if (c != ':') {
+                return false;
+            }
+            out[i] = ':';
+            continue;
+        }
+        if (!isxdigit((unsigned char)c)) {
+            return false;
+        }
+        if (c != '0') {
+            all_zero = false;
+        }
+        out[i] = (char)tolower((unsigned char)c);
+    }
+    out[17] = '\0';
+
+    return !all_zero;
+}
+
+static bool is_ipv4(const char *s) {
+    struct in_addr addr;
+    return inet_pton(AF_INET, s, &addr) == 1;
+}
+
+static bool add_entry(neigh_entry_t *entries, int max_entries, int *count,
+                      const neigh_entry_t *entry) {
+    if (*count >= max_entries) {
+        return false;
+    }
+    entries[(*count)++] = *entry;
+    return true;
+}
+
+/**
+ * @brief Dump via /proc/net/arp
+ */
+static int dump_proc(neigh_entry_t *entries, int max_entries) {
+    FILE *fp = fopen(PROC_ARP_PATH, "r");
+    if (fp == NULL) {
+        return NEIGH_ERROR_BACKEND;
+    }
+
+    char line[LINE_MAX_LEN];
+    int count = 0;
+    neigh_entry_t entry;
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (neigh_table_parse_proc_line(line, &entry) &&
+            !add_entry(entries, max_entries, &count, &entry)) {
+            break;
+        }
+    }
+
+    fclose(fp);
+    return count;
+}
+
+/**
+ * @brief Dump via `arp -n`
+ */
+static int dump_command(neigh_entry_t *entries, int max_entries) {
+    FAULT_DELAY(FAULT_POINT_CMD);
+    if (FAULT_FAIL(FAULT_POINT_CMD)) {
+        return NEIGH_ERROR_BACKEND;
+    }
+
+    FILE *fp = popen(ARP_COMMAND, "r");
+    if (fp == NULL) {
+        return NEIGH_ERROR_BACKEND;
+    }
+
+    char line[LINE_MAX_LEN];
+    int count = 0;
+    neigh_entry_t entry;
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (neigh_table_parse_arp_line(line, &entry) &&
+            !add_entry(entries, max_entries, &count, &entry)) {
+            break;
+        }
+    }
+
+    pclose(fp);
+    return count;
+}
+
+/**
+ * @brief Parse one RTM_NEWNEIGH message
+ */
+static bool parse_neigh_msg(struct nlmsghdr *nh, neigh_entry_t *entry) {
+    struct ndmsg *ndm = NLMSG_DATA(nh);
+
+    if (ndm->ndm_family != AF_INET ||
+        (ndm->ndm_state & (NUD_INCOMPLETE | NUD_FAILED | NUD_NOARP)) ||
+        ndm->ndm_state == NUD_NONE) {
+        return false;
+    }
+
+    const unsigned char *dst = NULL;
+    const unsigned char *lladdr = NULL;
+    int attr_len = (int)nh->nlmsg_len - (int)NLMSG_LENGTH(sizeof(struct ndmsg));
+
+    for (struct rtattr *rta = (struct rtattr*)((char*)ndm + NLMSG_ALIGN(sizeof(struct ndmsg)));
+         RTA_OK(rta, attr_len); rta = RTA_NEXT(rta, attr_len)) {
+        if (rta->rta_type == NDA_DST && RTA_PAYLOAD(rta) == 4) {
+            dst = RTA_DATA(rta);
+        } else if (rta->rta_type == NDA_LLADDR && RTA_PAYLOAD(rta) == 6) {
+            lladdr = RTA_DATA(rta);
+        }
+    }
+
+    if (dst == NULL || lladdr == NULL) {
+        return false;
+    }
+
+    char mac[NEIGH_MAC_MAX_LEN];
+    snprintf(mac, sizeof(mac), "%02x:%02x:%02x:%02x:%02x:%02x",
+             lladdr[0], lladdr[1], lladdr[2], lladdr[3], lladdr[4], lladdr[5]);
+    if (!normalize_mac(mac, entry->mac)) {
+        return false;
+    }
+
+    inet_ntop(AF_INET, dst, entry->ip, sizeof(entry->ip));
+    return true;
+}
+
+/**
+ * @brief Dump via rtnetlink (RTM_GETNEIGH)
+ */
+static int dump_netlink(neigh_entry_t *entries, int max_entries) {
+    int fd = socket(AF_NETLINK, SOCK_RAW, NETLINK_ROUTE);
+    if (fd < 0) {
+        return NEIGH_ERROR_BACKEND;
+    }
+
+    struct timeval tv = { .tv_sec = NETLINK_TIMEOUT_MS / 1000,
+                          .tv_usec = (NETLINK_TIMEOUT_MS % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    struct {
+        struct nlmsghdr nh;
+        struct ndmsg ndm;
+    } req;
+    memset(&req, 0, sizeof(req));
+    req.nh.nlmsg_len = NLMSG_LENGTH(sizeof(struct ndmsg));
+    req.nh.nlmsg_type = RTM_GETNEIGH;
+    req.nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.nh.nlmsg_seq = 1;
+    req.ndm.ndm_family = AF_INET;
+
+    if (send(fd, &req, req.nh.nlmsg_len, 0) < 0) {
+        close(fd);
+        return NEIGH_ERROR_BACKEND;
+    }
+
+    static char buf[NETLINK_BUF_SIZE];
+    int count = 0;
+    bool done = false;
+
+    while (!done) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            close(fd);
+            return (count > 0) ? count : NEIGH_ERROR_BACKEND;
+        }
+
+        int len = (int)n;
+        for (struct nlmsghdr *nh = (struct nlmsghdr*)buf; NLMSG_OK(nh, len);
+             nh = NLMSG_NEXT(nh, len)) {
+            if (nh->nlmsg_type == NLMSG_DONE || nh->nlmsg_type == NLMSG_ERROR) {
+                done = true;
+                break;
+            }
+
+            neigh_entry_t entry;
+            if (nh->nlmsg_type == RTM_NEWNEIGH && parse_neigh_msg(nh, &entry) &&
+                !add_entry(entries, max_entries, &count, &entry)) {
+                done = true;
+                break;
+            }
+        }
+    }
+
+    close(fd);
+    return count;
+}
+
+#ifndef TESTING
+
+/**
+ * @brief RTM_NEWNEIGH with NLM_F_CREATE only, so live entries are left alone
+ */
+static int learn_netlink(const struct in_addr *addr, const uint8_t mac[6], int ifindex) {
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) {
+        return NEIGH_ERROR_BACKEND;
+    }
+
+    struct timeval tv = { .tv_sec = NETLINK_TIMEOUT_MS / 1000,
+                          .tv_usec = (NETLINK_TIMEOUT_MS % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    struct {
+        struct nlmsghdr nh;
+        struct ndmsg ndm;
+        char attrs[64];
+    } req;
+    memset(&req, 0, sizeof(req));
+    req.nh.nlmsg_len = NLMSG_LENGTH(sizeof(struct ndmsg));
+    req.nh.nlmsg_type = RTM_NEWNEIGH;
+    req.nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE | NLM_F_EXCL;
+    req.nh.nlmsg_seq = 1;
+    req.ndm.ndm_family = AF_INET;
+    req.ndm.ndm_ifindex = ifindex;
+    req.ndm.ndm_state = NUD_STALE;
+
+    struct rtattr *rta = (struct rtattr*)((char*)&req + NLMSG_ALIGN(req.nh.nlmsg_len));
+    rta->rta_type = NDA_DST;
+    rta->rta_len = RTA_LENGTH(4);
+    memcpy(RTA_DATA(rta), addr, 4);
+    req.nh.nlmsg_len = NLMSG_ALIGN(req.nh.nlmsg_len) + RTA_ALIGN(rta->rta_len);
+
+    rta = (struct rtattr*)((char*)&req + req.nh.nlmsg_len);
+    rta->rta_type = NDA_LLADDR;
+    rta->rta_len = RTA_LENGTH(6);
+    memcpy(RTA_DATA(rta), mac, 6);
+    req.nh.nlmsg_len += RTA_ALIGN(rta->rta_len);
+
+    int result = NEIGH_ERROR_BACKEND;
+    char reply[256];
+    if (send(fd, &req, req.nh.nlmsg_len, 0) >= 0) {
+        ssize_t n = recv(fd, reply, sizeof(reply), 0);
+        struct nlmsghdr *nh = (struct nlmsghdr*)reply;
+        if (n >= (ssize_t)NLMSG_LENGTH(sizeof(struct nlmsgerr)) && nh->nlmsg_type == NLMSG_ERROR) {
+            int error = ((struct nlmsgerr*)NLMSG_DATA(nh))->error;
+            result = (error == 0 || error == -EEXIST) ? NEIGH_OK : NEIGH_ERROR_BACKEND;
+        }
+    }
+
+    close(fd);
+    return result;
+}
+
+#endif /* !TESTING */
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+void neigh_table_set_backend(neigh_backend_t backend) {
+    g_backend = backend;
+}
+
+neigh_backend_t neigh_table_get_backend(void) {
+    return g_backend;
+}
+
+int neigh_table_dump(neigh_entry_t *entries, int max_entries) {
+    if (entries == NULL || max_entries <= 0) {
+        return NEIGH_ERROR_INVALID_PARAM;
+    }
+
+    switch (g_backend) {
+        case NEIGH_BACKEND_NETLINK:     return dump_netlink(entries, max_entries);
+        case NEIGH_BACKEND_PROC:        return dump_proc(entries, max_entries);
+        case NEIGH_BACKEND_COMMAND:     return dump_command(entries, max_entries);
+        default:                        return NEIGH_ERROR_BACKEND;
+    }
+}
+
+int neigh_table_lookup_ip(const char *ip, char *mac, size_t mac_len) {
+    if (ip == NULL || mac == NULL || mac_len < NEIGH_MAC_MAX_LEN) {
+        return NEIGH_ERROR_INVALID_PARAM;
+    }
+
+    neigh_entry_t entries[NEIGH_MAX_ENTRIES];
+    int count = neigh_table_dump(entries, NEIGH_MAX_ENTRIES);
+    if (count < 0) {
+        return count;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (strcmp(entries[i].ip, ip) == 0) {
+            snprintf(mac, mac_len, "%s", entries[i].mac);
+            return NEIGH_OK;
+        }
+    }
+
+    return NEIGH_ERROR_NOT_FOUND;
+}
+
+int neigh_table_learn(const char *ip, const char *mac, int ifindex) {
+    char normalized[NEIGH_MAC_MAX_LEN];
+    struct in_addr addr;
+    if (ip == NULL || mac == NULL || ifindex <= 0 || inet_pton(AF_INET, ip, &addr) != 1 ||
+        !normalize_mac(mac, normalized)) {
+        return NEIGH_ERROR_INVALID_PARAM;
+    }
+
+    #ifdef TESTING
+    // In test mode, the kernel table is left alone
+    return NEIGH_OK;
+    #else
+    uint8_t lladdr[6];
+    for (int i = 0; i < 6; i++) {
+        lladdr[i] = (uint8_t)strtoul(normalized + i * 3, NULL, 16);
+    }
+    return learn_netlink(&addr, lladdr, ifindex);
+    #endif
+}
+
+bool neigh_table_parse_proc_line(const char *line, neigh_entry_t *entry) {
+    if (line == NULL || entry == NULL) {
+        return false;
+    }
+
+    // IP address       HW type     Flags       HW address            Mask     Device
+    // 192.168.1.100    0x1         0x2         aa:bb:cc:dd:ee:ff     *        br-lan
+    char ip[NEIGH_IP_MAX_LEN];
+    char mac[32];
+    unsigned int hw_type = 0, flags = 0;
+
+    if (sscanf(line, "%15s 0x%x 0x%x %31s", ip, &hw_type, &flags, mac) != 4) {
+        return false;  // Header line
+    }
+
+    if (!(flags & ATF_COMPLETE) || !is_ipv4(ip) || !normalize_mac(mac, entry->mac)) {
+        return false;
+    }
+
+    snprintf(entry->ip, sizeof(entry->ip), "%s", ip);
+    return true;
+}
+
+bool neigh_table_parse_arp_line(const char *line, neigh_entry_t *entry) {
+    if (line == NULL || entry == NULL) {
+        return false;
+    }
+
+    // busybox:   ? (192.168.1.100) at aa:bb:cc:dd:ee:ff [ether]  on br-lan
+    // net-tools: 192.168.1.100  ether  aa:bb:cc:dd:ee:ff  C  br-lan
+    char copy[LINE_MAX_LEN];
+    snprintf(copy, sizeof(copy), "%s", line);
+
+    bool have_ip = false, have_mac = false;
+    char *saveptr = NULL;
+
+    for (char *tok = strtok_r(copy, " \t()\r\n", &saveptr); tok != NULL;
+         tok = strtok_r(NULL, " \t()\r\n", &saveptr)) {
+        if (!have_ip && is_ipv4(tok)) {
+            snprintf(entry->ip, sizeof(entry->ip), "%s", tok);
+            have_ip = true;
+        } else if (!have_mac && normalize_mac(tok, entry->mac)) {
+            have_mac = true;
+        }
+    }
+
+    return have_ip && have_mac;
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* neigh_backend_to_string(neigh_backend_t backend) {
+    switch (backend) {
+        case NEIGH_BACKEND_NONE:        return "none";
+        case NEIGH_BACKEND_COMMAND:     return "arp";
+        case NEIGH_BACKEND_PROC:        return "proc";
+        case NEIGH_BACKEND_NETLINK:     return "netlink";
+        default:                        return "unknown";
+    }
+}
+
+const char* neigh_table_error_string(int error) {
+    switch (error) {
+        case NEIGH_OK:                      return "OK";
+        case NEIGH_ERROR_INVALID_PARAM:     return "Invalid parameter";
+        case NEIGH_ERROR_BACKEND:           return "Backend unavailable";
+        case NEIGH_ERROR_NOT_FOUND:         return "Not found";
+        case NEIGH_ERROR_UNKNOWN:           return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
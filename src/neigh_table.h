@@ -0,0 +1,151 @@
+/**
+ * @file neigh_table.h
+ * @brief Neighbour Table - IPv4 neighbour (ARP) lookups
+ *
+ * Reads the kernel neighbour table through one of three backends,
+ * fastest first:
+ *
+ *   NETLINK  RTM_GETNEIGH dump on a NETLINK_ROUTE socket
+ *   PROC     parse /proc/net/arp
+ *   COMMAND  run `arp -n` (busybox or net-tools output)
+ *
+ * The backend is chosen once at startup by the capability probe.
+ * Only complete entries with a real hardware address are returned.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef NEIGH_TABLE_H
+#define NEIGH_TABLE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define NEIGH_OK                        0
+#define NEIGH_ERROR_INVALID_PARAM      -2
+#define NEIGH_ERROR_BACKEND            -3
+#define NEIGH_ERROR_NOT_FOUND          -4
+#define NEIGH_ERROR_UNKNOWN            -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define NEIGH_MAX_ENTRIES               64
+#define NEIGH_IP_MAX_LEN                16
+#define NEIGH_MAC_MAX_LEN               18
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Neighbour table backend
+ */
+typedef enum {
+    NEIGH_BACKEND_NONE = 0,     /**< No neighbour source */
+    NEIGH_BACKEND_COMMAND,      /**< arp -n */
+    NEIGH_BACKEND_PROC,         /**< /proc/net/arp */
+    NEIGH_BACKEND_NETLINK,      /**< rtnetlink dump */
+} neigh_backend_t;
+
+/**
+ * @brief One neighbour entry
+ */
+typedef struct {
+    char ip[NEIGH_IP_MAX_LEN];      /**< IPv4 address */
+    char mac[NEIGH_MAC_MAX_LEN];    /**< Lowercase aa:bb:cc:dd:ee:ff */
+} neigh_entry_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Select the backend (default PROC)
+ * @param backend Backend
+ */
+void neigh_table_set_backend(neigh_backend_t backend);
+
+/**
+ * @brief Get the selected backend
+ * @return Backend
+ */
+neigh_backend_t neigh_table_get_backend(void);
+
+/**
+ * @brief Read complete neighbour entries
+ * @param entries Output array
+ * @param max_entries Array size
+ * @return Number of entries (>= 0), negative error code on failure
+ */
+int neigh_table_dump(neigh_entry_t *entries, int max_entries);
+
+/**
+ * @brief Look up the hardware address for an IP
+ * @param ip IPv4 address
+ * @param mac Output buffer
+ * @param mac_len Buffer size (>= NEIGH_MAC_MAX_LEN)
+ * @return NEIGH_OK if found, negative error code otherwise
+ */
+int neigh_table_lookup_ip(const char *ip, char *mac, size_t mac_len);
+
+/**
+ * @brief Add a STALE entry for ip if the kernel has none
+ *
+ * A STALE entry lets the next packet to ip go out at once; the kernel
+ * confirms it afterwards instead of resolving first. Always uses
+ * rtnetlink (needs CAP_NET_ADMIN), whatever the backend.
+ *
+ * @param ip IPv4 address
+ * @param mac Hardware address
+ * @param ifindex Interface index
+ * @return NEIGH_OK if added or already present, negative error code otherwise
+ */
+int neigh_table_learn(const char *ip, const char *mac, int ifindex);
+
+/**
+ * @brief Parse one /proc/net/arp line (exposed for tests)
+ * @param line Input line
+ * @param entry Output entry
+ * @return true if the line is a complete entry
+ */
+bool neigh_table_parse_proc_line(const char *line, neigh_entry_t *entry);
+
+/**
+ * @brief Parse one `arp -n` line, busybox or net-tools (exposed for tests)
+ * @param line Input line
+ * @param entry Output entry
+ * @return true if the line is a complete entry
+ */
+bool neigh_table_parse_arp_line(const char *line, neigh_entry_t *entry);
+
+/**
+ * @brief Convert backend to string
+ * @param backend Backend
+ * @return Backend name string
+ */
+const char* neigh_backend_to_string(neigh_backend_t backend);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* neigh_table_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NEIGH_TABLE_H */
@@ -0,0 +1,410 @@
+/**
+ * @file presence_channel.c
+ * @brief Presence Channel Implementation - Keepalive TCP connection
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "presence_channel.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    bool initialized;
+    uint16_t port;
+    struct sockaddr_in target;
+
+    // Connection
+    int fd;
+    uint64_t connect_start_us;
+    uint64_t next_attempt_us;
+
+    // Presence as last reported
+    bool known;
+    presence_stats_t stats;
+} presence_channel_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static presence_channel_context_t g_presence_ctx = { .fd = -1 };
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+/**
+ * @brief Close the connection socket
+ */
+static void close_channel(void) {
+    if (g_presence_ctx.fd >= 0) {
+        close(g_presence_ctx.fd);
+        g_presence_ctx.fd = -1;
+    }
+}
+
+/**
+ * @brief Map a socket error to an outcome
+ */
+static presence_outcome_t outcome_from_errno(int err) {
+    switch (err) {
+        case 0:             return PRESENCE_OUTCOME_CONNECTED;
+        case ECONNREFUSED:  return PRESENCE_OUTCOME_REFUSED;
+        default:            return PRESENCE_OUTCOME_UNREACHABLE;
+    }
+}
+
+/**
+ * @brief Report a presence change, if any
+ */
+static presence_event_t set_online(bool online) {
+    if (g_presence_ctx.known && g_presence_ctx.stats.online == online) {
+        return PRESENCE_EVENT_NONE;
+    }
+
+    g_presence_ctx.known = true;
+    g_presence_ctx.stats.online = online;
+    return online ? PRESENCE_EVENT_UP : PRESENCE_EVENT_DOWN;
+}
+
+/**
+ * @brief Schedule the next attempt after the current spacing
+ */
+static void schedule_retry(bool widen) {
+    presence_stats_t *s = &g_presence_ctx.stats;
+
+    s->state = PRESENCE_STATE_BACKOFF;
+    g_presence_ctx.next_attempt_us = server_clock_monotonic_us() + (uint64_t)s->backoff_ms * 1000ULL;
+
+    if (widen) {
+        s->backoff_ms *= 2;
+        if (s->backoff_ms > PRESENCE_BACKOFF_MAX_MS) {
+            s->backoff_ms = PRESENCE_BACKOFF_MAX_MS;
+        }
+    }
+}
+
+#ifndef TESTING
+
+/**
+ * @brief Keepalive and user timeout so a dead peer aborts the connection
+ *
+ * TCP_USER_TIMEOUT also bounds unacknowledged keepalives (Linux 2.6.37+),
+ * so the abort comes after PRESENCE_USER_TIMEOUT_MS even if KEEPCNT
+ * would allow longer.
+ */
+static void set_keepalive(int fd) {
+    int on = 1;
+    int idle = PRESENCE_KEEPIDLE_SEC;
+    int intvl = PRESENCE_KEEPINTVL_SEC;
+    int cnt = PRESENCE_KEEPCNT;
+    unsigned int user_timeout = PRESENCE_USER_TIMEOUT_MS;
+
+    setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &intvl, sizeof(intvl));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(cnt));
+    setsockopt(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, &user_timeout, sizeof(user_timeout));
+}
+
+#endif /* !TESTING */
+
+/**
+ * @brief Start one connect attempt
+ */
+static presence_event_t start_connect(uint64_t now_us) {
+    g_presence_ctx.stats.attempts++;
+    g_presence_ctx.connect_start_us = now_us;
+    g_presence_ctx.stats.state = PRESENCE_STATE_CONNECTING;
+
+    #ifdef TESTING
+    // In test mode, no network traffic; outcomes are fed via record()
+    return PRESENCE_EVENT_NONE;
+    #else
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return presence_channel_record(PRESENCE_OUTCOME_UNREACHABLE);
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    set_keepalive(fd);
+
+    if (connect(fd, (struct sockaddr*)&g_presence_ctx.target, sizeof(g_presence_ctx.target)) == 0) {
+        g_presence_ctx.fd = fd;
+        return presence_channel_record(PRESENCE_OUTCOME_CONNECTED);
+    }
+
+    if (errno != EINPROGRESS) {
+        int err = errno;
+        close(fd);
+        return presence_channel_record(outcome_from_errno(err));
+    }
+
+    g_presence_ctx.fd = fd;
+    return PRESENCE_EVENT_NONE;
+    #endif
+}
+
+/**
+ * @brief Check the in-flight connect for completion
+ */
+static presence_event_t check_connect(uint64_t now_us) {
+    struct pollfd pfd = { .fd = g_presence_ctx.fd, .events = POLLOUT };
+
+    if (poll(&pfd, 1, 0) > 0) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(g_presence_ctx.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+
+        presence_outcome_t outcome = outcome_from_errno(err);
+        if (outcome != PRESENCE_OUTCOME_CONNECTED) {
+            close_channel();
+        }
+        return presence_channel_record(outcome);
+    }
+
+    if (now_us - g_presence_ctx.connect_start_us >= (uint64_t)PRESENCE_CONNECT_TIMEOUT_MS * 1000ULL) {
+        close_channel();
+        return presence_channel_record(PRESENCE_OUTCOME_UNREACHABLE);
+    }
+
+    return PRESENCE_EVENT_NONE;
+}
+
+/**
+ * @brief Check the held connection (drains anything the peer sends)
+ */
+static presence_event_t check_held(void) {
+    struct pollfd pfd = { .fd = g_presence_ctx.fd, .events = POLLIN };
+
+    if (poll(&pfd, 1, 0) <= 0) {
+        return PRESENCE_EVENT_NONE;
+    }
+
+    char buf[256];
+    ssize_t n = recv(g_presence_ctx.fd, buf, sizeof(buf), MSG_DONTWAIT);
+    if (n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))) {
+        return PRESENCE_EVENT_NONE;
+    }
+
+    // FIN or RST means the console is still there to send it;
+    // ETIMEDOUT / EHOSTUNREACH means keepalive gave up
+    presence_outcome_t outcome = PRESENCE_OUTCOME_CLOSED;
+    if (n < 0 && errno != ECONNRESET) {
+        outcome = PRESENCE_OUTCOME_LOST;
+    }
+
+    close_channel();
+    return presence_channel_record(outcome);
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int presence_channel_init(uint16_t port) {
+    if (g_presence_ctx.initialized) {
+        return PRESENCE_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    memset(&g_presence_ctx, 0, sizeof(presence_channel_context_t));
+    g_presence_ctx.fd = -1;
+    g_presence_ctx.port = (port > 0) ? port : PRESENCE_DEFAULT_PORT;
+    g_presence_ctx.stats.state = PRESENCE_STATE_IDLE;
+    g_presence_ctx.stats.backoff_ms = PRESENCE_BACKOFF_INITIAL_MS;
+    g_presence_ctx.initialized = true;
+
+    return PRESENCE_OK;
+}
+
+int presence_channel_start(const char *ip) {
+    if (!g_presence_ctx.initialized) {
+        return PRESENCE_ERROR_NOT_INIT;
+    }
+
+    struct sockaddr_in target;
+    memset(&target, 0, sizeof(target));
+    target.sin_family = AF_INET;
+    target.sin_port = htons(g_presence_ctx.port);
+
+    if (ip == NULL || inet_pton(AF_INET, ip, &target.sin_addr) != 1) {
+        return PRESENCE_ERROR_INVALID_PARAM;
+    }
+
+    if (g_presence_ctx.stats.state != PRESENCE_STATE_IDLE &&
+        target.sin_addr.s_addr == g_presence_ctx.target.sin_addr.s_addr) {
+        return PRESENCE_OK;  // Already holding this address
+    }
+
+    close_channel();
+    g_presence_ctx.target = target;
+    g_presence_ctx.known = false;
+    g_presence_ctx.stats.online = false;
+    g_presence_ctx.stats.state = PRESENCE_STATE_BACKOFF;
+    g_presence_ctx.stats.backoff_ms = PRESENCE_BACKOFF_INITIAL_MS;
+    g_presence_ctx.next_attempt_us = server_clock_monotonic_us();  // First attempt right away
+
+    #ifndef TESTING
+    fprintf(stdout, "[Presence] Holding %s:%u\n", ip, g_presence_ctx.port);
+    #endif
+
+    return PRESENCE_OK;
+}
+
+void presence_channel_stop(void) {
+    close_channel();
+    g_presence_ctx.known = false;
+    g_presence_ctx.stats.state = PRESENCE_STATE_IDLE;
+}
+
+presence_event_t presence_channel_process(void) {
+    if (!g_presence_ctx.initialized) {
+        return PRESENCE_EVENT_NONE;
+    }
+
+    uint64_t now = server_clock_monotonic_us();
+
+    switch (g_presence_ctx.stats.state) {
+        case PRESENCE_STATE_CONNECTING:
+            return (g_presence_ctx.fd >= 0) ? check_connect(now) : PRESENCE_EVENT_NONE;
+
+        case PRESENCE_STATE_UP:
+            return (g_presence_ctx.fd >= 0) ? check_held() : PRESENCE_EVENT_NONE;
+
+        case PRESENCE_STATE_BACKOFF:
+            if (now >= g_presence_ctx.next_attempt_us) {
+                return start_connect(now);
+            }
+            return PRESENCE_EVENT_NONE;
+
+        default:
+            return PRESENCE_EVENT_NONE;
+    }
+}
+
+presence_event_t presence_channel_record(presence_outcome_t outcome) {
+    presence_stats_t *s = &g_presence_ctx.stats;
+
+    if (s->state == PRESENCE_STATE_IDLE) {
+        return PRESENCE_EVENT_NONE;
+    }
+
+    switch (outcome) {
+        case PRESENCE_OUTCOME_CONNECTED:
+            s->state = PRESENCE_STATE_UP;
+            s->connects++;
+            s->backoff_ms = PRESENCE_BACKOFF_INITIAL_MS;
+
+            #ifndef TESTING
+            fprintf(stdout, "[Presence] Connected after %u attempts\n", s->attempts);
+            #endif
+            return set_online(true);
+
+        case PRESENCE_OUTCOME_REFUSED:
+            // Port closed (rest mode, still booting): retry less and less often
+            schedule_retry(true);
+            return set_online(true);
+
+        case PRESENCE_OUTCOME_UNREACHABLE:
+            schedule_retry(true);
+            return set_online(false);
+
+        case PRESENCE_OUTCOME_CLOSED:
+            // Console dropped the idle session: reconnect at the base spacing
+            s->backoff_ms = PRESENCE_BACKOFF_INITIAL_MS;
+            schedule_retry(false);
+            return PRESENCE_EVENT_NONE;
+
+        case PRESENCE_OUTCOME_LOST:
+            s->losses++;
+            s->backoff_ms = PRESENCE_BACKOFF_INITIAL_MS;
+            schedule_retry(true);
+
+            #ifndef TESTING
+            fprintf(stdout, "[Presence] Connection lost (keepalive timeout)\n");
+            #endif
+            return set_online(false);
+
+        default:
+            return PRESENCE_EVENT_NONE;
+    }
+}
+
+presence_state_t presence_channel_get_state(void) {
+    return g_presence_ctx.stats.state;
+}
+
+int presence_channel_get_stats(presence_stats_t *stats) {
+    if (!g_presence_ctx.initialized) {
+        return PRESENCE_ERROR_NOT_INIT;
+    }
+
+    if (stats == NULL) {
+        return PRESENCE_ERROR_INVALID_PARAM;
+    }
+
+    memcpy(stats, &g_presence_ctx.stats, sizeof(presence_stats_t));
+    return PRESENCE_OK;
+}
+
+void presence_channel_cleanup(void) {
+    if (!g_presence_ctx.initialized) {
+        return;
+    }
+
+    close_channel();
+    memset(&g_presence_ctx, 0, sizeof(presence_channel_context_t));
+    g_presence_ctx.fd = -1;
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* presence_state_to_string(presence_state_t state) {
+    switch (state) {
+        case PRESENCE_STATE_IDLE:       return "IDLE";
+        case PRESENCE_STATE_CONNECTING: return "CONNECTING";
+        case PRESENCE_STATE_UP:         return "UP";
+        case PRESENCE_STATE_BACKOFF:    return "BACKOFF";
+        default:                        return "UNKNOWN";
+    }
+}
+
+const char* presence_channel_error_string(int error) {
+    switch (error) {
+        case PRESENCE_OK:                   return "OK";
+        case PRESENCE_ERROR_NOT_INIT:       return "Not initialized";
+        case PRESENCE_ERROR_INVALID_PARAM:  return "Invalid parameter";
+        case PRESENCE_ERROR_SOCKET:         return "Socket error";
+        case PRESENCE_ERROR_UNKNOWN:        return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
@@ -0,0 +1,185 @@
+/**
+ * @file presence_channel.h
+ * @brief Presence Channel - Held TCP connection as a console liveness signal
+ *
+ * Instead of pinging the console periodically, one TCP connection to the
+ * Remote Play port is kept open with aggressive keepalive and
+ * TCP_USER_TIMEOUT. While the console is reachable the kernel exchanges
+ * one small keepalive segment per second and nothing else; when it stops
+ * answering the kernel aborts the connection within
+ * PRESENCE_USER_TIMEOUT_MS, and the loss is reported as an event.
+ *
+ * Outcomes and what they say about the console:
+ *
+ *   connected      online (channel held)
+ *   refused (RST)  online, port closed (rest mode, booting); retry later
+ *   unreachable    offline (connect timed out, no route)
+ *   closed         online, peer closed the session; reconnect at once
+ *   lost           offline (keepalive / user timeout expired)
+ *
+ * Failed connects are retried with exponential backoff.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef PRESENCE_CHANNEL_H
+#define PRESENCE_CHANNEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define PRESENCE_OK                     0
+#define PRESENCE_ERROR_NOT_INIT        -1
+#define PRESENCE_ERROR_INVALID_PARAM   -2
+#define PRESENCE_ERROR_SOCKET          -3
+#define PRESENCE_ERROR_UNKNOWN         -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define PRESENCE_DEFAULT_PORT           9295    /**< PS5 Remote Play */
+#define PRESENCE_CONNECT_TIMEOUT_MS     1000    /**< Connect counted as unreachable after this */
+#define PRESENCE_KEEPIDLE_SEC           1       /**< Idle time before the first keepalive */
+#define PRESENCE_KEEPINTVL_SEC          1       /**< Keepalive spacing */
+#define PRESENCE_KEEPCNT                2       /**< Unanswered keepalives before abort */
+#define PRESENCE_USER_TIMEOUT_MS        2000    /**< Abort when data/keepalive unacked this long */
+#define PRESENCE_BACKOFF_INITIAL_MS     250     /**< First retry spacing */
+#define PRESENCE_BACKOFF_MAX_MS         8000    /**< Retry spacing cap */
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Channel state
+ */
+typedef enum {
+    PRESENCE_STATE_IDLE = 0,        /**< Not started */
+    PRESENCE_STATE_CONNECTING,      /**< Connect in flight */
+    PRESENCE_STATE_UP,              /**< Connection held */
+    PRESENCE_STATE_BACKOFF,         /**< Waiting to reconnect */
+} presence_state_t;
+
+/**
+ * @brief Outcome of one connect attempt or held connection
+ */
+typedef enum {
+    PRESENCE_OUTCOME_CONNECTED = 0, /**< Handshake completed */
+    PRESENCE_OUTCOME_REFUSED,       /**< RST: host up, port closed */
+    PRESENCE_OUTCOME_UNREACHABLE,   /**< Connect timed out or no route */
+    PRESENCE_OUTCOME_CLOSED,        /**< Held connection closed by the peer */
+    PRESENCE_OUTCOME_LOST,          /**< Held connection aborted by keepalive */
+} presence_outcome_t;
+
+/**
+ * @brief Presence change reported to the caller
+ */
+typedef enum {
+    PRESENCE_EVENT_NONE = 0,        /**< No change */
+    PRESENCE_EVENT_UP,              /**< Console became reachable */
+    PRESENCE_EVENT_DOWN,            /**< Console became unreachable */
+} presence_event_t;
+
+/**
+ * @brief Channel statistics
+ */
+typedef struct {
+    presence_state_t state;         /**< Current state */
+    bool online;                    /**< Last reported presence */
+    uint32_t connects;              /**< Connections established */
+    uint32_t losses;                /**< Held connections lost to keepalive */
+    uint32_t attempts;              /**< Connect attempts */
+    uint32_t backoff_ms;            /**< Current retry spacing */
+} presence_stats_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Initialize the presence channel
+ * @param port Target port (0 uses PRESENCE_DEFAULT_PORT)
+ * @return PRESENCE_OK on success, negative error code on failure
+ */
+int presence_channel_init(uint16_t port);
+
+/**
+ * @brief Start holding a connection to an address
+ *
+ * Calling again with the same address is a no-op; a different address
+ * drops the current connection and forgets the last presence.
+ *
+ * @param ip Console IPv4 address
+ * @return PRESENCE_OK on success, negative error code on failure
+ */
+int presence_channel_start(const char *ip);
+
+/**
+ * @brief Drop the connection and return to IDLE
+ */
+void presence_channel_stop(void);
+
+/**
+ * @brief Drive the channel (non-blocking, call from the main loop)
+ * @return Presence change, PRESENCE_EVENT_NONE if nothing changed
+ */
+presence_event_t presence_channel_process(void);
+
+/**
+ * @brief Apply one outcome to the state and backoff schedule
+ *
+ * Used by process(); exposed so the state handling can be tested offline.
+ *
+ * @param outcome Outcome
+ * @return Presence change, PRESENCE_EVENT_NONE if nothing changed
+ */
+presence_event_t presence_channel_record(presence_outcome_t outcome);
+
+/**
+ * @brief Get the channel state
+ * @return Channel state
+ */
+presence_state_t presence_channel_get_state(void);
+
+/**
+ * @brief Get a snapshot of the statistics
+ * @param stats Pointer to store statistics
+ * @return PRESENCE_OK on success, negative error code on failure
+ */
+int presence_channel_get_stats(presence_stats_t *stats);
+
+/**
+ * @brief Clean up presence channel resources
+ */
+void presence_channel_cleanup(void);
+
+/**
+ * @brief Convert channel state to string
+ * @param state Channel state
+ * @return State string
+ */
+const char* presence_state_to_string(presence_state_t state);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* presence_channel_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRESENCE_CHANNEL_H */
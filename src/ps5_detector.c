@@ -11,6 +11,13 @@
 #define _POSIX_C_SOURCE 200809L
 
 #include "ps5_detector.h"
+#include "neigh_table.h"
+#include "arp_prober.h"
+#include "server_clock.h"
+#include "server_trace.h"
+#include "worker_pool.h"
+#include "coroutine.h"
+#include "fault_inject.h"
 
 // Standard C library
 #include <stdio.h>
@@ -19,12 +26,18 @@
 #include <stdbool.h>
 #include <errno.h>
 #include <ctype.h>
+#include <strings.h>
 
 // POSIX headers
 #include <time.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
 
 // cJSON for cache management
 #include <cjson/cJSON.h>
@@ -38,6 +51,22 @@
 #define OUTPUT_BUFFER_SIZE  4096
 #define PING_TIMEOUT_SEC    2
 
+// Prior latency per detection method before any history exists
+#define METHOD_PRIOR_PING_US    2000
+#define METHOD_PRIOR_CACHE_US   3000
+#define METHOD_PRIOR_ARP_US     5000
+#define METHOD_PRIOR_LEASE_US   6000
+#define METHOD_PRIOR_SCAN_US    10000000
+#define METHOD_MIN_LATENCY_US   100     // Floor so a free miss still costs something
+
+#define PS5_HEDGE_MAX_PROBES    4       // cached_ip, cache file, ARP, lease
+#define PS5_LEASE_HOST_PREFIX   "PS5"   // DHCP hostname the console sends
+
+#define ICMP_ECHO_REPLY     0
+#define ICMP_ECHO_REQUEST   8
+#define ICMP_HEADER_LEN     8
+#define ICMP_PAYLOAD_LEN    8
+
 /* ============================================================
  *  Internal Structures
  * ============================================================ */
@@ -48,6 +77,15 @@ typedef struct {
     bool initialized;
     ps5_info_t cached_info;
     time_t cache_timestamp;
+    
+    // Detection method history for the device in stats_mac
+    detect_method_stats_t method_stats[DETECT_METHOD_COUNT];
+    char stats_mac[PS5_MAC_MAX_LEN];
+    
+    // Last single-probe answer from arp_prober, until a hedge takes it
+    char arp_answer_ip[PS5_IP_MAX_LEN];
+    char arp_answer_mac[PS5_MAC_MAX_LEN];
+    int arp_answer;             // 1 answered, -1 timed out, 0 none
 } ps5_detector_context_t;
 
 /* ============================================================
@@ -56,6 +94,26 @@ typedef struct {
 
 static ps5_detector_context_t g_detector_ctx = {0};
 
+// Backend is chosen before init and survives cleanup
+static ping_backend_t g_ping_backend = PING_BACKEND_COMMAND;
+static uint16_t g_ping_seq = 0;
+static bool g_scan_enabled = true;
+static char g_lease_file[256] = PS5_LEASE_FILE;
+
+/**
+ * @brief One cache file write, handed to the worker pool
+ */
+typedef struct {
+    char path[256];
+    char *json;                         // NULL = remove the file
+} cache_write_t;
+
+// At most one write is in flight so writes land in order; a newer save
+// arriving meanwhile replaces the waiting one. Kept outside the context:
+// a write may finish after ps5_detector_cleanup().
+static bool g_cache_write_busy = false;
+static cache_write_t *g_cache_write_next = NULL;
+
 /* ============================================================
  *  Helper Functions - Command Execution
  * ============================================================ */
@@ -68,6 +126,11 @@ static int execute_command(const char *cmd, char *output, size_t output_size) {
         return PS5_DETECT_ERROR_INVALID_PARAM;
     }
     
+    FAULT_DELAY(FAULT_POINT_CMD);
+    if (FAULT_FAIL(FAULT_POINT_CMD)) {
+        return PS5_DETECT_ERROR_SCAN_FAILED;
+    }
+    
     FILE *fp = popen(cmd, "r");
     if (fp == NULL) {
         #ifndef TESTING
@@ -189,16 +252,9 @@ bool ps5_detector_validate_ip(const char *ip) {
  * ============================================================ */
 
 /**
- * @brief Load cache from JSON file
+ * @brief Read and parse the cache file
  */
-static int load_cache_from_file(ps5_info_t *info) {
-    if (info == NULL) {
-        return PS5_DETECT_ERROR_INVALID_PARAM;
-    }
-    
-    // ✅ FIX: Initialize the structure to zero first
-    memset(info, 0, sizeof(ps5_info_t));
-    
+static int read_cache_json(cJSON **out) {
     // Check if cache file exists
     if (access(g_detector_ctx.cache_path, F_OK) != 0) {
         return PS5_DETECT_ERROR_CACHE_INVALID;
@@ -229,14 +285,21 @@ static int load_cache_from_file(ps5_info_t *info) {
     size_t bytes_read = fread(json_str, 1, file_size, fp);
     json_str[bytes_read] = '\0';
     fclose(fp);
+    FAULT_CORRUPT(FAULT_POINT_CACHE, json_str, bytes_read);
     
     // Parse JSON
-    cJSON *root = cJSON_Parse(json_str);
+    *out = cJSON_Parse(json_str);
     free(json_str);
     
-    if (root == NULL) {
-        return PS5_DETECT_ERROR_CACHE_INVALID;
-    }
+    return (*out != NULL) ? PS5_DETECT_OK : PS5_DETECT_ERROR_CACHE_INVALID;
+}
+
+/**
+ * @brief Extract the console entry from the cache JSON (age is checked by the caller)
+ */
+static int parse_cache_entry(cJSON *root, ps5_info_t *info) {
+    // ✅ FIX: Initialize the structure to zero first
+    memset(info, 0, sizeof(ps5_info_t));
     
     // Extract fields
     cJSON *ip_item = cJSON_GetObjectItem(root, "ip");
@@ -247,7 +310,6 @@ static int load_cache_from_file(ps5_info_t *info) {
     if (ip_item == NULL || !cJSON_IsString(ip_item) ||
         mac_item == NULL || !cJSON_IsString(mac_item) ||
         last_seen_item == NULL || !cJSON_IsNumber(last_seen_item)) {
-        cJSON_Delete(root);
         return PS5_DETECT_ERROR_CACHE_INVALID;
     }
     
@@ -257,19 +319,106 @@ static int load_cache_from_file(ps5_info_t *info) {
     info->last_seen = (time_t)last_seen_item->valuedouble;
     info->online = (online_item != NULL && cJSON_IsTrue(online_item));
     
-    cJSON_Delete(root);
+    return PS5_DETECT_OK;
+}
+
+/**
+ * @brief Write the cache JSON (temp file + rename, so readers never see half a file)
+ * @return PS5_DETECT_OK, or PS5_DETECT_ERROR_CACHE_INVALID if the file could not be written
+ */
+static int write_cache_file(const char *path, const char *json_str) {
+    char tmp_path[sizeof(((cache_write_t *)0)->path) + 8];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
     
-    // Validate cache age
-    time_t now = time(NULL);
-    if (now - info->last_seen > PS5_CACHE_MAX_AGE) {
+    FAULT_DELAY(FAULT_POINT_CACHE);
+    if (FAULT_FAIL(FAULT_POINT_CACHE)) {
+        return PS5_DETECT_ERROR_CACHE_INVALID;
+    }
+    
+    FILE *fp = fopen(tmp_path, "w");
+    if (fp == NULL) {
+        return PS5_DETECT_ERROR_CACHE_INVALID;
+    }
+    
+    bool ok = (fputs(json_str, fp) >= 0);
+    ok = (fclose(fp) == 0) && ok;
+    
+    if (!ok || rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
         return PS5_DETECT_ERROR_CACHE_INVALID;
     }
     
     return PS5_DETECT_OK;
 }
 
+/**
+ * @brief Worker pool job: write one cache snapshot (or remove the file)
+ */
+static int cache_write_job(void *arg) {
+    cache_write_t *write = (cache_write_t *)arg;
+    
+    if (write->json == NULL) {
+        if (unlink(write->path) != 0 && errno != ENOENT) {
+            return PS5_DETECT_ERROR_CACHE_INVALID;
+        }
+        return PS5_DETECT_OK;
+    }
+    return write_cache_file(write->path, write->json);
+}
+
+static void cache_write_done(int result, void *arg);
+
+/**
+ * @brief Hand a snapshot to the worker pool, or queue it behind the write in flight
+ * @return PS5_DETECT_OK if queued, negative error code if the pool refused it
+ */
+static int submit_cache_write(cache_write_t *write) {
+    if (g_cache_write_busy) {
+        if (g_cache_write_next != NULL) {
+            cJSON_free(g_cache_write_next->json);
+            free(g_cache_write_next);
+        }
+        g_cache_write_next = write;
+        return PS5_DETECT_OK;
+    }
+    
+    if (worker_pool_submit(cache_write_job, cache_write_done, write, 0) != WORKER_POOL_OK) {
+        return PS5_DETECT_ERROR_UNKNOWN;
+    }
+    g_cache_write_busy = true;
+    return PS5_DETECT_OK;
+}
+
+/**
+ * @brief Worker pool completion (main loop): log failures, start the next write
+ */
+static void cache_write_done(int result, void *arg) {
+    cache_write_t *write = (cache_write_t *)arg;
+    
+    if (result != PS5_DETECT_OK) {
+        #ifndef TESTING
+        fprintf(stderr, "[PS5Detect] Failed to write cache: %s\n", write->path);
+        #endif
+    }
+    cJSON_free(write->json);
+    free(write);
+    
+    g_cache_write_busy = false;
+    cache_write_t *next = g_cache_write_next;
+    g_cache_write_next = NULL;
+    
+    if (next != NULL && submit_cache_write(next) != PS5_DETECT_OK) {
+        cache_write_job(next);
+        cJSON_free(next->json);
+        free(next);
+    }
+}
+
 /**
  * @brief Save cache to JSON file
+ *
+ * The JSON is built here; the file write goes to the worker pool when
+ * it runs, so the main loop does not wait on storage.
  */
 static int save_cache_to_file(const ps5_info_t *info) {
     if (info == NULL) {
@@ -287,6 +436,17 @@ static int save_cache_to_file(const ps5_info_t *info) {
     cJSON_AddNumberToObject(root, "last_seen", (double)info->last_seen);
     cJSON_AddBoolToObject(root, "online", info->online);
     
+    // Method history belongs to this device on this subnet
+    cJSON_AddStringToObject(root, "subnet", g_detector_ctx.subnet);
+    cJSON *methods = cJSON_AddObjectToObject(root, "methods");
+    for (int m = 0; m < DETECT_METHOD_COUNT; m++) {
+        const detect_method_stats_t *st = &g_detector_ctx.method_stats[m];
+        cJSON *entry = cJSON_AddObjectToObject(methods, ps5_detector_method_string((detect_method_t)m));
+        cJSON_AddNumberToObject(entry, "attempts", st->attempts);
+        cJSON_AddNumberToObject(entry, "hits", st->hits);
+        cJSON_AddNumberToObject(entry, "latency_us", st->avg_latency_us);
+    }
+    
     // Convert to string
     char *json_str = cJSON_Print(root);
     cJSON_Delete(root);
@@ -295,18 +455,144 @@ static int save_cache_to_file(const ps5_info_t *info) {
         return PS5_DETECT_ERROR_UNKNOWN;
     }
     
-    // Write to file
-    FILE *fp = fopen(g_detector_ctx.cache_path, "w");
-    if (fp == NULL) {
-        cJSON_free(json_str);
-        return PS5_DETECT_ERROR_CACHE_INVALID;
+    if (worker_pool_is_ready()) {
+        cache_write_t *write = (cache_write_t *)malloc(sizeof(cache_write_t));
+        if (write != NULL) {
+            snprintf(write->path, sizeof(write->path), "%s", g_detector_ctx.cache_path);
+            write->json = json_str;
+            if (submit_cache_write(write) == PS5_DETECT_OK) {
+                return PS5_DETECT_OK;
+            }
+            free(write);
+        }
+        // Pool full: fall through to a direct write
     }
     
-    fputs(json_str, fp);
-    fclose(fp);
+    int ret = write_cache_file(g_detector_ctx.cache_path, json_str);
     cJSON_free(json_str);
     
-    return PS5_DETECT_OK;
+    return ret;
+}
+
+/**
+ * @brief Restore method history saved for this subnet
+ */
+static void load_method_stats(cJSON *root) {
+    cJSON *subnet = cJSON_GetObjectItem(root, "subnet");
+    cJSON *mac = cJSON_GetObjectItem(root, "mac");
+    cJSON *methods = cJSON_GetObjectItem(root, "methods");
+    
+    if (subnet == NULL || !cJSON_IsString(subnet) ||
+        strcmp(subnet->valuestring, g_detector_ctx.subnet) != 0 || methods == NULL) {
+        return;  // Another site's history
+    }
+    
+    for (int m = 0; m < DETECT_METHOD_COUNT; m++) {
+        cJSON *entry = cJSON_GetObjectItem(methods, ps5_detector_method_string((detect_method_t)m));
+        cJSON *attempts = cJSON_GetObjectItem(entry, "attempts");
+        cJSON *hits = cJSON_GetObjectItem(entry, "hits");
+        cJSON *latency = cJSON_GetObjectItem(entry, "latency_us");
+        
+        if (cJSON_IsNumber(attempts) && cJSON_IsNumber(hits) && cJSON_IsNumber(latency) &&
+            hits->valuedouble <= attempts->valuedouble) {
+            detect_method_stats_t *st = &g_detector_ctx.method_stats[m];
+            st->attempts = (uint32_t)attempts->valuedouble;
+            st->hits = (uint32_t)hits->valuedouble;
+            st->avg_latency_us = (uint32_t)latency->valuedouble;
+        }
+    }
+    
+    if (mac != NULL && cJSON_IsString(mac)) {
+        snprintf(g_detector_ctx.stats_mac, PS5_MAC_MAX_LEN, "%s", mac->valuestring);
+    }
+}
+
+/**
+ * @brief Read the cache file once at init
+ *
+ * The detector is the file's only writer, so afterwards the copy in
+ * cached_info is kept current by save/clear and lookups never touch
+ * storage from the main loop.
+ */
+static void load_cache(void) {
+    cJSON *root = NULL;
+    if (read_cache_json(&root) != PS5_DETECT_OK) {
+        return;
+    }
+    
+    if (parse_cache_entry(root, &g_detector_ctx.cached_info) == PS5_DETECT_OK) {
+        g_detector_ctx.cache_timestamp = time(NULL);
+    }
+    load_method_stats(root);
+    
+    cJSON_Delete(root);
+}
+
+/* ============================================================
+ *  Helper Functions - Method Statistics
+ * ============================================================ */
+
+/**
+ * @brief Prior latency per method, chosen so that with no history the
+ *        order is PING, CACHE, ARP, LEASE, SCAN
+ */
+static uint32_t method_prior_latency_us(detect_method_t method) {
+    switch (method) {
+        case DETECT_METHOD_PING:    return METHOD_PRIOR_PING_US;
+        case DETECT_METHOD_CACHE:   return METHOD_PRIOR_CACHE_US;
+        case DETECT_METHOD_ARP:     return METHOD_PRIOR_ARP_US;
+        case DETECT_METHOD_LEASE:   return METHOD_PRIOR_LEASE_US;
+        case DETECT_METHOD_SCAN:
+        default:                    return METHOD_PRIOR_SCAN_US;
+    }
+}
+
+/**
+ * @brief Expected time until this method answers: latency / hit rate
+ *
+ * Hit rate uses Laplace smoothing, so a method that keeps missing
+ * drifts back gradually instead of being ruled out for good.
+ */
+static double method_expected_cost(detect_method_t method) {
+    const detect_method_stats_t *st = &g_detector_ctx.method_stats[method];
+    
+    uint32_t latency_us = (st->attempts > 0) ? st->avg_latency_us
+                                             : method_prior_latency_us(method);
+    double latency = (latency_us < METHOD_MIN_LATENCY_US) ? METHOD_MIN_LATENCY_US
+                                                          : (double)latency_us;
+    double hit_rate = ((double)st->hits + 1.0) / ((double)st->attempts + 2.0);
+    
+    return latency / hit_rate;
+}
+
+/**
+ * @brief Record one attempt; a hit on a different device restarts history
+ */
+static void record_method(detect_method_t method, bool hit, uint64_t latency_us,
+                          const ps5_info_t *info) {
+    if (hit && info->mac[0] != '\0') {
+        if (g_detector_ctx.stats_mac[0] != '\0' &&
+            strcasecmp(g_detector_ctx.stats_mac, info->mac) != 0) {
+            memset(g_detector_ctx.method_stats, 0, sizeof(g_detector_ctx.method_stats));
+        }
+        snprintf(g_detector_ctx.stats_mac, PS5_MAC_MAX_LEN, "%s", info->mac);
+    }
+    
+    detect_method_stats_t *st = &g_detector_ctx.method_stats[method];
+    uint32_t sample = (latency_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)latency_us;
+    
+    // EWMA with gain 1/8 (as TCP SRTT); first sample taken as is
+    if (st->attempts == 0) {
+        st->avg_latency_us = sample;
+    } else {
+        int64_t delta = (int64_t)sample - (int64_t)st->avg_latency_us;
+        st->avg_latency_us = (uint32_t)((int64_t)st->avg_latency_us + delta / 8);
+    }
+    
+    st->attempts++;
+    if (hit) {
+        st->hits++;
+    }
 }
 
 /* ============================================================
@@ -321,49 +607,81 @@ static int check_arp_table(ps5_info_t *info) {
         return PS5_DETECT_ERROR_INVALID_PARAM;
     }
     
-    char cmd[COMMAND_BUFFER_SIZE];
-    char output[OUTPUT_BUFFER_SIZE];
+    neigh_entry_t entries[NEIGH_MAX_ENTRIES];
+    int count = neigh_table_dump(entries, NEIGH_MAX_ENTRIES);
+    const char *known_mac = g_detector_ctx.stats_mac;
     
-    snprintf(cmd, sizeof(cmd), "arp -n");
+    for (int i = 0; i < count; i++) {
+        if (!ps5_detector_validate_ip(entries[i].ip)) {
+            continue;
+        }
+        
+        // Once the PS5's MAC is known only that entry counts
+        // TODO: Add PS5 MAC address verification for the first sighting
+        // For now, accept any valid entry in our subnet until then
+        if (known_mac[0] != '\0' && strcasecmp(entries[i].mac, known_mac) != 0) {
+            continue;
+        }
+        
+        // Same field sizes as neigh_entry_t, and the IP was validated above
+        memcpy(info->ip, entries[i].ip, strlen(entries[i].ip) + 1);
+        memcpy(info->mac, entries[i].mac, strlen(entries[i].mac) + 1);
+        info->last_seen = time(NULL);
+        info->online = true;
+        return PS5_DETECT_OK;
+    }
     
-    if (execute_command(cmd, output, sizeof(output)) != PS5_DETECT_OK) {
+    return PS5_DETECT_ERROR_NOT_FOUND;
+}
+
+/**
+ * @brief Find the PS5's DHCP lease
+ *
+ * dnsmasq format: "<expiry> <mac> <ip> <hostname> <client-id>". Matches
+ * the known MAC, or before that is learned, the console's hostname.
+ */
+static int find_lease(char *ip, char *mac) {
+    FILE *fp = fopen(g_lease_file, "r");
+    if (fp == NULL) {
         return PS5_DETECT_ERROR_NOT_FOUND;
     }
     
-    // Parse ARP output
-    // Format: IP address       HW type     Flags       HW address            Mask     Device
-    // 192.168.1.100    0x1         0x2         aa:bb:cc:dd:ee:ff     *        eth0
+    const char *known_mac = g_detector_ctx.stats_mac;
+    time_t now = time(NULL);
+    char line[256];
+    int result = PS5_DETECT_ERROR_NOT_FOUND;
     
-    char *line = strtok(output, "\n");
-    while (line != NULL) {
-        char ip[PS5_IP_MAX_LEN];
-        char mac[PS5_MAC_MAX_LEN];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        long expiry = 0;
+        char lease_mac[32], lease_ip[32], host[64];
         
-        // Try to parse line
-        if (sscanf(line, "%15s %*s %*s %17s", ip, mac) == 2) {
-            if (ps5_detector_validate_ip(ip) && ps5_detector_validate_mac(mac)) {
-                // Found a valid entry
-                // TODO: Add PS5 MAC address verification here
-                // For now, accept any valid entry in our subnet
-                snprintf(info->ip, PS5_IP_MAX_LEN, "%s", ip);
-                snprintf(info->mac, PS5_MAC_MAX_LEN, "%s", mac);
-                info->last_seen = time(NULL);
-                info->online = true;
-                return PS5_DETECT_OK;
-            }
+        if (sscanf(line, "%ld %31s %31s %63s", &expiry, lease_mac, lease_ip, host) != 4 ||
+            (expiry != 0 && (time_t)expiry < now) || !ps5_detector_validate_ip(lease_ip) ||
+            !ps5_detector_validate_mac(lease_mac)) {
+            continue;
         }
         
-        line = strtok(NULL, "\n");
+        bool match = (known_mac[0] != '\0')
+                   ? (strcasecmp(lease_mac, known_mac) == 0)
+                   : (strncasecmp(host, PS5_LEASE_HOST_PREFIX, strlen(PS5_LEASE_HOST_PREFIX)) == 0);
+        if (match) {
+            // Lengths already bounded by the validators above
+            memcpy(ip, lease_ip, strlen(lease_ip) + 1);
+            memcpy(mac, lease_mac, strlen(lease_mac) + 1);
+            result = PS5_DETECT_OK;
+            break;
+        }
     }
     
-    return PS5_DETECT_ERROR_NOT_FOUND;
+    fclose(fp);
+    return result;
 }
 
 /**
  * @brief Scan network using nmap
  */
-static int scan_network_nmap(ps5_info_t *info) {
-    if (info == NULL) {
+static int scan_network_nmap(const char *subnet, ps5_info_t *info) {
+    if (subnet == NULL || info == NULL) {
         return PS5_DETECT_ERROR_INVALID_PARAM;
     }
     
@@ -371,9 +689,11 @@ static int scan_network_nmap(ps5_info_t *info) {
     char output[OUTPUT_BUFFER_SIZE];
     
     // Use nmap to scan for PS5 Remote Play port (9295)
+    // --open lists only hosts with the port open; no grep, so the exit
+    // status is nmap's own and a missing nmap shows up as SCAN_FAILED
     snprintf(cmd, sizeof(cmd), 
-             "nmap -p %d --open %s 2>/dev/null | grep -B 4 'open'",
-             PS5_DEFAULT_PORT, g_detector_ctx.subnet);
+             "nmap -p %d --open %s 2>/dev/null",
+             PS5_DEFAULT_PORT, subnet);
     
     #ifdef TESTING
     // In test mode, simulate not found
@@ -381,12 +701,14 @@ static int scan_network_nmap(ps5_info_t *info) {
     #endif
     
     if (execute_command(cmd, output, sizeof(output)) != PS5_DETECT_OK) {
-        return PS5_DETECT_ERROR_NOT_FOUND;
+        return PS5_DETECT_ERROR_SCAN_FAILED;
     }
     
     // Parse nmap output to find IP
     // Look for "Nmap scan report for X.X.X.X"
-    char *line = strtok(output, "\n");
+    // strtok_r: the scan also runs on a worker thread
+    char *saveptr = NULL;
+    char *line = strtok_r(output, "\n", &saveptr);
     while (line != NULL) {
         if (strstr(line, "Nmap scan report for") != NULL) {
             // Extract IP address
@@ -403,77 +725,357 @@ static int scan_network_nmap(ps5_info_t *info) {
                 }
             }
         }
-        line = strtok(NULL, "\n");
+        line = strtok_r(NULL, "\n", &saveptr);
     }
     
     return PS5_DETECT_ERROR_NOT_FOUND;
 }
 
+/**
+ * @brief Resolve the MAC, record stats and cache a finished scan
+ */
+static int scan_finish(ps5_info_t *info, int result, uint64_t start_us) {
+    if (result == PS5_DETECT_OK) {
+        // If we found IP, the scan just resolved its MAC
+        if (info->mac[0] == '\0') {
+            neigh_table_lookup_ip(info->ip, info->mac, PS5_MAC_MAX_LEN);
+        }
+        info->method = DETECT_METHOD_SCAN;
+    }
+    
+    uint64_t elapsed_us = server_clock_monotonic_us() - start_us;
+    record_method(DETECT_METHOD_SCAN, result == PS5_DETECT_OK, elapsed_us, info);
+    
+    if (result == PS5_DETECT_OK) {
+        // Save to cache
+        ps5_detector_save_cache(info);
+    }
+    
+    SERVER_TRACE2(scan_end, result, elapsed_us);
+    return result;
+}
+
 /* ============================================================
- *  Public API Implementation
+ *  Helper Functions - Liveness Checks
  * ============================================================ */
 
-int ps5_detector_init(const char *subnet, const char *cache_path) {
-    if (g_detector_ctx.initialized) {
-        return PS5_DETECT_ERROR_NOT_INIT;
+/**
+ * @brief One in-flight liveness probe (ICMP echo, TCP connect or ARP who-has)
+ */
+typedef struct {
+    char ip[PS5_IP_MAX_LEN];
+    char mac[PS5_MAC_MAX_LEN];  // ARP: expected MAC, then the answering one
+    detect_method_t method;     // Method credited when this probe answers
+    ping_backend_t backend;
+    struct in_addr addr;
+    int fd;
+    uint16_t id;
+    uint16_t seq;
+    int result;                 // 0 pending, 1 alive, -1 dead
+    uint64_t start_us;
+} liveness_probe_t;
+
+/**
+ * @brief Milliseconds left until deadline (0 when passed)
+ */
+static int remaining_ms(uint64_t deadline_us) {
+    uint64_t now = server_clock_monotonic_us();
+    return (now >= deadline_us) ? 0 : (int)((deadline_us - now + 999) / 1000);
+}
+
+/**
+ * @brief Internet checksum (RFC 1071)
+ */
+static uint16_t icmp_checksum(const uint8_t *data, size_t len) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i + 1 < len; i += 2) {
+        sum += (uint32_t)((data[i] << 8) | data[i + 1]);
     }
-    
-    if (subnet == NULL || cache_path == NULL) {
-        return PS5_DETECT_ERROR_INVALID_PARAM;
+    if (len & 1) {
+        sum += (uint32_t)(data[len - 1] << 8);
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return (uint16_t)~sum;
+}
+
+/**
+ * @brief Send an ICMP echo request or start a non-blocking TCP connect
+ *
+ * TCP connects to the Remote Play port; a refusal also proves the host
+ * is up. On return probe->result may already be final.
+ */
+static void probe_start(liveness_probe_t *probe, const char *ip, ping_backend_t backend,
+                        detect_method_t method) {
+    memset(probe, 0, sizeof(liveness_probe_t));
+    snprintf(probe->ip, PS5_IP_MAX_LEN, "%s", ip);
+    probe->method = method;
+    probe->backend = backend;
+    probe->fd = -1;
+    probe->result = -1;
+    probe->start_us = server_clock_monotonic_us();
+    
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    if (inet_pton(AF_INET, ip, &addr.sin_addr) != 1) {
+        return;
     }
+    probe->addr = addr.sin_addr;
     
-    // Copy configuration
-    strncpy(g_detector_ctx.subnet, subnet, PS5_SUBNET_MAX_LEN - 1);
-    g_detector_ctx.subnet[PS5_SUBNET_MAX_LEN - 1] = '\0';
-    strncpy(g_detector_ctx.cache_path, cache_path, sizeof(g_detector_ctx.cache_path) - 1);
-    g_detector_ctx.cache_path[sizeof(g_detector_ctx.cache_path) - 1] = '\0';
+    #ifdef TESTING
+    // In test mode, every valid IP answers (as ps5_detector_ping)
+    probe->result = 1;
+    return;
+    #endif
     
-    // Initialize state
-    memset(&g_detector_ctx.cached_info, 0, sizeof(ps5_info_t));
-    g_detector_ctx.cache_timestamp = 0;
-    g_detector_ctx.initialized = true;
+    if (backend == PING_BACKEND_TCP) {
+        addr.sin_port = htons(PS5_DEFAULT_PORT);
+        probe->fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (probe->fd < 0) {
+            return;
+        }
+        fcntl(probe->fd, F_SETFL, fcntl(probe->fd, F_GETFL, 0) | O_NONBLOCK);
+        
+        if (connect(probe->fd, (struct sockaddr*)&addr, sizeof(addr)) == 0) {
+            probe->result = 1;
+        } else if (errno == EINPROGRESS) {
+            probe->result = 0;
+        } else {
+            probe->result = (errno == ECONNREFUSED) ? 1 : -1;
+        }
+        return;
+    }
     
-    #ifndef TESTING
-    fprintf(stdout, "[PS5Detect] Initialized: subnet=%s, cache=%s\n", 
-            subnet, cache_path);
-    #endif
+    int sock_type = (backend == PING_BACKEND_ICMP_RAW) ? SOCK_RAW : SOCK_DGRAM;
+    probe->fd = socket(AF_INET, sock_type, IPPROTO_ICMP);
+    if (probe->fd < 0) {
+        return;
+    }
     
-    return PS5_DETECT_OK;
+    // Datagram sockets get their id rewritten by the kernel; match on seq
+    probe->id = (uint16_t)getpid();
+    probe->seq = ++g_ping_seq;
+    
+    uint8_t packet[ICMP_HEADER_LEN + ICMP_PAYLOAD_LEN];
+    memset(packet, 0, sizeof(packet));
+    packet[0] = ICMP_ECHO_REQUEST;
+    packet[4] = (uint8_t)(probe->id >> 8);
+    packet[5] = (uint8_t)probe->id;
+    packet[6] = (uint8_t)(probe->seq >> 8);
+    packet[7] = (uint8_t)probe->seq;
+    uint16_t csum = icmp_checksum(packet, sizeof(packet));
+    packet[2] = (uint8_t)(csum >> 8);
+    packet[3] = (uint8_t)csum;
+    
+    if (sendto(probe->fd, packet, sizeof(packet), 0, (struct sockaddr*)&addr, sizeof(addr)) >= 0) {
+        probe->result = 0;
+    }
 }
 
-int ps5_detector_get_cached(ps5_info_t *info) {
-    if (!g_detector_ctx.initialized) {
-        return PS5_DETECT_ERROR_NOT_INIT;
+/**
+ * @brief Send an ARP who-has through arp_prober
+ *
+ * The prober's socket is shared, not owned: the answer is matched in
+ * arp_prober_process() and comes back through
+ * ps5_detector_handle_arp_result().
+ */
+static void probe_start_arp(liveness_probe_t *probe, const char *ip, const char *mac) {
+    memset(probe, 0, sizeof(liveness_probe_t));
+    snprintf(probe->ip, PS5_IP_MAX_LEN, "%s", ip);
+    snprintf(probe->mac, PS5_MAC_MAX_LEN, "%s", (mac != NULL) ? mac : "");
+    probe->method = DETECT_METHOD_ARP;
+    probe->backend = PING_BACKEND_ARP;
+    probe->fd = -1;
+    probe->result = -1;
+    probe->start_us = server_clock_monotonic_us();
+    
+    // An answer from an earlier probe must not count for this one
+    g_detector_ctx.arp_answer = 0;
+    
+    if (arp_prober_probe(ip, probe->mac[0] != '\0' ? probe->mac : NULL) == ARP_OK) {
+        probe->fd = arp_prober_get_fd();
+        probe->result = 0;
     }
-    
-    if (info == NULL) {
-        return PS5_DETECT_ERROR_INVALID_PARAM;
+}
+
+static short probe_events(const liveness_probe_t *probe) {
+    return (probe->backend == PING_BACKEND_TCP) ? POLLOUT : POLLIN;
+}
+
+/**
+ * @brief Injected reply loss: forget the answer and let the probe run out its deadline
+ */
+static void probe_fault_drop(liveness_probe_t *probe) {
+    if (probe->result == 1 && FAULT_FAIL(FAULT_POINT_PROBE)) {
+        if (probe->backend != PING_BACKEND_ARP) {
+            close(probe->fd);
+        }
+        probe->fd = -1;     // poll() skips it until the deadline
+        probe->result = 0;
     }
-    
-    return load_cache_from_file(info);
 }
 
-int ps5_detector_save_cache(const ps5_info_t *info) {
-    if (!g_detector_ctx.initialized) {
-        return PS5_DETECT_ERROR_NOT_INIT;
+/**
+ * @brief Check whether an ARP answer is waiting for this probe
+ */
+static bool probe_arp_answered(const liveness_probe_t *probe) {
+    return probe->backend == PING_BACKEND_ARP && probe->result == 0 &&
+           g_detector_ctx.arp_answer != 0 && strcmp(g_detector_ctx.arp_answer_ip, probe->ip) == 0;
+}
+
+/**
+ * @brief Take the ARP answer for this probe; a different MAC is another host
+ */
+static void probe_take_arp_answer(liveness_probe_t *probe) {
+    if (!probe_arp_answered(probe)) {
+        return;
     }
     
-    if (info == NULL) {
-        return PS5_DETECT_ERROR_INVALID_PARAM;
+    int answer = g_detector_ctx.arp_answer;
+    g_detector_ctx.arp_answer = 0;
+    if (answer < 0 ||
+        (probe->mac[0] != '\0' && strcasecmp(probe->mac, g_detector_ctx.arp_answer_mac) != 0)) {
+        probe->result = -1;
+        return;
     }
     
-    // Update internal cache
-    memcpy(&g_detector_ctx.cached_info, info, sizeof(ps5_info_t));
-    g_detector_ctx.cache_timestamp = time(NULL);
+    snprintf(probe->mac, PS5_MAC_MAX_LEN, "%s", g_detector_ctx.arp_answer_mac);
+    probe->result = 1;
+    probe_fault_drop(probe);
+}
+
+/**
+ * @brief Consume readiness on the probe's socket and update its result
+ */
+static void probe_check(liveness_probe_t *probe) {
+    if (probe->backend == PING_BACKEND_ARP) {
+        arp_prober_process();
+        probe_take_arp_answer(probe);
+        return;
+    }
     
-    return save_cache_to_file(info);
+    if (probe->backend == PING_BACKEND_TCP) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(probe->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        probe->result = (err == 0 || err == ECONNREFUSED) ? 1 : -1;
+        probe_fault_drop(probe);
+        return;
+    }
+    
+    uint8_t reply[128];
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+    ssize_t n = recvfrom(probe->fd, reply, sizeof(reply), 0, (struct sockaddr*)&from, &from_len);
+    if (n <= 0 || from.sin_addr.s_addr != probe->addr.s_addr) {
+        return;  // Someone else's ICMP; keep waiting
+    }
+    
+    // Raw sockets deliver the IP header too
+    bool raw = (probe->backend == PING_BACKEND_ICMP_RAW);
+    size_t offset = raw ? (size_t)(reply[0] & 0x0F) * 4 : 0;
+    if ((size_t)n < offset + ICMP_HEADER_LEN) {
+        return;
+    }
+    
+    const uint8_t *icmp = reply + offset;
+    uint16_t reply_id = (uint16_t)((icmp[4] << 8) | icmp[5]);
+    uint16_t reply_seq = (uint16_t)((icmp[6] << 8) | icmp[7]);
+    
+    if (icmp[0] == ICMP_ECHO_REPLY && reply_seq == probe->seq && (!raw || reply_id == probe->id)) {
+        probe->result = 1;
+        probe_fault_drop(probe);
+    }
 }
 
-bool ps5_detector_ping(const char *ip) {
-    if (ip == NULL || !ps5_detector_validate_ip(ip)) {
-        return false;
+static void probe_cancel(liveness_probe_t *probe) {
+    if (probe->fd >= 0 && probe->backend != PING_BACKEND_ARP) {
+        close(probe->fd);
+    }
+    probe->fd = -1;
+}
+
+/**
+ * @brief Find an answered probe, else collect the pending ones' fds
+ * @param nfds Set to the number of fds collected
+ * @return Index of the probe that answered, -1 if none has yet
+ */
+static int probe_collect(liveness_probe_t *probes, int count,
+                         struct pollfd *pfds, int *map, int *nfds) {
+    *nfds = 0;
+    
+    for (int i = 0; i < count; i++) {
+        probe_take_arp_answer(&probes[i]);
+        if (probes[i].result == 1) {
+            return i;
+        }
+        if (probes[i].result == 0 && *nfds < PS5_HEDGE_MAX_PROBES) {
+            pfds[*nfds].fd = probes[i].fd;
+            pfds[*nfds].events = probe_events(&probes[i]);
+            pfds[*nfds].revents = 0;
+            map[(*nfds)++] = i;
+        }
     }
     
+    return -1;
+}
+
+/**
+ * @brief Consume the readiness reported for the collected fds
+ */
+static void probe_dispatch(liveness_probe_t *probes, const struct pollfd *pfds,
+                           const int *map, int nfds) {
+    for (int j = 0; j < nfds; j++) {
+        if (pfds[j].revents != 0) {
+            probe_check(&probes[map[j]]);
+        }
+    }
+}
+
+/**
+ * @brief Wait for the first probe to answer
+ * @return Index of the probe that answered, -1 if none did by the deadline
+ */
+static int probe_wait_any(liveness_probe_t *probes, int count, uint64_t deadline_us) {
+    for (;;) {
+        struct pollfd pfds[PS5_HEDGE_MAX_PROBES];
+        int map[PS5_HEDGE_MAX_PROBES];
+        int nfds;
+        
+        int winner = probe_collect(probes, count, pfds, map, &nfds);
+        if (winner >= 0) {
+            return winner;
+        }
+        
+        int timeout = remaining_ms(deadline_us);
+        if (nfds == 0 || timeout == 0 || poll(pfds, (nfds_t)nfds, timeout) <= 0) {
+            return -1;
+        }
+        
+        probe_dispatch(probes, pfds, map, nfds);
+    }
+}
+
+/**
+ * @brief Blocking liveness check over a socket backend
+ */
+static bool ping_socket(const char *ip, ping_backend_t backend) {
+    liveness_probe_t probe;
+    probe_start(&probe, ip, backend, DETECT_METHOD_PING);
+    
+    uint64_t deadline = probe.start_us + (uint64_t)PING_TIMEOUT_SEC * 1000000ULL;
+    bool alive = (probe_wait_any(&probe, 1, deadline) == 0);
+    
+    probe_cancel(&probe);
+    return alive;
+}
+
+/**
+ * @brief Run ping(8)
+ */
+static bool ping_command(const char *ip) {
     char cmd[COMMAND_BUFFER_SIZE];
     char output[OUTPUT_BUFFER_SIZE];
     
@@ -482,15 +1084,126 @@ bool ps5_detector_ping(const char *ip) {
              "ping -c 1 -W %d %s 2>/dev/null",
              PING_TIMEOUT_SEC, ip);
     
+    int result = execute_command(cmd, output, sizeof(output));
+    
+    // Check if ping was successful
+    return (result == PS5_DETECT_OK && strstr(output, "1 received") != NULL);
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int ps5_detector_init(const char *subnet, const char *cache_path) {
+    if (g_detector_ctx.initialized) {
+        return PS5_DETECT_ERROR_NOT_INIT;
+    }
+    
+    if (subnet == NULL || cache_path == NULL) {
+        return PS5_DETECT_ERROR_INVALID_PARAM;
+    }
+    
+    // Copy configuration
+    strncpy(g_detector_ctx.subnet, subnet, PS5_SUBNET_MAX_LEN - 1);
+    g_detector_ctx.subnet[PS5_SUBNET_MAX_LEN - 1] = '\0';
+    strncpy(g_detector_ctx.cache_path, cache_path, sizeof(g_detector_ctx.cache_path) - 1);
+    g_detector_ctx.cache_path[sizeof(g_detector_ctx.cache_path) - 1] = '\0';
+    
+    // Initialize state
+    memset(&g_detector_ctx.cached_info, 0, sizeof(ps5_info_t));
+    g_detector_ctx.cache_timestamp = 0;
+    memset(g_detector_ctx.method_stats, 0, sizeof(g_detector_ctx.method_stats));
+    g_detector_ctx.stats_mac[0] = '\0';
+    load_cache();
+    g_detector_ctx.initialized = true;
+    
+    #ifndef TESTING
+    fprintf(stdout, "[PS5Detect] Initialized: subnet=%s, cache=%s\n", 
+            subnet, cache_path);
+    #endif
+    
+    return PS5_DETECT_OK;
+}
+
+int ps5_detector_get_cached(ps5_info_t *info) {
+    if (!g_detector_ctx.initialized) {
+        return PS5_DETECT_ERROR_NOT_INIT;
+    }
+    
+    if (info == NULL) {
+        return PS5_DETECT_ERROR_INVALID_PARAM;
+    }
+    
+    if (g_detector_ctx.cache_timestamp == 0) {
+        memset(info, 0, sizeof(ps5_info_t));
+        return PS5_DETECT_ERROR_CACHE_INVALID;
+    }
+    
+    *info = g_detector_ctx.cached_info;
+    
+    // Validate cache age
+    time_t now = time(NULL);
+    if (now - info->last_seen > PS5_CACHE_MAX_AGE) {
+        return PS5_DETECT_ERROR_CACHE_INVALID;
+    }
+    
+    return PS5_DETECT_OK;
+}
+
+int ps5_detector_save_cache(const ps5_info_t *info) {
+    if (!g_detector_ctx.initialized) {
+        return PS5_DETECT_ERROR_NOT_INIT;
+    }
+    
+    if (info == NULL) {
+        return PS5_DETECT_ERROR_INVALID_PARAM;
+    }
+    
+    // Update internal cache
+    memcpy(&g_detector_ctx.cached_info, info, sizeof(ps5_info_t));
+    g_detector_ctx.cache_timestamp = time(NULL);
+    
+    return save_cache_to_file(info);
+}
+
+bool ps5_detector_ping(const char *ip) {
+    if (ip == NULL || !ps5_detector_validate_ip(ip)) {
+        return false;
+    }
+    
     #ifdef TESTING
     // In test mode, simulate success for valid IPs
     return true;
     #endif
     
-    int result = execute_command(cmd, output, sizeof(output));
+    switch (g_ping_backend) {
+        case PING_BACKEND_ICMP_RAW:
+        case PING_BACKEND_ICMP_DGRAM:
+        case PING_BACKEND_TCP:          return ping_socket(ip, g_ping_backend);
+        // ARP answers arrive on the main loop (hedged detection); a blocking check uses TCP
+        case PING_BACKEND_ARP:          return ping_socket(ip, PING_BACKEND_TCP);
+        case PING_BACKEND_COMMAND:      return ping_command(ip);
+        default:                        return false;
+    }
+}
+
+void ps5_detector_handle_arp_result(const char *ip, const char *mac, bool alive) {
+    if (!g_detector_ctx.initialized || ip == NULL) {
+        return;
+    }
     
-    // Check if ping was successful
-    return (result == PS5_DETECT_OK && strstr(output, "1 received") != NULL);
+    snprintf(g_detector_ctx.arp_answer_ip, sizeof(g_detector_ctx.arp_answer_ip), "%s", ip);
+    snprintf(g_detector_ctx.arp_answer_mac, sizeof(g_detector_ctx.arp_answer_mac), "%s",
+             (alive && mac != NULL) ? mac : "");
+    g_detector_ctx.arp_answer = alive ? 1 : -1;
+}
+
+void ps5_detector_set_ping_backend(ping_backend_t backend) {
+    g_ping_backend = backend;
+}
+
+ping_backend_t ps5_detector_get_ping_backend(void) {
+    return g_ping_backend;
 }
 
 int ps5_detector_scan(ps5_info_t *info) {
@@ -506,23 +1219,65 @@ int ps5_detector_scan(ps5_info_t *info) {
     fprintf(stdout, "[PS5Detect] Starting full network scan...\n");
     #endif
     
+    uint64_t start_us = server_clock_monotonic_us();
+    SERVER_TRACE0(scan_start);
+    
     // Try nmap scan
-    int result = scan_network_nmap(info);
+    int result = scan_network_nmap(g_detector_ctx.subnet, info);
     
-    if (result == PS5_DETECT_OK) {
-        // If we found IP, try to get MAC from ARP
-        if (info->mac[0] == '\0') {
-            ps5_info_t arp_info;
-            if (check_arp_table(&arp_info) == PS5_DETECT_OK) {
-                snprintf(info->mac, PS5_MAC_MAX_LEN, "%s", arp_info.mac);
-            }
-        }
-        
-        // Save to cache
-        ps5_detector_save_cache(info);
+    return scan_finish(info, result, start_us);
+}
+
+/**
+ * @brief Fill info for a host that just answered at ip
+ */
+static void fill_alive(ps5_info_t *info, const char *ip, const char *fallback_mac) {
+    snprintf(info->ip, PS5_IP_MAX_LEN, "%s", ip);
+    if (neigh_table_lookup_ip(ip, info->mac, PS5_MAC_MAX_LEN) != NEIGH_OK) {
+        snprintf(info->mac, PS5_MAC_MAX_LEN, "%s", fallback_mac);
+    }
+    info->online = true;
+    info->last_seen = time(NULL);
+}
+
+/**
+ * @brief Ping the caller's last known IP
+ */
+static int check_known_ip(const char *ip, ps5_info_t *info) {
+    if (!ps5_detector_ping(ip)) {
+        return PS5_DETECT_ERROR_NOT_FOUND;
     }
     
-    return result;
+    fill_alive(info, ip, g_detector_ctx.cached_info.mac);
+    return PS5_DETECT_OK;
+}
+
+/**
+ * @brief DHCP lease for the PS5, confirmed with a ping
+ */
+static int check_lease(ps5_info_t *info) {
+    char ip[PS5_IP_MAX_LEN];
+    char mac[PS5_MAC_MAX_LEN];
+    
+    if (find_lease(ip, mac) != PS5_DETECT_OK || !ps5_detector_ping(ip)) {
+        return PS5_DETECT_ERROR_NOT_FOUND;
+    }
+    
+    fill_alive(info, ip, mac);
+    return PS5_DETECT_OK;
+}
+
+/**
+ * @brief Cached entry, confirmed with a ping
+ */
+static int check_cache(ps5_info_t *info) {
+    if (ps5_detector_get_cached(info) != PS5_DETECT_OK || !ps5_detector_ping(info->ip)) {
+        return PS5_DETECT_ERROR_NOT_FOUND;
+    }
+    
+    info->online = true;
+    info->last_seen = time(NULL);
+    return PS5_DETECT_OK;
 }
 
 int ps5_detector_quick_check(const char *cached_ip, ps5_info_t *info) {
@@ -534,24 +1289,391 @@ int ps5_detector_quick_check(const char *cached_ip, ps5_info_t *info) {
         return PS5_DETECT_ERROR_INVALID_PARAM;
     }
     
-    // Step 1: Try cache
-    if (ps5_detector_get_cached(info) == PS5_DETECT_OK) {
-        // Verify with ping
-        if (ps5_detector_ping(info->ip)) {
-            info->online = true;
-            info->last_seen = time(NULL);
+    bool have_ip = (cached_ip != NULL && ps5_detector_validate_ip(cached_ip));
+    
+    detect_method_t order[DETECT_METHOD_COUNT];
+    ps5_detector_get_method_order(order);
+    
+    int result = PS5_DETECT_ERROR_NOT_FOUND;
+    
+    for (int i = 0; i < DETECT_METHOD_COUNT; i++) {
+        detect_method_t method = order[i];
+        
+        if (method == DETECT_METHOD_SCAN) {
+            if (!g_scan_enabled) {
+                continue;
+            }
+            result = ps5_detector_scan(info);    // Records its own stats
+            if (result == PS5_DETECT_OK) {
+                return PS5_DETECT_OK;
+            }
+            continue;
+        }
+        
+        if (method == DETECT_METHOD_PING && !have_ip) {
+            continue;
+        }
+        
+        uint64_t start_us = server_clock_monotonic_us();
+        int ret;
+        switch (method) {
+            case DETECT_METHOD_PING:    ret = check_known_ip(cached_ip, info); break;
+            case DETECT_METHOD_CACHE:   ret = check_cache(info); break;
+            case DETECT_METHOD_ARP:     ret = check_arp_table(info); break;
+            case DETECT_METHOD_LEASE:   ret = check_lease(info); break;
+            default:                    ret = PS5_DETECT_ERROR_NOT_FOUND; break;
+        }
+        record_method(method, ret == PS5_DETECT_OK, server_clock_monotonic_us() - start_us, info);
+        
+        if (ret == PS5_DETECT_OK) {
+            info->method = method;
+            if (method != DETECT_METHOD_CACHE) {
+                ps5_detector_save_cache(info);
+            }
             return PS5_DETECT_OK;
         }
     }
     
-    // Step 2: Try ARP table
-    if (check_arp_table(info) == PS5_DETECT_OK) {
+    return result;
+}
+
+/**
+ * @brief One hedged check, shared by the blocking and coroutine forms
+ */
+typedef struct {
+    liveness_probe_t probes[PS5_HEDGE_MAX_PROBES];
+    int count;
+    uint64_t deadline_us;
+    char lease_mac[PS5_MAC_MAX_LEN];
+    bool found;                 // Neighbour table answered; no probe to wait for
+} hedge_t;
+
+/**
+ * @brief Steps 1-3: start the probes and read the local sources
+ */
+static void hedge_begin(hedge_t *hedge, const char *cached_ip, ps5_info_t *info) {
+    // ping(8) cannot be multiplexed or cancelled
+    ping_backend_t backend = g_ping_backend;
+    if (backend != PING_BACKEND_ICMP_RAW && backend != PING_BACKEND_ICMP_DGRAM) {
+        backend = PING_BACKEND_TCP;
+    }
+    
+    liveness_probe_t *probes = hedge->probes;
+    hedge->count = 0;
+    hedge->found = false;
+    hedge->lease_mac[0] = '\0';
+    hedge->deadline_us = server_clock_monotonic_us() + (uint64_t)PING_TIMEOUT_SEC * 1000000ULL;
+    
+    // 1. Probe the last known addresses
+    if (cached_ip != NULL && ps5_detector_validate_ip(cached_ip)) {
+        probe_start(&probes[hedge->count++], cached_ip, backend, DETECT_METHOD_PING);
+    }
+    
+    ps5_info_t cached;
+    bool have_cached = (ps5_detector_get_cached(&cached) == PS5_DETECT_OK);
+    if (have_cached && (hedge->count == 0 || strcmp(cached.ip, probes[0].ip) != 0)) {
+        probe_start(&probes[hedge->count++], cached.ip, backend, DETECT_METHOD_CACHE);
+    }
+    
+    // ARP who-has to the first of them: a resting console that ignores
+    // the TCP probe still answers ARP
+    if (g_ping_backend == PING_BACKEND_ARP && hedge->count > 0) {
+        const char *mac = (g_detector_ctx.stats_mac[0] != '\0') ? g_detector_ctx.stats_mac :
+                          have_cached ? cached.mac : NULL;
+        char arp_ip[PS5_IP_MAX_LEN];
+        memcpy(arp_ip, probes[0].ip, sizeof(arp_ip));
+        probe_start_arp(&probes[hedge->count++], arp_ip, mac);
+    }
+    
+    // 2. Neighbour table while the probes are in flight
+    if (g_detector_ctx.stats_mac[0] != '\0') {
+        uint64_t arp_start = server_clock_monotonic_us();
+        hedge->found = (check_arp_table(info) == PS5_DETECT_OK);
+        record_method(DETECT_METHOD_ARP, hedge->found, server_clock_monotonic_us() - arp_start, info);
+        if (hedge->found) {
+            info->method = DETECT_METHOD_ARP;
+            return;
+        }
+    }
+    
+    // 3. A lease at a new address gets its own probe
+    char lease_ip[PS5_IP_MAX_LEN];
+    bool probed = false;
+    
+    if (find_lease(lease_ip, hedge->lease_mac) == PS5_DETECT_OK) {
+        for (int i = 0; i < hedge->count; i++) {
+            probed = probed || (strcmp(probes[i].ip, lease_ip) == 0);
+        }
+        if (!probed) {
+            probe_start(&probes[hedge->count++], lease_ip, backend, DETECT_METHOD_LEASE);
+        }
+    }
+}
+
+/**
+ * @brief Step 4: first answer wins; cancel the rest
+ * @param winner Index of the probe that answered, -1 if none
+ * @return true if the PS5 was found
+ */
+static bool hedge_end(hedge_t *hedge, int winner, ps5_info_t *info) {
+    liveness_probe_t *probes = hedge->probes;
+    bool found = hedge->found;
+    
+    uint64_t now = server_clock_monotonic_us();
+    for (int i = 0; i < hedge->count; i++) {
+        if (i == winner) {
+            const char *mac = (probes[i].method == DETECT_METHOD_LEASE) ? hedge->lease_mac :
+                              (probes[i].method == DETECT_METHOD_ARP) ? probes[i].mac :
+                              g_detector_ctx.stats_mac;
+            fill_alive(info, probes[i].ip, mac);
+            info->method = probes[i].method;
+            record_method(probes[i].method, true, now - probes[i].start_us, info);
+            found = true;
+        } else if (probes[i].result == -1 || (winner < 0 && !found)) {
+            record_method(probes[i].method, false, now - probes[i].start_us, info);
+        }
+        probe_cancel(&probes[i]);
+    }
+    hedge->count = 0;
+    
+    if (found && info->method != DETECT_METHOD_CACHE) {
         ps5_detector_save_cache(info);
+    }
+    return found;
+}
+
+int ps5_detector_quick_check_hedged(const char *cached_ip, ps5_info_t *info) {
+    if (!g_detector_ctx.initialized) {
+        return PS5_DETECT_ERROR_NOT_INIT;
+    }
+    
+    if (info == NULL) {
+        return PS5_DETECT_ERROR_INVALID_PARAM;
+    }
+    
+    hedge_t hedge;
+    hedge_begin(&hedge, cached_ip, info);
+    
+    int winner = hedge.found ? -1 : probe_wait_any(hedge.probes, hedge.count, hedge.deadline_us);
+    if (hedge_end(&hedge, winner, info)) {
         return PS5_DETECT_OK;
     }
     
-    // Step 3: Full scan (slow)
-    return ps5_detector_scan(info);
+    // 5. Nothing answered: full scan as the last resort
+    return g_scan_enabled ? ps5_detector_scan(info) : PS5_DETECT_ERROR_NOT_FOUND;
+}
+
+/* ============================================================
+ *  Asynchronous Detection
+ * ============================================================ */
+
+/**
+ * @brief Fallback scan handed to the worker pool (owns its own copy)
+ */
+typedef struct {
+    uint32_t generation;
+    char subnet[PS5_SUBNET_MAX_LEN];
+    uint64_t start_us;
+    ps5_info_t info;
+} scan_job_t;
+
+/**
+ * @brief State of the detection coroutine (everything kept across waits)
+ */
+typedef struct {
+    coro_t co;
+    uint32_t generation;        // Bumped on cancel so a late scan result is dropped
+    char cached_ip[PS5_IP_MAX_LEN];
+    hedge_t hedge;
+    struct pollfd pfds[PS5_HEDGE_MAX_PROBES];
+    int map[PS5_HEDGE_MAX_PROBES];
+    int nfds;
+    int winner;
+    bool scan_done;
+    int result;
+    ps5_info_t info;
+    ps5_detect_callback_t callback;
+    void *user_data;
+} detect_flow_t;
+
+static detect_flow_t g_detect_flow;
+
+static int scan_job_run(void *arg) {
+    scan_job_t *job = (scan_job_t *)arg;
+    return scan_network_nmap(job->subnet, &job->info);
+}
+
+static void scan_job_done(int result, void *arg) {
+    scan_job_t *job = (scan_job_t *)arg;
+    detect_flow_t *flow = &g_detect_flow;
+    
+    if (job->generation == flow->generation && coro_is_running(&flow->co) &&
+        g_detector_ctx.initialized) {
+        flow->info = job->info;
+        flow->result = scan_finish(&flow->info, result, job->start_us);
+        flow->scan_done = true;
+    }
+    
+    free(job);
+}
+
+/**
+ * @brief Queue the fallback scan
+ */
+static int submit_scan(detect_flow_t *flow) {
+    scan_job_t *job = calloc(1, sizeof(scan_job_t));
+    if (job == NULL) {
+        return PS5_DETECT_ERROR_UNKNOWN;
+    }
+    
+    job->generation = flow->generation;
+    snprintf(job->subnet, sizeof(job->subnet), "%s", g_detector_ctx.subnet);
+    job->start_us = server_clock_monotonic_us();
+    flow->scan_done = false;
+    
+    if (worker_pool_submit(scan_job_run, scan_job_done, job, 0) != WORKER_POOL_OK) {
+        free(job);
+        return PS5_DETECT_ERROR_UNKNOWN;
+    }
+    
+    #ifndef TESTING
+    fprintf(stdout, "[PS5Detect] Starting full network scan (background)...\n");
+    #endif
+    SERVER_TRACE0(scan_start);
+    return PS5_DETECT_OK;
+}
+
+/**
+ * @brief Check whether an ARP answer is waiting for one of the hedge's probes
+ */
+static bool hedge_arp_answered(const hedge_t *hedge) {
+    for (int i = 0; i < hedge->count; i++) {
+        if (probe_arp_answered(&hedge->probes[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static coro_status_t detect_flow_run(coro_t *co) {
+    detect_flow_t *flow = (detect_flow_t *)co->arg;
+    
+    CORO_BEGIN(co);
+    
+    hedge_begin(&flow->hedge, flow->cached_ip[0] != '\0' ? flow->cached_ip : NULL, &flow->info);
+    
+    // Wait for the first probe through the main loop's poll set
+    flow->winner = -1;
+    while (!flow->hedge.found) {
+        flow->winner = probe_collect(flow->hedge.probes, flow->hedge.count,
+                                     flow->pfds, flow->map, &flow->nfds);
+        if (flow->winner >= 0 || flow->nfds == 0 || remaining_ms(flow->hedge.deadline_us) == 0) {
+            break;
+        }
+        // An ARP answer may be read by the main loop's arp_prober_process() first
+        CORO_WAIT_FDS_UNTIL(co, flow->pfds, flow->nfds, remaining_ms(flow->hedge.deadline_us),
+                            hedge_arp_answered(&flow->hedge));
+        probe_dispatch(flow->hedge.probes, flow->pfds, flow->map, flow->nfds);
+    }
+    
+    if (hedge_end(&flow->hedge, flow->winner, &flow->info)) {
+        flow->result = PS5_DETECT_OK;
+    } else if (!g_scan_enabled) {
+        flow->result = PS5_DETECT_ERROR_NOT_FOUND;
+    } else if (!worker_pool_is_ready() || submit_scan(flow) != PS5_DETECT_OK) {
+        flow->result = ps5_detector_scan(&flow->info);
+    } else {
+        CORO_WAIT_UNTIL(co, flow->scan_done);
+    }
+    
+    flow->callback(flow->result, &flow->info, flow->user_data);
+    
+    CORO_END(co);
+}
+
+int ps5_detector_detect_start(const char *cached_ip, ps5_detect_callback_t callback,
+                              void *user_data) {
+    if (!g_detector_ctx.initialized) {
+        return PS5_DETECT_ERROR_NOT_INIT;
+    }
+    
+    if (callback == NULL) {
+        return PS5_DETECT_ERROR_INVALID_PARAM;
+    }
+    
+    detect_flow_t *flow = &g_detect_flow;
+    if (coro_is_running(&flow->co)) {
+        return PS5_DETECT_ERROR_BUSY;
+    }
+    
+    snprintf(flow->cached_ip, sizeof(flow->cached_ip), "%s", (cached_ip != NULL) ? cached_ip : "");
+    memset(&flow->info, 0, sizeof(ps5_info_t));
+    flow->hedge.count = 0;
+    flow->result = PS5_DETECT_ERROR_NOT_FOUND;
+    flow->callback = callback;
+    flow->user_data = user_data;
+    flow->generation++;
+    
+    coro_spawn(&flow->co, detect_flow_run, flow);
+    return PS5_DETECT_OK;
+}
+
+bool ps5_detector_detect_in_progress(void) {
+    return coro_is_running(&g_detect_flow.co);
+}
+
+/**
+ * @brief Drop an in-flight detection without calling back
+ */
+static void detect_cancel(void) {
+    detect_flow_t *flow = &g_detect_flow;
+    
+    if (!coro_is_running(&flow->co)) {
+        return;
+    }
+    
+    coro_cancel(&flow->co);
+    for (int i = 0; i < flow->hedge.count; i++) {
+        probe_cancel(&flow->hedge.probes[i]);
+    }
+    flow->hedge.count = 0;
+    flow->generation++;
+}
+
+void ps5_detector_set_lease_file(const char *path) {
+    snprintf(g_lease_file, sizeof(g_lease_file), "%s", (path != NULL) ? path : PS5_LEASE_FILE);
+}
+
+void ps5_detector_set_scan_enabled(bool enabled) {
+    g_scan_enabled = enabled;
+}
+
+void ps5_detector_get_method_order(detect_method_t order[DETECT_METHOD_COUNT]) {
+    double cost[DETECT_METHOD_COUNT];
+    
+    // Insertion sort by expected cost; stable, so ties keep enum order
+    for (int i = 0; i < DETECT_METHOD_COUNT; i++) {
+        detect_method_t method = (detect_method_t)i;
+        double c = method_expected_cost(method);
+        
+        int j = i;
+        while (j > 0 && cost[j - 1] > c) {
+            order[j] = order[j - 1];
+            cost[j] = cost[j - 1];
+            j--;
+        }
+        order[j] = method;
+        cost[j] = c;
+    }
+}
+
+int ps5_detector_get_method_stats(detect_method_t method, detect_method_stats_t *stats) {
+    if (stats == NULL || (int)method < 0 || method >= DETECT_METHOD_COUNT) {
+        return PS5_DETECT_ERROR_INVALID_PARAM;
+    }
+    
+    *stats = g_detector_ctx.method_stats[method];
+    return PS5_DETECT_OK;
 }
 
 int ps5_detector_clear_cache(void) {
@@ -559,7 +1681,15 @@ int ps5_detector_clear_cache(void) {
         return PS5_DETECT_ERROR_NOT_INIT;
     }
     
-    if (unlink(g_detector_ctx.cache_path) != 0 && errno != ENOENT) {
+    if (g_cache_write_busy) {
+        // Remove after the write in flight, or it would bring the file back
+        cache_write_t *remove = (cache_write_t *)calloc(1, sizeof(cache_write_t));
+        if (remove == NULL) {
+            return PS5_DETECT_ERROR_UNKNOWN;
+        }
+        snprintf(remove->path, sizeof(remove->path), "%s", g_detector_ctx.cache_path);
+        submit_cache_write(remove);
+    } else if (unlink(g_detector_ctx.cache_path) != 0 && errno != ENOENT) {
         return PS5_DETECT_ERROR_CACHE_INVALID;
     }
     
@@ -584,6 +1714,7 @@ void ps5_detector_cleanup(void) {
         return;
     }
     
+    detect_cancel();
     memset(&g_detector_ctx, 0, sizeof(ps5_detector_context_t));
     
     #ifndef TESTING
@@ -603,17 +1734,32 @@ const char* ps5_detector_error_string(int error) {
         case PS5_DETECT_ERROR_INVALID_PARAM:    return "Invalid parameter";
         case PS5_DETECT_ERROR_CACHE_INVALID:    return "Cache invalid";
         case PS5_DETECT_ERROR_SCAN_FAILED:      return "Scan failed";
+        case PS5_DETECT_ERROR_BUSY:             return "Detection in progress";
         case PS5_DETECT_ERROR_UNKNOWN:          return "Unknown error";
         default:                                return "Invalid error code";
     }
 }
 
+const char* ps5_detector_ping_backend_string(ping_backend_t backend) {
+    switch (backend) {
+        case PING_BACKEND_NONE:         return "none";
+        case PING_BACKEND_COMMAND:      return "ping";
+        case PING_BACKEND_TCP:          return "tcp";
+        case PING_BACKEND_ICMP_DGRAM:   return "icmp-dgram";
+        case PING_BACKEND_ICMP_RAW:     return "icmp-raw";
+        case PING_BACKEND_ARP:          return "arp";
+        default:                        return "unknown";
+    }
+}
+
 const char* ps5_detector_method_string(detect_method_t method) {
     switch (method) {
         case DETECT_METHOD_CACHE:   return "CACHE";
         case DETECT_METHOD_ARP:     return "ARP";
         case DETECT_METHOD_SCAN:    return "SCAN";
         case DETECT_METHOD_PING:    return "PING";
+        case DETECT_METHOD_LEASE:   return "LEASE";
+        case DETECT_METHOD_PASSIVE: return "PASSIVE";
         default:                    return "UNKNOWN";
     }
 }
@@ -33,6 +33,7 @@ extern "C" {
 #define PS5_DETECT_ERROR_INVALID_PARAM -3
 #define PS5_DETECT_ERROR_CACHE_INVALID -4
 #define PS5_DETECT_ERROR_SCAN_FAILED   -5
+#define PS5_DETECT_ERROR_BUSY          -6
 #define PS5_DETECT_ERROR_UNKNOWN       -99
 
 /* ============================================================
@@ -43,11 +44,25 @@ extern "C" {
 #define PS5_MAC_MAX_LEN     18    /**< Max MAC address length */
 #define PS5_SUBNET_MAX_LEN  32    /**< Max subnet string length */
 #define PS5_CACHE_MAX_AGE   3600  /**< Cache valid for 1 hour (seconds) */
+#define DETECT_METHOD_COUNT 5     /**< Methods tried by the quick check (values below this) */
+#define PS5_LEASE_FILE      "/tmp/dhcp.leases"  /**< Default dnsmasq lease file */
 
 /* ============================================================
  *  Type Definitions
  * ============================================================ */
 
+/**
+ * @brief Detection method
+ */
+typedef enum {
+    DETECT_METHOD_CACHE = 0,    /**< Cache lookup */
+    DETECT_METHOD_ARP,          /**< ARP table query */
+    DETECT_METHOD_SCAN,         /**< Network scan (nmap) */
+    DETECT_METHOD_PING,         /**< Ping check */
+    DETECT_METHOD_LEASE,        /**< DHCP lease lookup, then ping */
+    DETECT_METHOD_PASSIVE,      /**< Passive source: LAN announcement or L2 event (reported by the caller) */
+} detect_method_t;
+
 /**
  * @brief PS5 information structure
  */
@@ -56,17 +71,37 @@ typedef struct {
     char mac[PS5_MAC_MAX_LEN];      /**< MAC address */
     time_t last_seen;                /**< Last seen timestamp */
     bool online;                     /**< Online status */
+    detect_method_t method;          /**< Method that produced this result */
 } ps5_info_t;
 
 /**
- * @brief Detection method
+ * @brief Per-method detection statistics
+ */
+typedef struct {
+    uint32_t attempts;               /**< Times the method was tried */
+    uint32_t hits;                   /**< Times it found the PS5 */
+    uint32_t avg_latency_us;         /**< Smoothed time per attempt */
+} detect_method_stats_t;
+
+/**
+ * @brief Liveness check backend used by ps5_detector_ping()
  */
 typedef enum {
-    DETECT_METHOD_CACHE = 0,    /**< Cache lookup */
-    DETECT_METHOD_ARP,          /**< ARP table query */
-    DETECT_METHOD_SCAN,         /**< Network scan (nmap) */
-    DETECT_METHOD_PING,         /**< Ping check */
-} detect_method_t;
+    PING_BACKEND_NONE = 0,      /**< No liveness check */
+    PING_BACKEND_COMMAND,       /**< Run ping(8) */
+    PING_BACKEND_TCP,           /**< TCP connect; accept or RST means alive */
+    PING_BACKEND_ICMP_DGRAM,    /**< Unprivileged ICMP socket */
+    PING_BACKEND_ICMP_RAW,      /**< Raw ICMP socket (CAP_NET_RAW) */
+    PING_BACKEND_ARP,           /**< ARP who-has via arp_prober next to TCP (CAP_NET_RAW, LAN only) */
+} ping_backend_t;
+
+/**
+ * @brief Completion of ps5_detector_detect_start()
+ * @param result PS5_DETECT_OK if found, negative error code otherwise
+ * @param info Detected PS5 (valid during the call only)
+ * @param user_data User data
+ */
+typedef void (*ps5_detect_callback_t)(int result, const ps5_info_t *info, void *user_data);
 
 /* ============================================================
  *  Public Function Declarations
@@ -88,25 +123,104 @@ int ps5_detector_init(const char *subnet, const char *cache_path);
  * It may take 5-30 seconds depending on network size.
  * 
  * @param info Pointer to store PS5 information
- * @return PS5_DETECT_OK if found, negative error code if not found
+ * @return PS5_DETECT_OK if found, PS5_DETECT_ERROR_NOT_FOUND if the scan
+ *         ran without finding it, PS5_DETECT_ERROR_SCAN_FAILED if nmap
+ *         could not run
  */
 int ps5_detector_scan(ps5_info_t *info);
 
 /**
- * @brief Quick check using cache and ARP (fast)
+ * @brief Quick check, cheapest expected method first
  * 
- * This function first checks cache, then ARP table.
- * Falls back to scan only if needed.
+ * Tries PING (of cached_ip), CACHE, ARP, LEASE and SCAN in order of
+ * expected time-to-answer (average latency / hit rate) learned for this
+ * device on this subnet. With no history the order is PING, CACHE, ARP,
+ * LEASE, SCAN.
+ * The method that answered is stored in info->method.
  * 
- * @param cached_ip Cached IP address (can be NULL)
+ * @param cached_ip Last known IP address (can be NULL)
  * @param info Pointer to store PS5 information
  * @return PS5_DETECT_OK if found, negative error code if not found
  */
 int ps5_detector_quick_check(const char *cached_ip, ps5_info_t *info);
 
+/**
+ * @brief Hedged quick check: all fast sources at once, first answer wins
+ * 
+ * Sends liveness probes to cached_ip and the cached entry, then reads
+ * the neighbour table and the DHCP leases while they are in flight; a
+ * lease for the PS5 at a new address gets a probe of its own. The first
+ * confirmed answer wins and the remaining probes are cancelled, so a
+ * dead cached IP no longer costs a full ping timeout before the other
+ * sources are tried. Neighbour entries count only once the PS5's MAC is
+ * known. Falls back to SCAN (if enabled) when no source answers within
+ * the ping timeout.
+ * 
+ * Probes use the selected ping backend, or TCP connect when that
+ * backend is ping(8) or ARP.
+ * 
+ * @param cached_ip Last known IP address (can be NULL)
+ * @param info Pointer to store PS5 information
+ * @return PS5_DETECT_OK if found, negative error code if not found
+ */
+int ps5_detector_quick_check_hedged(const char *cached_ip, ps5_info_t *info);
+
+/**
+ * @brief Hedged quick check without blocking the main loop
+ * 
+ * Same sources and order as ps5_detector_quick_check_hedged(), run as
+ * a coroutine: the probes are waited on through the main loop's poll
+ * set (coro_sched_run()) and the fallback scan runs on the worker pool,
+ * or inline when the pool is not running. The callback may run before
+ * this returns when no probe has to be waited for.
+ * 
+ * @param cached_ip Last known IP address (can be NULL, copied)
+ * @param callback Completion (required)
+ * @param user_data User data
+ * @return PS5_DETECT_OK if started, PS5_DETECT_ERROR_BUSY if a detection
+ *         is already in flight, negative error code on failure
+ */
+int ps5_detector_detect_start(const char *cached_ip, ps5_detect_callback_t callback,
+                              void *user_data);
+
+/**
+ * @brief Check whether ps5_detector_detect_start() is still in flight
+ * @return true until its callback has run
+ */
+bool ps5_detector_detect_in_progress(void);
+
+/**
+ * @brief Set the DHCP lease file (default PS5_LEASE_FILE)
+ * @param path dnsmasq-format lease file
+ */
+void ps5_detector_set_lease_file(const char *path);
+
+/**
+ * @brief Allow or skip the SCAN step of quick check (default allowed)
+ * @param enabled false while nmap is known to be failing
+ */
+void ps5_detector_set_scan_enabled(bool enabled);
+
+/**
+ * @brief Get the current quick check order
+ * @param order Output array of DETECT_METHOD_COUNT methods
+ */
+void ps5_detector_get_method_order(detect_method_t order[DETECT_METHOD_COUNT]);
+
+/**
+ * @brief Get statistics for one detection method
+ * @param method Detection method
+ * @param stats Output statistics
+ * @return PS5_DETECT_OK on success, negative error code on failure
+ */
+int ps5_detector_get_method_stats(detect_method_t method, detect_method_stats_t *stats);
+
 /**
  * @brief Get cached PS5 information
  * 
+ * Served from memory: the cache file is read once by ps5_detector_init()
+ * and kept in step by save/clear.
+ * 
  * @param info Pointer to store PS5 information
  * @return PS5_DETECT_OK on success, negative error code if cache invalid
  */
@@ -128,6 +242,32 @@ int ps5_detector_save_cache(const ps5_info_t *info);
  */
 bool ps5_detector_ping(const char *ip);
 
+/**
+ * @brief Hand a single-probe arp_prober result to the detection flow
+ *
+ * With the ARP backend the hedged check sends a who-has to the known
+ * address next to its TCP probes; the answer arrives through the
+ * arp_prober callback and wins like any other probe. An answer from a
+ * different MAC than the known one does not count.
+ *
+ * @param ip Probed address
+ * @param mac Answering MAC (ignored when not alive)
+ * @param alive false if the probe timed out
+ */
+void ps5_detector_handle_arp_result(const char *ip, const char *mac, bool alive);
+
+/**
+ * @brief Select the ps5_detector_ping() backend (default COMMAND)
+ * @param backend Backend, kept across cleanup
+ */
+void ps5_detector_set_ping_backend(ping_backend_t backend);
+
+/**
+ * @brief Get the selected ping backend
+ * @return Backend
+ */
+ping_backend_t ps5_detector_get_ping_backend(void);
+
 /**
  * @brief Validate MAC address format
  * 
@@ -171,6 +311,13 @@ void ps5_detector_cleanup(void);
  */
 const char* ps5_detector_error_string(int error);
 
+/**
+ * @brief Convert ping backend to string
+ * @param backend Backend
+ * @return Backend name string
+ */
+const char* ps5_detector_ping_backend_string(ping_backend_t backend);
+
 /**
  * @brief Convert detection method to string
  * 
@@ -7,16 +7,57 @@
 #define _POSIX_C_SOURCE 200112L
 
 #include "ps5_wake.h"
+#include "server_clock.h"
+#include "coroutine.h"
+#include "worker_pool.h"
+#include "fault_inject.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <errno.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 #include <time.h>
 
+#define PS5_REMOTE_PLAY_PORT    9295    // 驗證用 TCP 埠 (休眠模式下會拒絕連線)
+#define WAKE_PROBE_TIMEOUT_MS   1000    // 單次驗證連線等待
+#define WAKE_SETTLE_MS          500     // CEC 命令後等待 PS5 回應
+#define WAKE_VERIFY_INTERVAL_MS 1000    // 驗證間隔
+#define WAKE_RETRY_DELAY_MS     2000    // 重試間隔
+
+// 非同步喚醒流程狀態 (協程跨等待保存的資料都在這裡)
+typedef struct {
+    coro_t co;
+    uint32_t generation;            // 取消後遞增,舊的 CEC 工作結果不再採用
+    char ip[PS5_IP_MAX_LEN];
+    int timeout_sec;
+    int max_retries;
+    int attempt;
+    bool cec_done;
+    int cec_result;
+    uint64_t verify_deadline_us;
+    struct pollfd probe;
+    bool awake;                     // 外部回報的開機訊號 (CEC ON / DDP 200)
+    bool verified;
+    wake_result_t result;
+    ps5_wake_callback_t callback;
+    void *user_data;
+} wake_flow_t;
+
 // 全域變數
 static char g_cec_device[64] = {0};
 static bool g_initialized = false;
+static wake_flow_t g_wake_flow = { .probe = { .fd = -1 } };
+
+#ifdef TESTING
+static int g_test_probe_state = 1;  // 測試模式的模擬連線結果
+#endif
 
 // 內部函數宣告
 static int execute_cec_command(const char *command);
@@ -38,6 +79,11 @@ static int execute_cec_command(const char *command) {
     char full_cmd[256];
     snprintf(full_cmd, sizeof(full_cmd), "cec-ctl -d %s %s", g_cec_device, command);
     
+    FAULT_DELAY(FAULT_POINT_CMD);
+    if (FAULT_FAIL(FAULT_POINT_CMD)) {
+        return -1;
+    }
+    
     int result = system(full_cmd);
     if (WIFEXITED(result)) {
         return WEXITSTATUS(result);
@@ -48,26 +94,79 @@ static int execute_cec_command(const char *command) {
 }
 
 /**
- * Ping 檢查 PS5 是否在線
+ * 開始非阻塞 TCP 連線到 Remote Play 埠
+ * @return 1 在線, 0 連線中 (*fd 有效), -1 不在線
  */
-static bool ping_ps5(const char *ip) {
-    if (ip == NULL) {
-        return false;
+static int probe_connect_start(const char *ip, int *fd) {
+    *fd = -1;
+    
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PS5_REMOTE_PLAY_PORT);
+    if (ip == NULL || inet_pton(AF_INET, ip, &addr.sin_addr) != 1) {
+        return -1;
     }
     
 #ifdef TESTING
-    // 測試模式: 模擬成功
-    return true;
+    // 測試模式: 模擬結果 (預設成功)
+    return g_test_probe_state;
 #else
-    // 實際執行 ping 命令
-    char cmd[128];
-    snprintf(cmd, sizeof(cmd), "ping -c 1 -W 1 %s > /dev/null 2>&1", ip);
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) {
+        return -1;
+    }
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+    
+    if (connect(sock, (struct sockaddr*)&addr, sizeof(addr)) == 0) {
+        close(sock);
+        return 1;
+    }
+    if (errno == EINPROGRESS) {
+        *fd = sock;
+        return 0;
+    }
     
-    int result = system(cmd);
-    return (result == 0);
+    close(sock);
+    return -1;
 #endif
 }
 
+/**
+ * 連線完成後取得結果並關閉 socket
+ */
+static bool probe_connect_finish(int fd) {
+    int err = 0;
+    socklen_t len = sizeof(err);
+    
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0) {
+        err = errno;
+    }
+    close(fd);
+    
+    // 只有接受連線才算開機: 休眠模式的主機也會回 RST
+    return (err == 0);
+}
+
+/**
+ * 檢查 PS5 是否在線 (TCP 連線,最多等待 WAKE_PROBE_TIMEOUT_MS)
+ */
+static bool ping_ps5(const char *ip) {
+    int fd;
+    int state = probe_connect_start(ip, &fd);
+    if (state != 0) {
+        return (state == 1);
+    }
+    
+    struct pollfd pfd = { .fd = fd, .events = POLLOUT };
+    if (poll(&pfd, 1, WAKE_PROBE_TIMEOUT_MS) <= 0) {
+        close(fd);
+        return false;
+    }
+    
+    return probe_connect_finish(fd);
+}
+
 /**
  * 初始化 PS5 喚醒模組
  */
@@ -106,11 +205,7 @@ int ps5_wake_by_cec(void) {
     }
     
     // 短暫延遲,讓 PS5 有時間回應 (500ms)
-    struct timespec sleep_time = {
-        .tv_sec = 0,
-        .tv_nsec = 500000000  // 500ms = 500,000,000 ns
-    };
-    nanosleep(&sleep_time, NULL);
+    server_clock_sleep_ms(500);
     
     return 0;
 }
@@ -123,7 +218,7 @@ bool ps5_wake_verify(const char *ip, int timeout_sec) {
         return false;
     }
     
-    time_t start_time = time(NULL);
+    time_t start_time = server_clock_now();
     time_t current_time;
     
     // 持續 ping 檢查,直到超時
@@ -133,17 +228,13 @@ bool ps5_wake_verify(const char *ip, int timeout_sec) {
         }
         
         // 檢查是否超時
-        current_time = time(NULL);
+        current_time = server_clock_now();
         if ((current_time - start_time) >= timeout_sec) {
             return false;  // 超時
         }
         
         // 等待 1 秒後重試
-        struct timespec sleep_time = {
-            .tv_sec = 1,
-            .tv_nsec = 0
-        };
-        nanosleep(&sleep_time, NULL);
+        server_clock_sleep_ms(1000);
     }
     
     return false;
@@ -203,17 +294,174 @@ wake_result_t ps5_wake_with_retry(const ps5_info_t *info,
         // 如果不是最後一次嘗試,等待後重試
         if (i < max_retries - 1) {
             // 等待 2 秒
-            struct timespec sleep_time = {
-                .tv_sec = 2,
-                .tv_nsec = 0
-            };
-            nanosleep(&sleep_time, NULL);
+            server_clock_sleep_ms(2000);
         }
     }
     
     return result;  // 返回最後一次的結果
 }
 
+/**
+ * 背景執行緒: 發送 CEC 喚醒命令 (cec-ctl 可能阻塞數秒)
+ */
+static int cec_wake_job(void *arg) {
+    (void)arg;
+    return execute_cec_command("--image-view-on");
+}
+
+/**
+ * 主循環: CEC 命令完成
+ */
+static void cec_wake_done(int result, void *arg) {
+    wake_flow_t *flow = &g_wake_flow;
+    
+    // 流程已取消或換了一輪,結果作廢
+    if ((uint32_t)(uintptr_t)arg != flow->generation || !coro_is_running(&flow->co)) {
+        return;
+    }
+    
+    flow->cec_result = result;
+    flow->cec_done = true;
+}
+
+/**
+ * 非同步喚醒流程: CEC 命令 → 等待 → 驗證 → 重試
+ */
+static coro_status_t wake_flow_run(coro_t *co) {
+    wake_flow_t *flow = (wake_flow_t *)co->arg;
+    
+    CORO_BEGIN(co);
+    
+    for (flow->attempt = 0; flow->attempt < flow->max_retries; flow->attempt++) {
+        if (flow->attempt > 0) {
+            CORO_SLEEP_MS(co, WAKE_RETRY_DELAY_MS);
+        }
+        
+        // 1. 發送 CEC 喚醒命令 (工作池不可用時直接執行)
+        flow->cec_done = false;
+        flow->awake = false;
+        if (worker_pool_is_ready() &&
+            worker_pool_submit(cec_wake_job, cec_wake_done,
+                               (void *)(uintptr_t)flow->generation, 0) == WORKER_POOL_OK) {
+            CORO_WAIT_UNTIL(co, flow->cec_done);
+        } else {
+            flow->cec_result = execute_cec_command("--image-view-on");
+        }
+        
+        if (flow->cec_result != 0) {
+            flow->result = WAKE_RESULT_CEC_ERROR;
+            continue;
+        }
+        
+        // 2. 讓 PS5 有時間回應
+        CORO_SLEEP_MS(co, WAKE_SETTLE_MS);
+        
+        // 3. 驗證 PS5 是否成功喚醒,直到超時
+        flow->verified = false;
+        flow->verify_deadline_us = server_clock_monotonic_us() +
+                                   (uint64_t)flow->timeout_sec * 1000000ULL;
+        for (;;) {
+            if (flow->awake) {
+                flow->verified = true;
+                break;
+            }
+            
+            int state = probe_connect_start(flow->ip, &flow->probe.fd);
+            if (state == 0) {
+                flow->probe.events = POLLOUT;
+                CORO_WAIT_FDS(co, &flow->probe, 1, WAKE_PROBE_TIMEOUT_MS);
+                if (coro_timed_out(co)) {
+                    close(flow->probe.fd);
+                } else {
+                    flow->verified = probe_connect_finish(flow->probe.fd);
+                }
+                flow->probe.fd = -1;
+            } else {
+                flow->verified = (state == 1);
+            }
+            
+            if (flow->verified || flow->awake ||
+                server_clock_monotonic_us() >= flow->verify_deadline_us) {
+                break;
+            }
+            CORO_SLEEP_MS(co, WAKE_VERIFY_INTERVAL_MS);
+        }
+        
+        if (flow->verified || flow->awake) {
+            flow->result = WAKE_RESULT_SUCCESS;
+            break;
+        }
+        flow->result = WAKE_RESULT_VERIFY_FAILED;
+    }
+    
+    if (flow->callback != NULL) {
+        flow->callback(flow->result, flow->user_data);
+    }
+    
+    CORO_END(co);
+}
+
+/**
+ * 非同步喚醒
+ */
+int ps5_wake_start(const ps5_info_t *info, int timeout_sec, int max_retries,
+                   ps5_wake_callback_t callback, void *user_data) {
+    if (!g_initialized || info == NULL || timeout_sec <= 0) {
+        return -1;
+    }
+    
+    wake_flow_t *flow = &g_wake_flow;
+    if (coro_is_running(&flow->co)) {
+        return -4;
+    }
+    
+    snprintf(flow->ip, sizeof(flow->ip), "%s", info->ip);
+    flow->timeout_sec = timeout_sec;
+    flow->max_retries = (max_retries > 0) ? max_retries : 1;  // 至少嘗試一次
+    flow->result = WAKE_RESULT_TIMEOUT;
+    flow->probe.fd = -1;
+    flow->callback = callback;
+    flow->user_data = user_data;
+    flow->generation++;
+    
+    coro_spawn(&flow->co, wake_flow_run, flow);
+    return 0;
+}
+
+/**
+ * 回報主機已開機 (CEC 電源狀態 ON 或 DDP 200)
+ */
+void ps5_wake_report_awake(void) {
+    if (coro_is_running(&g_wake_flow.co)) {
+        g_wake_flow.awake = true;
+    }
+}
+
+/**
+ * 是否有非同步喚醒進行中
+ */
+bool ps5_wake_in_progress(void) {
+    return coro_is_running(&g_wake_flow.co);
+}
+
+/**
+ * 取消非同步喚醒
+ */
+void ps5_wake_cancel(void) {
+    wake_flow_t *flow = &g_wake_flow;
+    
+    if (!coro_is_running(&flow->co)) {
+        return;
+    }
+    
+    coro_cancel(&flow->co);
+    if (flow->probe.fd >= 0) {
+        close(flow->probe.fd);
+        flow->probe.fd = -1;
+    }
+    flow->generation++;
+}
+
 /**
  * 取得 CEC 裝置狀態
  */
@@ -234,6 +482,7 @@ bool ps5_wake_is_cec_available(void) {
  * 清理資源
  */
 void ps5_wake_cleanup(void) {
+    ps5_wake_cancel();
     memset(g_cec_device, 0, sizeof(g_cec_device));
     g_initialized = false;
 }
@@ -271,7 +520,18 @@ const char* ps5_wake_error_string(int error) {
             return "CEC device not accessible";
         case -3:
             return "CEC command execution failed";
+        case -4:
+            return "Wake already in progress";
         default:
             return "Unknown error";
     }
 }
+
+#ifdef TESTING
+/**
+ * 測試用: 設定模擬的驗證連線結果 (1 接受, -1 拒絕或無回應)
+ */
+void ps5_wake_test_set_probe_state(int state) {
+    g_test_probe_state = state;
+}
+#endif
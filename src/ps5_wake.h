@@ -22,6 +22,13 @@ typedef enum {
     WAKE_RESULT_NOT_INITIALIZED,  /**< 未初始化 */
 } wake_result_t;
 
+/**
+ * @brief 非同步喚醒完成回調 (在主循環執行)
+ * @param result 喚醒結果
+ * @param user_data 使用者資料
+ */
+typedef void (*ps5_wake_callback_t)(wake_result_t result, void *user_data);
+
 /**
  * @brief 初始化 PS5 喚醒模組
  * @param cec_device CEC 裝置路徑,如 "/dev/cec0"
@@ -62,6 +69,43 @@ wake_result_t ps5_wake_with_retry(const ps5_info_t *info,
                                    int max_retries, 
                                    int timeout_sec);
 
+/**
+ * @brief 非同步喚醒 (不阻塞主循環)
+ *
+ * 與 ps5_wake_with_retry() 相同的流程 (CEC 命令、等待、驗證、重試),
+ * 以協程在主循環上執行: CEC 命令交給背景工作池,驗證以非阻塞 TCP
+ * 連線等待 fd 就緒。主循環需呼叫 coro_sched_run()。
+ *
+ * @param info PS5 資訊 (複製 IP,呼叫後可釋放)
+ * @param timeout_sec 每次驗證超時時間 (秒)
+ * @param max_retries 最大重試次數
+ * @param callback 完成回調 (可為 NULL)
+ * @param user_data 使用者資料
+ * @return 0 成功, -1 未初始化或參數錯誤, -4 已有喚醒進行中
+ */
+int ps5_wake_start(const ps5_info_t *info, int timeout_sec, int max_retries,
+                   ps5_wake_callback_t callback, void *user_data);
+
+/**
+ * @brief 回報主機已開機,讓進行中的驗證立即成功
+ *
+ * 驗證連線只把接受連線視為開機 (休眠模式的主機會拒絕 Remote Play 埠),
+ * 其他確實的開機訊號 (CEC 電源狀態 ON、DDP 200) 由呼叫端回報。
+ * 沒有喚醒進行中時無作用。
+ */
+void ps5_wake_report_awake(void);
+
+/**
+ * @brief 是否有非同步喚醒進行中
+ * @return true 進行中
+ */
+bool ps5_wake_in_progress(void);
+
+/**
+ * @brief 取消進行中的非同步喚醒 (不呼叫回調)
+ */
+void ps5_wake_cancel(void);
+
 /**
  * @brief 取得 CEC 裝置狀態
  * @return true CEC 裝置可用, false 不可用
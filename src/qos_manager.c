@@ -0,0 +1,571 @@
+/**
+ * @file qos_manager.c
+ * @brief QoS Manager Implementation - nftables DSCP marking and tc priority
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "qos_manager.h"
+#include "worker_pool.h"
+#include "fault_inject.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <ctype.h>
+
+// POSIX headers
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define QOS_CMD_BUFFER_SIZE     128
+#define QOS_MAC_LEN             18      // "XX:XX:XX:XX:XX:XX"
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    qos_config_t config;
+    bool initialized;
+    bool active;
+    char active_ip[INET_ADDRSTRLEN];
+} qos_manager_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static qos_manager_context_t g_qos_ctx = {0};
+
+/**
+ * @brief One rule change, handed to the worker pool
+ *
+ * Commands and scripts are built on the main loop; the worker only
+ * feeds them to nft / tc.
+ */
+typedef struct qos_job {
+    bool install;                       // apply (nft, then tc) or remove (tc, then nft)
+    char nft_cmd[QOS_CMD_BUFFER_SIZE];
+    char tc_cmd[QOS_CMD_BUFFER_SIZE];
+    char nft[QOS_SCRIPT_MAX_LEN];
+    char tc[QOS_SCRIPT_MAX_LEN];        // Empty: leave tc alone
+    char ip[INET_ADDRSTRLEN];           // Applied, or active before the remove
+    char mac[QOS_MAC_LEN];
+    int tc_result;                      // Written by the worker
+    struct qos_job *next;
+} qos_job_t;
+
+// Changes run one at a time in submission order; later ones wait here.
+// Kept outside the context: a change may finish after qos_manager_cleanup().
+static bool g_job_busy = false;
+static qos_job_t *g_job_head = NULL;
+static qos_job_t *g_job_tail = NULL;
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+/**
+ * @brief Check IPv4 address format
+ */
+static bool is_valid_ipv4(const char *ip) {
+    struct in_addr addr;
+    return (ip != NULL && inet_pton(AF_INET, ip, &addr) == 1);
+}
+
+/**
+ * @brief Check MAC address format (XX:XX:XX:XX:XX:XX)
+ */
+static bool is_valid_mac(const char *mac) {
+    unsigned int b[6];
+    char tail;
+
+    if (mac == NULL || strlen(mac) != 17) {
+        return false;
+    }
+
+    return (sscanf(mac, "%2x:%2x:%2x:%2x:%2x:%2x%c",
+                   &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &tail) == 6);
+}
+
+/**
+ * @brief Append formatted text to a script buffer
+ */
+static bool script_append(char *buf, size_t size, size_t *len, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static bool script_append(char *buf, size_t size, size_t *len, const char *fmt, ...) {
+    if (*len >= size) {
+        return false;
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf + *len, size - *len, fmt, args);
+    va_end(args);
+
+    if (n < 0 || (size_t)n >= size - *len) {
+        return false;
+    }
+
+    *len += (size_t)n;
+    return true;
+}
+
+/**
+ * @brief Build command line, optionally inside a network namespace
+ */
+static void build_command(const char *tool_cmd, char *cmd, size_t size) {
+    if (g_qos_ctx.config.netns[0] != '\0') {
+        snprintf(cmd, size, "ip netns exec %s %s", g_qos_ctx.config.netns, tool_cmd);
+    } else {
+        snprintf(cmd, size, "%s", tool_cmd);
+    }
+}
+
+/**
+ * @brief Feed a script to a command's stdin
+ */
+static int run_script(const char *cmd, const char *script) {
+    #ifdef TESTING
+    // In test mode, do not touch the host firewall
+    (void)cmd;
+    (void)script;
+    return QOS_OK;
+    #else
+    FAULT_DELAY(FAULT_POINT_CMD);
+    if (FAULT_FAIL(FAULT_POINT_CMD)) {
+        return QOS_ERROR_COMMAND_FAILED;
+    }
+
+    FILE *fp = popen(cmd, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "[QoS] Failed to execute: %s\n", cmd);
+        return QOS_ERROR_COMMAND_FAILED;
+    }
+
+    fputs(script, fp);
+
+    int status = pclose(fp);
+    if (status != 0) {
+        fprintf(stderr, "[QoS] Command failed (%d): %s\n", status, cmd);
+        return QOS_ERROR_COMMAND_FAILED;
+    }
+
+    return QOS_OK;
+    #endif
+}
+
+/**
+ * @brief Run one change (worker thread, or inline without a pool)
+ */
+static int job_run(void *arg) {
+    qos_job_t *job = (qos_job_t *)arg;
+    job->tc_result = QOS_OK;
+
+    if (job->install) {
+        int result = run_script(job->nft_cmd, job->nft);
+        if (result != QOS_OK) {
+            return result;
+        }
+        if (job->tc[0] != '\0') {
+            job->tc_result = run_script(job->tc_cmd, job->tc);
+        }
+        return QOS_OK;
+    }
+
+    if (job->tc[0] != '\0') {
+        job->tc_result = run_script(job->tc_cmd, job->tc);
+    }
+    return run_script(job->nft_cmd, job->nft);
+}
+
+/**
+ * @brief Report a finished change
+ */
+static void job_log(const qos_job_t *job, int result) {
+    #ifndef TESTING
+    if (result != QOS_OK) {
+        fprintf(stderr, "[QoS] Failed to %s prioritization\n", job->install ? "install" : "remove");
+    } else if (job->install) {
+        if (job->tc[0] != '\0' && job->tc_result != QOS_OK) {
+            // DSCP marking is still in place, SQM tins will pick it up
+            fprintf(stderr, "[QoS] tc filter not installed, DSCP marking only\n");
+        }
+        fprintf(stdout, "[QoS] Prioritization active for %s (%s)\n", job->ip, job->mac);
+    } else {
+        fprintf(stdout, "[QoS] Prioritization removed\n");
+    }
+    #else
+    (void)job;
+    (void)result;
+    #endif
+}
+
+static void job_done(int result, void *arg);
+
+/**
+ * @brief Start the next waiting change; without a pool, run them inline
+ */
+static void start_next_job(void) {
+    while (!g_job_busy && g_job_head != NULL) {
+        qos_job_t *job = g_job_head;
+        g_job_head = job->next;
+        if (g_job_head == NULL) {
+            g_job_tail = NULL;
+        }
+        job->next = NULL;
+
+        if (worker_pool_submit(job_run, job_done, job, 0) == WORKER_POOL_OK) {
+            g_job_busy = true;
+            return;
+        }
+
+        job_log(job, job_run(job));
+        free(job);
+    }
+}
+
+/**
+ * @brief Worker pool completion (main loop)
+ *
+ * The state was updated when the change was queued. If it failed and
+ * nothing newer is waiting, put the state back to what is installed.
+ */
+static void job_done(int result, void *arg) {
+    qos_job_t *job = (qos_job_t *)arg;
+    job_log(job, result);
+
+    if (result != QOS_OK && g_job_head == NULL && g_qos_ctx.initialized) {
+        g_qos_ctx.active = !job->install;
+        snprintf(g_qos_ctx.active_ip, sizeof(g_qos_ctx.active_ip), "%s",
+                 job->install ? "" : job->ip);
+    }
+    free(job);
+
+    g_job_busy = false;
+    start_next_job();
+}
+
+/**
+ * @brief Hand a change to the worker pool, or run it here without one
+ * @return QOS_OK if queued, otherwise the result of running it inline
+ */
+static int dispatch_job(qos_job_t *job) {
+    if (g_job_busy || worker_pool_is_ready()) {
+        if (g_job_tail != NULL) {
+            g_job_tail->next = job;
+        } else {
+            g_job_head = job;
+        }
+        g_job_tail = job;
+        start_next_job();
+        return QOS_OK;
+    }
+
+    int result = job_run(job);
+    job_log(job, result);
+    free(job);
+    return result;
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+void qos_manager_default_config(qos_config_t *config) {
+    if (config == NULL) {
+        return;
+    }
+
+    memset(config, 0, sizeof(qos_config_t));
+    config->dscp = QOS_DEFAULT_DSCP;
+    config->tc_prio = QOS_DEFAULT_TC_PRIO;
+}
+
+bool qos_manager_validate_netns(const char *netns) {
+    if (netns == NULL || netns[0] == '\0' ||
+        strcmp(netns, ".") == 0 || strcmp(netns, "..") == 0) {
+        return false;
+    }
+
+    size_t len = 0;
+    for (const char *p = netns; *p != '\0'; p++, len++) {
+        if (!isalnum((unsigned char)*p) && *p != '_' && *p != '.' && *p != '-') {
+            return false;
+        }
+    }
+    return len < QOS_NETNS_MAX_LEN;
+}
+
+int qos_manager_init(const qos_config_t *config) {
+    if (g_qos_ctx.initialized) {
+        return QOS_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    memset(&g_qos_ctx, 0, sizeof(qos_manager_context_t));
+
+    if (config != NULL) {
+        memcpy(&g_qos_ctx.config, config, sizeof(qos_config_t));
+    } else {
+        qos_manager_default_config(&g_qos_ctx.config);
+    }
+
+    if (g_qos_ctx.config.dscp > 63) {
+        return QOS_ERROR_INVALID_PARAM;
+    }
+
+    if (g_qos_ctx.config.netns[0] != '\0' &&
+        !qos_manager_validate_netns(g_qos_ctx.config.netns)) {
+        return QOS_ERROR_INVALID_PARAM;
+    }
+
+    // tc filter needs a target class
+    if (g_qos_ctx.config.tc_iface[0] != '\0' &&
+        strchr(g_qos_ctx.config.tc_classid, ':') == NULL) {
+        return QOS_ERROR_INVALID_PARAM;
+    }
+
+    g_qos_ctx.initialized = true;
+
+    #ifndef TESTING
+    fprintf(stdout, "[QoS] Initialized: dscp=%u, tc=%s, netns=%s\n",
+            g_qos_ctx.config.dscp,
+            g_qos_ctx.config.tc_iface[0] ? g_qos_ctx.config.tc_iface : "off",
+            g_qos_ctx.config.netns[0] ? g_qos_ctx.config.netns : "default");
+    #endif
+
+    return QOS_OK;
+}
+
+int qos_manager_build_ruleset(const char *ip, const char *mac,
+                              char *buf, size_t size) {
+    if (buf == NULL || size == 0) {
+        return QOS_ERROR_INVALID_PARAM;
+    }
+
+    bool has_ip = (ip != NULL && ip[0] != '\0');
+    bool has_mac = (mac != NULL && mac[0] != '\0');
+
+    if ((!has_ip && !has_mac) ||
+        (has_ip && !is_valid_ipv4(ip)) ||
+        (has_mac && !is_valid_mac(mac))) {
+        return QOS_ERROR_INVALID_PARAM;
+    }
+
+    unsigned int dscp = g_qos_ctx.initialized ? g_qos_ctx.config.dscp : QOS_DEFAULT_DSCP;
+    size_t len = 0;
+    bool ok = true;
+
+    // "table + delete table + table {...}" makes the replace a single transaction
+    ok = ok && script_append(buf, size, &len, "table inet %s\n", QOS_TABLE_NAME);
+    ok = ok && script_append(buf, size, &len, "delete table inet %s\n", QOS_TABLE_NAME);
+    ok = ok && script_append(buf, size, &len, "table inet %s {\n", QOS_TABLE_NAME);
+
+    // Upstream: packets from the console
+    ok = ok && script_append(buf, size, &len,
+                             "\tchain prerouting {\n"
+                             "\t\ttype filter hook prerouting priority mangle; policy accept;\n");
+    if (has_mac) {
+        ok = ok && script_append(buf, size, &len,
+                                 "\t\tether saddr %s ip dscp set 0x%02x\n"
+                                 "\t\tether saddr %s ip6 dscp set 0x%02x\n",
+                                 mac, dscp, mac, dscp);
+    }
+    if (has_ip) {
+        ok = ok && script_append(buf, size, &len,
+                                 "\t\tip saddr %s ip dscp set 0x%02x\n", ip, dscp);
+    }
+    ok = ok && script_append(buf, size, &len, "\t}\n");
+
+    // Downstream: packets to the console
+    if (has_ip) {
+        ok = ok && script_append(buf, size, &len,
+                                 "\tchain postrouting {\n"
+                                 "\t\ttype filter hook postrouting priority mangle; policy accept;\n"
+                                 "\t\tip daddr %s ip dscp set 0x%02x\n"
+                                 "\t}\n",
+                                 ip, dscp);
+    }
+
+    ok = ok && script_append(buf, size, &len, "}\n");
+
+    if (!ok) {
+        return QOS_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    return (int)len;
+}
+
+int qos_manager_build_tc_batch(const char *ip, bool install,
+                               char *buf, size_t size) {
+    if (buf == NULL || size == 0) {
+        return QOS_ERROR_INVALID_PARAM;
+    }
+
+    buf[0] = '\0';
+
+    if (!g_qos_ctx.initialized || g_qos_ctx.config.tc_iface[0] == '\0') {
+        return 0;  // tc disabled
+    }
+
+    // Parent qdisc is the major part of the classid ("1:10" -> "1:")
+    char parent[QOS_CLASSID_MAX_LEN];
+    snprintf(parent, sizeof(parent), "%s", g_qos_ctx.config.tc_classid);
+    char *colon = strchr(parent, ':');
+    if (colon == NULL) {
+        return QOS_ERROR_INVALID_PARAM;
+    }
+    colon[1] = '\0';
+
+    size_t len = 0;
+    bool ok;
+
+    if (install) {
+        if (!is_valid_ipv4(ip)) {
+            return QOS_ERROR_INVALID_PARAM;
+        }
+        ok = script_append(buf, size, &len,
+                           "filter replace dev %s parent %s protocol ip prio %u "
+                           "u32 match ip dst %s/32 flowid %s\n",
+                           g_qos_ctx.config.tc_iface, parent,
+                           g_qos_ctx.config.tc_prio, ip,
+                           g_qos_ctx.config.tc_classid);
+    } else {
+        ok = script_append(buf, size, &len,
+                           "filter del dev %s parent %s protocol ip prio %u\n",
+                           g_qos_ctx.config.tc_iface, parent,
+                           g_qos_ctx.config.tc_prio);
+    }
+
+    return ok ? (int)len : QOS_ERROR_BUFFER_TOO_SMALL;
+}
+
+int qos_manager_apply(const char *ip, const char *mac) {
+    if (!g_qos_ctx.initialized) {
+        return QOS_ERROR_NOT_INIT;
+    }
+
+    qos_job_t *job = (qos_job_t *)calloc(1, sizeof(qos_job_t));
+    if (job == NULL) {
+        return QOS_ERROR_UNKNOWN;
+    }
+    job->install = true;
+
+    int len = qos_manager_build_ruleset(ip, mac, job->nft, sizeof(job->nft));
+
+    // tc filter only makes sense with an IP match
+    if (len >= 0 && ip != NULL && ip[0] != '\0') {
+        int tc_len = qos_manager_build_tc_batch(ip, true, job->tc, sizeof(job->tc));
+        if (tc_len < 0) {
+            len = tc_len;
+        }
+    }
+    if (len < 0) {
+        free(job);
+        return len;
+    }
+
+    build_command("nft -f -", job->nft_cmd, sizeof(job->nft_cmd));
+    build_command("tc -batch -", job->tc_cmd, sizeof(job->tc_cmd));
+    snprintf(job->ip, sizeof(job->ip), "%s", (ip != NULL) ? ip : "");
+    snprintf(job->mac, sizeof(job->mac), "%s", (mac != NULL) ? mac : "");
+
+    int result = dispatch_job(job);
+    if (result != QOS_OK) {
+        return result;
+    }
+
+    g_qos_ctx.active = true;
+    snprintf(g_qos_ctx.active_ip, sizeof(g_qos_ctx.active_ip), "%s",
+             (ip != NULL) ? ip : "");
+
+    return QOS_OK;
+}
+
+int qos_manager_remove(void) {
+    if (!g_qos_ctx.initialized) {
+        return QOS_ERROR_NOT_INIT;
+    }
+
+    if (!g_qos_ctx.active) {
+        return QOS_OK;
+    }
+
+    qos_job_t *job = (qos_job_t *)calloc(1, sizeof(qos_job_t));
+    if (job == NULL) {
+        return QOS_ERROR_UNKNOWN;
+    }
+
+    if (g_qos_ctx.active_ip[0] != '\0' &&
+        qos_manager_build_tc_batch(NULL, false, job->tc, sizeof(job->tc)) <= 0) {
+        job->tc[0] = '\0';
+    }
+
+    snprintf(job->nft, sizeof(job->nft),
+             "table inet %s\ndelete table inet %s\n",
+             QOS_TABLE_NAME, QOS_TABLE_NAME);
+
+    build_command("nft -f -", job->nft_cmd, sizeof(job->nft_cmd));
+    build_command("tc -batch -", job->tc_cmd, sizeof(job->tc_cmd));
+    snprintf(job->ip, sizeof(job->ip), "%s", g_qos_ctx.active_ip);
+
+    int result = dispatch_job(job);
+    if (result != QOS_OK) {
+        return result;
+    }
+
+    g_qos_ctx.active = false;
+    g_qos_ctx.active_ip[0] = '\0';
+
+    return QOS_OK;
+}
+
+bool qos_manager_is_active(void) {
+    return g_qos_ctx.active;
+}
+
+const char* qos_manager_get_active_ip(void) {
+    return g_qos_ctx.active_ip;
+}
+
+void qos_manager_cleanup(void) {
+    if (!g_qos_ctx.initialized) {
+        return;
+    }
+
+    qos_manager_remove();
+    memset(&g_qos_ctx, 0, sizeof(qos_manager_context_t));
+
+    #ifndef TESTING
+    fprintf(stdout, "[QoS] Cleaned up\n");
+    #endif
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* qos_manager_error_string(int error) {
+    switch (error) {
+        case QOS_OK:                        return "OK";
+        case QOS_ERROR_NOT_INIT:            return "Not initialized";
+        case QOS_ERROR_INVALID_PARAM:       return "Invalid parameter";
+        case QOS_ERROR_COMMAND_FAILED:      return "Command failed";
+        case QOS_ERROR_BUFFER_TOO_SMALL:    return "Buffer too small";
+        case QOS_ERROR_UNKNOWN:             return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * @file qos_manager.h
+ * @brief QoS Manager - Traffic prioritization for the PS5 console
+ *
+ * Installs DSCP marking (nftables) and an optional tc priority filter
+ * for the console's IP/MAC while it is powered on, and removes them
+ * again when it goes to standby or off.
+ *
+ * All nftables rules live in a private table and are replaced in a
+ * single `nft -f` transaction, so the ruleset is never half-applied.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef QOS_MANAGER_H
+#define QOS_MANAGER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define QOS_OK                          0
+#define QOS_ERROR_NOT_INIT             -1
+#define QOS_ERROR_INVALID_PARAM        -2
+#define QOS_ERROR_COMMAND_FAILED       -3
+#define QOS_ERROR_BUFFER_TOO_SMALL     -4
+#define QOS_ERROR_UNKNOWN              -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define QOS_TABLE_NAME          "gaming_qos"    /**< nftables table name */
+#define QOS_DEFAULT_DSCP        46              /**< EF (Expedited Forwarding) */
+#define QOS_DEFAULT_TC_PRIO     7               /**< tc filter preference */
+#define QOS_IFACE_MAX_LEN       16              /**< Max interface name length */
+#define QOS_NETNS_MAX_LEN       32              /**< Max network namespace name length */
+#define QOS_CLASSID_MAX_LEN     16              /**< Max tc classid length */
+#define QOS_SCRIPT_MAX_LEN      2048            /**< Max generated script length */
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief QoS configuration
+ */
+typedef struct {
+    uint8_t dscp;                           /**< DSCP value to mark (0-63) */
+    char tc_iface[QOS_IFACE_MAX_LEN];       /**< tc interface, empty = no tc filter */
+    char tc_classid[QOS_CLASSID_MAX_LEN];   /**< Priority class (e.g. "1:10") */
+    uint16_t tc_prio;                       /**< tc filter preference */
+    char netns[QOS_NETNS_MAX_LEN];          /**< Network namespace, empty = current */
+} qos_config_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Fill configuration with default values
+ * @param config Configuration to fill
+ */
+void qos_manager_default_config(qos_config_t *config);
+
+/**
+ * @brief Initialize the QoS manager
+ * @param config Configuration (NULL uses defaults)
+ * @return QOS_OK on success, negative error code on failure
+ */
+int qos_manager_init(const qos_config_t *config);
+
+/**
+ * @brief Check a network namespace name
+ *
+ * The name is passed to "ip netns exec" in a shell command, so only
+ * [A-Za-z0-9_.-] is accepted ("." and ".." are not namespaces).
+ *
+ * @param netns Namespace name
+ * @return true if non-empty, shorter than QOS_NETNS_MAX_LEN and safe
+ */
+bool qos_manager_validate_netns(const char *netns);
+
+/**
+ * @brief Install prioritization rules for the console
+ *
+ * Replaces any previously installed rules atomically. Either ip or
+ * mac may be empty, but not both.
+ *
+ * With the worker pool running, nft / tc run there in submission order
+ * and a failure is only logged; without it they run before returning.
+ *
+ * @param ip Console IP address (can be NULL or empty)
+ * @param mac Console MAC address (can be NULL or empty)
+ * @return QOS_OK on success, negative error code on failure
+ */
+int qos_manager_apply(const char *ip, const char *mac);
+
+/**
+ * @brief Remove all prioritization rules (on the worker pool like apply)
+ * @return QOS_OK on success, negative error code on failure
+ */
+int qos_manager_remove(void);
+
+/**
+ * @brief Check if rules are currently installed
+ * @return true if installed, false otherwise
+ */
+bool qos_manager_is_active(void);
+
+/**
+ * @brief Get the IP the active rules were installed for
+ * @return IP string (empty if not active)
+ */
+const char* qos_manager_get_active_ip(void);
+
+/**
+ * @brief Build the nftables ruleset for the console
+ *
+ * The generated script flushes and recreates the private table, so
+ * `nft -f` applies it as one transaction.
+ *
+ * @param ip Console IP address (can be NULL or empty)
+ * @param mac Console MAC address (can be NULL or empty)
+ * @param buf Output buffer
+ * @param size Output buffer size
+ * @return Script length on success, negative error code on failure
+ */
+int qos_manager_build_ruleset(const char *ip, const char *mac,
+                              char *buf, size_t size);
+
+/**
+ * @brief Build the tc batch script for the console
+ * @param ip Console IP address
+ * @param install true to add the filter, false to delete it
+ * @param buf Output buffer
+ * @param size Output buffer size
+ * @return Script length on success (0 if tc is disabled), negative error code on failure
+ */
+int qos_manager_build_tc_batch(const char *ip, bool install,
+                               char *buf, size_t size);
+
+/**
+ * @brief Clean up QoS manager (removes installed rules)
+ */
+void qos_manager_cleanup(void);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* qos_manager_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QOS_MANAGER_H */
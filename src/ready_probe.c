@@ -0,0 +1,272 @@
+/**
+ * @file ready_probe.c
+ * @brief Ready Probe Implementation - Non-blocking TCP connect loop
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "ready_probe.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    bool initialized;
+    uint16_t port;
+    struct sockaddr_in target;
+    ready_probe_state_t state;
+
+    // In-flight attempt
+    int probe_fd;
+    uint64_t attempt_start_us;
+    uint64_t next_attempt_us;
+
+    // Schedule
+    uint32_t delay_ms;
+    uint32_t attempts;
+} ready_probe_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static ready_probe_context_t g_ready_ctx = { .probe_fd = -1 };
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+/**
+ * @brief Close the in-flight attempt socket
+ */
+static void close_probe(void) {
+    if (g_ready_ctx.probe_fd >= 0) {
+        close(g_ready_ctx.probe_fd);
+        g_ready_ctx.probe_fd = -1;
+    }
+}
+
+/**
+ * @brief Start one connect attempt
+ */
+static void start_attempt(uint64_t now_us) {
+    g_ready_ctx.attempts++;
+    g_ready_ctx.attempt_start_us = now_us;
+
+    #ifdef TESTING
+    // In test mode, no network traffic; results are fed via record_result()
+    #else
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        ready_probe_record_result(false);
+        return;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    // RST on close: the console sees an aborted connection, not a session
+    struct linger lg = { .l_onoff = 1, .l_linger = 0 };
+    setsockopt(fd, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg));
+
+    if (connect(fd, (struct sockaddr*)&g_ready_ctx.target, sizeof(g_ready_ctx.target)) == 0) {
+        close(fd);
+        ready_probe_record_result(true);
+        return;
+    }
+
+    if (errno != EINPROGRESS) {
+        close(fd);
+        ready_probe_record_result(false);
+        return;
+    }
+
+    g_ready_ctx.probe_fd = fd;
+    #endif
+}
+
+/**
+ * @brief Check the in-flight attempt for completion
+ */
+static void check_attempt(uint64_t now_us) {
+    struct pollfd pfd = { .fd = g_ready_ctx.probe_fd, .events = POLLOUT };
+
+    if (poll(&pfd, 1, 0) > 0) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(g_ready_ctx.probe_fd, SOL_SOCKET, SO_ERROR, &err, &len);
+
+        close_probe();
+        ready_probe_record_result(err == 0);
+        return;
+    }
+
+    if (now_us - g_ready_ctx.attempt_start_us >= (uint64_t)READY_PROBE_TIMEOUT_MS * 1000ULL) {
+        close_probe();
+        ready_probe_record_result(false);
+    }
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int ready_probe_init(uint16_t port) {
+    if (g_ready_ctx.initialized) {
+        return READY_PROBE_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    memset(&g_ready_ctx, 0, sizeof(ready_probe_context_t));
+    g_ready_ctx.probe_fd = -1;
+    g_ready_ctx.port = (port > 0) ? port : READY_PROBE_DEFAULT_PORT;
+    g_ready_ctx.state = READY_PROBE_IDLE;
+    g_ready_ctx.delay_ms = READY_PROBE_INITIAL_DELAY_MS;
+    g_ready_ctx.initialized = true;
+
+    return READY_PROBE_OK;
+}
+
+int ready_probe_start(const char *ip) {
+    if (!g_ready_ctx.initialized) {
+        return READY_PROBE_ERROR_NOT_INIT;
+    }
+
+    struct sockaddr_in target;
+    memset(&target, 0, sizeof(target));
+    target.sin_family = AF_INET;
+    target.sin_port = htons(g_ready_ctx.port);
+
+    if (ip == NULL || inet_pton(AF_INET, ip, &target.sin_addr) != 1) {
+        return READY_PROBE_ERROR_INVALID_PARAM;
+    }
+
+    close_probe();
+    g_ready_ctx.target = target;
+    g_ready_ctx.state = READY_PROBE_PROBING;
+    g_ready_ctx.delay_ms = READY_PROBE_INITIAL_DELAY_MS;
+    g_ready_ctx.attempts = 0;
+    g_ready_ctx.next_attempt_us = server_clock_monotonic_us();  // First attempt right away
+
+    #ifndef TESTING
+    fprintf(stdout, "[Ready] Waiting for %s:%u to accept\n", ip, g_ready_ctx.port);
+    #endif
+
+    return READY_PROBE_OK;
+}
+
+void ready_probe_stop(void) {
+    close_probe();
+    g_ready_ctx.state = READY_PROBE_IDLE;
+}
+
+ready_probe_state_t ready_probe_process(void) {
+    if (!g_ready_ctx.initialized || g_ready_ctx.state != READY_PROBE_PROBING) {
+        return g_ready_ctx.state;
+    }
+
+    uint64_t now = server_clock_monotonic_us();
+
+    if (g_ready_ctx.probe_fd >= 0) {
+        check_attempt(now);
+    } else if (now >= g_ready_ctx.next_attempt_us) {
+        start_attempt(now);
+    }
+
+    return g_ready_ctx.state;
+}
+
+void ready_probe_record_result(bool accepted) {
+    if (g_ready_ctx.state != READY_PROBE_PROBING) {
+        return;
+    }
+
+    if (accepted) {
+        g_ready_ctx.state = READY_PROBE_READY;
+
+        #ifndef TESTING
+        fprintf(stdout, "[Ready] Remote Play port accepting after %u attempts\n",
+                g_ready_ctx.attempts);
+        #endif
+        return;
+    }
+
+    // Not yet: schedule the next attempt and widen the spacing
+    g_ready_ctx.next_attempt_us = server_clock_monotonic_us() + (uint64_t)g_ready_ctx.delay_ms * 1000ULL;
+    g_ready_ctx.delay_ms *= 2;
+    if (g_ready_ctx.delay_ms > READY_PROBE_MAX_DELAY_MS) {
+        g_ready_ctx.delay_ms = READY_PROBE_MAX_DELAY_MS;
+    }
+}
+
+int ready_probe_get_fd(void) {
+    return g_ready_ctx.probe_fd;
+}
+
+ready_probe_state_t ready_probe_get_state(void) {
+    return g_ready_ctx.state;
+}
+
+uint32_t ready_probe_get_next_delay_ms(void) {
+    return g_ready_ctx.delay_ms;
+}
+
+uint32_t ready_probe_get_attempts(void) {
+    return g_ready_ctx.attempts;
+}
+
+void ready_probe_cleanup(void) {
+    if (!g_ready_ctx.initialized) {
+        return;
+    }
+
+    close_probe();
+    memset(&g_ready_ctx, 0, sizeof(ready_probe_context_t));
+    g_ready_ctx.probe_fd = -1;
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* ready_probe_state_to_string(ready_probe_state_t state) {
+    switch (state) {
+        case READY_PROBE_IDLE:      return "IDLE";
+        case READY_PROBE_PROBING:   return "PROBING";
+        case READY_PROBE_READY:     return "READY";
+        default:                    return "UNKNOWN";
+    }
+}
+
+const char* ready_probe_error_string(int error) {
+    switch (error) {
+        case READY_PROBE_OK:                    return "OK";
+        case READY_PROBE_ERROR_NOT_INIT:        return "Not initialized";
+        case READY_PROBE_ERROR_INVALID_PARAM:   return "Invalid parameter";
+        case READY_PROBE_ERROR_SOCKET:          return "Socket error";
+        case READY_PROBE_ERROR_UNKNOWN:         return "Unknown error";
+        default:                                return "Invalid error code";
+    }
+}
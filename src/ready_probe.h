@@ -0,0 +1,143 @@
+/**
+ * @file ready_probe.h
+ * @brief Ready Probe - Detect when the PS5 Remote Play port accepts
+ *
+ * After the console is "on" (CEC ON + network online), the Remote Play
+ * port usually refuses connections for several more seconds. The probe
+ * repeatedly attempts a non-blocking TCP connect to that port, spacing
+ * attempts exponentially, and reports READY the moment a connection is
+ * accepted. A refused connection (RST) counts as "not yet".
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef READY_PROBE_H
+#define READY_PROBE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define READY_PROBE_OK                  0
+#define READY_PROBE_ERROR_NOT_INIT     -1
+#define READY_PROBE_ERROR_INVALID_PARAM -2
+#define READY_PROBE_ERROR_SOCKET       -3
+#define READY_PROBE_ERROR_UNKNOWN      -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define READY_PROBE_DEFAULT_PORT        9295    /**< PS5 Remote Play */
+#define READY_PROBE_INITIAL_DELAY_MS    250     /**< First retry spacing */
+#define READY_PROBE_MAX_DELAY_MS        4000    /**< Spacing cap */
+#define READY_PROBE_TIMEOUT_MS          1000    /**< Per-attempt timeout */
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Probe state
+ */
+typedef enum {
+    READY_PROBE_IDLE = 0,           /**< Not probing */
+    READY_PROBE_PROBING,            /**< Waiting for the port to accept */
+    READY_PROBE_READY,              /**< Port accepted a connection */
+} ready_probe_state_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Initialize the ready probe
+ * @param port Target port (0 uses READY_PROBE_DEFAULT_PORT)
+ * @return READY_PROBE_OK on success, negative error code on failure
+ */
+int ready_probe_init(uint16_t port);
+
+/**
+ * @brief Start probing an address (restarts the spacing schedule)
+ * @param ip Console IPv4 address
+ * @return READY_PROBE_OK on success, negative error code on failure
+ */
+int ready_probe_start(const char *ip);
+
+/**
+ * @brief Stop probing and return to IDLE
+ */
+void ready_probe_stop(void);
+
+/**
+ * @brief Drive the probe (non-blocking, call from the main loop)
+ * @return Current probe state
+ */
+ready_probe_state_t ready_probe_process(void);
+
+/**
+ * @brief Record the outcome of one attempt
+ *
+ * Used by process(); exposed so the schedule can be tested offline.
+ *
+ * @param accepted true if the port accepted the connection
+ */
+void ready_probe_record_result(bool accepted);
+
+/**
+ * @brief Get the in-flight attempt's socket, for the caller's poll set (POLLOUT)
+ * @return File descriptor, -1 if no attempt is in flight
+ */
+int ready_probe_get_fd(void);
+
+/**
+ * @brief Get the probe state
+ * @return Probe state
+ */
+ready_probe_state_t ready_probe_get_state(void);
+
+/**
+ * @brief Delay before the next attempt
+ * @return Delay in milliseconds
+ */
+uint32_t ready_probe_get_next_delay_ms(void);
+
+/**
+ * @brief Attempts made since start
+ * @return Attempt count
+ */
+uint32_t ready_probe_get_attempts(void);
+
+/**
+ * @brief Clean up ready probe resources
+ */
+void ready_probe_cleanup(void);
+
+/**
+ * @brief Convert probe state to string
+ * @param state Probe state
+ * @return State string
+ */
+const char* ready_probe_state_to_string(ready_probe_state_t state);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* ready_probe_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* READY_PROBE_H */
@@ -0,0 +1,529 @@
+/**
+ * @file self_bench.c
+ * @brief Self Benchmark Implementation
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "self_bench.h"
+#include "cec_monitor.h"
+#include "neigh_table.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+// Third-party
+#include <cjson/cJSON.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define BENCH_SLOW_SPAWN_US     20000   // Fork this slow means a weak CPU: halve probes in flight
+#define BENCH_WAKEUP_GAP_NS     1000000 // Writer pause between loop wakeups (1 ms)
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef bool (*bench_fn_t)(void *arg);
+
+typedef struct {
+    const char *ip;
+    uint16_t port;
+} tcp_target_t;
+
+typedef struct {
+    int fd;
+    int count;
+} wakeup_writer_t;
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t round_up(uint32_t value, uint32_t step) {
+    return ((value + step - 1) / step) * step;
+}
+
+static uint32_t clamp_u32(uint32_t value, uint32_t lo, uint32_t hi) {
+    return (value < lo) ? lo : (value > hi) ? hi : value;
+}
+
+/**
+ * @brief Time `count` calls of fn; failed calls are counted, not timed
+ */
+static void measure(bench_fn_t fn, void *arg, int count, self_bench_timing_t *timing) {
+    uint32_t samples[SELF_BENCH_MAX_SAMPLES];
+    uint32_t failures = 0;
+    int n = 0;
+
+    if (count > SELF_BENCH_MAX_SAMPLES) {
+        count = SELF_BENCH_MAX_SAMPLES;
+    }
+
+    for (int i = 0; i < count; i++) {
+        uint64_t start = server_clock_monotonic_us();
+        bool ok = fn(arg);
+        uint64_t elapsed = server_clock_monotonic_us() - start;
+
+        if (ok) {
+            samples[n++] = (uint32_t)elapsed;
+        } else {
+            failures++;
+        }
+    }
+
+    self_bench_summarize(samples, n, failures, timing);
+}
+
+/* ============================================================
+ *  Measurements
+ * ============================================================ */
+
+#ifndef TESTING
+static bool bench_spawn(void *arg) {
+    (void)arg;
+    FILE *fp = popen("exit 0", "r");
+    return (fp != NULL && pclose(fp) == 0);
+}
+
+static bool bench_cec(void *arg) {
+    (void)arg;
+    return (cec_monitor_query_state(NULL) == CEC_OK);
+}
+
+static bool bench_icmp(void *arg) {
+    return ps5_detector_ping((const char *)arg);
+}
+
+/**
+ * @brief One non-blocking connect; a handshake or a RST both mean the host answered
+ */
+static bool bench_tcp(void *arg) {
+    const tcp_target_t *target = (const tcp_target_t *)arg;
+    struct sockaddr_in addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(target->port);
+    if (inet_pton(AF_INET, target->ip, &addr.sin_addr) != 1) {
+        return false;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool answered = false;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+        answered = true;
+    } else if (errno == ECONNREFUSED) {
+        answered = true;
+    } else if (errno == EINPROGRESS) {
+        struct pollfd pfd = { .fd = fd, .events = POLLOUT };
+        if (poll(&pfd, 1, SELF_BENCH_PROBE_TIMEOUT_MS) == 1) {
+            int err = 0;
+            socklen_t len = sizeof(err);
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len);
+            answered = (err == 0 || err == ECONNREFUSED);
+        }
+    }
+
+    close(fd);
+    return answered;
+}
+
+static bool bench_neigh(void *arg) {
+    (void)arg;
+    neigh_entry_t entries[NEIGH_MAX_ENTRIES];
+    return (neigh_table_dump(entries, NEIGH_MAX_ENTRIES) >= 0);
+}
+
+/**
+ * @brief Writer thread: each write carries its own send timestamp
+ */
+static void* wakeup_writer(void *arg) {
+    const wakeup_writer_t *writer = (const wakeup_writer_t *)arg;
+    struct timespec gap = { .tv_sec = 0, .tv_nsec = BENCH_WAKEUP_GAP_NS };
+
+    for (int i = 0; i < writer->count; i++) {
+        nanosleep(&gap, NULL);
+        uint64_t sent = server_clock_monotonic_us();
+        if (write(writer->fd, &sent, sizeof(sent)) != (ssize_t)sizeof(sent)) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Time from a pipe write on another thread to poll() returning here
+ */
+static void bench_loop_wakeup(int count, self_bench_timing_t *timing) {
+    uint32_t samples[SELF_BENCH_MAX_SAMPLES];
+    uint32_t failures = 0;
+    int n = 0;
+    int pipefd[2];
+
+    if (count > SELF_BENCH_MAX_SAMPLES) {
+        count = SELF_BENCH_MAX_SAMPLES;
+    }
+
+    if (pipe(pipefd) != 0) {
+        self_bench_summarize(samples, 0, (uint32_t)count, timing);
+        return;
+    }
+
+#ifndef TESTING
+    wakeup_writer_t writer = { .fd = pipefd[1], .count = count };
+    pthread_t thread;
+    bool threaded = (pthread_create(&thread, NULL, wakeup_writer, &writer) == 0);
+#else
+    bool threaded = false;
+#endif
+
+    for (int i = 0; i < count; i++) {
+        uint64_t sent;
+
+        if (!threaded) {
+            // Same-thread fallback: measures the syscall path only
+            sent = server_clock_monotonic_us();
+            if (write(pipefd[1], &sent, sizeof(sent)) != (ssize_t)sizeof(sent)) {
+                failures++;
+                continue;
+            }
+        }
+
+        struct pollfd pfd = { .fd = pipefd[0], .events = POLLIN };
+        if (poll(&pfd, 1, SELF_BENCH_PROBE_TIMEOUT_MS) != 1 ||
+            read(pipefd[0], &sent, sizeof(sent)) != (ssize_t)sizeof(sent)) {
+            failures++;
+            continue;
+        }
+
+        samples[n++] = (uint32_t)(server_clock_monotonic_us() - sent);
+    }
+
+#ifndef TESTING
+    if (threaded) {
+        pthread_join(thread, NULL);
+    }
+#endif
+
+    close(pipefd[0]);
+    close(pipefd[1]);
+    self_bench_summarize(samples, n, failures, timing);
+}
+
+/**
+ * @brief How late poll() comes back from a 1 ms timeout
+ */
+static void bench_timer_slack(int count, self_bench_timing_t *timing) {
+    uint32_t samples[SELF_BENCH_MAX_SAMPLES];
+
+    if (count > SELF_BENCH_MAX_SAMPLES) {
+        count = SELF_BENCH_MAX_SAMPLES;
+    }
+
+    for (int i = 0; i < count; i++) {
+        uint64_t start = server_clock_monotonic_us();
+        poll(NULL, 0, 1);
+        uint64_t elapsed = server_clock_monotonic_us() - start;
+        samples[i] = (elapsed > 1000) ? (uint32_t)(elapsed - 1000) : 0;
+    }
+
+    self_bench_summarize(samples, count, 0, timing);
+}
+
+/**
+ * @brief A message shaped like the ps5_status reply
+ */
+static cJSON* build_status_message(void) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "type", "ps5_status");
+    cJSON_AddStringToObject(root, "status", "on");
+    cJSON_AddStringToObject(root, "ip", "192.168.1.123");
+    cJSON_AddStringToObject(root, "mac", "a8:47:4a:12:34:56");
+    cJSON_AddStringToObject(root, "cec", "on");
+    cJSON_AddBoolToObject(root, "online", true);
+
+    cJSON *link = cJSON_AddObjectToObject(root, "link");
+    cJSON_AddNumberToObject(link, "rtt_ms", 1.25);
+    cJSON_AddNumberToObject(link, "jitter_ms", 0.31);
+    cJSON_AddNumberToObject(link, "loss", 0);
+
+    cJSON_AddNumberToObject(root, "timestamp", 1792300800);
+    return root;
+}
+
+static void bench_json(self_bench_report_t *report) {
+    uint64_t start = server_clock_monotonic_us();
+    for (int i = 0; i < SELF_BENCH_JSON_ITERATIONS; i++) {
+        cJSON *root = build_status_message();
+        char *json = cJSON_PrintUnformatted(root);
+        cJSON_free(json);
+        cJSON_Delete(root);
+    }
+    uint64_t encode_us = server_clock_monotonic_us() - start;
+
+    cJSON *root = build_status_message();
+    char *json = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (json == NULL) {
+        return;
+    }
+    report->json_bytes = (uint32_t)strlen(json);
+
+    start = server_clock_monotonic_us();
+    for (int i = 0; i < SELF_BENCH_JSON_ITERATIONS; i++) {
+        cJSON *parsed = cJSON_Parse(json);
+        (void)cJSON_GetObjectItem(parsed, "type");
+        cJSON_Delete(parsed);
+    }
+    uint64_t decode_us = server_clock_monotonic_us() - start;
+    cJSON_free(json);
+
+    if (encode_us > 0) {
+        report->json_encode_per_sec = SELF_BENCH_JSON_ITERATIONS * 1e6 / (double)encode_us;
+    }
+    if (decode_us > 0) {
+        report->json_decode_per_sec = SELF_BENCH_JSON_ITERATIONS * 1e6 / (double)decode_us;
+    }
+}
+
+static void add_timing(cJSON *parent, const char *name, const self_bench_timing_t *timing) {
+    cJSON *entry = cJSON_AddObjectToObject(parent, name);
+    cJSON_AddNumberToObject(entry, "samples", timing->samples);
+    cJSON_AddNumberToObject(entry, "failures", timing->failures);
+    cJSON_AddNumberToObject(entry, "min_us", timing->min_us);
+    cJSON_AddNumberToObject(entry, "avg_us", timing->avg_us);
+    cJSON_AddNumberToObject(entry, "p90_us", timing->p90_us);
+    cJSON_AddNumberToObject(entry, "max_us", timing->max_us);
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int self_bench_run(const self_bench_config_t *config, self_bench_report_t *report) {
+    if (report == NULL) {
+        return SELF_BENCH_ERROR_INVALID_PARAM;
+    }
+
+    self_bench_config_t defaults = {0};
+    if (config == NULL) {
+        config = &defaults;
+    }
+
+    int samples = (config->samples > 0) ? config->samples : SELF_BENCH_DEFAULT_SAMPLES;
+    uint64_t start = server_clock_monotonic_us();
+
+    memset(report, 0, sizeof(self_bench_report_t));
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    report->cpus = (cpus > 0) ? (int)cpus : 1;
+
+    bool have_target = (config->target_ip != NULL && ps5_detector_validate_ip(config->target_ip));
+    if (have_target) {
+        snprintf(report->target_ip, sizeof(report->target_ip), "%s", config->target_ip);
+    }
+
+#ifndef TESTING
+    measure(bench_spawn, NULL, samples, &report->spawn);
+
+    if (config->cec_available) {
+        measure(bench_cec, NULL, samples, &report->cec);
+    }
+
+    if (have_target && config->icmp_backend != PING_BACKEND_NONE) {
+        ping_backend_t saved = ps5_detector_get_ping_backend();
+        ps5_detector_set_ping_backend(config->icmp_backend);
+        measure(bench_icmp, (void *)config->target_ip, samples, &report->icmp);
+        ps5_detector_set_ping_backend(saved);
+    }
+
+    if (have_target) {
+        tcp_target_t target = {
+            .ip = config->target_ip,
+            .port = (config->tcp_port != 0) ? config->tcp_port : SELF_BENCH_TCP_PORT
+        };
+        measure(bench_tcp, &target, samples, &report->tcp);
+    }
+
+    measure(bench_neigh, NULL, samples, &report->neigh);
+#else
+    (void)measure;
+    (void)samples;
+#endif
+
+    bench_json(report);
+    bench_loop_wakeup(SELF_BENCH_LOOP_SAMPLES, &report->loop_wakeup);
+    bench_timer_slack(SELF_BENCH_LOOP_SAMPLES, &report->timer_slack);
+
+    self_bench_recommend(report);
+    report->elapsed_ms = (uint32_t)((server_clock_monotonic_us() - start) / 1000);
+
+    return SELF_BENCH_OK;
+}
+
+void self_bench_summarize(uint32_t *samples, int count, uint32_t failures,
+                          self_bench_timing_t *timing) {
+    if (timing == NULL) {
+        return;
+    }
+
+    memset(timing, 0, sizeof(self_bench_timing_t));
+    timing->failures = failures;
+
+    if (samples == NULL || count <= 0) {
+        return;
+    }
+
+    qsort(samples, (size_t)count, sizeof(uint32_t), compare_u32);
+
+    uint64_t sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+
+    timing->samples = (uint32_t)count;
+    timing->min_us = samples[0];
+    timing->max_us = samples[count - 1];
+    timing->avg_us = (uint32_t)(sum / (uint64_t)count);
+    timing->p90_us = samples[((count * 90 + 99) / 100) - 1];
+}
+
+void self_bench_recommend(self_bench_report_t *report) {
+    if (report == NULL) {
+        return;
+    }
+
+    self_bench_recommend_t *rec = &report->recommend;
+
+    // Main loop: an idle wakeup should cost under 0.1% of the interval,
+    // and the interval should be ten times the timer's lateness
+    if (report->loop_wakeup.samples > 0) {
+        uint32_t cpu_ms = report->loop_wakeup.avg_us;           // avg_us / (ms * 1000) <= 0.001
+        uint32_t slack_ms = report->timer_slack.p90_us / 100;   // 10 * p90_us / 1000
+        uint32_t ms = (cpu_ms > slack_ms) ? cpu_ms : slack_ms;
+        rec->main_loop_interval_ms = clamp_u32(round_up(ms, 50),
+                                               SELF_BENCH_DEFAULT_LOOP_MS / 2, 1000);
+    } else {
+        rec->main_loop_interval_ms = SELF_BENCH_DEFAULT_LOOP_MS;
+    }
+
+    // CEC: a query may keep the bus busy at most 10% of the time
+    if (report->cec.samples > 0) {
+        rec->cec_poll_interval_ms = clamp_u32(round_up(report->cec.p90_us / 100, 250),
+                                              500, 10000);
+    } else {
+        rec->cec_poll_interval_ms = SELF_BENCH_DEFAULT_CEC_POLL_MS;
+    }
+
+    // Liveness probes: four slow round trips between probes
+    uint32_t rtt_us = report->icmp.p90_us;
+    if (report->tcp.p90_us > rtt_us) {
+        rtt_us = report->tcp.p90_us;
+    }
+    if (report->icmp.samples > 0 || report->tcp.samples > 0) {
+        rec->probe_interval_ms = clamp_u32(round_up(rtt_us * 4 / 1000, 250), 250, 5000);
+    } else {
+        rec->probe_interval_ms = SELF_BENCH_DEFAULT_PROBE_MS;
+    }
+
+    // Probes in flight: two per CPU, halved where spawning is slow
+    uint32_t in_flight = (uint32_t)((report->cpus > 0) ? report->cpus : 1) * 2;
+    if (report->spawn.samples > 0 && report->spawn.avg_us > BENCH_SLOW_SPAWN_US) {
+        in_flight /= 2;
+    }
+    rec->probes_in_flight = clamp_u32(in_flight, 1, SELF_BENCH_MAX_IN_FLIGHT);
+}
+
+char* self_bench_report_to_json(const self_bench_report_t *report) {
+    if (report == NULL) {
+        return NULL;
+    }
+
+    cJSON *root = cJSON_CreateObject();
+    if (root == NULL) {
+        return NULL;
+    }
+
+    cJSON *system = cJSON_AddObjectToObject(root, "system");
+    cJSON_AddNumberToObject(system, "cpus", report->cpus);
+    cJSON_AddStringToObject(system, "ping_backend",
+                            ps5_detector_ping_backend_string(ps5_detector_get_ping_backend()));
+    cJSON_AddStringToObject(system, "cec_backend", cec_backend_to_string(cec_monitor_get_backend()));
+    cJSON_AddStringToObject(system, "neigh_backend", neigh_backend_to_string(neigh_table_get_backend()));
+
+    if (report->target_ip[0] != '\0') {
+        cJSON_AddStringToObject(root, "target", report->target_ip);
+    } else {
+        cJSON_AddNullToObject(root, "target");
+    }
+
+    add_timing(root, "spawn", &report->spawn);
+    add_timing(root, "cec", &report->cec);
+    add_timing(root, "icmp", &report->icmp);
+    add_timing(root, "tcp", &report->tcp);
+    add_timing(root, "neigh", &report->neigh);
+
+    cJSON *json = cJSON_AddObjectToObject(root, "json");
+    cJSON_AddNumberToObject(json, "message_bytes", report->json_bytes);
+    cJSON_AddNumberToObject(json, "encode_per_sec", report->json_encode_per_sec);
+    cJSON_AddNumberToObject(json, "decode_per_sec", report->json_decode_per_sec);
+
+    cJSON *loop = cJSON_AddObjectToObject(root, "loop");
+    add_timing(loop, "wakeup", &report->loop_wakeup);
+    add_timing(loop, "timer_slack", &report->timer_slack);
+
+    cJSON *rec = cJSON_AddObjectToObject(root, "recommended");
+    cJSON_AddNumberToObject(rec, "main_loop_interval_ms", report->recommend.main_loop_interval_ms);
+    cJSON_AddNumberToObject(rec, "cec_poll_interval_ms", report->recommend.cec_poll_interval_ms);
+    cJSON_AddNumberToObject(rec, "probe_interval_ms", report->recommend.probe_interval_ms);
+    cJSON_AddNumberToObject(rec, "probes_in_flight", report->recommend.probes_in_flight);
+
+    cJSON_AddNumberToObject(root, "elapsed_ms", report->elapsed_ms);
+
+    char *out = cJSON_Print(root);
+    cJSON_Delete(root);
+    return out;
+}
+
+const char* self_bench_error_string(int error) {
+    switch (error) {
+        case SELF_BENCH_OK:                     return "OK";
+        case SELF_BENCH_ERROR_INVALID_PARAM:    return "Invalid parameter";
+        case SELF_BENCH_ERROR_UNKNOWN:          return "Unknown error";
+        default:                                return "Invalid error code";
+    }
+}
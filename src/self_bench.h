@@ -0,0 +1,175 @@
+/**
+ * @file self_bench.h
+ * @brief Self Benchmark - Measure the target and suggest tunables
+ *
+ * Run by `gaming-server --bench` on the router itself. Each measurement
+ * is repeated and summarized (min / avg / p90 / max in microseconds):
+ *
+ *   spawn        popen("exit 0") + pclose (the cec-ctl / nmap / ping path)
+ *   cec          one power status query on the selected CEC backend
+ *   icmp         one echo to the cached console (ICMP datagram or raw)
+ *   tcp          one connect to the console's Remote Play port (RST counts)
+ *   neigh        one neighbour table dump on the selected backend
+ *   loop_wakeup  another thread writes a pipe until poll() returns
+ *   timer_slack  how late poll() returns from a 1 ms timeout
+ *
+ * plus cJSON encode and decode throughput for a status-sized message.
+ * The report is printed as JSON together with recommended polling
+ * intervals and probes in flight derived from the numbers.
+ *
+ * Measurements that need the console are skipped when no address is
+ * known; those that need hardware the box lacks report zero samples.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef SELF_BENCH_H
+#define SELF_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ps5_detector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define SELF_BENCH_OK                   0
+#define SELF_BENCH_ERROR_INVALID_PARAM -2
+#define SELF_BENCH_ERROR_UNKNOWN       -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define SELF_BENCH_DEFAULT_SAMPLES      10      /**< Samples per slow measurement */
+#define SELF_BENCH_LOOP_SAMPLES         200     /**< Samples for loop wakeup / timer slack */
+#define SELF_BENCH_MAX_SAMPLES          256
+#define SELF_BENCH_JSON_ITERATIONS      2000    /**< Encode + decode rounds */
+#define SELF_BENCH_PROBE_TIMEOUT_MS     1000    /**< Per TCP probe */
+#define SELF_BENCH_TCP_PORT             9295    /**< PS5 Remote Play */
+
+// Defaults reported when a measurement has no samples
+#define SELF_BENCH_DEFAULT_LOOP_MS      100
+#define SELF_BENCH_DEFAULT_CEC_POLL_MS  1000
+#define SELF_BENCH_DEFAULT_PROBE_MS     1000
+#define SELF_BENCH_MAX_IN_FLIGHT        8
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Summary of one repeated measurement
+ */
+typedef struct {
+    uint32_t samples;           /**< Successful samples */
+    uint32_t failures;          /**< Attempts that failed (not in the timings) */
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p90_us;
+    uint32_t max_us;
+} self_bench_timing_t;
+
+/**
+ * @brief Values suggested from the measurements
+ */
+typedef struct {
+    uint32_t main_loop_interval_ms;     /**< Idle wakeups stay under 0.1% CPU */
+    uint32_t cec_poll_interval_ms;      /**< CEC bus busy at most 10% of the time */
+    uint32_t probe_interval_ms;         /**< Liveness probe spacing */
+    uint32_t probes_in_flight;          /**< Concurrent probes for sweeps and hedging */
+} self_bench_recommend_t;
+
+/**
+ * @brief Full report
+ */
+typedef struct {
+    char target_ip[46];                 /**< Console probed ("" if none known) */
+    int cpus;                           /**< Online CPUs */
+
+    self_bench_timing_t spawn;
+    self_bench_timing_t cec;
+    self_bench_timing_t icmp;
+    self_bench_timing_t tcp;
+    self_bench_timing_t neigh;
+    self_bench_timing_t loop_wakeup;
+    self_bench_timing_t timer_slack;
+
+    uint32_t json_bytes;                /**< Size of the encoded test message */
+    double json_encode_per_sec;
+    double json_decode_per_sec;
+
+    self_bench_recommend_t recommend;
+    uint32_t elapsed_ms;                /**< Time the whole run took */
+} self_bench_report_t;
+
+/**
+ * @brief Run options
+ */
+typedef struct {
+    const char *target_ip;              /**< Cached console address (NULL skips icmp/tcp) */
+    ping_backend_t icmp_backend;        /**< ICMP_DGRAM or ICMP_RAW (NONE skips icmp) */
+    uint16_t tcp_port;                  /**< 0 uses SELF_BENCH_TCP_PORT */
+    int samples;                        /**< 0 uses SELF_BENCH_DEFAULT_SAMPLES */
+    bool cec_available;                 /**< CEC monitor initialized (otherwise skipped) */
+} self_bench_config_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Run every measurement and fill in the recommendations
+ *
+ * Blocks for a few seconds; meant for the --bench mode, not the daemon.
+ * Uses whatever ping / CEC / neighbour backends are selected.
+ *
+ * @param config Run options (NULL for defaults)
+ * @param report Output report
+ * @return SELF_BENCH_OK on success, negative error code on failure
+ */
+int self_bench_run(const self_bench_config_t *config, self_bench_report_t *report);
+
+/**
+ * @brief Summarize raw samples
+ * @param samples Durations in microseconds (reordered in place)
+ * @param count Number of samples
+ * @param failures Failed attempts to record
+ * @param timing Output summary
+ */
+void self_bench_summarize(uint32_t *samples, int count, uint32_t failures,
+                          self_bench_timing_t *timing);
+
+/**
+ * @brief Derive the recommendations from the measurements in a report
+ * @param report Report with measurements filled in
+ */
+void self_bench_recommend(self_bench_report_t *report);
+
+/**
+ * @brief Encode a report as JSON
+ * @param report Report to encode
+ * @return JSON string (free with cJSON_free), NULL on failure
+ */
+char* self_bench_report_to_json(const self_bench_report_t *report);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* self_bench_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SELF_BENCH_H */
@@ -0,0 +1,80 @@
+/**
+ * @file server_clock.c
+ * @brief Server Clock Implementation - System or simulated time
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "server_clock.h"
+
+#include <stdbool.h>
+#include <time.h>
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static struct {
+    bool fake;
+    time_t fake_start;      // Wall-clock time at fake_us == 0
+    uint64_t fake_us;       // Simulated monotonic time
+} g_clock;
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+time_t server_clock_now(void) {
+    if (g_clock.fake) {
+        return g_clock.fake_start + (time_t)(g_clock.fake_us / 1000000ULL);
+    }
+    return time(NULL);
+}
+
+uint64_t server_clock_monotonic_us(void) {
+    if (g_clock.fake) {
+        return g_clock.fake_us;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+void server_clock_sleep_ms(uint32_t ms) {
+    if (g_clock.fake) {
+        g_clock.fake_us += (uint64_t)ms * 1000ULL;
+        return;
+    }
+
+    struct timespec ts = {
+        .tv_sec = ms / 1000,
+        .tv_nsec = (long)(ms % 1000) * 1000000L
+    };
+    nanosleep(&ts, NULL);
+}
+
+void server_clock_use_fake(time_t start) {
+    g_clock.fake = true;
+    g_clock.fake_start = start;
+    g_clock.fake_us = 0;
+}
+
+void server_clock_use_real(void) {
+    g_clock.fake = false;
+}
+
+void server_clock_advance_ms(uint64_t ms) {
+    if (g_clock.fake) {
+        g_clock.fake_us += ms * 1000ULL;
+    }
+}
+
+bool server_clock_is_fake(void) {
+    return g_clock.fake;
+}
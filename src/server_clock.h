@@ -0,0 +1,76 @@
+/**
+ * @file server_clock.h
+ * @brief Server Clock - Injectable time source
+ *
+ * Modules read time and sleep through this clock instead of calling
+ * time() / clock_gettime() / nanosleep() directly. In normal operation
+ * it is a thin wrapper over the system clocks. A test can switch it to
+ * simulated time, where sleeping simply advances the clock, so long
+ * runs (days or weeks of daemon time) complete in seconds.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef SERVER_CLOCK_H
+#define SERVER_CLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Wall-clock time in seconds (time(NULL) equivalent)
+ * @return Current time
+ */
+time_t server_clock_now(void);
+
+/**
+ * @brief Monotonic time in microseconds
+ * @return Monotonic timestamp
+ */
+uint64_t server_clock_monotonic_us(void);
+
+/**
+ * @brief Sleep (advances simulated time instead when fake)
+ * @param ms Milliseconds
+ */
+void server_clock_sleep_ms(uint32_t ms);
+
+/**
+ * @brief Switch to simulated time
+ * @param start Initial wall-clock time
+ */
+void server_clock_use_fake(time_t start);
+
+/**
+ * @brief Switch back to the system clocks
+ */
+void server_clock_use_real(void);
+
+/**
+ * @brief Advance simulated time (no-op when using the system clocks)
+ * @param ms Milliseconds
+ */
+void server_clock_advance_ms(uint64_t ms);
+
+/**
+ * @brief Whether simulated time is active
+ * @return true if fake
+ */
+bool server_clock_is_fake(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SERVER_CLOCK_H */
@@ -7,6 +7,8 @@
 #define _POSIX_C_SOURCE 200809L
 
 #include "server_state_machine.h"
+#include "server_clock.h"
+#include "server_trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,9 +23,12 @@
  */
 static void change_state(server_context_t *ctx, server_state_t new_state) {
     if (ctx->state != new_state) {
+        time_t now = server_clock_now();
+        SERVER_TRACE3(state_transition, ctx->state, new_state, now - ctx->state_enter_time);
+        
         ctx->prev_state = ctx->state;
         ctx->state = new_state;
-        ctx->state_enter_time = time(NULL);
+        ctx->state_enter_time = now;
         
         // TODO: 觸發狀態變化回調 (生產環境實作)
     }
@@ -33,7 +38,7 @@ static void change_state(server_context_t *ctx, server_state_t new_state) {
  * @brief 檢查狀態是否超時
  */
 static bool is_state_timeout(const server_context_t *ctx) {
-    time_t now = time(NULL);
+    time_t now = server_clock_now();
     time_t elapsed = now - ctx->state_enter_time;
     return (elapsed >= SERVER_STATE_TIMEOUT_SEC);
 }
@@ -42,11 +47,13 @@ static bool is_state_timeout(const server_context_t *ctx) {
  * @brief 判斷 PS5 綜合狀態
  */
 static const char* determine_ps5_status(ps5_power_state_t cec_state, 
-                                        bool network_online) {
+                                        bool network_online,
+                                        bool remote_play_ready) {
     // 優先級: CEC 狀態 > 網路狀態
     
     if (cec_state == PS5_POWER_ON && network_online) {
-        return "on";
+        // 網路在線後 Remote Play 埠通常還要數秒才接受連線
+        return remote_play_ready ? "ready" : "on";
     } else if (cec_state == PS5_POWER_ON && !network_online) {
         // CEC 顯示開機但網路未連線,可能正在啟動
         return "starting";
@@ -56,7 +63,7 @@ static const char* determine_ps5_status(ps5_power_state_t cec_state,
         return "off";
     } else if (network_online) {
         // CEC 狀態未知但網路在線
-        return "on";
+        return remote_play_ready ? "ready" : "on";
     } else {
         return "unknown";
     }
@@ -79,7 +86,7 @@ int server_sm_init(server_context_t *ctx) {
     
     ctx->state = SERVER_STATE_INIT;
     ctx->prev_state = SERVER_STATE_INIT;
-    ctx->state_enter_time = time(NULL);
+    ctx->state_enter_time = server_clock_now();
     ctx->last_detect_time = 0;
     ctx->initialized = true;
     ctx->running = false;
@@ -87,7 +94,7 @@ int server_sm_init(server_context_t *ctx) {
     // 初始化 PS5 狀態
     ctx->ps5_status.cec_state = PS5_POWER_UNKNOWN;
     ctx->ps5_status.network_online = false;
-    ctx->ps5_status.last_update = time(NULL);
+    ctx->ps5_status.last_update = server_clock_now();
     memset(&ctx->ps5_status.info, 0, sizeof(ps5_info_t));
     
     // 轉換到 IDLE 狀態
@@ -189,7 +196,7 @@ int server_sm_update(server_context_t *ctx) {
         return -1;
     }
     
-    time_t now = time(NULL);
+    time_t now = server_clock_now();
     
     // 檢查狀態超時
     if (is_state_timeout(ctx)) {
@@ -223,7 +230,12 @@ int server_sm_update_cec_state(server_context_t *ctx,
     
     if (ctx->ps5_status.cec_state != cec_state) {
         ctx->ps5_status.cec_state = cec_state;
-        ctx->ps5_status.last_update = time(NULL);
+        ctx->ps5_status.last_update = server_clock_now();
+        
+        // 離開開機狀態,Remote Play 需重新確認
+        if (cec_state == PS5_POWER_STANDBY || cec_state == PS5_POWER_OFF) {
+            ctx->ps5_status.remote_play_ready = false;
+        }
         
         // 觸發狀態變化事件
         if (ctx->state == SERVER_STATE_IDLE) {
@@ -244,7 +256,27 @@ int server_sm_update_network_state(server_context_t *ctx, bool online) {
     
     if (ctx->ps5_status.network_online != online) {
         ctx->ps5_status.network_online = online;
-        ctx->ps5_status.last_update = time(NULL);
+        ctx->ps5_status.last_update = server_clock_now();
+        
+        if (!online) {
+            ctx->ps5_status.remote_play_ready = false;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief 更新 Remote Play 就緒狀態
+ */
+int server_sm_update_ready_state(server_context_t *ctx, bool ready) {
+    if (ctx == NULL || !ctx->initialized) {
+        return -1;
+    }
+    
+    if (ctx->ps5_status.remote_play_ready != ready) {
+        ctx->ps5_status.remote_play_ready = ready;
+        ctx->ps5_status.last_update = server_clock_now();
     }
     
     return 0;
@@ -260,7 +292,10 @@ int server_sm_update_ps5_info(server_context_t *ctx, const ps5_info_t *info) {
     
     memcpy(&ctx->ps5_status.info, info, sizeof(ps5_info_t));
     ctx->ps5_status.network_online = info->online;
-    ctx->ps5_status.last_update = time(NULL);
+    if (!info->online) {
+        ctx->ps5_status.remote_play_ready = false;
+    }
+    ctx->ps5_status.last_update = server_clock_now();
     
     return 0;
 }
@@ -274,7 +309,8 @@ const char* server_sm_get_ps5_status(const server_context_t *ctx) {
     }
     
     return determine_ps5_status(ctx->ps5_status.cec_state,
-                               ctx->ps5_status.network_online);
+                               ctx->ps5_status.network_online,
+                               ctx->ps5_status.remote_play_ready);
 }
 
 /**
@@ -82,6 +82,7 @@ typedef enum {
 typedef struct {
     ps5_power_state_t cec_state;    /**< CEC 電源狀態 */
     bool network_online;            /**< 網路是否在線 */
+    bool remote_play_ready;         /**< Remote Play 埠已接受連線 */
     ps5_info_t info;                /**< PS5 資訊 */
     time_t last_update;             /**< 最後更新時間 */
 } ps5_status_t;
@@ -180,6 +181,17 @@ int server_sm_update_cec_state(server_context_t *ctx,
  */
 int server_sm_update_network_state(server_context_t *ctx, bool online);
 
+/**
+ * @brief 更新 Remote Play 就緒狀態
+ * 
+ * 只有在 "on" 狀態下才有意義; CEC 離開 ON 或網路離線時自動清除
+ * 
+ * @param ctx 伺服器上下文
+ * @param ready Remote Play 埠是否已接受連線
+ * @return 0 成功, <0 失敗
+ */
+int server_sm_update_ready_state(server_context_t *ctx, bool ready);
+
 /**
  * @brief 更新 PS5 資訊
  * 
@@ -195,7 +207,7 @@ int server_sm_update_ps5_info(server_context_t *ctx, const ps5_info_t *info);
  * 根據 CEC 和網路狀態綜合判斷
  * 
  * @param ctx 伺服器上下文
- * @return 狀態字串: "on", "standby", "off", "unknown"
+ * @return 狀態字串: "ready", "on", "starting", "standby", "off", "unknown"
  */
 const char* server_sm_get_ps5_status(const server_context_t *ctx);
 
@@ -0,0 +1,74 @@
+/**
+ * @file server_trace.h
+ * @brief Server Trace - USDT static tracepoints on hot paths
+ *
+ * Built with ENABLE_USDT (needs <sys/sdt.h> from systemtap-sdt), each
+ * probe is a single nop in the binary under the "gaming_server"
+ * provider, which bpftrace or perf can attach to on a live box. Without
+ * ENABLE_USDT (and always in unit tests) probes and their timestamps
+ * compile to nothing and the arguments are not evaluated.
+ *
+ * Probes and arguments:
+ *
+ *   cec_query_start   ()
+ *   cec_query_end     (power_state, latency_us)
+ *   scan_start        ()
+ *   scan_end          (result, latency_us)
+ *   probe_sent        (target_ip, port)            target_ip in network order
+ *   probe_reply       (replied, rtt_us)
+ *   ws_msg_recv       (client_id, msg_type)
+ *   ws_reply_sent     (client_id, msg_type, latency_us, reply_len)
+ *   state_transition  (old_state, new_state, time_in_old_state_s)
+ *   broadcast         (clients_sent, message_len)
+ *
+ * Example (reply latency histogram):
+ *
+ *   bpftrace -e 'usdt:/usr/bin/gaming-server:gaming_server:ws_reply_sent
+ *                { @us = hist(arg2); }'
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef SERVER_TRACE_H
+#define SERVER_TRACE_H
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(ENABLE_USDT) && !defined(TESTING)
+
+#include <sys/sdt.h>
+
+#define SERVER_TRACE0(name)                 DTRACE_PROBE(gaming_server, name)
+#define SERVER_TRACE2(name, a, b)           DTRACE_PROBE2(gaming_server, name, a, b)
+#define SERVER_TRACE3(name, a, b, c)        DTRACE_PROBE3(gaming_server, name, a, b, c)
+#define SERVER_TRACE4(name, a, b, c, d)     DTRACE_PROBE4(gaming_server, name, a, b, c, d)
+
+/**
+ * @brief Monotonic timestamp for probe latency arguments
+ */
+static inline uint64_t server_trace_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+#else
+
+// sizeof keeps the arguments "used" without evaluating them
+#define SERVER_TRACE0(name)                 do { } while (0)
+#define SERVER_TRACE2(name, a, b)           do { (void)sizeof(a); (void)sizeof(b); } while (0)
+#define SERVER_TRACE3(name, a, b, c)        do { (void)sizeof(a); (void)sizeof(b); \
+                                                 (void)sizeof(c); } while (0)
+#define SERVER_TRACE4(name, a, b, c, d)     do { (void)sizeof(a); (void)sizeof(b); \
+                                                 (void)sizeof(c); (void)sizeof(d); } while (0)
+
+static inline uint64_t server_trace_now_us(void) {
+    return 0;
+}
+
+#endif
+
+#endif /* SERVER_TRACE_H */
@@ -0,0 +1,285 @@
+/**
+ * @file status_beacon.c
+ * @brief Status Beacon Implementation - UDP multicast status datagrams
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "status_beacon.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// POSIX headers
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    bool initialized;
+    int sock_fd;
+    struct sockaddr_in group_addr;
+
+    bool have_status;
+    beacon_status_t last_status;
+    uint32_t seq;
+    time_t last_send_time;
+    uint32_t sent_count;
+} status_beacon_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static status_beacon_context_t g_beacon_ctx = { .sock_fd = -1 };
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+/**
+ * @brief FNV-1a 32-bit hash step over a string
+ */
+static uint32_t fnv1a_update(uint32_t hash, const char *str) {
+    for (const unsigned char *p = (const unsigned char*)str; *p != '\0'; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void put_u32(uint8_t *buf, uint32_t value) {
+    buf[0] = (uint8_t)(value >> 24);
+    buf[1] = (uint8_t)(value >> 16);
+    buf[2] = (uint8_t)(value >> 8);
+    buf[3] = (uint8_t)value;
+}
+
+static uint32_t get_u32(const uint8_t *buf) {
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+           ((uint32_t)buf[2] << 8) | (uint32_t)buf[3];
+}
+
+/**
+ * @brief Encode and send the current status
+ */
+static int send_current(void) {
+    uint8_t packet[STATUS_BEACON_PACKET_SIZE];
+
+    int len = status_beacon_encode(&g_beacon_ctx.last_status, g_beacon_ctx.seq,
+                                   packet, sizeof(packet));
+    if (len < 0) {
+        return len;
+    }
+
+    g_beacon_ctx.seq++;
+    g_beacon_ctx.last_send_time = server_clock_now();
+
+    #ifndef TESTING
+    ssize_t sent = sendto(g_beacon_ctx.sock_fd, packet, (size_t)len, 0,
+                          (struct sockaddr*)&g_beacon_ctx.group_addr,
+                          sizeof(g_beacon_ctx.group_addr));
+    if (sent != len) {
+        return BEACON_ERROR_SEND_FAILED;
+    }
+    #endif
+
+    g_beacon_ctx.sent_count++;
+    return BEACON_OK;
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int status_beacon_init(const char *group, uint16_t port) {
+    if (g_beacon_ctx.initialized) {
+        return BEACON_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    memset(&g_beacon_ctx, 0, sizeof(status_beacon_context_t));
+    g_beacon_ctx.sock_fd = -1;
+
+    g_beacon_ctx.group_addr.sin_family = AF_INET;
+    g_beacon_ctx.group_addr.sin_port = htons((port > 0) ? port : STATUS_BEACON_DEFAULT_PORT);
+
+    const char *group_str = (group != NULL) ? group : STATUS_BEACON_DEFAULT_GROUP;
+    if (inet_pton(AF_INET, group_str, &g_beacon_ctx.group_addr.sin_addr) != 1 ||
+        (ntohl(g_beacon_ctx.group_addr.sin_addr.s_addr) & 0xF0000000u) != 0xE0000000u) {
+        return BEACON_ERROR_INVALID_PARAM;
+    }
+
+    #ifndef TESTING
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return BEACON_ERROR_SOCKET;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    unsigned char ttl = STATUS_BEACON_TTL;
+    unsigned char loop = 1;
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+
+    g_beacon_ctx.sock_fd = fd;
+
+    fprintf(stdout, "[Beacon] Multicasting status to %s:%u\n",
+            group_str, ntohs(g_beacon_ctx.group_addr.sin_port));
+    #endif
+
+    g_beacon_ctx.initialized = true;
+    return BEACON_OK;
+}
+
+int status_beacon_publish(const beacon_status_t *status) {
+    if (!g_beacon_ctx.initialized) {
+        return BEACON_ERROR_NOT_INIT;
+    }
+
+    if (status == NULL) {
+        return BEACON_ERROR_INVALID_PARAM;
+    }
+
+    memcpy(&g_beacon_ctx.last_status, status, sizeof(beacon_status_t));
+    g_beacon_ctx.have_status = true;
+
+    return send_current();
+}
+
+int status_beacon_process(void) {
+    if (!g_beacon_ctx.initialized) {
+        return BEACON_ERROR_NOT_INIT;
+    }
+
+    if (!g_beacon_ctx.have_status) {
+        return BEACON_OK;
+    }
+
+    if (server_clock_now() - g_beacon_ctx.last_send_time >= STATUS_BEACON_HEARTBEAT_SEC) {
+        return send_current();
+    }
+
+    return BEACON_OK;
+}
+
+int status_beacon_encode(const beacon_status_t *status, uint32_t seq,
+                         uint8_t *buf, size_t size) {
+    if (status == NULL || buf == NULL) {
+        return BEACON_ERROR_INVALID_PARAM;
+    }
+
+    if (size < STATUS_BEACON_PACKET_SIZE) {
+        return BEACON_ERROR_INVALID_PARAM;
+    }
+
+    struct in_addr addr;
+    uint32_t ipv4 = 0;
+    if (inet_pton(AF_INET, status->ip, &addr) == 1) {
+        ipv4 = ntohl(addr.s_addr);
+    }
+
+    uint32_t digest = 2166136261u;
+    digest = fnv1a_update(digest, status->ip);
+    digest = fnv1a_update(digest, "|");
+    digest = fnv1a_update(digest, status->mac);
+
+    put_u32(&buf[0], STATUS_BEACON_MAGIC);
+    buf[4] = STATUS_BEACON_PROTO_VERSION;
+    buf[5] = status->power_state;
+    buf[6] = status->network_online ? 1 : 0;
+    buf[7] = (uint8_t)status->status;
+    put_u32(&buf[8], seq);
+    put_u32(&buf[12], status->status_version);
+    put_u32(&buf[16], ipv4);
+    put_u32(&buf[20], digest);
+
+    return STATUS_BEACON_PACKET_SIZE;
+}
+
+int status_beacon_decode(const uint8_t *buf, size_t len, beacon_packet_t *packet) {
+    if (buf == NULL || packet == NULL) {
+        return BEACON_ERROR_INVALID_PARAM;
+    }
+
+    if (len < STATUS_BEACON_PACKET_SIZE || get_u32(&buf[0]) != STATUS_BEACON_MAGIC) {
+        return BEACON_ERROR_BAD_PACKET;
+    }
+
+    packet->proto_version = buf[4];
+    packet->power_state = buf[5];
+    packet->network_online = (buf[6] != 0);
+    packet->status = (beacon_status_code_t)buf[7];
+    packet->seq = get_u32(&buf[8]);
+    packet->status_version = get_u32(&buf[12]);
+    packet->ipv4 = get_u32(&buf[16]);
+    packet->addr_digest = get_u32(&buf[20]);
+
+    return BEACON_OK;
+}
+
+beacon_status_code_t status_beacon_code_from_string(const char *status) {
+    if (status == NULL) {
+        return BEACON_STATUS_UNKNOWN;
+    }
+
+    if (strcmp(status, "ready") == 0)     return BEACON_STATUS_READY;
+    if (strcmp(status, "on") == 0)        return BEACON_STATUS_ON;
+    if (strcmp(status, "starting") == 0)  return BEACON_STATUS_STARTING;
+    if (strcmp(status, "standby") == 0)   return BEACON_STATUS_STANDBY;
+    if (strcmp(status, "off") == 0)       return BEACON_STATUS_OFF;
+
+    return BEACON_STATUS_UNKNOWN;
+}
+
+uint32_t status_beacon_get_sent_count(void) {
+    return g_beacon_ctx.sent_count;
+}
+
+void status_beacon_cleanup(void) {
+    if (!g_beacon_ctx.initialized) {
+        return;
+    }
+
+    if (g_beacon_ctx.sock_fd >= 0) {
+        close(g_beacon_ctx.sock_fd);
+    }
+
+    memset(&g_beacon_ctx, 0, sizeof(status_beacon_context_t));
+    g_beacon_ctx.sock_fd = -1;
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* status_beacon_error_string(int error) {
+    switch (error) {
+        case BEACON_OK:                     return "OK";
+        case BEACON_ERROR_NOT_INIT:         return "Not initialized";
+        case BEACON_ERROR_INVALID_PARAM:    return "Invalid parameter";
+        case BEACON_ERROR_SOCKET:           return "Socket error";
+        case BEACON_ERROR_SEND_FAILED:      return "Send failed";
+        case BEACON_ERROR_BAD_PACKET:       return "Bad packet";
+        case BEACON_ERROR_UNKNOWN:          return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
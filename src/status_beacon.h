@@ -0,0 +1,178 @@
+/**
+ * @file status_beacon.h
+ * @brief Status Beacon - Connectionless PS5 status via UDP multicast
+ *
+ * Display-only listeners (set-top boxes, wall panels) can follow the PS5
+ * status without a WebSocket connection. A compact binary datagram is
+ * multicast on the LAN on every status change and repeated as a slow
+ * heartbeat, so the daemon's cost is independent of the listener count.
+ *
+ * Wire format (24 bytes, network byte order):
+ *
+ *   0  uint32  magic            "GSBC"
+ *   4  uint8   proto_version    STATUS_BEACON_PROTO_VERSION
+ *   5  uint8   power_state      ps5_power_state_t
+ *   6  uint8   network_online   0 / 1
+ *   7  uint8   status           beacon_status_code_t
+ *   8  uint32  seq              Datagram sequence number
+ *  12  uint32  status_version   Bumped on every status change
+ *  16  uint32  ipv4             Console IPv4 address (0 if unknown)
+ *  20  uint32  addr_digest      FNV-1a of "ip|mac", changes with either
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef STATUS_BEACON_H
+#define STATUS_BEACON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define BEACON_OK                       0
+#define BEACON_ERROR_NOT_INIT          -1
+#define BEACON_ERROR_INVALID_PARAM     -2
+#define BEACON_ERROR_SOCKET            -3
+#define BEACON_ERROR_SEND_FAILED       -4
+#define BEACON_ERROR_BAD_PACKET        -5
+#define BEACON_ERROR_UNKNOWN           -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define STATUS_BEACON_MAGIC             0x47534243u     /**< "GSBC" */
+#define STATUS_BEACON_PROTO_VERSION     1
+#define STATUS_BEACON_PACKET_SIZE       24
+#define STATUS_BEACON_DEFAULT_GROUP     "239.255.42.99"
+#define STATUS_BEACON_DEFAULT_PORT      9399
+#define STATUS_BEACON_HEARTBEAT_SEC     30              /**< Heartbeat interval */
+#define STATUS_BEACON_TTL               1               /**< Stay on the LAN */
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Combined status code carried in the beacon
+ */
+typedef enum {
+    BEACON_STATUS_UNKNOWN = 0,
+    BEACON_STATUS_OFF,
+    BEACON_STATUS_STANDBY,
+    BEACON_STATUS_STARTING,
+    BEACON_STATUS_ON,
+    BEACON_STATUS_READY,            /**< Remote Play port accepting */
+} beacon_status_code_t;
+
+/**
+ * @brief Status snapshot published by the beacon
+ */
+typedef struct {
+    uint32_t status_version;        /**< Status version */
+    uint8_t power_state;            /**< ps5_power_state_t */
+    bool network_online;            /**< Network online */
+    beacon_status_code_t status;    /**< Combined status */
+    char ip[16];                    /**< Console IP */
+    char mac[18];                   /**< Console MAC */
+} beacon_status_t;
+
+/**
+ * @brief Decoded beacon datagram
+ */
+typedef struct {
+    uint8_t proto_version;
+    uint8_t power_state;
+    bool network_online;
+    beacon_status_code_t status;
+    uint32_t seq;
+    uint32_t status_version;
+    uint32_t ipv4;                  /**< Host byte order */
+    uint32_t addr_digest;
+} beacon_packet_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Initialize the status beacon
+ * @param group Multicast group (NULL uses default)
+ * @param port UDP port (0 uses default)
+ * @return BEACON_OK on success, negative error code on failure
+ */
+int status_beacon_init(const char *group, uint16_t port);
+
+/**
+ * @brief Publish a status change immediately
+ * @param status Status snapshot
+ * @return BEACON_OK on success, negative error code on failure
+ */
+int status_beacon_publish(const beacon_status_t *status);
+
+/**
+ * @brief Send the heartbeat when due (non-blocking, call from the main loop)
+ * @return BEACON_OK on success, negative error code on failure
+ */
+int status_beacon_process(void);
+
+/**
+ * @brief Encode a datagram
+ * @param status Status snapshot
+ * @param seq Sequence number
+ * @param buf Output buffer
+ * @param size Output buffer size (>= STATUS_BEACON_PACKET_SIZE)
+ * @return Encoded length on success, negative error code on failure
+ */
+int status_beacon_encode(const beacon_status_t *status, uint32_t seq,
+                         uint8_t *buf, size_t size);
+
+/**
+ * @brief Decode a datagram (for listeners and tests)
+ * @param buf Datagram
+ * @param len Datagram length
+ * @param packet Pointer to store the decoded fields
+ * @return BEACON_OK on success, negative error code on failure
+ */
+int status_beacon_decode(const uint8_t *buf, size_t len, beacon_packet_t *packet);
+
+/**
+ * @brief Map a combined status string ("on", "standby", ...) to its code
+ * @param status Status string
+ * @return Status code
+ */
+beacon_status_code_t status_beacon_code_from_string(const char *status);
+
+/**
+ * @brief Number of datagrams sent
+ * @return Datagram count
+ */
+uint32_t status_beacon_get_sent_count(void);
+
+/**
+ * @brief Clean up beacon resources
+ */
+void status_beacon_cleanup(void);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* status_beacon_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_BEACON_H */
@@ -0,0 +1,226 @@
+/**
+ * @file status_snapshot.c
+ * @brief Status Snapshot Implementation - Version history and cached frames
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "status_snapshot.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    status_snapshot_t snapshot;
+    char delta_frame[SNAPSHOT_FRAME_MAX_LEN];   // Delta to current, "" until built
+} history_entry_t;
+
+typedef struct {
+    bool initialized;
+    bool have_status;
+
+    // history[head] is the current version
+    history_entry_t history[SNAPSHOT_HISTORY_SIZE];
+    int head;
+    int count;
+
+    char not_modified_frame[SNAPSHOT_FRAME_MAX_LEN];
+} status_snapshot_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static status_snapshot_context_t g_snapshot_ctx;
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+static const status_snapshot_t* current(void) {
+    return &g_snapshot_ctx.history[g_snapshot_ctx.head].snapshot;
+}
+
+/**
+ * @brief Append a changed field to a delta frame
+ */
+static size_t append_field(char *buf, size_t len, const char *name, const char *value) {
+    int n = snprintf(buf + len, SNAPSHOT_FRAME_MAX_LEN - len, ",\"%s\":\"%s\"", name, value);
+    if (n < 0 || (size_t)n >= SNAPSHOT_FRAME_MAX_LEN - len) {
+        return len;
+    }
+    return len + (size_t)n;
+}
+
+/**
+ * @brief Build the delta frame from an older version to the current one
+ */
+static void build_delta(history_entry_t *entry) {
+    const status_snapshot_t *from = &entry->snapshot;
+    const status_snapshot_t *to = current();
+    char buf[SNAPSHOT_FRAME_MAX_LEN];   // Built aside: the fields come from the same history array
+
+    int n = snprintf(buf, SNAPSHOT_FRAME_MAX_LEN,
+                     "{\"type\":\"ps5_status_delta\",\"version\":%u,\"from\":%u",
+                     to->version, from->version);
+    size_t len = (size_t)n;
+
+    if (strcmp(from->status, to->status) != 0) {
+        len = append_field(buf, len, "status", to->status);
+    }
+    if (strcmp(from->ip, to->ip) != 0) {
+        len = append_field(buf, len, "ip", to->ip);
+    }
+    if (strcmp(from->mac, to->mac) != 0) {
+        len = append_field(buf, len, "mac", to->mac);
+    }
+
+    snprintf(buf + len, SNAPSHOT_FRAME_MAX_LEN - len, "}");
+    memcpy(entry->delta_frame, buf, sizeof(buf));
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int status_snapshot_init(void) {
+    if (g_snapshot_ctx.initialized) {
+        return SNAPSHOT_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    memset(&g_snapshot_ctx, 0, sizeof(status_snapshot_context_t));
+
+    history_entry_t *entry = &g_snapshot_ctx.history[0];
+    entry->snapshot.version = (uint32_t)server_clock_now();
+    snprintf(entry->snapshot.status, sizeof(entry->snapshot.status), "unknown");
+    g_snapshot_ctx.count = 1;
+
+    snprintf(g_snapshot_ctx.not_modified_frame, sizeof(g_snapshot_ctx.not_modified_frame),
+             "{\"type\":\"not_modified\",\"version\":%u}", entry->snapshot.version);
+
+    g_snapshot_ctx.initialized = true;
+    return SNAPSHOT_OK;
+}
+
+bool status_snapshot_update(const char *status, const char *ip, const char *mac) {
+    if (!g_snapshot_ctx.initialized || status == NULL) {
+        return false;
+    }
+
+    if (ip == NULL) {
+        ip = "";
+    }
+    if (mac == NULL) {
+        mac = "";
+    }
+
+    const status_snapshot_t *cur = current();
+    if (g_snapshot_ctx.have_status &&
+        strcmp(cur->status, status) == 0 &&
+        strcmp(cur->ip, ip) == 0 &&
+        strcmp(cur->mac, mac) == 0) {
+        return false;
+    }
+
+    uint32_t version = cur->version + 1;
+
+    // First real status replaces the placeholder
+    if (g_snapshot_ctx.have_status) {
+        g_snapshot_ctx.head = (g_snapshot_ctx.head + 1) % SNAPSHOT_HISTORY_SIZE;
+        if (g_snapshot_ctx.count < SNAPSHOT_HISTORY_SIZE) {
+            g_snapshot_ctx.count++;
+        }
+    }
+
+    history_entry_t *entry = &g_snapshot_ctx.history[g_snapshot_ctx.head];
+    entry->snapshot.version = version;
+    snprintf(entry->snapshot.status, sizeof(entry->snapshot.status), "%s", status);
+    snprintf(entry->snapshot.ip, sizeof(entry->snapshot.ip), "%s", ip);
+    snprintf(entry->snapshot.mac, sizeof(entry->snapshot.mac), "%s", mac);
+    g_snapshot_ctx.have_status = true;
+
+    // Cached frames refer to the old current version
+    for (int i = 0; i < SNAPSHOT_HISTORY_SIZE; i++) {
+        g_snapshot_ctx.history[i].delta_frame[0] = '\0';
+    }
+    snprintf(g_snapshot_ctx.not_modified_frame, sizeof(g_snapshot_ctx.not_modified_frame),
+             "{\"type\":\"not_modified\",\"version\":%u}", version);
+
+    return true;
+}
+
+uint32_t status_snapshot_get_version(void) {
+    if (!g_snapshot_ctx.initialized) {
+        return 0;
+    }
+    return current()->version;
+}
+
+int status_snapshot_get(status_snapshot_t *snapshot) {
+    if (!g_snapshot_ctx.initialized) {
+        return SNAPSHOT_ERROR_NOT_INIT;
+    }
+
+    if (snapshot == NULL) {
+        return SNAPSHOT_ERROR_INVALID_PARAM;
+    }
+
+    memcpy(snapshot, current(), sizeof(status_snapshot_t));
+    return SNAPSHOT_OK;
+}
+
+const char* status_snapshot_conditional_reply(uint32_t if_version) {
+    if (!g_snapshot_ctx.initialized) {
+        return NULL;
+    }
+
+    if (if_version == current()->version) {
+        return g_snapshot_ctx.not_modified_frame;
+    }
+
+    // Search older versions still in the history
+    for (int i = 1; i < g_snapshot_ctx.count; i++) {
+        int idx = (g_snapshot_ctx.head - i + SNAPSHOT_HISTORY_SIZE) % SNAPSHOT_HISTORY_SIZE;
+        history_entry_t *entry = &g_snapshot_ctx.history[idx];
+
+        if (entry->snapshot.version == if_version) {
+            if (entry->delta_frame[0] == '\0') {
+                build_delta(entry);
+            }
+            return entry->delta_frame;
+        }
+    }
+
+    return NULL;  // Unknown or too old: full reply
+}
+
+void status_snapshot_cleanup(void) {
+    memset(&g_snapshot_ctx, 0, sizeof(status_snapshot_context_t));
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* status_snapshot_error_string(int error) {
+    switch (error) {
+        case SNAPSHOT_OK:                   return "OK";
+        case SNAPSHOT_ERROR_NOT_INIT:       return "Not initialized";
+        case SNAPSHOT_ERROR_INVALID_PARAM:  return "Invalid parameter";
+        case SNAPSHOT_ERROR_UNKNOWN:        return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
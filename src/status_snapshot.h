@@ -0,0 +1,127 @@
+/**
+ * @file status_snapshot.h
+ * @brief Status Snapshot - Versioned PS5 status for conditional queries
+ *
+ * The published status (combined status, IP, MAC) carries a version that
+ * increases on every change. A query that sends the version it already
+ * has ("if_version") can then be answered with a tiny frame instead of
+ * the full document:
+ *
+ *   {"type":"not_modified","version":V}
+ *   {"type":"ps5_status_delta","version":V,"from":F,"status":"ready"}
+ *
+ * The delta carries only the fields that differ from version F, which
+ * must still be in the short history; otherwise a full reply is needed.
+ * Reply frames are serialized once per version and reused.
+ *
+ * Versions start at the daemon start time (seconds) so a client holding
+ * a version from a previous run never matches by accident.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef STATUS_SNAPSHOT_H
+#define STATUS_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define SNAPSHOT_OK                     0
+#define SNAPSHOT_ERROR_NOT_INIT        -1
+#define SNAPSHOT_ERROR_INVALID_PARAM   -2
+#define SNAPSHOT_ERROR_UNKNOWN         -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define SNAPSHOT_HISTORY_SIZE           8       /**< Versions answerable by delta */
+#define SNAPSHOT_STATUS_MAX_LEN         16
+#define SNAPSHOT_IP_MAX_LEN             16
+#define SNAPSHOT_MAC_MAX_LEN            18
+#define SNAPSHOT_FRAME_MAX_LEN          160
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief One published status version
+ */
+typedef struct {
+    uint32_t version;                       /**< Status version */
+    char status[SNAPSHOT_STATUS_MAX_LEN];   /**< Combined status */
+    char ip[SNAPSHOT_IP_MAX_LEN];           /**< Console IP */
+    char mac[SNAPSHOT_MAC_MAX_LEN];         /**< Console MAC */
+} status_snapshot_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Initialize the snapshot (first version = start time)
+ * @return SNAPSHOT_OK on success, negative error code on failure
+ */
+int status_snapshot_init(void);
+
+/**
+ * @brief Record the current status; bumps the version if anything changed
+ * @param status Combined status
+ * @param ip Console IP
+ * @param mac Console MAC
+ * @return true if a new version was created
+ */
+bool status_snapshot_update(const char *status, const char *ip, const char *mac);
+
+/**
+ * @brief Get the current version
+ * @return Current version (0 if not initialized)
+ */
+uint32_t status_snapshot_get_version(void);
+
+/**
+ * @brief Get the current snapshot
+ * @param snapshot Pointer to store the snapshot
+ * @return SNAPSHOT_OK on success, negative error code on failure
+ */
+int status_snapshot_get(status_snapshot_t *snapshot);
+
+/**
+ * @brief Conditional reply for a client holding if_version
+ *
+ * The returned frame is owned by the module and valid until the next
+ * update; copy it before handing it out.
+ *
+ * @param if_version Version the client already has
+ * @return not_modified or delta frame, NULL if a full reply is needed
+ */
+const char* status_snapshot_conditional_reply(uint32_t if_version);
+
+/**
+ * @brief Clean up snapshot state
+ */
+void status_snapshot_cleanup(void);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* status_snapshot_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_SNAPSHOT_H */
@@ -0,0 +1,371 @@
+/**
+ * @file thread_policy.c
+ * @brief Thread Policy Implementation
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+#define _GNU_SOURCE         // SCHED_IDLE, cpu_set_t, pthread_setaffinity_np
+
+#include "thread_policy.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// POSIX headers
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    thread_policy_t policies[THREAD_CLASS_COUNT];
+    thread_policy_stats_t stats[THREAD_CLASS_COUNT];
+    int base_nice;                      // Process nice value at init
+    cpu_set_t base_cpus;                // Process affinity at init
+    bool initialized;
+    pthread_mutex_t mutex;              // Threads apply concurrently as they start
+} thread_policy_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static thread_policy_context_t g_policy_ctx = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+static const char *const g_class_names[THREAD_CLASS_COUNT] = {
+    "main", "cec", "worker", "webhook"
+};
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+static bool valid_class(thread_class_t cls) {
+    return ((int)cls >= 0 && cls < THREAD_CLASS_COUNT);
+}
+
+static void set_defaults(void) {
+    memset(g_policy_ctx.policies, 0, sizeof(g_policy_ctx.policies));
+
+    thread_policy_t background = { THREAD_SCHED_NICE, THREAD_POLICY_BACKGROUND_NICE, 0 };
+    g_policy_ctx.policies[THREAD_CLASS_WORKER] = background;
+    g_policy_ctx.policies[THREAD_CLASS_WEBHOOK] = background;
+}
+
+/**
+ * @brief "0,2-3" -> 0b1101; "all" -> 0
+ */
+static bool parse_cpu_list(const char *text, uint32_t *mask) {
+    if (strcmp(text, "all") == 0) {
+        *mask = 0;
+        return true;
+    }
+
+    uint32_t result = 0;
+    const char *p = text;
+
+    for (;;) {
+        char *end = NULL;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0 || first >= THREAD_POLICY_MAX_CPUS) {
+            return false;
+        }
+        long last = first;
+        if (*end == '-') {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first || last >= THREAD_POLICY_MAX_CPUS) {
+                return false;
+            }
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            result |= (1u << cpu);
+        }
+
+        if (*end == '\0') {
+            break;
+        }
+        if (*end != ',') {
+            return false;
+        }
+        p = end + 1;
+    }
+
+    *mask = result;
+    return true;
+}
+
+static bool parse_sched(const char *text, thread_policy_t *policy) {
+    if (strcmp(text, "normal") == 0) {
+        policy->sched = THREAD_SCHED_NORMAL;
+        return true;
+    }
+    if (strcmp(text, "idle") == 0) {
+        policy->sched = THREAD_SCHED_IDLE;
+        return true;
+    }
+    if (strncmp(text, "nice:", 5) == 0) {
+        char *end = NULL;
+        long nice = strtol(text + 5, &end, 10);
+        if (end == text + 5 || *end != '\0' || nice < 0 || nice > 19) {
+            return false;
+        }
+        policy->sched = THREAD_SCHED_NICE;
+        policy->nice = (int)nice;
+        return true;
+    }
+    return false;
+}
+
+#ifndef TESTING
+/**
+ * @brief Set scheduling class and nice value of the calling thread
+ */
+static bool apply_sched(const thread_policy_t *policy, int base_nice) {
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+
+    int sched = (policy->sched == THREAD_SCHED_IDLE) ? SCHED_IDLE : SCHED_OTHER;
+    if (pthread_setschedparam(pthread_self(), sched, &param) != 0) {
+        return false;
+    }
+    if (policy->sched == THREAD_SCHED_IDLE) {
+        return true;    // Nice has no effect under SCHED_IDLE
+    }
+
+    // On Linux nice is per thread when addressed by TID
+    int nice = (policy->sched == THREAD_SCHED_NICE) ? policy->nice : base_nice;
+    pid_t tid = (pid_t)syscall(SYS_gettid);
+    return (setpriority(PRIO_PROCESS, (id_t)tid, nice) == 0);
+}
+
+/**
+ * @brief Pin the calling thread to the class mask, or the process's original set
+ */
+static bool apply_affinity(uint32_t mask, const cpu_set_t *base) {
+    cpu_set_t cpus;
+
+    if (mask == 0) {
+        cpus = *base;
+    } else {
+        CPU_ZERO(&cpus);
+        for (int cpu = 0; cpu < THREAD_POLICY_MAX_CPUS; cpu++) {
+            if (mask & (1u << cpu)) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+    }
+
+    return (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0);
+}
+#endif
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int thread_policy_init(void) {
+    pthread_mutex_lock(&g_policy_ctx.mutex);
+
+    set_defaults();
+    memset(g_policy_ctx.stats, 0, sizeof(g_policy_ctx.stats));
+    g_policy_ctx.base_nice = 0;
+    CPU_ZERO(&g_policy_ctx.base_cpus);
+
+    #ifndef TESTING
+    errno = 0;
+    int nice = getpriority(PRIO_PROCESS, 0);
+    if (errno == 0) {
+        g_policy_ctx.base_nice = nice;
+    }
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &g_policy_ctx.base_cpus) != 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET(cpu, &g_policy_ctx.base_cpus);
+        }
+    }
+    #endif
+
+    g_policy_ctx.initialized = true;
+    pthread_mutex_unlock(&g_policy_ctx.mutex);
+
+    return THREAD_POLICY_OK;
+}
+
+int thread_policy_add_rule(const char *rule) {
+    if (rule == NULL) {
+        return THREAD_POLICY_ERROR_INVALID_PARAM;
+    }
+
+    char buf[THREAD_POLICY_RULE_MAX_LEN];
+    if (strlen(rule) >= sizeof(buf)) {
+        return THREAD_POLICY_ERROR_INVALID_PARAM;
+    }
+    snprintf(buf, sizeof(buf), "%s", rule);
+
+    char *eq = strchr(buf, '=');
+    if (eq == NULL) {
+        return THREAD_POLICY_ERROR_INVALID_PARAM;
+    }
+    *eq = '\0';
+
+    int cls = -1;
+    for (int i = 0; i < THREAD_CLASS_COUNT; i++) {
+        if (strcmp(buf, g_class_names[i]) == 0) {
+            cls = i;
+        }
+    }
+    if (cls < 0) {
+        return THREAD_POLICY_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&g_policy_ctx.mutex);
+    if (!g_policy_ctx.initialized) {
+        pthread_mutex_unlock(&g_policy_ctx.mutex);
+        return THREAD_POLICY_ERROR_NOT_INIT;
+    }
+    thread_policy_t policy = g_policy_ctx.policies[cls];
+    pthread_mutex_unlock(&g_policy_ctx.mutex);
+
+    char *sched = eq + 1;
+    char *at = strchr(sched, '@');
+    if (at != NULL) {
+        *at = '\0';
+        if (!parse_cpu_list(at + 1, &policy.cpu_mask)) {
+            return THREAD_POLICY_ERROR_INVALID_PARAM;
+        }
+    }
+    if (*sched != '\0' && !parse_sched(sched, &policy)) {
+        return THREAD_POLICY_ERROR_INVALID_PARAM;
+    }
+    if (*sched == '\0' && at == NULL) {
+        return THREAD_POLICY_ERROR_INVALID_PARAM;   // "worker=" says nothing
+    }
+
+    pthread_mutex_lock(&g_policy_ctx.mutex);
+    g_policy_ctx.policies[cls] = policy;
+    pthread_mutex_unlock(&g_policy_ctx.mutex);
+
+    return THREAD_POLICY_OK;
+}
+
+int thread_policy_get(thread_class_t cls, thread_policy_t *policy) {
+    if (!valid_class(cls) || policy == NULL) {
+        return THREAD_POLICY_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&g_policy_ctx.mutex);
+    if (!g_policy_ctx.initialized) {
+        pthread_mutex_unlock(&g_policy_ctx.mutex);
+        return THREAD_POLICY_ERROR_NOT_INIT;
+    }
+    *policy = g_policy_ctx.policies[cls];
+    pthread_mutex_unlock(&g_policy_ctx.mutex);
+
+    return THREAD_POLICY_OK;
+}
+
+int thread_policy_apply(thread_class_t cls) {
+    if (!valid_class(cls)) {
+        return THREAD_POLICY_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&g_policy_ctx.mutex);
+    if (!g_policy_ctx.initialized) {
+        pthread_mutex_unlock(&g_policy_ctx.mutex);
+        return THREAD_POLICY_ERROR_NOT_INIT;
+    }
+    thread_policy_t policy = g_policy_ctx.policies[cls];
+    int base_nice = g_policy_ctx.base_nice;
+    cpu_set_t base_cpus = g_policy_ctx.base_cpus;
+    pthread_mutex_unlock(&g_policy_ctx.mutex);
+
+    bool ok = true;
+
+    #ifdef TESTING
+    // In test mode, leave the test runner's scheduling alone
+    (void)policy;
+    (void)base_nice;
+    (void)base_cpus;
+    #else
+    // Both parts are attempted; one refused does not skip the other
+    bool sched_ok = apply_sched(&policy, base_nice);
+    bool cpus_ok = apply_affinity(policy.cpu_mask, &base_cpus);
+    ok = sched_ok && cpus_ok;
+
+    if (!sched_ok) {
+        fprintf(stderr, "[Threads] %s: %s scheduling refused\n",
+                g_class_names[cls], thread_sched_to_string(policy.sched));
+    }
+    if (!cpus_ok) {
+        fprintf(stderr, "[Threads] %s: CPU affinity 0x%x refused\n", g_class_names[cls], policy.cpu_mask);
+    }
+    #endif
+
+    pthread_mutex_lock(&g_policy_ctx.mutex);
+    if (ok) {
+        g_policy_ctx.stats[cls].applied++;
+    } else {
+        g_policy_ctx.stats[cls].failed++;
+    }
+    pthread_mutex_unlock(&g_policy_ctx.mutex);
+
+    return ok ? THREAD_POLICY_OK : THREAD_POLICY_ERROR_SYSTEM;
+}
+
+int thread_policy_get_stats(thread_class_t cls, thread_policy_stats_t *stats) {
+    if (!valid_class(cls) || stats == NULL) {
+        return THREAD_POLICY_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&g_policy_ctx.mutex);
+    *stats = g_policy_ctx.stats[cls];
+    pthread_mutex_unlock(&g_policy_ctx.mutex);
+
+    return THREAD_POLICY_OK;
+}
+
+void thread_policy_cleanup(void) {
+    pthread_mutex_lock(&g_policy_ctx.mutex);
+    set_defaults();
+    memset(g_policy_ctx.stats, 0, sizeof(g_policy_ctx.stats));
+    g_policy_ctx.initialized = false;
+    pthread_mutex_unlock(&g_policy_ctx.mutex);
+}
+
+const char* thread_class_to_string(thread_class_t cls) {
+    return valid_class(cls) ? g_class_names[cls] : "unknown";
+}
+
+const char* thread_sched_to_string(thread_sched_t sched) {
+    switch (sched) {
+        case THREAD_SCHED_NORMAL:   return "normal";
+        case THREAD_SCHED_NICE:     return "nice";
+        case THREAD_SCHED_IDLE:     return "idle";
+        default:                    return "unknown";
+    }
+}
+
+const char* thread_policy_error_string(int error) {
+    switch (error) {
+        case THREAD_POLICY_OK:                      return "OK";
+        case THREAD_POLICY_ERROR_NOT_INIT:          return "Not initialized";
+        case THREAD_POLICY_ERROR_INVALID_PARAM:     return "Invalid parameter";
+        case THREAD_POLICY_ERROR_SYSTEM:            return "Refused by the kernel";
+        case THREAD_POLICY_ERROR_UNKNOWN:           return "Unknown error";
+        default:                                    return "Invalid error code";
+    }
+}
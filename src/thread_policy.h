@@ -0,0 +1,174 @@
+/**
+ * @file thread_policy.h
+ * @brief Thread Policy - Scheduling class and CPU affinity per thread class
+ *
+ * The router's few cores also forward the gaming traffic, so background
+ * work must give way to the kernel's packet processing:
+ *
+ *   main      client I/O and state machine      normal
+ *   cec       CEC monitor thread                normal
+ *   worker    worker pool (scans, cache writes) nice 10
+ *   webhook   webhook dispatcher                nice 10
+ *
+ * Each class can be switched to normal, a nice value or SCHED_IDLE and
+ * given a CPU list, one rule per class: "worker=idle@1-3",
+ * "webhook=nice:15@3", "main=@0".
+ *
+ * Every thread applies its class policy to itself when it starts; child
+ * processes it spawns (nmap, ping, cec-ctl) inherit it. A class without
+ * a mask gets the process's original affinity back, not main's.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef THREAD_POLICY_H
+#define THREAD_POLICY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define THREAD_POLICY_OK                    0
+#define THREAD_POLICY_ERROR_NOT_INIT       -1
+#define THREAD_POLICY_ERROR_INVALID_PARAM  -2
+#define THREAD_POLICY_ERROR_SYSTEM         -3
+#define THREAD_POLICY_ERROR_UNKNOWN        -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define THREAD_POLICY_MAX_CPUS              32
+#define THREAD_POLICY_BACKGROUND_NICE       10      /**< Default for worker / webhook */
+#define THREAD_POLICY_RULE_MAX_LEN          64
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Thread class
+ */
+typedef enum {
+    THREAD_CLASS_MAIN = 0,      /**< Main loop: client I/O, state machine */
+    THREAD_CLASS_CEC,           /**< CEC monitor thread */
+    THREAD_CLASS_WORKER,        /**< Worker pool threads */
+    THREAD_CLASS_WEBHOOK,       /**< Webhook dispatcher thread */
+    THREAD_CLASS_COUNT
+} thread_class_t;
+
+/**
+ * @brief Scheduling choice
+ */
+typedef enum {
+    THREAD_SCHED_NORMAL = 0,    /**< SCHED_OTHER at the process's own nice value */
+    THREAD_SCHED_NICE,          /**< SCHED_OTHER at a given nice value */
+    THREAD_SCHED_IDLE           /**< SCHED_IDLE: runs only when a CPU has nothing else */
+} thread_sched_t;
+
+/**
+ * @brief Policy of one class
+ */
+typedef struct {
+    thread_sched_t sched;
+    int nice;                   /**< For THREAD_SCHED_NICE (0..19) */
+    uint32_t cpu_mask;          /**< Bit n = CPU n; 0 = process default */
+} thread_policy_t;
+
+/**
+ * @brief Per-class counters
+ */
+typedef struct {
+    uint32_t applied;           /**< Threads that took the policy */
+    uint32_t failed;            /**< Threads where a part of it was refused */
+} thread_policy_stats_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Record the process's nice value and affinity and set the default policies
+ *
+ * Call once from the main thread before any class policy is applied.
+ *
+ * @return THREAD_POLICY_OK on success, negative error code on failure
+ */
+int thread_policy_init(void);
+
+/**
+ * @brief Override one class policy
+ *
+ * CLASS=[normal|idle|nice:N][@CPUS], CPUS like "0,2-3" or "all".
+ * A part left out keeps its current value.
+ *
+ * @param rule Rule string
+ * @return THREAD_POLICY_OK on success,
+ *         THREAD_POLICY_ERROR_INVALID_PARAM if it does not parse (nothing is changed)
+ */
+int thread_policy_add_rule(const char *rule);
+
+/**
+ * @brief Get the policy of a class
+ * @param cls Thread class
+ * @param policy Output policy
+ * @return THREAD_POLICY_OK on success, negative error code on failure
+ */
+int thread_policy_get(thread_class_t cls, thread_policy_t *policy);
+
+/**
+ * @brief Apply a class policy to the calling thread
+ * @param cls Thread class
+ * @return THREAD_POLICY_OK on success,
+ *         THREAD_POLICY_ERROR_SYSTEM if the kernel refused part of it (the rest still applies)
+ */
+int thread_policy_apply(thread_class_t cls);
+
+/**
+ * @brief Get the counters of a class
+ * @param cls Thread class
+ * @param stats Output counters
+ * @return THREAD_POLICY_OK on success, negative error code on failure
+ */
+int thread_policy_get_stats(thread_class_t cls, thread_policy_stats_t *stats);
+
+/**
+ * @brief Forget the policies and counters
+ */
+void thread_policy_cleanup(void);
+
+/**
+ * @brief Convert thread class to string
+ * @param cls Thread class
+ * @return "main", "cec", "worker", "webhook" or "unknown"
+ */
+const char* thread_class_to_string(thread_class_t cls);
+
+/**
+ * @brief Convert scheduling choice to string
+ * @param sched Scheduling choice
+ * @return "normal", "nice", "idle" or "unknown"
+ */
+const char* thread_sched_to_string(thread_sched_t sched);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* thread_policy_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREAD_POLICY_H */
@@ -0,0 +1,702 @@
+/**
+ * @file webhook_dispatcher.c
+ * @brief Webhook Dispatcher Implementation - Batched HTTP POST worker
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "webhook_dispatcher.h"
+#include "thread_policy.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// POSIX headers
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <strings.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define WEBHOOK_BODY_MAX_LEN        8192
+#define WEBHOOK_REQUEST_MAX_LEN     (WEBHOOK_BODY_MAX_LEN + 512)
+#define WEBHOOK_RESPONSE_MAX_LEN    2048
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    webhook_endpoint_t endpoint;
+    int fd;                             // Keep-alive connection, -1 if closed
+} endpoint_conn_t;
+
+typedef struct {
+    bool initialized;
+    bool running;
+    bool stopping;
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    // Endpoints (owned by the worker once started)
+    endpoint_conn_t endpoints[WEBHOOK_MAX_ENDPOINTS];
+    int endpoint_count;
+
+    // Ring buffer (protected by mutex)
+    webhook_event_t queue[WEBHOOK_QUEUE_SIZE];
+    int head;
+    int count;
+    uint32_t next_seq;
+
+    webhook_stats_t stats;
+} webhook_dispatcher_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static webhook_dispatcher_context_t g_webhook_ctx;
+
+/* ============================================================
+ *  Helper Functions - Timing
+ * ============================================================ */
+
+/**
+ * @brief Absolute CLOCK_MONOTONIC deadline ms from now
+ */
+static struct timespec deadline_after_ms(long ms) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += ms / 1000;
+    ts.tv_nsec += (ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+/**
+ * @brief Sleep for a retry backoff; returns false if stopping
+ */
+static bool backoff_wait(int seconds) {
+    struct timespec deadline = deadline_after_ms((long)seconds * 1000L);
+
+    pthread_mutex_lock(&g_webhook_ctx.mutex);
+    while (!g_webhook_ctx.stopping) {
+        if (pthread_cond_timedwait(&g_webhook_ctx.cond, &g_webhook_ctx.mutex,
+                                   &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    bool keep_going = !g_webhook_ctx.stopping;
+    pthread_mutex_unlock(&g_webhook_ctx.mutex);
+
+    return keep_going;
+}
+
+/* ============================================================
+ *  Helper Functions - HTTP
+ * ============================================================ */
+
+static void close_conn(endpoint_conn_t *conn) {
+    if (conn->fd >= 0) {
+        close(conn->fd);
+        conn->fd = -1;
+    }
+}
+
+#ifndef TESTING
+/**
+ * @brief Open a TCP connection with send/receive timeouts
+ */
+static int open_conn(endpoint_conn_t *conn) {
+    struct addrinfo hints;
+    struct addrinfo *res = NULL;
+    char port_str[8];
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    snprintf(port_str, sizeof(port_str), "%u", conn->endpoint.port);
+
+    if (getaddrinfo(conn->endpoint.host, port_str, &hints, &res) != 0 || res == NULL) {
+        return -1;
+    }
+
+    int fd = socket(res->ai_family, SOCK_STREAM, 0);
+    if (fd < 0) {
+        freeaddrinfo(res);
+        return -1;
+    }
+
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    // SO_SNDTIMEO also bounds connect() on Linux
+    struct timeval tv = { .tv_sec = WEBHOOK_IO_TIMEOUT_SEC, .tv_usec = 0 };
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    int rc = connect(fd, res->ai_addr, res->ai_addrlen);
+    freeaddrinfo(res);
+
+    if (rc != 0) {
+        close(fd);
+        return -1;
+    }
+
+    conn->fd = fd;
+
+    pthread_mutex_lock(&g_webhook_ctx.mutex);
+    g_webhook_ctx.stats.connects++;
+    pthread_mutex_unlock(&g_webhook_ctx.mutex);
+
+    return 0;
+}
+
+/**
+ * @brief Send one request on the connection and read the response
+ * @return HTTP status code, -1 on I/O failure
+ */
+static int exchange(endpoint_conn_t *conn, const char *request, size_t request_len) {
+    size_t off = 0;
+    while (off < request_len) {
+        ssize_t n = send(conn->fd, request + off, request_len - off, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        off += (size_t)n;
+    }
+
+    // Read until the header block is complete
+    char resp[WEBHOOK_RESPONSE_MAX_LEN];
+    size_t len = 0;
+    char *header_end = NULL;
+
+    while (header_end == NULL) {
+        if (len >= sizeof(resp) - 1) {
+            return -1;
+        }
+        ssize_t n = recv(conn->fd, resp + len, sizeof(resp) - 1 - len, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        len += (size_t)n;
+        resp[len] = '\0';
+        header_end = strstr(resp, "\r\n\r\n");
+    }
+
+    size_t content_length = 0;
+    bool keep_alive = true;
+    int status = webhook_parse_response(resp, &content_length, &keep_alive);
+    if (status < 0) {
+        return -1;
+    }
+
+    // Drain the body so the connection can be reused
+    size_t body_have = len - (size_t)(header_end + 4 - resp);
+    while (body_have < content_length) {
+        char discard[512];
+        size_t want = content_length - body_have;
+        ssize_t n = recv(conn->fd, discard, (want < sizeof(discard)) ? want : sizeof(discard), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            keep_alive = false;
+            break;
+        }
+        body_have += (size_t)n;
+    }
+
+    if (!keep_alive) {
+        close_conn(conn);
+    }
+
+    return status;
+}
+
+#endif /* TESTING */
+
+/**
+ * @brief POST a body to one endpoint
+ * @return true if the endpoint answered 2xx
+ */
+static bool post_to_endpoint(endpoint_conn_t *conn, const char *body) {
+    #ifdef TESTING
+    // In test mode, no network traffic; deliveries always succeed
+    (void)conn;
+    (void)body;
+    return true;
+    #else
+    char request[WEBHOOK_REQUEST_MAX_LEN];
+    int request_len = webhook_build_request(&conn->endpoint, body, request, sizeof(request));
+    if (request_len < 0) {
+        return false;
+    }
+
+    // A reused keep-alive connection may have been closed by the peer
+    // while idle; retry once on a fresh connection before failing.
+    for (int attempt = 0; attempt < 2; attempt++) {
+        bool reused = (conn->fd >= 0);
+
+        if (!reused && open_conn(conn) != 0) {
+            return false;
+        }
+
+        int status = exchange(conn, request, (size_t)request_len);
+        if (status >= 200 && status < 300) {
+            return true;
+        }
+
+        if (status > 0) {
+            return false;  // Endpoint answered with an error
+        }
+
+        close_conn(conn);
+        if (!reused) {
+            return false;
+        }
+    }
+
+    return false;
+    #endif
+}
+
+/**
+ * @brief Deliver one batch to every endpoint, retrying with backoff
+ */
+static void deliver_batch(const webhook_event_t *events, int count) {
+    char body[WEBHOOK_BODY_MAX_LEN];
+
+    if (webhook_build_body(events, count, body, sizeof(body)) < 0) {
+        pthread_mutex_lock(&g_webhook_ctx.mutex);
+        g_webhook_ctx.stats.batches_failed++;
+        pthread_mutex_unlock(&g_webhook_ctx.mutex);
+        return;
+    }
+
+    for (int i = 0; i < g_webhook_ctx.endpoint_count; i++) {
+        endpoint_conn_t *conn = &g_webhook_ctx.endpoints[i];
+        int backoff = WEBHOOK_BACKOFF_MIN_SEC;
+        bool delivered = false;
+
+        for (int attempt = 0; attempt <= WEBHOOK_MAX_RETRIES; attempt++) {
+            if (attempt > 0) {
+                pthread_mutex_lock(&g_webhook_ctx.mutex);
+                g_webhook_ctx.stats.retries++;
+                pthread_mutex_unlock(&g_webhook_ctx.mutex);
+
+                if (!backoff_wait(backoff)) {
+                    break;  // Shutting down
+                }
+                backoff = (backoff * 2 > WEBHOOK_BACKOFF_MAX_SEC) ?
+                          WEBHOOK_BACKOFF_MAX_SEC : backoff * 2;
+            }
+
+            if (post_to_endpoint(conn, body)) {
+                delivered = true;
+                break;
+            }
+        }
+
+        pthread_mutex_lock(&g_webhook_ctx.mutex);
+        if (delivered) {
+            g_webhook_ctx.stats.batches_sent++;
+            g_webhook_ctx.stats.events_sent += (uint32_t)count;
+        } else {
+            g_webhook_ctx.stats.batches_failed++;
+        }
+        pthread_mutex_unlock(&g_webhook_ctx.mutex);
+
+        #ifndef TESTING
+        if (!delivered) {
+            fprintf(stderr, "[Webhook] Giving up on %s:%u%s (%d events)\n",
+                    conn->endpoint.host, conn->endpoint.port, conn->endpoint.path, count);
+        }
+        #endif
+    }
+}
+
+/**
+ * @brief Worker thread: collect bursts and deliver them
+ */
+static void* worker_main(void *arg) {
+    (void)arg;
+    webhook_event_t batch[WEBHOOK_BATCH_MAX];
+
+#ifndef TESTING
+    thread_policy_apply(THREAD_CLASS_WEBHOOK);
+#endif
+
+    pthread_mutex_lock(&g_webhook_ctx.mutex);
+
+    while (!g_webhook_ctx.stopping) {
+        if (g_webhook_ctx.count == 0) {
+            pthread_cond_wait(&g_webhook_ctx.cond, &g_webhook_ctx.mutex);
+            continue;
+        }
+
+        // Let the rest of a burst arrive
+        struct timespec deadline = deadline_after_ms(WEBHOOK_COALESCE_MS);
+        while (!g_webhook_ctx.stopping && g_webhook_ctx.count < WEBHOOK_BATCH_MAX) {
+            if (pthread_cond_timedwait(&g_webhook_ctx.cond, &g_webhook_ctx.mutex,
+                                       &deadline) == ETIMEDOUT) {
+                break;
+            }
+        }
+
+        if (g_webhook_ctx.stopping) {
+            break;
+        }
+
+        int n = 0;
+        while (n < WEBHOOK_BATCH_MAX && g_webhook_ctx.count > 0) {
+            batch[n++] = g_webhook_ctx.queue[g_webhook_ctx.head];
+            g_webhook_ctx.head = (g_webhook_ctx.head + 1) % WEBHOOK_QUEUE_SIZE;
+            g_webhook_ctx.count--;
+        }
+
+        pthread_mutex_unlock(&g_webhook_ctx.mutex);
+        deliver_batch(batch, n);
+        pthread_mutex_lock(&g_webhook_ctx.mutex);
+    }
+
+    pthread_mutex_unlock(&g_webhook_ctx.mutex);
+    return NULL;
+}
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int webhook_dispatcher_init(void) {
+    if (g_webhook_ctx.initialized) {
+        return WEBHOOK_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    memset(&g_webhook_ctx, 0, sizeof(webhook_dispatcher_context_t));
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&g_webhook_ctx.cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&g_webhook_ctx.mutex, NULL);
+
+    for (int i = 0; i < WEBHOOK_MAX_ENDPOINTS; i++) {
+        g_webhook_ctx.endpoints[i].fd = -1;
+    }
+
+    g_webhook_ctx.next_seq = 1;
+    g_webhook_ctx.initialized = true;
+
+    return WEBHOOK_OK;
+}
+
+int webhook_dispatcher_add_endpoint(const char *url) {
+    if (!g_webhook_ctx.initialized) {
+        return WEBHOOK_ERROR_NOT_INIT;
+    }
+
+    if (g_webhook_ctx.running) {
+        return WEBHOOK_ERROR_INVALID_PARAM;  // Endpoints are fixed once started
+    }
+
+    if (g_webhook_ctx.endpoint_count >= WEBHOOK_MAX_ENDPOINTS) {
+        return WEBHOOK_ERROR_NO_SPACE;
+    }
+
+    endpoint_conn_t *conn = &g_webhook_ctx.endpoints[g_webhook_ctx.endpoint_count];
+    int ret = webhook_parse_url(url, &conn->endpoint);
+    if (ret != WEBHOOK_OK) {
+        return ret;
+    }
+
+    conn->fd = -1;
+    g_webhook_ctx.endpoint_count++;
+
+    #ifndef TESTING
+    fprintf(stdout, "[Webhook] Endpoint: http://%s:%u%s\n",
+            conn->endpoint.host, conn->endpoint.port, conn->endpoint.path);
+    #endif
+
+    return WEBHOOK_OK;
+}
+
+int webhook_dispatcher_start(void) {
+    if (!g_webhook_ctx.initialized) {
+        return WEBHOOK_ERROR_NOT_INIT;
+    }
+
+    if (g_webhook_ctx.running) {
+        return WEBHOOK_OK;
+    }
+
+    g_webhook_ctx.stopping = false;
+    if (pthread_create(&g_webhook_ctx.thread, NULL, worker_main, NULL) != 0) {
+        return WEBHOOK_ERROR_THREAD;
+    }
+
+    g_webhook_ctx.running = true;
+    return WEBHOOK_OK;
+}
+
+int webhook_dispatcher_notify(const char *type, const char *data_json) {
+    if (!g_webhook_ctx.initialized) {
+        return WEBHOOK_ERROR_NOT_INIT;
+    }
+
+    if (type == NULL || type[0] == '\0' || strlen(type) >= WEBHOOK_TYPE_MAX_LEN ||
+        (data_json != NULL && strlen(data_json) >= WEBHOOK_DATA_MAX_LEN)) {
+        return WEBHOOK_ERROR_INVALID_PARAM;
+    }
+
+    if (g_webhook_ctx.endpoint_count == 0) {
+        return WEBHOOK_OK;  // Nobody to tell
+    }
+
+    pthread_mutex_lock(&g_webhook_ctx.mutex);
+
+    if (g_webhook_ctx.count == WEBHOOK_QUEUE_SIZE) {
+        // Drop the oldest: the newest state matters most
+        g_webhook_ctx.head = (g_webhook_ctx.head + 1) % WEBHOOK_QUEUE_SIZE;
+        g_webhook_ctx.count--;
+        g_webhook_ctx.stats.events_dropped++;
+    }
+
+    int tail = (g_webhook_ctx.head + g_webhook_ctx.count) % WEBHOOK_QUEUE_SIZE;
+    webhook_event_t *ev = &g_webhook_ctx.queue[tail];
+    ev->seq = g_webhook_ctx.next_seq++;
+    ev->timestamp = time(NULL);
+    snprintf(ev->type, sizeof(ev->type), "%s", type);
+    snprintf(ev->data, sizeof(ev->data), "%s", (data_json != NULL) ? data_json : "{}");
+    g_webhook_ctx.count++;
+
+    pthread_cond_signal(&g_webhook_ctx.cond);
+    pthread_mutex_unlock(&g_webhook_ctx.mutex);
+
+    return WEBHOOK_OK;
+}
+
+int webhook_dispatcher_get_stats(webhook_stats_t *stats) {
+    if (!g_webhook_ctx.initialized) {
+        return WEBHOOK_ERROR_NOT_INIT;
+    }
+
+    if (stats == NULL) {
+        return WEBHOOK_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&g_webhook_ctx.mutex);
+    memcpy(stats, &g_webhook_ctx.stats, sizeof(webhook_stats_t));
+    stats->queued = (uint32_t)g_webhook_ctx.count;
+    pthread_mutex_unlock(&g_webhook_ctx.mutex);
+
+    return WEBHOOK_OK;
+}
+
+void webhook_dispatcher_cleanup(void) {
+    if (!g_webhook_ctx.initialized) {
+        return;
+    }
+
+    if (g_webhook_ctx.running) {
+        pthread_mutex_lock(&g_webhook_ctx.mutex);
+        g_webhook_ctx.stopping = true;
+        pthread_cond_broadcast(&g_webhook_ctx.cond);
+        pthread_mutex_unlock(&g_webhook_ctx.mutex);
+
+        pthread_join(g_webhook_ctx.thread, NULL);
+    }
+
+    for (int i = 0; i < g_webhook_ctx.endpoint_count; i++) {
+        close_conn(&g_webhook_ctx.endpoints[i]);
+    }
+
+    pthread_cond_destroy(&g_webhook_ctx.cond);
+    pthread_mutex_destroy(&g_webhook_ctx.mutex);
+
+    memset(&g_webhook_ctx, 0, sizeof(webhook_dispatcher_context_t));
+}
+
+/* ============================================================
+ *  Encoding / Parsing
+ * ============================================================ */
+
+int webhook_parse_url(const char *url, webhook_endpoint_t *endpoint) {
+    if (url == NULL || endpoint == NULL || strncmp(url, "http://", 7) != 0) {
+        return WEBHOOK_ERROR_INVALID_PARAM;
+    }
+
+    const char *host = url + 7;
+    const char *path = strchr(host, '/');
+    size_t authority_len = (path != NULL) ? (size_t)(path - host) : strlen(host);
+
+    const char *colon = memchr(host, ':', authority_len);
+    size_t host_len = (colon != NULL) ? (size_t)(colon - host) : authority_len;
+
+    if (host_len == 0 || host_len >= sizeof(endpoint->host)) {
+        return WEBHOOK_ERROR_INVALID_PARAM;
+    }
+
+    memset(endpoint, 0, sizeof(webhook_endpoint_t));
+    memcpy(endpoint->host, host, host_len);
+    endpoint->port = 80;
+
+    if (colon != NULL) {
+        long port = strtol(colon + 1, NULL, 10);
+        if (port <= 0 || port > 65535) {
+            return WEBHOOK_ERROR_INVALID_PARAM;
+        }
+        endpoint->port = (uint16_t)port;
+    }
+
+    if (path == NULL) {
+        path = "/";
+    }
+    if (strlen(path) >= sizeof(endpoint->path)) {
+        return WEBHOOK_ERROR_INVALID_PARAM;
+    }
+    snprintf(endpoint->path, sizeof(endpoint->path), "%s", path);
+
+    return WEBHOOK_OK;
+}
+
+int webhook_build_body(const webhook_event_t *events, int count, char *buf, size_t size) {
+    if (events == NULL || buf == NULL || count <= 0 || size < 3) {
+        return WEBHOOK_ERROR_INVALID_PARAM;
+    }
+
+    size_t len = 0;
+    buf[len++] = '[';
+
+    for (int i = 0; i < count; i++) {
+        int n = snprintf(buf + len, size - len,
+                         "%s{\"seq\":%u,\"type\":\"%s\",\"timestamp\":%lld,\"data\":%s}",
+                         (i > 0) ? "," : "", events[i].seq, events[i].type,
+                         (long long)events[i].timestamp, events[i].data);
+        if (n < 0 || (size_t)n >= size - len) {
+            return WEBHOOK_ERROR_NO_SPACE;
+        }
+        len += (size_t)n;
+    }
+
+    if (len + 2 > size) {
+        return WEBHOOK_ERROR_NO_SPACE;
+    }
+    buf[len++] = ']';
+    buf[len] = '\0';
+
+    return (int)len;
+}
+
+int webhook_build_request(const webhook_endpoint_t *endpoint, const char *body,
+                          char *buf, size_t size) {
+    if (endpoint == NULL || body == NULL || buf == NULL) {
+        return WEBHOOK_ERROR_INVALID_PARAM;
+    }
+
+    int n = snprintf(buf, size,
+                     "POST %s HTTP/1.1\r\n"
+                     "Host: %s:%u\r\n"
+                     "User-Agent: gaming-server\r\n"
+                     "Content-Type: application/json\r\n"
+                     "Content-Length: %zu\r\n"
+                     "Connection: keep-alive\r\n"
+                     "\r\n"
+                     "%s",
+                     endpoint->path, endpoint->host, endpoint->port,
+                     strlen(body), body);
+
+    if (n < 0 || (size_t)n >= size) {
+        return WEBHOOK_ERROR_NO_SPACE;
+    }
+
+    return n;
+}
+
+int webhook_parse_response(const char *buf, size_t *content_length, bool *keep_alive) {
+    if (buf == NULL || content_length == NULL || keep_alive == NULL) {
+        return WEBHOOK_ERROR_INVALID_PARAM;
+    }
+
+    int major = 0;
+    int minor = 0;
+    int status = 0;
+    if (sscanf(buf, "HTTP/%d.%d %d", &major, &minor, &status) != 3 ||
+        status < 100 || status > 599) {
+        return WEBHOOK_ERROR_INVALID_PARAM;
+    }
+
+    *content_length = 0;
+    *keep_alive = (major > 1 || (major == 1 && minor >= 1));
+
+    const char *line = strstr(buf, "\r\n");
+    while (line != NULL) {
+        line += 2;
+        if (strncmp(line, "\r\n", 2) == 0) {
+            break;  // End of headers
+        }
+
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            *content_length = (size_t)strtoul(line + 15, NULL, 10);
+        } else if (strncasecmp(line, "Connection:", 11) == 0) {
+            const char *value = line + 11;
+            while (*value == ' ') {
+                value++;
+            }
+            if (strncasecmp(value, "close", 5) == 0) {
+                *keep_alive = false;
+            } else if (strncasecmp(value, "keep-alive", 10) == 0) {
+                *keep_alive = true;
+            }
+        }
+
+        line = strstr(line, "\r\n");
+    }
+
+    return status;
+}
+
+/* ============================================================
+ *  String Conversion Functions
+ * ============================================================ */
+
+const char* webhook_dispatcher_error_string(int error) {
+    switch (error) {
+        case WEBHOOK_OK:                    return "OK";
+        case WEBHOOK_ERROR_NOT_INIT:        return "Not initialized";
+        case WEBHOOK_ERROR_INVALID_PARAM:   return "Invalid parameter";
+        case WEBHOOK_ERROR_NO_SPACE:        return "No space";
+        case WEBHOOK_ERROR_THREAD:          return "Thread error";
+        case WEBHOOK_ERROR_UNKNOWN:         return "Unknown error";
+        default:                            return "Invalid error code";
+    }
+}
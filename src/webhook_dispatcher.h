@@ -0,0 +1,189 @@
+/**
+ * @file webhook_dispatcher.h
+ * @brief Webhook Dispatcher - Push PS5 change events to HTTP endpoints
+ *
+ * Events are queued from the main loop without blocking and delivered by
+ * a worker thread:
+ *
+ *   - Bounded queue; when full the oldest event is dropped
+ *   - Events arriving within WEBHOOK_COALESCE_MS are sent as one POST
+ *     carrying a JSON array
+ *   - One keep-alive HTTP/1.1 connection per endpoint
+ *   - Failed deliveries are retried with exponential backoff
+ *
+ * Only plain http:// endpoints on the local network are supported.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef WEBHOOK_DISPATCHER_H
+#define WEBHOOK_DISPATCHER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define WEBHOOK_OK                      0
+#define WEBHOOK_ERROR_NOT_INIT         -1
+#define WEBHOOK_ERROR_INVALID_PARAM    -2
+#define WEBHOOK_ERROR_NO_SPACE         -3
+#define WEBHOOK_ERROR_THREAD           -4
+#define WEBHOOK_ERROR_UNKNOWN          -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define WEBHOOK_MAX_ENDPOINTS           4
+#define WEBHOOK_QUEUE_SIZE              64      /**< Queued events */
+#define WEBHOOK_BATCH_MAX               16      /**< Events per POST */
+#define WEBHOOK_COALESCE_MS             200     /**< Burst collection window */
+#define WEBHOOK_IO_TIMEOUT_SEC          5
+#define WEBHOOK_MAX_RETRIES             4
+#define WEBHOOK_BACKOFF_MIN_SEC         1
+#define WEBHOOK_BACKOFF_MAX_SEC         30
+#define WEBHOOK_HOST_MAX_LEN            64
+#define WEBHOOK_PATH_MAX_LEN            128
+#define WEBHOOK_TYPE_MAX_LEN            24
+#define WEBHOOK_DATA_MAX_LEN            256
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Parsed endpoint URL
+ */
+typedef struct {
+    char host[WEBHOOK_HOST_MAX_LEN];    /**< Host name or address */
+    uint16_t port;                      /**< TCP port */
+    char path[WEBHOOK_PATH_MAX_LEN];    /**< Request path */
+} webhook_endpoint_t;
+
+/**
+ * @brief Queued event
+ */
+typedef struct {
+    uint32_t seq;                       /**< Event sequence number */
+    time_t timestamp;                   /**< Event time */
+    char type[WEBHOOK_TYPE_MAX_LEN];    /**< Event type ("cec_state", ...) */
+    char data[WEBHOOK_DATA_MAX_LEN];    /**< JSON object */
+} webhook_event_t;
+
+/**
+ * @brief Delivery statistics
+ */
+typedef struct {
+    uint32_t queued;                    /**< Events currently queued */
+    uint32_t events_sent;               /**< Events delivered */
+    uint32_t batches_sent;              /**< POSTs delivered */
+    uint32_t events_dropped;            /**< Dropped (queue full) */
+    uint32_t batches_failed;            /**< Given up after retries */
+    uint32_t retries;                   /**< Retry attempts */
+    uint32_t connects;                  /**< TCP connections opened */
+} webhook_stats_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Initialize the webhook dispatcher
+ * @return WEBHOOK_OK on success, negative error code on failure
+ */
+int webhook_dispatcher_init(void);
+
+/**
+ * @brief Add a delivery endpoint
+ * @param url Endpoint URL ("http://host[:port]/path")
+ * @return WEBHOOK_OK on success, negative error code on failure
+ */
+int webhook_dispatcher_add_endpoint(const char *url);
+
+/**
+ * @brief Start the delivery worker thread
+ * @return WEBHOOK_OK on success, negative error code on failure
+ */
+int webhook_dispatcher_start(void);
+
+/**
+ * @brief Queue an event (non-blocking)
+ * @param type Event type
+ * @param data_json Event data as a JSON object (NULL for "{}")
+ * @return WEBHOOK_OK on success, negative error code on failure
+ */
+int webhook_dispatcher_notify(const char *type, const char *data_json);
+
+/**
+ * @brief Get delivery statistics
+ * @param stats Pointer to store the statistics
+ * @return WEBHOOK_OK on success, negative error code on failure
+ */
+int webhook_dispatcher_get_stats(webhook_stats_t *stats);
+
+/**
+ * @brief Stop the worker and release resources (queued events are dropped)
+ */
+void webhook_dispatcher_cleanup(void);
+
+/**
+ * @brief Parse an endpoint URL
+ * @param url URL string
+ * @param endpoint Pointer to store the parsed endpoint
+ * @return WEBHOOK_OK on success, negative error code on failure
+ */
+int webhook_parse_url(const char *url, webhook_endpoint_t *endpoint);
+
+/**
+ * @brief Build the JSON array body for a batch
+ * @param events Events
+ * @param count Number of events
+ * @param buf Output buffer
+ * @param size Output buffer size
+ * @return Body length on success, negative error code on failure
+ */
+int webhook_build_body(const webhook_event_t *events, int count, char *buf, size_t size);
+
+/**
+ * @brief Build the HTTP request for a body
+ * @param endpoint Target endpoint
+ * @param body JSON body
+ * @param buf Output buffer
+ * @param size Output buffer size
+ * @return Request length on success, negative error code on failure
+ */
+int webhook_build_request(const webhook_endpoint_t *endpoint, const char *body,
+                          char *buf, size_t size);
+
+/**
+ * @brief Parse an HTTP response header block
+ * @param buf Response bytes (headers must be complete)
+ * @param content_length Pointer to store Content-Length (0 if absent)
+ * @param keep_alive Pointer to store whether the connection stays open
+ * @return HTTP status code, negative error code if malformed
+ */
+int webhook_parse_response(const char *buf, size_t *content_length, bool *keep_alive);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* webhook_dispatcher_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEBHOOK_DISPATCHER_H */
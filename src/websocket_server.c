@@ -10,6 +10,10 @@
 #define _POSIX_C_SOURCE 200809L
 
 #include "websocket_server.h"
+#include "server_clock.h"
+#include "server_trace.h"
+#include "client_acl.h"
+#include "fault_inject.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,11 +29,17 @@
  */
 typedef struct {
     int id;
-    char ip[16];
+    char ip[46];       // INET6_ADDRSTRLEN
     uint16_t port;
     time_t connect_time;
     bool active;
+    uint8_t perms;    // ACL 權限 (CLIENT_ACL_PERM_*)
     void *ws_handle;  // libwebsockets wsi pointer (生產環境用)
+    
+    // 輸出停滯 (0 = 未停滯),期間的訊息依序暫存
+    uint64_t stalled_until_us;
+    char *held[WS_SERVER_HELD_FRAMES_MAX];
+    int held_count;
 } client_connection_t;
 
 /**
@@ -93,6 +103,72 @@ static int find_client_by_id(int client_id) {
     return -1;
 }
 
+/**
+ * @brief 寫出一則訊息到傳輸層
+ */
+static int write_frame(client_connection_t *client, const char *message) {
+#ifdef TESTING
+    // 測試模式: 模擬發送成功
+    (void)client;
+    (void)message;
+    return 0;
+#else
+    if (FAULT_FAIL(FAULT_POINT_CLIENT)) {
+        return -6;  // 注入的發送失敗
+    }
+    
+    // 生產環境: 使用 libwebsockets 發送
+    // lws_write(client->ws_handle, (unsigned char*)message, strlen(message), LWS_WRITE_TEXT);
+    (void)client;
+    (void)message;
+    return 0;
+#endif
+}
+
+/**
+ * @brief 暫存停滯中客戶端的訊息 (滿了丟最舊的)
+ */
+static int hold_frame(client_connection_t *client, const char *message) {
+    char *copy = strdup(message);
+    if (copy == NULL) {
+        return -3;
+    }
+    
+    if (client->held_count == WS_SERVER_HELD_FRAMES_MAX) {
+        free(client->held[0]);
+        memmove(&client->held[0], &client->held[1],
+                (WS_SERVER_HELD_FRAMES_MAX - 1) * sizeof(client->held[0]));
+        client->held_count--;
+    }
+    client->held[client->held_count++] = copy;
+    return 1;
+}
+
+/**
+ * @brief 停滯結束: 依序送出暫存的訊息
+ */
+static void flush_held_frames(client_connection_t *client) {
+    client->stalled_until_us = 0;
+    for (int i = 0; i < client->held_count; i++) {
+        write_frame(client, client->held[i]);
+        free(client->held[i]);
+        client->held[i] = NULL;
+    }
+    client->held_count = 0;
+}
+
+/**
+ * @brief 丟棄客戶端的暫存訊息 (斷線時)
+ */
+static void drop_held_frames(client_connection_t *client) {
+    for (int i = 0; i < client->held_count; i++) {
+        free(client->held[i]);
+        client->held[i] = NULL;
+    }
+    client->held_count = 0;
+    client->stalled_until_us = 0;
+}
+
 /**
  * @brief 解析 JSON 訊息類型
  */
@@ -123,6 +199,8 @@ static ws_message_type_t parse_message_type(const char *json_str) {
         msg_type = WS_MSG_PING;
     } else if (strncmp(type_str, "pong", 4) == 0) {
         msg_type = WS_MSG_PONG;
+    } else if (strncmp(type_str, "stats", 5) == 0) {
+        msg_type = WS_MSG_STATS;
     }
     
     cJSON_Delete(root);
@@ -130,9 +208,8 @@ static ws_message_type_t parse_message_type(const char *json_str) {
 }
 
 /**
- * @brief 建立回應訊息 (預留給生產環境使用)
+ * @brief 建立回應訊息
  */
-__attribute__((unused))
 static char* create_response(const char *type, const char *status, const char *message) {
     cJSON *root = cJSON_CreateObject();
     cJSON_AddStringToObject(root, "type", type);
@@ -152,6 +229,67 @@ static char* create_response(const char *type, const char *status, const char *m
  *  Public Function Implementations
  * ============================================================ */
 
+/**
+ * @brief 接受新連線 (ACL 拒絕的來源只花一次查詢就關閉)
+ */
+int ws_server_accept_client(const char *ip, uint16_t port) {
+    if (!g_server_ctx.initialized || ip == NULL) {
+        return -1;
+    }
+    
+    uint8_t perms = client_acl_check(ip);
+    if (perms == CLIENT_ACL_PERM_NONE) {
+        return -5;  // ACL 拒絕
+    }
+    
+    int slot = find_free_client_slot();
+    if (slot < 0) {
+        return -4;  // 達到最大客戶端數
+    }
+    
+    int client_id = g_server_ctx.next_client_id++;
+    
+    g_server_ctx.clients[slot].id = client_id;
+    snprintf(g_server_ctx.clients[slot].ip, sizeof(g_server_ctx.clients[slot].ip), 
+            "%s", ip);
+    g_server_ctx.clients[slot].port = port;
+    g_server_ctx.clients[slot].connect_time = server_clock_now();
+    g_server_ctx.clients[slot].active = true;
+    g_server_ctx.clients[slot].perms = perms;
+    g_server_ctx.client_count++;
+    
+    // 觸發連線回調
+    if (g_server_ctx.connect_callback) {
+        g_server_ctx.connect_callback(client_id, ip, 
+                                      g_server_ctx.connect_callback_data);
+    }
+    
+    return client_id;
+}
+
+/**
+ * @brief 處理收到的訊息 (先檢查 ACL 權限,再交給訊息處理回調)
+ */
+char* ws_server_handle_message(int client_id, const char *message) {
+    ws_message_type_t msg_type = parse_message_type(message);
+    
+    int client_idx = find_client_by_id(client_id);
+    uint8_t perms = (client_idx >= 0) ? g_server_ctx.clients[client_idx].perms : CLIENT_ACL_PERM_ALL;
+    uint8_t needed = (msg_type == WS_MSG_WAKE_PS5) ? CLIENT_ACL_PERM_WAKE : CLIENT_ACL_PERM_QUERY;
+    
+    if ((perms & needed) == 0) {
+        return create_response(msg_type == WS_MSG_WAKE_PS5 ? "wake_response" : "error",
+                               "denied", "Not permitted from this address");
+    }
+    
+    if (!g_server_ctx.message_handler) {
+        return NULL;
+    }
+    
+    return g_server_ctx.message_handler(client_id, msg_type, message,
+                                        g_server_ctx.message_handler_data);
+}
+
 /**
  * @brief 初始化 WebSocket Server
  */
@@ -220,6 +358,12 @@ int ws_server_start(void) {
     // info.port = g_server_ctx.port;
     // info.protocols = protocols;
     // g_server_ctx.lws_context = lws_create_context(&info);
+    
+    // 尚無網路傳輸層: 沒有連線會經過 ws_server_accept_client(),ACL 不會生效
+    if (client_acl_is_active()) {
+        fprintf(stderr, "[WebSocket] Warning: no network transport in this build, "
+                        "client ACL (--acl) is not enforced\n");
+    }
 #endif
     
     g_server_ctx.state = WS_SERVER_RUNNING;
@@ -234,8 +378,17 @@ int ws_server_service(int timeout_ms) {
         return -1;
     }
     
+    // 停滯結束的客戶端補送暫存的訊息
+    uint64_t now = server_clock_monotonic_us();
+    for (int i = 0; i < WS_SERVER_MAX_CLIENTS; i++) {
+        client_connection_t *client = &g_server_ctx.clients[i];
+        if (client->active && client->stalled_until_us != 0 && now >= client->stalled_until_us) {
+            flush_held_frames(client);
+        }
+    }
+    
 #ifdef TESTING
-    // 測試模式: 什麼都不做
+    // 測試模式: 沒有傳輸層事件
     (void)timeout_ms;
     return 0;
 #else
@@ -263,6 +416,7 @@ int ws_server_broadcast(const char *message) {
         }
     }
     
+    SERVER_TRACE2(broadcast, sent_count, strlen(message));
     return sent_count;
 }
 
@@ -279,15 +433,42 @@ int ws_server_send(int client_id, const char *message) {
         return -2;  // 客戶端不存在
     }
     
-#ifdef TESTING
-    // 測試模式: 模擬發送成功
-    return 0;
-#else
-    // 生產環境: 使用 libwebsockets 發送
-    // client_connection_t *client = &g_server_ctx.clients[client_idx];
-    // lws_write(client->ws_handle, (unsigned char*)message, strlen(message), LWS_WRITE_TEXT);
+    client_connection_t *client = &g_server_ctx.clients[client_idx];
+    
+    // 注入的停滯只停住這個客戶端的輸出,主執行緒不睡眠
+    if (client->stalled_until_us == 0) {
+        uint32_t stall_ms = FAULT_STALL_MS(FAULT_POINT_CLIENT);
+        if (stall_ms > 0) {
+            ws_server_stall_client(client_id, stall_ms);
+        }
+    }
+    
+    if (client->stalled_until_us != 0) {
+        return hold_frame(client, message);
+    }
+    
+    return write_frame(client, message);
+}
+
+/**
+ * @brief 讓客戶端的輸出停滯一段時間
+ */
+int ws_server_stall_client(int client_id, uint32_t stall_ms) {
+    if (!g_server_ctx.initialized) {
+        return -1;
+    }
+    
+    int client_idx = find_client_by_id(client_id);
+    if (client_idx < 0) {
+        return -2;  // 客戶端不存在
+    }
+    
+    client_connection_t *client = &g_server_ctx.clients[client_idx];
+    uint64_t until = server_clock_monotonic_us() + (uint64_t)stall_ms * 1000ULL;
+    if (until > client->stalled_until_us) {
+        client->stalled_until_us = until;
+    }
     return 0;
-#endif
 }
 
 /**
@@ -314,6 +495,7 @@ int ws_server_get_clients(ws_client_info_t *clients, int max_count) {
             clients[count].port = g_server_ctx.clients[i].port;
             clients[count].connect_time = g_server_ctx.clients[i].connect_time;
             clients[count].active = g_server_ctx.clients[i].active;
+            clients[count].stalled = (g_server_ctx.clients[i].stalled_until_us != 0);
             count++;
         }
     }
@@ -365,6 +547,7 @@ void ws_server_stop(void) {
                     g_server_ctx.disconnect_callback_data
                 );
             }
+            drop_held_frames(&g_server_ctx.clients[i]);
             g_server_ctx.clients[i].active = false;
         }
     }
@@ -381,6 +564,9 @@ void ws_server_cleanup(void) {
         ws_server_stop();
     }
     
+    for (int i = 0; i < WS_SERVER_MAX_CLIENTS; i++) {
+        drop_held_frames(&g_server_ctx.clients[i]);
+    }
     memset(&g_server_ctx, 0, sizeof(ws_server_context_t));
 }
 
@@ -394,6 +580,7 @@ const char* ws_message_type_to_string(ws_message_type_t msg_type) {
         case WS_MSG_WAKE_PS5:   return "wake_ps5";
         case WS_MSG_PING:       return "ping";
         case WS_MSG_PONG:       return "pong";
+        case WS_MSG_STATS:      return "stats";
         default:                return "invalid";
     }
 }
@@ -422,6 +609,8 @@ const char* ws_server_error_string(int error) {
         case -2: return "Client not found";
         case -3: return "Server not running";
         case -4: return "Max clients reached";
+        case -5: return "Rejected by ACL";
+        case -6: return "Send failed";
         default: return "Unknown error";
     }
 }
@@ -436,32 +625,7 @@ const char* ws_server_error_string(int error) {
  * @brief 模擬客戶端連線 (測試用)
  */
 int ws_server_test_add_client(const char *ip, uint16_t port) {
-    if (!g_server_ctx.initialized) {
-        return -1;
-    }
-    
-    int slot = find_free_client_slot();
-    if (slot < 0) {
-        return -4;  // 達到最大客戶端數
-    }
-    
-    int client_id = g_server_ctx.next_client_id++;
-    
-    g_server_ctx.clients[slot].id = client_id;
-    snprintf(g_server_ctx.clients[slot].ip, sizeof(g_server_ctx.clients[slot].ip), 
-            "%s", ip);
-    g_server_ctx.clients[slot].port = port;
-    g_server_ctx.clients[slot].connect_time = time(NULL);
-    g_server_ctx.clients[slot].active = true;
-    g_server_ctx.client_count++;
-    
-    // 觸發連線回調
-    if (g_server_ctx.connect_callback) {
-        g_server_ctx.connect_callback(client_id, ip, 
-                                      g_server_ctx.connect_callback_data);
-    }
-    
-    return client_id;
+    return ws_server_accept_client(ip, port);
 }
 
 /**
@@ -473,6 +637,7 @@ int ws_server_test_remove_client(int client_id) {
         return -2;
     }
     
+    drop_held_frames(&g_server_ctx.clients[client_idx]);
     g_server_ctx.clients[client_idx].active = false;
     g_server_ctx.client_count--;
     
@@ -489,14 +654,7 @@ int ws_server_test_remove_client(int client_id) {
  * @brief 模擬接收訊息 (測試用)
  */
 char* ws_server_test_handle_message(int client_id, const char *message) {
-    if (!g_server_ctx.message_handler) {
-        return NULL;
-    }
-    
-    ws_message_type_t msg_type = parse_message_type(message);
-    
-    return g_server_ctx.message_handler(client_id, msg_type, message,
-                                        g_server_ctx.message_handler_data);
+    return ws_server_handle_message(client_id, message);
 }
 
 #endif // TESTING
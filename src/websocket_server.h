@@ -43,6 +43,9 @@ extern "C" {
 /** 最大訊息大小 (bytes) */
 #define WS_SERVER_MAX_MESSAGE_SIZE      4096
 
+/** 客戶端停滯期間暫存的訊息數 (滿了丟最舊的) */
+#define WS_SERVER_HELD_FRAMES_MAX       8
+
 /** Ping 間隔 (毫秒) */
 #define WS_SERVER_PING_INTERVAL_MS      30000
 
@@ -69,10 +72,11 @@ typedef enum {
  */
 typedef struct {
     int id;                     /**< 客戶端 ID */
-    char ip[16];                /**< IP 位址 */
+    char ip[46];                /**< IP 位址 (IPv4 或 IPv6) */
     uint16_t port;              /**< 端口 */
     time_t connect_time;        /**< 連線時間 */
     bool active;                /**< 是否活躍 */
+    bool stalled;               /**< 輸出停滯中,訊息暫存待送 */
 } ws_client_info_t;
 
 /**
@@ -84,6 +88,7 @@ typedef enum {
     WS_MSG_WAKE_PS5,            /**< 喚醒 PS5 */
     WS_MSG_PING,                /**< Ping */
     WS_MSG_PONG,                /**< Pong */
+    WS_MSG_STATS,               /**< 查詢執行統計 (metrics) */
 } ws_message_type_t;
 
 /**
@@ -187,12 +192,49 @@ int ws_server_broadcast(const char *message);
 /**
  * @brief 發送訊息給特定客戶端
  * 
+ * 客戶端停滯中時訊息先暫存,停滯結束後由 ws_server_service() 依序送出。
+ * 
  * @param client_id 客戶端 ID
  * @param message 訊息內容 (JSON 字串)
- * @return 0 成功, <0 失敗
+ * @return 0 成功, 1 已暫存 (客戶端停滯中), <0 失敗
  */
 int ws_server_send(int client_id, const char *message);
 
+/**
+ * @brief 讓客戶端的輸出停滯一段時間 (模擬慢速客戶端)
+ * 
+ * 只影響這個客戶端: 期間的訊息暫存 (最多 WS_SERVER_HELD_FRAMES_MAX 則),
+ * 主循環照常運作。故障注入的 client.stall 經由此處生效。
+ * 
+ * @param client_id 客戶端 ID
+ * @param stall_ms 停滯時間 (毫秒),從現在起算;已停滯時取較晚的截止時間
+ * @return 0 成功, -1 未初始化, -2 客戶端不存在
+ */
+int ws_server_stall_client(int client_id, uint32_t stall_ms);
+
+/**
+ * @brief 接受新連線 (傳輸層在 accept 之後、握手之前呼叫)
+ * 
+ * 先以 client_acl 檢查來源,拒絕的來源不佔用客戶端槽位也不觸發回調。
+ * libwebsockets 由 LWS_CALLBACK_FILTER_NETWORK_CONNECTION 呼叫 (回傳 <0 即關閉)。
+ * 
+ * @param ip 來源 IP
+ * @param port 來源端口
+ * @return 客戶端 ID, -1 未初始化, -4 客戶端已滿, -5 ACL 拒絕
+ */
+int ws_server_accept_client(const char *ip, uint16_t port);
+
+/**
+ * @brief 處理收到的訊息 (傳輸層收到完整訊息時呼叫)
+ * 
+ * 先檢查該連線的 ACL 權限,再交給訊息處理回調。
+ * 
+ * @param client_id 客戶端 ID
+ * @param message 訊息內容 (JSON 字串)
+ * @return 要回覆的訊息 (呼叫者以 free() 釋放), NULL 表示不回應
+ */
+char* ws_server_handle_message(int client_id, const char *message);
+
 /**
  * @brief 取得連線的客戶端數量
  * 
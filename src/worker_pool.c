@@ -0,0 +1,417 @@
+/**
+ * @file worker_pool.c
+ * @brief Worker Pool Implementation
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+
+#include "worker_pool.h"
+#include "server_clock.h"
+#include "thread_policy.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <pthread.h>
+
+// Linux headers
+#include <sys/eventfd.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define EWMA_SHIFT              3       // avg += (sample - avg) / 8
+
+/* ============================================================
+ *  Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    bool in_use;
+    worker_job_fn job;
+    worker_done_fn done;
+    void *arg;
+    uint64_t submitted_us;
+    uint64_t deadline_us;               // 0 = none
+    int result;
+} worker_job_t;
+
+typedef struct {
+    bool initialized;
+    bool started;
+    bool stopping;
+    int thread_count;
+    pthread_t threads[WORKER_POOL_MAX_THREADS];
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    // Every job holds one slot from submit until its done callback has run
+    worker_job_t jobs[WORKER_POOL_QUEUE_SIZE];
+    int in_use;
+
+    // FIFOs of slot indices
+    int pending[WORKER_POOL_QUEUE_SIZE];
+    int pending_head;
+    int pending_count;
+    int finished[WORKER_POOL_QUEUE_SIZE];
+    int finished_head;
+    int finished_count;
+
+    int event_fd;                       // Signalled when a job finishes
+    worker_pool_stats_t stats;
+} worker_pool_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static worker_pool_context_t g_pool_ctx = { .event_fd = -1 };
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+/**
+ * @brief Smooth a sample into an average (same EWMA as the ARP prober)
+ */
+static void update_avg(uint32_t *avg, uint32_t sample) {
+    if (*avg == 0) {
+        *avg = sample;
+    } else {
+        int32_t delta = (int32_t)sample - (int32_t)*avg;
+        *avg = (uint32_t)((int32_t)*avg + delta / (1 << EWMA_SHIFT));
+    }
+}
+
+/**
+ * @brief Queue a finished slot for worker_pool_process() (mutex held)
+ */
+static void push_finished(int slot) {
+    int tail = (g_pool_ctx.finished_head + g_pool_ctx.finished_count) % WORKER_POOL_QUEUE_SIZE;
+    g_pool_ctx.finished[tail] = slot;
+    g_pool_ctx.finished_count++;
+}
+
+/**
+ * @brief Wake the main loop
+ */
+static void signal_event_fd(void) {
+    uint64_t one = 1;
+    ssize_t n = write(g_pool_ctx.event_fd, &one, sizeof(one));
+    (void)n;    // EAGAIN: already signalled
+}
+
+#ifndef TESTING
+/**
+ * @brief Worker thread: run jobs until stopped and the queue is empty
+ */
+static void* worker_main(void *arg) {
+    (void)arg;
+    thread_policy_apply(THREAD_CLASS_WORKER);
+
+    for (;;) {
+        pthread_mutex_lock(&g_pool_ctx.mutex);
+        while (g_pool_ctx.pending_count == 0 && !g_pool_ctx.stopping) {
+            pthread_cond_wait(&g_pool_ctx.cond, &g_pool_ctx.mutex);
+        }
+        bool quit = (g_pool_ctx.pending_count == 0);
+        pthread_mutex_unlock(&g_pool_ctx.mutex);
+
+        if (quit) {
+            break;
+        }
+        worker_pool_run_one();
+    }
+
+    return NULL;
+}
+#endif
+
+/* ============================================================
+ *  Public API Implementation
+ * ============================================================ */
+
+int worker_pool_init(int threads) {
+    if (g_pool_ctx.initialized) {
+        return WORKER_POOL_ERROR_NOT_INIT;  // Already initialized
+    }
+
+    if (threads < 0 || threads > WORKER_POOL_MAX_THREADS) {
+        return WORKER_POOL_ERROR_INVALID_PARAM;
+    }
+
+    memset(&g_pool_ctx, 0, sizeof(worker_pool_context_t));
+    g_pool_ctx.thread_count = (threads == 0) ? WORKER_POOL_DEFAULT_THREADS : threads;
+
+    g_pool_ctx.event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (g_pool_ctx.event_fd < 0) {
+        return WORKER_POOL_ERROR_UNKNOWN;
+    }
+
+    pthread_mutex_init(&g_pool_ctx.mutex, NULL);
+    pthread_cond_init(&g_pool_ctx.cond, NULL);
+
+    g_pool_ctx.initialized = true;
+    return WORKER_POOL_OK;
+}
+
+int worker_pool_start(void) {
+    if (!g_pool_ctx.initialized) {
+        return WORKER_POOL_ERROR_NOT_INIT;
+    }
+
+    if (g_pool_ctx.started) {
+        return WORKER_POOL_OK;
+    }
+
+    #ifndef TESTING
+    int created = 0;
+    for (; created < g_pool_ctx.thread_count; created++) {
+        if (pthread_create(&g_pool_ctx.threads[created], NULL, worker_main, NULL) != 0) {
+            break;
+        }
+    }
+
+    if (created == 0) {
+        return WORKER_POOL_ERROR_THREAD;
+    }
+    if (created < g_pool_ctx.thread_count) {
+        fprintf(stderr, "[Workers] Only %d of %d threads started\n", created, g_pool_ctx.thread_count);
+    }
+    g_pool_ctx.thread_count = created;
+
+    pthread_mutex_lock(&g_pool_ctx.mutex);
+    g_pool_ctx.stats.threads = (uint32_t)created;
+    pthread_mutex_unlock(&g_pool_ctx.mutex);
+
+    fprintf(stdout, "[Workers] %d thread(s) started\n", created);
+    #endif
+
+    g_pool_ctx.started = true;
+    return WORKER_POOL_OK;
+}
+
+int worker_pool_submit(worker_job_fn job, worker_done_fn done, void *arg, uint32_t deadline_ms) {
+    if (!g_pool_ctx.initialized) {
+        return WORKER_POOL_ERROR_NOT_INIT;
+    }
+
+    if (job == NULL) {
+        return WORKER_POOL_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&g_pool_ctx.mutex);
+
+    if (g_pool_ctx.in_use >= WORKER_POOL_QUEUE_SIZE) {
+        g_pool_ctx.stats.rejected++;
+        pthread_mutex_unlock(&g_pool_ctx.mutex);
+        return WORKER_POOL_ERROR_FULL;
+    }
+
+    int slot = 0;
+    while (g_pool_ctx.jobs[slot].in_use) {
+        slot++;
+    }
+
+    uint64_t now = server_clock_monotonic_us();
+    worker_job_t *entry = &g_pool_ctx.jobs[slot];
+    entry->in_use = true;
+    entry->job = job;
+    entry->done = done;
+    entry->arg = arg;
+    entry->submitted_us = now;
+    entry->deadline_us = (deadline_ms > 0) ? now + (uint64_t)deadline_ms * 1000 : 0;
+    entry->result = WORKER_POOL_OK;
+    g_pool_ctx.in_use++;
+
+    int tail = (g_pool_ctx.pending_head + g_pool_ctx.pending_count) % WORKER_POOL_QUEUE_SIZE;
+    g_pool_ctx.pending[tail] = slot;
+    g_pool_ctx.pending_count++;
+
+    g_pool_ctx.stats.submitted++;
+    if ((uint32_t)g_pool_ctx.pending_count > g_pool_ctx.stats.max_queued) {
+        g_pool_ctx.stats.max_queued = (uint32_t)g_pool_ctx.pending_count;
+    }
+
+    pthread_cond_signal(&g_pool_ctx.cond);
+    pthread_mutex_unlock(&g_pool_ctx.mutex);
+
+    return WORKER_POOL_OK;
+}
+
+int worker_pool_run_one(void) {
+    if (!g_pool_ctx.initialized) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&g_pool_ctx.mutex);
+
+    if (g_pool_ctx.pending_count == 0) {
+        pthread_mutex_unlock(&g_pool_ctx.mutex);
+        return 0;
+    }
+
+    int slot = g_pool_ctx.pending[g_pool_ctx.pending_head];
+    g_pool_ctx.pending_head = (g_pool_ctx.pending_head + 1) % WORKER_POOL_QUEUE_SIZE;
+    g_pool_ctx.pending_count--;
+
+    worker_job_t *entry = &g_pool_ctx.jobs[slot];
+    uint64_t start = server_clock_monotonic_us();
+    uint32_t wait_us = (uint32_t)(start - entry->submitted_us);
+
+    update_avg(&g_pool_ctx.stats.wait_avg_us, wait_us);
+    if (wait_us > g_pool_ctx.stats.wait_max_us) {
+        g_pool_ctx.stats.wait_max_us = wait_us;
+    }
+
+    if (entry->deadline_us != 0 && start > entry->deadline_us) {
+        // Too late to be useful; let the owner know without running it
+        entry->result = WORKER_POOL_ERROR_EXPIRED;
+        g_pool_ctx.stats.expired++;
+        push_finished(slot);
+        pthread_mutex_unlock(&g_pool_ctx.mutex);
+        signal_event_fd();
+        return 1;
+    }
+
+    worker_job_fn job = entry->job;
+    void *arg = entry->arg;
+    g_pool_ctx.stats.running++;
+    pthread_mutex_unlock(&g_pool_ctx.mutex);
+
+    int result = job(arg);
+    uint64_t end = server_clock_monotonic_us();
+
+    pthread_mutex_lock(&g_pool_ctx.mutex);
+    entry->result = result;
+    g_pool_ctx.stats.running--;
+    g_pool_ctx.stats.completed++;
+    update_avg(&g_pool_ctx.stats.run_avg_us, (uint32_t)(end - start));
+    push_finished(slot);
+    pthread_mutex_unlock(&g_pool_ctx.mutex);
+
+    signal_event_fd();
+    return 1;
+}
+
+int worker_pool_get_event_fd(void) {
+    return g_pool_ctx.event_fd;
+}
+
+int worker_pool_process(void) {
+    if (!g_pool_ctx.initialized) {
+        return WORKER_POOL_ERROR_NOT_INIT;
+    }
+
+    // Reset the wakeup before draining, so a job finishing meanwhile re-arms it
+    uint64_t count;
+    ssize_t n = read(g_pool_ctx.event_fd, &count, sizeof(count));
+    (void)n;
+
+    int delivered = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&g_pool_ctx.mutex);
+        if (g_pool_ctx.finished_count == 0) {
+            pthread_mutex_unlock(&g_pool_ctx.mutex);
+            break;
+        }
+
+        int slot = g_pool_ctx.finished[g_pool_ctx.finished_head];
+        g_pool_ctx.finished_head = (g_pool_ctx.finished_head + 1) % WORKER_POOL_QUEUE_SIZE;
+        g_pool_ctx.finished_count--;
+
+        worker_job_t entry = g_pool_ctx.jobs[slot];
+        memset(&g_pool_ctx.jobs[slot], 0, sizeof(worker_job_t));
+        g_pool_ctx.in_use--;
+        pthread_mutex_unlock(&g_pool_ctx.mutex);
+
+        // Outside the lock: the callback may submit the next job
+        if (entry.done != NULL) {
+            entry.done(entry.result, entry.arg);
+        }
+        delivered++;
+    }
+
+    return delivered;
+}
+
+bool worker_pool_is_ready(void) {
+    return g_pool_ctx.initialized;
+}
+
+int worker_pool_get_stats(worker_pool_stats_t *stats) {
+    if (!g_pool_ctx.initialized) {
+        return WORKER_POOL_ERROR_NOT_INIT;
+    }
+
+    if (stats == NULL) {
+        return WORKER_POOL_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&g_pool_ctx.mutex);
+    *stats = g_pool_ctx.stats;
+    stats->queued = (uint32_t)g_pool_ctx.pending_count;
+    pthread_mutex_unlock(&g_pool_ctx.mutex);
+
+    return WORKER_POOL_OK;
+}
+
+void worker_pool_cleanup(void) {
+    if (!g_pool_ctx.initialized) {
+        return;
+    }
+
+    #ifndef TESTING
+    if (g_pool_ctx.started) {
+        // Workers drain the queue before they exit
+        pthread_mutex_lock(&g_pool_ctx.mutex);
+        g_pool_ctx.stopping = true;
+        pthread_cond_broadcast(&g_pool_ctx.cond);
+        pthread_mutex_unlock(&g_pool_ctx.mutex);
+
+        for (int i = 0; i < g_pool_ctx.thread_count; i++) {
+            pthread_join(g_pool_ctx.threads[i], NULL);
+        }
+        g_pool_ctx.started = false;
+    }
+    #endif
+
+    // Anything left runs here (no threads, or done callbacks that queued more)
+    do {
+        while (worker_pool_run_one() > 0) {
+        }
+    } while (worker_pool_process() > 0);
+
+    close(g_pool_ctx.event_fd);
+    pthread_cond_destroy(&g_pool_ctx.cond);
+    pthread_mutex_destroy(&g_pool_ctx.mutex);
+
+    memset(&g_pool_ctx, 0, sizeof(worker_pool_context_t));
+    g_pool_ctx.event_fd = -1;
+}
+
+const char* worker_pool_error_string(int error) {
+    switch (error) {
+        case WORKER_POOL_OK:                    return "OK";
+        case WORKER_POOL_ERROR_NOT_INIT:        return "Not initialized";
+        case WORKER_POOL_ERROR_INVALID_PARAM:   return "Invalid parameter";
+        case WORKER_POOL_ERROR_FULL:            return "Queue full";
+        case WORKER_POOL_ERROR_THREAD:          return "Thread error";
+        case WORKER_POOL_ERROR_EXPIRED:         return "Deadline expired";
+        case WORKER_POOL_ERROR_UNKNOWN:         return "Unknown error";
+        default:                                return "Invalid error code";
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * @file worker_pool.h
+ * @brief Worker Pool - Run blocking work off the main loop
+ *
+ * A small fixed set of threads takes jobs from one bounded queue that
+ * any thread may submit to. When a job finishes its completion is queued
+ * and the event fd is signalled; worker_pool_process() then runs the
+ * done callback on the main loop, so modules never need locks of their
+ * own for the result.
+ *
+ *   job       runs on a worker thread, may block (file writes, popen,
+ *             name lookups); must not touch main-loop state
+ *   done      runs from worker_pool_process() with the job's result
+ *   deadline  a job still queued when its deadline passes is not run;
+ *             done gets WORKER_POOL_ERROR_EXPIRED instead
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ *  Error Codes
+ * ============================================================ */
+
+#define WORKER_POOL_OK                  0
+#define WORKER_POOL_ERROR_NOT_INIT     -1
+#define WORKER_POOL_ERROR_INVALID_PARAM -2
+#define WORKER_POOL_ERROR_FULL         -3
+#define WORKER_POOL_ERROR_THREAD       -4
+#define WORKER_POOL_ERROR_EXPIRED      -5
+#define WORKER_POOL_ERROR_UNKNOWN      -99
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define WORKER_POOL_DEFAULT_THREADS     2
+#define WORKER_POOL_MAX_THREADS         8
+#define WORKER_POOL_QUEUE_SIZE          32      /**< Jobs queued, running or awaiting done */
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+/**
+ * @brief Blocking work, runs on a worker thread
+ * @return Result passed to the done callback
+ */
+typedef int (*worker_job_fn)(void *arg);
+
+/**
+ * @brief Completion, runs on the thread calling worker_pool_process()
+ * @param result Job result, or WORKER_POOL_ERROR_EXPIRED if it never ran
+ */
+typedef void (*worker_done_fn)(int result, void *arg);
+
+/**
+ * @brief Statistics
+ */
+typedef struct {
+    uint32_t threads;                   /**< Worker threads running */
+    uint32_t queued;                    /**< Jobs waiting for a worker */
+    uint32_t running;                   /**< Jobs on a worker now */
+    uint32_t max_queued;                /**< Deepest the queue has been */
+    uint32_t submitted;                 /**< Jobs accepted */
+    uint32_t completed;                 /**< Jobs run to the end */
+    uint32_t expired;                   /**< Jobs dropped at their deadline */
+    uint32_t rejected;                  /**< Submits refused (queue full) */
+    uint32_t wait_avg_us;               /**< Smoothed queue wait */
+    uint32_t wait_max_us;               /**< Longest queue wait */
+    uint32_t run_avg_us;                /**< Smoothed job run time */
+} worker_pool_stats_t;
+
+/* ============================================================
+ *  Public Function Declarations
+ * ============================================================ */
+
+/**
+ * @brief Initialize the pool (no threads yet)
+ * @param threads Worker threads, 0 for WORKER_POOL_DEFAULT_THREADS
+ * @return WORKER_POOL_OK on success, negative error code on failure
+ */
+int worker_pool_init(int threads);
+
+/**
+ * @brief Start the worker threads
+ *
+ * In TESTING no thread is created; jobs are run with
+ * worker_pool_run_one().
+ *
+ * @return WORKER_POOL_OK on success, negative error code on failure
+ */
+int worker_pool_start(void);
+
+/**
+ * @brief Queue a job (any thread, non-blocking)
+ * @param job Work to run
+ * @param done Completion (can be NULL)
+ * @param arg Passed to both
+ * @param deadline_ms Latest start after submission, 0 for none
+ * @return WORKER_POOL_OK on success, WORKER_POOL_ERROR_FULL if the queue is full
+ */
+int worker_pool_submit(worker_job_fn job, worker_done_fn done, void *arg, uint32_t deadline_ms);
+
+/**
+ * @brief Run one queued job on the calling thread
+ *
+ * Used by the worker threads; exposed so jobs can be run offline.
+ *
+ * @return 1 if a job was taken, 0 if the queue was empty
+ */
+int worker_pool_run_one(void);
+
+/**
+ * @brief Get the fd that becomes readable when completions are waiting
+ * @return File descriptor, -1 if not initialized
+ */
+int worker_pool_get_event_fd(void);
+
+/**
+ * @brief Run the done callbacks of finished jobs (main loop)
+ * @return Number of completions delivered, negative error code on failure
+ */
+int worker_pool_process(void);
+
+/**
+ * @brief Check whether the pool accepts jobs
+ * @return true if initialized
+ */
+bool worker_pool_is_ready(void);
+
+/**
+ * @brief Get a snapshot of the statistics
+ * @param stats Pointer to store statistics
+ * @return WORKER_POOL_OK on success, negative error code on failure
+ */
+int worker_pool_get_stats(worker_pool_stats_t *stats);
+
+/**
+ * @brief Finish queued jobs, stop the threads and release resources
+ *
+ * Jobs still queued are run and every pending done callback is called
+ * before returning, so their arguments are not leaked.
+ */
+void worker_pool_cleanup(void);
+
+/**
+ * @brief Convert error code to string
+ * @param error Error code
+ * @return Error message string
+ */
+const char* worker_pool_error_string(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WORKER_POOL_H */
@@ -0,0 +1,251 @@
+/**
+ * @file test_arp_prober.c
+ * @brief Unit tests for ARP Prober module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "arp_prober.h"
+#include "neigh_table.h"
+#include "server_clock.h"
+#include <string.h>
+
+#define MAX_RESULTS     8
+
+static arp_result_t g_results[MAX_RESULTS];
+static int g_result_count;
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+static void on_result(const arp_result_t *result, void *user_data) {
+    (void)user_data;
+    if (g_result_count < MAX_RESULTS) {
+        g_results[g_result_count] = *result;
+    }
+    g_result_count++;
+}
+
+void setUp(void) {
+    memset(g_results, 0, sizeof(g_results));
+    g_result_count = 0;
+    arp_prober_cleanup();
+    server_clock_use_fake(1000);
+
+    TEST_ASSERT_EQUAL(ARP_OK, arp_prober_init("192.168.1.0/24"));
+    arp_prober_set_callback(on_result, NULL);
+}
+
+void tearDown(void) {
+    arp_prober_cleanup();
+    server_clock_use_real();
+}
+
+/**
+ * @brief Build an ARP payload from sender_ip (last octet) with a0:..:<octet> MAC
+ */
+static void build_arp(uint8_t *packet, uint8_t op, uint8_t last_octet) {
+    memset(packet, 0, ARP_PACKET_LEN);
+    packet[1] = 1;          // Ethernet
+    packet[2] = 0x08;       // IPv4
+    packet[4] = 6;
+    packet[5] = 4;
+    packet[7] = op;
+    const uint8_t mac[6] = { 0xa0, 0xb1, 0xc2, 0xd3, 0xe4, last_octet };
+    memcpy(packet + 8, mac, 6);
+    packet[14] = 192;
+    packet[15] = 168;
+    packet[16] = 1;
+    packet[17] = last_octet;
+    packet[24] = 192;
+    packet[25] = 168;
+    packet[26] = 1;
+    packet[27] = 1;
+}
+
+static int reply_from(uint8_t last_octet) {
+    uint8_t packet[ARP_PACKET_LEN];
+    build_arp(packet, 2, last_octet);
+    return arp_prober_handle_reply(packet, sizeof(packet));
+}
+
+/* ============================================================
+ *  Test Group 1: Probe Tests
+ * ============================================================ */
+
+void test_arp_probe_answered(void) {
+    arp_stats_t stats;
+
+    TEST_ASSERT_EQUAL(ARP_OK, arp_prober_probe("192.168.1.77", "A0:B1:C2:D3:E4:4D"));
+    server_clock_advance_ms(3);
+    TEST_ASSERT_EQUAL(1, reply_from(77));
+
+    TEST_ASSERT_EQUAL(1, g_result_count);
+    TEST_ASSERT_TRUE(g_results[0].alive);
+    TEST_ASSERT_FALSE(g_results[0].sweep);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.77", g_results[0].ip);
+    TEST_ASSERT_EQUAL_STRING("a0:b1:c2:d3:e4:4d", g_results[0].mac);
+    TEST_ASSERT_EQUAL(3000, g_results[0].rtt_us);
+
+    // Answered probes are done; a late duplicate is not reported
+    TEST_ASSERT_EQUAL(0, reply_from(77));
+
+    TEST_ASSERT_EQUAL(ARP_OK, arp_prober_get_stats(&stats));
+    TEST_ASSERT_EQUAL(1, stats.requests);
+    TEST_ASSERT_EQUAL(1, stats.replies);
+    TEST_ASSERT_EQUAL(1, stats.learned);
+    TEST_ASSERT_EQUAL(3000, stats.rtt_avg_us);
+}
+
+void test_arp_probe_retries_then_times_out(void) {
+    arp_stats_t stats;
+
+    TEST_ASSERT_EQUAL(ARP_OK, arp_prober_probe("192.168.1.77", NULL));
+
+    for (int i = 0; i < ARP_PROBE_ATTEMPTS - 1; i++) {
+        server_clock_advance_ms(ARP_PROBE_TIMEOUT_MS);
+        TEST_ASSERT_EQUAL(0, arp_prober_process());
+    }
+    server_clock_advance_ms(ARP_PROBE_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(1, arp_prober_process());
+
+    TEST_ASSERT_FALSE(g_results[0].alive);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.77", g_results[0].ip);
+    TEST_ASSERT_EQUAL_STRING("", g_results[0].mac);
+
+    arp_prober_get_stats(&stats);
+    TEST_ASSERT_EQUAL(ARP_PROBE_ATTEMPTS, stats.requests);
+    TEST_ASSERT_EQUAL(1, stats.timeouts);
+}
+
+void test_arp_probe_ignores_requests_and_strangers(void) {
+    uint8_t packet[ARP_PACKET_LEN];
+
+    arp_prober_probe("192.168.1.77", NULL);
+
+    // A who-has from the console itself is not an answer
+    build_arp(packet, 1, 77);
+    TEST_ASSERT_EQUAL(0, arp_prober_handle_reply(packet, sizeof(packet)));
+    // Nobody asked .78
+    TEST_ASSERT_EQUAL(0, reply_from(78));
+    // Truncated
+    build_arp(packet, 2, 77);
+    TEST_ASSERT_EQUAL(0, arp_prober_handle_reply(packet, ARP_PACKET_LEN - 1));
+
+    TEST_ASSERT_EQUAL(0, g_result_count);
+}
+
+void test_arp_probe_limits(void) {
+    char ip[16];
+
+    TEST_ASSERT_EQUAL(ARP_ERROR_INVALID_PARAM, arp_prober_probe("192.168.1", NULL));
+    TEST_ASSERT_EQUAL(ARP_ERROR_INVALID_PARAM, arp_prober_probe(NULL, NULL));
+
+    for (int i = 0; i < ARP_MAX_PENDING; i++) {
+        snprintf(ip, sizeof(ip), "192.168.1.%d", 10 + i);
+        TEST_ASSERT_EQUAL(ARP_OK, arp_prober_probe(ip, NULL));
+    }
+    // Same IP again joins the probe in flight
+    TEST_ASSERT_EQUAL(ARP_OK, arp_prober_probe("192.168.1.10", NULL));
+    TEST_ASSERT_EQUAL(ARP_ERROR_BUSY, arp_prober_probe("192.168.1.99", NULL));
+}
+
+void test_arp_get_fd_in_test_mode(void) {
+    // No packet socket in test mode
+    TEST_ASSERT_EQUAL(-1, arp_prober_get_fd());
+}
+
+/* ============================================================
+ *  Test Group 2: Sweep Tests
+ * ============================================================ */
+
+void test_arp_sweep_is_paced(void) {
+    arp_stats_t stats;
+
+    TEST_ASSERT_EQUAL(ARP_OK, arp_prober_sweep());
+    arp_prober_process();
+
+    // Nothing is due until the gap has passed, and bursts are capped
+    arp_prober_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.requests);
+
+    server_clock_advance_ms(1000);
+    arp_prober_process();
+    arp_prober_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1 + ARP_SWEEP_BURST, stats.requests);
+    TEST_ASSERT_TRUE(stats.sweeping);
+
+    // Run to completion: 254 hosts minus this one (.1)
+    for (int i = 0; i < 40; i++) {
+        server_clock_advance_ms(100);
+        arp_prober_process();
+    }
+    arp_prober_get_stats(&stats);
+    TEST_ASSERT_EQUAL(253, stats.requests);
+    TEST_ASSERT_FALSE(stats.sweeping);
+    TEST_ASSERT_EQUAL(1, stats.sweeps);
+}
+
+void test_arp_sweep_reports_each_host_once(void) {
+    TEST_ASSERT_EQUAL(ARP_OK, arp_prober_sweep());
+    for (int i = 0; i < 10; i++) {
+        server_clock_advance_ms(10);
+        arp_prober_process();
+    }
+
+    TEST_ASSERT_EQUAL(1, reply_from(5));
+    TEST_ASSERT_TRUE(g_results[0].sweep);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.5", g_results[0].ip);
+    TEST_ASSERT_EQUAL(0, reply_from(5));
+
+    // Not asked yet
+    TEST_ASSERT_EQUAL(0, reply_from(200));
+    TEST_ASSERT_EQUAL(1, g_result_count);
+}
+
+void test_arp_sweep_does_not_restart(void) {
+    arp_stats_t stats;
+
+    arp_prober_sweep();
+    arp_prober_sweep();
+    arp_prober_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.sweeps);
+}
+
+/* ============================================================
+ *  Test Group 3: Lifecycle Tests
+ * ============================================================ */
+
+void test_arp_init_validates_subnet(void) {
+    arp_prober_cleanup();
+
+    TEST_ASSERT_EQUAL(ARP_ERROR_INVALID_PARAM, arp_prober_init(NULL));
+    TEST_ASSERT_EQUAL(ARP_ERROR_INVALID_PARAM, arp_prober_init("192.168.1.0/33"));
+    TEST_ASSERT_EQUAL(ARP_ERROR_INVALID_PARAM, arp_prober_init("not-a-subnet"));
+    TEST_ASSERT_EQUAL(ARP_OK, arp_prober_init("10.0.0.0/16"));
+    TEST_ASSERT_EQUAL(ARP_ERROR_NOT_INIT, arp_prober_init("10.0.0.0/16"));
+}
+
+void test_arp_not_initialized(void) {
+    arp_stats_t stats;
+
+    arp_prober_cleanup();
+    TEST_ASSERT_EQUAL(ARP_ERROR_NOT_INIT, arp_prober_probe("192.168.1.77", NULL));
+    TEST_ASSERT_EQUAL(ARP_ERROR_NOT_INIT, arp_prober_sweep());
+    TEST_ASSERT_EQUAL(ARP_ERROR_NOT_INIT, arp_prober_process());
+    TEST_ASSERT_EQUAL(ARP_ERROR_NOT_INIT, arp_prober_get_stats(&stats));
+    TEST_ASSERT_EQUAL(0, reply_from(77));
+}
+
+/* ============================================================
+ *  Test Group 4: String Conversion Tests
+ * ============================================================ */
+
+void test_arp_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", arp_prober_error_string(ARP_OK));
+    TEST_ASSERT_EQUAL_STRING("No answer", arp_prober_error_string(ARP_ERROR_TIMEOUT));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", arp_prober_error_string(-50));
+}
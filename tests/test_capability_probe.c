@@ -0,0 +1,127 @@
+/**
+ * @file test_capability_probe.c
+ * @brief Unit tests for Capability Probe module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "capability_probe.h"
+#include "server_clock.h"
+#include <string.h>
+
+static capability_set_t g_caps;
+static capability_report_t g_report;
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    memset(&g_caps, 0, sizeof(g_caps));
+    memset(&g_report, 0xA5, sizeof(g_report));
+}
+
+void tearDown(void) {
+}
+
+/* ============================================================
+ *  Test Group 1: Selection Tests
+ * ============================================================ */
+
+void test_capability_select_nothing_available(void) {
+    capability_probe_select(&g_caps, &g_report);
+
+    TEST_ASSERT_EQUAL(PING_BACKEND_NONE, g_report.ping);
+    TEST_ASSERT_EQUAL(CEC_BACKEND_NONE, g_report.cec);
+    TEST_ASSERT_EQUAL(NEIGH_BACKEND_NONE, g_report.neigh);
+    TEST_ASSERT_EQUAL(LOOP_BACKEND_POLL, g_report.loop);
+}
+
+void test_capability_select_everything_available(void) {
+    memset(&g_caps, 1, sizeof(g_caps));
+    capability_probe_select(&g_caps, &g_report);
+
+    TEST_ASSERT_EQUAL(PING_BACKEND_ARP, g_report.ping);
+    TEST_ASSERT_EQUAL(CEC_BACKEND_IOCTL, g_report.cec);
+    TEST_ASSERT_EQUAL(NEIGH_BACKEND_NETLINK, g_report.neigh);
+    TEST_ASSERT_EQUAL(LOOP_BACKEND_POLL, g_report.loop);
+    TEST_ASSERT_TRUE(g_report.caps.io_uring);
+    TEST_ASSERT_TRUE(g_report.caps.epoll);
+}
+
+void test_capability_select_unprivileged_fallbacks(void) {
+    // Typical non-root build: no ICMP sockets, no CEC node access
+    g_caps.tcp_connect = true;
+    g_caps.ping_command = true;
+    g_caps.cec_ctl = true;
+    g_caps.neigh_proc = true;
+    g_caps.arp_command = true;
+    g_caps.epoll = true;
+    capability_probe_select(&g_caps, &g_report);
+
+    TEST_ASSERT_EQUAL(PING_BACKEND_TCP, g_report.ping);
+    TEST_ASSERT_EQUAL(CEC_BACKEND_COMMAND, g_report.cec);
+    TEST_ASSERT_EQUAL(NEIGH_BACKEND_PROC, g_report.neigh);
+    TEST_ASSERT_EQUAL(LOOP_BACKEND_POLL, g_report.loop);
+}
+
+void test_capability_select_icmp_without_packet_socket(void) {
+    memset(&g_caps, 1, sizeof(g_caps));
+    g_caps.arp_packet = false;
+    capability_probe_select(&g_caps, &g_report);
+
+    TEST_ASSERT_EQUAL(PING_BACKEND_ICMP_DGRAM, g_report.ping);
+}
+
+void test_capability_select_raw_icmp_without_dgram(void) {
+    g_caps.icmp_raw = true;
+    g_caps.tcp_connect = true;
+    capability_probe_select(&g_caps, &g_report);
+
+    TEST_ASSERT_EQUAL(PING_BACKEND_ICMP_RAW, g_report.ping);
+}
+
+void test_capability_select_command_only(void) {
+    g_caps.ping_command = true;
+    g_caps.arp_command = true;
+    capability_probe_select(&g_caps, &g_report);
+
+    TEST_ASSERT_EQUAL(PING_BACKEND_COMMAND, g_report.ping);
+    TEST_ASSERT_EQUAL(NEIGH_BACKEND_COMMAND, g_report.neigh);
+}
+
+/* ============================================================
+ *  Test Group 2: Run Tests
+ * ============================================================ */
+
+void test_capability_probe_run_null_device(void) {
+    TEST_ASSERT_EQUAL(CAP_PROBE_ERROR_INVALID_PARAM, capability_probe_run(NULL, &g_report));
+}
+
+void test_capability_probe_run_stores_report(void) {
+    TEST_ASSERT_EQUAL(CAP_PROBE_OK, capability_probe_run("/dev/cec0", &g_report));
+
+    const capability_report_t *stored = capability_probe_get();
+    TEST_ASSERT_NOT_NULL(stored);
+    TEST_ASSERT_EQUAL(g_report.ping, stored->ping);
+    TEST_ASSERT_EQUAL(g_report.loop, stored->loop);
+}
+
+/* ============================================================
+ *  Test Group 3: String Conversion Tests
+ * ============================================================ */
+
+void test_capability_loop_backend_string(void) {
+    TEST_ASSERT_EQUAL_STRING("poll", capability_loop_backend_string(LOOP_BACKEND_POLL));
+    TEST_ASSERT_EQUAL_STRING("epoll", capability_loop_backend_string(LOOP_BACKEND_EPOLL));
+    TEST_ASSERT_EQUAL_STRING("io_uring", capability_loop_backend_string(LOOP_BACKEND_IO_URING));
+    TEST_ASSERT_EQUAL_STRING("unknown", capability_loop_backend_string((loop_backend_t)99));
+}
+
+void test_capability_probe_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", capability_probe_error_string(CAP_PROBE_OK));
+    TEST_ASSERT_EQUAL_STRING("Invalid parameter", capability_probe_error_string(CAP_PROBE_ERROR_INVALID_PARAM));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", capability_probe_error_string(12345));
+}
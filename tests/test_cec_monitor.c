@@ -9,6 +9,8 @@
 #include "unity.h"
 #include "cec_monitor.h"
 #include <string.h>
+#include <stdint.h>
+#include <unistd.h>
 
 /* ============================================================
  *  Test Fixtures
@@ -238,6 +240,138 @@ void test_cec_monitor_process_after_init(void) {
     TEST_ASSERT_TRUE(result == CEC_OK || result == CEC_ERROR_COMMAND_FAILED);
 }
 
+/* ============================================================
+ *  Test Group 7: Backend Selection Tests
+ * ============================================================ */
+
+void test_cec_monitor_backend_default_is_command(void) {
+    TEST_ASSERT_EQUAL(CEC_BACKEND_COMMAND, cec_monitor_get_backend());
+}
+
+void test_cec_monitor_ioctl_backend_without_device(void) {
+    cec_monitor_set_backend(CEC_BACKEND_IOCTL);
+    cec_monitor_init("/dev/cec-does-not-exist");
+    
+    TEST_ASSERT_EQUAL(CEC_ERROR_COMMAND_FAILED, cec_monitor_process(100));
+    TEST_ASSERT_EQUAL(PS5_POWER_UNKNOWN, cec_monitor_get_power_state());
+    
+    cec_monitor_set_backend(CEC_BACKEND_COMMAND);
+}
+
+void test_cec_backend_to_string(void) {
+    TEST_ASSERT_EQUAL_STRING("none", cec_backend_to_string(CEC_BACKEND_NONE));
+    TEST_ASSERT_EQUAL_STRING("cec-ctl", cec_backend_to_string(CEC_BACKEND_COMMAND));
+    TEST_ASSERT_EQUAL_STRING("ioctl", cec_backend_to_string(CEC_BACKEND_IOCTL));
+}
+
+/* ============================================================
+ *  Test Group 8: Mailbox Tests
+ * ============================================================ */
+
+static void start_mailbox(void) {
+    g_callback_count = 0;
+    g_received_event = CEC_EVENT_NONE;
+    g_received_state = PS5_POWER_UNKNOWN;
+    
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_init("/dev/cec0"));
+    cec_monitor_set_callback(test_callback, NULL);
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_start_thread());
+}
+
+void test_cec_monitor_start_thread_without_init(void) {
+    TEST_ASSERT_EQUAL(CEC_ERROR_NOT_INIT, cec_monitor_start_thread());
+    TEST_ASSERT_EQUAL(-1, cec_monitor_get_event_fd());
+    TEST_ASSERT_EQUAL(CEC_ERROR_NOT_INIT, cec_monitor_dispatch());
+    TEST_ASSERT_EQUAL(CEC_ERROR_NOT_INIT, cec_monitor_post(CEC_EVENT_POWER_ON, PS5_POWER_ON));
+}
+
+void test_cec_monitor_dispatch_runs_callback(void) {
+    start_mailbox();
+    
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_post(CEC_EVENT_STANDBY, PS5_POWER_STANDBY));
+    // Nothing is delivered until the main loop dispatches
+    TEST_ASSERT_EQUAL(0, g_callback_count);
+    
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_dispatch());
+    TEST_ASSERT_EQUAL(1, g_callback_count);
+    TEST_ASSERT_EQUAL(CEC_EVENT_STANDBY, g_received_event);
+    TEST_ASSERT_EQUAL(PS5_POWER_STANDBY, g_received_state);
+    
+    // Drained
+    TEST_ASSERT_EQUAL(CEC_ERROR_TIMEOUT, cec_monitor_dispatch());
+    TEST_ASSERT_EQUAL(1, g_callback_count);
+}
+
+void test_cec_monitor_dispatch_keeps_order(void) {
+    start_mailbox();
+    
+    cec_monitor_post(CEC_EVENT_POWER_ON, PS5_POWER_ON);
+    cec_monitor_post(CEC_EVENT_STANDBY, PS5_POWER_STANDBY);
+    
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_dispatch());
+    TEST_ASSERT_EQUAL(2, g_callback_count);
+    TEST_ASSERT_EQUAL(CEC_EVENT_STANDBY, g_received_event);
+}
+
+void test_cec_monitor_dispatch_reports_latest_outcome(void) {
+    start_mailbox();
+    
+    // Query results without a change do not reach the callback
+    cec_monitor_post(CEC_EVENT_NONE, PS5_POWER_ON);
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_dispatch());
+    
+    cec_monitor_post(CEC_EVENT_NONE, PS5_POWER_ON);
+    cec_monitor_post(CEC_EVENT_ERROR, PS5_POWER_ON);
+    TEST_ASSERT_EQUAL(CEC_ERROR_COMMAND_FAILED, cec_monitor_dispatch());
+    
+    cec_monitor_post(CEC_EVENT_ERROR, PS5_POWER_ON);
+    cec_monitor_post(CEC_EVENT_NONE, PS5_POWER_ON);
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_dispatch());
+    
+    TEST_ASSERT_EQUAL(0, g_callback_count);
+}
+
+void test_cec_monitor_mailbox_full(void) {
+    start_mailbox();
+    
+    for (int i = 0; i < CEC_MAILBOX_SIZE; i++) {
+        TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_post(CEC_EVENT_NONE, PS5_POWER_ON));
+    }
+    TEST_ASSERT_EQUAL(CEC_ERROR_MAILBOX_FULL, cec_monitor_post(CEC_EVENT_POWER_OFF, PS5_POWER_OFF));
+    
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_dispatch());
+    TEST_ASSERT_EQUAL(0, g_callback_count);
+    
+    // Room again after the drain
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_post(CEC_EVENT_POWER_OFF, PS5_POWER_OFF));
+    TEST_ASSERT_EQUAL(CEC_OK, cec_monitor_dispatch());
+    TEST_ASSERT_EQUAL(1, g_callback_count);
+}
+
+void test_cec_monitor_event_fd_signals_posts(void) {
+    uint64_t count = 0;
+    
+    start_mailbox();
+    int fd = cec_monitor_get_event_fd();
+    TEST_ASSERT_TRUE(fd >= 0);
+    
+    // Not readable while empty
+    TEST_ASSERT_EQUAL(-1, (int)read(fd, &count, sizeof(count)));
+    
+    cec_monitor_post(CEC_EVENT_POWER_ON, PS5_POWER_ON);
+    cec_monitor_dispatch();
+    // dispatch() consumed the wakeup
+    TEST_ASSERT_EQUAL(-1, (int)read(fd, &count, sizeof(count)));
+    
+    cec_monitor_post(CEC_EVENT_STANDBY, PS5_POWER_STANDBY);
+    TEST_ASSERT_EQUAL((int)sizeof(count), (int)read(fd, &count, sizeof(count)));
+}
+
+void test_cec_monitor_error_string_mailbox(void) {
+    TEST_ASSERT_EQUAL_STRING("Thread error", cec_monitor_error_string(CEC_ERROR_THREAD));
+    TEST_ASSERT_EQUAL_STRING("Mailbox full", cec_monitor_error_string(CEC_ERROR_MAILBOX_FULL));
+}
+
 /* ============================================================
  *  ⚠️ 重要: 不要有 main() 函數!
  *  Ceedling 會自動生成 test runner (包含 main)
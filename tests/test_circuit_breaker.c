@@ -0,0 +1,158 @@
+/**
+ * @file test_circuit_breaker.c
+ * @brief Unit tests for Circuit Breaker module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "circuit_breaker.h"
+#include "server_clock.h"
+#include <string.h>
+
+static circuit_breaker_t g_cb;
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    server_clock_use_fake(1000000);
+    circuit_breaker_init(&g_cb, "scan", 3, 1000, 8000);
+}
+
+void tearDown(void) {
+    server_clock_use_real();
+}
+
+static void fail_times(int n) {
+    for (int i = 0; i < n; i++) {
+        TEST_ASSERT_TRUE(circuit_breaker_allow(&g_cb));
+        circuit_breaker_record_failure(&g_cb);
+    }
+}
+
+/* ============================================================
+ *  Test Group 1: Lifecycle Tests
+ * ============================================================ */
+
+void test_circuit_breaker_init_rejects_bad_params(void) {
+    circuit_breaker_t cb;
+    TEST_ASSERT_EQUAL(CB_ERROR_INVALID_PARAM, circuit_breaker_init(NULL, "x", 1, 10, 10));
+    TEST_ASSERT_EQUAL(CB_ERROR_INVALID_PARAM, circuit_breaker_init(&cb, NULL, 1, 10, 10));
+    TEST_ASSERT_EQUAL(CB_ERROR_INVALID_PARAM, circuit_breaker_init(&cb, "x", 0, 10, 10));
+    TEST_ASSERT_EQUAL(CB_ERROR_INVALID_PARAM, circuit_breaker_init(&cb, "x", 1, 0, 10));
+    TEST_ASSERT_EQUAL(CB_ERROR_INVALID_PARAM, circuit_breaker_init(&cb, "x", 1, 20, 10));
+}
+
+void test_circuit_breaker_starts_closed(void) {
+    TEST_ASSERT_EQUAL(CB_STATE_CLOSED, circuit_breaker_get_state(&g_cb));
+    TEST_ASSERT_EQUAL_STRING("scan", g_cb.name);
+    TEST_ASSERT_TRUE(circuit_breaker_allow(&g_cb));
+    TEST_ASSERT_EQUAL(0, circuit_breaker_remaining_ms(&g_cb));
+}
+
+void test_circuit_breaker_uninitialized_never_blocks(void) {
+    circuit_breaker_t cb;
+    memset(&cb, 0, sizeof(cb));
+
+    circuit_breaker_record_failure(&cb);
+    TEST_ASSERT_TRUE(circuit_breaker_allow(&cb));
+    TEST_ASSERT_EQUAL(CB_STATE_CLOSED, circuit_breaker_get_state(&cb));
+}
+
+/* ============================================================
+ *  Test Group 2: State Transition Tests
+ * ============================================================ */
+
+void test_circuit_breaker_opens_after_threshold(void) {
+    fail_times(2);
+    TEST_ASSERT_EQUAL(CB_STATE_CLOSED, circuit_breaker_get_state(&g_cb));
+
+    fail_times(1);
+    TEST_ASSERT_EQUAL(CB_STATE_OPEN, circuit_breaker_get_state(&g_cb));
+    TEST_ASSERT_EQUAL(1, g_cb.stats.opens);
+    TEST_ASSERT_EQUAL(1000, circuit_breaker_remaining_ms(&g_cb));
+
+    TEST_ASSERT_FALSE(circuit_breaker_allow(&g_cb));
+    TEST_ASSERT_EQUAL(1, g_cb.stats.rejected);
+}
+
+void test_circuit_breaker_success_resets_failure_count(void) {
+    fail_times(2);
+    circuit_breaker_record_success(&g_cb);
+    fail_times(2);
+
+    TEST_ASSERT_EQUAL(CB_STATE_CLOSED, circuit_breaker_get_state(&g_cb));
+}
+
+void test_circuit_breaker_half_open_allows_single_trial(void) {
+    fail_times(3);
+
+    server_clock_advance_ms(999);
+    TEST_ASSERT_FALSE(circuit_breaker_allow(&g_cb));
+
+    server_clock_advance_ms(1);
+    TEST_ASSERT_TRUE(circuit_breaker_allow(&g_cb));
+    TEST_ASSERT_EQUAL(CB_STATE_HALF_OPEN, circuit_breaker_get_state(&g_cb));
+
+    // Trial outstanding: everything else waits
+    TEST_ASSERT_FALSE(circuit_breaker_allow(&g_cb));
+}
+
+void test_circuit_breaker_trial_success_closes(void) {
+    fail_times(3);
+    server_clock_advance_ms(1000);
+    TEST_ASSERT_TRUE(circuit_breaker_allow(&g_cb));
+
+    circuit_breaker_record_success(&g_cb);
+    TEST_ASSERT_EQUAL(CB_STATE_CLOSED, circuit_breaker_get_state(&g_cb));
+    TEST_ASSERT_TRUE(circuit_breaker_allow(&g_cb));
+}
+
+void test_circuit_breaker_trial_failure_doubles_cooldown(void) {
+    fail_times(3);
+
+    uint32_t expected[] = { 2000, 4000, 8000, 8000 };
+    for (int i = 0; i < 4; i++) {
+        server_clock_advance_ms(circuit_breaker_remaining_ms(&g_cb));
+        TEST_ASSERT_TRUE(circuit_breaker_allow(&g_cb));
+        circuit_breaker_record_failure(&g_cb);
+
+        TEST_ASSERT_EQUAL(CB_STATE_OPEN, circuit_breaker_get_state(&g_cb));
+        TEST_ASSERT_EQUAL(expected[i], circuit_breaker_remaining_ms(&g_cb));
+    }
+    TEST_ASSERT_EQUAL(5, g_cb.stats.opens);
+}
+
+void test_circuit_breaker_close_resets_cooldown(void) {
+    fail_times(3);
+    server_clock_advance_ms(1000);
+    circuit_breaker_allow(&g_cb);
+    circuit_breaker_record_failure(&g_cb);      // Reopen for 2000 ms
+
+    server_clock_advance_ms(2000);
+    circuit_breaker_allow(&g_cb);
+    circuit_breaker_record_success(&g_cb);
+
+    fail_times(3);
+    TEST_ASSERT_EQUAL(1000, circuit_breaker_remaining_ms(&g_cb));
+}
+
+/* ============================================================
+ *  Test Group 3: String Conversion Tests
+ * ============================================================ */
+
+void test_circuit_breaker_state_to_string(void) {
+    TEST_ASSERT_EQUAL_STRING("CLOSED", circuit_breaker_state_to_string(CB_STATE_CLOSED));
+    TEST_ASSERT_EQUAL_STRING("OPEN", circuit_breaker_state_to_string(CB_STATE_OPEN));
+    TEST_ASSERT_EQUAL_STRING("HALF_OPEN", circuit_breaker_state_to_string(CB_STATE_HALF_OPEN));
+    TEST_ASSERT_EQUAL_STRING("UNKNOWN", circuit_breaker_state_to_string((cb_state_t)99));
+}
+
+void test_circuit_breaker_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", circuit_breaker_error_string(CB_OK));
+    TEST_ASSERT_EQUAL_STRING("Invalid parameter", circuit_breaker_error_string(CB_ERROR_INVALID_PARAM));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", circuit_breaker_error_string(12345));
+}
@@ -0,0 +1,221 @@
+/**
+ * @file test_client_acl.c
+ * @brief Unit tests for Client ACL
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "client_acl.h"
+#include <stdio.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    client_acl_init();
+}
+
+void tearDown(void) {
+    client_acl_cleanup();
+}
+
+/* ============================================================
+ *  Test Group 1: Initialization Tests
+ * ============================================================ */
+
+void test_client_acl_double_init_should_fail(void) {
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_NOT_INIT, client_acl_init());
+}
+
+void test_client_acl_add_without_init_should_fail(void) {
+    client_acl_cleanup();
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_NOT_INIT, client_acl_add("10.0.0.0/8", CLIENT_ACL_PERM_ALL));
+}
+
+void test_client_acl_empty_allows_everyone(void) {
+    TEST_ASSERT_FALSE(client_acl_is_active());
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_ALL, client_acl_check("203.0.113.9"));
+
+    client_acl_cleanup();
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_ALL, client_acl_check("203.0.113.9"));
+}
+
+/* ============================================================
+ *  Test Group 2: Lookup Tests
+ * ============================================================ */
+
+void test_client_acl_unmatched_peer_is_denied(void) {
+    client_acl_add("192.168.1.0/24", CLIENT_ACL_PERM_ALL);
+
+    TEST_ASSERT_TRUE(client_acl_is_active());
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_ALL, client_acl_check("192.168.1.77"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check("192.168.2.77"));
+}
+
+void test_client_acl_longest_prefix_wins(void) {
+    client_acl_add("10.0.0.0/8", CLIENT_ACL_PERM_QUERY);
+    client_acl_add("10.1.0.0/16", CLIENT_ACL_PERM_NONE);
+    client_acl_add("10.1.2.3", CLIENT_ACL_PERM_ALL);
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_QUERY, client_acl_check("10.9.9.9"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check("10.1.9.9"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_ALL, client_acl_check("10.1.2.3"));
+}
+
+void test_client_acl_default_applies_to_unmatched(void) {
+    client_acl_add("10.0.0.0/8", CLIENT_ACL_PERM_NONE);
+    client_acl_set_default(CLIENT_ACL_PERM_QUERY);
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check("10.0.0.1"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_QUERY, client_acl_check("172.16.0.1"));
+}
+
+void test_client_acl_zero_length_prefix_matches_all_v4(void) {
+    client_acl_add("0.0.0.0/0", CLIENT_ACL_PERM_QUERY);
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_QUERY, client_acl_check("8.8.8.8"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check("2001:db8::1"));
+}
+
+void test_client_acl_ipv6_prefix(void) {
+    client_acl_add("fd00::/8", CLIENT_ACL_PERM_ALL);
+    client_acl_add("fd00:bad::/32", CLIENT_ACL_PERM_NONE);
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_ALL, client_acl_check("fd12::1"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check("fd00:bad::1"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check("2001:db8::1"));
+}
+
+void test_client_acl_v4_mapped_peer_matches_v4_rule(void) {
+    client_acl_add("192.168.1.0/24", CLIENT_ACL_PERM_QUERY);
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_QUERY, client_acl_check("::ffff:192.168.1.5"));
+}
+
+void test_client_acl_check_addr(void) {
+    client_acl_add("192.168.1.0/24", CLIENT_ACL_PERM_ALL);
+    client_acl_add("fe80::/10", CLIENT_ACL_PERM_QUERY);
+
+    struct sockaddr_in v4;
+    memset(&v4, 0, sizeof(v4));
+    v4.sin_family = AF_INET;
+    inet_pton(AF_INET, "192.168.1.20", &v4.sin_addr);
+
+    struct sockaddr_in6 v6;
+    memset(&v6, 0, sizeof(v6));
+    v6.sin6_family = AF_INET6;
+    inet_pton(AF_INET6, "fe80::1", &v6.sin6_addr);
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_ALL, client_acl_check_addr((struct sockaddr *)&v4));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_QUERY, client_acl_check_addr((struct sockaddr *)&v6));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check_addr(NULL));
+}
+
+void test_client_acl_unparsable_peer_is_denied(void) {
+    client_acl_add("0.0.0.0/0", CLIENT_ACL_PERM_ALL);
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check("not-an-ip"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check(NULL));
+}
+
+/* ============================================================
+ *  Test Group 3: Rule Tests
+ * ============================================================ */
+
+void test_client_acl_add_rule_parses_masks(void) {
+    TEST_ASSERT_EQUAL(CLIENT_ACL_OK, client_acl_add_rule("10.0.0.0/8"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_OK, client_acl_add_rule("10.1.0.0/16=query"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_OK, client_acl_add_rule("10.2.0.0/16=deny"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_OK, client_acl_add_rule("10.3.0.0/16=wake"));
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_ALL, client_acl_check("10.0.0.1"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_QUERY, client_acl_check("10.1.0.1"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check("10.2.0.1"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_ALL, client_acl_check("10.3.0.1"));
+}
+
+void test_client_acl_invalid_rules_should_fail(void) {
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_INVALID_PARAM, client_acl_add_rule(NULL));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_INVALID_PARAM, client_acl_add_rule("10.0.0.0/33"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_INVALID_PARAM, client_acl_add_rule("10.0.0.0/"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_INVALID_PARAM, client_acl_add_rule("fd00::/129"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_INVALID_PARAM, client_acl_add_rule("example.com"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_INVALID_PARAM, client_acl_add_rule("10.0.0.0/8=admin"));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_INVALID_PARAM, client_acl_add("10.0.0.0/8", 0x80));
+
+    TEST_ASSERT_FALSE(client_acl_is_active());
+}
+
+void test_client_acl_readding_prefix_replaces_mask(void) {
+    client_acl_add("10.0.0.0/8", CLIENT_ACL_PERM_ALL);
+    client_acl_add("10.0.0.0/8", CLIENT_ACL_PERM_QUERY);
+
+    client_acl_stats_t stats;
+    client_acl_get_stats(&stats);
+
+    TEST_ASSERT_EQUAL(1, stats.rules);
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_QUERY, client_acl_check("10.0.0.1"));
+}
+
+void test_client_acl_full_should_fail(void) {
+    char prefix[32];
+
+    for (int i = 0; i < CLIENT_ACL_MAX_RULES; i++) {
+        snprintf(prefix, sizeof(prefix), "10.0.%d.0/24", i);
+        TEST_ASSERT_EQUAL(CLIENT_ACL_OK, client_acl_add(prefix, CLIENT_ACL_PERM_ALL));
+    }
+
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_FULL, client_acl_add("10.1.0.0/24", CLIENT_ACL_PERM_ALL));
+    TEST_ASSERT_EQUAL(CLIENT_ACL_PERM_NONE, client_acl_check("10.1.0.1"));
+
+    // Replacing an existing prefix still works
+    TEST_ASSERT_EQUAL(CLIENT_ACL_OK, client_acl_add("10.0.0.0/24", CLIENT_ACL_PERM_QUERY));
+}
+
+/* ============================================================
+ *  Test Group 4: Statistics Tests
+ * ============================================================ */
+
+void test_client_acl_stats_count_lookups(void) {
+    client_acl_add_rule("192.168.1.0/24=query");
+
+    client_acl_check("192.168.1.1");
+    client_acl_check("192.168.1.2");
+    client_acl_check("10.0.0.1");
+
+    client_acl_stats_t stats;
+    TEST_ASSERT_EQUAL(CLIENT_ACL_OK, client_acl_get_stats(&stats));
+
+    TEST_ASSERT_EQUAL(1, stats.rules);
+    TEST_ASSERT_EQUAL(1 + 96 + 24, stats.nodes);
+    TEST_ASSERT_EQUAL(3, stats.lookups);
+    TEST_ASSERT_EQUAL(1, stats.denied);
+    TEST_ASSERT_EQUAL(2, stats.query_only);
+}
+
+void test_client_acl_get_stats_with_null_should_fail(void) {
+    TEST_ASSERT_EQUAL(CLIENT_ACL_ERROR_INVALID_PARAM, client_acl_get_stats(NULL));
+}
+
+/* ============================================================
+ *  Test Group 5: String Tests
+ * ============================================================ */
+
+void test_client_acl_perm_string(void) {
+    TEST_ASSERT_EQUAL_STRING("deny", client_acl_perm_string(CLIENT_ACL_PERM_NONE));
+    TEST_ASSERT_EQUAL_STRING("query", client_acl_perm_string(CLIENT_ACL_PERM_QUERY));
+    TEST_ASSERT_EQUAL_STRING("wake", client_acl_perm_string(CLIENT_ACL_PERM_ALL));
+}
+
+void test_client_acl_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", client_acl_error_string(CLIENT_ACL_OK));
+    TEST_ASSERT_EQUAL_STRING("ACL full", client_acl_error_string(CLIENT_ACL_ERROR_FULL));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", client_acl_error_string(-50));
+}
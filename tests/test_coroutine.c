@@ -0,0 +1,355 @@
+/**
+ * @file test_coroutine.c
+ * @brief Unit tests for Coroutine scheduler
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "coroutine.h"
+#include "server_clock.h"
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+typedef struct {
+    coro_t co;
+    int step;
+    int counter;
+    bool flag;
+    bool timed_out;
+    struct pollfd pfd;
+} flow_t;
+
+static flow_t g_flow;
+static flow_t g_other;
+
+static coro_status_t sleep_flow(coro_t *co) {
+    flow_t *f = (flow_t *)co->arg;
+
+    CORO_BEGIN(co);
+    f->step = 1;
+    CORO_SLEEP_MS(co, 100);
+    f->step = 2;
+    CORO_SLEEP_MS(co, 50);
+    f->step = 3;
+    CORO_END(co);
+}
+
+static coro_status_t loop_flow(coro_t *co) {
+    flow_t *f = (flow_t *)co->arg;
+
+    CORO_BEGIN(co);
+    for (f->counter = 0; f->counter < 3; f->counter++) {
+        CORO_YIELD(co);
+    }
+    f->step = 1;
+    CORO_END(co);
+}
+
+static coro_status_t until_flow(coro_t *co) {
+    flow_t *f = (flow_t *)co->arg;
+
+    CORO_BEGIN(co);
+    CORO_WAIT_UNTIL(co, f->flag);
+    f->step = 1;
+    CORO_END(co);
+}
+
+static coro_status_t fd_flow(coro_t *co) {
+    flow_t *f = (flow_t *)co->arg;
+
+    CORO_BEGIN(co);
+    CORO_WAIT_FDS(co, &f->pfd, 1, 500);
+    f->timed_out = coro_timed_out(co);
+    f->step = 1;
+    CORO_END(co);
+}
+
+static coro_status_t fd_until_flow(coro_t *co) {
+    flow_t *f = (flow_t *)co->arg;
+
+    CORO_BEGIN(co);
+    CORO_WAIT_FDS_UNTIL(co, &f->pfd, 1, 500, f->flag);
+    f->timed_out = coro_timed_out(co);
+    f->step = 1;
+    CORO_END(co);
+}
+
+/** Run one main-loop pass: collect fds, poll without blocking, resume */
+static int run_pass(void) {
+    struct pollfd fds[8];
+    int n = coro_sched_pollfds(fds, 8);
+    if (n > 0) {
+        poll(fds, (nfds_t)n, 0);
+    }
+    return coro_sched_run(fds, n);
+}
+
+void setUp(void) {
+    memset(&g_flow, 0, sizeof(g_flow));
+    memset(&g_other, 0, sizeof(g_other));
+    server_clock_use_fake(1000);
+}
+
+void tearDown(void) {
+    coro_cancel(&g_flow.co);
+    coro_cancel(&g_other.co);
+    server_clock_use_real();
+}
+
+/* ============================================================
+ *  Test Group 1: Spawn Tests
+ * ============================================================ */
+
+void test_coro_spawn_with_null_should_fail(void) {
+    TEST_ASSERT_EQUAL(CORO_ERROR_INVALID_PARAM, coro_spawn(NULL, sleep_flow, &g_flow));
+    TEST_ASSERT_EQUAL(CORO_ERROR_INVALID_PARAM, coro_spawn(&g_flow.co, NULL, &g_flow));
+}
+
+void test_coro_spawn_runs_to_first_wait(void) {
+    TEST_ASSERT_EQUAL(CORO_OK, coro_spawn(&g_flow.co, sleep_flow, &g_flow));
+
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+    TEST_ASSERT_TRUE(coro_is_running(&g_flow.co));
+    TEST_ASSERT_EQUAL(1, coro_sched_count());
+}
+
+void test_coro_spawn_twice_should_be_busy(void) {
+    coro_spawn(&g_flow.co, sleep_flow, &g_flow);
+
+    TEST_ASSERT_EQUAL(CORO_ERROR_BUSY, coro_spawn(&g_flow.co, sleep_flow, &g_flow));
+}
+
+/* ============================================================
+ *  Test Group 2: Wait Tests
+ * ============================================================ */
+
+void test_coro_sleep_resumes_after_delay(void) {
+    coro_spawn(&g_flow.co, sleep_flow, &g_flow);
+    TEST_ASSERT_EQUAL(100, coro_sched_timeout_ms(1000));
+
+    server_clock_advance_ms(99);
+    TEST_ASSERT_EQUAL(0, run_pass());
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+
+    server_clock_advance_ms(1);
+    TEST_ASSERT_EQUAL(1, run_pass());
+    TEST_ASSERT_EQUAL(2, g_flow.step);
+
+    server_clock_advance_ms(50);
+    run_pass();
+    TEST_ASSERT_EQUAL(3, g_flow.step);
+    TEST_ASSERT_FALSE(coro_is_running(&g_flow.co));
+    TEST_ASSERT_EQUAL(0, coro_sched_count());
+}
+
+void test_coro_yield_resumes_every_pass(void) {
+    coro_spawn(&g_flow.co, loop_flow, &g_flow);
+
+    run_pass();
+    run_pass();
+    TEST_ASSERT_EQUAL(2, g_flow.counter);
+    TEST_ASSERT_TRUE(coro_is_running(&g_flow.co));
+
+    run_pass();
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+    TEST_ASSERT_FALSE(coro_is_running(&g_flow.co));
+}
+
+void test_coro_wait_until_waits_for_condition(void) {
+    coro_spawn(&g_flow.co, until_flow, &g_flow);
+
+    run_pass();
+    run_pass();
+    TEST_ASSERT_EQUAL(0, g_flow.step);
+
+    g_flow.flag = true;
+    run_pass();
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+}
+
+void test_coro_wait_until_true_does_not_suspend(void) {
+    g_flow.flag = true;
+    coro_spawn(&g_flow.co, until_flow, &g_flow);
+
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+    TEST_ASSERT_FALSE(coro_is_running(&g_flow.co));
+}
+
+void test_coro_wait_fds_resumes_when_readable(void) {
+    int pipefd[2];
+    TEST_ASSERT_EQUAL(0, pipe(pipefd));
+    g_flow.pfd.fd = pipefd[0];
+    g_flow.pfd.events = POLLIN;
+
+    coro_spawn(&g_flow.co, fd_flow, &g_flow);
+
+    struct pollfd fds[8];
+    TEST_ASSERT_EQUAL(1, coro_sched_pollfds(fds, 8));
+    TEST_ASSERT_EQUAL(pipefd[0], fds[0].fd);
+
+    TEST_ASSERT_EQUAL(0, run_pass());
+    TEST_ASSERT_EQUAL(1, write(pipefd[1], "x", 1));
+    TEST_ASSERT_EQUAL(1, run_pass());
+
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+    TEST_ASSERT_FALSE(g_flow.timed_out);
+
+    close(pipefd[0]);
+    close(pipefd[1]);
+}
+
+void test_coro_wait_fds_times_out(void) {
+    int pipefd[2];
+    TEST_ASSERT_EQUAL(0, pipe(pipefd));
+    g_flow.pfd.fd = pipefd[0];
+    g_flow.pfd.events = POLLIN;
+
+    coro_spawn(&g_flow.co, fd_flow, &g_flow);
+    server_clock_advance_ms(500);
+    run_pass();
+
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+    TEST_ASSERT_TRUE(g_flow.timed_out);
+
+    close(pipefd[0]);
+    close(pipefd[1]);
+}
+
+void test_coro_wait_fds_outside_poll_set_is_polled_by_scheduler(void) {
+    int pipefd[2];
+    TEST_ASSERT_EQUAL(0, pipe(pipefd));
+    g_flow.pfd.fd = pipefd[0];
+    g_flow.pfd.events = POLLIN;
+
+    coro_spawn(&g_flow.co, fd_flow, &g_flow);
+    TEST_ASSERT_EQUAL(1, write(pipefd[1], "x", 1));
+
+    // No poll set at all
+    TEST_ASSERT_EQUAL(1, coro_sched_run(NULL, 0));
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+
+    close(pipefd[0]);
+    close(pipefd[1]);
+}
+
+void test_coro_wait_fds_until_ends_on_condition(void) {
+    int pipefd[2];
+    TEST_ASSERT_EQUAL(0, pipe(pipefd));
+    g_flow.pfd.fd = pipefd[0];
+    g_flow.pfd.events = POLLIN;
+
+    coro_spawn(&g_flow.co, fd_until_flow, &g_flow);
+    run_pass();
+    run_pass();
+    TEST_ASSERT_EQUAL(0, g_flow.step);
+
+    // Delivered by someone else, the fd never became readable
+    g_flow.flag = true;
+    run_pass();
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+    TEST_ASSERT_FALSE(g_flow.timed_out);
+
+    close(pipefd[0]);
+    close(pipefd[1]);
+}
+
+void test_coro_wait_fds_until_ends_on_fd_or_timeout(void) {
+    int pipefd[2];
+    TEST_ASSERT_EQUAL(0, pipe(pipefd));
+    g_flow.pfd.fd = pipefd[0];
+    g_flow.pfd.events = POLLIN;
+
+    coro_spawn(&g_flow.co, fd_until_flow, &g_flow);
+    TEST_ASSERT_EQUAL(1, write(pipefd[1], "x", 1));
+    run_pass();
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+
+    g_other.pfd.fd = -1;
+    coro_spawn(&g_other.co, fd_until_flow, &g_other);
+    server_clock_advance_ms(500);
+    run_pass();
+    TEST_ASSERT_EQUAL(1, g_other.step);
+    TEST_ASSERT_TRUE(g_other.timed_out);
+
+    close(pipefd[0]);
+    close(pipefd[1]);
+}
+
+/* ============================================================
+ *  Test Group 3: Scheduler Tests
+ * ============================================================ */
+
+void test_coro_timeout_is_nearest_deadline(void) {
+    TEST_ASSERT_EQUAL(1000, coro_sched_timeout_ms(1000));
+
+    coro_spawn(&g_flow.co, sleep_flow, &g_flow);
+    coro_spawn(&g_other.co, until_flow, &g_other);
+
+    // Condition waits do not shorten the timeout
+    TEST_ASSERT_EQUAL(100, coro_sched_timeout_ms(1000));
+    TEST_ASSERT_EQUAL(20, coro_sched_timeout_ms(20));
+
+    server_clock_advance_ms(150);
+    TEST_ASSERT_EQUAL(0, coro_sched_timeout_ms(1000));
+}
+
+void test_coro_many_in_flight(void) {
+    static flow_t flows[200];
+    memset(flows, 0, sizeof(flows));
+
+    for (int i = 0; i < 200; i++) {
+        TEST_ASSERT_EQUAL(CORO_OK, coro_spawn(&flows[i].co, sleep_flow, &flows[i]));
+    }
+    TEST_ASSERT_EQUAL(200, coro_sched_count());
+
+    server_clock_advance_ms(100);
+    TEST_ASSERT_EQUAL(200, run_pass());
+    server_clock_advance_ms(50);
+    run_pass();
+
+    TEST_ASSERT_EQUAL(0, coro_sched_count());
+    for (int i = 0; i < 200; i++) {
+        TEST_ASSERT_EQUAL(3, flows[i].step);
+    }
+}
+
+void test_coro_cancel_stops_flow(void) {
+    coro_spawn(&g_flow.co, sleep_flow, &g_flow);
+    coro_cancel(&g_flow.co);
+
+    server_clock_advance_ms(200);
+    run_pass();
+
+    TEST_ASSERT_EQUAL(1, g_flow.step);
+    TEST_ASSERT_EQUAL(0, coro_sched_count());
+}
+
+void test_coro_can_be_spawned_again_after_done(void) {
+    coro_spawn(&g_flow.co, loop_flow, &g_flow);
+    run_pass();
+    run_pass();
+    run_pass();
+    TEST_ASSERT_FALSE(coro_is_running(&g_flow.co));
+
+    g_flow.step = 0;
+    TEST_ASSERT_EQUAL(CORO_OK, coro_spawn(&g_flow.co, loop_flow, &g_flow));
+    TEST_ASSERT_EQUAL(0, g_flow.counter);
+    TEST_ASSERT_EQUAL(1, coro_sched_count());
+}
+
+/* ============================================================
+ *  Test Group 4: Error String Tests
+ * ============================================================ */
+
+void test_coro_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", coro_error_string(CORO_OK));
+    TEST_ASSERT_EQUAL_STRING("Already running", coro_error_string(CORO_ERROR_BUSY));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", coro_error_string(-50));
+}
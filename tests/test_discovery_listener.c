@@ -0,0 +1,191 @@
+/**
+ * @file test_discovery_listener.c
+ * @brief Unit tests for Discovery Listener module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "discovery_listener.h"
+#include "server_clock.h"
+#include <string.h>
+
+static discovery_sighting_t g_sighting;
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    memset(&g_sighting, 0, sizeof(g_sighting));
+    discovery_listener_cleanup();
+}
+
+void tearDown(void) {
+    discovery_listener_cleanup();
+}
+
+static bool parse_ddp(const char *text) {
+    return discovery_parse_ddp(text, strlen(text), "192.168.1.50", &g_sighting);
+}
+
+static bool parse_ssdp(const char *text) {
+    return discovery_parse_ssdp(text, strlen(text), "192.168.1.50", &g_sighting);
+}
+
+/* ============================================================
+ *  Test Group 1: DDP Tests
+ * ============================================================ */
+
+void test_discovery_ddp_on_reply(void) {
+    TEST_ASSERT_TRUE(parse_ddp("HTTP/1.1 200 Ok\n"
+                               "host-id:A1B2C3D4E5F6\n"
+                               "host-type:PS5\n"
+                               "host-name:PS5-123\n"
+                               "host-request-port:997\n"
+                               "device-discovery-protocol-version:00030010\n"));
+
+    TEST_ASSERT_EQUAL(DISCOVERY_PROTO_DDP, g_sighting.proto);
+    TEST_ASSERT_EQUAL(DISCOVERY_STATUS_ON, g_sighting.status);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.50", g_sighting.ip);
+    TEST_ASSERT_EQUAL_STRING("A1B2C3D4E5F6", g_sighting.host_id);
+    TEST_ASSERT_EQUAL_STRING("a1:b2:c3:d4:e5:f6", g_sighting.mac);
+    TEST_ASSERT_EQUAL_STRING("PS5-123", g_sighting.name);
+}
+
+void test_discovery_ddp_standby_reply(void) {
+    TEST_ASSERT_TRUE(parse_ddp("HTTP/1.1 620 Server Standby\r\nhost-type:PS5\r\nhost-id:A1B2C3D4E5F6\r\n"));
+    TEST_ASSERT_EQUAL(DISCOVERY_STATUS_STANDBY, g_sighting.status);
+    TEST_ASSERT_EQUAL_STRING("a1:b2:c3:d4:e5:f6", g_sighting.mac);
+}
+
+void test_discovery_ddp_rejects_search_and_ps4(void) {
+    TEST_ASSERT_FALSE(parse_ddp("SRCH * HTTP/1.1\ndevice-discovery-protocol-version:00030010\n"));
+    TEST_ASSERT_FALSE(parse_ddp("HTTP/1.1 200 Ok\nhost-type:PS4\nhost-id:A1B2C3D4E5F6\n"));
+    TEST_ASSERT_FALSE(parse_ddp("HTTP/1.1 200 Ok\nhost-id:A1B2C3D4E5F6\n"));
+}
+
+void test_discovery_ddp_odd_host_id_has_no_mac(void) {
+    TEST_ASSERT_TRUE(parse_ddp("HTTP/1.1 200 Ok\nhost-type:PS5\nhost-id:XYZ\n"));
+    TEST_ASSERT_EQUAL_STRING("XYZ", g_sighting.host_id);
+    TEST_ASSERT_EQUAL_STRING("", g_sighting.mac);
+}
+
+/* ============================================================
+ *  Test Group 2: SSDP Tests
+ * ============================================================ */
+
+void test_discovery_ssdp_alive(void) {
+    TEST_ASSERT_TRUE(parse_ssdp("NOTIFY * HTTP/1.1\r\n"
+                                "HOST: 239.255.255.250:1900\r\n"
+                                "NT: urn:dial-multiscreen-org:service:dial:1\r\n"
+                                "NTS: ssdp:alive\r\n"
+                                "SERVER: PS5/1.00 UPnP/1.0\r\n"
+                                "USN: uuid:00000000-0000-1010-8000-a1b2c3d4e5f6::urn:dial-multiscreen-org:service:dial:1\r\n"
+                                "\r\n"));
+
+    TEST_ASSERT_EQUAL(DISCOVERY_PROTO_SSDP, g_sighting.proto);
+    TEST_ASSERT_EQUAL(DISCOVERY_STATUS_UNKNOWN, g_sighting.status);
+    TEST_ASSERT_EQUAL_STRING("00000000-0000-1010-8000-a1b2c3d4e5f6", g_sighting.host_id);
+}
+
+void test_discovery_ssdp_byebye(void) {
+    TEST_ASSERT_TRUE(parse_ssdp("NOTIFY * HTTP/1.1\r\n"
+                                "NTS: ssdp:byebye\r\n"
+                                "NT: upnp:rootdevice\r\n"
+                                "USN: uuid:abc::upnp:rootdevice\r\n"
+                                "SERVER: Linux UPnP/1.0 PlayStation 5\r\n\r\n"));
+    TEST_ASSERT_EQUAL(DISCOVERY_STATUS_GONE, g_sighting.status);
+}
+
+void test_discovery_ssdp_rejects_other_devices(void) {
+    TEST_ASSERT_FALSE(parse_ssdp("NOTIFY * HTTP/1.1\r\nNTS: ssdp:alive\r\n"
+                                 "SERVER: Linux/5.4 UPnP/1.0 MiniUPnPd/2.2\r\n\r\n"));
+    // "PS5" only counts as a token
+    TEST_ASSERT_FALSE(parse_ssdp("NOTIFY * HTTP/1.1\r\nSERVER: GPS500 UPnP/1.0\r\n\r\n"));
+    // Searches are sent by clients, not the console
+    TEST_ASSERT_FALSE(parse_ssdp("M-SEARCH * HTTP/1.1\r\nST: urn:PS5\r\n\r\n"));
+}
+
+/* ============================================================
+ *  Test Group 3: mDNS Tests
+ * ============================================================ */
+
+// Response: PS5-123.local A 192.168.1.77, then _http._tcp.local PTR -> compressed
+static const uint8_t g_mdns_response[] = {
+    0x00, 0x00, 0x84, 0x00,                 // id, flags: response, authoritative
+    0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+    // PS5-123.local A (offset 12)
+    0x07, 'P', 'S', '5', '-', '1', '2', '3', 0x05, 'l', 'o', 'c', 'a', 'l', 0x00,
+    0x00, 0x01, 0x80, 0x01, 0x00, 0x00, 0x00, 0x78, 0x00, 0x04, 192, 168, 1, 77,
+    // _http._tcp.local PTR PS5-123.local
+    0x05, '_', 'h', 't', 't', 'p', 0x04, '_', 't', 'c', 'p', 0xC0, 20,
+    0x00, 0x0C, 0x00, 0x01, 0x00, 0x00, 0x00, 0x78, 0x00, 0x02, 0xC0, 12,
+};
+
+void test_discovery_mdns_a_record(void) {
+    TEST_ASSERT_TRUE(discovery_parse_mdns(g_mdns_response, sizeof(g_mdns_response),
+                                          "192.168.1.50", &g_sighting));
+    TEST_ASSERT_EQUAL(DISCOVERY_PROTO_MDNS, g_sighting.proto);
+    TEST_ASSERT_EQUAL(DISCOVERY_STATUS_UNKNOWN, g_sighting.status);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.77", g_sighting.ip);
+    TEST_ASSERT_EQUAL_STRING("PS5-123", g_sighting.name);
+}
+
+void test_discovery_mdns_goodbye(void) {
+    uint8_t packet[sizeof(g_mdns_response)];
+    memcpy(packet, g_mdns_response, sizeof(packet));
+    memset(packet + 31, 0, 4);  // A record TTL = 0
+
+    TEST_ASSERT_TRUE(discovery_parse_mdns(packet, sizeof(packet), "192.168.1.50", &g_sighting));
+    TEST_ASSERT_EQUAL(DISCOVERY_STATUS_GONE, g_sighting.status);
+}
+
+void test_discovery_mdns_rejects_queries_and_garbage(void) {
+    uint8_t packet[sizeof(g_mdns_response)];
+    memcpy(packet, g_mdns_response, sizeof(packet));
+    packet[2] = 0x00;  // Query
+
+    TEST_ASSERT_FALSE(discovery_parse_mdns(packet, sizeof(packet), "192.168.1.50", &g_sighting));
+    TEST_ASSERT_FALSE(discovery_parse_mdns(g_mdns_response, 20, "192.168.1.50", &g_sighting));
+
+    // Pointer loop must not hang
+    static const uint8_t loop[] = {
+        0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0xC0, 12,
+    };
+    TEST_ASSERT_FALSE(discovery_parse_mdns(loop, sizeof(loop), "192.168.1.50", &g_sighting));
+}
+
+/* ============================================================
+ *  Test Group 4: Lifecycle Tests
+ * ============================================================ */
+
+void test_discovery_init_requires_protocols(void) {
+    TEST_ASSERT_EQUAL(DISCOVERY_ERROR_INVALID_PARAM, discovery_listener_init(0));
+    TEST_ASSERT_EQUAL(DISCOVERY_ERROR_NOT_INIT, discovery_listener_process());
+}
+
+void test_discovery_init_and_stats(void) {
+    discovery_stats_t stats;
+
+    TEST_ASSERT_EQUAL(DISCOVERY_OK, discovery_listener_init(DISCOVERY_MASK_ALL));
+    TEST_ASSERT_EQUAL(DISCOVERY_ERROR_NOT_INIT, discovery_listener_init(DISCOVERY_MASK_ALL));
+    TEST_ASSERT_EQUAL(0, discovery_listener_process());
+
+    TEST_ASSERT_EQUAL(DISCOVERY_OK, discovery_listener_get_stats(&stats));
+    TEST_ASSERT_EQUAL_HEX32(DISCOVERY_MASK_ALL, stats.listening_mask);
+    TEST_ASSERT_EQUAL(0, stats.packets);
+}
+
+/* ============================================================
+ *  Test Group 5: String Conversion Tests
+ * ============================================================ */
+
+void test_discovery_strings(void) {
+    TEST_ASSERT_EQUAL_STRING("ddp", discovery_proto_to_string(DISCOVERY_PROTO_DDP));
+    TEST_ASSERT_EQUAL_STRING("mdns", discovery_proto_to_string(DISCOVERY_PROTO_MDNS));
+    TEST_ASSERT_EQUAL_STRING("STANDBY", discovery_status_to_string(DISCOVERY_STATUS_STANDBY));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", discovery_listener_error_string(-50));
+}
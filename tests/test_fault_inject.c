@@ -0,0 +1,258 @@
+/**
+ * @file test_fault_inject.c
+ * @brief Unit tests for Fault Injection
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "unity.h"
+#include "fault_inject.h"
+#include "server_clock.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    unsetenv(FAULT_ENV_VAR);
+    server_clock_use_fake(1000);
+}
+
+void tearDown(void) {
+    fault_inject_cleanup();
+    server_clock_use_real();
+    unsetenv(FAULT_ENV_VAR);
+}
+
+/* ============================================================
+ *  Test Group 1: Spec Parsing Tests
+ * ============================================================ */
+
+void test_fault_inject_inactive_by_default(void) {
+    TEST_ASSERT_FALSE(fault_inject_is_active());
+    TEST_ASSERT_FALSE(fault_inject_fail(FAULT_POINT_CEC));
+    TEST_ASSERT_EQUAL(0, fault_inject_delay(FAULT_POINT_CMD));
+}
+
+void test_fault_inject_configure_parses_rules(void) {
+    TEST_ASSERT_EQUAL(FAULT_OK, fault_inject_configure(
+        "cec.fail=0.2, cmd.delay=50-400@0.5,probe.drop=0.1,client.stall=2000,cache.corrupt=0.3"));
+    TEST_ASSERT_TRUE(fault_inject_is_active());
+
+    fault_rule_t rule;
+    fault_inject_get_rule(FAULT_POINT_CEC, &rule);
+    TEST_ASSERT_EQUAL_DOUBLE(0.2, rule.fail_prob);
+
+    fault_inject_get_rule(FAULT_POINT_CMD, &rule);
+    TEST_ASSERT_EQUAL(50, rule.delay_min_ms);
+    TEST_ASSERT_EQUAL(400, rule.delay_max_ms);
+    TEST_ASSERT_EQUAL_DOUBLE(0.5, rule.delay_prob);
+
+    fault_inject_get_rule(FAULT_POINT_PROBE, &rule);
+    TEST_ASSERT_EQUAL_DOUBLE(0.1, rule.fail_prob);
+
+    fault_inject_get_rule(FAULT_POINT_CLIENT, &rule);
+    TEST_ASSERT_EQUAL(2000, rule.delay_min_ms);
+    TEST_ASSERT_EQUAL(2000, rule.delay_max_ms);
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, rule.delay_prob);
+
+    fault_inject_get_rule(FAULT_POINT_CACHE, &rule);
+    TEST_ASSERT_EQUAL_DOUBLE(0.3, rule.corrupt_prob);
+}
+
+void test_fault_inject_invalid_spec_changes_nothing(void) {
+    fault_inject_configure("cec.fail=1");
+
+    const char *bad[] = {
+        "cec.fail=1.5", "cec.fail=", "tv.fail=0.5", "cec.explode=0.5", "cec.fail",
+        "cmd.delay=400-50", "cmd.delay=70000", "cmd.delay=10@2", "cmd.delay=10ms", "seed=abc"
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(FAULT_ERROR_INVALID_PARAM, fault_inject_configure(bad[i]), bad[i]);
+    }
+
+    fault_rule_t rule;
+    fault_inject_get_rule(FAULT_POINT_CEC, &rule);
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, rule.fail_prob);
+}
+
+void test_fault_inject_spec_too_long_should_fail(void) {
+    char spec[FAULT_SPEC_MAX_LEN + 16];
+    memset(spec, ' ', sizeof(spec) - 1);
+    spec[sizeof(spec) - 1] = '\0';
+
+    TEST_ASSERT_EQUAL(FAULT_ERROR_INVALID_PARAM, fault_inject_configure(spec));
+}
+
+void test_fault_inject_configure_reads_env(void) {
+    setenv(FAULT_ENV_VAR, "probe.drop=1", 1);
+
+    TEST_ASSERT_EQUAL(FAULT_OK, fault_inject_configure(NULL));
+    TEST_ASSERT_TRUE(fault_inject_fail(FAULT_POINT_PROBE));
+}
+
+void test_fault_inject_configure_without_env_is_noop(void) {
+    TEST_ASSERT_EQUAL(FAULT_OK, fault_inject_configure(NULL));
+    TEST_ASSERT_FALSE(fault_inject_is_active());
+}
+
+void test_fault_inject_empty_spec_clears_rules(void) {
+    fault_inject_configure("cec.fail=1");
+    TEST_ASSERT_EQUAL(FAULT_OK, fault_inject_configure(""));
+    TEST_ASSERT_FALSE(fault_inject_is_active());
+}
+
+/* ============================================================
+ *  Test Group 2: Injection Tests
+ * ============================================================ */
+
+void test_fault_inject_fail_probability_bounds(void) {
+    fault_inject_configure("cec.fail=1,cmd.fail=0");
+
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_TRUE(fault_inject_fail(FAULT_POINT_CEC));
+        TEST_ASSERT_FALSE(fault_inject_fail(FAULT_POINT_CMD));
+        TEST_ASSERT_FALSE(fault_inject_fail(FAULT_POINT_CLIENT));   // No rule
+    }
+
+    fault_stats_t stats;
+    fault_inject_get_stats(FAULT_POINT_CEC, &stats);
+    TEST_ASSERT_EQUAL(100, stats.failures);
+}
+
+void test_fault_inject_fail_probability_is_roughly_honoured(void) {
+    fault_inject_configure("cec.fail=0.25,seed=7");
+
+    int failures = 0;
+    for (int i = 0; i < 4000; i++) {
+        if (fault_inject_fail(FAULT_POINT_CEC)) {
+            failures++;
+        }
+    }
+
+    TEST_ASSERT_INT_WITHIN(200, 1000, failures);
+}
+
+void test_fault_inject_seed_is_repeatable(void) {
+    bool first[64];
+
+    fault_inject_configure("probe.drop=0.5,seed=42");
+    for (int i = 0; i < 64; i++) {
+        first[i] = fault_inject_fail(FAULT_POINT_PROBE);
+    }
+
+    fault_inject_configure("probe.drop=0.5,seed=42");
+    for (int i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL(first[i], fault_inject_fail(FAULT_POINT_PROBE));
+    }
+}
+
+void test_fault_inject_delay_sleeps_within_range(void) {
+    fault_inject_configure("cmd.delay=50-400");
+
+    for (int i = 0; i < 50; i++) {
+        uint64_t before = server_clock_monotonic_us();
+        uint32_t ms = fault_inject_delay(FAULT_POINT_CMD);
+
+        TEST_ASSERT_TRUE(ms >= 50 && ms <= 400);
+        TEST_ASSERT_EQUAL(ms * 1000ULL, server_clock_monotonic_us() - before);
+    }
+
+    fault_stats_t stats;
+    fault_inject_get_stats(FAULT_POINT_CMD, &stats);
+    TEST_ASSERT_EQUAL(50, stats.calls);
+    TEST_ASSERT_EQUAL(50, stats.delays);
+    TEST_ASSERT_TRUE(stats.delay_ms >= 50 * 50);
+}
+
+void test_fault_inject_fixed_delay(void) {
+    fault_inject_configure("client.stall=2000");
+
+    TEST_ASSERT_EQUAL(2000, fault_inject_delay(FAULT_POINT_CLIENT));
+    TEST_ASSERT_EQUAL(0, fault_inject_delay(FAULT_POINT_CACHE));
+}
+
+void test_fault_inject_draw_delay_does_not_sleep(void) {
+    fault_inject_configure("client.stall=2000");
+
+    uint64_t before = server_clock_monotonic_us();
+    TEST_ASSERT_EQUAL(2000, fault_inject_draw_delay(FAULT_POINT_CLIENT));
+    TEST_ASSERT_EQUAL(before, server_clock_monotonic_us());
+
+    fault_stats_t stats;
+    fault_inject_get_stats(FAULT_POINT_CLIENT, &stats);
+    TEST_ASSERT_EQUAL(1, stats.delays);
+    TEST_ASSERT_EQUAL(2000, stats.delay_ms);
+}
+
+void test_fault_inject_corrupt_changes_one_byte(void) {
+    char buf[] = "{\"ip\":\"192.168.1.50\"}";
+    char orig[sizeof(buf)];
+    memcpy(orig, buf, sizeof(buf));
+
+    fault_inject_configure("cache.corrupt=1");
+    TEST_ASSERT_TRUE(fault_inject_corrupt(FAULT_POINT_CACHE, buf, strlen(buf)));
+
+    int changed = 0;
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        if (buf[i] != orig[i]) {
+            changed++;
+        }
+    }
+    TEST_ASSERT_EQUAL(1, changed);
+    TEST_ASSERT_EQUAL('\0', buf[sizeof(buf) - 1]);
+}
+
+void test_fault_inject_corrupt_without_rule_leaves_buffer(void) {
+    char buf[] = "abc";
+
+    fault_inject_configure("cec.fail=1");
+    TEST_ASSERT_FALSE(fault_inject_corrupt(FAULT_POINT_CACHE, buf, 3));
+    TEST_ASSERT_EQUAL_STRING("abc", buf);
+    TEST_ASSERT_FALSE(fault_inject_corrupt(FAULT_POINT_CACHE, NULL, 3));
+}
+
+void test_fault_inject_reconfigure_resets_stats(void) {
+    fault_inject_configure("cec.fail=1");
+    fault_inject_fail(FAULT_POINT_CEC);
+
+    fault_inject_configure("cec.fail=1");
+
+    fault_stats_t stats;
+    fault_inject_get_stats(FAULT_POINT_CEC, &stats);
+    TEST_ASSERT_EQUAL(0, stats.failures);
+}
+
+/* ============================================================
+ *  Test Group 3: Accessor / String Tests
+ * ============================================================ */
+
+void test_fault_inject_invalid_point_should_fail(void) {
+    fault_rule_t rule;
+    fault_stats_t stats;
+
+    TEST_ASSERT_EQUAL(FAULT_ERROR_INVALID_PARAM, fault_inject_get_rule(FAULT_POINT_COUNT, &rule));
+    TEST_ASSERT_EQUAL(FAULT_ERROR_INVALID_PARAM, fault_inject_get_stats(FAULT_POINT_CEC, NULL));
+    TEST_ASSERT_EQUAL(FAULT_ERROR_INVALID_PARAM, fault_inject_get_stats(FAULT_POINT_COUNT, &stats));
+    TEST_ASSERT_FALSE(fault_inject_fail(FAULT_POINT_COUNT));
+}
+
+void test_fault_point_to_string(void) {
+    TEST_ASSERT_EQUAL_STRING("cmd", fault_point_to_string(FAULT_POINT_CMD));
+    TEST_ASSERT_EQUAL_STRING("cec", fault_point_to_string(FAULT_POINT_CEC));
+    TEST_ASSERT_EQUAL_STRING("probe", fault_point_to_string(FAULT_POINT_PROBE));
+    TEST_ASSERT_EQUAL_STRING("client", fault_point_to_string(FAULT_POINT_CLIENT));
+    TEST_ASSERT_EQUAL_STRING("cache", fault_point_to_string(FAULT_POINT_CACHE));
+    TEST_ASSERT_EQUAL_STRING("unknown", fault_point_to_string(FAULT_POINT_COUNT));
+}
+
+void test_fault_inject_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", fault_inject_error_string(FAULT_OK));
+    TEST_ASSERT_EQUAL_STRING("Invalid parameter", fault_inject_error_string(FAULT_ERROR_INVALID_PARAM));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", fault_inject_error_string(-50));
+}
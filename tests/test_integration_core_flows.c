@@ -26,7 +26,9 @@
 #include "ps5_detector.h"
 #include "ps5_wake.h"
 #include "websocket_server.h"
+#include "client_acl.h"
 #include "server_state_machine.h"
+#include "server_clock.h"
 
 #include <stdio.h>
 #include <string.h>
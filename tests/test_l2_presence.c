@@ -0,0 +1,272 @@
+/**
+ * @file test_l2_presence.c
+ * @brief Unit tests for L2 Presence module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "l2_presence.h"
+#include "server_clock.h"
+#include <string.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/neighbour.h>
+
+#define CONSOLE_MAC     "A1:B2:C3:D4:E5:F6"
+
+static const uint8_t g_console_mac[6] = { 0xa1, 0xb2, 0xc3, 0xd4, 0xe5, 0xf6 };
+static const uint8_t g_other_mac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+static l2_event_t g_event;
+static int g_event_count;
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+static void on_event(const l2_event_t *event, void *user_data) {
+    (void)user_data;
+    g_event = *event;
+    g_event_count++;
+}
+
+void setUp(void) {
+    memset(&g_event, 0, sizeof(g_event));
+    g_event_count = 0;
+    l2_presence_cleanup();
+
+    TEST_ASSERT_EQUAL(L2_OK, l2_presence_init(NULL));
+    TEST_ASSERT_EQUAL(L2_OK, l2_presence_set_mac(CONSOLE_MAC));
+    l2_presence_set_callback(on_event, NULL);
+}
+
+void tearDown(void) {
+    l2_presence_cleanup();
+    server_clock_use_real();
+}
+
+/**
+ * @brief Build one RTM_*NEIGH message with LLADDR (and DST for AF_INET)
+ */
+static size_t build_neigh(uint8_t *buf, uint16_t type, uint8_t family,
+                          uint16_t state, uint8_t flags, const uint8_t *mac) {
+    memset(buf, 0, 128);
+
+    struct nlmsghdr *nh = (struct nlmsghdr*)buf;
+    nh->nlmsg_type = type;
+    nh->nlmsg_len = NLMSG_LENGTH(sizeof(struct ndmsg));
+
+    struct ndmsg *ndm = NLMSG_DATA(nh);
+    ndm->ndm_family = family;
+    ndm->ndm_state = state;
+    ndm->ndm_flags = flags;
+    ndm->ndm_ifindex = 1;
+
+    struct rtattr *rta = (struct rtattr*)(buf + NLMSG_ALIGN(nh->nlmsg_len));
+    rta->rta_type = NDA_LLADDR;
+    rta->rta_len = RTA_LENGTH(6);
+    memcpy(RTA_DATA(rta), mac, 6);
+    nh->nlmsg_len = NLMSG_ALIGN(nh->nlmsg_len) + RTA_ALIGN(rta->rta_len);
+
+    if (family == AF_INET) {
+        static const uint8_t ip[4] = { 192, 168, 1, 77 };
+        rta = (struct rtattr*)(buf + nh->nlmsg_len);
+        rta->rta_type = NDA_DST;
+        rta->rta_len = RTA_LENGTH(4);
+        memcpy(RTA_DATA(rta), ip, 4);
+        nh->nlmsg_len += RTA_ALIGN(rta->rta_len);
+    }
+
+    return nh->nlmsg_len;
+}
+
+/* ============================================================
+ *  Test Group 1: Bridge FDB Tests
+ * ============================================================ */
+
+void test_l2_fdb_learned_and_aged_out(void) {
+    uint8_t buf[128];
+    size_t len;
+
+    len = build_neigh(buf, RTM_NEWNEIGH, AF_BRIDGE, NUD_REACHABLE, NTF_MASTER, g_console_mac);
+    TEST_ASSERT_EQUAL(1, l2_presence_handle_netlink(buf, len));
+    TEST_ASSERT_EQUAL(L2_SOURCE_BRIDGE, g_event.source);
+    TEST_ASSERT_TRUE(g_event.present);
+    TEST_ASSERT_EQUAL_STRING("a1:b2:c3:d4:e5:f6", g_event.mac);
+    TEST_ASSERT_TRUE(l2_presence_is_present());
+
+    // Refresh of a known entry is not a change
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_netlink(buf, len));
+    TEST_ASSERT_EQUAL(1, g_event_count);
+
+    len = build_neigh(buf, RTM_DELNEIGH, AF_BRIDGE, NUD_REACHABLE, NTF_MASTER, g_console_mac);
+    TEST_ASSERT_EQUAL(1, l2_presence_handle_netlink(buf, len));
+    TEST_ASSERT_FALSE(g_event.present);
+    TEST_ASSERT_FALSE(l2_presence_is_present());
+}
+
+void test_l2_get_fds(void) {
+    int fds[L2_MAX_FDS];
+
+    // Test mode opens no sockets
+    TEST_ASSERT_EQUAL(0, l2_presence_get_fds(fds, L2_MAX_FDS));
+    TEST_ASSERT_EQUAL(0, l2_presence_get_fds(NULL, L2_MAX_FDS));
+
+    l2_presence_cleanup();
+    TEST_ASSERT_EQUAL(0, l2_presence_get_fds(fds, L2_MAX_FDS));
+}
+
+void test_l2_fdb_ignores_other_macs_and_self_entries(void) {
+    uint8_t buf[128];
+    size_t len;
+
+    len = build_neigh(buf, RTM_NEWNEIGH, AF_BRIDGE, NUD_REACHABLE, 0, g_other_mac);
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_netlink(buf, len));
+
+    len = build_neigh(buf, RTM_NEWNEIGH, AF_BRIDGE, NUD_REACHABLE, NTF_SELF, g_console_mac);
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_netlink(buf, len));
+
+    len = build_neigh(buf, RTM_NEWNEIGH, AF_BRIDGE, NUD_PERMANENT, NTF_MASTER, g_console_mac);
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_netlink(buf, len));
+
+    TEST_ASSERT_EQUAL(0, g_event_count);
+}
+
+void test_l2_ipv4_neighbour_sets_event_ip(void) {
+    uint8_t buf[256];
+    size_t len;
+
+    // Two messages in one buffer: ARP entry, then FDB entry
+    len = build_neigh(buf, RTM_NEWNEIGH, AF_INET, NUD_REACHABLE, 0, g_console_mac);
+    uint8_t fdb[128];
+    size_t fdb_len = build_neigh(fdb, RTM_NEWNEIGH, AF_BRIDGE, NUD_REACHABLE, NTF_MASTER, g_console_mac);
+    memcpy(buf + len, fdb, fdb_len);
+
+    TEST_ASSERT_EQUAL(1, l2_presence_handle_netlink(buf, len + fdb_len));
+    TEST_ASSERT_EQUAL(1, g_event_count);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.77", g_event.ip);
+}
+
+void test_l2_truncated_netlink_is_ignored(void) {
+    uint8_t buf[128];
+    size_t len = build_neigh(buf, RTM_NEWNEIGH, AF_BRIDGE, NUD_REACHABLE, NTF_MASTER, g_console_mac);
+
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_netlink(buf, len - 8));
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_netlink(buf, 4));
+    TEST_ASSERT_EQUAL(0, g_event_count);
+}
+
+/* ============================================================
+ *  Test Group 2: hostapd Tests
+ * ============================================================ */
+
+void test_l2_hostapd_connect_disconnect(void) {
+    TEST_ASSERT_EQUAL(1, l2_presence_handle_hostapd("<3>AP-STA-CONNECTED a1:b2:c3:d4:e5:f6", "wlan0"));
+    TEST_ASSERT_EQUAL(L2_SOURCE_WIFI, g_event.source);
+    TEST_ASSERT_TRUE(g_event.present);
+    TEST_ASSERT_EQUAL_STRING("wlan0", g_event.iface);
+
+    TEST_ASSERT_EQUAL(1, l2_presence_handle_hostapd("<3>AP-STA-DISCONNECTED A1:B2:C3:D4:E5:F6", "wlan0"));
+    TEST_ASSERT_FALSE(g_event.present);
+    TEST_ASSERT_FALSE(l2_presence_is_present());
+}
+
+void test_l2_hostapd_ignores_other_stations_and_events(void) {
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_hostapd("<3>AP-STA-CONNECTED 02:00:00:00:00:01", "wlan0"));
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_hostapd("<3>CTRL-EVENT-EAP-STARTED a1:b2:c3:d4:e5:f6", "wlan0"));
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_hostapd("<3>AP-STA-CONNECTED", "wlan0"));
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_hostapd("PONG", "wlan0"));
+    TEST_ASSERT_EQUAL(0, g_event_count);
+}
+
+void test_l2_present_while_any_source_sees_it(void) {
+    uint8_t buf[128];
+    size_t len = build_neigh(buf, RTM_NEWNEIGH, AF_BRIDGE, NUD_REACHABLE, NTF_MASTER, g_console_mac);
+
+    l2_presence_handle_netlink(buf, len);
+    l2_presence_handle_hostapd("<3>AP-STA-CONNECTED a1:b2:c3:d4:e5:f6", "wlan0");
+    l2_presence_handle_hostapd("<3>AP-STA-DISCONNECTED a1:b2:c3:d4:e5:f6", "wlan0");
+
+    TEST_ASSERT_TRUE(l2_presence_is_present());
+}
+
+/* ============================================================
+ *  Test Group 3: MAC Tests
+ * ============================================================ */
+
+void test_l2_set_mac_validates_and_resets(void) {
+    TEST_ASSERT_EQUAL(L2_ERROR_INVALID_PARAM, l2_presence_set_mac("a1:b2:c3"));
+    TEST_ASSERT_EQUAL(L2_ERROR_INVALID_PARAM, l2_presence_set_mac(NULL));
+
+    l2_presence_handle_hostapd("<3>AP-STA-CONNECTED a1:b2:c3:d4:e5:f6", "wlan0");
+    TEST_ASSERT_TRUE(l2_presence_is_present());
+
+    // Same MAC in another case keeps state
+    TEST_ASSERT_EQUAL(L2_OK, l2_presence_set_mac("a1:b2:c3:d4:e5:f6"));
+    TEST_ASSERT_TRUE(l2_presence_is_present());
+
+    TEST_ASSERT_EQUAL(L2_OK, l2_presence_set_mac("02:00:00:00:00:01"));
+    TEST_ASSERT_FALSE(l2_presence_is_present());
+}
+
+void test_l2_no_mac_no_events(void) {
+    l2_presence_cleanup();
+    TEST_ASSERT_EQUAL(L2_OK, l2_presence_init(NULL));
+    l2_presence_set_callback(on_event, NULL);
+
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_hostapd("<3>AP-STA-CONNECTED a1:b2:c3:d4:e5:f6", "wlan0"));
+    TEST_ASSERT_EQUAL(0, g_event_count);
+}
+
+/* ============================================================
+ *  Test Group 4: Lifecycle Tests
+ * ============================================================ */
+
+void test_l2_init_and_stats(void) {
+    l2_stats_t stats;
+
+    TEST_ASSERT_EQUAL(L2_ERROR_NOT_INIT, l2_presence_init(NULL));
+    TEST_ASSERT_EQUAL(0, l2_presence_process());
+
+    l2_presence_handle_hostapd("<3>AP-STA-CONNECTED a1:b2:c3:d4:e5:f6", "wlan0");
+
+    TEST_ASSERT_EQUAL(L2_OK, l2_presence_get_stats(&stats));
+    TEST_ASSERT_EQUAL_HEX32(L2_SOURCE_MASK(L2_SOURCE_BRIDGE) | L2_SOURCE_MASK(L2_SOURCE_WIFI),
+                            stats.listening_mask);
+    TEST_ASSERT_EQUAL(1, stats.messages);
+    TEST_ASSERT_EQUAL(1, stats.events[L2_SOURCE_WIFI]);
+    TEST_ASSERT_EQUAL(0, stats.events[L2_SOURCE_BRIDGE]);
+    TEST_ASSERT_EQUAL(L2_ERROR_INVALID_PARAM, l2_presence_get_stats(NULL));
+}
+
+void test_l2_last_event_uses_server_clock(void) {
+    l2_stats_t stats;
+    server_clock_use_fake(5000);
+
+    l2_presence_handle_hostapd("<3>AP-STA-CONNECTED a1:b2:c3:d4:e5:f6", "wlan0");
+
+    l2_presence_get_stats(&stats);
+    TEST_ASSERT_EQUAL(5000, stats.last_event);
+}
+
+void test_l2_not_initialized(void) {
+    l2_presence_cleanup();
+    TEST_ASSERT_EQUAL(L2_ERROR_NOT_INIT, l2_presence_set_mac(CONSOLE_MAC));
+    TEST_ASSERT_EQUAL(L2_ERROR_NOT_INIT, l2_presence_process());
+    TEST_ASSERT_EQUAL(0, l2_presence_handle_hostapd("<3>AP-STA-CONNECTED a1:b2:c3:d4:e5:f6", "wlan0"));
+    TEST_ASSERT_FALSE(l2_presence_is_present());
+}
+
+/* ============================================================
+ *  Test Group 5: String Conversion Tests
+ * ============================================================ */
+
+void test_l2_strings(void) {
+    TEST_ASSERT_EQUAL_STRING("bridge", l2_source_to_string(L2_SOURCE_BRIDGE));
+    TEST_ASSERT_EQUAL_STRING("wifi", l2_source_to_string(L2_SOURCE_WIFI));
+    TEST_ASSERT_EQUAL_STRING("Socket error", l2_presence_error_string(L2_ERROR_SOCKET));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", l2_presence_error_string(-50));
+}
@@ -0,0 +1,204 @@
+/**
+ * @file test_link_monitor.c
+ * @brief Unit tests for Link Monitor module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "link_monitor.h"
+#include "server_clock.h"
+#include <string.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    link_monitor_cleanup();
+    link_monitor_init(0);
+}
+
+void tearDown(void) {
+    link_monitor_cleanup();
+    server_clock_use_real();
+}
+
+/* ============================================================
+ *  Test Group 1: Lifecycle Tests
+ * ============================================================ */
+
+void test_link_monitor_init_twice_should_fail(void) {
+    TEST_ASSERT_EQUAL(LINK_MON_ERROR_NOT_INIT, link_monitor_init(0));
+}
+
+void test_link_monitor_start_with_invalid_ip(void) {
+    TEST_ASSERT_EQUAL(LINK_MON_ERROR_INVALID_PARAM, link_monitor_start(NULL));
+    TEST_ASSERT_EQUAL(LINK_MON_ERROR_INVALID_PARAM, link_monitor_start("not-an-ip"));
+    TEST_ASSERT_FALSE(link_monitor_is_active());
+}
+
+void test_link_monitor_start_and_stop(void) {
+    TEST_ASSERT_EQUAL(LINK_MON_OK, link_monitor_start("192.168.1.100"));
+    TEST_ASSERT_TRUE(link_monitor_is_active());
+    TEST_ASSERT_EQUAL(LINK_MON_OK, link_monitor_process());
+
+    link_monitor_stop();
+    TEST_ASSERT_FALSE(link_monitor_is_active());
+    TEST_ASSERT_EQUAL(-1, link_monitor_get_fd());
+}
+
+void test_link_monitor_get_stats_without_init(void) {
+    link_stats_t stats;
+    link_monitor_cleanup();
+    TEST_ASSERT_EQUAL(LINK_MON_ERROR_NOT_INIT, link_monitor_get_stats(&stats));
+}
+
+/* ============================================================
+ *  Test Group 2: Estimator Tests
+ * ============================================================ */
+
+void test_link_monitor_rtt_min_max_avg(void) {
+    link_stats_t stats;
+
+    link_monitor_record_sample(true, 1000);
+    link_monitor_record_sample(true, 3000);
+    link_monitor_record_sample(true, 2000);
+    link_monitor_get_stats(&stats);
+
+    TEST_ASSERT_EQUAL_UINT32(3, stats.replies);
+    TEST_ASSERT_EQUAL_UINT32(1000, stats.rtt_min_us);
+    TEST_ASSERT_EQUAL_UINT32(3000, stats.rtt_max_us);
+    TEST_ASSERT_EQUAL_UINT32(2000, stats.rtt_last_us);
+    TEST_ASSERT_TRUE(stats.rtt_avg_us > 1000 && stats.rtt_avg_us < 2000);
+}
+
+void test_link_monitor_jitter_zero_for_constant_rtt(void) {
+    link_stats_t stats;
+
+    for (int i = 0; i < 20; i++) {
+        link_monitor_record_sample(true, 1500);
+    }
+    link_monitor_get_stats(&stats);
+
+    TEST_ASSERT_EQUAL_UINT32(0, stats.jitter_us);
+}
+
+void test_link_monitor_jitter_grows_with_variation(void) {
+    link_stats_t stats;
+
+    for (int i = 0; i < 50; i++) {
+        link_monitor_record_sample(true, (i % 2) ? 1000 : 5000);
+    }
+    link_monitor_get_stats(&stats);
+
+    // Converges towards |D| = 4000us
+    TEST_ASSERT_TRUE(stats.jitter_us > 3000 && stats.jitter_us <= 4000);
+}
+
+void test_link_monitor_loss_window(void) {
+    link_stats_t stats;
+
+    for (int i = 0; i < 10; i++) {
+        link_monitor_record_sample(i < 8, 1000);
+    }
+    link_monitor_get_stats(&stats);
+
+    TEST_ASSERT_EQUAL_UINT32(10, stats.window_probes);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.window_lost);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, 20.0, link_monitor_loss_percent(&stats));
+}
+
+void test_link_monitor_loss_window_is_bounded(void) {
+    link_stats_t stats;
+
+    for (int i = 0; i < LINK_MON_LOSS_WINDOW; i++) {
+        link_monitor_record_sample(false, 0);
+    }
+    for (int i = 0; i < LINK_MON_LOSS_WINDOW; i++) {
+        link_monitor_record_sample(true, 1000);
+    }
+    link_monitor_get_stats(&stats);
+
+    // Old losses fell out of the window
+    TEST_ASSERT_EQUAL_UINT32(LINK_MON_LOSS_WINDOW, stats.window_probes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.window_lost);
+}
+
+void test_link_monitor_histogram_percentiles(void) {
+    link_stats_t stats;
+
+    for (int i = 0; i < 95; i++) {
+        link_monitor_record_sample(true, 200);      // bucket 0 (<256us)
+    }
+    for (int i = 0; i < 5; i++) {
+        link_monitor_record_sample(true, 40000);    // tail
+    }
+    link_monitor_get_stats(&stats);
+
+    TEST_ASSERT_EQUAL_UINT32(LINK_MON_HIST_BASE_US, link_monitor_percentile_us(&stats, 50));
+    TEST_ASSERT_EQUAL_UINT32(LINK_MON_HIST_BASE_US, link_monitor_percentile_us(&stats, 95));
+    TEST_ASSERT_TRUE(link_monitor_percentile_us(&stats, 99) > 40000);
+}
+
+void test_link_monitor_histogram_ages_out_old_samples(void) {
+    link_stats_t stats;
+    const uint32_t slot_ms = LINK_MON_HIST_WINDOW_SEC * 1000 / LINK_MON_HIST_SLOTS;
+
+    server_clock_use_fake(1000);
+    link_monitor_cleanup();
+    link_monitor_init(0);
+
+    // A bad spell, then a clean link
+    for (int i = 0; i < 50; i++) {
+        link_monitor_record_sample(true, 40000);
+    }
+    server_clock_advance_ms(slot_ms);
+    for (int i = 0; i < 50; i++) {
+        link_monitor_record_sample(true, 200);
+    }
+
+    link_monitor_get_stats(&stats);
+    TEST_ASSERT_TRUE(link_monitor_percentile_us(&stats, 95) > 40000);
+
+    // Once the bad slot leaves the window only the clean samples remain
+    server_clock_advance_ms(slot_ms * (LINK_MON_HIST_SLOTS - 1));
+    link_monitor_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(LINK_MON_HIST_BASE_US, link_monitor_percentile_us(&stats, 95));
+    TEST_ASSERT_EQUAL_UINT32(50, stats.histogram[0]);
+
+    // Idle for longer than the window: empty
+    server_clock_advance_ms(LINK_MON_HIST_WINDOW_SEC * 1000 * 2);
+    link_monitor_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, link_monitor_percentile_us(&stats, 50));
+    TEST_ASSERT_EQUAL_UINT32(100, stats.replies);
+}
+
+void test_link_monitor_percentile_without_samples(void) {
+    link_stats_t stats;
+    link_monitor_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, link_monitor_percentile_us(&stats, 50));
+}
+
+void test_link_monitor_restart_with_new_ip_resets_stats(void) {
+    link_stats_t stats;
+
+    link_monitor_start("192.168.1.100");
+    link_monitor_record_sample(true, 1000);
+    link_monitor_stop();
+
+    link_monitor_start("192.168.1.101");
+    link_monitor_get_stats(&stats);
+
+    TEST_ASSERT_EQUAL_UINT32(0, stats.replies);
+}
+
+/* ============================================================
+ *  Test Group 3: String Conversion Tests
+ * ============================================================ */
+
+void test_link_monitor_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", link_monitor_error_string(LINK_MON_OK));
+    TEST_ASSERT_EQUAL_STRING("Socket error", link_monitor_error_string(LINK_MON_ERROR_SOCKET));
+}
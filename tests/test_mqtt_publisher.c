@@ -0,0 +1,406 @@
+/**
+ * @file test_mqtt_publisher.c
+ * @brief Unit tests for MQTT Publisher module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "mqtt_publisher.h"
+#include "worker_pool.h"
+#include "server_clock.h"
+#include <string.h>
+
+static int g_wake_count = 0;
+
+static void on_wake(void *user_data) {
+    (void)user_data;
+    g_wake_count++;
+}
+
+static const uint8_t CONNACK_OK[] = { 0x20, 0x02, 0x00, 0x00 };
+
+/**
+ * @brief Init, start the (simulated) connection and accept CONNACK
+ */
+static void connect_publisher(void) {
+    mqtt_config_t config;
+    mqtt_publisher_default_config(&config);
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_init(&config));
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_set_device("AA:BB:CC:DD:EE:FF"));
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_process());
+    TEST_ASSERT_EQUAL(MQTT_STATE_WAIT_CONNACK, mqtt_publisher_get_state());
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_feed(CONNACK_OK, sizeof(CONNACK_OK)));
+    TEST_ASSERT_EQUAL(MQTT_STATE_CONNECTED, mqtt_publisher_get_state());
+}
+
+/**
+ * @brief Build a broker PUBLISH packet (short packets only)
+ */
+static size_t make_publish(uint8_t flags, const char *topic, const char *payload, uint8_t *buf) {
+    size_t topic_len = strlen(topic);
+    size_t payload_len = strlen(payload);
+
+    buf[0] = (uint8_t)(0x30 | flags);
+    buf[1] = (uint8_t)(2 + topic_len + payload_len);
+    buf[2] = 0;
+    buf[3] = (uint8_t)topic_len;
+    memcpy(&buf[4], topic, topic_len);
+    memcpy(&buf[4 + topic_len], payload, payload_len);
+    return 4 + topic_len + payload_len;
+}
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    mqtt_publisher_cleanup();
+    g_wake_count = 0;
+}
+
+void tearDown(void) {
+    mqtt_publisher_cleanup();
+    server_clock_use_real();
+}
+
+/* ============================================================
+ *  Test Group 1: Initialization Tests
+ * ============================================================ */
+
+void test_mqtt_publisher_init_with_defaults(void) {
+    mqtt_config_t config;
+    mqtt_publisher_default_config(&config);
+
+    TEST_ASSERT_EQUAL(MQTT_DEFAULT_PORT, config.port);
+    TEST_ASSERT_EQUAL_STRING(MQTT_DEFAULT_TOPIC_PREFIX, config.topic_prefix);
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_init(&config));
+    TEST_ASSERT_EQUAL(MQTT_STATE_DISCONNECTED, mqtt_publisher_get_state());
+}
+
+void test_mqtt_publisher_double_init_fails(void) {
+    mqtt_config_t config;
+    mqtt_publisher_default_config(&config);
+
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_init(&config));
+    TEST_ASSERT_EQUAL(MQTT_ERROR_NOT_INIT, mqtt_publisher_init(&config));
+}
+
+void test_mqtt_publisher_update_without_init(void) {
+    TEST_ASSERT_EQUAL(MQTT_ERROR_NOT_INIT, mqtt_publisher_update("state", "on"));
+    TEST_ASSERT_EQUAL(MQTT_ERROR_NOT_INIT, mqtt_publisher_process());
+}
+
+void test_mqtt_publisher_set_device_validates_mac(void) {
+    mqtt_config_t config;
+    mqtt_publisher_default_config(&config);
+    mqtt_publisher_init(&config);
+
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_set_device("aa:bb:cc:dd:ee:ff"));
+    TEST_ASSERT_EQUAL(MQTT_ERROR_INVALID_PARAM, mqtt_publisher_set_device("AA:BB:CC"));
+    TEST_ASSERT_EQUAL(MQTT_ERROR_INVALID_PARAM, mqtt_publisher_set_device("ZZ:BB:CC:DD:EE:FF"));
+    TEST_ASSERT_EQUAL(MQTT_ERROR_INVALID_PARAM, mqtt_publisher_set_device(NULL));
+}
+
+/* ============================================================
+ *  Test Group 2: Encoding Tests
+ * ============================================================ */
+
+void test_mqtt_remaining_length_roundtrip(void) {
+    const uint32_t values[] = { 0, 127, 128, 16383, 16384, 2097151, 2097152, 268435455u };
+    uint8_t buf[4];
+    uint32_t decoded;
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        int n = mqtt_encode_remaining_length(values[i], buf);
+        TEST_ASSERT_GREATER_THAN(0, n);
+        TEST_ASSERT_EQUAL(n, mqtt_decode_remaining_length(buf, (size_t)n, &decoded));
+        TEST_ASSERT_EQUAL_UINT32(values[i], decoded);
+    }
+
+    TEST_ASSERT_EQUAL(MQTT_ERROR_INVALID_PARAM, mqtt_encode_remaining_length(268435456u, buf));
+}
+
+void test_mqtt_remaining_length_incomplete_and_malformed(void) {
+    const uint8_t partial[] = { 0x80, 0x80 };
+    const uint8_t overlong[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x01 };
+    uint32_t value;
+
+    TEST_ASSERT_EQUAL(0, mqtt_decode_remaining_length(partial, sizeof(partial), &value));
+    TEST_ASSERT_EQUAL(MQTT_ERROR_PROTOCOL, mqtt_decode_remaining_length(overlong, sizeof(overlong), &value));
+}
+
+void test_mqtt_encode_connect(void) {
+    mqtt_config_t config;
+    uint8_t buf[128];
+    mqtt_publisher_default_config(&config);
+    snprintf(config.client_id, sizeof(config.client_id), "gs");
+
+    int len = mqtt_encode_connect(&config, buf, sizeof(buf));
+    const uint8_t expected[] = {
+        0x10, 14,
+        0x00, 0x04, 'M', 'Q', 'T', 'T', 0x04, 0x02, 0x00, 60,
+        0x00, 0x02, 'g', 's'
+    };
+
+    TEST_ASSERT_EQUAL(sizeof(expected), len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, buf, sizeof(expected));
+}
+
+void test_mqtt_encode_connect_with_credentials(void) {
+    mqtt_config_t config;
+    uint8_t buf[128];
+    mqtt_publisher_default_config(&config);
+    snprintf(config.username, sizeof(config.username), "user");
+    snprintf(config.password, sizeof(config.password), "pw");
+
+    int len = mqtt_encode_connect(&config, buf, sizeof(buf));
+
+    TEST_ASSERT_GREATER_THAN(0, len);
+    TEST_ASSERT_EQUAL_HEX8(0xC2, buf[9]);   // username | password | clean session
+}
+
+void test_mqtt_encode_publish_retained(void) {
+    uint8_t buf[64];
+    int len = mqtt_encode_publish("a/b", "on", true, buf, sizeof(buf));
+    const uint8_t expected[] = { 0x31, 7, 0x00, 0x03, 'a', '/', 'b', 'o', 'n' };
+
+    TEST_ASSERT_EQUAL(sizeof(expected), len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, buf, sizeof(expected));
+}
+
+void test_mqtt_encode_subscribe(void) {
+    uint8_t buf[64];
+    int len = mqtt_encode_subscribe(1, "a/w", buf, sizeof(buf));
+    const uint8_t expected[] = { 0x82, 8, 0x00, 0x01, 0x00, 0x03, 'a', '/', 'w', 0x00 };
+
+    TEST_ASSERT_EQUAL(sizeof(expected), len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, buf, sizeof(expected));
+    TEST_ASSERT_EQUAL(MQTT_ERROR_INVALID_PARAM, mqtt_encode_subscribe(0, "a/w", buf, sizeof(buf)));
+}
+
+void test_mqtt_encode_unsubscribe(void) {
+    uint8_t buf[64];
+    int len = mqtt_encode_unsubscribe(2, "a/w", buf, sizeof(buf));
+    const uint8_t expected[] = { 0xA2, 7, 0x00, 0x02, 0x00, 0x03, 'a', '/', 'w' };
+
+    TEST_ASSERT_EQUAL(sizeof(expected), len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, buf, sizeof(expected));
+    TEST_ASSERT_EQUAL(MQTT_ERROR_INVALID_PARAM, mqtt_encode_unsubscribe(0, "a/w", buf, sizeof(buf)));
+}
+
+void test_mqtt_encode_buffer_too_small(void) {
+    uint8_t buf[8];
+    TEST_ASSERT_EQUAL(MQTT_ERROR_BUFFER_TOO_SMALL,
+                      mqtt_encode_publish("gaming/ps5/state", "standby", true, buf, sizeof(buf)));
+}
+
+/* ============================================================
+ *  Test Group 3: Session Tests
+ * ============================================================ */
+
+void test_mqtt_publisher_connack_connects(void) {
+    connect_publisher();
+}
+
+void test_mqtt_publisher_connack_refused(void) {
+    mqtt_config_t config;
+    const uint8_t refused[] = { 0x20, 0x02, 0x00, 0x05 };
+
+    mqtt_publisher_default_config(&config);
+    mqtt_publisher_init(&config);
+    mqtt_publisher_process();
+
+    TEST_ASSERT_EQUAL(MQTT_ERROR_PROTOCOL, mqtt_publisher_feed(refused, sizeof(refused)));
+}
+
+void test_mqtt_publisher_connack_timeout_backs_off(void) {
+    mqtt_config_t config;
+
+    server_clock_use_fake(1000);
+    mqtt_publisher_default_config(&config);
+    mqtt_publisher_init(&config);
+    mqtt_publisher_process();
+    TEST_ASSERT_EQUAL(MQTT_STATE_WAIT_CONNACK, mqtt_publisher_get_state());
+
+    server_clock_advance_ms(9999);
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_process());
+    server_clock_advance_ms(1);
+    TEST_ASSERT_EQUAL(MQTT_ERROR_PROTOCOL, mqtt_publisher_process());
+    TEST_ASSERT_EQUAL(MQTT_STATE_DISCONNECTED, mqtt_publisher_get_state());
+
+    // Reconnect waits out the backoff
+    mqtt_publisher_process();
+    TEST_ASSERT_EQUAL(MQTT_STATE_DISCONNECTED, mqtt_publisher_get_state());
+    server_clock_advance_ms(MQTT_BACKOFF_MIN_SEC * 1000);
+    mqtt_publisher_process();
+    TEST_ASSERT_EQUAL(MQTT_STATE_WAIT_CONNACK, mqtt_publisher_get_state());
+}
+
+void test_mqtt_publisher_keepalive_timeout(void) {
+    mqtt_config_t config;
+
+    server_clock_use_fake(1000);
+    connect_publisher();
+    mqtt_publisher_default_config(&config);
+    mqtt_publisher_process();   // Flushes the SUBSCRIBE
+
+    // Idle for half the interval: PINGREQ goes out
+    server_clock_advance_ms((uint64_t)config.keepalive_sec * 500);
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_process());
+
+    // No PINGRESP within the interval drops the session
+    server_clock_advance_ms((uint64_t)config.keepalive_sec * 1000 - 1);
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_process());
+    TEST_ASSERT_EQUAL(MQTT_STATE_CONNECTED, mqtt_publisher_get_state());
+    server_clock_advance_ms(1);
+    TEST_ASSERT_EQUAL(MQTT_ERROR_PROTOCOL, mqtt_publisher_process());
+    TEST_ASSERT_EQUAL(MQTT_STATE_DISCONNECTED, mqtt_publisher_get_state());
+}
+
+void test_mqtt_publisher_updates_coalesce(void) {
+    connect_publisher();
+
+    mqtt_publisher_update("state", "starting");
+    mqtt_publisher_update("state", "on");
+    mqtt_publisher_update("network", "{\"online\":true}");
+    TEST_ASSERT_EQUAL(2, mqtt_publisher_pending_count());
+
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_process());
+    TEST_ASSERT_EQUAL(0, mqtt_publisher_pending_count());
+
+    // Unchanged value is not republished
+    mqtt_publisher_update("state", "on");
+    TEST_ASSERT_EQUAL(0, mqtt_publisher_pending_count());
+}
+
+void test_mqtt_publisher_updates_held_while_disconnected(void) {
+    mqtt_config_t config;
+    mqtt_publisher_default_config(&config);
+    mqtt_publisher_init(&config);
+    mqtt_publisher_set_device("AA:BB:CC:DD:EE:FF");
+
+    mqtt_publisher_update("state", "on");
+    mqtt_publisher_process();  // Now waiting for CONNACK
+    TEST_ASSERT_EQUAL(1, mqtt_publisher_pending_count());
+}
+
+void test_mqtt_publisher_topic_table_full(void) {
+    connect_publisher();
+
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_update("t1", "x"));
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_update("t2", "x"));
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_update("t3", "x"));
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_update("t4", "x"));
+    TEST_ASSERT_EQUAL(MQTT_ERROR_BUFFER_TOO_SMALL, mqtt_publisher_update("t5", "x"));
+}
+
+/* ============================================================
+ *  Test Group 4: Wake Command Tests
+ * ============================================================ */
+
+void test_mqtt_publisher_wake_command(void) {
+    uint8_t buf[128];
+    connect_publisher();
+    mqtt_publisher_set_wake_callback(on_wake, NULL);
+
+    size_t len = make_publish(0x00, "gaming/ps5/aabbccddeeff/wake", "1", buf);
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_feed(buf, len));
+    TEST_ASSERT_EQUAL(1, g_wake_count);
+}
+
+void test_mqtt_publisher_ignores_retained_wake(void) {
+    uint8_t buf[128];
+    connect_publisher();
+    mqtt_publisher_set_wake_callback(on_wake, NULL);
+
+    size_t len = make_publish(0x01, "gaming/ps5/aabbccddeeff/wake", "1", buf);
+    mqtt_publisher_feed(buf, len);
+    len = make_publish(0x00, "gaming/ps5/aabbccddeeff/wake", "", buf);
+    mqtt_publisher_feed(buf, len);
+    len = make_publish(0x00, "gaming/ps5/112233445566/wake", "1", buf);
+    mqtt_publisher_feed(buf, len);
+
+    TEST_ASSERT_EQUAL(0, g_wake_count);
+}
+
+void test_mqtt_publisher_feed_split_packets(void) {
+    uint8_t buf[128];
+    connect_publisher();
+    mqtt_publisher_set_wake_callback(on_wake, NULL);
+
+    size_t len = make_publish(0x00, "gaming/ps5/aabbccddeeff/wake", "1", buf);
+    const uint8_t pingresp[] = { 0xD0, 0x00 };
+    memcpy(&buf[len], pingresp, sizeof(pingresp));
+    len += sizeof(pingresp);
+
+    // Byte by byte
+    for (size_t i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_feed(&buf[i], 1));
+    }
+
+    TEST_ASSERT_EQUAL(1, g_wake_count);
+}
+
+void test_mqtt_publisher_skips_oversized_publish(void) {
+    uint8_t buf[128];
+    uint8_t chunk[256];
+    connect_publisher();
+    mqtt_publisher_set_wake_callback(on_wake, NULL);
+
+    // Retained PUBLISH of 3000 bytes on the wake topic: remaining length 0xB8 0x17
+    const uint32_t remaining = 3000;
+    const uint8_t header[] = { 0x31, 0xB8, 0x17 };
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_feed(header, sizeof(header)));
+
+    memset(chunk, 'x', sizeof(chunk));
+    for (uint32_t fed = 0; fed < remaining; fed += sizeof(chunk)) {
+        size_t n = (remaining - fed < sizeof(chunk)) ? remaining - fed : sizeof(chunk);
+        TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_feed(chunk, n));
+    }
+
+    // Session still up, and the next packet is parsed normally
+    TEST_ASSERT_EQUAL(MQTT_STATE_CONNECTED, mqtt_publisher_get_state());
+    TEST_ASSERT_EQUAL(1, mqtt_publisher_dropped_count());
+
+    size_t len = make_publish(0x00, "gaming/ps5/aabbccddeeff/wake", "1", buf);
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_feed(buf, len));
+    TEST_ASSERT_EQUAL(1, g_wake_count);
+}
+
+void test_mqtt_publisher_oversized_non_publish_is_protocol_error(void) {
+    connect_publisher();
+
+    const uint8_t suback[] = { 0x90, 0xB8, 0x17 };
+    TEST_ASSERT_EQUAL(MQTT_ERROR_PROTOCOL, mqtt_publisher_feed(suback, sizeof(suback)));
+}
+
+void test_mqtt_publisher_wake_follows_device_change(void) {
+    uint8_t buf[128];
+    connect_publisher();
+    mqtt_publisher_set_wake_callback(on_wake, NULL);
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_process());
+
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_set_device("11:22:33:44:55:66"));
+    TEST_ASSERT_EQUAL(MQTT_OK, mqtt_publisher_process());
+
+    size_t len = make_publish(0x00, "gaming/ps5/aabbccddeeff/wake", "1", buf);
+    mqtt_publisher_feed(buf, len);
+    TEST_ASSERT_EQUAL(0, g_wake_count);
+
+    len = make_publish(0x00, "gaming/ps5/112233445566/wake", "1", buf);
+    mqtt_publisher_feed(buf, len);
+    TEST_ASSERT_EQUAL(1, g_wake_count);
+}
+
+/* ============================================================
+ *  Test Group 5: Error String Tests
+ * ============================================================ */
+
+void test_mqtt_publisher_error_strings(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", mqtt_publisher_error_string(MQTT_OK));
+    TEST_ASSERT_EQUAL_STRING("Protocol error", mqtt_publisher_error_string(MQTT_ERROR_PROTOCOL));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", mqtt_publisher_error_string(-50));
+    TEST_ASSERT_EQUAL_STRING("CONNECTED", mqtt_state_to_string(MQTT_STATE_CONNECTED));
+}
@@ -0,0 +1,128 @@
+/**
+ * @file test_neigh_table.c
+ * @brief Unit tests for Neighbour Table module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "neigh_table.h"
+#include <string.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    neigh_table_set_backend(NEIGH_BACKEND_PROC);
+}
+
+void tearDown(void) {
+    neigh_table_set_backend(NEIGH_BACKEND_PROC);
+}
+
+/* ============================================================
+ *  Test Group 1: /proc/net/arp Parsing
+ * ============================================================ */
+
+void test_neigh_parse_proc_complete_entry(void) {
+    neigh_entry_t entry;
+    const char *line = "192.168.1.100    0x1         0x2         AA:BB:CC:DD:EE:FF     *        br-lan\n";
+
+    TEST_ASSERT_TRUE(neigh_table_parse_proc_line(line, &entry));
+    TEST_ASSERT_EQUAL_STRING("192.168.1.100", entry.ip);
+    TEST_ASSERT_EQUAL_STRING("aa:bb:cc:dd:ee:ff", entry.mac);
+}
+
+void test_neigh_parse_proc_rejects_header_and_incomplete(void) {
+    neigh_entry_t entry;
+
+    TEST_ASSERT_FALSE(neigh_table_parse_proc_line(
+        "IP address       HW type     Flags       HW address            Mask     Device\n", &entry));
+    TEST_ASSERT_FALSE(neigh_table_parse_proc_line(
+        "192.168.1.101    0x1         0x0         00:00:00:00:00:00     *        br-lan\n", &entry));
+    TEST_ASSERT_FALSE(neigh_table_parse_proc_line(
+        "192.168.1.102    0x1         0x2         00:00:00:00:00:00     *        br-lan\n", &entry));
+    TEST_ASSERT_FALSE(neigh_table_parse_proc_line(NULL, &entry));
+}
+
+/* ============================================================
+ *  Test Group 2: arp -n Parsing
+ * ============================================================ */
+
+void test_neigh_parse_arp_busybox(void) {
+    neigh_entry_t entry;
+    const char *line = "? (192.168.1.100) at aa:bb:cc:dd:ee:ff [ether]  on br-lan\n";
+
+    TEST_ASSERT_TRUE(neigh_table_parse_arp_line(line, &entry));
+    TEST_ASSERT_EQUAL_STRING("192.168.1.100", entry.ip);
+    TEST_ASSERT_EQUAL_STRING("aa:bb:cc:dd:ee:ff", entry.mac);
+}
+
+void test_neigh_parse_arp_net_tools(void) {
+    neigh_entry_t entry;
+    const char *line = "192.168.1.100            ether   AA:BB:CC:DD:EE:FF   C                     br-lan\n";
+
+    TEST_ASSERT_TRUE(neigh_table_parse_arp_line(line, &entry));
+    TEST_ASSERT_EQUAL_STRING("192.168.1.100", entry.ip);
+    TEST_ASSERT_EQUAL_STRING("aa:bb:cc:dd:ee:ff", entry.mac);
+}
+
+void test_neigh_parse_arp_rejects_incomplete(void) {
+    neigh_entry_t entry;
+
+    TEST_ASSERT_FALSE(neigh_table_parse_arp_line(
+        "? (192.168.1.100) at <incomplete>  on br-lan\n", &entry));
+    TEST_ASSERT_FALSE(neigh_table_parse_arp_line(
+        "Address                  HWtype  HWaddress           Flags Mask            Iface\n", &entry));
+}
+
+/* ============================================================
+ *  Test Group 3: Backend Selection
+ * ============================================================ */
+
+void test_neigh_backend_default_is_proc(void) {
+    TEST_ASSERT_EQUAL(NEIGH_BACKEND_PROC, neigh_table_get_backend());
+}
+
+void test_neigh_backend_none_fails(void) {
+    neigh_entry_t entries[4];
+    char mac[NEIGH_MAC_MAX_LEN];
+
+    neigh_table_set_backend(NEIGH_BACKEND_NONE);
+    TEST_ASSERT_EQUAL(NEIGH_ERROR_BACKEND, neigh_table_dump(entries, 4));
+    TEST_ASSERT_EQUAL(NEIGH_ERROR_BACKEND, neigh_table_lookup_ip("192.168.1.1", mac, sizeof(mac)));
+}
+
+void test_neigh_invalid_params(void) {
+    char mac[4];
+
+    TEST_ASSERT_EQUAL(NEIGH_ERROR_INVALID_PARAM, neigh_table_dump(NULL, 4));
+    TEST_ASSERT_EQUAL(NEIGH_ERROR_INVALID_PARAM, neigh_table_lookup_ip(NULL, mac, sizeof(mac)));
+    TEST_ASSERT_EQUAL(NEIGH_ERROR_INVALID_PARAM, neigh_table_lookup_ip("192.168.1.1", mac, sizeof(mac)));
+}
+
+void test_neigh_learn_validates(void) {
+    TEST_ASSERT_EQUAL(NEIGH_OK, neigh_table_learn("192.168.1.77", "A0:B1:C2:D3:E4:F5", 2));
+    TEST_ASSERT_EQUAL(NEIGH_ERROR_INVALID_PARAM, neigh_table_learn("192.168.1", "a0:b1:c2:d3:e4:f5", 2));
+    TEST_ASSERT_EQUAL(NEIGH_ERROR_INVALID_PARAM, neigh_table_learn("192.168.1.77", "00:00:00:00:00:00", 2));
+    TEST_ASSERT_EQUAL(NEIGH_ERROR_INVALID_PARAM, neigh_table_learn("192.168.1.77", "a0:b1:c2:d3:e4:f5", 0));
+}
+
+/* ============================================================
+ *  Test Group 4: String Conversion Tests
+ * ============================================================ */
+
+void test_neigh_backend_to_string(void) {
+    TEST_ASSERT_EQUAL_STRING("none", neigh_backend_to_string(NEIGH_BACKEND_NONE));
+    TEST_ASSERT_EQUAL_STRING("arp", neigh_backend_to_string(NEIGH_BACKEND_COMMAND));
+    TEST_ASSERT_EQUAL_STRING("proc", neigh_backend_to_string(NEIGH_BACKEND_PROC));
+    TEST_ASSERT_EQUAL_STRING("netlink", neigh_backend_to_string(NEIGH_BACKEND_NETLINK));
+}
+
+void test_neigh_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", neigh_table_error_string(NEIGH_OK));
+    TEST_ASSERT_EQUAL_STRING("Not found", neigh_table_error_string(NEIGH_ERROR_NOT_FOUND));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", neigh_table_error_string(12345));
+}
@@ -0,0 +1,201 @@
+/**
+ * @file test_presence_channel.c
+ * @brief Unit tests for Presence Channel module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "presence_channel.h"
+#include "server_clock.h"
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    presence_channel_cleanup();
+}
+
+void tearDown(void) {
+    presence_channel_cleanup();
+}
+
+static presence_stats_t get_stats(void) {
+    presence_stats_t stats;
+    TEST_ASSERT_EQUAL(PRESENCE_OK, presence_channel_get_stats(&stats));
+    return stats;
+}
+
+/* ============================================================
+ *  Test Group 1: Initialization Tests
+ * ============================================================ */
+
+void test_presence_init_idle(void) {
+    TEST_ASSERT_EQUAL(PRESENCE_OK, presence_channel_init(0));
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_IDLE, presence_channel_get_state());
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_NONE, presence_channel_process());
+}
+
+void test_presence_double_init_fails(void) {
+    TEST_ASSERT_EQUAL(PRESENCE_OK, presence_channel_init(0));
+    TEST_ASSERT_EQUAL(PRESENCE_ERROR_NOT_INIT, presence_channel_init(0));
+}
+
+void test_presence_start_without_init(void) {
+    TEST_ASSERT_EQUAL(PRESENCE_ERROR_NOT_INIT, presence_channel_start("192.168.1.100"));
+}
+
+void test_presence_start_invalid_ip(void) {
+    presence_channel_init(0);
+    TEST_ASSERT_EQUAL(PRESENCE_ERROR_INVALID_PARAM, presence_channel_start("not-an-ip"));
+    TEST_ASSERT_EQUAL(PRESENCE_ERROR_INVALID_PARAM, presence_channel_start(NULL));
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_IDLE, presence_channel_get_state());
+}
+
+void test_presence_first_attempt_is_immediate(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+
+    presence_channel_process();
+
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_CONNECTING, presence_channel_get_state());
+    TEST_ASSERT_EQUAL(1, get_stats().attempts);
+}
+
+/* ============================================================
+ *  Test Group 2: Outcome Tests
+ * ============================================================ */
+
+void test_presence_connect_reports_up_once(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+    presence_channel_process();
+
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_UP, presence_channel_record(PRESENCE_OUTCOME_CONNECTED));
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_UP, presence_channel_get_state());
+    TEST_ASSERT_TRUE(get_stats().online);
+    TEST_ASSERT_EQUAL(1, get_stats().connects);
+
+    // Peer closing the idle session is not a loss; reconnecting is not news
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_NONE, presence_channel_record(PRESENCE_OUTCOME_CLOSED));
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_BACKOFF, presence_channel_get_state());
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_NONE, presence_channel_record(PRESENCE_OUTCOME_CONNECTED));
+}
+
+void test_presence_keepalive_loss_reports_down(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+    presence_channel_record(PRESENCE_OUTCOME_CONNECTED);
+
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_DOWN, presence_channel_record(PRESENCE_OUTCOME_LOST));
+    TEST_ASSERT_FALSE(get_stats().online);
+    TEST_ASSERT_EQUAL(1, get_stats().losses);
+
+    // Still gone: no repeated event
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_NONE, presence_channel_record(PRESENCE_OUTCOME_UNREACHABLE));
+}
+
+void test_presence_refused_counts_as_online(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_UP, presence_channel_record(PRESENCE_OUTCOME_REFUSED));
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_BACKOFF, presence_channel_get_state());
+}
+
+void test_presence_first_unreachable_reports_down(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_DOWN, presence_channel_record(PRESENCE_OUTCOME_UNREACHABLE));
+}
+
+/* ============================================================
+ *  Test Group 3: Backoff Tests
+ * ============================================================ */
+
+void test_presence_backoff_doubles_until_cap(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+
+    TEST_ASSERT_EQUAL(PRESENCE_BACKOFF_INITIAL_MS, get_stats().backoff_ms);
+
+    presence_channel_record(PRESENCE_OUTCOME_UNREACHABLE);
+    TEST_ASSERT_EQUAL(PRESENCE_BACKOFF_INITIAL_MS * 2, get_stats().backoff_ms);
+
+    for (int i = 0; i < 10; i++) {
+        presence_channel_record(PRESENCE_OUTCOME_UNREACHABLE);
+    }
+    TEST_ASSERT_EQUAL(PRESENCE_BACKOFF_MAX_MS, get_stats().backoff_ms);
+}
+
+void test_presence_connect_resets_backoff(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+    presence_channel_record(PRESENCE_OUTCOME_UNREACHABLE);
+    presence_channel_record(PRESENCE_OUTCOME_UNREACHABLE);
+
+    presence_channel_record(PRESENCE_OUTCOME_CONNECTED);
+
+    TEST_ASSERT_EQUAL(PRESENCE_BACKOFF_INITIAL_MS, get_stats().backoff_ms);
+}
+
+void test_presence_retry_waits_for_backoff(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+    presence_channel_process();
+    presence_channel_record(PRESENCE_OUTCOME_UNREACHABLE);
+
+    presence_channel_process();
+
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_BACKOFF, presence_channel_get_state());
+    TEST_ASSERT_EQUAL(1, get_stats().attempts);
+}
+
+/* ============================================================
+ *  Test Group 4: Restart / Stop Tests
+ * ============================================================ */
+
+void test_presence_same_address_keeps_connection(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+    presence_channel_record(PRESENCE_OUTCOME_CONNECTED);
+
+    presence_channel_start("192.168.1.100");
+
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_UP, presence_channel_get_state());
+}
+
+void test_presence_new_address_forgets_presence(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+    presence_channel_record(PRESENCE_OUTCOME_CONNECTED);
+
+    presence_channel_start("192.168.1.101");
+
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_BACKOFF, presence_channel_get_state());
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_UP, presence_channel_record(PRESENCE_OUTCOME_CONNECTED));
+}
+
+void test_presence_stop_ignores_outcomes(void) {
+    presence_channel_init(0);
+    presence_channel_start("192.168.1.100");
+
+    presence_channel_stop();
+
+    TEST_ASSERT_EQUAL(PRESENCE_EVENT_NONE, presence_channel_record(PRESENCE_OUTCOME_CONNECTED));
+    TEST_ASSERT_EQUAL(PRESENCE_STATE_IDLE, presence_channel_get_state());
+}
+
+/* ============================================================
+ *  Test Group 5: String Conversion Tests
+ * ============================================================ */
+
+void test_presence_strings(void) {
+    TEST_ASSERT_EQUAL_STRING("UP", presence_state_to_string(PRESENCE_STATE_UP));
+    TEST_ASSERT_EQUAL_STRING("BACKOFF", presence_state_to_string(PRESENCE_STATE_BACKOFF));
+    TEST_ASSERT_EQUAL_STRING("OK", presence_channel_error_string(PRESENCE_OK));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", presence_channel_error_string(-50));
+}
@@ -8,7 +8,13 @@
 
 #include "unity.h"
 #include "ps5_detector.h"
+#include "neigh_table.h"
+#include "arp_prober.h"
+#include "worker_pool.h"
+#include "coroutine.h"
+#include "server_clock.h"
 #include <string.h>
+#include <unistd.h>
 
 /* ============================================================
  *  Test Fixtures
@@ -22,6 +28,13 @@ void setUp(void) {
 void tearDown(void) {
     // Clean up after each test
     ps5_detector_cleanup();
+    ps5_detector_set_scan_enabled(true);
+    ps5_detector_set_lease_file(NULL);
+    neigh_table_set_backend(NEIGH_BACKEND_PROC);
+    worker_pool_cleanup();
+    arp_prober_cleanup();
+    ps5_detector_set_ping_backend(PING_BACKEND_COMMAND);
+    server_clock_use_real();
 }
 
 /* ============================================================
@@ -114,6 +127,29 @@ void test_ps5_detector_save_and_get_cache(void) {
     TEST_ASSERT_TRUE(load_info.online);
 }
 
+void test_ps5_detector_cache_file_read_once_at_init(void) {
+    const char *path = "/tmp/test_ps5_cache_init.json";
+    ps5_info_t info = {
+        .ip = "192.168.1.120",
+        .mac = "AA:BB:CC:DD:EE:FF",
+        .last_seen = time(NULL),
+        .online = false
+    };
+
+    ps5_detector_init("192.168.1.0/24", path);
+    ps5_detector_save_cache(&info);
+    ps5_detector_cleanup();
+
+    // A restart picks the entry up from the file
+    ps5_detector_init("192.168.1.0/24", path);
+    unlink(path);
+
+    // Later lookups are served from memory
+    ps5_info_t load_info;
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_get_cached(&load_info));
+    TEST_ASSERT_EQUAL_STRING("192.168.1.120", load_info.ip);
+}
+
 void test_ps5_detector_get_cached_without_init(void) {
     ps5_info_t info;
     int result = ps5_detector_get_cached(&info);
@@ -159,6 +195,59 @@ void test_ps5_detector_clear_cache(void) {
     TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_CACHE_INVALID, result);
 }
 
+void test_ps5_detector_save_cache_on_worker_pool(void) {
+    const char *path = "/tmp/test_ps5_cache_pool.json";
+    ps5_info_t info = {
+        .ip = "192.168.1.100",
+        .mac = "AA:BB:CC:DD:EE:FF",
+        .last_seen = time(NULL),
+        .online = true
+    };
+    ps5_info_t load_info;
+    
+    unlink(path);
+    TEST_ASSERT_EQUAL(WORKER_POOL_OK, worker_pool_init(1));
+    ps5_detector_init("192.168.1.0/24", path);
+    
+    // Queued, not written yet
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_save_cache(&info));
+    TEST_ASSERT_NOT_EQUAL(0, access(path, F_OK));
+    
+    // A second save waits behind the first; only one write is in flight
+    snprintf(info.ip, sizeof(info.ip), "192.168.1.101");
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_save_cache(&info));
+    TEST_ASSERT_EQUAL(1, worker_pool_run_one());
+    TEST_ASSERT_EQUAL(0, worker_pool_run_one());
+    
+    // Completion starts the newer write
+    TEST_ASSERT_EQUAL(1, worker_pool_process());
+    TEST_ASSERT_EQUAL(1, worker_pool_run_one());
+    TEST_ASSERT_EQUAL(1, worker_pool_process());
+    
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_get_cached(&load_info));
+    TEST_ASSERT_EQUAL_STRING("192.168.1.101", load_info.ip);
+}
+
+void test_ps5_detector_clear_cache_after_pending_write(void) {
+    const char *path = "/tmp/test_ps5_cache_pool2.json";
+    ps5_info_t info = {
+        .ip = "192.168.1.100",
+        .mac = "AA:BB:CC:DD:EE:FF",
+        .last_seen = time(NULL),
+        .online = true
+    };
+    
+    TEST_ASSERT_EQUAL(WORKER_POOL_OK, worker_pool_init(1));
+    ps5_detector_init("192.168.1.0/24", path);
+    
+    ps5_detector_save_cache(&info);
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_clear_cache());
+    
+    // The write lands first, then the removal
+    worker_pool_cleanup();
+    TEST_ASSERT_NOT_EQUAL(0, access(path, F_OK));
+}
+
 /* ============================================================
  *  Test Group 4: Detection Tests
  * ============================================================ */
@@ -247,6 +336,36 @@ void test_ps5_detector_method_string_ping(void) {
     TEST_ASSERT_EQUAL_STRING("PING", str);
 }
 
+void test_ps5_detector_method_string_passive(void) {
+    detect_method_stats_t stats;
+
+    TEST_ASSERT_EQUAL_STRING("PASSIVE", ps5_detector_method_string(DETECT_METHOD_PASSIVE));
+
+    // Reported by the caller, never tried by the quick check
+    TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_INVALID_PARAM,
+                      ps5_detector_get_method_stats(DETECT_METHOD_PASSIVE, &stats));
+}
+
+void test_ps5_detector_ping_backend_string(void) {
+    TEST_ASSERT_EQUAL_STRING("none", ps5_detector_ping_backend_string(PING_BACKEND_NONE));
+    TEST_ASSERT_EQUAL_STRING("ping", ps5_detector_ping_backend_string(PING_BACKEND_COMMAND));
+    TEST_ASSERT_EQUAL_STRING("tcp", ps5_detector_ping_backend_string(PING_BACKEND_TCP));
+    TEST_ASSERT_EQUAL_STRING("icmp-dgram", ps5_detector_ping_backend_string(PING_BACKEND_ICMP_DGRAM));
+    TEST_ASSERT_EQUAL_STRING("icmp-raw", ps5_detector_ping_backend_string(PING_BACKEND_ICMP_RAW));
+    TEST_ASSERT_EQUAL_STRING("arp", ps5_detector_ping_backend_string(PING_BACKEND_ARP));
+}
+
+void test_ps5_detector_ping_backend_survives_cleanup(void) {
+    TEST_ASSERT_EQUAL(PING_BACKEND_COMMAND, ps5_detector_get_ping_backend());
+    
+    ps5_detector_set_ping_backend(PING_BACKEND_TCP);
+    ps5_detector_init("192.168.1.0/24", "/tmp/ps5_cache.json");
+    ps5_detector_cleanup();
+    TEST_ASSERT_EQUAL(PING_BACKEND_TCP, ps5_detector_get_ping_backend());
+    
+    ps5_detector_set_ping_backend(PING_BACKEND_COMMAND);
+}
+
 /* ============================================================
  *  Test Group 6: Lifecycle Tests
  * ============================================================ */
@@ -281,6 +400,290 @@ void test_ps5_detector_get_cache_age(void) {
     TEST_ASSERT_TRUE(age >= 0 && age <= 2);
 }
 
+/* ============================================================
+ *  Test Group 7: Adaptive Method Order Tests
+ * ============================================================ */
+
+// Cache, ARP and scan all miss; latencies read as zero on the fake clock
+static void setup_all_miss(const char *cache_path) {
+    unlink(cache_path);
+    server_clock_use_fake(1000000);
+    neigh_table_set_backend(NEIGH_BACKEND_NONE);
+    ps5_detector_set_scan_enabled(false);
+    ps5_detector_set_lease_file("/tmp/test_ps5_no_leases");
+    ps5_detector_init("192.168.1.0/24", cache_path);
+}
+
+void test_ps5_detector_default_method_order(void) {
+    unlink("/tmp/test_ps5_order.json");
+    ps5_detector_init("192.168.1.0/24", "/tmp/test_ps5_order.json");
+    
+    detect_method_t order[DETECT_METHOD_COUNT];
+    ps5_detector_get_method_order(order);
+    
+    TEST_ASSERT_EQUAL(DETECT_METHOD_PING, order[0]);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_CACHE, order[1]);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_ARP, order[2]);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_LEASE, order[3]);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_SCAN, order[4]);
+}
+
+void test_ps5_detector_quick_check_reports_ping_method(void) {
+    setup_all_miss("/tmp/test_ps5_order.json");
+    
+    ps5_info_t info;
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_quick_check("192.168.1.100", &info));
+    TEST_ASSERT_EQUAL(DETECT_METHOD_PING, info.method);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.100", info.ip);
+    
+    detect_method_stats_t stats;
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_get_method_stats(DETECT_METHOD_PING, &stats));
+    TEST_ASSERT_EQUAL(1, stats.attempts);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+}
+
+void test_ps5_detector_quick_check_reports_cache_method(void) {
+    setup_all_miss("/tmp/test_ps5_order.json");
+    
+    ps5_info_t saved = { .ip = "192.168.1.100", .mac = "aa:bb:cc:dd:ee:ff",
+                         .last_seen = time(NULL), .online = true };
+    ps5_detector_save_cache(&saved);
+    
+    ps5_info_t info;
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_quick_check(NULL, &info));
+    TEST_ASSERT_EQUAL(DETECT_METHOD_CACHE, info.method);
+}
+
+void test_ps5_detector_quick_check_all_miss_records_attempts(void) {
+    setup_all_miss("/tmp/test_ps5_order.json");
+    
+    ps5_info_t info;
+    TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_NOT_FOUND, ps5_detector_quick_check(NULL, &info));
+    
+    detect_method_stats_t stats;
+    ps5_detector_get_method_stats(DETECT_METHOD_CACHE, &stats);
+    TEST_ASSERT_EQUAL(1, stats.attempts);
+    TEST_ASSERT_EQUAL(0, stats.hits);
+    ps5_detector_get_method_stats(DETECT_METHOD_PING, &stats);
+    TEST_ASSERT_EQUAL(0, stats.attempts);    // No IP given
+    ps5_detector_get_method_stats(DETECT_METHOD_SCAN, &stats);
+    TEST_ASSERT_EQUAL(0, stats.attempts);    // Disabled
+}
+
+void test_ps5_detector_order_adapts_to_hits(void) {
+    setup_all_miss("/tmp/test_ps5_order.json");
+    
+    ps5_info_t info;
+    for (int i = 0; i < 5; i++) {
+        ps5_detector_quick_check(NULL, &info);
+    }
+    
+    // Cheap misses are still worth trying before an untested ping
+    detect_method_t order[DETECT_METHOD_COUNT];
+    ps5_detector_get_method_order(order);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_CACHE, order[0]);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_ARP, order[1]);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_LEASE, order[2]);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_PING, order[3]);
+    
+    // A ping that answers moves back to the front
+    ps5_detector_quick_check("192.168.1.100", &info);
+    ps5_detector_get_method_order(order);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_PING, order[0]);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_SCAN, order[4]);
+}
+
+void test_ps5_detector_method_stats_persist_per_subnet(void) {
+    setup_all_miss("/tmp/test_ps5_order.json");
+    
+    ps5_info_t info;
+    ps5_detector_quick_check("192.168.1.100", &info);    // Hit, saves cache
+    ps5_detector_cleanup();
+    
+    detect_method_stats_t stats;
+    ps5_detector_init("192.168.1.0/24", "/tmp/test_ps5_order.json");
+    ps5_detector_get_method_stats(DETECT_METHOD_PING, &stats);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+    ps5_detector_cleanup();
+    
+    // Another site starts from scratch
+    ps5_detector_init("10.0.0.0/24", "/tmp/test_ps5_order.json");
+    ps5_detector_get_method_stats(DETECT_METHOD_PING, &stats);
+    TEST_ASSERT_EQUAL(0, stats.attempts);
+}
+
+void test_ps5_detector_method_stats_invalid(void) {
+    detect_method_stats_t stats;
+    TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_INVALID_PARAM,
+                      ps5_detector_get_method_stats(DETECT_METHOD_PING, NULL));
+    TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_INVALID_PARAM,
+                      ps5_detector_get_method_stats((detect_method_t)DETECT_METHOD_COUNT, &stats));
+}
+
+/* ============================================================
+ *  Test Group 8: Hedged Quick Check Tests
+ * ============================================================ */
+
+static void write_leases(const char *contents) {
+    FILE *fp = fopen("/tmp/test_ps5_leases", "w");
+    fputs(contents, fp);
+    fclose(fp);
+    ps5_detector_set_lease_file("/tmp/test_ps5_leases");
+}
+
+void test_ps5_detector_hedged_without_init(void) {
+    ps5_info_t info;
+    TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_NOT_INIT, ps5_detector_quick_check_hedged(NULL, &info));
+}
+
+void test_ps5_detector_hedged_known_ip_answers(void) {
+    setup_all_miss("/tmp/test_ps5_hedged.json");
+    
+    ps5_info_t info;
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_quick_check_hedged("192.168.1.100", &info));
+    TEST_ASSERT_EQUAL(DETECT_METHOD_PING, info.method);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.100", info.ip);
+}
+
+void test_ps5_detector_hedged_lease_by_hostname(void) {
+    setup_all_miss("/tmp/test_ps5_hedged.json");
+    write_leases("0 11:22:33:44:55:66 192.168.1.20 laptop *\n"
+                 "0 aa:bb:cc:dd:ee:ff 192.168.1.57 PS5-123 01:aa:bb:cc:dd:ee:ff\n");
+    
+    ps5_info_t info;
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_quick_check_hedged(NULL, &info));
+    TEST_ASSERT_EQUAL(DETECT_METHOD_LEASE, info.method);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.57", info.ip);
+    TEST_ASSERT_EQUAL_STRING("aa:bb:cc:dd:ee:ff", info.mac);
+}
+
+void test_ps5_detector_hedged_lease_follows_known_mac(void) {
+    setup_all_miss("/tmp/test_ps5_hedged.json");
+    write_leases("0 aa:bb:cc:dd:ee:ff 192.168.1.57 PS5-123 *\n");
+    
+    ps5_info_t info;
+    ps5_detector_quick_check_hedged(NULL, &info);       // Learns the MAC
+    ps5_detector_clear_cache();                         // Old address is gone
+    
+    // Renamed console at a new address: the MAC still matches
+    write_leases("0 AA:BB:CC:DD:EE:FF 192.168.1.80 living-room *\n");
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_quick_check_hedged(NULL, &info));
+    TEST_ASSERT_EQUAL_STRING("192.168.1.80", info.ip);
+}
+
+void test_ps5_detector_hedged_ignores_expired_and_foreign_leases(void) {
+    setup_all_miss("/tmp/test_ps5_hedged.json");
+    write_leases("1 aa:bb:cc:dd:ee:ff 192.168.1.57 PS5-123 *\n"
+                 "0 11:22:33:44:55:66 192.168.1.20 laptop *\n");
+    
+    ps5_info_t info;
+    TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_NOT_FOUND, ps5_detector_quick_check_hedged(NULL, &info));
+}
+
+/* ============================================================
+ *  Test Group 9: Asynchronous Detection Tests
+ * ============================================================ */
+
+static int g_detect_calls;
+static int g_detect_result;
+static ps5_info_t g_detect_info;
+
+static void on_detect(int result, const ps5_info_t *info, void *user_data) {
+    g_detect_calls++;
+    g_detect_result = result;
+    g_detect_info = *info;
+    (void)user_data;
+}
+
+static void reset_detect_calls(void) {
+    g_detect_calls = 0;
+    g_detect_result = PS5_DETECT_ERROR_UNKNOWN;
+    memset(&g_detect_info, 0, sizeof(g_detect_info));
+}
+
+void test_ps5_detector_detect_start_without_init(void) {
+    reset_detect_calls();
+    TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_NOT_INIT, ps5_detector_detect_start(NULL, on_detect, NULL));
+    TEST_ASSERT_EQUAL(0, g_detect_calls);
+}
+
+void test_ps5_detector_detect_start_known_ip_answers(void) {
+    reset_detect_calls();
+    setup_all_miss("/tmp/test_ps5_async.json");
+    
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_detect_start("192.168.1.100", on_detect, NULL));
+    coro_sched_run(NULL, 0);
+    
+    TEST_ASSERT_EQUAL(1, g_detect_calls);
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, g_detect_result);
+    TEST_ASSERT_EQUAL(DETECT_METHOD_PING, g_detect_info.method);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.100", g_detect_info.ip);
+    TEST_ASSERT_FALSE(ps5_detector_detect_in_progress());
+}
+
+void test_ps5_detector_detect_start_scans_on_worker_pool(void) {
+    reset_detect_calls();
+    setup_all_miss("/tmp/test_ps5_async.json");
+    ps5_detector_set_scan_enabled(true);
+    worker_pool_init(1);
+    worker_pool_start();
+    
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_detect_start(NULL, on_detect, NULL));
+    
+    // Nothing answered; the scan is queued and the main loop keeps running
+    TEST_ASSERT_TRUE(ps5_detector_detect_in_progress());
+    TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_BUSY, ps5_detector_detect_start(NULL, on_detect, NULL));
+    coro_sched_run(NULL, 0);
+    TEST_ASSERT_EQUAL(0, g_detect_calls);
+    
+    TEST_ASSERT_EQUAL(1, worker_pool_run_one());
+    TEST_ASSERT_EQUAL(1, worker_pool_process());
+    coro_sched_run(NULL, 0);
+    
+    TEST_ASSERT_EQUAL(1, g_detect_calls);
+    TEST_ASSERT_EQUAL(PS5_DETECT_ERROR_NOT_FOUND, g_detect_result);
+    
+    detect_method_stats_t stats;
+    ps5_detector_get_method_stats(DETECT_METHOD_SCAN, &stats);
+    TEST_ASSERT_EQUAL(1, stats.attempts);
+}
+
+void test_ps5_detector_detect_start_hedges_arp_probe(void) {
+    reset_detect_calls();
+    setup_all_miss("/tmp/test_ps5_async.json");
+    ps5_detector_set_ping_backend(PING_BACKEND_ARP);
+    TEST_ASSERT_EQUAL(ARP_OK, arp_prober_init("192.168.1.0/24"));
+    
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, ps5_detector_detect_start("192.168.1.100", on_detect, NULL));
+    coro_sched_run(NULL, 0);
+    
+    // The who-has goes out next to the TCP probe
+    arp_stats_t stats;
+    arp_prober_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.requests);
+    TEST_ASSERT_EQUAL(1, g_detect_calls);
+    TEST_ASSERT_EQUAL(PS5_DETECT_OK, g_detect_result);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.100", g_detect_info.ip);
+}
+
+void test_ps5_detector_cleanup_cancels_detection(void) {
+    reset_detect_calls();
+    setup_all_miss("/tmp/test_ps5_async.json");
+    ps5_detector_set_scan_enabled(true);
+    worker_pool_init(1);
+    worker_pool_start();
+    
+    ps5_detector_detect_start(NULL, on_detect, NULL);
+    ps5_detector_cleanup();
+    TEST_ASSERT_FALSE(ps5_detector_detect_in_progress());
+    
+    // The scan still finishes, but its result is dropped
+    worker_pool_run_one();
+    worker_pool_process();
+    coro_sched_run(NULL, 0);
+    TEST_ASSERT_EQUAL(0, g_detect_calls);
+}
+
 /* ============================================================
  *  ⚠️ 重要: 不要有 main() 函數!
  *  Ceedling 會自動生成 test runner (包含 main)
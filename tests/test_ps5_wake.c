@@ -5,6 +5,9 @@
 
 #include "unity.h"
 #include "ps5_wake.h"
+#include "server_clock.h"
+#include "coroutine.h"
+#include "worker_pool.h"
 #include <string.h>
 
 // 測試用常數
@@ -12,14 +15,31 @@
 #define TEST_PS5_IP "192.168.1.100"
 #define TEST_PS5_MAC "AA:BB:CC:DD:EE:FF"
 
+extern void ps5_wake_test_set_probe_state(int state);
+
+// 非同步喚醒回調紀錄
+static int g_wake_callbacks = 0;
+static wake_result_t g_wake_result = WAKE_RESULT_TIMEOUT;
+
+static void on_wake_done(wake_result_t result, void *user_data) {
+    g_wake_callbacks++;
+    g_wake_result = result;
+    (void)user_data;
+}
+
 void setUp(void) {
     // 每個測試前初始化
+    g_wake_callbacks = 0;
+    g_wake_result = WAKE_RESULT_TIMEOUT;
     ps5_wake_init(TEST_CEC_DEVICE);
 }
 
 void tearDown(void) {
     // 每個測試後清理
     ps5_wake_cleanup();
+    ps5_wake_test_set_probe_state(1);
+    worker_pool_cleanup();
+    server_clock_use_real();
 }
 
 // ============================================
@@ -255,6 +275,137 @@ void test_ps5_wake_cleanup_should_reset_state(void) {
     TEST_ASSERT_EQUAL(-1, result);
 }
 
+// ============================================
+// 非同步喚醒測試
+// ============================================
+
+void test_ps5_wake_start_completes_on_main_loop(void) {
+    ps5_info_t info;
+    memset(&info, 0, sizeof(ps5_info_t));
+    snprintf(info.ip, sizeof(info.ip), TEST_PS5_IP);
+    server_clock_use_fake(1000);
+    
+    TEST_ASSERT_EQUAL(0, ps5_wake_start(&info, 5, 3, on_wake_done, NULL));
+    
+    // CEC 命令已送出,等待 PS5 回應期間不阻塞
+    TEST_ASSERT_TRUE(ps5_wake_in_progress());
+    coro_sched_run(NULL, 0);
+    TEST_ASSERT_EQUAL(0, g_wake_callbacks);
+    
+    server_clock_advance_ms(500);
+    coro_sched_run(NULL, 0);
+    
+    TEST_ASSERT_EQUAL(1, g_wake_callbacks);
+    TEST_ASSERT_EQUAL(WAKE_RESULT_SUCCESS, g_wake_result);
+    TEST_ASSERT_FALSE(ps5_wake_in_progress());
+}
+
+void test_ps5_wake_start_sends_cec_on_worker_pool(void) {
+    ps5_info_t info;
+    memset(&info, 0, sizeof(ps5_info_t));
+    snprintf(info.ip, sizeof(info.ip), TEST_PS5_IP);
+    server_clock_use_fake(1000);
+    worker_pool_init(1);
+    worker_pool_start();
+    
+    TEST_ASSERT_EQUAL(0, ps5_wake_start(&info, 5, 1, on_wake_done, NULL));
+    
+    // CEC 工作完成前流程停在原地
+    server_clock_advance_ms(500);
+    coro_sched_run(NULL, 0);
+    TEST_ASSERT_EQUAL(0, g_wake_callbacks);
+    
+    TEST_ASSERT_EQUAL(1, worker_pool_run_one());
+    TEST_ASSERT_EQUAL(1, worker_pool_process());
+    coro_sched_run(NULL, 0);
+    server_clock_advance_ms(500);
+    coro_sched_run(NULL, 0);
+    
+    TEST_ASSERT_EQUAL(1, g_wake_callbacks);
+    TEST_ASSERT_EQUAL(WAKE_RESULT_SUCCESS, g_wake_result);
+}
+
+void test_ps5_wake_start_while_in_progress_should_fail(void) {
+    ps5_info_t info;
+    memset(&info, 0, sizeof(ps5_info_t));
+    snprintf(info.ip, sizeof(info.ip), TEST_PS5_IP);
+    server_clock_use_fake(1000);
+    
+    TEST_ASSERT_EQUAL(0, ps5_wake_start(&info, 5, 1, on_wake_done, NULL));
+    TEST_ASSERT_EQUAL(-4, ps5_wake_start(&info, 5, 1, on_wake_done, NULL));
+}
+
+void test_ps5_wake_start_without_init_should_fail(void) {
+    ps5_info_t info;
+    memset(&info, 0, sizeof(ps5_info_t));
+    ps5_wake_cleanup();
+    
+    TEST_ASSERT_EQUAL(-1, ps5_wake_start(&info, 5, 1, on_wake_done, NULL));
+    TEST_ASSERT_EQUAL(-1, ps5_wake_start(NULL, 5, 1, on_wake_done, NULL));
+}
+
+void test_ps5_wake_cancel_skips_callback(void) {
+    ps5_info_t info;
+    memset(&info, 0, sizeof(ps5_info_t));
+    snprintf(info.ip, sizeof(info.ip), TEST_PS5_IP);
+    server_clock_use_fake(1000);
+    
+    ps5_wake_start(&info, 5, 1, on_wake_done, NULL);
+    ps5_wake_cancel();
+    
+    server_clock_advance_ms(1000);
+    coro_sched_run(NULL, 0);
+    
+    TEST_ASSERT_FALSE(ps5_wake_in_progress());
+    TEST_ASSERT_EQUAL(0, g_wake_callbacks);
+}
+
+void test_ps5_wake_start_refused_port_is_not_awake(void) {
+    ps5_info_t info;
+    memset(&info, 0, sizeof(ps5_info_t));
+    snprintf(info.ip, sizeof(info.ip), TEST_PS5_IP);
+    server_clock_use_fake(1000);
+    
+    // 休眠模式: Remote Play 埠回 RST
+    ps5_wake_test_set_probe_state(-1);
+    TEST_ASSERT_EQUAL(0, ps5_wake_start(&info, 2, 1, on_wake_done, NULL));
+    
+    for (int i = 0; i < 5; i++) {
+        coro_sched_run(NULL, 0);
+        server_clock_advance_ms(1000);
+    }
+    coro_sched_run(NULL, 0);
+    
+    TEST_ASSERT_EQUAL(1, g_wake_callbacks);
+    TEST_ASSERT_EQUAL(WAKE_RESULT_VERIFY_FAILED, g_wake_result);
+}
+
+void test_ps5_wake_report_awake_completes_verification(void) {
+    ps5_info_t info;
+    memset(&info, 0, sizeof(ps5_info_t));
+    snprintf(info.ip, sizeof(info.ip), TEST_PS5_IP);
+    server_clock_use_fake(1000);
+    
+    ps5_wake_test_set_probe_state(-1);
+    TEST_ASSERT_EQUAL(0, ps5_wake_start(&info, 10, 1, on_wake_done, NULL));
+    server_clock_advance_ms(500);
+    coro_sched_run(NULL, 0);
+    TEST_ASSERT_EQUAL(0, g_wake_callbacks);
+    
+    // CEC 電源狀態 ON / DDP 200
+    ps5_wake_report_awake();
+    server_clock_advance_ms(1000);
+    coro_sched_run(NULL, 0);
+    
+    TEST_ASSERT_EQUAL(1, g_wake_callbacks);
+    TEST_ASSERT_EQUAL(WAKE_RESULT_SUCCESS, g_wake_result);
+}
+
+void test_ps5_wake_report_awake_without_wake_is_ignored(void) {
+    ps5_wake_report_awake();
+    TEST_ASSERT_FALSE(ps5_wake_in_progress());
+}
+
 // ============================================
 // 整合測試
 // ============================================
@@ -0,0 +1,210 @@
+/**
+ * @file test_qos_manager.c
+ * @brief Unit tests for QoS Manager module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "qos_manager.h"
+#include "worker_pool.h"
+#include "server_clock.h"
+#include <string.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    qos_manager_cleanup();
+}
+
+void tearDown(void) {
+    qos_manager_cleanup();
+    worker_pool_cleanup();
+}
+
+/* ============================================================
+ *  Test Group 1: Initialization Tests
+ * ============================================================ */
+
+void test_qos_manager_init_with_defaults(void) {
+    TEST_ASSERT_EQUAL(QOS_OK, qos_manager_init(NULL));
+    TEST_ASSERT_FALSE(qos_manager_is_active());
+}
+
+void test_qos_manager_init_twice_should_fail(void) {
+    qos_manager_init(NULL);
+    TEST_ASSERT_EQUAL(QOS_ERROR_NOT_INIT, qos_manager_init(NULL));
+}
+
+void test_qos_manager_init_with_invalid_dscp(void) {
+    qos_config_t config;
+    qos_manager_default_config(&config);
+    config.dscp = 64;
+    TEST_ASSERT_EQUAL(QOS_ERROR_INVALID_PARAM, qos_manager_init(&config));
+}
+
+void test_qos_manager_init_tc_without_classid(void) {
+    qos_config_t config;
+    qos_manager_default_config(&config);
+    strcpy(config.tc_iface, "br-lan");
+    TEST_ASSERT_EQUAL(QOS_ERROR_INVALID_PARAM, qos_manager_init(&config));
+}
+
+void test_qos_manager_validate_netns(void) {
+    TEST_ASSERT_TRUE(qos_manager_validate_netns("gaming"));
+    TEST_ASSERT_TRUE(qos_manager_validate_netns("ns-1.lan_0"));
+
+    TEST_ASSERT_FALSE(qos_manager_validate_netns(NULL));
+    TEST_ASSERT_FALSE(qos_manager_validate_netns(""));
+    TEST_ASSERT_FALSE(qos_manager_validate_netns(".."));
+    TEST_ASSERT_FALSE(qos_manager_validate_netns("a;reboot"));
+    TEST_ASSERT_FALSE(qos_manager_validate_netns("$(id)"));
+    TEST_ASSERT_FALSE(qos_manager_validate_netns("a b"));
+    TEST_ASSERT_FALSE(qos_manager_validate_netns("0123456789012345678901234567890123"));
+}
+
+void test_qos_manager_init_with_unsafe_netns(void) {
+    qos_config_t config;
+    qos_manager_default_config(&config);
+    strcpy(config.netns, "x;rm -rf /");
+    TEST_ASSERT_EQUAL(QOS_ERROR_INVALID_PARAM, qos_manager_init(&config));
+
+    strcpy(config.netns, "gaming");
+    TEST_ASSERT_EQUAL(QOS_OK, qos_manager_init(&config));
+}
+
+/* ============================================================
+ *  Test Group 2: Ruleset Generation Tests
+ * ============================================================ */
+
+void test_qos_manager_ruleset_is_single_transaction(void) {
+    char buf[QOS_SCRIPT_MAX_LEN];
+    qos_manager_init(NULL);
+
+    int len = qos_manager_build_ruleset("192.168.1.50", "AA:BB:CC:DD:EE:FF",
+                                        buf, sizeof(buf));
+
+    TEST_ASSERT_GREATER_THAN(0, len);
+    // Table is declared, deleted and recreated in the same script
+    TEST_ASSERT_TRUE(strncmp(buf, "table inet gaming_qos\ndelete table inet gaming_qos\n", 50) == 0);
+    TEST_ASSERT_NOT_NULL(strstr(buf, "ether saddr AA:BB:CC:DD:EE:FF ip dscp set 0x2e"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "ip saddr 192.168.1.50 ip dscp set 0x2e"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "ip daddr 192.168.1.50 ip dscp set 0x2e"));
+}
+
+void test_qos_manager_ruleset_mac_only(void) {
+    char buf[QOS_SCRIPT_MAX_LEN];
+    qos_manager_init(NULL);
+
+    int len = qos_manager_build_ruleset(NULL, "AA:BB:CC:DD:EE:FF", buf, sizeof(buf));
+
+    TEST_ASSERT_GREATER_THAN(0, len);
+    TEST_ASSERT_NULL(strstr(buf, "ip daddr"));
+    TEST_ASSERT_NULL(strstr(buf, "postrouting"));
+}
+
+void test_qos_manager_ruleset_rejects_invalid_input(void) {
+    char buf[QOS_SCRIPT_MAX_LEN];
+    qos_manager_init(NULL);
+
+    TEST_ASSERT_EQUAL(QOS_ERROR_INVALID_PARAM, qos_manager_build_ruleset(NULL, NULL, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(QOS_ERROR_INVALID_PARAM, qos_manager_build_ruleset("", "", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(QOS_ERROR_INVALID_PARAM, qos_manager_build_ruleset("1.2.3; flush ruleset", NULL, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(QOS_ERROR_INVALID_PARAM, qos_manager_build_ruleset(NULL, "AA:BB:CC:DD:EE", buf, sizeof(buf)));
+}
+
+void test_qos_manager_ruleset_buffer_too_small(void) {
+    char buf[32];
+    qos_manager_init(NULL);
+
+    int len = qos_manager_build_ruleset("192.168.1.50", NULL, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(QOS_ERROR_BUFFER_TOO_SMALL, len);
+}
+
+void test_qos_manager_tc_batch(void) {
+    char buf[256];
+    qos_config_t config;
+    qos_manager_default_config(&config);
+    strcpy(config.tc_iface, "br-lan");
+    strcpy(config.tc_classid, "1:10");
+    qos_manager_init(&config);
+
+    TEST_ASSERT_GREATER_THAN(0, qos_manager_build_tc_batch("192.168.1.50", true, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("filter replace dev br-lan parent 1: protocol ip prio 7 "
+                             "u32 match ip dst 192.168.1.50/32 flowid 1:10\n", buf);
+
+    TEST_ASSERT_GREATER_THAN(0, qos_manager_build_tc_batch(NULL, false, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("filter del dev br-lan parent 1: protocol ip prio 7\n", buf);
+}
+
+void test_qos_manager_tc_batch_disabled(void) {
+    char buf[256];
+    qos_manager_init(NULL);
+
+    TEST_ASSERT_EQUAL(0, qos_manager_build_tc_batch("192.168.1.50", true, buf, sizeof(buf)));
+}
+
+/* ============================================================
+ *  Test Group 3: Apply / Remove Tests
+ * ============================================================ */
+
+void test_qos_manager_apply_without_init(void) {
+    TEST_ASSERT_EQUAL(QOS_ERROR_NOT_INIT, qos_manager_apply("192.168.1.50", NULL));
+}
+
+void test_qos_manager_apply_and_remove(void) {
+    qos_manager_init(NULL);
+
+    TEST_ASSERT_EQUAL(QOS_OK, qos_manager_apply("192.168.1.50", "AA:BB:CC:DD:EE:FF"));
+    TEST_ASSERT_TRUE(qos_manager_is_active());
+    TEST_ASSERT_EQUAL_STRING("192.168.1.50", qos_manager_get_active_ip());
+
+    TEST_ASSERT_EQUAL(QOS_OK, qos_manager_remove());
+    TEST_ASSERT_FALSE(qos_manager_is_active());
+    TEST_ASSERT_EQUAL_STRING("", qos_manager_get_active_ip());
+}
+
+void test_qos_manager_apply_invalid_keeps_inactive(void) {
+    qos_manager_init(NULL);
+
+    TEST_ASSERT_EQUAL(QOS_ERROR_INVALID_PARAM, qos_manager_apply("bad", NULL));
+    TEST_ASSERT_FALSE(qos_manager_is_active());
+}
+
+void test_qos_manager_remove_when_inactive(void) {
+    qos_manager_init(NULL);
+    TEST_ASSERT_EQUAL(QOS_OK, qos_manager_remove());
+}
+
+void test_qos_manager_changes_run_on_worker_pool(void) {
+    TEST_ASSERT_EQUAL(WORKER_POOL_OK, worker_pool_init(1));
+    qos_manager_init(NULL);
+
+    // State follows the request right away, the commands run later
+    TEST_ASSERT_EQUAL(QOS_OK, qos_manager_apply("192.168.1.50", NULL));
+    TEST_ASSERT_TRUE(qos_manager_is_active());
+    TEST_ASSERT_EQUAL(QOS_OK, qos_manager_remove());
+    TEST_ASSERT_FALSE(qos_manager_is_active());
+
+    // One change in flight; the remove waits for the apply
+    TEST_ASSERT_EQUAL(1, worker_pool_run_one());
+    TEST_ASSERT_EQUAL(0, worker_pool_run_one());
+    TEST_ASSERT_EQUAL(1, worker_pool_process());
+    TEST_ASSERT_EQUAL(1, worker_pool_run_one());
+    TEST_ASSERT_EQUAL(1, worker_pool_process());
+
+    TEST_ASSERT_FALSE(qos_manager_is_active());
+}
+
+/* ============================================================
+ *  Test Group 4: String Conversion Tests
+ * ============================================================ */
+
+void test_qos_manager_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", qos_manager_error_string(QOS_OK));
+    TEST_ASSERT_EQUAL_STRING("Command failed", qos_manager_error_string(QOS_ERROR_COMMAND_FAILED));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", qos_manager_error_string(12345));
+}
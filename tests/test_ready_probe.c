@@ -0,0 +1,140 @@
+/**
+ * @file test_ready_probe.c
+ * @brief Unit tests for Ready Probe module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "ready_probe.h"
+#include "server_clock.h"
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    ready_probe_cleanup();
+}
+
+void tearDown(void) {
+    ready_probe_cleanup();
+}
+
+/* ============================================================
+ *  Test Group 1: Initialization Tests
+ * ============================================================ */
+
+void test_ready_probe_init_idle(void) {
+    TEST_ASSERT_EQUAL(READY_PROBE_OK, ready_probe_init(0));
+    TEST_ASSERT_EQUAL(READY_PROBE_IDLE, ready_probe_get_state());
+}
+
+void test_ready_probe_double_init_fails(void) {
+    TEST_ASSERT_EQUAL(READY_PROBE_OK, ready_probe_init(0));
+    TEST_ASSERT_EQUAL(READY_PROBE_ERROR_NOT_INIT, ready_probe_init(0));
+}
+
+void test_ready_probe_start_without_init(void) {
+    TEST_ASSERT_EQUAL(READY_PROBE_ERROR_NOT_INIT, ready_probe_start("192.168.1.100"));
+}
+
+void test_ready_probe_start_invalid_ip(void) {
+    ready_probe_init(0);
+    TEST_ASSERT_EQUAL(READY_PROBE_ERROR_INVALID_PARAM, ready_probe_start("not-an-ip"));
+    TEST_ASSERT_EQUAL(READY_PROBE_ERROR_INVALID_PARAM, ready_probe_start(NULL));
+    TEST_ASSERT_EQUAL(READY_PROBE_IDLE, ready_probe_get_state());
+}
+
+/* ============================================================
+ *  Test Group 2: Schedule Tests
+ * ============================================================ */
+
+void test_ready_probe_first_attempt_is_immediate(void) {
+    ready_probe_init(0);
+    ready_probe_start("192.168.1.100");
+
+    TEST_ASSERT_EQUAL(READY_PROBE_PROBING, ready_probe_process());
+    TEST_ASSERT_EQUAL(1, ready_probe_get_attempts());
+}
+
+void test_ready_probe_spacing_doubles_until_cap(void) {
+    ready_probe_init(0);
+    ready_probe_start("192.168.1.100");
+
+    TEST_ASSERT_EQUAL(READY_PROBE_INITIAL_DELAY_MS, ready_probe_get_next_delay_ms());
+
+    ready_probe_record_result(false);
+    TEST_ASSERT_EQUAL(READY_PROBE_INITIAL_DELAY_MS * 2, ready_probe_get_next_delay_ms());
+
+    for (int i = 0; i < 10; i++) {
+        ready_probe_record_result(false);
+    }
+    TEST_ASSERT_EQUAL(READY_PROBE_MAX_DELAY_MS, ready_probe_get_next_delay_ms());
+    TEST_ASSERT_EQUAL(READY_PROBE_PROBING, ready_probe_get_state());
+}
+
+void test_ready_probe_refused_attempt_waits_for_spacing(void) {
+    ready_probe_init(0);
+    ready_probe_start("192.168.1.100");
+    ready_probe_process();
+    ready_probe_record_result(false);
+
+    // Next attempt is at least READY_PROBE_INITIAL_DELAY_MS away
+    ready_probe_process();
+    TEST_ASSERT_EQUAL(1, ready_probe_get_attempts());
+}
+
+void test_ready_probe_accept_reports_ready(void) {
+    ready_probe_init(0);
+    ready_probe_start("192.168.1.100");
+    ready_probe_process();
+
+    ready_probe_record_result(true);
+
+    TEST_ASSERT_EQUAL(READY_PROBE_READY, ready_probe_get_state());
+    TEST_ASSERT_EQUAL(READY_PROBE_READY, ready_probe_process());
+}
+
+void test_ready_probe_restart_resets_schedule(void) {
+    ready_probe_init(0);
+    ready_probe_start("192.168.1.100");
+    ready_probe_record_result(false);
+    ready_probe_record_result(false);
+
+    ready_probe_start("192.168.1.101");
+
+    TEST_ASSERT_EQUAL(READY_PROBE_INITIAL_DELAY_MS, ready_probe_get_next_delay_ms());
+    TEST_ASSERT_EQUAL(0, ready_probe_get_attempts());
+}
+
+void test_ready_probe_stop_returns_to_idle(void) {
+    ready_probe_init(0);
+    ready_probe_start("192.168.1.100");
+
+    ready_probe_stop();
+    ready_probe_record_result(true);
+
+    TEST_ASSERT_EQUAL(READY_PROBE_IDLE, ready_probe_get_state());
+}
+
+void test_ready_probe_get_fd_without_attempt(void) {
+    TEST_ASSERT_EQUAL(-1, ready_probe_get_fd());
+
+    // Test mode opens no socket; the result is recorded directly
+    ready_probe_init(0);
+    ready_probe_start("192.168.1.100");
+    ready_probe_process();
+    TEST_ASSERT_EQUAL(-1, ready_probe_get_fd());
+}
+
+/* ============================================================
+ *  Test Group 3: String Conversion Tests
+ * ============================================================ */
+
+void test_ready_probe_strings(void) {
+    TEST_ASSERT_EQUAL_STRING("READY", ready_probe_state_to_string(READY_PROBE_READY));
+    TEST_ASSERT_EQUAL_STRING("OK", ready_probe_error_string(READY_PROBE_OK));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", ready_probe_error_string(-50));
+}
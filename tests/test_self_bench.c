@@ -0,0 +1,218 @@
+/**
+ * @file test_self_bench.c
+ * @brief Unit tests for Self Benchmark
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "self_bench.h"
+#include "ps5_detector.h"
+#include "cec_monitor.h"
+#include "neigh_table.h"
+#include "arp_prober.h"
+#include "worker_pool.h"
+#include "coroutine.h"
+#include "server_clock.h"
+#include <stdio.h>
+#include <string.h>
+#include <cjson/cJSON.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+static self_bench_report_t g_report;
+
+static void set_timing(self_bench_timing_t *timing, uint32_t avg_us, uint32_t p90_us) {
+    timing->samples = 10;
+    timing->avg_us = avg_us;
+    timing->p90_us = p90_us;
+}
+
+void setUp(void) {
+    memset(&g_report, 0, sizeof(g_report));
+    g_report.cpus = 2;
+}
+
+void tearDown(void) {
+}
+
+/* ============================================================
+ *  Test Group 1: Summary Tests
+ * ============================================================ */
+
+void test_self_bench_summarize_computes_stats(void) {
+    uint32_t samples[10] = { 90, 10, 50, 20, 100, 30, 80, 40, 70, 60 };
+    self_bench_timing_t timing;
+
+    self_bench_summarize(samples, 10, 2, &timing);
+
+    TEST_ASSERT_EQUAL(10, timing.samples);
+    TEST_ASSERT_EQUAL(2, timing.failures);
+    TEST_ASSERT_EQUAL(10, timing.min_us);
+    TEST_ASSERT_EQUAL(55, timing.avg_us);
+    TEST_ASSERT_EQUAL(90, timing.p90_us);
+    TEST_ASSERT_EQUAL(100, timing.max_us);
+}
+
+void test_self_bench_summarize_single_sample(void) {
+    uint32_t samples[1] = { 42 };
+    self_bench_timing_t timing;
+
+    self_bench_summarize(samples, 1, 0, &timing);
+
+    TEST_ASSERT_EQUAL(42, timing.min_us);
+    TEST_ASSERT_EQUAL(42, timing.p90_us);
+    TEST_ASSERT_EQUAL(42, timing.max_us);
+}
+
+void test_self_bench_summarize_no_samples(void) {
+    self_bench_timing_t timing;
+
+    self_bench_summarize(NULL, 0, 5, &timing);
+
+    TEST_ASSERT_EQUAL(0, timing.samples);
+    TEST_ASSERT_EQUAL(5, timing.failures);
+    TEST_ASSERT_EQUAL(0, timing.max_us);
+}
+
+/* ============================================================
+ *  Test Group 2: Recommendation Tests
+ * ============================================================ */
+
+void test_self_bench_recommend_defaults_without_samples(void) {
+    self_bench_recommend(&g_report);
+
+    TEST_ASSERT_EQUAL(SELF_BENCH_DEFAULT_LOOP_MS, g_report.recommend.main_loop_interval_ms);
+    TEST_ASSERT_EQUAL(SELF_BENCH_DEFAULT_CEC_POLL_MS, g_report.recommend.cec_poll_interval_ms);
+    TEST_ASSERT_EQUAL(SELF_BENCH_DEFAULT_PROBE_MS, g_report.recommend.probe_interval_ms);
+    TEST_ASSERT_EQUAL(4, g_report.recommend.probes_in_flight);
+}
+
+void test_self_bench_recommend_fast_loop_uses_floor(void) {
+    set_timing(&g_report.loop_wakeup, 20, 30);
+    set_timing(&g_report.timer_slack, 60, 100);
+
+    self_bench_recommend(&g_report);
+
+    TEST_ASSERT_EQUAL(SELF_BENCH_DEFAULT_LOOP_MS / 2, g_report.recommend.main_loop_interval_ms);
+}
+
+void test_self_bench_recommend_slow_timer_lengthens_loop(void) {
+    set_timing(&g_report.loop_wakeup, 20, 30);
+    set_timing(&g_report.timer_slack, 8000, 12000);   // 12 ms late -> 120 ms
+
+    self_bench_recommend(&g_report);
+
+    TEST_ASSERT_EQUAL(150, g_report.recommend.main_loop_interval_ms);
+}
+
+void test_self_bench_recommend_cec_interval_scales_with_rtt(void) {
+    set_timing(&g_report.cec, 150000, 180000);         // 180 ms -> 1.8 s
+
+    self_bench_recommend(&g_report);
+
+    TEST_ASSERT_EQUAL(2000, g_report.recommend.cec_poll_interval_ms);
+}
+
+void test_self_bench_recommend_cec_interval_is_clamped(void) {
+    set_timing(&g_report.cec, 5000, 8000);
+
+    self_bench_recommend(&g_report);
+    TEST_ASSERT_EQUAL(500, g_report.recommend.cec_poll_interval_ms);
+
+    set_timing(&g_report.cec, 3000000, 4000000);
+    self_bench_recommend(&g_report);
+    TEST_ASSERT_EQUAL(10000, g_report.recommend.cec_poll_interval_ms);
+}
+
+void test_self_bench_recommend_probe_interval_uses_slower_probe(void) {
+    set_timing(&g_report.icmp, 1000, 2000);
+    set_timing(&g_report.tcp, 100000, 300000);        // 4 x 300 ms
+
+    self_bench_recommend(&g_report);
+
+    TEST_ASSERT_EQUAL(1250, g_report.recommend.probe_interval_ms);
+}
+
+void test_self_bench_recommend_slow_spawn_halves_in_flight(void) {
+    g_report.cpus = 4;
+    self_bench_recommend(&g_report);
+    TEST_ASSERT_EQUAL(8, g_report.recommend.probes_in_flight);
+
+    set_timing(&g_report.spawn, 30000, 40000);
+    self_bench_recommend(&g_report);
+    TEST_ASSERT_EQUAL(4, g_report.recommend.probes_in_flight);
+
+    g_report.cpus = 1;
+    self_bench_recommend(&g_report);
+    TEST_ASSERT_EQUAL(1, g_report.recommend.probes_in_flight);
+}
+
+/* ============================================================
+ *  Test Group 3: Run / Report Tests
+ * ============================================================ */
+
+void test_self_bench_run_with_null_report_should_fail(void) {
+    TEST_ASSERT_EQUAL(SELF_BENCH_ERROR_INVALID_PARAM, self_bench_run(NULL, NULL));
+}
+
+void test_self_bench_run_measures_json_and_loop(void) {
+    self_bench_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.target_ip = "192.168.1.50";
+
+    TEST_ASSERT_EQUAL(SELF_BENCH_OK, self_bench_run(&config, &g_report));
+
+    TEST_ASSERT_EQUAL_STRING("192.168.1.50", g_report.target_ip);
+    TEST_ASSERT_TRUE(g_report.cpus >= 1);
+    TEST_ASSERT_TRUE(g_report.json_bytes > 0);
+    TEST_ASSERT_TRUE(g_report.json_encode_per_sec > 0);
+    TEST_ASSERT_TRUE(g_report.json_decode_per_sec > 0);
+    TEST_ASSERT_EQUAL(SELF_BENCH_LOOP_SAMPLES, g_report.loop_wakeup.samples);
+    TEST_ASSERT_EQUAL(SELF_BENCH_LOOP_SAMPLES, g_report.timer_slack.samples);
+    TEST_ASSERT_TRUE(g_report.recommend.main_loop_interval_ms > 0);
+}
+
+void test_self_bench_run_ignores_invalid_target(void) {
+    self_bench_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.target_ip = "not-an-ip";
+
+    self_bench_run(&config, &g_report);
+
+    TEST_ASSERT_EQUAL_STRING("", g_report.target_ip);
+    TEST_ASSERT_EQUAL(0, g_report.tcp.samples);
+}
+
+void test_self_bench_report_to_json(void) {
+    snprintf(g_report.target_ip, sizeof(g_report.target_ip), "192.168.1.50");
+    set_timing(&g_report.cec, 150000, 180000);
+    self_bench_recommend(&g_report);
+
+    char *json = self_bench_report_to_json(&g_report);
+    TEST_ASSERT_NOT_NULL(json);
+
+    cJSON *root = cJSON_Parse(json);
+    TEST_ASSERT_NOT_NULL(root);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.50", cJSON_GetObjectItem(root, "target")->valuestring);
+
+    cJSON *cec = cJSON_GetObjectItem(root, "cec");
+    TEST_ASSERT_EQUAL(180000, cJSON_GetObjectItem(cec, "p90_us")->valueint);
+
+    cJSON *rec = cJSON_GetObjectItem(root, "recommended");
+    TEST_ASSERT_EQUAL(2000, cJSON_GetObjectItem(rec, "cec_poll_interval_ms")->valueint);
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(rec, "probes_in_flight"));
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(cJSON_GetObjectItem(root, "loop"), "wakeup"));
+
+    cJSON_Delete(root);
+    cJSON_free(json);
+}
+
+void test_self_bench_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", self_bench_error_string(SELF_BENCH_OK));
+    TEST_ASSERT_EQUAL_STRING("Invalid parameter", self_bench_error_string(SELF_BENCH_ERROR_INVALID_PARAM));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", self_bench_error_string(-50));
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_server_clock.c
+ * @brief Unit tests for Server Clock module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "server_clock.h"
+#include <time.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    server_clock_use_real();
+}
+
+void tearDown(void) {
+    server_clock_use_real();
+}
+
+/* ============================================================
+ *  Test Group 1: System Clock Tests
+ * ============================================================ */
+
+void test_server_clock_real_by_default(void) {
+    TEST_ASSERT_FALSE(server_clock_is_fake());
+
+    time_t before = time(NULL);
+    time_t now = server_clock_now();
+    TEST_ASSERT_TRUE(now >= before);
+    TEST_ASSERT_TRUE(now - before <= 1);
+}
+
+void test_server_clock_real_monotonic_advances(void) {
+    uint64_t t0 = server_clock_monotonic_us();
+    server_clock_sleep_ms(5);
+    uint64_t t1 = server_clock_monotonic_us();
+
+    TEST_ASSERT_TRUE(t1 - t0 >= 5000);
+}
+
+void test_server_clock_advance_ignored_when_real(void) {
+    time_t before = server_clock_now();
+    server_clock_advance_ms(3600 * 1000ULL);
+
+    TEST_ASSERT_TRUE(server_clock_now() - before <= 1);
+}
+
+/* ============================================================
+ *  Test Group 2: Simulated Clock Tests
+ * ============================================================ */
+
+void test_server_clock_fake_starts_at_given_time(void) {
+    server_clock_use_fake(1000000);
+
+    TEST_ASSERT_TRUE(server_clock_is_fake());
+    TEST_ASSERT_EQUAL(1000000, server_clock_now());
+    TEST_ASSERT_EQUAL_UINT64(0, server_clock_monotonic_us());
+}
+
+void test_server_clock_fake_advance(void) {
+    server_clock_use_fake(1000000);
+
+    server_clock_advance_ms(999);
+    TEST_ASSERT_EQUAL(1000000, server_clock_now());
+
+    server_clock_advance_ms(1);
+    TEST_ASSERT_EQUAL(1000001, server_clock_now());
+    TEST_ASSERT_EQUAL_UINT64(1000000ULL, server_clock_monotonic_us());
+}
+
+void test_server_clock_fake_sleep_advances_without_blocking(void) {
+    server_clock_use_fake(1000000);
+
+    // A week of sleeping returns immediately
+    for (int i = 0; i < 7 * 24; i++) {
+        server_clock_sleep_ms(3600 * 1000U);
+    }
+
+    TEST_ASSERT_EQUAL(1000000 + 7 * 86400, server_clock_now());
+}
+
+void test_server_clock_back_to_real(void) {
+    server_clock_use_fake(1000);
+    server_clock_use_real();
+
+    TEST_ASSERT_FALSE(server_clock_is_fake());
+    TEST_ASSERT_TRUE(server_clock_now() > 1000);
+}
@@ -8,6 +8,7 @@
 
 #include "unity.h"
 #include "server_state_machine.h"
+#include "server_clock.h"
 #include <string.h>
 
 // 測試用上下文
@@ -284,6 +285,43 @@ void test_server_sm_get_ps5_status_all_unknown(void) {
     TEST_ASSERT_EQUAL_STRING("unknown", status);
 }
 
+void test_server_sm_get_ps5_status_ready_after_on(void) {
+    server_sm_update_cec_state(&g_ctx, PS5_POWER_ON);
+    server_sm_update_network_state(&g_ctx, true);
+    
+    int result = server_sm_update_ready_state(&g_ctx, true);
+    
+    TEST_ASSERT_EQUAL(0, result);
+    TEST_ASSERT_EQUAL_STRING("ready", server_sm_get_ps5_status(&g_ctx));
+}
+
+void test_server_sm_ready_cleared_when_network_offline(void) {
+    server_sm_update_cec_state(&g_ctx, PS5_POWER_ON);
+    server_sm_update_network_state(&g_ctx, true);
+    server_sm_update_ready_state(&g_ctx, true);
+    
+    server_sm_update_network_state(&g_ctx, false);
+    server_sm_update_network_state(&g_ctx, true);
+    
+    TEST_ASSERT_FALSE(g_ctx.ps5_status.remote_play_ready);
+    TEST_ASSERT_EQUAL_STRING("on", server_sm_get_ps5_status(&g_ctx));
+}
+
+void test_server_sm_ready_cleared_when_cec_standby(void) {
+    server_sm_update_cec_state(&g_ctx, PS5_POWER_ON);
+    server_sm_update_network_state(&g_ctx, true);
+    server_sm_update_ready_state(&g_ctx, true);
+    
+    server_sm_update_cec_state(&g_ctx, PS5_POWER_STANDBY);
+    
+    TEST_ASSERT_FALSE(g_ctx.ps5_status.remote_play_ready);
+    TEST_ASSERT_EQUAL_STRING("standby", server_sm_get_ps5_status(&g_ctx));
+}
+
+void test_server_sm_update_ready_state_with_null_should_fail(void) {
+    TEST_ASSERT_EQUAL(-1, server_sm_update_ready_state(NULL, true));
+}
+
 // ============================================
 // 錯誤狀態測試
 // ============================================
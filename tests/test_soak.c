@@ -0,0 +1,662 @@
+/**
+ * @file test_soak.c
+ * @brief Accelerated-time soak test
+ *
+ * Runs the real state machine, WebSocket message path, status snapshot,
+ * ready probe, link monitor and wake flow for weeks of daemon time on
+ * the simulated server clock. Scripted backends stand in for the
+ * console (CEC power, boot delay, Remote Play port), the DHCP server
+ * and the clients:
+ *
+ * - CEC flaps: power toggles plus bursts of rapid on/standby changes
+ * - DHCP changes: the console moves to a new address every few hours
+ * - Client churn: clients connect, poll (plain and if_version), leave
+ * - Wake storms: every client sends wake_ps5 in the same second
+ *
+ * At the end of every simulated day the harness samples RSS, open fds,
+ * live cJSON allocations and the mean message-handling latency, and
+ * fails if any of them grows against the first day.
+ *
+ * SOAK_DAYS (default 14) and SOAK_SEED override the run length and the
+ * scenario seed; a failing seed replays exactly.
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "unity.h"
+#include "server_clock.h"
+#include "server_state_machine.h"
+#include "websocket_server.h"
+#include "client_acl.h"
+#include "ps5_wake.h"
+#include "coroutine.h"
+#include "worker_pool.h"
+#include "status_snapshot.h"
+#include "ready_probe.h"
+#include "link_monitor.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <cjson/cJSON.h>
+
+// 測試輔助函數宣告 (在 websocket_server.c 中實作)
+extern int ws_server_test_add_client(const char *ip, uint16_t port);
+extern int ws_server_test_remove_client(int client_id);
+extern char* ws_server_test_handle_message(int client_id, const char *message);
+
+/* ============================================================
+ *  Scenario Parameters
+ * ============================================================ */
+
+#define SOAK_DEFAULT_DAYS       14
+#define SOAK_DEFAULT_SEED       0x50A4C0DEu
+#define SOAK_MAX_DAYS           366
+#define SOAK_START_TIME         1790000000      // Fixed epoch for replay
+
+#define SOAK_MAX_CLIENTS        8
+#define SOAK_POLL_SEC           30              // Mean client poll interval
+#define SOAK_BOOT_SEC           20              // Power on -> network online
+#define SOAK_RP_DELAY_SEC       15              // Online -> Remote Play accepts
+
+// Mean intervals between scripted events (seconds)
+#define SOAK_POWER_TOGGLE_SEC   (45 * 60)
+#define SOAK_FLAP_BURST_SEC     (6 * 3600)
+#define SOAK_DHCP_CHANGE_SEC    (8 * 3600)
+#define SOAK_CLIENT_JOIN_SEC    (10 * 60)
+#define SOAK_CLIENT_LEAVE_SEC   (15 * 60)
+#define SOAK_WAKE_STORM_SEC     (12 * 3600)
+
+// Growth limits (last day against first day)
+#define SOAK_RSS_SLACK_KB       256
+#define SOAK_LATENCY_FACTOR     3.0
+#define SOAK_LATENCY_SLACK_NS   20000.0
+
+/* ============================================================
+ *  Harness State
+ * ============================================================ */
+
+typedef struct {
+    int id;
+    uint32_t version;       // Last version seen, 0 = none
+    time_t next_poll;
+} soak_client_t;
+
+typedef struct {
+    long rss_kb;
+    int fds;
+    long live_allocs;
+    double latency_ns;
+} soak_sample_t;
+
+static server_context_t g_ctx;
+static uint32_t g_rng;
+
+// Fake console
+static ps5_power_state_t g_power;
+static time_t g_power_since;
+static ps5_info_t g_console;
+static int g_flap_left;
+
+// Daemon-side bookkeeping (mirrors main.c)
+static const char *g_last_status;
+static char g_last_ip[PS5_IP_MAX_LEN];
+static uint32_t g_probe_attempts;
+
+static soak_client_t g_clients[SOAK_MAX_CLIENTS];
+static int g_client_count;
+
+// Allocation and latency accounting
+static long g_live_allocs;
+static long g_peak_allocs;
+static double g_day_latency_ns;
+static long g_day_messages;
+
+// Scenario coverage
+static struct {
+    long power_toggles;
+    long flap_bursts;
+    long dhcp_changes;
+    long joins;
+    long leaves;
+    long wake_storms;
+    long wakes;
+    long queries;
+    long not_modified;
+    long deltas;
+    long broadcasts;
+    long ready;
+} g_seen;
+
+/* ============================================================
+ *  Helpers
+ * ============================================================ */
+
+static uint32_t rng_next(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+/**
+ * @brief True with probability 1/mean_sec (one draw per simulated second)
+ */
+static bool chance(uint32_t mean_sec) {
+    return (rng_next() % mean_sec) == 0;
+}
+
+static long env_long(const char *name, long fallback) {
+    const char *value = getenv(name);
+    if (value == NULL || *value == '\0') {
+        return fallback;
+    }
+    return strtol(value, NULL, 0);
+}
+
+static void *counting_malloc(size_t size) {
+    void *p = malloc(size);
+    if (p != NULL) {
+        g_live_allocs++;
+        if (g_live_allocs > g_peak_allocs) {
+            g_peak_allocs = g_live_allocs;
+        }
+    }
+    return p;
+}
+
+static void counting_free(void *p) {
+    if (p != NULL) {
+        g_live_allocs--;
+    }
+    free(p);
+}
+
+static long read_rss_kb(void) {
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (f == NULL) {
+        return -1;
+    }
+
+    long size = 0, resident = 0;
+    int n = fscanf(f, "%ld %ld", &size, &resident);
+    fclose(f);
+
+    return (n == 2) ? resident * (sysconf(_SC_PAGESIZE) / 1024) : -1;
+}
+
+static int count_fds(void) {
+    DIR *dir = opendir("/proc/self/fd");
+    if (dir == NULL) {
+        return -1;
+    }
+
+    int count = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] != '.') {
+            count++;
+        }
+    }
+    closedir(dir);
+
+    return count - 1;  // Not the directory stream itself
+}
+
+static double wall_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ============================================================
+ *  Daemon Glue (same wiring as main.c)
+ * ============================================================ */
+
+static char* dup_response(const char *frame) {
+    size_t len = strlen(frame) + 1;
+    char *copy = cJSON_malloc(len);
+    memcpy(copy, frame, len);
+    return copy;
+}
+
+static char* soak_message_handler(int client_id, ws_message_type_t msg_type,
+                                  const char *payload, void *user_data) {
+    server_context_t *ctx = (server_context_t*)user_data;
+    char *response = NULL;
+
+    switch (msg_type) {
+        case WS_MSG_QUERY_PS5: {
+            server_sm_handle_event(ctx, SERVER_EVENT_CLIENT_QUERY);
+
+            if (strstr(payload, "if_version") != NULL) {
+                cJSON *root = cJSON_Parse(payload);
+                cJSON *if_version = cJSON_GetObjectItem(root, "if_version");
+                const char *cached = NULL;
+                if (cJSON_IsNumber(if_version)) {
+                    cached = status_snapshot_conditional_reply((uint32_t)if_version->valuedouble);
+                }
+                cJSON_Delete(root);
+
+                if (cached != NULL) {
+                    response = dup_response(cached);
+                    server_sm_handle_event(ctx, SERVER_EVENT_COMPLETED);
+                    break;
+                }
+            }
+
+            status_snapshot_t snap;
+            status_snapshot_get(&snap);
+
+            cJSON *root = cJSON_CreateObject();
+            cJSON_AddStringToObject(root, "type", "ps5_status");
+            cJSON_AddNumberToObject(root, "version", snap.version);
+            cJSON_AddStringToObject(root, "status", snap.status);
+            cJSON_AddStringToObject(root, "ip", snap.ip);
+            cJSON_AddStringToObject(root, "mac", snap.mac);
+            cJSON_AddNumberToObject(root, "timestamp", (double)server_clock_now());
+            response = cJSON_PrintUnformatted(root);
+            cJSON_Delete(root);
+
+            server_sm_handle_event(ctx, SERVER_EVENT_COMPLETED);
+            break;
+        }
+
+        case WS_MSG_WAKE_PS5: {
+            server_sm_handle_event(ctx, SERVER_EVENT_WAKE_REQUEST);
+
+            wake_result_t result = ps5_wake(&ctx->ps5_status.info, 30);
+
+            cJSON *root = cJSON_CreateObject();
+            cJSON_AddStringToObject(root, "type", "wake_response");
+            cJSON_AddStringToObject(root, "status",
+                                    result == WAKE_RESULT_SUCCESS ? "success" : "failed");
+            response = cJSON_PrintUnformatted(root);
+            cJSON_Delete(root);
+
+            server_sm_handle_event(ctx, result == WAKE_RESULT_SUCCESS ?
+                                   SERVER_EVENT_COMPLETED : SERVER_EVENT_ERROR);
+
+            // The console reacts to Image View On
+            if (g_power != PS5_POWER_ON) {
+                g_power = PS5_POWER_ON;
+                g_power_since = server_clock_now();
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return response;
+}
+
+static void broadcast_status(const char *status) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "type", "ps5_status_update");
+    cJSON_AddNumberToObject(root, "version", status_snapshot_get_version());
+    cJSON_AddStringToObject(root, "status", status);
+    char *json = cJSON_PrintUnformatted(root);
+    ws_server_broadcast(json);
+    cJSON_free(json);
+    cJSON_Delete(root);
+    g_seen.broadcasts++;
+}
+
+static void process_state_machine(void) {
+    switch (server_sm_get_state(&g_ctx)) {
+        case SERVER_STATE_MONITORING:
+            server_sm_handle_event(&g_ctx, SERVER_EVENT_COMPLETED);
+            break;
+
+        case SERVER_STATE_DETECTING:
+            // Fake detector: the console is wherever DHCP put it
+            server_sm_update_ps5_info(&g_ctx, &g_console);
+            server_sm_handle_event(&g_ctx, SERVER_EVENT_COMPLETED);
+            break;
+
+        case SERVER_STATE_BROADCASTING:
+            broadcast_status(server_sm_get_ps5_status(&g_ctx));
+            server_sm_handle_event(&g_ctx, SERVER_EVENT_COMPLETED);
+            break;
+
+        case SERVER_STATE_ERROR:
+            server_sm_handle_event(&g_ctx, SERVER_EVENT_NONE);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void on_status_changed(const char *status) {
+    const ps5_info_t *info = &g_ctx.ps5_status.info;
+    bool is_ready = (strcmp(status, "ready") == 0);
+    bool is_on = is_ready || (strcmp(status, "on") == 0);
+
+    status_snapshot_update(status, info->ip, info->mac);
+
+    if (is_on) {
+        link_monitor_start(info->ip);
+    } else {
+        link_monitor_stop();
+    }
+
+    if (is_ready) {
+        broadcast_status(status);
+        g_seen.ready++;
+    } else if (is_on) {
+        ready_probe_start(info->ip);
+        g_probe_attempts = 0;
+    } else {
+        ready_probe_stop();
+    }
+}
+
+static void check_status_change(void) {
+    const char *status = server_sm_get_ps5_status(&g_ctx);
+    const char *ip = g_ctx.ps5_status.info.ip;
+
+    if (g_last_status == NULL || strcmp(g_last_status, status) != 0) {
+        on_status_changed(status);
+        g_last_status = status;
+    } else if (strcmp(g_last_ip, ip) != 0) {
+        on_status_changed(status);
+    }
+
+    snprintf(g_last_ip, sizeof(g_last_ip), "%s", ip);
+}
+
+/* ============================================================
+ *  Fake Backends
+ * ============================================================ */
+
+static void set_power(ps5_power_state_t power) {
+    if (g_power != power) {
+        g_power = power;
+        g_power_since = server_clock_now();
+    }
+}
+
+/**
+ * @brief CEC: occasional toggles and bursts of rapid flapping
+ */
+static void step_cec(void) {
+    if (g_flap_left > 0) {
+        g_flap_left--;
+        set_power(g_power == PS5_POWER_ON ? PS5_POWER_STANDBY : PS5_POWER_ON);
+    } else if (chance(SOAK_FLAP_BURST_SEC)) {
+        g_flap_left = 10;
+        g_seen.flap_bursts++;
+    } else if (chance(SOAK_POWER_TOGGLE_SEC)) {
+        set_power(g_power == PS5_POWER_ON ? PS5_POWER_STANDBY : PS5_POWER_ON);
+        g_seen.power_toggles++;
+    }
+
+    server_sm_update_cec_state(&g_ctx, g_power);
+}
+
+/**
+ * @brief Network: online after booting, new lease now and then
+ */
+static void step_network(void) {
+    time_t up = server_clock_now() - g_power_since;
+    bool online = (g_power == PS5_POWER_ON && up >= SOAK_BOOT_SEC);
+
+    if (chance(SOAK_DHCP_CHANGE_SEC)) {
+        snprintf(g_console.ip, sizeof(g_console.ip), "192.168.1.%u",
+                 100 + rng_next() % 100);
+        g_seen.dhcp_changes++;
+    }
+
+    if (online != g_console.online || strcmp(g_console.ip, g_ctx.ps5_status.info.ip) != 0) {
+        g_console.online = online;
+        g_console.last_seen = server_clock_now();
+        server_sm_update_ps5_info(&g_ctx, &g_console);
+    }
+}
+
+/**
+ * @brief Remote Play port and link probes answer like the console would
+ */
+static void step_probes(void) {
+    if (ready_probe_process() == READY_PROBE_PROBING &&
+        ready_probe_get_attempts() != g_probe_attempts) {
+        g_probe_attempts = ready_probe_get_attempts();
+        time_t up = server_clock_now() - g_power_since;
+        ready_probe_record_result(g_console.online &&
+                                  up >= SOAK_BOOT_SEC + SOAK_RP_DELAY_SEC);
+    }
+
+    if (ready_probe_get_state() == READY_PROBE_READY) {
+        server_sm_update_ready_state(&g_ctx, true);
+    }
+
+    if (link_monitor_is_active()) {
+        link_monitor_process();
+        link_monitor_record_sample(true, 2000 + rng_next() % 2000);
+    }
+}
+
+static void send_message(soak_client_t *client, const char *message) {
+    double start = wall_ns();
+    char *response = ws_server_test_handle_message(client->id, message);
+
+    if (response != NULL) {
+        cJSON *root = cJSON_Parse(response);
+        cJSON *version = cJSON_GetObjectItem(root, "version");
+        cJSON *type = cJSON_GetObjectItem(root, "type");
+
+        if (cJSON_IsNumber(version)) {
+            client->version = (uint32_t)version->valuedouble;
+        }
+        if (cJSON_IsString(type)) {
+            if (strcmp(type->valuestring, "not_modified") == 0) {
+                g_seen.not_modified++;
+            } else if (strcmp(type->valuestring, "ps5_status_delta") == 0) {
+                g_seen.deltas++;
+            }
+        }
+
+        cJSON_Delete(root);
+        cJSON_free(response);
+    }
+
+    g_day_latency_ns += wall_ns() - start;
+    g_day_messages++;
+}
+
+/**
+ * @brief Clients: join, poll, leave, and all wake at once now and then
+ */
+static void step_clients(void) {
+    time_t now = server_clock_now();
+
+    if (g_client_count < SOAK_MAX_CLIENTS && chance(SOAK_CLIENT_JOIN_SEC)) {
+        soak_client_t *client = &g_clients[g_client_count];
+        client->id = ws_server_test_add_client("192.168.1.50", (uint16_t)(40000 + g_client_count));
+        TEST_ASSERT_TRUE(client->id > 0);
+        client->version = 0;
+        client->next_poll = now;
+        g_client_count++;
+        g_seen.joins++;
+    }
+
+    if (g_client_count > 0 && chance(SOAK_CLIENT_LEAVE_SEC)) {
+        int idx = (int)(rng_next() % (uint32_t)g_client_count);
+        TEST_ASSERT_EQUAL(0, ws_server_test_remove_client(g_clients[idx].id));
+        g_clients[idx] = g_clients[--g_client_count];
+        g_seen.leaves++;
+    }
+
+    bool storm = (g_client_count > 0 && chance(SOAK_WAKE_STORM_SEC));
+    if (storm) {
+        g_seen.wake_storms++;
+    }
+
+    for (int i = 0; i < g_client_count; i++) {
+        soak_client_t *client = &g_clients[i];
+
+        if (storm) {
+            send_message(client, "{\"type\":\"wake_ps5\"}");
+            g_seen.wakes++;
+        }
+
+        if (now >= client->next_poll) {
+            char message[64];
+            if (client->version != 0) {
+                snprintf(message, sizeof(message),
+                         "{\"type\":\"query_ps5\",\"if_version\":%u}", client->version);
+            } else {
+                snprintf(message, sizeof(message), "{\"type\":\"query_ps5\"}");
+            }
+            send_message(client, message);
+            g_seen.queries++;
+            client->next_poll = now + 1 + (time_t)(rng_next() % (2 * SOAK_POLL_SEC));
+        }
+    }
+}
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    cJSON_Hooks hooks = { counting_malloc, counting_free };
+    cJSON_InitHooks(&hooks);
+
+    server_clock_use_fake(SOAK_START_TIME);
+
+    memset(&g_seen, 0, sizeof(g_seen));
+    memset(&g_console, 0, sizeof(g_console));
+    snprintf(g_console.ip, sizeof(g_console.ip), "192.168.1.100");
+    snprintf(g_console.mac, sizeof(g_console.mac), "AA:BB:CC:DD:EE:FF");
+    g_power = PS5_POWER_STANDBY;
+    g_power_since = server_clock_now();
+    g_flap_left = 0;
+    g_last_status = NULL;
+    g_last_ip[0] = '\0';
+    g_client_count = 0;
+    g_live_allocs = 0;
+    g_peak_allocs = 0;
+
+    TEST_ASSERT_EQUAL(0, server_sm_init(&g_ctx));
+    TEST_ASSERT_EQUAL(0, ws_server_init(8080));
+    TEST_ASSERT_EQUAL(0, ws_server_start());
+    ws_server_set_message_handler(soak_message_handler, &g_ctx);
+    TEST_ASSERT_EQUAL(0, ps5_wake_init("/dev/cec0"));
+    TEST_ASSERT_EQUAL(SNAPSHOT_OK, status_snapshot_init());
+    TEST_ASSERT_EQUAL(READY_PROBE_OK, ready_probe_init(0));
+    TEST_ASSERT_EQUAL(LINK_MON_OK, link_monitor_init(0));
+}
+
+void tearDown(void) {
+    link_monitor_cleanup();
+    ready_probe_cleanup();
+    status_snapshot_cleanup();
+    ps5_wake_cleanup();
+    ws_server_cleanup();
+    server_sm_cleanup(&g_ctx);
+
+    cJSON_InitHooks(NULL);
+    server_clock_use_real();
+}
+
+/* ============================================================
+ *  Soak Test
+ * ============================================================ */
+
+void test_soak_weeks_of_simulated_time(void) {
+    long days = env_long("SOAK_DAYS", SOAK_DEFAULT_DAYS);
+    if (days < 2) {
+        days = 2;  // Need a baseline day and a day to compare
+    } else if (days > SOAK_MAX_DAYS) {
+        days = SOAK_MAX_DAYS;
+    }
+    g_rng = (uint32_t)env_long("SOAK_SEED", SOAK_DEFAULT_SEED);
+    if (g_rng == 0) {
+        g_rng = SOAK_DEFAULT_SEED;  // xorshift needs a non-zero state
+    }
+
+    static soak_sample_t samples[SOAK_MAX_DAYS];
+    int fds_at_start = count_fds();
+    uint32_t first_version = status_snapshot_get_version();
+    double started = wall_ns();
+
+    printf("\n=== Soak: %ld simulated days, seed 0x%08X ===\n", days, (unsigned)g_rng);
+
+    for (long day = 0; day < days; day++) {
+        g_day_latency_ns = 0;
+        g_day_messages = 0;
+        time_t day_end = SOAK_START_TIME + (time_t)(day + 1) * 86400;
+
+        // One main loop pass per simulated second; wakes may sleep further
+        while (server_clock_now() < day_end) {
+            server_sm_update(&g_ctx);
+            step_cec();
+            step_network();
+            process_state_machine();
+            step_probes();
+            check_status_change();
+            step_clients();
+
+            server_clock_advance_ms(1000);
+        }
+
+        soak_sample_t *s = &samples[day];
+        s->rss_kb = read_rss_kb();
+        s->fds = count_fds();
+        s->live_allocs = g_live_allocs;
+        s->latency_ns = g_day_messages > 0 ? g_day_latency_ns / (double)g_day_messages : 0;
+
+        if (day % 7 == 6 || day == days - 1) {
+            printf("  day %3ld: rss %ld KB, fds %d, live allocs %ld, %.0f ns/msg (%ld msgs)\n",
+                   day + 1, s->rss_kb, s->fds, s->live_allocs, s->latency_ns, g_day_messages);
+        }
+
+        // Leaks show up long before the end of the run
+        TEST_ASSERT_EQUAL_MESSAGE(0, s->live_allocs, "cJSON allocations leaked");
+        TEST_ASSERT_EQUAL_MESSAGE(fds_at_start, s->fds, "file descriptors leaked");
+    }
+
+    printf("  %ld queries (%ld not_modified, %ld delta), %ld wakes in %ld storms\n",
+           g_seen.queries, g_seen.not_modified, g_seen.deltas, g_seen.wakes, g_seen.wake_storms);
+    printf("  %ld power toggles, %ld flap bursts, %ld DHCP changes, %ld joins, %ld leaves\n",
+           g_seen.power_toggles, g_seen.flap_bursts, g_seen.dhcp_changes, g_seen.joins, g_seen.leaves);
+    printf("  peak live allocs %ld, wall time %.1f s\n",
+           g_peak_allocs, (wall_ns() - started) / 1e9);
+
+    // The scenario must actually have exercised every path
+    TEST_ASSERT_TRUE(g_seen.power_toggles > 0);
+    TEST_ASSERT_TRUE(g_seen.flap_bursts > 0);
+    TEST_ASSERT_TRUE(g_seen.dhcp_changes > 0);
+    TEST_ASSERT_TRUE(g_seen.joins > 0 && g_seen.leaves > 0);
+    TEST_ASSERT_TRUE(g_seen.wake_storms > 0);
+    TEST_ASSERT_TRUE(g_seen.not_modified > 0);
+    TEST_ASSERT_TRUE(g_seen.ready > 0);
+    TEST_ASSERT_TRUE(status_snapshot_get_version() > first_version);
+
+    // Growth checks: last day against the first
+    const soak_sample_t *first = &samples[0];
+    const soak_sample_t *last = &samples[days - 1];
+
+    if (first->rss_kb > 0) {
+        TEST_ASSERT_TRUE_MESSAGE(last->rss_kb - first->rss_kb <= SOAK_RSS_SLACK_KB,
+                                 "RSS grew during soak");
+    }
+
+    TEST_ASSERT_TRUE_MESSAGE(last->latency_ns <=
+                             first->latency_ns * SOAK_LATENCY_FACTOR + SOAK_LATENCY_SLACK_NS,
+                             "message latency drifted during soak");
+
+    // The daemon is still healthy after weeks of churn
+    TEST_ASSERT_FALSE(server_sm_is_error(&g_ctx));
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_status_beacon.c
+ * @brief Unit tests for Status Beacon module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "status_beacon.h"
+#include "server_clock.h"
+#include <string.h>
+
+static beacon_status_t make_status(const char *ip, const char *mac) {
+    beacon_status_t status;
+    memset(&status, 0, sizeof(status));
+    status.status_version = 7;
+    status.power_state = 1;
+    status.network_online = true;
+    status.status = BEACON_STATUS_ON;
+    snprintf(status.ip, sizeof(status.ip), "%s", ip);
+    snprintf(status.mac, sizeof(status.mac), "%s", mac);
+    return status;
+}
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    status_beacon_cleanup();
+}
+
+void tearDown(void) {
+    status_beacon_cleanup();
+}
+
+/* ============================================================
+ *  Test Group 1: Initialization Tests
+ * ============================================================ */
+
+void test_status_beacon_init_with_defaults(void) {
+    TEST_ASSERT_EQUAL(BEACON_OK, status_beacon_init(NULL, 0));
+}
+
+void test_status_beacon_init_rejects_unicast_group(void) {
+    TEST_ASSERT_EQUAL(BEACON_ERROR_INVALID_PARAM, status_beacon_init("192.168.1.1", 0));
+    TEST_ASSERT_EQUAL(BEACON_ERROR_INVALID_PARAM, status_beacon_init("bogus", 0));
+}
+
+void test_status_beacon_publish_without_init(void) {
+    beacon_status_t status = make_status("192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    TEST_ASSERT_EQUAL(BEACON_ERROR_NOT_INIT, status_beacon_publish(&status));
+}
+
+/* ============================================================
+ *  Test Group 2: Encoding Tests
+ * ============================================================ */
+
+void test_status_beacon_encode_decode_roundtrip(void) {
+    uint8_t buf[STATUS_BEACON_PACKET_SIZE];
+    beacon_packet_t packet;
+    beacon_status_t status = make_status("192.168.1.100", "AA:BB:CC:DD:EE:FF");
+
+    TEST_ASSERT_EQUAL(STATUS_BEACON_PACKET_SIZE, status_beacon_encode(&status, 42, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(BEACON_OK, status_beacon_decode(buf, sizeof(buf), &packet));
+
+    TEST_ASSERT_EQUAL(STATUS_BEACON_PROTO_VERSION, packet.proto_version);
+    TEST_ASSERT_EQUAL(1, packet.power_state);
+    TEST_ASSERT_TRUE(packet.network_online);
+    TEST_ASSERT_EQUAL(BEACON_STATUS_ON, packet.status);
+    TEST_ASSERT_EQUAL_UINT32(42, packet.seq);
+    TEST_ASSERT_EQUAL_UINT32(7, packet.status_version);
+    TEST_ASSERT_EQUAL_HEX32(0xC0A80164u, packet.ipv4);
+}
+
+void test_status_beacon_magic_in_network_order(void) {
+    uint8_t buf[STATUS_BEACON_PACKET_SIZE];
+    beacon_status_t status = make_status("192.168.1.100", "AA:BB:CC:DD:EE:FF");
+
+    status_beacon_encode(&status, 0, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_MEMORY("GSBC", buf, 4);
+}
+
+void test_status_beacon_digest_changes_with_address(void) {
+    uint8_t a[STATUS_BEACON_PACKET_SIZE];
+    uint8_t b[STATUS_BEACON_PACKET_SIZE];
+    beacon_packet_t pa, pb;
+
+    beacon_status_t s1 = make_status("192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    beacon_status_t s2 = make_status("192.168.1.100", "AA:BB:CC:DD:EE:00");
+
+    status_beacon_encode(&s1, 0, a, sizeof(a));
+    status_beacon_encode(&s2, 0, b, sizeof(b));
+    status_beacon_decode(a, sizeof(a), &pa);
+    status_beacon_decode(b, sizeof(b), &pb);
+
+    TEST_ASSERT_NOT_EQUAL(pa.addr_digest, pb.addr_digest);
+}
+
+void test_status_beacon_encode_unknown_ip(void) {
+    uint8_t buf[STATUS_BEACON_PACKET_SIZE];
+    beacon_packet_t packet;
+    beacon_status_t status = make_status("", "");
+
+    status_beacon_encode(&status, 0, buf, sizeof(buf));
+    status_beacon_decode(buf, sizeof(buf), &packet);
+    TEST_ASSERT_EQUAL_UINT32(0, packet.ipv4);
+}
+
+void test_status_beacon_encode_buffer_too_small(void) {
+    uint8_t buf[8];
+    beacon_status_t status = make_status("192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    TEST_ASSERT_EQUAL(BEACON_ERROR_INVALID_PARAM, status_beacon_encode(&status, 0, buf, sizeof(buf)));
+}
+
+void test_status_beacon_decode_rejects_garbage(void) {
+    uint8_t buf[STATUS_BEACON_PACKET_SIZE] = {0};
+    beacon_packet_t packet;
+
+    TEST_ASSERT_EQUAL(BEACON_ERROR_BAD_PACKET, status_beacon_decode(buf, sizeof(buf), &packet));
+    TEST_ASSERT_EQUAL(BEACON_ERROR_BAD_PACKET, status_beacon_decode(buf, 4, &packet));
+}
+
+/* ============================================================
+ *  Test Group 3: Publishing Tests
+ * ============================================================ */
+
+void test_status_beacon_publish_sends_immediately(void) {
+    beacon_status_t status = make_status("192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    status_beacon_init(NULL, 0);
+
+    TEST_ASSERT_EQUAL(BEACON_OK, status_beacon_publish(&status));
+    TEST_ASSERT_EQUAL_UINT32(1, status_beacon_get_sent_count());
+}
+
+void test_status_beacon_no_heartbeat_before_interval(void) {
+    beacon_status_t status = make_status("192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    status_beacon_init(NULL, 0);
+
+    status_beacon_publish(&status);
+    status_beacon_process();
+    TEST_ASSERT_EQUAL_UINT32(1, status_beacon_get_sent_count());
+}
+
+void test_status_beacon_no_heartbeat_without_status(void) {
+    status_beacon_init(NULL, 0);
+    status_beacon_process();
+    TEST_ASSERT_EQUAL_UINT32(0, status_beacon_get_sent_count());
+}
+
+/* ============================================================
+ *  Test Group 4: String Conversion Tests
+ * ============================================================ */
+
+void test_status_beacon_code_from_string(void) {
+    TEST_ASSERT_EQUAL(BEACON_STATUS_READY, status_beacon_code_from_string("ready"));
+    TEST_ASSERT_EQUAL(BEACON_STATUS_ON, status_beacon_code_from_string("on"));
+    TEST_ASSERT_EQUAL(BEACON_STATUS_STANDBY, status_beacon_code_from_string("standby"));
+    TEST_ASSERT_EQUAL(BEACON_STATUS_STARTING, status_beacon_code_from_string("starting"));
+    TEST_ASSERT_EQUAL(BEACON_STATUS_OFF, status_beacon_code_from_string("off"));
+    TEST_ASSERT_EQUAL(BEACON_STATUS_UNKNOWN, status_beacon_code_from_string("unknown"));
+    TEST_ASSERT_EQUAL(BEACON_STATUS_UNKNOWN, status_beacon_code_from_string(NULL));
+}
+
+void test_status_beacon_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", status_beacon_error_string(BEACON_OK));
+    TEST_ASSERT_EQUAL_STRING("Bad packet", status_beacon_error_string(BEACON_ERROR_BAD_PACKET));
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_status_snapshot.c
+ * @brief Unit tests for Status Snapshot module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "status_snapshot.h"
+#include "server_clock.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    status_snapshot_cleanup();
+    status_snapshot_init();
+}
+
+void tearDown(void) {
+    status_snapshot_cleanup();
+}
+
+/* ============================================================
+ *  Test Group 1: Versioning Tests
+ * ============================================================ */
+
+void test_status_snapshot_double_init_fails(void) {
+    TEST_ASSERT_EQUAL(SNAPSHOT_ERROR_NOT_INIT, status_snapshot_init());
+}
+
+void test_status_snapshot_version_without_init(void) {
+    status_snapshot_cleanup();
+    TEST_ASSERT_EQUAL_UINT32(0, status_snapshot_get_version());
+    TEST_ASSERT_NULL(status_snapshot_conditional_reply(0));
+}
+
+void test_status_snapshot_update_bumps_version(void) {
+    uint32_t v0 = status_snapshot_get_version();
+
+    TEST_ASSERT_TRUE(status_snapshot_update("on", "192.168.1.100", "AA:BB:CC:DD:EE:FF"));
+    TEST_ASSERT_EQUAL_UINT32(v0 + 1, status_snapshot_get_version());
+
+    TEST_ASSERT_TRUE(status_snapshot_update("ready", "192.168.1.100", "AA:BB:CC:DD:EE:FF"));
+    TEST_ASSERT_EQUAL_UINT32(v0 + 2, status_snapshot_get_version());
+}
+
+void test_status_snapshot_unchanged_keeps_version(void) {
+    status_snapshot_update("on", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    uint32_t v = status_snapshot_get_version();
+
+    TEST_ASSERT_FALSE(status_snapshot_update("on", "192.168.1.100", "AA:BB:CC:DD:EE:FF"));
+    TEST_ASSERT_EQUAL_UINT32(v, status_snapshot_get_version());
+}
+
+void test_status_snapshot_get_current(void) {
+    status_snapshot_t snap;
+    status_snapshot_update("standby", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+
+    TEST_ASSERT_EQUAL(SNAPSHOT_OK, status_snapshot_get(&snap));
+    TEST_ASSERT_EQUAL_STRING("standby", snap.status);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.100", snap.ip);
+    TEST_ASSERT_EQUAL_UINT32(status_snapshot_get_version(), snap.version);
+    TEST_ASSERT_EQUAL(SNAPSHOT_ERROR_INVALID_PARAM, status_snapshot_get(NULL));
+}
+
+/* ============================================================
+ *  Test Group 2: Conditional Reply Tests
+ * ============================================================ */
+
+void test_status_snapshot_not_modified_when_current(void) {
+    char expected[SNAPSHOT_FRAME_MAX_LEN];
+    status_snapshot_update("on", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    uint32_t v = status_snapshot_get_version();
+
+    snprintf(expected, sizeof(expected), "{\"type\":\"not_modified\",\"version\":%u}", v);
+    TEST_ASSERT_EQUAL_STRING(expected, status_snapshot_conditional_reply(v));
+}
+
+void test_status_snapshot_delta_carries_only_changes(void) {
+    char expected[SNAPSHOT_FRAME_MAX_LEN];
+    status_snapshot_update("on", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    uint32_t from = status_snapshot_get_version();
+    status_snapshot_update("ready", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+
+    snprintf(expected, sizeof(expected),
+             "{\"type\":\"ps5_status_delta\",\"version\":%u,\"from\":%u,\"status\":\"ready\"}",
+             from + 1, from);
+    TEST_ASSERT_EQUAL_STRING(expected, status_snapshot_conditional_reply(from));
+}
+
+void test_status_snapshot_delta_across_several_versions(void) {
+    char expected[SNAPSHOT_FRAME_MAX_LEN];
+    status_snapshot_update("on", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    uint32_t from = status_snapshot_get_version();
+    status_snapshot_update("standby", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    status_snapshot_update("on", "192.168.1.120", "AA:BB:CC:DD:EE:FF");
+
+    snprintf(expected, sizeof(expected),
+             "{\"type\":\"ps5_status_delta\",\"version\":%u,\"from\":%u,\"ip\":\"192.168.1.120\"}",
+             from + 2, from);
+    TEST_ASSERT_EQUAL_STRING(expected, status_snapshot_conditional_reply(from));
+}
+
+void test_status_snapshot_reply_is_cached(void) {
+    status_snapshot_update("on", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    uint32_t from = status_snapshot_get_version();
+    status_snapshot_update("ready", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+
+    const char *first = status_snapshot_conditional_reply(from);
+    const char *second = status_snapshot_conditional_reply(from);
+
+    TEST_ASSERT_TRUE(first == second);
+}
+
+void test_status_snapshot_full_reply_when_too_old_or_unknown(void) {
+    status_snapshot_update("on", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    uint32_t oldest = status_snapshot_get_version();
+
+    for (int i = 0; i < SNAPSHOT_HISTORY_SIZE; i++) {
+        status_snapshot_update((i % 2) ? "on" : "standby", "192.168.1.100", "AA:BB:CC:DD:EE:FF");
+    }
+
+    TEST_ASSERT_NULL(status_snapshot_conditional_reply(oldest));
+    TEST_ASSERT_NULL(status_snapshot_conditional_reply(status_snapshot_get_version() + 1));
+    TEST_ASSERT_NULL(status_snapshot_conditional_reply(0));
+}
+
+/* ============================================================
+ *  Test Group 3: Error String Tests
+ * ============================================================ */
+
+void test_status_snapshot_error_strings(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", status_snapshot_error_string(SNAPSHOT_OK));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", status_snapshot_error_string(-50));
+}
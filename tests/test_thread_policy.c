@@ -0,0 +1,195 @@
+/**
+ * @file test_thread_policy.c
+ * @brief Unit tests for Thread Policy
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "thread_policy.h"
+#include <string.h>
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+static thread_policy_t g_policy;
+
+void setUp(void) {
+    thread_policy_init();
+    memset(&g_policy, 0, sizeof(g_policy));
+}
+
+void tearDown(void) {
+    thread_policy_cleanup();
+}
+
+/* ============================================================
+ *  Test Group 1: Default Tests
+ * ============================================================ */
+
+void test_thread_policy_defaults(void) {
+    thread_policy_get(THREAD_CLASS_MAIN, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_NORMAL, g_policy.sched);
+    TEST_ASSERT_EQUAL(0, g_policy.cpu_mask);
+
+    thread_policy_get(THREAD_CLASS_CEC, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_NORMAL, g_policy.sched);
+
+    thread_policy_get(THREAD_CLASS_WORKER, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_NICE, g_policy.sched);
+    TEST_ASSERT_EQUAL(THREAD_POLICY_BACKGROUND_NICE, g_policy.nice);
+
+    thread_policy_get(THREAD_CLASS_WEBHOOK, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_NICE, g_policy.sched);
+    TEST_ASSERT_EQUAL(THREAD_POLICY_BACKGROUND_NICE, g_policy.nice);
+}
+
+void test_thread_policy_before_init_should_fail(void) {
+    thread_policy_cleanup();
+
+    TEST_ASSERT_EQUAL(THREAD_POLICY_ERROR_NOT_INIT, thread_policy_get(THREAD_CLASS_MAIN, &g_policy));
+    TEST_ASSERT_EQUAL(THREAD_POLICY_ERROR_NOT_INIT, thread_policy_add_rule("worker=idle"));
+    TEST_ASSERT_EQUAL(THREAD_POLICY_ERROR_NOT_INIT, thread_policy_apply(THREAD_CLASS_WORKER));
+}
+
+/* ============================================================
+ *  Test Group 2: Rule Tests
+ * ============================================================ */
+
+void test_thread_policy_rule_idle_with_cpus(void) {
+    TEST_ASSERT_EQUAL(THREAD_POLICY_OK, thread_policy_add_rule("worker=idle@1-3"));
+
+    thread_policy_get(THREAD_CLASS_WORKER, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_IDLE, g_policy.sched);
+    TEST_ASSERT_EQUAL_HEX32(0x0E, g_policy.cpu_mask);
+}
+
+void test_thread_policy_rule_nice_with_cpu_list(void) {
+    TEST_ASSERT_EQUAL(THREAD_POLICY_OK, thread_policy_add_rule("webhook=nice:15@0,2-3"));
+
+    thread_policy_get(THREAD_CLASS_WEBHOOK, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_NICE, g_policy.sched);
+    TEST_ASSERT_EQUAL(15, g_policy.nice);
+    TEST_ASSERT_EQUAL_HEX32(0x0D, g_policy.cpu_mask);
+}
+
+void test_thread_policy_rule_cpus_only_keeps_sched(void) {
+    TEST_ASSERT_EQUAL(THREAD_POLICY_OK, thread_policy_add_rule("worker=@3"));
+
+    thread_policy_get(THREAD_CLASS_WORKER, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_NICE, g_policy.sched);
+    TEST_ASSERT_EQUAL(THREAD_POLICY_BACKGROUND_NICE, g_policy.nice);
+    TEST_ASSERT_EQUAL_HEX32(0x08, g_policy.cpu_mask);
+}
+
+void test_thread_policy_rule_sched_only_keeps_cpus(void) {
+    thread_policy_add_rule("main=@0");
+    TEST_ASSERT_EQUAL(THREAD_POLICY_OK, thread_policy_add_rule("main=normal"));
+
+    thread_policy_get(THREAD_CLASS_MAIN, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_NORMAL, g_policy.sched);
+    TEST_ASSERT_EQUAL_HEX32(0x01, g_policy.cpu_mask);
+}
+
+void test_thread_policy_rule_all_clears_mask(void) {
+    thread_policy_add_rule("cec=@1");
+    TEST_ASSERT_EQUAL(THREAD_POLICY_OK, thread_policy_add_rule("cec=@all"));
+
+    thread_policy_get(THREAD_CLASS_CEC, &g_policy);
+    TEST_ASSERT_EQUAL(0, g_policy.cpu_mask);
+}
+
+void test_thread_policy_invalid_rule_changes_nothing(void) {
+    const char *bad[] = {
+        "worker", "worker=", "scanner=idle", "worker=fast", "worker=nice:20", "worker=nice:-1",
+        "worker=nice:", "worker=idle@", "worker=idle@32", "worker=idle@3-1", "worker=idle@1;2",
+        "worker=idle@1,", NULL
+    };
+    TEST_ASSERT_EQUAL(THREAD_POLICY_ERROR_INVALID_PARAM, thread_policy_add_rule(NULL));
+    for (int i = 0; bad[i] != NULL; i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(THREAD_POLICY_ERROR_INVALID_PARAM, thread_policy_add_rule(bad[i]), bad[i]);
+    }
+
+    thread_policy_get(THREAD_CLASS_WORKER, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_NICE, g_policy.sched);
+    TEST_ASSERT_EQUAL(0, g_policy.cpu_mask);
+}
+
+void test_thread_policy_rule_too_long_should_fail(void) {
+    char rule[THREAD_POLICY_RULE_MAX_LEN + 8];
+    memset(rule, '0', sizeof(rule) - 1);
+    rule[sizeof(rule) - 1] = '\0';
+    memcpy(rule, "main=@", 6);
+
+    TEST_ASSERT_EQUAL(THREAD_POLICY_ERROR_INVALID_PARAM, thread_policy_add_rule(rule));
+}
+
+/* ============================================================
+ *  Test Group 3: Apply / Stats Tests
+ * ============================================================ */
+
+void test_thread_policy_apply_counts_per_class(void) {
+    thread_policy_apply(THREAD_CLASS_WORKER);
+    thread_policy_apply(THREAD_CLASS_WORKER);
+    TEST_ASSERT_EQUAL(THREAD_POLICY_OK, thread_policy_apply(THREAD_CLASS_MAIN));
+
+    thread_policy_stats_t stats;
+    thread_policy_get_stats(THREAD_CLASS_WORKER, &stats);
+    TEST_ASSERT_EQUAL(2, stats.applied);
+    TEST_ASSERT_EQUAL(0, stats.failed);
+
+    thread_policy_get_stats(THREAD_CLASS_WEBHOOK, &stats);
+    TEST_ASSERT_EQUAL(0, stats.applied);
+}
+
+void test_thread_policy_init_resets_rules_and_stats(void) {
+    thread_policy_add_rule("worker=idle@1");
+    thread_policy_apply(THREAD_CLASS_WORKER);
+
+    thread_policy_init();
+
+    thread_policy_stats_t stats;
+    thread_policy_get_stats(THREAD_CLASS_WORKER, &stats);
+    TEST_ASSERT_EQUAL(0, stats.applied);
+
+    thread_policy_get(THREAD_CLASS_WORKER, &g_policy);
+    TEST_ASSERT_EQUAL(THREAD_SCHED_NICE, g_policy.sched);
+    TEST_ASSERT_EQUAL(0, g_policy.cpu_mask);
+}
+
+void test_thread_policy_invalid_class_should_fail(void) {
+    thread_policy_stats_t stats;
+
+    TEST_ASSERT_EQUAL(THREAD_POLICY_ERROR_INVALID_PARAM, thread_policy_get(THREAD_CLASS_COUNT, &g_policy));
+    TEST_ASSERT_EQUAL(THREAD_POLICY_ERROR_INVALID_PARAM, thread_policy_get(THREAD_CLASS_MAIN, NULL));
+    TEST_ASSERT_EQUAL(THREAD_POLICY_ERROR_INVALID_PARAM, thread_policy_apply(THREAD_CLASS_COUNT));
+    TEST_ASSERT_EQUAL(THREAD_POLICY_ERROR_INVALID_PARAM, thread_policy_get_stats(THREAD_CLASS_COUNT, &stats));
+}
+
+/* ============================================================
+ *  Test Group 4: String Tests
+ * ============================================================ */
+
+void test_thread_class_to_string(void) {
+    TEST_ASSERT_EQUAL_STRING("main", thread_class_to_string(THREAD_CLASS_MAIN));
+    TEST_ASSERT_EQUAL_STRING("cec", thread_class_to_string(THREAD_CLASS_CEC));
+    TEST_ASSERT_EQUAL_STRING("worker", thread_class_to_string(THREAD_CLASS_WORKER));
+    TEST_ASSERT_EQUAL_STRING("webhook", thread_class_to_string(THREAD_CLASS_WEBHOOK));
+    TEST_ASSERT_EQUAL_STRING("unknown", thread_class_to_string(THREAD_CLASS_COUNT));
+}
+
+void test_thread_sched_to_string(void) {
+    TEST_ASSERT_EQUAL_STRING("normal", thread_sched_to_string(THREAD_SCHED_NORMAL));
+    TEST_ASSERT_EQUAL_STRING("nice", thread_sched_to_string(THREAD_SCHED_NICE));
+    TEST_ASSERT_EQUAL_STRING("idle", thread_sched_to_string(THREAD_SCHED_IDLE));
+    TEST_ASSERT_EQUAL_STRING("unknown", thread_sched_to_string((thread_sched_t)99));
+}
+
+void test_thread_policy_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", thread_policy_error_string(THREAD_POLICY_OK));
+    TEST_ASSERT_EQUAL_STRING("Not initialized", thread_policy_error_string(THREAD_POLICY_ERROR_NOT_INIT));
+    TEST_ASSERT_EQUAL_STRING("Invalid parameter", thread_policy_error_string(THREAD_POLICY_ERROR_INVALID_PARAM));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", thread_policy_error_string(-50));
+}
@@ -0,0 +1,238 @@
+/**
+ * @file test_webhook_dispatcher.c
+ * @brief Unit tests for Webhook Dispatcher module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "unity.h"
+#include "webhook_dispatcher.h"
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Wait (up to 2s) for the worker to deliver the given number of events
+ */
+static void wait_for_events_sent(uint32_t expected, webhook_stats_t *stats) {
+    struct timespec ts = { .tv_sec = 0, .tv_nsec = 10 * 1000000L };
+
+    for (int i = 0; i < 200; i++) {
+        webhook_dispatcher_get_stats(stats);
+        if (stats->events_sent >= expected) {
+            return;
+        }
+        nanosleep(&ts, NULL);
+    }
+}
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+void setUp(void) {
+    webhook_dispatcher_cleanup();
+}
+
+void tearDown(void) {
+    webhook_dispatcher_cleanup();
+}
+
+/* ============================================================
+ *  Test Group 1: Initialization Tests
+ * ============================================================ */
+
+void test_webhook_dispatcher_init_success(void) {
+    TEST_ASSERT_EQUAL(WEBHOOK_OK, webhook_dispatcher_init());
+}
+
+void test_webhook_dispatcher_double_init_fails(void) {
+    TEST_ASSERT_EQUAL(WEBHOOK_OK, webhook_dispatcher_init());
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_NOT_INIT, webhook_dispatcher_init());
+}
+
+void test_webhook_dispatcher_notify_without_init(void) {
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_NOT_INIT, webhook_dispatcher_notify("cec_state", NULL));
+}
+
+void test_webhook_dispatcher_endpoint_limit(void) {
+    webhook_dispatcher_init();
+
+    for (int i = 0; i < WEBHOOK_MAX_ENDPOINTS; i++) {
+        TEST_ASSERT_EQUAL(WEBHOOK_OK, webhook_dispatcher_add_endpoint("http://10.0.0.2/hook"));
+    }
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_NO_SPACE, webhook_dispatcher_add_endpoint("http://10.0.0.2/hook"));
+}
+
+/* ============================================================
+ *  Test Group 2: URL and HTTP Tests
+ * ============================================================ */
+
+void test_webhook_parse_url_full(void) {
+    webhook_endpoint_t ep;
+
+    TEST_ASSERT_EQUAL(WEBHOOK_OK, webhook_parse_url("http://homeserver.lan:8123/api/ps5", &ep));
+    TEST_ASSERT_EQUAL_STRING("homeserver.lan", ep.host);
+    TEST_ASSERT_EQUAL(8123, ep.port);
+    TEST_ASSERT_EQUAL_STRING("/api/ps5", ep.path);
+}
+
+void test_webhook_parse_url_defaults(void) {
+    webhook_endpoint_t ep;
+
+    TEST_ASSERT_EQUAL(WEBHOOK_OK, webhook_parse_url("http://192.168.1.10", &ep));
+    TEST_ASSERT_EQUAL_STRING("192.168.1.10", ep.host);
+    TEST_ASSERT_EQUAL(80, ep.port);
+    TEST_ASSERT_EQUAL_STRING("/", ep.path);
+}
+
+void test_webhook_parse_url_invalid(void) {
+    webhook_endpoint_t ep;
+
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_INVALID_PARAM, webhook_parse_url("https://host/", &ep));
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_INVALID_PARAM, webhook_parse_url("http://:80/", &ep));
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_INVALID_PARAM, webhook_parse_url("http://host:99999/", &ep));
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_INVALID_PARAM, webhook_parse_url(NULL, &ep));
+}
+
+void test_webhook_build_body_array(void) {
+    webhook_event_t events[2];
+    char body[512];
+    memset(events, 0, sizeof(events));
+
+    events[0].seq = 1;
+    events[0].timestamp = 100;
+    snprintf(events[0].type, sizeof(events[0].type), "cec_state");
+    snprintf(events[0].data, sizeof(events[0].data), "{\"power_state\":\"ON\"}");
+    events[1].seq = 2;
+    events[1].timestamp = 101;
+    snprintf(events[1].type, sizeof(events[1].type), "network");
+    snprintf(events[1].data, sizeof(events[1].data), "{}");
+
+    int len = webhook_build_body(events, 2, body, sizeof(body));
+
+    TEST_ASSERT_EQUAL_STRING(
+        "[{\"seq\":1,\"type\":\"cec_state\",\"timestamp\":100,\"data\":{\"power_state\":\"ON\"}},"
+        "{\"seq\":2,\"type\":\"network\",\"timestamp\":101,\"data\":{}}]", body);
+    TEST_ASSERT_EQUAL((int)strlen(body), len);
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_NO_SPACE, webhook_build_body(events, 2, body, 16));
+}
+
+void test_webhook_build_request_keep_alive(void) {
+    webhook_endpoint_t ep;
+    char request[512];
+    webhook_parse_url("http://10.0.0.2:8080/hook", &ep);
+
+    int len = webhook_build_request(&ep, "[]", request, sizeof(request));
+
+    TEST_ASSERT_GREATER_THAN(0, len);
+    TEST_ASSERT_NOT_NULL(strstr(request, "POST /hook HTTP/1.1\r\n"));
+    TEST_ASSERT_NOT_NULL(strstr(request, "Content-Length: 2\r\n"));
+    TEST_ASSERT_NOT_NULL(strstr(request, "Connection: keep-alive\r\n"));
+    TEST_ASSERT_EQUAL_STRING("\r\n\r\n[]", request + len - 6);
+}
+
+void test_webhook_parse_response(void) {
+    size_t content_length;
+    bool keep_alive;
+
+    TEST_ASSERT_EQUAL(204, webhook_parse_response("HTTP/1.1 204 No Content\r\n\r\n",
+                                                  &content_length, &keep_alive));
+    TEST_ASSERT_EQUAL(0, content_length);
+    TEST_ASSERT_TRUE(keep_alive);
+
+    TEST_ASSERT_EQUAL(500, webhook_parse_response(
+        "HTTP/1.1 500 Error\r\ncontent-length: 12\r\nConnection: close\r\n\r\n",
+        &content_length, &keep_alive));
+    TEST_ASSERT_EQUAL(12, content_length);
+    TEST_ASSERT_FALSE(keep_alive);
+
+    TEST_ASSERT_EQUAL(200, webhook_parse_response("HTTP/1.0 200 OK\r\n\r\n",
+                                                  &content_length, &keep_alive));
+    TEST_ASSERT_FALSE(keep_alive);
+
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_INVALID_PARAM,
+                      webhook_parse_response("garbage\r\n\r\n", &content_length, &keep_alive));
+}
+
+/* ============================================================
+ *  Test Group 3: Queue and Delivery Tests
+ * ============================================================ */
+
+void test_webhook_dispatcher_notify_without_endpoints_is_noop(void) {
+    webhook_stats_t stats;
+    webhook_dispatcher_init();
+
+    TEST_ASSERT_EQUAL(WEBHOOK_OK, webhook_dispatcher_notify("cec_state", NULL));
+    webhook_dispatcher_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.queued);
+}
+
+void test_webhook_dispatcher_notify_rejects_oversized_data(void) {
+    char data[WEBHOOK_DATA_MAX_LEN + 1];
+    memset(data, 'x', sizeof(data) - 1);
+    data[sizeof(data) - 1] = '\0';
+
+    webhook_dispatcher_init();
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_INVALID_PARAM, webhook_dispatcher_notify("x", data));
+    TEST_ASSERT_EQUAL(WEBHOOK_ERROR_INVALID_PARAM, webhook_dispatcher_notify("", NULL));
+}
+
+void test_webhook_dispatcher_queue_drops_oldest_when_full(void) {
+    webhook_stats_t stats;
+    webhook_dispatcher_init();
+    webhook_dispatcher_add_endpoint("http://10.0.0.2/hook");
+
+    for (int i = 0; i < WEBHOOK_QUEUE_SIZE + 5; i++) {
+        TEST_ASSERT_EQUAL(WEBHOOK_OK, webhook_dispatcher_notify("cec_state", NULL));
+    }
+
+    webhook_dispatcher_get_stats(&stats);
+    TEST_ASSERT_EQUAL(WEBHOOK_QUEUE_SIZE, stats.queued);
+    TEST_ASSERT_EQUAL(5, stats.events_dropped);
+}
+
+void test_webhook_dispatcher_burst_is_coalesced(void) {
+    webhook_stats_t stats;
+    webhook_dispatcher_init();
+    webhook_dispatcher_add_endpoint("http://10.0.0.2/hook");
+
+    for (int i = 0; i < 5; i++) {
+        webhook_dispatcher_notify("cec_state", "{}");
+    }
+
+    TEST_ASSERT_EQUAL(WEBHOOK_OK, webhook_dispatcher_start());
+    wait_for_events_sent(5, &stats);
+
+    TEST_ASSERT_EQUAL(5, stats.events_sent);
+    TEST_ASSERT_EQUAL(1, stats.batches_sent);
+    TEST_ASSERT_EQUAL(0, stats.queued);
+}
+
+void test_webhook_dispatcher_large_burst_split_into_batches(void) {
+    webhook_stats_t stats;
+    webhook_dispatcher_init();
+    webhook_dispatcher_add_endpoint("http://10.0.0.2/hook");
+
+    for (int i = 0; i < WEBHOOK_BATCH_MAX * 2; i++) {
+        webhook_dispatcher_notify("network", "{}");
+    }
+
+    webhook_dispatcher_start();
+    wait_for_events_sent(WEBHOOK_BATCH_MAX * 2, &stats);
+
+    TEST_ASSERT_EQUAL(WEBHOOK_BATCH_MAX * 2, stats.events_sent);
+    TEST_ASSERT_EQUAL(2, stats.batches_sent);
+}
+
+/* ============================================================
+ *  Test Group 4: Error String Tests
+ * ============================================================ */
+
+void test_webhook_dispatcher_error_strings(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", webhook_dispatcher_error_string(WEBHOOK_OK));
+    TEST_ASSERT_EQUAL_STRING("No space", webhook_dispatcher_error_string(WEBHOOK_ERROR_NO_SPACE));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", webhook_dispatcher_error_string(-50));
+}
@@ -8,6 +8,8 @@
 
 #include "unity.h"
 #include "websocket_server.h"
+#include "server_clock.h"
+#include "client_acl.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -36,6 +38,7 @@ void setUp(void) {
 void tearDown(void) {
     // 每個測試後清理
     ws_server_cleanup();
+    client_acl_cleanup();
 }
 
 // ============================================
@@ -311,6 +314,54 @@ void test_ws_server_broadcast_should_send_to_all_clients(void) {
     TEST_ASSERT_EQUAL(3, sent_count);
 }
 
+void test_ws_server_stalled_client_holds_frames(void) {
+    server_clock_use_fake(1000);
+    ws_server_start();
+    
+    int slow_id = ws_server_test_add_client("192.168.1.101", 12345);
+    ws_server_test_add_client("192.168.1.102", 12346);
+    
+    TEST_ASSERT_EQUAL(0, ws_server_stall_client(slow_id, 2000));
+    TEST_ASSERT_EQUAL(-2, ws_server_stall_client(999, 2000));
+    
+    // 只有停滯的客戶端暫存,其他客戶端照常送出
+    TEST_ASSERT_EQUAL(1, ws_server_send(slow_id, "{\"type\":\"test\"}"));
+    TEST_ASSERT_EQUAL(1, ws_server_broadcast("{\"type\":\"broadcast_test\"}"));
+    
+    ws_client_info_t clients[2];
+    TEST_ASSERT_EQUAL(2, ws_server_get_clients(clients, 2));
+    TEST_ASSERT_TRUE(clients[0].stalled);
+    TEST_ASSERT_FALSE(clients[1].stalled);
+    
+    // 截止前不補送
+    server_clock_advance_ms(1999);
+    ws_server_service(0);
+    ws_server_get_clients(clients, 2);
+    TEST_ASSERT_TRUE(clients[0].stalled);
+    
+    server_clock_advance_ms(1);
+    ws_server_service(0);
+    ws_server_get_clients(clients, 2);
+    TEST_ASSERT_FALSE(clients[0].stalled);
+    TEST_ASSERT_EQUAL(0, ws_server_send(slow_id, "{\"type\":\"test\"}"));
+    
+    server_clock_use_real();
+}
+
+void test_ws_server_stalled_client_held_frames_are_bounded(void) {
+    ws_server_start();
+    
+    int client_id = ws_server_test_add_client("192.168.1.101", 12345);
+    ws_server_stall_client(client_id, 60000);
+    
+    for (int i = 0; i < WS_SERVER_HELD_FRAMES_MAX * 2; i++) {
+        TEST_ASSERT_EQUAL(1, ws_server_send(client_id, "{\"type\":\"test\"}"));
+    }
+    
+    // 斷線時丟棄暫存 (tearDown 的 cleanup 也會)
+    TEST_ASSERT_EQUAL(0, ws_server_test_remove_client(client_id));
+}
+
 void test_ws_server_broadcast_with_no_clients(void) {
     ws_server_start();
     
@@ -346,6 +397,7 @@ void test_ws_message_type_to_string(void) {
     TEST_ASSERT_EQUAL_STRING("wake_ps5", ws_message_type_to_string(WS_MSG_WAKE_PS5));
     TEST_ASSERT_EQUAL_STRING("ping", ws_message_type_to_string(WS_MSG_PING));
     TEST_ASSERT_EQUAL_STRING("pong", ws_message_type_to_string(WS_MSG_PONG));
+    TEST_ASSERT_EQUAL_STRING("stats", ws_message_type_to_string(WS_MSG_STATS));
 }
 
 void test_ws_server_state_to_string(void) {
@@ -359,6 +411,83 @@ void test_ws_server_error_string(void) {
     TEST_ASSERT_EQUAL_STRING("Success", msg);
 }
 
+// ============================================
+// ACL 測試
+// ============================================
+
+void test_ws_server_acl_denied_peer_is_rejected(void) {
+    client_acl_init();
+    client_acl_add_rule("192.168.1.0/24");
+    ws_server_set_connect_callback(test_connect_callback, NULL);
+    ws_server_start();
+    
+    int client_id = ws_server_accept_client("10.0.0.5", 12345);
+    
+    TEST_ASSERT_EQUAL(-5, client_id);
+    TEST_ASSERT_EQUAL(0, ws_server_get_client_count());
+    TEST_ASSERT_EQUAL(0, g_connect_count);
+    TEST_ASSERT_EQUAL_STRING("Rejected by ACL", ws_server_error_string(-5));
+}
+
+void test_ws_server_acl_query_only_peer_cannot_wake(void) {
+    client_acl_init();
+    client_acl_add_rule("192.168.1.0/24=query");
+    ws_server_set_message_handler(test_message_handler, NULL);
+    ws_server_start();
+    
+    int client_id = ws_server_accept_client("192.168.1.100", 12345);
+    TEST_ASSERT_TRUE(client_id > 0);
+    
+    char *response = ws_server_handle_message(client_id, "{\"type\":\"wake_ps5\"}");
+    TEST_ASSERT_NOT_NULL(response);
+    TEST_ASSERT_TRUE(strstr(response, "wake_response") != NULL);
+    TEST_ASSERT_TRUE(strstr(response, "denied") != NULL);
+    TEST_ASSERT_EQUAL(0, g_message_count);
+    free(response);
+    
+    response = ws_server_handle_message(client_id, "{\"type\":\"query_ps5\"}");
+    TEST_ASSERT_NOT_NULL(response);
+    TEST_ASSERT_TRUE(strstr(response, "ps5_status") != NULL);
+    TEST_ASSERT_EQUAL(1, g_message_count);
+    free(response);
+}
+
+void test_ws_server_acl_wake_peer_can_wake(void) {
+    client_acl_init();
+    client_acl_add_rule("192.168.1.0/24=query");
+    client_acl_add_rule("192.168.1.100=wake");
+    ws_server_set_message_handler(test_message_handler, NULL);
+    ws_server_start();
+    
+    int client_id = ws_server_accept_client("192.168.1.100", 12345);
+    char *response = ws_server_handle_message(client_id, "{\"type\":\"wake_ps5\"}");
+    
+    TEST_ASSERT_NOT_NULL(response);
+    TEST_ASSERT_TRUE(strstr(response, "success") != NULL);
+    TEST_ASSERT_EQUAL(1, g_message_count);
+    free(response);
+}
+
+void test_ws_server_acl_accepts_ipv6_peer(void) {
+    client_acl_init();
+    client_acl_add_rule("fd00::/8");
+    ws_server_start();
+    
+    int client_id = ws_server_accept_client("fd12:3456::1", 12345);
+    TEST_ASSERT_TRUE(client_id > 0);
+    
+    ws_client_info_t clients[1];
+    TEST_ASSERT_EQUAL(1, ws_server_get_clients(clients, 1));
+    TEST_ASSERT_EQUAL_STRING("fd12:3456::1", clients[0].ip);
+}
+
+void test_ws_server_accept_client_invalid_params(void) {
+    TEST_ASSERT_EQUAL(-1, ws_server_accept_client(NULL, 12345));
+    
+    ws_server_cleanup();
+    TEST_ASSERT_EQUAL(-1, ws_server_accept_client("192.168.1.100", 12345));
+}
+
 // ============================================
 // 整合測試
 // ============================================
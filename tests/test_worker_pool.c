@@ -0,0 +1,216 @@
+/**
+ * @file test_worker_pool.c
+ * @brief Unit tests for Worker Pool module
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ */
+
+#include "unity.h"
+#include "worker_pool.h"
+#include "server_clock.h"
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define MAX_DONE    8
+
+static int g_done_results[MAX_DONE];
+static int g_done_args[MAX_DONE];
+static int g_done_count;
+static int g_job_runs;
+
+/* ============================================================
+ *  Test Fixtures
+ * ============================================================ */
+
+static int job_add_one(void *arg) {
+    g_job_runs++;
+    return *(int *)arg + 1;
+}
+
+static int job_slow(void *arg) {
+    (void)arg;
+    g_job_runs++;
+    server_clock_advance_ms(40);
+    return 0;
+}
+
+static void on_done(int result, void *arg) {
+    if (g_done_count < MAX_DONE) {
+        g_done_results[g_done_count] = result;
+        g_done_args[g_done_count] = *(int *)arg;
+    }
+    g_done_count++;
+}
+
+void setUp(void) {
+    memset(g_done_results, 0, sizeof(g_done_results));
+    memset(g_done_args, 0, sizeof(g_done_args));
+    g_done_count = 0;
+    g_job_runs = 0;
+    worker_pool_cleanup();
+    server_clock_use_fake(1000);
+
+    TEST_ASSERT_EQUAL(WORKER_POOL_OK, worker_pool_init(0));
+    TEST_ASSERT_EQUAL(WORKER_POOL_OK, worker_pool_start());
+}
+
+void tearDown(void) {
+    worker_pool_cleanup();
+    server_clock_use_real();
+}
+
+/* ============================================================
+ *  Test Group 1: Job Tests
+ * ============================================================ */
+
+void test_worker_pool_runs_job_and_delivers_done(void) {
+    int arg = 41;
+
+    TEST_ASSERT_EQUAL(WORKER_POOL_OK, worker_pool_submit(job_add_one, on_done, &arg, 0));
+
+    // Nothing is delivered before the job has run
+    TEST_ASSERT_EQUAL(0, worker_pool_process());
+    TEST_ASSERT_EQUAL(1, worker_pool_run_one());
+    TEST_ASSERT_EQUAL(0, g_done_count);
+
+    TEST_ASSERT_EQUAL(1, worker_pool_process());
+    TEST_ASSERT_EQUAL(1, g_done_count);
+    TEST_ASSERT_EQUAL(42, g_done_results[0]);
+    TEST_ASSERT_EQUAL(0, worker_pool_run_one());
+}
+
+void test_worker_pool_keeps_order(void) {
+    int args[3] = { 10, 20, 30 };
+
+    for (int i = 0; i < 3; i++) {
+        worker_pool_submit(job_add_one, on_done, &args[i], 0);
+    }
+    while (worker_pool_run_one() > 0) {
+    }
+
+    TEST_ASSERT_EQUAL(3, worker_pool_process());
+    TEST_ASSERT_EQUAL(10, g_done_args[0]);
+    TEST_ASSERT_EQUAL(20, g_done_args[1]);
+    TEST_ASSERT_EQUAL(30, g_done_args[2]);
+}
+
+void test_worker_pool_deadline_expires_queued_job(void) {
+    int arg = 0;
+    worker_pool_stats_t stats;
+
+    worker_pool_submit(job_add_one, on_done, &arg, 50);
+    server_clock_advance_ms(51);
+    TEST_ASSERT_EQUAL(1, worker_pool_run_one());
+
+    TEST_ASSERT_EQUAL(0, g_job_runs);
+    TEST_ASSERT_EQUAL(1, worker_pool_process());
+    TEST_ASSERT_EQUAL(WORKER_POOL_ERROR_EXPIRED, g_done_results[0]);
+
+    worker_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.expired);
+    TEST_ASSERT_EQUAL(0, stats.completed);
+}
+
+void test_worker_pool_full(void) {
+    int arg = 0;
+    worker_pool_stats_t stats;
+
+    for (int i = 0; i < WORKER_POOL_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL(WORKER_POOL_OK, worker_pool_submit(job_add_one, NULL, &arg, 0));
+    }
+    TEST_ASSERT_EQUAL(WORKER_POOL_ERROR_FULL, worker_pool_submit(job_add_one, NULL, &arg, 0));
+
+    // A slot is only free again once its completion is delivered
+    worker_pool_run_one();
+    TEST_ASSERT_EQUAL(WORKER_POOL_ERROR_FULL, worker_pool_submit(job_add_one, NULL, &arg, 0));
+    worker_pool_process();
+    TEST_ASSERT_EQUAL(WORKER_POOL_OK, worker_pool_submit(job_add_one, NULL, &arg, 0));
+
+    worker_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.rejected);
+    TEST_ASSERT_EQUAL(WORKER_POOL_QUEUE_SIZE, stats.max_queued);
+}
+
+void test_worker_pool_event_fd_signals_completion(void) {
+    int arg = 0;
+    uint64_t count = 0;
+    int fd = worker_pool_get_event_fd();
+
+    TEST_ASSERT_TRUE(fd >= 0);
+    worker_pool_submit(job_add_one, on_done, &arg, 0);
+    TEST_ASSERT_EQUAL(-1, (int)read(fd, &count, sizeof(count)));
+
+    worker_pool_run_one();
+    worker_pool_process();
+    // process() consumed the wakeup
+    TEST_ASSERT_EQUAL(-1, (int)read(fd, &count, sizeof(count)));
+
+    worker_pool_submit(job_add_one, on_done, &arg, 0);
+    worker_pool_run_one();
+    TEST_ASSERT_EQUAL((int)sizeof(count), (int)read(fd, &count, sizeof(count)));
+}
+
+/* ============================================================
+ *  Test Group 2: Metrics Tests
+ * ============================================================ */
+
+void test_worker_pool_wait_and_run_times(void) {
+    int arg = 0;
+    worker_pool_stats_t stats;
+
+    worker_pool_submit(job_slow, NULL, &arg, 0);
+    worker_pool_submit(job_slow, NULL, &arg, 0);
+
+    worker_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.queued);
+    TEST_ASSERT_EQUAL(2, stats.submitted);
+
+    server_clock_advance_ms(10);
+    worker_pool_run_one();      // waited 10 ms, runs 40 ms
+    worker_pool_run_one();      // waited 50 ms
+
+    worker_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.queued);
+    TEST_ASSERT_EQUAL(0, stats.running);
+    TEST_ASSERT_EQUAL(2, stats.completed);
+    TEST_ASSERT_EQUAL(50000, stats.wait_max_us);
+    TEST_ASSERT_EQUAL(15000, stats.wait_avg_us);
+    TEST_ASSERT_EQUAL(40000, stats.run_avg_us);
+}
+
+/* ============================================================
+ *  Test Group 3: Lifecycle Tests
+ * ============================================================ */
+
+void test_worker_pool_cleanup_finishes_jobs(void) {
+    int arg = 1;
+
+    worker_pool_submit(job_add_one, on_done, &arg, 0);
+    worker_pool_cleanup();
+
+    TEST_ASSERT_EQUAL(1, g_job_runs);
+    TEST_ASSERT_EQUAL(1, g_done_count);
+    TEST_ASSERT_FALSE(worker_pool_is_ready());
+    TEST_ASSERT_EQUAL(-1, worker_pool_get_event_fd());
+}
+
+void test_worker_pool_validates(void) {
+    int arg = 0;
+
+    TEST_ASSERT_EQUAL(WORKER_POOL_ERROR_INVALID_PARAM, worker_pool_submit(NULL, on_done, &arg, 0));
+    TEST_ASSERT_EQUAL(WORKER_POOL_ERROR_NOT_INIT, worker_pool_init(1));
+
+    worker_pool_cleanup();
+    TEST_ASSERT_EQUAL(WORKER_POOL_ERROR_INVALID_PARAM, worker_pool_init(WORKER_POOL_MAX_THREADS + 1));
+    TEST_ASSERT_EQUAL(WORKER_POOL_ERROR_NOT_INIT, worker_pool_submit(job_add_one, NULL, &arg, 0));
+    TEST_ASSERT_EQUAL(WORKER_POOL_ERROR_NOT_INIT, worker_pool_process());
+    TEST_ASSERT_EQUAL(WORKER_POOL_ERROR_NOT_INIT, worker_pool_start());
+}
+
+void test_worker_pool_error_string(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", worker_pool_error_string(WORKER_POOL_OK));
+    TEST_ASSERT_EQUAL_STRING("Deadline expired", worker_pool_error_string(WORKER_POOL_ERROR_EXPIRED));
+    TEST_ASSERT_EQUAL_STRING("Invalid error code", worker_pool_error_string(-50));
+}
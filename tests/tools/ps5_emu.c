@@ -0,0 +1,779 @@
+/**
+ * @file ps5_emu.c
+ * @brief Emulated PS5 for end-to-end tests (run inside a network namespace)
+ *
+ * Started by ps5_netns.sh inside the console's namespace. Behaves like a
+ * console on the LAN side and drives the fake cec-ctl on the HDMI side:
+ *
+ *   state      ARP   ICMP  DDP (UDP 9302)   TCP 9295   CEC power
+ *   off        -     -     -                -          (no reply)
+ *   standby    yes   -     620 Standby      RST        standby
+ *   booting    yes   after --net-delay      after      on after
+ *              yes   200 Ok after           --ready-   --cec-delay
+ *                          --net-delay      delay
+ *   on         yes   yes   200 Ok           accept     on
+ *
+ * ARP and ICMP are switched with the namespace's own sysctls
+ * (conf/all/arp_ignore, icmp_echo_ignore_all); the kernel answers.
+ * --flap PERIOD:DOWN takes the console off the network for DOWN ms every
+ * PERIOD ms while it is on (CEC stays on), to exercise loss detection.
+ *
+ * Control: "wake", "standby", "off" or "on" lines written to
+ * STATE_DIR/control (a FIFO; the fake cec-ctl writes it), or a DDP
+ * WAKEUP datagram. CEC power is published in STATE_DIR/cec_power.
+ *
+ * With --watch the same binary instead runs on the host, listens for the
+ * server's status beacon, optionally runs a command (the wake request)
+ * and prints how long the server took to report "on" and "ready".
+ *
+ * Build: cc -std=c99 -O2 -Wall -Isrc -o ps5_emu tests/tools/ps5_emu.c
+ *        src/status_beacon.c src/server_clock.c
+ *
+ * @author Gaming System Development Team
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+// ⭐ POSIX 標準定義 (必須在最前面!)
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE     // struct ip_mreq
+
+#include "status_beacon.h"
+#include "server_clock.h"
+
+// Standard C library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+
+// POSIX headers
+#include <unistd.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* ============================================================
+ *  Constants
+ * ============================================================ */
+
+#define EMU_DDP_PORT            9302
+#define EMU_REMOTE_PLAY_PORT    9295
+#define EMU_DEFAULT_CEC_MS      1000
+#define EMU_DEFAULT_NET_MS      4000
+#define EMU_DEFAULT_READY_MS    9000
+#define EMU_DEFAULT_TIMEOUT_MS  60000
+#define EMU_PATH_MAX            256
+
+#define PROC_ICMP_IGNORE        "/proc/sys/net/ipv4/icmp_echo_ignore_all"
+#define PROC_ARP_IGNORE         "/proc/sys/net/ipv4/conf/all/arp_ignore"
+#define ARP_IGNORE_ALL          "8"     // Reply to no ARP request
+
+/* ============================================================
+ *  Type Definitions
+ * ============================================================ */
+
+typedef enum {
+    EMU_OFF = 0,
+    EMU_STANDBY,
+    EMU_BOOTING,
+    EMU_ON
+} emu_power_t;
+
+/**
+ * @brief What the console answers right now
+ */
+typedef struct {
+    bool arp;
+    bool icmp;
+    int ddp_code;               // 0 (silent), 620 or 200
+    bool tcp;
+    bool cec_on;
+    bool cec_reply;
+} emu_face_t;
+
+typedef struct {
+    // Options
+    const char *state_dir;
+    const char *host_id;
+    const char *host_name;
+    const char *announce_addr;
+    uint32_t cec_delay_ms;
+    uint32_t net_delay_ms;
+    uint32_t ready_delay_ms;
+    uint32_t flap_period_ms;
+    uint32_t flap_down_ms;
+
+    // Runtime
+    emu_power_t power;
+    uint64_t wake_us;
+    bool flap_down;
+    uint64_t next_flap_us;
+    emu_face_t face;
+    bool face_valid;
+
+    int ddp_fd;
+    int tcp_fd;
+    int ctl_fd;
+    char ctl_path[EMU_PATH_MAX];
+    char cec_path[EMU_PATH_MAX];
+    char pid_path[EMU_PATH_MAX];
+    uint64_t start_us;
+} emu_context_t;
+
+/* ============================================================
+ *  Static Variables
+ * ============================================================ */
+
+static volatile sig_atomic_t g_running = 1;
+
+static emu_context_t g_emu = {
+    .host_id = "00D9D1000099",
+    .host_name = "PS5-EMU",
+    .cec_delay_ms = EMU_DEFAULT_CEC_MS,
+    .net_delay_ms = EMU_DEFAULT_NET_MS,
+    .ready_delay_ms = EMU_DEFAULT_READY_MS,
+    .power = EMU_STANDBY,
+    .ddp_fd = -1,
+    .tcp_fd = -1,
+    .ctl_fd = -1
+};
+
+static const char *const g_power_names[] = { "off", "standby", "booting", "on" };
+
+/* ============================================================
+ *  Helper Functions
+ * ============================================================ */
+
+static void on_signal(int sig) {
+    (void)sig;
+    g_running = 0;
+}
+
+static uint32_t elapsed_ms(uint64_t since_us) {
+    return (uint32_t)((server_clock_monotonic_us() - since_us) / 1000ULL);
+}
+
+static void log_event(const char *fmt, const char *arg) {
+    fprintf(stdout, "[PS5Emu] %7u ms  ", elapsed_ms(g_emu.start_us));
+    fprintf(stdout, fmt, arg);
+    fprintf(stdout, "\n");
+    fflush(stdout);
+}
+
+static void write_proc(const char *path, const char *value) {
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL || fputs(value, fp) < 0) {
+        fprintf(stderr, "[PS5Emu] Cannot write %s: %s\n", path, strerror(errno));
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+}
+
+/**
+ * @brief Publish CEC power for the fake cec-ctl (rename, so it never reads half a file)
+ */
+static void write_cec_power(const emu_face_t *face) {
+    if (!face->cec_reply) {
+        unlink(g_emu.cec_path);
+        return;
+    }
+
+    char tmp[EMU_PATH_MAX + 8];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", g_emu.cec_path);
+
+    FILE *fp = fopen(tmp, "w");
+    if (fp == NULL) {
+        return;
+    }
+    fprintf(fp, "\tpwr-state: %s\n", face->cec_on ? "on (0x00)" : "standby (0x01)");
+    fclose(fp);
+    rename(tmp, g_emu.cec_path);
+}
+
+static int open_udp(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int open_listener(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* ============================================================
+ *  Emulator - State
+ * ============================================================ */
+
+/**
+ * @brief Work out what the console answers at `now`
+ */
+static emu_face_t compute_face(uint64_t now_us) {
+    emu_face_t face;
+    memset(&face, 0, sizeof(face));
+
+    switch (g_emu.power) {
+        case EMU_OFF:
+            break;
+
+        case EMU_STANDBY:
+            face.arp = true;
+            face.ddp_code = 620;
+            face.cec_reply = true;
+            break;
+
+        case EMU_BOOTING: {
+            uint64_t since_ms = (now_us - g_emu.wake_us) / 1000ULL;
+            bool net = (since_ms >= g_emu.net_delay_ms);
+            face.arp = true;
+            face.icmp = net;
+            face.ddp_code = net ? 200 : 620;
+            face.tcp = (since_ms >= g_emu.ready_delay_ms);
+            face.cec_on = (since_ms >= g_emu.cec_delay_ms);
+            face.cec_reply = true;
+            break;
+        }
+
+        case EMU_ON:
+            face.arp = true;
+            face.icmp = true;
+            face.ddp_code = 200;
+            face.tcp = true;
+            face.cec_on = true;
+            face.cec_reply = true;
+            break;
+    }
+
+    if (g_emu.flap_down) {
+        face.arp = false;
+        face.icmp = false;
+        face.ddp_code = 0;
+        face.tcp = false;
+    }
+
+    return face;
+}
+
+static void send_ddp(int code, const struct sockaddr_in *to) {
+    char msg[384];
+    int len = snprintf(msg, sizeof(msg),
+                       "HTTP/1.1 %s\n"
+                       "host-id:%s\n"
+                       "host-type:PS5\n"
+                       "host-name:%s\n"
+                       "host-request-port:997\n"
+                       "device-discovery-protocol-version:00030010\n"
+                       "system-version:07020001\n",
+                       (code == 200) ? "200 Ok" : "620 Server Standby",
+                       g_emu.host_id, g_emu.host_name);
+
+    sendto(g_emu.ddp_fd, msg, (size_t)len, 0, (const struct sockaddr*)to, sizeof(*to));
+}
+
+static void announce_ddp(int code) {
+    if (g_emu.announce_addr == NULL || code == 0) {
+        return;
+    }
+
+    struct sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(EMU_DDP_PORT);
+    if (inet_pton(AF_INET, g_emu.announce_addr, &to.sin_addr) == 1) {
+        send_ddp(code, &to);
+    }
+}
+
+/**
+ * @brief Push the face out to sysctls, sockets and the CEC file
+ */
+static void apply_face(const emu_face_t *face) {
+    const emu_face_t *old = g_emu.face_valid ? &g_emu.face : NULL;
+
+    if (old == NULL || old->arp != face->arp) {
+        write_proc(PROC_ARP_IGNORE, face->arp ? "0" : ARP_IGNORE_ALL);
+        log_event("arp %s", face->arp ? "on" : "off");
+    }
+    if (old == NULL || old->icmp != face->icmp) {
+        write_proc(PROC_ICMP_IGNORE, face->icmp ? "0" : "1");
+        log_event("icmp %s", face->icmp ? "on" : "off");
+    }
+    if (old == NULL || old->ddp_code != face->ddp_code) {
+        log_event("ddp %s", (face->ddp_code == 200) ? "200 Ok" :
+                            (face->ddp_code == 620) ? "620 Standby" : "silent");
+        announce_ddp(face->ddp_code);
+    }
+    if (old == NULL || old->tcp != face->tcp) {
+        if (face->tcp && g_emu.tcp_fd < 0) {
+            g_emu.tcp_fd = open_listener(EMU_REMOTE_PLAY_PORT);
+        } else if (!face->tcp && g_emu.tcp_fd >= 0) {
+            close(g_emu.tcp_fd);
+            g_emu.tcp_fd = -1;
+        }
+        log_event("remote play %s", face->tcp ? "accepting" : "closed");
+    }
+    if (old == NULL || old->cec_on != face->cec_on || old->cec_reply != face->cec_reply) {
+        write_cec_power(face);
+        log_event("cec %s", !face->cec_reply ? "silent" : face->cec_on ? "on" : "standby");
+    }
+
+    g_emu.face = *face;
+    g_emu.face_valid = true;
+}
+
+static void set_power(emu_power_t power, uint64_t now_us) {
+    if (power == EMU_BOOTING) {
+        if (g_emu.power == EMU_BOOTING || g_emu.power == EMU_ON) {
+            return;     // Already awake
+        }
+        g_emu.wake_us = now_us;
+    }
+
+    g_emu.power = power;
+    g_emu.flap_down = false;
+    g_emu.next_flap_us = 0;
+    log_event("power %s", g_power_names[power]);
+}
+
+/**
+ * @brief Advance boot and flap timers
+ */
+static void tick(uint64_t now_us) {
+    if (g_emu.power == EMU_BOOTING) {
+        uint32_t last_ms = g_emu.net_delay_ms;
+        if (g_emu.cec_delay_ms > last_ms)   last_ms = g_emu.cec_delay_ms;
+        if (g_emu.ready_delay_ms > last_ms) last_ms = g_emu.ready_delay_ms;
+
+        if (now_us - g_emu.wake_us >= (uint64_t)last_ms * 1000ULL) {
+            set_power(EMU_ON, now_us);
+        }
+    }
+
+    if (g_emu.power == EMU_ON && g_emu.flap_period_ms > 0) {
+        if (g_emu.next_flap_us == 0) {
+            g_emu.next_flap_us = now_us + (uint64_t)g_emu.flap_period_ms * 1000ULL;
+        } else if (now_us >= g_emu.next_flap_us) {
+            g_emu.flap_down = !g_emu.flap_down;
+            uint32_t ms = g_emu.flap_down ? g_emu.flap_down_ms : g_emu.flap_period_ms;
+            g_emu.next_flap_us = now_us + (uint64_t)ms * 1000ULL;
+            log_event("flap %s", g_emu.flap_down ? "down" : "up");
+        }
+    }
+
+    emu_face_t face = compute_face(now_us);
+    apply_face(&face);
+}
+
+/**
+ * @brief Milliseconds until the next timer, -1 if none
+ */
+static int next_timeout_ms(uint64_t now_us) {
+    uint64_t next = 0;
+
+    if (g_emu.power == EMU_BOOTING) {
+        const uint32_t delays[3] = { g_emu.cec_delay_ms, g_emu.net_delay_ms, g_emu.ready_delay_ms };
+        for (int i = 0; i < 3; i++) {
+            uint64_t at = g_emu.wake_us + (uint64_t)delays[i] * 1000ULL;
+            if (at > now_us && (next == 0 || at < next)) {
+                next = at;
+            }
+        }
+    }
+    if (g_emu.power == EMU_ON && g_emu.next_flap_us > now_us &&
+        (next == 0 || g_emu.next_flap_us < next)) {
+        next = g_emu.next_flap_us;
+    }
+
+    if (next == 0) {
+        return (g_emu.power == EMU_ON && g_emu.flap_period_ms > 0) ? 0 : -1;
+    }
+    return (int)((next - now_us + 999) / 1000);
+}
+
+/* ============================================================
+ *  Emulator - I/O
+ * ============================================================ */
+
+static void handle_command(const char *cmd, uint64_t now_us) {
+    if (strcmp(cmd, "wake") == 0) {
+        if (g_emu.power == EMU_STANDBY) {
+            set_power(EMU_BOOTING, now_us);
+        }
+    } else if (strcmp(cmd, "standby") == 0) {
+        set_power(EMU_STANDBY, now_us);
+    } else if (strcmp(cmd, "off") == 0) {
+        set_power(EMU_OFF, now_us);
+    } else if (strcmp(cmd, "on") == 0) {
+        set_power(EMU_ON, now_us);
+    } else if (cmd[0] != '\0') {
+        log_event("unknown command '%s'", cmd);
+    }
+}
+
+static void read_control(uint64_t now_us) {
+    char buf[256];
+    ssize_t n = read(g_emu.ctl_fd, buf, sizeof(buf) - 1);
+    if (n <= 0) {
+        return;
+    }
+    buf[n] = '\0';
+
+    char *saveptr = NULL;
+    for (char *line = strtok_r(buf, "\r\n", &saveptr); line != NULL;
+         line = strtok_r(NULL, "\r\n", &saveptr)) {
+        handle_command(line, now_us);
+    }
+}
+
+static void read_ddp(uint64_t now_us) {
+    char buf[512];
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+
+    ssize_t n = recvfrom(g_emu.ddp_fd, buf, sizeof(buf) - 1, 0, (struct sockaddr*)&from, &from_len);
+    if (n <= 0) {
+        return;
+    }
+    buf[n] = '\0';
+
+    if (strncmp(buf, "SRCH ", 5) == 0 && g_emu.face.ddp_code != 0) {
+        send_ddp(g_emu.face.ddp_code, &from);
+    } else if (strncmp(buf, "WAKEUP ", 7) == 0 && g_emu.power == EMU_STANDBY) {
+        log_event("ddp wakeup from %s", inet_ntoa(from.sin_addr));
+        set_power(EMU_BOOTING, now_us);
+    }
+}
+
+static void accept_remote_play(void) {
+    int fd;
+    while ((fd = accept(g_emu.tcp_fd, NULL, NULL)) >= 0) {
+        close(fd);      // Accepting is all the ready probe looks for
+    }
+}
+
+static int emulator_open(void) {
+    snprintf(g_emu.ctl_path, sizeof(g_emu.ctl_path), "%s/control", g_emu.state_dir);
+    snprintf(g_emu.cec_path, sizeof(g_emu.cec_path), "%s/cec_power", g_emu.state_dir);
+    snprintf(g_emu.pid_path, sizeof(g_emu.pid_path), "%s/ps5_emu.pid", g_emu.state_dir);
+
+    unlink(g_emu.ctl_path);
+    if (mkfifo(g_emu.ctl_path, 0600) != 0) {
+        fprintf(stderr, "[PS5Emu] mkfifo %s: %s\n", g_emu.ctl_path, strerror(errno));
+        return -1;
+    }
+    // Read-write, so the FIFO never reports EOF and writers never block
+    g_emu.ctl_fd = open(g_emu.ctl_path, O_RDWR | O_NONBLOCK);
+
+    g_emu.ddp_fd = open_udp(EMU_DDP_PORT);
+    if (g_emu.ctl_fd < 0 || g_emu.ddp_fd < 0) {
+        fprintf(stderr, "[PS5Emu] Cannot open control FIFO or DDP socket: %s\n", strerror(errno));
+        return -1;
+    }
+
+    FILE *fp = fopen(g_emu.pid_path, "w");
+    if (fp != NULL) {
+        fprintf(fp, "%d\n", (int)getpid());
+        fclose(fp);
+    }
+    return 0;
+}
+
+static void emulator_close(void) {
+    if (g_emu.tcp_fd >= 0)  close(g_emu.tcp_fd);
+    if (g_emu.ddp_fd >= 0)  close(g_emu.ddp_fd);
+    if (g_emu.ctl_fd >= 0)  close(g_emu.ctl_fd);
+
+    // Leave the namespace answering normally
+    write_proc(PROC_ARP_IGNORE, "0");
+    write_proc(PROC_ICMP_IGNORE, "0");
+
+    unlink(g_emu.ctl_path);
+    unlink(g_emu.cec_path);
+    unlink(g_emu.pid_path);
+}
+
+static int run_emulator(void) {
+    if (g_emu.state_dir == NULL) {
+        fprintf(stderr, "[PS5Emu] --state-dir is required\n");
+        return 1;
+    }
+    if (emulator_open() != 0) {
+        emulator_close();
+        return 1;
+    }
+
+    g_emu.start_us = server_clock_monotonic_us();
+    log_event("started in %s", g_power_names[g_emu.power]);
+    if (g_emu.power == EMU_BOOTING) {
+        g_emu.wake_us = g_emu.start_us;
+    }
+
+    while (g_running) {
+        uint64_t now = server_clock_monotonic_us();
+        tick(now);
+
+        struct pollfd pfds[3] = {
+            { .fd = g_emu.ctl_fd, .events = POLLIN },
+            { .fd = g_emu.ddp_fd, .events = POLLIN },
+            { .fd = g_emu.tcp_fd, .events = POLLIN },   // -1 (ignored) while closed
+        };
+
+        int ret = poll(pfds, 3, next_timeout_ms(now));
+        if (ret < 0 && errno != EINTR) {
+            break;
+        }
+
+        now = server_clock_monotonic_us();
+        if (pfds[0].revents & POLLIN)                       read_control(now);
+        if (pfds[1].revents & POLLIN)                       read_ddp(now);
+        if (g_emu.tcp_fd >= 0 && (pfds[2].revents & POLLIN)) accept_remote_play();
+    }
+
+    log_event("stopping in %s", g_power_names[g_emu.power]);
+    emulator_close();
+    return 0;
+}
+
+/* ============================================================
+ *  Watch Mode
+ * ============================================================ */
+
+/**
+ * @brief Time the server's beacon from the wake command to "on" and "ready"
+ * @return 0 when ready was seen, 1 on timeout, 2 on setup or command failure
+ */
+static int run_watch(const char *group_spec, uint32_t timeout_ms, const char *exec_cmd) {
+    char group[32] = STATUS_BEACON_DEFAULT_GROUP;
+    unsigned int port = STATUS_BEACON_DEFAULT_PORT;
+
+    if (group_spec != NULL) {
+        char *colon = strchr(group_spec, ':');
+        size_t len = colon ? (size_t)(colon - group_spec) : strlen(group_spec);
+        if (len == 0 || len >= sizeof(group) || (colon && sscanf(colon + 1, "%u", &port) != 1)) {
+            fprintf(stderr, "[PS5Emu] Bad beacon address: %s\n", group_spec);
+            return 2;
+        }
+        memcpy(group, group_spec, len);
+        group[len] = '\0';
+    }
+
+    int fd = open_udp((uint16_t)port);
+    struct ip_mreq mreq;
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+    if (fd < 0 || inet_pton(AF_INET, group, &mreq.imr_multiaddr) != 1 ||
+        setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) {
+        fprintf(stderr, "[PS5Emu] Cannot join %s:%u: %s\n", group, port, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return 2;
+    }
+
+    uint64_t start = server_clock_monotonic_us();
+    if (exec_cmd != NULL && system(exec_cmd) != 0) {
+        fprintf(stderr, "[PS5Emu] Command failed: %s\n", exec_cmd);
+        close(fd);
+        return 2;
+    }
+
+    int64_t on_ms = -1;
+    int64_t ready_ms = -1;
+
+    while (g_running && ready_ms < 0) {
+        uint32_t waited = elapsed_ms(start);
+        if (waited >= timeout_ms) {
+            break;
+        }
+
+        struct pollfd pfd = { .fd = fd, .events = POLLIN };
+        if (poll(&pfd, 1, (int)(timeout_ms - waited)) <= 0) {
+            continue;
+        }
+
+        uint8_t buf[64];
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        beacon_packet_t packet;
+        if (n <= 0 || status_beacon_decode(buf, (size_t)n, &packet) != BEACON_OK) {
+            continue;
+        }
+
+        if (on_ms < 0 && (packet.status == BEACON_STATUS_ON || packet.status == BEACON_STATUS_READY)) {
+            on_ms = elapsed_ms(start);
+        }
+        if (packet.status == BEACON_STATUS_READY) {
+            ready_ms = elapsed_ms(start);
+        }
+    }
+
+    close(fd);
+    fprintf(stdout, "on_ms=%lld ready_ms=%lld\n", (long long)on_ms, (long long)ready_ms);
+    return (ready_ms >= 0) ? 0 : 1;
+}
+
+/* ============================================================
+ *  Main
+ * ============================================================ */
+
+static void print_usage(const char *program_name) {
+    printf("Usage: %s --state-dir DIR [OPTIONS]     (inside the console namespace)\n", program_name);
+    printf("       %s --watch [--beacon GROUP[:PORT]] [--timeout MS] [--exec CMD]\n", program_name);
+    printf("\n");
+    printf("Emulator options:\n");
+    printf("      --state-dir DIR   Control FIFO, CEC power file and pid file\n");
+    printf("      --start STATE     off, standby (default), booting or on\n");
+    printf("      --cec-delay MS    Wake to CEC power on (default: %d)\n", EMU_DEFAULT_CEC_MS);
+    printf("      --net-delay MS    Wake to ICMP / DDP 200 (default: %d)\n", EMU_DEFAULT_NET_MS);
+    printf("      --ready-delay MS  Wake to Remote Play accepting (default: %d)\n", EMU_DEFAULT_READY_MS);
+    printf("      --flap PERIOD:DOWN\n");
+    printf("                        While on, drop off the network for DOWN ms every PERIOD ms\n");
+    printf("      --host-id HEX     DDP host-id (the MAC as 12 hex digits)\n");
+    printf("      --host-name NAME  DDP host-name (default: PS5-EMU)\n");
+    printf("      --announce ADDR   Also send DDP replies to ADDR on every change\n");
+    printf("\n");
+    printf("Watch options:\n");
+    printf("      --beacon GROUP[:PORT]  Server status beacon (default: %s:%d)\n",
+           STATUS_BEACON_DEFAULT_GROUP, STATUS_BEACON_DEFAULT_PORT);
+    printf("      --timeout MS      Give up after MS (default: %d)\n", EMU_DEFAULT_TIMEOUT_MS);
+    printf("      --exec CMD        Run CMD (the wake request) after joining the group\n");
+}
+
+static bool parse_ms_arg(const char *text, uint32_t *ms) {
+    char *end = NULL;
+    unsigned long value = strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || value > 3600000UL) {
+        return false;
+    }
+    *ms = (uint32_t)value;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    enum {
+        OPT_STATE_DIR = 256, OPT_START, OPT_CEC_DELAY, OPT_NET_DELAY, OPT_READY_DELAY,
+        OPT_FLAP, OPT_HOST_ID, OPT_HOST_NAME, OPT_ANNOUNCE,
+        OPT_WATCH, OPT_BEACON, OPT_TIMEOUT, OPT_EXEC,
+    };
+    static struct option long_options[] = {
+        {"state-dir",   required_argument, 0, OPT_STATE_DIR},
+        {"start",       required_argument, 0, OPT_START},
+        {"cec-delay",   required_argument, 0, OPT_CEC_DELAY},
+        {"net-delay",   required_argument, 0, OPT_NET_DELAY},
+        {"ready-delay", required_argument, 0, OPT_READY_DELAY},
+        {"flap",        required_argument, 0, OPT_FLAP},
+        {"host-id",     required_argument, 0, OPT_HOST_ID},
+        {"host-name",   required_argument, 0, OPT_HOST_NAME},
+        {"announce",    required_argument, 0, OPT_ANNOUNCE},
+        {"watch",       no_argument,       0, OPT_WATCH},
+        {"beacon",      required_argument, 0, OPT_BEACON},
+        {"timeout",     required_argument, 0, OPT_TIMEOUT},
+        {"exec",        required_argument, 0, OPT_EXEC},
+        {"help",        no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    bool watch = false;
+    const char *beacon = NULL;
+    const char *exec_cmd = NULL;
+    uint32_t timeout_ms = EMU_DEFAULT_TIMEOUT_MS;
+    bool ok = true;
+
+    int opt;
+    while (ok && (opt = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case OPT_STATE_DIR:     g_emu.state_dir = optarg; break;
+            case OPT_CEC_DELAY:     ok = parse_ms_arg(optarg, &g_emu.cec_delay_ms); break;
+            case OPT_NET_DELAY:     ok = parse_ms_arg(optarg, &g_emu.net_delay_ms); break;
+            case OPT_READY_DELAY:   ok = parse_ms_arg(optarg, &g_emu.ready_delay_ms); break;
+            case OPT_HOST_ID:       g_emu.host_id = optarg; break;
+            case OPT_HOST_NAME:     g_emu.host_name = optarg; break;
+            case OPT_ANNOUNCE:      g_emu.announce_addr = optarg; break;
+            case OPT_WATCH:         watch = true; break;
+            case OPT_BEACON:        beacon = optarg; break;
+            case OPT_TIMEOUT:       ok = parse_ms_arg(optarg, &timeout_ms); break;
+            case OPT_EXEC:          exec_cmd = optarg; break;
+
+            case OPT_START:
+                ok = false;
+                for (int i = EMU_OFF; i <= EMU_ON; i++) {
+                    if (strcmp(optarg, g_power_names[i]) == 0) {
+                        g_emu.power = (emu_power_t)i;
+                        ok = true;
+                    }
+                }
+                break;
+
+            case OPT_FLAP:
+                ok = (sscanf(optarg, "%u:%u", &g_emu.flap_period_ms, &g_emu.flap_down_ms) == 2 &&
+                      g_emu.flap_period_ms > 0 && g_emu.flap_down_ms > 0);
+                break;
+
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+
+            default:
+                ok = false;
+                break;
+        }
+    }
+
+    if (!ok) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    return watch ? run_watch(beacon, timeout_ms, exec_cmd) : run_emulator();
+}
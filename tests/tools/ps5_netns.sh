@@ -0,0 +1,214 @@
+#!/bin/sh
+#
+# ps5_netns.sh - Emulated PS5 in a network namespace, for end-to-end runs
+#                of the real gaming-server binary without a console
+#
+#   host (root ns)                        ps5emu ns
+#   veth-ps5h 10.99.0.1/24  <-------->  veth-ps5 10.99.0.2/24
+#   gaming-server, mosquitto             ps5_emu (ARP, ICMP, DDP 9302, TCP 9295)
+#   fake cec-ctl  --- STATE_DIR/control, cec_power --->
+#
+# Usage (as root):
+#   ps5_netns.sh up                 create the namespace and start the emulator
+#   ps5_netns.sh measure [RUNS]     time wake request -> "ready" with the real server
+#   ps5_netns.sh down               stop everything and remove the namespace
+#
+# Environment:
+#   GAMING_SERVER   server binary (default: gaming-server in PATH)
+#   EMU_ARGS        extra ps5_emu options, e.g. "--ready-delay 12000 --flap 30000:2000"
+#   SERVER_ARGS     extra server options, e.g. "--faults cec.delay=100-800"
+#   STATE_DIR       scratch directory (default: /tmp/ps5emu)
+#   SETTLE_SEC      standby time before each wake (default: 15)
+#   TIMEOUT_MS      give up on a run after this long (default: 60000)
+#   MQTT_HOST/PORT  broker for the wake request (default: a private mosquitto on 127.0.0.1:18830)
+#
+# measure needs mosquitto and mosquitto_pub. The wake is sent as an MQTT
+# command, and readiness is read from the server's multicast status beacon.
+# The PS5 cache file is seeded so the server finds the console without a
+# scan. An existing cache file is saved and restored.
+#
+
+set -e
+
+NS=ps5emu
+HOST_IF=veth-ps5h
+PS5_IF=veth-ps5
+HOST_ADDR=10.99.0.1/24
+PS5_IP=10.99.0.2
+PS5_MAC=00:d9:d1:00:00:99
+SUBNET=10.99.0.0/24
+BEACON_GROUP=239.255.42.99
+CACHE_PATH=/var/run/gaming/ps5_cache.json
+
+STATE_DIR=${STATE_DIR:-/tmp/ps5emu}
+SETTLE_SEC=${SETTLE_SEC:-15}
+TIMEOUT_MS=${TIMEOUT_MS:-60000}
+GAMING_SERVER=${GAMING_SERVER:-gaming-server}
+
+TOOLS_DIR=$(cd "$(dirname "$0")" && pwd)
+SRC_DIR=$(cd "$TOOLS_DIR/../../src" && pwd)
+EMU="$STATE_DIR/ps5_emu"
+CEC_DEV="$STATE_DIR/cec0"
+
+log() {
+    echo "[ps5_netns] $*"
+}
+
+die() {
+    echo "[ps5_netns] $*" >&2
+    exit 1
+}
+
+need() {
+    command -v "$1" >/dev/null 2>&1 || die "$1 not found"
+}
+
+stop_pidfile() {
+    if [ -f "$1" ]; then
+        kill "$(cat "$1")" 2>/dev/null || true
+        rm -f "$1"
+    fi
+}
+
+build_emu() {
+    need "${CC:-cc}"
+    if [ ! -x "$EMU" ] || [ "$TOOLS_DIR/ps5_emu.c" -nt "$EMU" ]; then
+        log "building ps5_emu"
+        "${CC:-cc}" -std=c99 -O2 -Wall -I"$SRC_DIR" -o "$EMU" \
+            "$TOOLS_DIR/ps5_emu.c" "$SRC_DIR/status_beacon.c" "$SRC_DIR/server_clock.c"
+    fi
+}
+
+cmd_up() {
+    need ip
+    [ "$(id -u)" -eq 0 ] || die "must run as root"
+    ip netns list | grep -qw "$NS" && die "namespace $NS already exists (run down first)"
+
+    mkdir -p "$STATE_DIR/bin"
+    build_emu
+
+    # cec-ctl in the server's PATH, and a "device" the capability probe can see
+    ln -sf "$TOOLS_DIR/fake-cec-ctl" "$STATE_DIR/bin/cec-ctl"
+    : > "$CEC_DEV"
+
+    ip netns add "$NS"
+    ip link add "$HOST_IF" type veth peer name "$PS5_IF"
+    ip link set "$PS5_IF" netns "$NS"
+    ip netns exec "$NS" ip link set "$PS5_IF" address "$PS5_MAC"
+    ip netns exec "$NS" ip addr add "$PS5_IP/24" dev "$PS5_IF"
+    ip netns exec "$NS" ip link set lo up
+    ip netns exec "$NS" ip link set "$PS5_IF" up
+    ip addr add "$HOST_ADDR" dev "$HOST_IF"
+    ip link set "$HOST_IF" up
+
+    # Keep the status beacon on the veth even on hosts without a default route
+    ip route replace "$BEACON_GROUP/32" dev "$HOST_IF"
+
+    host_id=$(echo "$PS5_MAC" | tr -d ':' | tr 'a-f' 'A-F')
+    # shellcheck disable=SC2086
+    ip netns exec "$NS" "$EMU" --state-dir "$STATE_DIR" --host-id "$host_id" \
+        --announce 10.99.0.255 $EMU_ARGS > "$STATE_DIR/ps5_emu.log" 2>&1 &
+
+    sleep 0.5
+    [ -f "$STATE_DIR/ps5_emu.pid" ] || die "emulator did not start, see $STATE_DIR/ps5_emu.log"
+    log "console $PS5_IP ($PS5_MAC) in namespace $NS, log $STATE_DIR/ps5_emu.log"
+    log "CEC device for the server: -c $CEC_DEV (with $STATE_DIR/bin first in PATH)"
+}
+
+cmd_down() {
+    stop_pidfile "$STATE_DIR/server.pid"
+    stop_pidfile "$STATE_DIR/mosquitto.pid"
+    stop_pidfile "$STATE_DIR/ps5_emu.pid"
+
+    if [ -f "$STATE_DIR/cache.orig" ]; then
+        mv -f "$STATE_DIR/cache.orig" "$CACHE_PATH"
+    fi
+
+    ip route del "$BEACON_GROUP/32" dev "$HOST_IF" 2>/dev/null || true
+    ip link del "$HOST_IF" 2>/dev/null || true
+    ip netns del "$NS" 2>/dev/null || true
+    log "down"
+}
+
+seed_cache() {
+    mkdir -p "$(dirname "$CACHE_PATH")"
+    if [ -f "$CACHE_PATH" ] && [ ! -f "$STATE_DIR/cache.orig" ]; then
+        cp "$CACHE_PATH" "$STATE_DIR/cache.orig"
+    fi
+    printf '{"ip":"%s","mac":"%s","last_seen":%s,"online":false}\n' \
+        "$PS5_IP" "$PS5_MAC" "$(date +%s)" > "$CACHE_PATH"
+}
+
+start_broker() {
+    if [ -n "$MQTT_HOST" ]; then
+        MQTT_PORT=${MQTT_PORT:-1883}
+        return
+    fi
+    need mosquitto
+    MQTT_HOST=127.0.0.1
+    MQTT_PORT=${MQTT_PORT:-18830}
+    mosquitto -p "$MQTT_PORT" > "$STATE_DIR/mosquitto.log" 2>&1 &
+    echo $! > "$STATE_DIR/mosquitto.pid"
+    sleep 0.5
+}
+
+start_server() {
+    need "$GAMING_SERVER"
+    # shellcheck disable=SC2086
+    PATH="$STATE_DIR/bin:$PATH" "$GAMING_SERVER" -c "$CEC_DEV" -s "$SUBNET" \
+        --beacon --mqtt "$MQTT_HOST:$MQTT_PORT" $SERVER_ARGS > "$STATE_DIR/server.log" 2>&1 &
+    echo $! > "$STATE_DIR/server.pid"
+
+    i=0
+    until grep -q "All services started" "$STATE_DIR/server.log" 2>/dev/null; do
+        i=$((i + 1))
+        [ $i -le 50 ] || die "server did not start, see $STATE_DIR/server.log"
+        sleep 0.2
+    done
+}
+
+cmd_measure() {
+    runs=${1:-5}
+    [ -f "$STATE_DIR/ps5_emu.pid" ] || die "emulator not running (run up first)"
+    need mosquitto_pub
+
+    seed_cache
+    start_broker
+    start_server
+
+    device=$(echo "$PS5_MAC" | tr -d ':')
+    wake="mosquitto_pub -h $MQTT_HOST -p $MQTT_PORT -t gaming/ps5/$device/wake -m wake"
+    results="$STATE_DIR/results.txt"
+    : > "$results"
+
+    run=1
+    while [ "$run" -le "$runs" ]; do
+        PATH="$STATE_DIR/bin:$PATH" cec-ctl -d "$CEC_DEV" --standby
+        sleep "$SETTLE_SEC"
+
+        line=$("$EMU" --watch --timeout "$TIMEOUT_MS" --exec "$wake") || true
+        log "run $run: $line"
+        echo "$line" >> "$results"
+        run=$((run + 1))
+    done
+
+    stop_pidfile "$STATE_DIR/server.pid"
+    stop_pidfile "$STATE_DIR/mosquitto.pid"
+
+    # on_ms=N ready_ms=N per line; -1 means not seen before the timeout
+    awk -F'[= ]' '
+        $4 >= 0 { n++; sum += $4; if (min == "" || $4 < min) min = $4; if ($4 > max) max = $4 }
+        $4 < 0  { lost++ }
+        END {
+            if (n > 0) printf "[ps5_netns] wake -> ready: %d runs, min %d ms, avg %d ms, max %d ms, %d timed out\n",
+                              n, min, sum / n, max, lost
+            else       printf "[ps5_netns] wake -> ready: no run reached ready (%d timed out)\n", lost
+        }' "$results"
+}
+
+case "$1" in
+    up)         cmd_up ;;
+    down)       cmd_down ;;
+    measure)    shift; cmd_measure "$@" ;;
+    *)          sed -n '2,30p' "$0" | sed 's/^# \{0,1\}//'; exit 2 ;;
+esac